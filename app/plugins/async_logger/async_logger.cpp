@@ -0,0 +1,65 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "async_logger.h"
+
+#include "core/util/logging.hpp"
+
+namespace plugins
+{
+AsyncLogger::AsyncLogger() :
+    AsyncLoggerTags("Async Logger",
+                    "Write log messages from a logging thread.",
+                    {},
+                    {},
+                    {{"log-async", "Write log messages from a logging thread, messages logged while its queue is full are either dropped or wait (drop|block)"}})
+{
+}
+
+bool AsyncLogger::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "log-async")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"log-async\" is missing the overflow policy!");
+			return false;
+		}
+
+		if (arguments[1] == "drop")
+		{
+			vkb::logging::enable_async(8192, vkb::logging::OverflowPolicy::Drop);
+		}
+		else if (arguments[1] == "block")
+		{
+			vkb::logging::enable_async(8192, vkb::logging::OverflowPolicy::Block);
+		}
+		else
+		{
+			LOGE("Option \"log-async\" has an unknown overflow policy \"{}\"!", arguments[1]);
+			return false;
+		}
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
@@ -0,0 +1,45 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using AsyncLoggerTags = vkb::PluginBase<vkb::tags::Passive>;
+
+/**
+ * @brief Async Logger
+ *
+ * Moves the formatting and the output of log messages to a logging thread, so that logging from hot paths does not wait
+ * on I/O. Messages logged while the queue of the logging thread is full are either dropped or wait for a free slot.
+ * Consecutive identical messages within a second are only written once.
+ *
+ * Usage: vulkan_sample sample afbc --log-async drop
+ *
+ */
+class AsyncLogger : public AsyncLoggerTags
+{
+  public:
+	AsyncLogger();
+
+	virtual ~AsyncLogger() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+};
+}        // namespace plugins
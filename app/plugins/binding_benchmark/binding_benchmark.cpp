@@ -0,0 +1,270 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "binding_benchmark.h"
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+#include "common/binding_table.h"
+#include "common/hpp_resource_caching.h"
+#include "timer.h"
+
+namespace plugins
+{
+namespace
+{
+constexpr size_t DRAW_COUNT = 200000;
+
+// Allocations made by the containers measured, through CountingAllocator
+size_t allocation_count = 0;
+
+/**
+ * @brief Standard allocator counting its allocations, given to the containers measured only
+ */
+template <typename T>
+struct CountingAllocator
+{
+	using value_type = T;
+
+	CountingAllocator() = default;
+
+	template <typename U>
+	CountingAllocator(CountingAllocator<U> const &)
+	{}
+
+	T *allocate(size_t count)
+	{
+		++allocation_count;
+		return std::allocator<T>{}.allocate(count);
+	}
+
+	void deallocate(T *pointer, size_t count)
+	{
+		std::allocator<T>{}.deallocate(pointer, count);
+	}
+
+	template <typename U>
+	bool operator==(CountingAllocator<U> const &) const
+	{
+		return true;
+	}
+};
+
+template <typename Key, typename Value>
+using CountingMap = std::map<Key, Value, std::less<Key>, CountingAllocator<std::pair<Key const, Value>>>;
+
+// A vkb::BindingMap allocating with CountingAllocator
+template <typename T>
+using CountingBindingMap = CountingMap<uint32_t, CountingMap<uint32_t, T>>;
+
+template <typename T>
+using CountingBindingTable = vkb::BindingTable<T, 16, CountingAllocator>;
+
+/**
+ * @brief Hashes a map the way std::hash hashes a vkb::BindingMap
+ */
+template <typename Key, typename Value>
+size_t hash_map(CountingMap<Key, Value> const &map)
+{
+	size_t result = 0;
+	vkb::hash_combine(result, map.size());
+	for (auto const &[key, value] : map)
+	{
+		vkb::hash_combine(result, key);
+		if constexpr (requires { hash_map(value); })
+		{
+			vkb::hash_combine(result, hash_map(value));
+		}
+		else
+		{
+			vkb::hash_combine(result, value);
+		}
+	}
+	return result;
+}
+
+// Draws cycle through the materials, whose descriptor sets are all cached once warmed up
+constexpr uint32_t MATERIAL_COUNT = 8;
+
+struct Result
+{
+	double nanoseconds_per_draw;
+	double allocations_per_draw;
+};
+
+/**
+ * @brief Handles are only hashed, any value stands for a resource
+ */
+template <typename Handle>
+Handle make_handle(uint64_t value)
+{
+	return Handle{reinterpret_cast<typename Handle::CType>(value)};
+}
+
+// The dynamic uniform buffer at binding 0, its offset is a dynamic offset so the info is the same for all the draws
+vk::DescriptorBufferInfo uniform_info()
+{
+	return {.buffer = make_handle<vk::Buffer>(1), .offset = 0, .range = 256};
+}
+
+// The textures of the material at the next bindings
+vk::DescriptorImageInfo texture_info(uint32_t material, uint32_t binding)
+{
+	return {.sampler     = make_handle<vk::Sampler>(1),
+	        .imageView   = make_handle<vk::ImageView>(1 + material * 64 + binding),
+	        .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal};
+}
+
+/**
+ * @brief Measures a function writing the infos of a draw and returning the key of its descriptor set
+ */
+template <typename DrawFunc>
+Result measure(DrawFunc &&draw)
+{
+	// The first draw of each material creates its descriptor set, and warms up the storage of the infos
+	std::unordered_map<size_t, uint32_t> descriptor_sets;
+	for (uint32_t material = 0; material < MATERIAL_COUNT; ++material)
+	{
+		descriptor_sets.emplace(draw(material), material);
+	}
+
+	size_t     misses      = 0;
+	size_t     allocations = allocation_count;
+	vkb::Timer timer;
+	timer.start();
+	for (size_t i = 0; i < DRAW_COUNT; ++i)
+	{
+		uint32_t material = static_cast<uint32_t>(i % MATERIAL_COUNT);
+		auto     it       = descriptor_sets.find(draw(material));
+		if (it == descriptor_sets.end() || it->second != material)
+		{
+			++misses;
+		}
+	}
+	double seconds = timer.stop();
+	allocations    = allocation_count - allocations;
+
+	if (misses)
+	{
+		LOGW("Binding benchmark looked up the wrong descriptor set for {} draws", misses);
+	}
+
+	return {seconds * 1e9 / DRAW_COUNT, static_cast<double>(allocations) / DRAW_COUNT};
+}
+
+/**
+ * @brief Writes the infos into BindingMaps built for each draw, as the command buffer did before using binding tables
+ */
+Result measure_binding_maps(uint32_t binding_count)
+{
+	auto layout = make_handle<vk::DescriptorSetLayout>(1);
+
+	return measure([&](uint32_t material) {
+		CountingBindingMap<vk::DescriptorBufferInfo> buffer_infos;
+		CountingBindingMap<vk::DescriptorImageInfo>  image_infos;
+
+		buffer_infos[0][0] = uniform_info();
+		for (uint32_t binding = 1; binding < binding_count; ++binding)
+		{
+			image_infos[binding][0] = texture_info(material, binding);
+		}
+
+		size_t hash = 0;
+		vkb::hash_combine(hash, layout);
+		vkb::hash_combine(hash, hash_map(buffer_infos));
+		vkb::hash_combine(hash, hash_map(image_infos));
+		return hash;
+	});
+}
+
+/**
+ * @brief Writes the infos into binding tables kept between draws, as the command buffer does
+ */
+Result measure_binding_tables(uint32_t binding_count)
+{
+	auto layout = make_handle<vk::DescriptorSetLayout>(1);
+
+	CountingBindingTable<vk::DescriptorBufferInfo> buffer_infos;
+	CountingBindingTable<vk::DescriptorImageInfo>  image_infos;
+
+	return measure([&](uint32_t material) {
+		buffer_infos.clear();
+		image_infos.clear();
+
+		buffer_infos.set(0, 0, uniform_info());
+		for (uint32_t binding = 1; binding < binding_count; ++binding)
+		{
+			image_infos.set(binding, 0, texture_info(material, binding));
+		}
+
+		size_t hash = 0;
+		vkb::hash_combine(hash, layout);
+		vkb::hash_combine(hash, buffer_infos.get_hash());
+		vkb::hash_combine(hash, image_infos.get_hash());
+		return hash;
+	});
+}
+}        // namespace
+
+BindingBenchmark::BindingBenchmark() :
+    BindingBenchmarkTags("Binding Benchmark",
+                         "Measures the cost and the allocations per draw of writing descriptor infos.",
+                         {},
+                         {{"binding-benchmark", "Measure the cost and the allocations per draw of writing descriptor infos, and exit"}})
+{
+}
+
+void BindingBenchmark::run() const
+{
+	LOGI("");
+	LOGI("Descriptor infos written per draw, time in ns and heap allocations");
+	LOGI("");
+	LOGI("{:>10} {:>12} {:>12} {:>12} {:>12}", "bindings", "map time", "map allocs", "table time", "table allocs");
+
+	// Tables store 16 entries inline, the largest set spills to their vector
+	for (uint32_t binding_count : {4u, 8u, 16u, 32u})
+	{
+		Result maps   = measure_binding_maps(binding_count);
+		Result tables = measure_binding_tables(binding_count);
+
+		LOGI("{:>10} {:>12.1f} {:>12.2f} {:>12.1f} {:>12.2f}",
+		     binding_count,
+		     maps.nanoseconds_per_draw,
+		     maps.allocations_per_draw,
+		     tables.nanoseconds_per_draw,
+		     tables.allocations_per_draw);
+	}
+
+	LOGI("");
+
+	platform->close();
+}
+
+bool BindingBenchmark::handle_command(std::deque<std::string> &arguments) const
+{
+	assert(!arguments.empty());
+	if (arguments[0] == "binding-benchmark")
+	{
+		run();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
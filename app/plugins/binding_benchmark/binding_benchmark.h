@@ -0,0 +1,48 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/platform.h"
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using BindingBenchmarkTags = vkb::PluginBase<vkb::tags::Entrypoint>;
+
+/**
+ * @brief Binding Benchmark
+ *
+ * Measures the cost per draw of writing the descriptor infos of a set and computing the key of its cached descriptor set,
+ * with the binding tables kept by the command buffer and with the BindingMaps they replaced, and counts the heap
+ * allocations made per draw. Allocations are counted by giving the containers measured an allocator counting them.
+ *
+ * Usage: vulkan_samples binding-benchmark
+ */
+class BindingBenchmark : public BindingBenchmarkTags
+{
+  public:
+	BindingBenchmark();
+
+	virtual ~BindingBenchmark() = default;
+
+	bool handle_command(std::deque<std::string> &arguments) const override;
+
+  private:
+	void run() const;
+};
+}        // namespace plugins
@@ -0,0 +1,229 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hash_benchmark.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <random>
+
+#include "common/content_hash.h"
+#include "timer.h"
+
+namespace plugins
+{
+namespace
+{
+// Hashes at least this many bytes per measurement, so that small buffers are timed over many iterations
+constexpr size_t MIN_BYTES_PER_MEASUREMENT = 512 * 1024 * 1024;
+
+// Size of the pieces of the streaming measurement, as read from a file
+constexpr size_t STREAMING_PIECE_SIZE = 64 * 1024;
+
+/**
+ * @brief Expected digests of the first bytes of the known answer input, whose bytes follow a fixed linear congruential sequence
+ */
+struct KnownAnswer
+{
+	size_t   size;
+	uint64_t seed;
+	uint64_t digest64;
+	uint64_t digest128_high;        // The low half of the 128-bit digest is the 64-bit digest
+};
+
+constexpr KnownAnswer KNOWN_ANSWERS[] = {
+	{0, 0, 0xfb08f5779ee50f9a, 0x318972f279cb9cad},
+	{1, 0, 0xc5e38ff4f3881ca8, 0xe32497227f440c89},
+	{3, 0, 0x74c817c15ca13cb0, 0xe95b8844de035d0b},
+	{16, 0, 0x2fcb20e5176c281a, 0xfe809ab2c98e71a5},
+	{17, 0, 0x51ccad3dd90b063d, 0x208d8c96d4fc1c97},
+	{129, 0, 0xc184b2247cf21a75, 0x0d1921ad785ba468},
+	{240, 0, 0x34ee4a445e374727, 0xbdf6b5b0800e5984},
+	{257, 0, 0x85fc3af71f6fa8d5, 0xd8c1d7d65e89d88e},
+	{4096, 0, 0xd24bdca7b6e121fe, 0x781faf1b3a5c1d7a},
+	{vkb::ContentHasher::CHUNK_SIZE + 1, 0, 0x76458029b8afda2d, 0xa3e9f764266b3c05},
+	{3 * vkb::ContentHasher::CHUNK_SIZE + 5, 0, 0x98ed31d5b6c4aa8b, 0xe1747db95327f037},
+	{0, 0x9e3779b97f4a7c15, 0xd603e4064dbcdc12, 0x9b9c8d9b1ce0079e},
+	{1, 0x9e3779b97f4a7c15, 0xfc1439c6761fba1d, 0x2cfda8de6b7a3df3},
+	{3, 0x9e3779b97f4a7c15, 0xec315e77dae44246, 0x49890565d05900c6},
+	{16, 0x9e3779b97f4a7c15, 0xcce3fc237f2fb2f5, 0x3860b3ffcd233169},
+	{17, 0x9e3779b97f4a7c15, 0x9f01b02977016cd8, 0x1426fbb3049e63e8},
+	{129, 0x9e3779b97f4a7c15, 0x6db4e23524105bd1, 0x8db7f4a3e4d4714a},
+	{240, 0x9e3779b97f4a7c15, 0x018f7300cef80479, 0x8ead2a32ddcc47d8},
+	{257, 0x9e3779b97f4a7c15, 0x768443c4b64644a8, 0x79f5d7685c8ca9d2},
+	{4096, 0x9e3779b97f4a7c15, 0xc420edd7ff43dfde, 0x08e1e85fb44c623a},
+	{vkb::ContentHasher::CHUNK_SIZE + 1, 0x9e3779b97f4a7c15, 0x7c01fafba854d2c8, 0xc76abc33e8c75bac},
+	{3 * vkb::ContentHasher::CHUNK_SIZE + 5, 0x9e3779b97f4a7c15, 0x512fe2a03ed1f65d, 0xf8798a9cbc94841f},
+};
+
+/**
+ * @brief Checks the digests against the known answers, one-shot, streamed in uneven pieces and on several threads
+ * @return True if all the digests match, which they must on every target and with or without SIMD
+ */
+bool check_known_answers()
+{
+	std::vector<uint8_t> input(3 * vkb::ContentHasher::CHUNK_SIZE + 5);
+	uint32_t             state = 0x12345678;
+	for (auto &byte : input)
+	{
+		state = state * 1664525 + 1013904223;
+		byte  = static_cast<uint8_t>(state >> 24);
+	}
+
+	bool passed = true;
+	for (auto const &answer : KNOWN_ANSWERS)
+	{
+		std::span<const uint8_t> data{input.data(), answer.size};
+
+		vkb::ContentHasher hasher{answer.seed};
+		for (size_t offset = 0; offset < data.size(); offset += 777)
+		{
+			hasher.update(data.subspan(offset, std::min<size_t>(777, data.size() - offset)));
+		}
+
+		vkb::Hash128 digest128 = vkb::content_hash128(data, answer.seed);
+
+		std::array<uint64_t, 5> digests{vkb::content_hash64(data, answer.seed),
+		                                vkb::content_hash64(data, answer.seed, 4),
+		                                hasher.digest64(),
+		                                digest128.low,
+		                                hasher.digest128().low};
+		if (std::ranges::any_of(digests, [&answer](uint64_t digest) { return digest != answer.digest64; }) ||
+		    digest128.high != answer.digest128_high)
+		{
+			LOGE("Content hash of {} bytes with seed {:016x} is {:016x}, expected {:016x}", answer.size, answer.seed, digests[0], answer.digest64);
+			passed = false;
+		}
+	}
+	return passed;
+}
+
+/**
+ * @brief The fold of 8-byte words through glm::detail::hash_combine, previously used for image data
+ */
+uint64_t fold_hash(std::span<const uint8_t> data)
+{
+	auto hash_combine = [](size_t &hash, size_t word) { hash ^= word + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+
+	size_t hash   = 0;
+	size_t offset = 0;
+	for (; offset + sizeof(size_t) < data.size(); offset += sizeof(size_t))
+	{
+		size_t word;
+		std::memcpy(&word, data.data() + offset, sizeof(word));
+		hash_combine(hash, word);
+	}
+	if (offset < data.size())
+	{
+		size_t word = 0;
+		std::memcpy(&word, data.data() + offset, data.size() - offset);
+		hash_combine(hash, word);
+	}
+	return hash;
+}
+
+/**
+ * @brief Measures the throughput of a hash function over a buffer, in GB/s
+ */
+double measure(std::span<const uint8_t> data, std::function<uint64_t(std::span<const uint8_t>)> const &hash)
+{
+	size_t iteration_count = std::max<size_t>(1, MIN_BYTES_PER_MEASUREMENT / data.size());
+
+	// Results are accumulated so that the calls are not optimized out
+	uint64_t   checksum = 0;
+	vkb::Timer timer;
+	timer.start();
+	for (size_t i = 0; i < iteration_count; ++i)
+	{
+		checksum ^= hash(data);
+	}
+	double seconds = timer.stop();
+
+	LOGD("Hash benchmark checksum {:016x}", checksum);
+	return static_cast<double>(data.size() * iteration_count) / seconds / 1e9;
+}
+}        // namespace
+
+HashBenchmark::HashBenchmark() :
+    HashBenchmarkTags("Hash Benchmark",
+                      "Checks the content hash against known answers and measures its throughput.",
+                      {},
+                      {{"hash-benchmark", "Check the content hash against known answers, measure its throughput, and exit"}})
+{
+}
+
+void HashBenchmark::run() const
+{
+	if (!check_known_answers())
+	{
+		LOGE("Content hash does not match its known answers, the throughput is not measured");
+		platform->close();
+		return;
+	}
+	LOGI("Content hash matches its {} known answers", std::size(KNOWN_ANSWERS));
+
+	std::vector<uint8_t> data(256 * 1024 * 1024);
+	std::mt19937_64      generator{0};
+	for (size_t i = 0; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t))
+	{
+		uint64_t value = generator();
+		std::memcpy(data.data() + i, &value, sizeof(value));
+	}
+
+	LOGI("");
+	LOGI("Content hash throughput, in GB/s");
+	LOGI("");
+	LOGI("{:>12} {:>12} {:>12} {:>12} {:>12}", "size", "fold", "one-shot", "streaming", "parallel");
+
+	for (size_t size : {size_t{64}, size_t{4} * 1024, size_t{1024} * 1024, size_t{16} * 1024 * 1024, data.size()})
+	{
+		std::span<const uint8_t> buffer{data.data(), size};
+
+		double fold      = measure(buffer, fold_hash);
+		double one_shot  = measure(buffer, [](std::span<const uint8_t> bytes) { return vkb::content_hash64(bytes); });
+		double streaming = measure(buffer, [](std::span<const uint8_t> bytes) {
+			vkb::ContentHasher hasher;
+			for (size_t offset = 0; offset < bytes.size(); offset += STREAMING_PIECE_SIZE)
+			{
+				hasher.update(bytes.subspan(offset, std::min(STREAMING_PIECE_SIZE, bytes.size() - offset)));
+			}
+			return hasher.digest64();
+		});
+		double parallel  = measure(buffer, [](std::span<const uint8_t> bytes) { return vkb::content_hash64(bytes, 0, 0); });
+
+		LOGI("{:>12} {:>12.2f} {:>12.2f} {:>12.2f} {:>12.2f}", size, fold, one_shot, streaming, parallel);
+	}
+
+	LOGI("");
+
+	platform->close();
+}
+
+bool HashBenchmark::handle_command(std::deque<std::string> &arguments) const
+{
+	assert(!arguments.empty());
+	if (arguments[0] == "hash-benchmark")
+	{
+		run();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
@@ -0,0 +1,48 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/platform.h"
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using HashBenchmarkTags = vkb::PluginBase<vkb::tags::Entrypoint>;
+
+/**
+ * @brief Hash Benchmark
+ *
+ * Measures the throughput of the content hash used for image, shader and cache keys, hashing buffers of several sizes
+ * at once, in pieces as when streaming from a file, and with several threads. The fold of 8-byte words through
+ * hash_combine that the content hash replaced is measured as a reference.
+ *
+ * Usage: vulkan_samples hash-benchmark
+ */
+class HashBenchmark : public HashBenchmarkTags
+{
+  public:
+	HashBenchmark();
+
+	virtual ~HashBenchmark() = default;
+
+	bool handle_command(std::deque<std::string> &arguments) const override;
+
+  private:
+	void run() const;
+};
+}        // namespace plugins
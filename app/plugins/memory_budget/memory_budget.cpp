@@ -0,0 +1,102 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_budget.h"
+
+#include "rendering/render_context.h"
+#include "scene_graph/components/image.h"
+#include "vulkan_sample.h"
+
+namespace plugins
+{
+MemoryBudget::MemoryBudget() :
+    MemoryBudgetTags("Memory Budget",
+                     "Keep the device memory used within a percentage of the memory budget, by dropping mip levels of unused textures.",
+                     {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart},
+                     {},
+                     {{"memory-budget", "Percentage of the device memory budget the sample may use, from 1 to 100"}})
+{
+}
+
+bool MemoryBudget::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "memory-budget")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"memory-budget\" is missing the percentage of the memory budget!");
+			return false;
+		}
+		auto percentage = std::stoul(arguments[1]);
+		if (percentage < 1 || 100 < percentage)
+		{
+			LOGE("Option \"memory-budget\" needs a percentage from 1 to 100!");
+			return false;
+		}
+		budget_fraction = static_cast<float>(percentage) / 100.0f;
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void MemoryBudget::on_update(float delta_time)
+{
+	if (budget_fraction == 0.0f)
+	{
+		return;
+	}
+
+	// Textures of the scene are registered before the frame is drawn, and again whenever the scene changes
+	vkb::rendering::RenderContextC *context = nullptr;
+	vkb::scene_graph::SceneC       *scene   = nullptr;
+	if (auto *app = dynamic_cast<vkb::VulkanSampleCpp *>(&platform->get_app()))
+	{
+		if (app->has_render_context() && app->has_scene())
+		{
+			context = &reinterpret_cast<vkb::rendering::RenderContextC &>(app->get_render_context());
+			scene   = &reinterpret_cast<vkb::scene_graph::SceneC &>(app->get_scene());
+		}
+	}
+	else if (auto *app = dynamic_cast<vkb::VulkanSampleC *>(&platform->get_app()))
+	{
+		if (app->has_render_context() && app->has_scene())
+		{
+			context = &app->get_render_context();
+			scene   = &app->get_scene();
+		}
+	}
+	if (!context || (registered && (scene->get_generation() == scene_generation)))
+	{
+		return;
+	}
+
+	context->enable_residency_management(budget_fraction).set_images(scene->get_components<vkb::sg::Image>());
+
+	scene_generation = scene->get_generation();
+	registered       = true;
+}
+
+void MemoryBudget::on_app_start(const std::string &app_info)
+{
+	registered = false;
+}
+}        // namespace plugins
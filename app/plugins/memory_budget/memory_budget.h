@@ -0,0 +1,58 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+class MemoryBudget;
+
+using MemoryBudgetTags = vkb::PluginBase<MemoryBudget, vkb::tags::Passive>;
+
+/**
+ * @brief Memory Budget
+ *
+ * Keeps the device memory used by a sample within a percentage of the memory budget of the device. While a heap is over
+ * budget, the least recently used textures of the scene lose their top mip levels, which are restored once the memory is
+ * available again. The memory used by textures, meshes, render targets and transient resources is shown in the stats.
+ *
+ * Usage: vulkan_sample sample afbc --memory-budget 50
+ *
+ */
+class MemoryBudget : public MemoryBudgetTags
+{
+  public:
+	MemoryBudget();
+
+	virtual ~MemoryBudget() = default;
+
+	void on_update(float delta_time) override;
+	void on_app_start(const std::string &app_info) override;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+  private:
+	float budget_fraction = 0.0f;
+
+	// Generation of the scene whose images were registered last
+	uint64_t scene_generation = 0;
+
+	bool registered = false;
+};
+}        // namespace plugins
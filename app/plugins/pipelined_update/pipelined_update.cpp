@@ -0,0 +1,118 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipelined_update.h"
+
+#include <algorithm>
+
+#include "vulkan_sample.h"
+
+namespace plugins
+{
+PipelinedUpdate::PipelinedUpdate() :
+    PipelinedUpdateTags("Pipelined Update",
+                        "Update the scene on a simulation thread while the previous frame is presented.",
+                        {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::OnAppClose},
+                        {},
+                        {{"pipelined-update", "Update the scene on a simulation thread, between the submission of a frame and the recording of the next"}})
+{
+}
+
+bool PipelinedUpdate::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "pipelined-update")
+	{
+		requested = true;
+
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void PipelinedUpdate::on_update(float delta_time)
+{
+	if (!requested)
+	{
+		return;
+	}
+
+	auto *sample_cpp = dynamic_cast<vkb::VulkanSampleCpp *>(&platform->get_app());
+	auto *sample_c   = dynamic_cast<vkb::VulkanSampleC *>(&platform->get_app());
+
+	if (!enabled)
+	{
+		// Samples load their scene while being prepared, so it exists by the first update
+		if (sample_cpp)
+		{
+			sample_cpp->set_pipelined_update(true);
+		}
+		else if (sample_c)
+		{
+			sample_c->set_pipelined_update(true);
+		}
+		enabled = true;
+		timer.start();
+		return;
+	}
+
+	// The statistics are those of the update joined by the previous frame
+	if (sample_cpp && sample_cpp->is_pipelined_update())
+	{
+		auto statistics = sample_cpp->get_scene_update_statistics();
+		update_time_ms += statistics.update_time_ms;
+		wait_time_ms += statistics.wait_time_ms;
+		++frame_count;
+	}
+	else if (sample_c && sample_c->is_pipelined_update())
+	{
+		auto statistics = sample_c->get_scene_update_statistics();
+		update_time_ms += statistics.update_time_ms;
+		wait_time_ms += statistics.wait_time_ms;
+		++frame_count;
+	}
+}
+
+void PipelinedUpdate::on_app_start(const std::string &app_info)
+{
+	enabled        = false;
+	frame_count    = 0;
+	update_time_ms = 0.0;
+	wait_time_ms   = 0.0;
+}
+
+void PipelinedUpdate::on_app_close(const std::string &app_id)
+{
+	if (!enabled || frame_count == 0)
+	{
+		return;
+	}
+
+	double seconds = timer.stop();
+
+	// The part of the update not waited for ran while the previous frame was presented and the next one waited for
+	double hidden_ms = std::max(update_time_ms - wait_time_ms, 0.0);
+	LOGI("Pipelined update of {}: {:.1f} frames/s over {} frames, scene update {:.3f} ms per frame, {:.0f}% of it hidden",
+	     app_id,
+	     frame_count / seconds,
+	     frame_count,
+	     update_time_ms / frame_count,
+	     update_time_ms > 0.0 ? 100.0 * hidden_ms / update_time_ms : 0.0);
+}
+}        // namespace plugins
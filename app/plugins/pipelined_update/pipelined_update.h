@@ -0,0 +1,67 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+#include "timer.h"
+
+namespace plugins
+{
+class PipelinedUpdate;
+
+using PipelinedUpdateTags = vkb::PluginBase<PipelinedUpdate, vkb::tags::Passive>;
+
+/**
+ * @brief Pipelined Update
+ *
+ * Updates the scene of a sample on a simulation thread, once the previous frame is submitted. The time spent updating the
+ * scene and waiting for the update is shown in the debug window. The frame rate, the update time and the part of it hidden
+ * behind the presentation and the wait for the next frame are logged when the sample closes.
+ *
+ * Usage: vulkan_sample sample afbc --pipelined-update
+ *
+ */
+class PipelinedUpdate : public PipelinedUpdateTags
+{
+  public:
+	PipelinedUpdate();
+
+	virtual ~PipelinedUpdate() = default;
+
+	void on_update(float delta_time) override;
+	void on_app_start(const std::string &app_info) override;
+	void on_app_close(const std::string &app_id) override;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+  private:
+	bool requested = false;
+
+	// Whether the pipelined update was enabled on the running sample
+	bool enabled = false;
+
+	// Totals over the frames recorded with the pipelined update, for the throughput logged when the sample closes
+	size_t frame_count = 0;
+
+	double update_time_ms = 0.0;
+
+	double wait_time_ms = 0.0;
+
+	vkb::Timer timer;
+};
+}        // namespace plugins
@@ -0,0 +1,307 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render_graph_check.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "rendering/render_graph.h"
+
+namespace plugins
+{
+namespace
+{
+using vkb::rendering::RenderGraph;
+using vkb::rendering::RenderGraphQueue;
+
+namespace access = vkb::rendering::access;
+
+constexpr vk::ImageSubresourceRange COLOR_RANGE{vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1};
+
+constexpr uint32_t GRAPHICS_FAMILY = 0;
+constexpr uint32_t COMPUTE_FAMILY  = 1;
+
+/**
+ * @brief Handles are only compared while compiling, any non-null value stands for a resource
+ */
+template <typename Handle>
+Handle make_handle(uint64_t value)
+{
+	return Handle{reinterpret_cast<typename Handle::CType>(value)};
+}
+
+vk::ImageMemoryBarrier2 image_barrier(vk::Image image, vk::PipelineStageFlags2 src_stages, vk::AccessFlags2 src_access,
+                                      vk::PipelineStageFlags2 dst_stages, vk::AccessFlags2 dst_access, vk::ImageLayout old_layout, vk::ImageLayout new_layout)
+{
+	return {.srcStageMask        = src_stages,
+	        .srcAccessMask       = src_access,
+	        .dstStageMask        = dst_stages,
+	        .dstAccessMask       = dst_access,
+	        .oldLayout           = old_layout,
+	        .newLayout           = new_layout,
+	        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	        .image               = image,
+	        .subresourceRange    = COLOR_RANGE};
+}
+
+vk::BufferMemoryBarrier2 buffer_barrier(vk::Buffer buffer, vk::PipelineStageFlags2 src_stages, vk::AccessFlags2 src_access,
+                                        vk::PipelineStageFlags2 dst_stages, vk::AccessFlags2 dst_access,
+                                        uint32_t src_queue_family = VK_QUEUE_FAMILY_IGNORED, uint32_t dst_queue_family = VK_QUEUE_FAMILY_IGNORED)
+{
+	return {.srcStageMask        = src_stages,
+	        .srcAccessMask       = src_access,
+	        .dstStageMask        = dst_stages,
+	        .dstAccessMask       = dst_access,
+	        .srcQueueFamilyIndex = src_queue_family,
+	        .dstQueueFamilyIndex = dst_queue_family,
+	        .buffer              = buffer,
+	        .offset              = 0,
+	        .size                = VK_WHOLE_SIZE};
+}
+
+bool compare(char const *name, RenderGraph const &graph, std::vector<RenderGraph::Submission> const &expected)
+{
+	if (graph.get_submissions() != expected)
+	{
+		LOGE("Render graph \"{}\" compiled to {} submissions, which differ from the {} expected ones", name, graph.get_submissions().size(), expected.size());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief A color attachment sampled by the next pass, which renders to the swapchain image
+ */
+bool check_sampled_read_after_write()
+{
+	auto color_image     = make_handle<vk::Image>(1);
+	auto swapchain_image = make_handle<vk::Image>(2);
+
+	RenderGraph graph;
+	uint32_t    color     = graph.import_image("Color", color_image, COLOR_RANGE);
+	uint32_t    swapchain = graph.import_image("Swapchain", swapchain_image, COLOR_RANGE);
+	graph.set_final_state(swapchain, access::present);
+
+	graph.add_pass("Scene").write(color, access::color_attachment_write);
+	graph.add_pass("Composite").read(color, access::fragment_shader_sampled_read).write(swapchain, access::color_attachment_write);
+
+	graph.compile(GRAPHICS_FAMILY, GRAPHICS_FAMILY);
+
+	auto const color_stage  = vk::PipelineStageFlagBits2::eColorAttachmentOutput;
+	auto const color_access = vk::AccessFlagBits2::eColorAttachmentRead | vk::AccessFlagBits2::eColorAttachmentWrite;
+
+	return compare("sampled read after write",
+	               graph,
+	               {{.queue          = RenderGraphQueue::Graphics,
+	                 .passes         = {{.pass     = 0,
+	                                     .barriers = {.image_barriers = {image_barrier(color_image, {}, {}, color_stage, color_access,
+	                                                                                   vk::ImageLayout::eUndefined, vk::ImageLayout::eColorAttachmentOptimal)}}},
+	                                    {.pass     = 1,
+	                                     .barriers = {.image_barriers = {image_barrier(color_image, color_stage, vk::AccessFlagBits2::eColorAttachmentWrite,
+	                                                                                   vk::PipelineStageFlagBits2::eFragmentShader, vk::AccessFlagBits2::eShaderRead,
+	                                                                                   vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::eShaderReadOnlyOptimal),
+	                                                                     image_barrier(swapchain_image, {}, {}, color_stage, color_access,
+	                                                                                   vk::ImageLayout::eUndefined, vk::ImageLayout::eColorAttachmentOptimal)}}}},
+	                 .final_barriers = {.image_barriers = {image_barrier(swapchain_image, color_stage, vk::AccessFlagBits2::eColorAttachmentWrite, {}, {},
+	                                                                     vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::ePresentSrcKHR)}}}});
+}
+
+/**
+ * @brief Reads in the layout the image is already in need no barrier
+ */
+bool check_reads_after_reads()
+{
+	RenderGraph graph;
+	uint32_t    image = graph.import_image("Texture", make_handle<vk::Image>(1), COLOR_RANGE, access::fragment_shader_sampled_read);
+	graph.set_final_state(image, access::fragment_shader_sampled_read);
+
+	graph.add_pass("Compute read").read(image, access::compute_shader_sampled_read).set_side_effects();
+	graph.add_pass("Fragment read").read(image, access::fragment_shader_sampled_read).set_side_effects();
+
+	graph.compile(GRAPHICS_FAMILY, GRAPHICS_FAMILY);
+
+	return compare("reads after reads", graph, {{.queue = RenderGraphQueue::Graphics, .passes = {{.pass = 0}, {.pass = 1}}}});
+}
+
+/**
+ * @brief A buffer written after being read only needs an execution dependency, then is made visible to the host
+ */
+bool check_write_after_read()
+{
+	auto particle_buffer = make_handle<vk::Buffer>(1);
+
+	RenderGraph graph;
+	uint32_t    buffer = graph.import_buffer("Particles", particle_buffer, 0, VK_WHOLE_SIZE, access::compute_shader_storage_read);
+	graph.set_final_state(buffer, access::host_read);
+
+	graph.add_pass("Simulate").write(buffer, access::compute_shader_storage_write);
+
+	graph.compile(GRAPHICS_FAMILY, GRAPHICS_FAMILY);
+
+	auto const compute_stage = vk::PipelineStageFlagBits2::eComputeShader;
+
+	return compare("write after read",
+	               graph,
+	               {{.queue          = RenderGraphQueue::Graphics,
+	                 .passes         = {{.pass     = 0,
+	                                     .barriers = {.buffer_barriers = {buffer_barrier(particle_buffer, compute_stage, {}, compute_stage,
+	                                                                                     vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite)}}}},
+	                 .final_barriers = {.buffer_barriers = {buffer_barrier(particle_buffer, compute_stage, vk::AccessFlagBits2::eShaderWrite,
+	                                                                       vk::PipelineStageFlagBits2::eHost, vk::AccessFlagBits2::eHostRead)}}}});
+}
+
+/**
+ * @brief Passes whose writes are never read, or are overwritten before being read, are culled
+ */
+bool check_culling()
+{
+	auto output_image = make_handle<vk::Image>(2);
+
+	RenderGraph graph;
+	uint32_t    unused = graph.import_image("Unused", make_handle<vk::Image>(1), COLOR_RANGE);
+	uint32_t    output = graph.import_image("Output", output_image, COLOR_RANGE);
+	graph.set_final_state(output, access::transfer_read);
+
+	graph.add_pass("Unused").write(unused, access::color_attachment_write);
+	graph.add_pass("Overwritten").write(output, access::transfer_write);
+	graph.add_pass("Output").write(output, access::transfer_write);
+
+	graph.compile(GRAPHICS_FAMILY, GRAPHICS_FAMILY);
+
+	if (!graph.is_culled(0) || !graph.is_culled(1) || graph.is_culled(2))
+	{
+		LOGE("Render graph \"culling\" kept the wrong passes");
+		return false;
+	}
+
+	auto const transfer_stage = vk::PipelineStageFlagBits2::eTransfer;
+
+	return compare("culling",
+	               graph,
+	               {{.queue          = RenderGraphQueue::Graphics,
+	                 .passes         = {{.pass     = 2,
+	                                     .barriers = {.image_barriers = {image_barrier(output_image, {}, {}, transfer_stage, vk::AccessFlagBits2::eTransferWrite,
+	                                                                                   vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal)}}}},
+	                 .final_barriers = {.image_barriers = {image_barrier(output_image, transfer_stage, vk::AccessFlagBits2::eTransferWrite, transfer_stage,
+	                                                                     vk::AccessFlagBits2::eTransferRead, vk::ImageLayout::eTransferDstOptimal,
+	                                                                     vk::ImageLayout::eTransferSrcOptimal)}}}});
+}
+
+/**
+ * @brief A buffer written on the async compute queue and read as vertices on the graphics queue
+ * @param compute_family Family of the compute queue, ownership is only transferred when it differs from the graphics family
+ */
+bool check_async_compute(uint32_t compute_family)
+{
+	auto particle_buffer = make_handle<vk::Buffer>(1);
+
+	RenderGraph graph;
+	uint32_t    buffer = graph.import_buffer("Particles", particle_buffer);
+
+	graph.add_pass("Simulate", RenderGraphQueue::AsyncCompute).write(buffer, access::compute_shader_storage_write);
+	graph.add_pass("Draw").read(buffer, access::vertex_input_read).set_side_effects();
+
+	graph.compile(GRAPHICS_FAMILY, compute_family);
+
+	auto const vertex_stage = vk::PipelineStageFlagBits2::eVertexInput;
+
+	std::vector<RenderGraph::Submission> expected{{.queue = RenderGraphQueue::AsyncCompute, .passes = {{.pass = 0}}, .signals = true},
+	                                              {.queue  = RenderGraphQueue::Graphics,
+	                                               .waits  = {{.submission = 0, .stage_mask = vertex_stage}},
+	                                               .passes = {{.pass = 1}}}};
+	if (compute_family != GRAPHICS_FAMILY)
+	{
+		// The release ends the compute submission, the acquire starts the draw
+		expected[0].final_barriers.buffer_barriers = {buffer_barrier(particle_buffer, vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderWrite,
+		                                                             {}, {}, compute_family, GRAPHICS_FAMILY)};
+		expected[1].passes[0].barriers.buffer_barriers = {buffer_barrier(particle_buffer, vertex_stage, {}, vertex_stage,
+		                                                                 vk::AccessFlagBits2::eVertexAttributeRead | vk::AccessFlagBits2::eIndexRead,
+		                                                                 compute_family, GRAPHICS_FAMILY)};
+	}
+
+	return compare(compute_family != GRAPHICS_FAMILY ? "async compute with ownership transfer" : "async compute on the graphics family", graph, expected);
+}
+
+/**
+ * @brief A pass using an image in two layouts cannot be compiled
+ */
+bool check_conflicting_layouts()
+{
+	RenderGraph graph;
+	uint32_t    image = graph.import_image("Texture", make_handle<vk::Image>(1), COLOR_RANGE);
+
+	graph.add_pass("Conflict").read(image, access::fragment_shader_sampled_read).write(image, access::color_attachment_write);
+
+	try
+	{
+		graph.compile(GRAPHICS_FAMILY, GRAPHICS_FAMILY);
+	}
+	catch (std::runtime_error const &)
+	{
+		return true;
+	}
+
+	LOGE("Render graph \"conflicting layouts\" compiled a pass using an image in two layouts");
+	return false;
+}
+}        // namespace
+
+RenderGraphCheck::RenderGraphCheck() :
+    RenderGraphCheckTags("Render Graph Check",
+                         "Checks the barriers computed by the render graph against the expected ones.",
+                         {},
+                         {{"render-graph-check", "Check the barriers computed by the render graph, and exit"}})
+{
+}
+
+void RenderGraphCheck::run() const
+{
+	bool results[] = {check_sampled_read_after_write(),
+	                  check_reads_after_reads(),
+	                  check_write_after_read(),
+	                  check_culling(),
+	                  check_async_compute(GRAPHICS_FAMILY),
+	                  check_async_compute(COMPUTE_FAMILY),
+	                  check_conflicting_layouts()};
+
+	size_t passed = std::ranges::count(results, true);
+	if (passed == std::size(results))
+	{
+		LOGI("Render graph matches its {} expected graphs", passed);
+	}
+	else
+	{
+		LOGE("Render graph matches {} of its {} expected graphs", passed, std::size(results));
+	}
+
+	platform->close();
+}
+
+bool RenderGraphCheck::handle_command(std::deque<std::string> &arguments) const
+{
+	assert(!arguments.empty());
+	if (arguments[0] == "render-graph-check")
+	{
+		run();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
@@ -0,0 +1,48 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/platform.h"
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using RenderGraphCheckTags = vkb::PluginBase<vkb::tags::Entrypoint>;
+
+/**
+ * @brief Render Graph Check
+ *
+ * Compiles small render graphs and compares their submissions and barriers against the expected ones, without a device:
+ * layout transitions after writes, reads after reads, write after read hazards, culled passes, and resources shared by the
+ * graphics and the async compute queue, with and without a queue family ownership transfer.
+ *
+ * Usage: vulkan_samples render-graph-check
+ */
+class RenderGraphCheck : public RenderGraphCheckTags
+{
+  public:
+	RenderGraphCheck();
+
+	virtual ~RenderGraphCheck() = default;
+
+	bool handle_command(std::deque<std::string> &arguments) const override;
+
+  private:
+	void run() const;
+};
+}        // namespace plugins
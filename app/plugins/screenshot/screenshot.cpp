@@ -23,15 +23,19 @@
 
 #include "common/utils.h"
 #include "rendering/render_context.h"
+#include "vulkan_sample.h"
 
 namespace plugins
 {
 Screenshot::Screenshot() :
     ScreenshotTags("Screenshot",
-                   "Save a screenshot of a specific frame",
-                   {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::PostDraw},
+                   "Save a screenshot of a specific frame or of a range of frames",
+                   {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart},
                    {},
-                   {{"screenshot", "Take a screenshot at a given frame"}, {"screenshot-output", "Declare an output name for the image"}})
+                   {{"screenshot", "Take a screenshot at a given frame"},
+                    {"screenshot-output", "Declare an output name for the image"},
+                    {"capture-range", "Capture every frame from a first to a last frame, inclusive"},
+                    {"capture-format", "File format of the captures: png (default), qoi or raw"}})
 {
 }
 
@@ -52,6 +56,55 @@ bool Screenshot::handle_option(std::deque<std::string> &arguments)
 		arguments.pop_front();
 		return true;
 	}
+	else if (option == "capture-range")
+	{
+		if (arguments.size() < 3)
+		{
+			LOGE("Option \"capture-range\" is missing the first and last frame indices to capture!");
+			return false;
+		}
+		range_first = static_cast<uint32_t>(std::stoul(arguments[1]));
+		range_last  = static_cast<uint32_t>(std::stoul(arguments[2]));
+		if (range_first == 0 || range_last < range_first)
+		{
+			LOGE("Option \"capture-range\" needs a first frame of at least 1, and a last frame after the first!");
+			return false;
+		}
+
+		arguments.pop_front();
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "capture-format")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"capture-format\" is missing the file format!");
+			return false;
+		}
+		if (arguments[1] == "png")
+		{
+			format = vkb::rendering::CaptureFormat::Png;
+		}
+		else if (arguments[1] == "qoi")
+		{
+			format = vkb::rendering::CaptureFormat::Qoi;
+		}
+		else if (arguments[1] == "raw")
+		{
+			format = vkb::rendering::CaptureFormat::Raw;
+		}
+		else
+		{
+			LOGE("Option \"capture-format\" has an unknown file format \"{}\"!", arguments[1]);
+			return false;
+		}
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
 	else if (option == "screenshot-output")
 	{
 		if (arguments.size() < 2)
@@ -72,35 +125,67 @@ bool Screenshot::handle_option(std::deque<std::string> &arguments)
 void Screenshot::on_update(float delta_time)
 {
 	current_frame++;
+
+	bool in_range = range_first <= current_frame && current_frame <= range_last;
+	if (current_frame != frame_number && !in_range)
+	{
+		return;
+	}
+
+	// Request the capture before the frame is drawn, so that it is copied before being presented
+	vkb::rendering::RenderContextC *context = nullptr;
+	if (auto *app = dynamic_cast<vkb::VulkanSampleCpp *>(&platform->get_app()))
+	{
+		if (app->has_render_context())
+		{
+			context = &reinterpret_cast<vkb::rendering::RenderContextC &>(app->get_render_context());
+		}
+	}
+	else if (auto *app = dynamic_cast<vkb::VulkanSampleC *>(&platform->get_app()))
+	{
+		if (app->has_render_context())
+		{
+			context = &app->get_render_context();
+		}
+	}
+	if (!context)
+	{
+		return;
+	}
+
+	std::string const &path = output_path_set ? output_path : default_output_path;
+	if (current_frame == frame_number)
+	{
+		context->request_capture({.filename = path, .format = format});
+	}
+	if (in_range)
+	{
+		context->request_capture({.filename = fmt::format("{}-{:05}", path, current_frame), .format = format});
+	}
 }
 
 void Screenshot::on_app_start(const std::string &name)
 {
 	current_app_name = name;
 	current_frame    = 0;
+
+	// Named once, so that all the frames of a range share the same prefix
+	default_output_path = get_default_output_path();
 }
 
-void Screenshot::on_post_draw(vkb::rendering::RenderContextC &context)
+std::string Screenshot::get_default_output_path() const
 {
-	if (current_frame == frame_number)
-	{
-		if (!output_path_set)
-		{
-			// Create generic image path. <app name>-<current timestamp>.png
-			auto        timestamp = std::chrono::system_clock::now();
-			std::time_t now_tt    = std::chrono::system_clock::to_time_t(timestamp);
-			std::tm     tm        = *std::localtime(&now_tt);
+	// Create generic image path. <app name>-<current timestamp>
+	auto        timestamp = std::chrono::system_clock::now();
+	std::time_t now_tt    = std::chrono::system_clock::to_time_t(timestamp);
+	std::tm     tm        = *std::localtime(&now_tt);
 
-			char buffer[30];
-			strftime(buffer, sizeof(buffer), "%G-%m-%d---%H-%M-%S", &tm);
+	char buffer[30];
+	strftime(buffer, sizeof(buffer), "%G-%m-%d---%H-%M-%S", &tm);
 
-			std::stringstream stream;
-			stream << current_app_name << "-" << buffer;
+	std::stringstream stream;
+	stream << current_app_name << "-" << buffer;
 
-			output_path = stream.str();
-		}
-
-		vkb::screenshot(context, output_path);
-	}
+	return stream.str();
 }
 }        // namespace plugins
\ No newline at end of file
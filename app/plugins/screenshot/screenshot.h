@@ -20,6 +20,7 @@
 
 #include "filesystem/legacy.h"
 #include "platform/plugins/plugin_base.h"
+#include "rendering/frame_capture.h"
 
 namespace plugins
 {
@@ -30,9 +31,13 @@ using ScreenshotTags = vkb::PluginBase<Screenshot, vkb::tags::Passive>;
 /**
  * @brief Screenshot
  *
- * Capture a screen shot of the last rendered image at a given frame. The output can also be named
+ * Capture a screen shot of the last rendered image at a given frame, or of every frame in a range. The output can also be named
+ *
+ * Captures do not stall the application: the images are read back once their frames complete, and written by worker threads.
+ * Frames of a range are written to "<output>-<frame>", and QOI or raw RGBA8 files can be used to keep up with long ranges.
  *
  * Usage: vulkan_sample sample afbc --screenshot 1 --screenshot-output afbc-screenshot
+ *        vulkan_sample sample afbc --capture-range 100 200 --capture-format qoi --screenshot-output afbc
  *
  */
 class Screenshot : public ScreenshotTags
@@ -44,16 +49,22 @@ class Screenshot : public ScreenshotTags
 
 	void on_update(float delta_time) override;
 	void on_app_start(const std::string &app_info) override;
-	void on_post_draw(vkb::rendering::RenderContextC &context) override;
 
 	bool handle_option(std::deque<std::string> &arguments) override;
 
   private:
+	std::string get_default_output_path() const;
+
 	uint32_t    current_frame = 0;
-	uint32_t    frame_number;
+	uint32_t    frame_number  = 0;
 	std::string current_app_name;
 
+	uint32_t                      range_first = 0;
+	uint32_t                      range_last  = 0;
+	vkb::rendering::CaptureFormat format      = vkb::rendering::CaptureFormat::Png;
+
 	bool        output_path_set = false;
 	std::string output_path;
+	std::string default_output_path;
 };
 }        // namespace plugins
\ No newline at end of file
@@ -0,0 +1,234 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transform_benchmark.h"
+
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <random>
+
+#include "scene_graph/components/transform.h"
+#include "scene_graph/node.h"
+#include "scene_graph/transform_hierarchy.h"
+#include "timer.h"
+
+namespace plugins
+{
+namespace
+{
+// Number of children of each node, the trees are complete so that their depth grows with the log of the node count
+constexpr size_t BRANCHING = 4;
+
+// Each measurement is averaged over this many updates
+constexpr uint32_t ITERATIONS = 10;
+
+// Largest difference between the world matrices of the hierarchy and of the lazy update
+constexpr float TOLERANCE = 1e-3f;
+
+using NodeCpp = vkb::scene_graph::NodeCpp;
+
+/**
+ * @brief Builds a complete tree with random local transforms, the parent of node i is node (i - 1) / BRANCHING
+ * @note Nodes are kept in a deque, as their transform refers to them and they must not move
+ */
+void build_tree(std::deque<NodeCpp> &nodes, size_t count)
+{
+	std::mt19937                          generator{0};
+	std::uniform_real_distribution<float> distribution{-1.0f, 1.0f};
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		auto &node = nodes.emplace_back(i, "");
+
+		auto &transform = node.get_transform();
+		transform.set_translation({distribution(generator), distribution(generator), distribution(generator)});
+		transform.set_rotation(glm::angleAxis(distribution(generator), glm::normalize(glm::vec3{1.0f, distribution(generator), 0.5f})));
+		transform.set_scale(glm::vec3{1.0f + 0.1f * distribution(generator)});
+
+		if (i > 0)
+		{
+			auto &parent = nodes[(i - 1) / BRANCHING];
+			parent.add_child(node);
+			node.set_parent(parent);
+		}
+	}
+}
+
+/**
+ * @brief Changes the translation of every stride-th node by offset, which marks it dirty
+ */
+void change(std::deque<NodeCpp> &nodes, size_t stride, glm::vec3 const &offset = glm::vec3{0.0f})
+{
+	for (size_t i = 0; i < nodes.size(); i += stride)
+	{
+		auto &transform = nodes[i].get_transform();
+		transform.set_translation(transform.get_translation() + offset);
+	}
+}
+
+float max_difference(glm::mat4 const &a, glm::mat4 const &b)
+{
+	float difference = 0.0f;
+	for (int column = 0; column < 4; ++column)
+	{
+		for (int row = 0; row < 4; ++row)
+		{
+			difference = std::max(difference, std::abs(a[column][row] - b[column][row]));
+		}
+	}
+	return difference;
+}
+
+/**
+ * @brief Checks the world matrices of the hierarchy against the lazy update, right after a build, when read between a
+ *        change and the next update, and after that update
+ * @return True if all world matrices match
+ */
+bool check(std::deque<NodeCpp> &nodes, std::vector<glm::mat4> const &expected, vkb::sg::TransformHierarchy &hierarchy)
+{
+	float difference = 0.0f;
+
+	hierarchy.update();
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		difference = std::max(difference, max_difference(nodes[i].get_transform().get_world_matrix(), expected[i]));
+	}
+
+	// Reads before the update compose the changed local matrices, and must give the same result as the update
+	change(nodes, 100, glm::vec3{0.25f});
+	std::vector<glm::mat4> changed(nodes.size());
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		changed[i] = nodes[i].get_transform().get_world_matrix();
+	}
+
+	hierarchy.update();
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		difference = std::max(difference, max_difference(nodes[i].get_transform().get_world_matrix(), changed[i]));
+	}
+
+	if (difference > TOLERANCE)
+	{
+		LOGE("World matrices of {} nodes differ by up to {}", nodes.size(), difference);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Measures the lazy update of nodes outside of a hierarchy, reading the world matrix of every node after all
+ *        of them changed, in ms
+ */
+double measure_lazy(std::deque<NodeCpp> &nodes, std::vector<glm::mat4> &world_matrices)
+{
+	double total = 0.0;
+	for (uint32_t iteration = 0; iteration < ITERATIONS; ++iteration)
+	{
+		change(nodes, 1);
+
+		vkb::Timer timer;
+		timer.start();
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			world_matrices[i] = nodes[i].get_transform().get_world_matrix();
+		}
+		total += timer.stop<vkb::Timer::Milliseconds>();
+	}
+	return total / ITERATIONS;
+}
+
+/**
+ * @brief Measures the hierarchy update after every stride-th node changed, in ms
+ */
+double measure_hierarchy(std::deque<NodeCpp> &nodes, vkb::sg::TransformHierarchy &hierarchy, size_t stride)
+{
+	double total = 0.0;
+	for (uint32_t iteration = 0; iteration < ITERATIONS; ++iteration)
+	{
+		change(nodes, stride);
+
+		vkb::Timer timer;
+		timer.start();
+		hierarchy.update();
+		total += timer.stop<vkb::Timer::Milliseconds>();
+	}
+	return total / ITERATIONS;
+}
+}        // namespace
+
+TransformBenchmark::TransformBenchmark() :
+    TransformBenchmarkTags("Transform Benchmark",
+                           "Measures the world matrix update of large node trees.",
+                           {},
+                           {{"transform-benchmark", "Measure the world matrix update of node trees from 10k to 1M nodes, and exit"}})
+{
+}
+
+void TransformBenchmark::run() const
+{
+	LOGI("");
+	LOGI("World matrix update, in ms, averaged over {} updates", ITERATIONS);
+	LOGI("");
+	LOGI("{:>10} {:>8} {:>10} {:>10} {:>10} {:>10}", "nodes", "levels", "lazy", "serial", "parallel", "1% dirty");
+
+	for (size_t count : {size_t{10000}, size_t{100000}, size_t{1000000}})
+	{
+		// Declared before the hierarchy, which unregisters the transforms when it is destroyed
+		std::deque<NodeCpp> nodes;
+		build_tree(nodes, count);
+
+		std::vector<glm::mat4> expected(nodes.size());
+		double                 lazy = measure_lazy(nodes, expected);
+
+		vkb::sg::TransformHierarchy hierarchy;
+		hierarchy.build(nodes.front());
+
+		if (!check(nodes, expected, hierarchy))
+		{
+			LOGE("Transform hierarchy does not match the lazy update, it is not measured");
+			break;
+		}
+
+		double parallel = measure_hierarchy(nodes, hierarchy, 1);
+		double partial  = measure_hierarchy(nodes, hierarchy, 100);
+
+		hierarchy.set_parallel_threshold(std::numeric_limits<uint32_t>::max());
+		double serial = measure_hierarchy(nodes, hierarchy, 1);
+
+		LOGI("{:>10} {:>8} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f}",
+		     count, hierarchy.get_statistics().level_count, lazy, serial, parallel, partial);
+	}
+
+	LOGI("");
+
+	platform->close();
+}
+
+bool TransformBenchmark::handle_command(std::deque<std::string> &arguments) const
+{
+	assert(!arguments.empty());
+	if (arguments[0] == "transform-benchmark")
+	{
+		run();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
@@ -0,0 +1,49 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/platform.h"
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using TransformBenchmarkTags = vkb::PluginBase<vkb::tags::Entrypoint>;
+
+/**
+ * @brief Transform Benchmark
+ *
+ * Measures the world matrix update of node trees from 10k to 1M nodes. The lazy per-node update of Transform, which
+ * recurses to the parent of each node, is measured as a reference against the flattened TransformHierarchy, updated
+ * serially and on several threads, with all nodes or one percent of them changed. The hierarchy is checked against
+ * the reference before it is measured.
+ *
+ * Usage: vulkan_samples transform-benchmark
+ */
+class TransformBenchmark : public TransformBenchmarkTags
+{
+  public:
+	TransformBenchmark();
+
+	virtual ~TransformBenchmark() = default;
+
+	bool handle_command(std::deque<std::string> &arguments) const override;
+
+  private:
+	void run() const;
+};
+}        // namespace plugins
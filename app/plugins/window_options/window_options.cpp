@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -34,6 +34,8 @@ WindowOptions::WindowOptions() :
                        {"fullscreen", "Run in fullscreen mode"},
                        {"headless-surface", "Run in headless surface mode. A Surface and swap-chain is still created using VK_EXT_headless_surface."},
                        {"height", "Initial window height"},
+                       {"offscreen", "Run in offscreen mode. No surface nor swap-chain is created, frames are rendered into a ring of offscreen images"},
+                       {"offscreen-frames", "Number of offscreen images frames are rendered into in offscreen mode, 3 by default"},
                        {"stretch", "Stretch window to fullscreen (direct-to-display only)"},
                        {"vsync", "Force vsync {ON | OFF}. If not set samples decide how vsync is set"},
                        {"width", "Initial window width"}})
@@ -90,6 +92,34 @@ bool WindowOptions::handle_option(std::deque<std::string> &arguments)
 		arguments.pop_front();
 		return true;
 	}
+	else if (option == "offscreen")
+	{
+		properties.mode = vkb::Window::Mode::Offscreen;
+		platform->set_window_properties(properties);
+
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "offscreen-frames")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"offscreen-frames\" is missing the number of frames!");
+			return false;
+		}
+		uint32_t frame_count = static_cast<uint32_t>(std::stoul(arguments[1]));
+		if (frame_count == 0)
+		{
+			LOGD("[Window Options] At least one offscreen frame is needed, resorting to one frame");
+			frame_count = 1;
+		}
+		properties.offscreen_frame_count = frame_count;
+		platform->set_window_properties(properties);
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
 	else if (option == "stretch")
 	{
 		properties.mode = vkb::Window::Mode::FullscreenStretch;
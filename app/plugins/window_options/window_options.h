@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -33,6 +33,9 @@ using WindowOptionsTags = vkb::PluginBase<WindowOptions, vkb::tags::Passive>;
  *
  * Usage: vulkan_samples sample instancing --width 500 --height 500 --vsync OFF
  *
+ * Offscreen mode renders without a surface nor a swapchain, into a ring of offscreen images paced by fences only:
+ *        vulkan_samples sample afbc --offscreen --offscreen-frames 2 --benchmark --stop-after-frame 1000
+ *
  */
 class WindowOptions : public WindowOptionsTags
 {
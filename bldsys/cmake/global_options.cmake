@@ -126,6 +126,8 @@ set(VKB_WSI_SELECTION "XCB" CACHE STRING "Select WSI target (XCB, XLIB, WAYLAND,
 set(VKB_CLANG_TIDY OFF CACHE STRING "Use CMake Clang Tidy integration")
 set(VKB_CLANG_TIDY_EXTRAS "-header-filter=framework,samples,app;-checks=-*,google-*,-google-runtime-references;--fix;--fix-errors" CACHE STRING "Clang Tidy Parameters")
 set(VKB_PROFILING OFF CACHE BOOL "Enable Tracy profiling")
+set(VKB_LOG_LEVEL "DEBUG" CACHE STRING "Lowest level of the log statements compiled in (DEBUG, INFO, WARN, ERROR, OFF)")
+set_property(CACHE VKB_LOG_LEVEL PROPERTY STRINGS DEBUG INFO WARN ERROR OFF)
 set(VKB_SKIP_SLANG_SHADER_COMPILATION OFF CACHE BOOL "Skips compilation for Slang shader")
 
 set(CMAKE_RUNTIME_OUTPUT_DIRECTORY "bin/${CMAKE_BUILD_TYPE}/${TARGET_ARCH}")
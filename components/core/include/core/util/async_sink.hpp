@@ -0,0 +1,148 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <spdlog/details/log_msg_buffer.h>
+#include <spdlog/sinks/dist_sink.h>
+#include <spdlog/sinks/sink.h>
+
+#include "core/util/logging.hpp"
+
+namespace vkb
+{
+namespace logging
+{
+/**
+ * @brief A sink handing the messages to a logging thread, which forwards them to the actual sinks
+ *
+ * Messages are copied into a bounded multi-producer queue of sequenced slots, so the logging threads never take a lock,
+ * and only wake the logging thread up when it waits for messages. Formatting for the sinks and I/O happen on the
+ * logging thread. When the queue is full, messages are either dropped and counted, or the logging threads wait.
+ */
+class AsyncSink : public spdlog::sinks::sink
+{
+  public:
+	/**
+	 * @param queue_size Number of messages the queue holds, rounded up to a power of two
+	 * @param overflow_policy What to do with messages logged while the queue is full
+	 * @param deduplication_interval Consecutive identical messages within this interval are only forwarded once, 0 to forward all
+	 */
+	AsyncSink(size_t queue_size, OverflowPolicy overflow_policy, std::chrono::milliseconds deduplication_interval);
+
+	AsyncSink(const AsyncSink &) = delete;
+
+	AsyncSink(AsyncSink &&) = delete;
+
+	/**
+	 * @brief Forwards the queued messages, and stops the logging thread
+	 */
+	~AsyncSink() override;
+
+	AsyncSink &operator=(const AsyncSink &) = delete;
+
+	AsyncSink &operator=(AsyncSink &&) = delete;
+
+	/**
+	 * @brief Adds a sink the messages are forwarded to
+	 */
+	void add_sink(spdlog::sink_ptr sink);
+
+	void log(const spdlog::details::log_msg &message) override;
+
+	/**
+	 * @brief Blocks until the messages logged so far are forwarded, and flushes the sinks
+	 */
+	void flush() override;
+
+	void set_pattern(const std::string &pattern) override;
+
+	void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+	/**
+	 * @return The number of messages dropped because the queue was full
+	 */
+	uint64_t get_dropped_count() const;
+
+  private:
+	struct Slot
+	{
+		// Equals the position of the slot when it is free, and the position plus one once it holds a message
+		std::atomic<size_t> sequence{0};
+
+		spdlog::details::log_msg_buffer message;
+	};
+
+	bool try_push(const spdlog::details::log_msg &message);
+
+	bool has_message() const;
+
+	// Forwards the queued messages to the sinks, and returns their count
+	size_t forward_messages();
+
+	void report_dropped_messages();
+
+	void wake_worker();
+
+	void worker_loop();
+
+	std::shared_ptr<spdlog::sinks::dist_sink_mt> sinks;
+
+	OverflowPolicy overflow_policy;
+
+	std::unique_ptr<Slot[]> slots;
+
+	size_t slot_mask = 0;
+
+	alignas(64) std::atomic<size_t> enqueue_position{0};
+
+	// Only accessed by the logging thread
+	alignas(64) size_t dequeue_position = 0;
+
+	std::atomic<uint64_t> dropped_count{0};
+
+	uint64_t reported_dropped_count = 0;
+
+	// Incremented to wake the logging thread up, which waits on it when the queue is empty
+	std::atomic<uint32_t> wake_counter{0};
+
+	std::atomic<bool> worker_waiting{false};
+
+	std::atomic<bool> flush_requested{false};
+
+	std::atomic<bool> stop_worker{false};
+
+	// Guards the flush target and the flushed position
+	std::mutex flush_mutex;
+
+	std::condition_variable flush_condition;
+
+	// Position up to which the messages must be forwarded before flushing
+	size_t flush_target = 0;
+
+	size_t flushed_position = 0;
+
+	std::thread worker;
+};
+}        // namespace logging
+}        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2024, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,21 +17,115 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
 #define LOGGER_FORMAT "[%^%l%$] %v"
 #define PROJECT_NAME "VulkanSamples"
 
-#define LOGI(...) spdlog::info(__VA_ARGS__);
-#define LOGW(...) spdlog::warn(__VA_ARGS__);
-#define LOGE(...) spdlog::error("{}", fmt::format(__VA_ARGS__));
-#define LOGD(...) spdlog::debug(__VA_ARGS__);
+#define VKB_LOG_LEVEL_DEBUG 1
+#define VKB_LOG_LEVEL_INFO 2
+#define VKB_LOG_LEVEL_WARN 3
+#define VKB_LOG_LEVEL_ERROR 4
+#define VKB_LOG_LEVEL_OFF 6
+
+// Lowest level of the log statements compiled in, set from the VKB_LOG_LEVEL CMake option
+#ifndef VKB_LOG_ACTIVE_LEVEL
+#	define VKB_LOG_ACTIVE_LEVEL VKB_LOG_LEVEL_DEBUG
+#endif
+
+// Log statements below the active level are discarded at compile time, their arguments are still checked but never evaluated
+#define VKB_LOG_IF_ACTIVE(level, ...)              \
+	if constexpr (VKB_LOG_ACTIVE_LEVEL <= (level)) \
+	{                                              \
+		__VA_ARGS__;                               \
+	}
+
+#define LOGI(...) VKB_LOG_IF_ACTIVE(VKB_LOG_LEVEL_INFO, spdlog::info(__VA_ARGS__))
+#define LOGW(...) VKB_LOG_IF_ACTIVE(VKB_LOG_LEVEL_WARN, spdlog::warn(__VA_ARGS__))
+#define LOGE(...) VKB_LOG_IF_ACTIVE(VKB_LOG_LEVEL_ERROR, spdlog::error("{}", fmt::format(__VA_ARGS__)))
+#define LOGD(...) VKB_LOG_IF_ACTIVE(VKB_LOG_LEVEL_DEBUG, spdlog::debug(__VA_ARGS__))
+
+// Rate limited log statements, for call sites which may repeat every frame or for every item of a large set
+#define VKB_LOG_RATE_LIMITED(level, log_function, ...)                                     \
+	VKB_LOG_IF_ACTIVE(level, {                                                             \
+		static ::vkb::logging::RateLimiter vkb_rate_limiter;                               \
+		uint32_t                           vkb_suppressed_count = 0;                       \
+		if (vkb_rate_limiter.try_acquire(vkb_suppressed_count))                            \
+		{                                                                                  \
+			if (vkb_suppressed_count > 0)                                                  \
+			{                                                                              \
+				log_function("{} similar messages were suppressed", vkb_suppressed_count); \
+			}                                                                              \
+			log_function("{}", fmt::format(__VA_ARGS__));                                  \
+		}                                                                                  \
+	})
+
+#define LOGI_RATE_LIMITED(...) VKB_LOG_RATE_LIMITED(VKB_LOG_LEVEL_INFO, spdlog::info, __VA_ARGS__)
+#define LOGW_RATE_LIMITED(...) VKB_LOG_RATE_LIMITED(VKB_LOG_LEVEL_WARN, spdlog::warn, __VA_ARGS__)
+#define LOGE_RATE_LIMITED(...) VKB_LOG_RATE_LIMITED(VKB_LOG_LEVEL_ERROR, spdlog::error, __VA_ARGS__)
+#define LOGD_RATE_LIMITED(...) VKB_LOG_RATE_LIMITED(VKB_LOG_LEVEL_DEBUG, spdlog::debug, __VA_ARGS__)
 
 namespace vkb
 {
 namespace logging
 {
+/**
+ * @brief What a log statement does when the queue of the asynchronous logger is full
+ */
+enum class OverflowPolicy
+{
+	Block,        // Wait for the logging thread to free a slot
+	Drop          // Discard the message, the number of discarded messages is logged later
+};
+
+/**
+ * @brief Limits the rate of the messages of a log statement, and counts the suppressed ones
+ */
+class RateLimiter
+{
+  public:
+	explicit RateLimiter(uint32_t max_messages_per_second = 5);
+
+	/**
+	 * @brief Checks whether a message can be logged
+	 * @param suppressed_count Set to the number of messages suppressed since the last one allowed
+	 * @return True if the message can be logged
+	 */
+	bool try_acquire(uint32_t &suppressed_count);
+
+  private:
+	uint32_t max_messages_per_second;
+
+	std::atomic<int64_t> window_start{0};
+
+	std::atomic<uint32_t> window_count{0};
+
+	std::atomic<uint32_t> suppressed{0};
+};
+
 void init();
-}
-}        // namespace vkb
\ No newline at end of file
+
+/**
+ * @brief Moves the sinks of the default logger to a logging thread, fed through a bounded lock-free queue
+ *
+ * The calling threads only copy the messages into the queue, formatting for the sinks and I/O happen on the logging
+ * thread. Must be called before other threads log.
+ * @param queue_size Number of messages the queue holds, rounded up to a power of two
+ * @param overflow_policy What to do with messages logged while the queue is full
+ * @param deduplication_interval Consecutive identical messages within this interval are only logged once, 0 to keep all
+ */
+void enable_async(size_t                    queue_size             = 8192,
+                  OverflowPolicy            overflow_policy        = OverflowPolicy::Drop,
+                  std::chrono::milliseconds deduplication_interval = std::chrono::milliseconds{1000});
+
+/**
+ * @brief Adds a sink to the default logger, behind the logging thread if asynchronous logging is enabled
+ */
+void add_sink(spdlog::sink_ptr sink);
+}        // namespace logging
+}        // namespace vkb
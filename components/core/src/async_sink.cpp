@@ -0,0 +1,231 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/util/async_sink.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include <spdlog/sinks/dup_filter_sink.h>
+
+namespace vkb
+{
+namespace logging
+{
+AsyncSink::AsyncSink(size_t queue_size, OverflowPolicy overflow_policy, std::chrono::milliseconds deduplication_interval) :
+    overflow_policy{overflow_policy}
+{
+	if (deduplication_interval.count() > 0)
+	{
+		sinks = std::make_shared<spdlog::sinks::dup_filter_sink_mt>(deduplication_interval);
+	}
+	else
+	{
+		sinks = std::make_shared<spdlog::sinks::dist_sink_mt>();
+	}
+
+	size_t slot_count = std::bit_ceil(std::max<size_t>(queue_size, 2));
+	slots             = std::make_unique<Slot[]>(slot_count);
+	slot_mask         = slot_count - 1;
+	for (size_t i = 0; i < slot_count; ++i)
+	{
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	worker = std::thread(&AsyncSink::worker_loop, this);
+}
+
+AsyncSink::~AsyncSink()
+{
+	stop_worker.store(true, std::memory_order_release);
+	wake_worker();
+	worker.join();
+}
+
+void AsyncSink::add_sink(spdlog::sink_ptr sink)
+{
+	sinks->add_sink(std::move(sink));
+}
+
+void AsyncSink::log(const spdlog::details::log_msg &message)
+{
+	while (!try_push(message))
+	{
+		if (overflow_policy == OverflowPolicy::Drop)
+		{
+			dropped_count.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		wake_worker();
+		std::this_thread::yield();
+	}
+
+	// Pairs with the fence of the logging thread before it checks for messages, so that either sees the other
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (worker_waiting.load(std::memory_order_relaxed))
+	{
+		wake_worker();
+	}
+}
+
+void AsyncSink::flush()
+{
+	std::unique_lock<std::mutex> lock{flush_mutex};
+
+	size_t target = enqueue_position.load(std::memory_order_acquire);
+	flush_target  = std::max(flush_target, target);
+	flush_requested.store(true, std::memory_order_release);
+	wake_worker();
+
+	flush_condition.wait(lock, [this, target] { return flushed_position >= target; });
+}
+
+void AsyncSink::set_pattern(const std::string &pattern)
+{
+	sinks->set_pattern(pattern);
+}
+
+void AsyncSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter)
+{
+	sinks->set_formatter(std::move(formatter));
+}
+
+uint64_t AsyncSink::get_dropped_count() const
+{
+	return dropped_count.load(std::memory_order_relaxed);
+}
+
+bool AsyncSink::try_push(const spdlog::details::log_msg &message)
+{
+	size_t position = enqueue_position.load(std::memory_order_relaxed);
+	while (true)
+	{
+		Slot &slot     = slots[position & slot_mask];
+		auto  sequence = slot.sequence.load(std::memory_order_acquire);
+
+		if (sequence == position)
+		{
+			// The slot is free, claim it unless another thread did
+			if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				slot.message = spdlog::details::log_msg_buffer{message};
+				slot.sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (sequence < position)
+		{
+			// The slot still holds the message from the previous lap, the queue is full
+			return false;
+		}
+		else
+		{
+			position = enqueue_position.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool AsyncSink::has_message() const
+{
+	return slots[dequeue_position & slot_mask].sequence.load(std::memory_order_acquire) == dequeue_position + 1;
+}
+
+size_t AsyncSink::forward_messages()
+{
+	size_t count = 0;
+	while (has_message())
+	{
+		Slot &slot = slots[dequeue_position & slot_mask];
+		sinks->log(slot.message);
+
+		// Free the slot for the next lap
+		slot.sequence.store(dequeue_position + slot_mask + 1, std::memory_order_release);
+		++dequeue_position;
+		++count;
+	}
+	return count;
+}
+
+void AsyncSink::report_dropped_messages()
+{
+	uint64_t dropped = dropped_count.load(std::memory_order_relaxed);
+	if (dropped != reported_dropped_count)
+	{
+		auto text = fmt::format("{} log messages were dropped, the logging queue was full", dropped - reported_dropped_count);
+		sinks->log(spdlog::details::log_msg{"logger", spdlog::level::warn, text});
+		reported_dropped_count = dropped;
+	}
+}
+
+void AsyncSink::wake_worker()
+{
+	wake_counter.fetch_add(1, std::memory_order_release);
+	wake_counter.notify_one();
+}
+
+void AsyncSink::worker_loop()
+{
+	while (true)
+	{
+		size_t forwarded_count = forward_messages();
+		report_dropped_messages();
+
+		if (flush_requested.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> lock{flush_mutex};
+
+			// Messages may be claimed but not written yet, the flush waits for them
+			if (dequeue_position >= flush_target)
+			{
+				flush_requested.store(false, std::memory_order_relaxed);
+				sinks->flush();
+				flushed_position = dequeue_position;
+				flush_condition.notify_all();
+			}
+		}
+
+		if (forwarded_count > 0)
+		{
+			continue;
+		}
+
+		if (stop_worker.load(std::memory_order_acquire) && !has_message())
+		{
+			break;
+		}
+
+		if (flush_requested.load(std::memory_order_acquire))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		uint32_t wake_value = wake_counter.load(std::memory_order_acquire);
+		worker_waiting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (!has_message() && !flush_requested.load(std::memory_order_acquire) && !stop_worker.load(std::memory_order_acquire))
+		{
+			wake_counter.wait(wake_value, std::memory_order_acquire);
+		}
+		worker_waiting.store(false, std::memory_order_relaxed);
+	}
+
+	sinks->flush();
+}
+}        // namespace logging
+}        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2024, Thomas Atkinson
+/* Copyright (c) 2024-2026, Thomas Atkinson
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,8 @@
 
 #include "core/util/logging.hpp"
 
+#include "core/util/async_sink.hpp"
+
 #include "spdlog/cfg/env.h"
 
 #ifdef PLATFORM__ANDROID
@@ -29,6 +31,32 @@ namespace vkb
 {
 namespace logging
 {
+RateLimiter::RateLimiter(uint32_t max_messages_per_second) :
+    max_messages_per_second{max_messages_per_second}
+{
+}
+
+bool RateLimiter::try_acquire(uint32_t &suppressed_count)
+{
+	int64_t now   = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	int64_t start = window_start.load(std::memory_order_relaxed);
+
+	// The thread starting a new window resets the count, concurrent callers may still count against the previous one
+	if ((now - start >= 1000) && window_start.compare_exchange_strong(start, now, std::memory_order_relaxed))
+	{
+		window_count.store(0, std::memory_order_relaxed);
+	}
+
+	if (window_count.fetch_add(1, std::memory_order_relaxed) < max_messages_per_second)
+	{
+		suppressed_count = suppressed.exchange(0, std::memory_order_relaxed);
+		return true;
+	}
+
+	suppressed.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
 void init()
 {
 	// Taken from "spdlog/cfg/env.h" and renamed SPDLOG_LEVEL to VKB_LOG_LEVEL
@@ -48,5 +76,35 @@ void init()
 	logger->set_level(spdlog::level::trace);
 	spdlog::set_default_logger(logger);
 }
+
+void enable_async(size_t queue_size, OverflowPolicy overflow_policy, std::chrono::milliseconds deduplication_interval)
+{
+	auto &logger_sinks = spdlog::default_logger()->sinks();
+	if ((logger_sinks.size() == 1) && std::dynamic_pointer_cast<AsyncSink>(logger_sinks.front()))
+	{
+		return;
+	}
+
+	auto async_sink = std::make_shared<AsyncSink>(queue_size, overflow_policy, deduplication_interval);
+	for (auto &sink : logger_sinks)
+	{
+		async_sink->add_sink(sink);
+	}
+	logger_sinks.assign(1, async_sink);
+}
+
+void add_sink(spdlog::sink_ptr sink)
+{
+	auto &logger_sinks = spdlog::default_logger()->sinks();
+	if (logger_sinks.size() == 1)
+	{
+		if (auto async_sink = std::dynamic_pointer_cast<AsyncSink>(logger_sinks.front()))
+		{
+			async_sink->add_sink(std::move(sink));
+			return;
+		}
+	}
+	logger_sinks.push_back(std::move(sink));
+}
 }        // namespace logging
-}        // namespace vkb
\ No newline at end of file
+}        // namespace vkb
@@ -138,5 +138,13 @@ void write_temp(const std::vector<uint8_t> &data, const std::string &filename);
  * @param row_stride The stride in bytes of a row of pixels
  */
 void write_image(const uint8_t *data, const std::string &filename, const uint32_t width, const uint32_t height, const uint32_t components, const uint32_t row_stride);
+
+/**
+ * @brief Helper to write an already encoded image in permanent storage
+ *
+ * @param data     A vector filled with the bytes of the file
+ * @param filename The name of the image file, including its extension
+ */
+void write_image_file(const std::vector<uint8_t> &data, const std::string &filename);
 }        // namespace fs
 }        // namespace vkb
@@ -137,5 +137,10 @@ void write_image(const uint8_t *data, const std::string &filename, const uint32_
 	stbi_write_png((path::get(path::Type::Screenshots) + filename + ".png").c_str(), width, height, components, data, row_stride);
 }
 
+void write_image_file(const std::vector<uint8_t> &data, const std::string &filename)
+{
+	vkb::filesystem::get()->write_file(path::get(path::Type::Screenshots) + filename, data);
+}
+
 }        // namespace fs
 }        // namespace vkb
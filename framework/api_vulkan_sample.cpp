@@ -31,6 +31,13 @@
 
 bool ApiVulkanSample::prepare(const vkb::ApplicationOptions &options)
 {
+	// The API samples acquire and present the swapchain images themselves, so they can't render without a swapchain
+	if (options.window && options.window->get_window_mode() == vkb::Window::Mode::Offscreen)
+	{
+		LOGE("{} acquires and presents swapchain images, it does not support the --offscreen window mode", get_name());
+		return false;
+	}
+
 	if (!VulkanSample::prepare(options))
 	{
 		return false;
@@ -523,6 +530,12 @@ void ApiVulkanSample::draw_ui(const VkCommandBuffer command_buffer, uint32_t swa
 
 void ApiVulkanSample::prepare_frame()
 {
+	if (texture_upload_token)
+	{
+		// Uploads complete in submission order, so waiting on the latest one covers all textures loaded so far
+		get_device().get_upload_manager().wait(std::exchange(texture_upload_token, {}));
+	}
+
 	if (get_render_context().has_swapchain())
 	{
 		handle_surface_changes();
@@ -539,6 +552,12 @@ void ApiVulkanSample::prepare_frame()
 		{
 			VK_CHECK(result);
 		}
+
+		if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR)
+		{
+			// The captures copied the last time this image was presented are read back now
+			get_render_context().collect_captures(current_buffer);
+		}
 	}
 }
 
@@ -565,10 +584,15 @@ void ApiVulkanSample::submit_frame()
 			present_info.pNext = &disp_present_info;
 		}
 
+		// The sample presents without end_frame(), so the captures requested with F12 or --screenshot are copied here,
+		// between the rendering and the presentation, and read back when the image is acquired again
+		VkSemaphore present_wait_semaphore =
+		    static_cast<VkSemaphore>(get_render_context().submit_capture(current_buffer, static_cast<vk::Semaphore>(semaphores.render_complete)));
+
 		// Check if a wait semaphore has been specified to wait for before presenting the image
-		if (semaphores.render_complete != VK_NULL_HANDLE)
+		if (present_wait_semaphore != VK_NULL_HANDLE)
 		{
-			present_info.pWaitSemaphores    = &semaphores.render_complete;
+			present_info.pWaitSemaphores    = &present_wait_semaphore;
 			present_info.waitSemaphoreCount = 1;
 		}
 
@@ -1040,12 +1064,6 @@ Texture ApiVulkanSample::load_texture(const std::string &file, vkb::sg::Image::C
 	texture.image = vkb::sg::Image::load(file, file, content_type);
 	texture.image->create_vk_image(get_device());
 
-	const auto &queue = get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-	VkCommandBuffer command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-	vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<VkBufferImageCopy> bufferCopyRegions;
 
@@ -1072,31 +1090,14 @@ Texture ApiVulkanSample::load_texture(const std::string &file, vkb::sg::Image::C
 	subresource_range.levelCount              = vkb::to_u32(mipmaps.size());
 	subresource_range.layerCount              = 1;
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_UNDEFINED,
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             subresource_range);
-
-	// Copy mip levels from staging buffer
-	vkCmdCopyBufferToImage(
-	    command_buffer,
-	    stage_buffer.get_handle(),
-	    texture.image->get_vk_image().get_handle(),
-	    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	    static_cast<uint32_t>(bufferCopyRegions.size()),
-	    bufferCopyRegions.data());
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-	                             subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy all mip levels through the staging ring without blocking, the first frame waits for the upload to complete
+	auto &upload_manager = get_device().get_upload_manager();
+	texture_upload_token = upload_manager.upload_image(texture.image->get_data().data(),
+	                                                   texture.image->get_data().size(),
+	                                                   texture.image->get_vk_image().get_handle(),
+	                                                   bufferCopyRegions,
+	                                                   subresource_range);
+	upload_manager.flush();
 
 	// Calculate valid filter and mipmap modes
 	VkFilter            filter      = VK_FILTER_LINEAR;
@@ -1136,12 +1137,6 @@ Texture ApiVulkanSample::load_texture_array(const std::string &file, vkb::sg::Im
 	texture.image = vkb::sg::Image::load(file, file, content_type);
 	texture.image->create_vk_image(get_device(), VK_IMAGE_VIEW_TYPE_2D_ARRAY);
 
-	const auto &queue = get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-	VkCommandBuffer command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-	vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<VkBufferImageCopy> buffer_copy_regions;
 
@@ -1174,31 +1169,14 @@ Texture ApiVulkanSample::load_texture_array(const std::string &file, vkb::sg::Im
 	subresource_range.levelCount              = vkb::to_u32(mipmaps.size());
 	subresource_range.layerCount              = layers;
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_UNDEFINED,
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             subresource_range);
-
-	// Copy mip levels from staging buffer
-	vkCmdCopyBufferToImage(
-	    command_buffer,
-	    stage_buffer.get_handle(),
-	    texture.image->get_vk_image().get_handle(),
-	    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	    static_cast<uint32_t>(buffer_copy_regions.size()),
-	    buffer_copy_regions.data());
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-	                             subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy all mip levels through the staging ring without blocking, the first frame waits for the upload to complete
+	auto &upload_manager = get_device().get_upload_manager();
+	texture_upload_token = upload_manager.upload_image(texture.image->get_data().data(),
+	                                                   texture.image->get_data().size(),
+	                                                   texture.image->get_vk_image().get_handle(),
+	                                                   buffer_copy_regions,
+	                                                   subresource_range);
+	upload_manager.flush();
 
 	// Calculate valid filter and mipmap modes
 	VkFilter            filter      = VK_FILTER_LINEAR;
@@ -1235,12 +1213,6 @@ Texture ApiVulkanSample::load_texture_cubemap(const std::string &file, vkb::sg::
 	texture.image = vkb::sg::Image::load(file, file, content_type);
 	texture.image->create_vk_image(get_device(), VK_IMAGE_VIEW_TYPE_CUBE, VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT);
 
-	const auto &queue = get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-	VkCommandBuffer command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-	vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<VkBufferImageCopy> buffer_copy_regions;
 
@@ -1273,31 +1245,14 @@ Texture ApiVulkanSample::load_texture_cubemap(const std::string &file, vkb::sg::
 	subresource_range.levelCount              = vkb::to_u32(mipmaps.size());
 	subresource_range.layerCount              = layers;
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_UNDEFINED,
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             subresource_range);
-
-	// Copy mip levels from staging buffer
-	vkCmdCopyBufferToImage(
-	    command_buffer,
-	    stage_buffer.get_handle(),
-	    texture.image->get_vk_image().get_handle(),
-	    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	    static_cast<uint32_t>(buffer_copy_regions.size()),
-	    buffer_copy_regions.data());
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-	                             subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy all mip levels through the staging ring without blocking, the first frame waits for the upload to complete
+	auto &upload_manager = get_device().get_upload_manager();
+	texture_upload_token = upload_manager.upload_image(texture.image->get_data().data(),
+	                                                   texture.image->get_data().size(),
+	                                                   texture.image->get_vk_image().get_handle(),
+	                                                   buffer_copy_regions,
+	                                                   subresource_range);
+	upload_manager.flush();
 
 	// Calculate valid filter and mipmap modes
 	VkFilter            filter      = VK_FILTER_LINEAR;
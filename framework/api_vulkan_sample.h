@@ -426,6 +426,9 @@ class ApiVulkanSample : public vkb::VulkanSampleC
 	uint32_t dest_height;
 	bool     resizing = false;
 
+	/// Latest texture upload submitted by the load_texture* helpers, waited on once before the next frame is recorded
+	vkb::core::UploadToken texture_upload_token;
+
 	void handle_mouse_move(int32_t x, int32_t y);
 
 #if defined(VKB_DEBUG) || defined(VKB_VALIDATION_LAYERS)
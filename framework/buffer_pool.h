@@ -258,6 +258,9 @@ vk::DeviceSize BufferBlock<bindingType>::aligned_offset() const
 template <vkb::BindingType bindingType>
 vk::DeviceSize BufferBlock<bindingType>::determine_alignment(vk::BufferUsageFlags usage, vk::PhysicalDeviceLimits const &limits) const
 {
+	// Buffers referenced by descriptor buffers also have a device address, which does not change their alignment
+	usage &= ~vk::BufferUsageFlags{vk::BufferUsageFlagBits::eShaderDeviceAddress};
+
 	if (usage == vk::BufferUsageFlagBits::eUniformBuffer)
 	{
 		return limits.minUniformBufferOffsetAlignment;
@@ -0,0 +1,222 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "common/helpers.h"
+#include "common/vk_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Flat replacement of BindingMap for the bindings of a descriptor set, which does not allocate once warmed up
+ *
+ * Entries are kept sorted by binding then array element, as a BindingMap iterates them. The first InlineCapacity entries
+ * are stored inline, larger tables move to a vector which keeps its capacity when the table is cleared.
+ *
+ * Each entry keeps the hash of the value written with set. The hash of the table folds them with hash_combine in binding
+ * order, on the first lookup after a change, so that a descriptor set keyed by it is looked up without rehashing values.
+ *
+ * The vector is allocated with Allocator, which lets the binding benchmark count its allocations.
+ */
+template <class T, size_t InlineCapacity = 16, template <class> class Allocator = std::allocator>
+class BindingTable
+{
+  public:
+	struct Entry
+	{
+		uint32_t binding = 0;
+
+		uint32_t array_element = 0;
+
+		T value = {};
+
+		// Hash of the entry if its value was written with set, zero otherwise
+		size_t hash = 0;
+	};
+
+	/**
+	 * @brief Gets the value of an array element of a binding, inserting a default one if missing
+	 */
+	T &at(uint32_t binding, uint32_t array_element)
+	{
+		return find_or_insert(binding, array_element).value;
+	}
+
+	/**
+	 * @brief Writes the value of an array element of a binding, updating the hash of the table
+	 */
+	void set(uint32_t binding, uint32_t array_element, T const &value)
+	{
+		Entry &entry = find_or_insert(binding, array_element);
+
+		entry.value = value;
+		entry.hash  = 0;
+		hash_combine(entry.hash, binding);
+		hash_combine(entry.hash, array_element);
+		hash_combine(entry.hash, value);
+
+		hash_dirty = true;
+	}
+
+	T const *find(uint32_t binding, uint32_t array_element) const
+	{
+		auto entries = get_entries();
+		auto it      = std::ranges::lower_bound(entries, std::pair{binding, array_element}, std::less{}, key);
+		return (it != entries.end() && key(*it) == std::pair{binding, array_element}) ? &it->value : nullptr;
+	}
+
+	bool has_binding(uint32_t binding) const
+	{
+		auto entries = get_entries();
+		auto it      = std::ranges::lower_bound(entries, binding, std::less{}, &Entry::binding);
+		return it != entries.end() && it->binding == binding;
+	}
+
+	std::span<Entry> get_entries()
+	{
+		return {data(), count};
+	}
+
+	std::span<Entry const> get_entries() const
+	{
+		return {data(), count};
+	}
+
+	size_t get_hash() const
+	{
+		if (hash_dirty)
+		{
+			// Entries are sorted, so the fold follows binding then array element order
+			hash = 0;
+			for (auto const &entry : get_entries())
+			{
+				if (entry.hash)
+				{
+					hash_combine(hash, entry.hash);
+				}
+			}
+			hash_dirty = false;
+		}
+		return hash;
+	}
+
+	bool empty() const
+	{
+		return count == 0;
+	}
+
+	void clear()
+	{
+		count      = 0;
+		hash       = 0;
+		hash_dirty = false;
+	}
+
+	/**
+	 * @brief Fills a table with the values of a BindingMap, written with set
+	 */
+	static BindingTable from_binding_map(BindingMap<T> const &map)
+	{
+		BindingTable table;
+		for (auto const &[binding, elements] : map)
+		{
+			for (auto const &[array_element, value] : elements)
+			{
+				table.set(binding, array_element, value);
+			}
+		}
+		return table;
+	}
+
+	/**
+	 * @brief Copies the table into a BindingMap, for the code creating descriptor sets
+	 */
+	BindingMap<T> to_binding_map() const
+	{
+		BindingMap<T> map;
+		for (auto const &entry : get_entries())
+		{
+			map[entry.binding][entry.array_element] = entry.value;
+		}
+		return map;
+	}
+
+  private:
+	static std::pair<uint32_t, uint32_t> key(Entry const &entry)
+	{
+		return {entry.binding, entry.array_element};
+	}
+
+	Entry *data()
+	{
+		return overflow_entries.empty() ? inline_entries.data() : overflow_entries.data();
+	}
+
+	Entry const *data() const
+	{
+		return overflow_entries.empty() ? inline_entries.data() : overflow_entries.data();
+	}
+
+	Entry &find_or_insert(uint32_t binding, uint32_t array_element)
+	{
+		auto entries = get_entries();
+		auto it      = std::ranges::lower_bound(entries, std::pair{binding, array_element}, std::less{}, key);
+		if (it != entries.end() && key(*it) == std::pair{binding, array_element})
+		{
+			return *it;
+		}
+
+		size_t index = static_cast<size_t>(it - entries.begin());
+
+		if (count == InlineCapacity && overflow_entries.empty())
+		{
+			// Spill to the heap, the vector then stays in use so that clearing the table does not free it
+			overflow_entries.assign(inline_entries.begin(), inline_entries.end());
+		}
+		if (!overflow_entries.empty() && count == overflow_entries.size())
+		{
+			overflow_entries.resize(count * 2);
+		}
+
+		Entry *entries_data = data();
+		std::move_backward(entries_data + index, entries_data + count, entries_data + count + 1);
+		entries_data[index] = {.binding = binding, .array_element = array_element};
+		++count;
+
+		return entries_data[index];
+	}
+
+	std::array<Entry, InlineCapacity> inline_entries;
+
+	std::vector<Entry, Allocator<Entry>> overflow_entries;
+
+	size_t count = 0;
+
+	// Folded lazily by get_hash
+	mutable size_t hash = 0;
+
+	mutable bool hash_dirty = false;
+};
+}        // namespace vkb
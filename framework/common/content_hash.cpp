@@ -0,0 +1,509 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/content_hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#	include <intrin.h>
+#endif
+
+// SSE2 and NEON are part of the baseline of x86-64 and AArch64, other targets use the scalar code
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define VKB_CONTENT_HASH_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#	include <arm_neon.h>
+#	define VKB_CONTENT_HASH_NEON
+#endif
+
+namespace vkb
+{
+namespace
+{
+constexpr uint64_t PRIME32_1 = 0x9E3779B1U;
+constexpr uint64_t PRIME32_2 = 0x85EBCA77U;
+constexpr uint64_t PRIME32_3 = 0xC2B2AE3DU;
+constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+constexpr size_t STRIPES_PER_BLOCK         = (detail::HashState::SECRET_SIZE - detail::HashState::STRIPE_SIZE) / 8;
+constexpr size_t SCRAMBLE_SECRET_OFFSET    = detail::HashState::SECRET_SIZE - detail::HashState::STRIPE_SIZE;
+constexpr size_t LAST_STRIPE_SECRET_OFFSET = detail::HashState::SECRET_SIZE - detail::HashState::STRIPE_SIZE - 7;
+constexpr size_t MERGE_LOW_SECRET_OFFSET   = 11;
+constexpr size_t MERGE_HIGH_SECRET_OFFSET  = detail::HashState::SECRET_SIZE - 64 - 11;
+
+// Distinguishes the hash of the chunk digests from the hash of a chunk
+constexpr uint64_t ROOT_SEED = 0x6A09E667F3BCC908ULL;
+
+/**
+ * @brief Derives the default secret from a splitmix64 sequence
+ */
+constexpr std::array<uint8_t, detail::HashState::SECRET_SIZE> generate_secret()
+{
+	std::array<uint8_t, detail::HashState::SECRET_SIZE> secret{};
+
+	uint64_t state = 0x243F6A8885A308D3ULL;
+	for (size_t i = 0; i < secret.size(); i += 8)
+	{
+		state += 0x9E3779B97F4A7C15ULL;
+		uint64_t value = state;
+		value          = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		value          = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+		value          = value ^ (value >> 31);
+
+		for (size_t byte = 0; byte < 8; ++byte)
+		{
+			secret[i + byte] = static_cast<uint8_t>(value >> (byte * 8));
+		}
+	}
+	return secret;
+}
+
+constexpr std::array<uint8_t, detail::HashState::SECRET_SIZE> DEFAULT_SECRET = generate_secret();
+
+inline uint64_t read64(const uint8_t *data)
+{
+	uint64_t value;
+	std::memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+inline void write64(uint8_t *data, uint64_t value)
+{
+	std::memcpy(data, &value, sizeof(value));
+}
+
+inline uint64_t rotate_left(uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+/**
+ * @brief Multiplies two 64-bit values into 128 bits, and folds the halves of the product
+ */
+inline uint64_t multiply_fold(uint64_t lhs, uint64_t rhs)
+{
+#if defined(__SIZEOF_INT128__)
+	__uint128_t product = static_cast<__uint128_t>(lhs) * rhs;
+	return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	uint64_t high = 0;
+	uint64_t low  = _umul128(lhs, rhs, &high);
+	return low ^ high;
+#else
+	uint64_t low_low   = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+	uint64_t high_low  = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+	uint64_t low_high  = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+	uint64_t high_high = (lhs >> 32) * (rhs >> 32);
+	uint64_t cross     = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+	uint64_t upper     = (high_low >> 32) + (cross >> 32) + high_high;
+	uint64_t lower     = (cross << 32) | (low_low & 0xFFFFFFFF);
+	return lower ^ upper;
+#endif
+}
+
+inline uint64_t avalanche(uint64_t hash)
+{
+	hash ^= hash >> 37;
+	hash *= 0x165667919E3779F9ULL;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+/**
+ * @brief Consumes one stripe, each accumulator multiplies the 32-bit halves of its lane mixed with the secret
+ */
+inline void accumulate_stripe(std::array<uint64_t, 8> &accumulators, const uint8_t *data, const uint8_t *secret)
+{
+#if defined(VKB_CONTENT_HASH_SSE2)
+	__m128i *acc = reinterpret_cast<__m128i *>(accumulators.data());
+	for (size_t i = 0; i < 4; ++i)
+	{
+		__m128i value   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data) + i);
+		__m128i key     = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i));
+		__m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+		__m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+		_mm_storeu_si128(acc + i, _mm_add_epi64(_mm_loadu_si128(acc + i), _mm_add_epi64(product, swapped)));
+	}
+#elif defined(VKB_CONTENT_HASH_NEON)
+	uint64_t *acc = accumulators.data();
+	for (size_t i = 0; i < 4; ++i)
+	{
+		uint64x2_t value       = vreinterpretq_u64_u8(vld1q_u8(data + i * 16));
+		uint64x2_t key         = veorq_u64(value, vreinterpretq_u64_u8(vld1q_u8(secret + i * 16)));
+		uint64x2_t accumulator = vaddq_u64(vld1q_u64(acc + i * 2), vextq_u64(value, value, 1));
+		accumulator            = vmlal_u32(accumulator, vmovn_u64(key), vshrn_n_u64(key, 32));
+		vst1q_u64(acc + i * 2, accumulator);
+	}
+#else
+	for (size_t lane = 0; lane < 8; ++lane)
+	{
+		uint64_t value = read64(data + lane * 8);
+		uint64_t key   = value ^ read64(secret + lane * 8);
+		accumulators[lane ^ 1] += value;
+		accumulators[lane] += (key & 0xFFFFFFFF) * (key >> 32);
+	}
+#endif
+}
+
+inline void scramble(std::array<uint64_t, 8> &accumulators, const uint8_t *secret)
+{
+#if defined(VKB_CONTENT_HASH_SSE2)
+	__m128i *acc   = reinterpret_cast<__m128i *>(accumulators.data());
+	__m128i  prime = _mm_set1_epi32(static_cast<int>(PRIME32_1));
+	for (size_t i = 0; i < 4; ++i)
+	{
+		__m128i accumulator = _mm_loadu_si128(acc + i);
+		accumulator         = _mm_xor_si128(accumulator, _mm_srli_epi64(accumulator, 47));
+		accumulator         = _mm_xor_si128(accumulator, _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i));
+
+		// 64-bit by 32-bit multiplication, from the products of the low and high halves
+		__m128i product_low  = _mm_mul_epu32(accumulator, prime);
+		__m128i product_high = _mm_mul_epu32(_mm_shuffle_epi32(accumulator, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+		_mm_storeu_si128(acc + i, _mm_add_epi64(product_low, _mm_slli_epi64(product_high, 32)));
+	}
+#elif defined(VKB_CONTENT_HASH_NEON)
+	uint64_t  *acc   = accumulators.data();
+	uint32x2_t prime = vdup_n_u32(static_cast<uint32_t>(PRIME32_1));
+	for (size_t i = 0; i < 4; ++i)
+	{
+		uint64x2_t accumulator = vld1q_u64(acc + i * 2);
+		accumulator            = veorq_u64(accumulator, vshrq_n_u64(accumulator, 47));
+		accumulator            = veorq_u64(accumulator, vreinterpretq_u64_u8(vld1q_u8(secret + i * 16)));
+
+		// 64-bit by 32-bit multiplication, from the products of the low and high halves
+		uint64x2_t product_high = vshlq_n_u64(vmull_u32(vshrn_n_u64(accumulator, 32), prime), 32);
+		vst1q_u64(acc + i * 2, vmlal_u32(product_high, vmovn_u64(accumulator), prime));
+	}
+#else
+	for (size_t lane = 0; lane < 8; ++lane)
+	{
+		uint64_t accumulator = accumulators[lane];
+		accumulator ^= accumulator >> 47;
+		accumulator ^= read64(secret + lane * 8);
+		accumulators[lane] = accumulator * PRIME32_1;
+	}
+#endif
+}
+
+inline void accumulate_stripes(std::array<uint64_t, 8> &accumulators, size_t &stripes_in_block, const uint8_t *data, size_t stripe_count, const uint8_t *secret)
+{
+	for (size_t stripe = 0; stripe < stripe_count; ++stripe)
+	{
+		accumulate_stripe(accumulators, data + stripe * detail::HashState::STRIPE_SIZE, secret + stripes_in_block * 8);
+		if (++stripes_in_block == STRIPES_PER_BLOCK)
+		{
+			scramble(accumulators, secret + SCRAMBLE_SECRET_OFFSET);
+			stripes_in_block = 0;
+		}
+	}
+}
+
+detail::HashState make_root(uint64_t seed)
+{
+	return detail::HashState{seed ^ ROOT_SEED};
+}
+
+void add_chunk_digest(detail::HashState &root, Hash128 const &digest)
+{
+	std::array<uint8_t, 16> bytes;
+	write64(bytes.data(), digest.low);
+	write64(bytes.data() + 8, digest.high);
+	root.update(bytes.data(), bytes.size());
+}
+
+void add_total_size(detail::HashState &root, uint64_t total_size)
+{
+	std::array<uint8_t, 8> bytes;
+	write64(bytes.data(), total_size);
+	root.update(bytes.data(), bytes.size());
+}
+
+Hash128 hash_chunk(std::span<const uint8_t> data, uint64_t seed)
+{
+	detail::HashState state{seed};
+	state.update(data.data(), data.size());
+	return state.digest128();
+}
+}        // namespace
+
+namespace detail
+{
+HashState::HashState(uint64_t seed) :
+    accumulators{PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1}
+{
+	// Like XXH3, the seed is folded into the secret, so that it costs nothing per stripe
+	for (size_t i = 0; i < SECRET_SIZE; i += 16)
+	{
+		write64(secret.data() + i, read64(DEFAULT_SECRET.data() + i) + seed);
+		write64(secret.data() + i + 8, read64(DEFAULT_SECRET.data() + i + 8) - seed);
+	}
+}
+
+void HashState::update(const uint8_t *data, size_t size)
+{
+	total_size += size;
+
+	if (buffered_size + size <= BUFFER_SIZE)
+	{
+		if (size > 0)
+		{
+			std::memcpy(buffer.data() + buffered_size, data, size);
+			buffered_size += size;
+		}
+		return;
+	}
+
+	// More input follows, so the buffered bytes are not the last ones anymore
+	if (buffered_size > 0)
+	{
+		size_t fill_size = BUFFER_SIZE - buffered_size;
+		std::memcpy(buffer.data() + buffered_size, data, fill_size);
+		data += fill_size;
+		size -= fill_size;
+
+		consume_stripes(buffer.data(), BUFFER_SIZE / STRIPE_SIZE);
+		buffered_size = 0;
+	}
+
+	// Consume the input in place, keeping between 1 and STRIPE_SIZE bytes for the last stripe
+	if (size > STRIPE_SIZE)
+	{
+		size_t stripe_count = (size - 1) / STRIPE_SIZE;
+		consume_stripes(data, stripe_count);
+		data += stripe_count * STRIPE_SIZE;
+		size -= stripe_count * STRIPE_SIZE;
+	}
+
+	std::memcpy(buffer.data(), data, size);
+	buffered_size = size;
+}
+
+uint64_t HashState::digest64() const
+{
+	if (total_size <= BUFFER_SIZE)
+	{
+		return short_digest(0, PRIME64_1);
+	}
+
+	return merge_accumulators(finalize_accumulators(), MERGE_LOW_SECRET_OFFSET, total_size * PRIME64_1);
+}
+
+Hash128 HashState::digest128() const
+{
+	if (total_size <= BUFFER_SIZE)
+	{
+		return {short_digest(0, PRIME64_1), short_digest(MERGE_HIGH_SECRET_OFFSET, PRIME64_2)};
+	}
+
+	std::array<uint64_t, 8> final_accumulators = finalize_accumulators();
+	return {merge_accumulators(final_accumulators, MERGE_LOW_SECRET_OFFSET, total_size * PRIME64_1),
+	        merge_accumulators(final_accumulators, MERGE_HIGH_SECRET_OFFSET, ~(total_size * PRIME64_2))};
+}
+
+uint64_t HashState::get_total_size() const
+{
+	return total_size;
+}
+
+void HashState::consume_stripes(const uint8_t *data, size_t stripe_count)
+{
+	accumulate_stripes(accumulators, stripes_in_block, data, stripe_count, secret.data());
+}
+
+std::array<uint64_t, 8> HashState::finalize_accumulators() const
+{
+	std::array<uint64_t, 8> final_accumulators     = accumulators;
+	size_t                  final_stripes_in_block = stripes_in_block;
+
+	// The last stripe is always partial or complete, never empty, and is padded with zeros
+	size_t full_stripe_count = (buffered_size - 1) / STRIPE_SIZE;
+	accumulate_stripes(final_accumulators, final_stripes_in_block, buffer.data(), full_stripe_count, secret.data());
+
+	std::array<uint8_t, STRIPE_SIZE> last_stripe{};
+	std::memcpy(last_stripe.data(), buffer.data() + full_stripe_count * STRIPE_SIZE, buffered_size - full_stripe_count * STRIPE_SIZE);
+	accumulate_stripe(final_accumulators, last_stripe.data(), secret.data() + LAST_STRIPE_SECRET_OFFSET);
+
+	return final_accumulators;
+}
+
+uint64_t HashState::short_digest(size_t secret_offset, uint64_t multiplier) const
+{
+	uint64_t hash = (total_size * multiplier) ^ read64(secret.data() + secret_offset);
+
+	for (size_t offset = 0; offset < buffered_size; offset += 16)
+	{
+		std::array<uint8_t, 16> chunk{};
+		std::memcpy(chunk.data(), buffer.data() + offset, std::min<size_t>(16, buffered_size - offset));
+
+		const uint8_t *chunk_secret = secret.data() + (secret_offset + offset) % (SECRET_SIZE - 16);
+		hash += multiply_fold(read64(chunk.data()) ^ read64(chunk_secret), read64(chunk.data() + 8) ^ read64(chunk_secret + 8));
+
+		// Rotate so that the chunks are not interchangeable
+		hash = rotate_left(hash, 27) * PRIME64_1;
+	}
+
+	return avalanche(hash);
+}
+
+uint64_t HashState::merge_accumulators(std::array<uint64_t, 8> const &final_accumulators, size_t secret_offset, uint64_t start) const
+{
+	uint64_t result = start;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		const uint8_t *merge_secret = secret.data() + secret_offset + i * 16;
+		result += multiply_fold(final_accumulators[2 * i] ^ read64(merge_secret), final_accumulators[2 * i + 1] ^ read64(merge_secret + 8));
+	}
+	return avalanche(result);
+}
+}        // namespace detail
+
+ContentHasher::ContentHasher(uint64_t seed) :
+    seed{seed}, root{make_root(seed)}, chunk{seed}
+{
+}
+
+void ContentHasher::update(std::span<const uint8_t> data)
+{
+	while (!data.empty())
+	{
+		if (chunk.get_total_size() == CHUNK_SIZE)
+		{
+			// The chunk is complete and more input follows
+			add_chunk_digest(root, chunk.digest128());
+			chunk = detail::HashState{seed};
+			++chunk_count;
+		}
+
+		size_t size = std::min<size_t>(data.size(), CHUNK_SIZE - chunk.get_total_size());
+		chunk.update(data.data(), size);
+		data = data.subspan(size);
+	}
+}
+
+void ContentHasher::update(std::string_view data)
+{
+	update(std::span<const uint8_t>(reinterpret_cast<const uint8_t *>(data.data()), data.size()));
+}
+
+uint64_t ContentHasher::digest64() const
+{
+	if (chunk_count == 0)
+	{
+		return chunk.digest64();
+	}
+
+	detail::HashState final_root = root;
+	add_chunk_digest(final_root, chunk.digest128());
+	add_total_size(final_root, chunk_count * CHUNK_SIZE + chunk.get_total_size());
+	return final_root.digest64();
+}
+
+Hash128 ContentHasher::digest128() const
+{
+	if (chunk_count == 0)
+	{
+		return chunk.digest128();
+	}
+
+	detail::HashState final_root = root;
+	add_chunk_digest(final_root, chunk.digest128());
+	add_total_size(final_root, chunk_count * CHUNK_SIZE + chunk.get_total_size());
+	return final_root.digest128();
+}
+
+namespace
+{
+/**
+ * @brief Hashes the chunks of a buffer larger than a chunk, and returns the state of the hash of their digests
+ */
+detail::HashState hash_chunks(std::span<const uint8_t> data, uint64_t seed, uint32_t thread_count)
+{
+	size_t chunk_count = (data.size() + ContentHasher::CHUNK_SIZE - 1) / ContentHasher::CHUNK_SIZE;
+
+	if (thread_count == 0)
+	{
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+	thread_count = static_cast<uint32_t>(std::min<size_t>(thread_count, chunk_count));
+
+	// Each thread takes every thread_count-th chunk
+	std::vector<Hash128> chunk_digests(chunk_count);
+	auto                 hash_strided_chunks = [&](size_t first_chunk) {
+        for (size_t i = first_chunk; i < chunk_count; i += thread_count)
+        {
+            size_t offset    = i * ContentHasher::CHUNK_SIZE;
+            chunk_digests[i] = hash_chunk(data.subspan(offset, std::min(ContentHasher::CHUNK_SIZE, data.size() - offset)), seed);
+        }
+	};
+
+	std::vector<std::thread> threads;
+	for (uint32_t i = 1; i < thread_count; ++i)
+	{
+		threads.emplace_back(hash_strided_chunks, i);
+	}
+	hash_strided_chunks(0);
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	detail::HashState root = make_root(seed);
+	for (auto &digest : chunk_digests)
+	{
+		add_chunk_digest(root, digest);
+	}
+	add_total_size(root, data.size());
+	return root;
+}
+}        // namespace
+
+uint64_t content_hash64(std::span<const uint8_t> data, uint64_t seed, uint32_t thread_count)
+{
+	if (data.size() <= ContentHasher::CHUNK_SIZE)
+	{
+		detail::HashState state{seed};
+		state.update(data.data(), data.size());
+		return state.digest64();
+	}
+
+	return hash_chunks(data, seed, thread_count).digest64();
+}
+
+Hash128 content_hash128(std::span<const uint8_t> data, uint64_t seed, uint32_t thread_count)
+{
+	if (data.size() <= ContentHasher::CHUNK_SIZE)
+	{
+		return hash_chunk(data, seed);
+	}
+
+	return hash_chunks(data, seed, thread_count).digest128();
+}
+
+uint64_t content_hash64(std::string_view data, uint64_t seed)
+{
+	return content_hash64(std::span<const uint8_t>(reinterpret_cast<const uint8_t *>(data.data()), data.size()), seed);
+}
+}        // namespace vkb
@@ -0,0 +1,145 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace vkb
+{
+/**
+ * @brief A 128-bit content hash
+ */
+struct Hash128
+{
+	uint64_t low  = 0;
+	uint64_t high = 0;
+
+	bool operator==(const Hash128 &) const = default;
+};
+
+namespace detail
+{
+/**
+ * @brief Streaming state of the hash of a contiguous range of bytes
+ *
+ * Follows the structure of XXH3: eight independent 64-bit accumulators consume 64-byte stripes, multiplying 32-bit halves
+ * of the input mixed with a secret, with SSE2 or NEON on the targets that have them. The accumulators are scrambled after
+ * every block of stripes, and merged into a 64 or 128-bit digest. Inputs of up to 256 bytes are hashed
+ * by a dedicated short path. The values differ from the reference XXH3, as the secret is derived here.
+ */
+class HashState
+{
+  public:
+	static constexpr size_t STRIPE_SIZE = 64;
+	static constexpr size_t SECRET_SIZE = 192;
+	static constexpr size_t BUFFER_SIZE = 256;
+
+	explicit HashState(uint64_t seed = 0);
+
+	void update(const uint8_t *data, size_t size);
+
+	uint64_t digest64() const;
+
+	Hash128 digest128() const;
+
+	uint64_t get_total_size() const;
+
+  private:
+	void consume_stripes(const uint8_t *data, size_t stripe_count);
+
+	// Accumulators with all the input consumed, including the buffered bytes
+	std::array<uint64_t, 8> finalize_accumulators() const;
+
+	uint64_t short_digest(size_t secret_offset, uint64_t multiplier) const;
+
+	uint64_t merge_accumulators(std::array<uint64_t, 8> const &accumulators, size_t secret_offset, uint64_t start) const;
+
+	alignas(64) std::array<uint64_t, 8> accumulators;
+
+	alignas(64) std::array<uint8_t, SECRET_SIZE> secret;
+
+	// Input not consumed yet, always holds the last bytes of the input once more than BUFFER_SIZE bytes are hashed
+	alignas(64) std::array<uint8_t, BUFFER_SIZE> buffer;
+
+	size_t buffered_size = 0;
+
+	size_t stripes_in_block = 0;
+
+	uint64_t total_size = 0;
+};
+}        // namespace detail
+
+/**
+ * @brief Incremental content hash, for data which is produced or read in pieces
+ *
+ * The input is split into chunks of CHUNK_SIZE bytes, each hashed on its own, and the digests of the chunks are hashed
+ * in order along with the input size. Inputs of up to one chunk hash to the digest of that chunk. The split does not
+ * depend on how the input is handed to update(), so hashing data in pieces, for example while it is read from a file,
+ * gives the same digest as hashing it at once, including with several threads through content_hash64().
+ */
+class ContentHasher
+{
+  public:
+	static constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+	explicit ContentHasher(uint64_t seed = 0);
+
+	void update(std::span<const uint8_t> data);
+
+	void update(std::string_view data);
+
+	/**
+	 * @brief Hashes the bytes of trivially copyable values, such as the words of a SPIR-V binary
+	 */
+	template <typename T>
+	void update_values(std::span<const T> values)
+	{
+		update(std::span<const uint8_t>(reinterpret_cast<const uint8_t *>(values.data()), values.size_bytes()));
+	}
+
+	uint64_t digest64() const;
+
+	Hash128 digest128() const;
+
+  private:
+	uint64_t seed;
+
+	// Hash of the digests of the completed chunks
+	detail::HashState root;
+
+	detail::HashState chunk;
+
+	size_t chunk_count = 0;
+};
+
+/**
+ * @brief Hashes a buffer, the digest is the one of a ContentHasher fed with the same bytes
+ * @param data Bytes to hash
+ * @param seed Seed of the hash
+ * @param thread_count Number of threads hashing the chunks of large buffers, 0 for one per hardware thread
+ */
+uint64_t content_hash64(std::span<const uint8_t> data, uint64_t seed = 0, uint32_t thread_count = 1);
+
+Hash128 content_hash128(std::span<const uint8_t> data, uint64_t seed = 0, uint32_t thread_count = 1);
+
+uint64_t content_hash64(std::string_view data, uint64_t seed = 0);
+}        // namespace vkb
@@ -0,0 +1,273 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/ktx_transcoder.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "common/content_hash.h"
+#include "common/error.h"
+#include "common/glm_common.h"
+#include "common/utils.h"
+#include "timer.h"
+
+#include <filesystem/filesystem.hpp>
+
+#define BASISU_CACHE_DIRECTORY "cache/basisu_transcoded"
+
+namespace vkb
+{
+namespace ktx
+{
+namespace
+{
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+
+double to_mb_per_s(size_t bytes, double time_ms)
+{
+	return time_ms > 0.0 ? (static_cast<double>(bytes) / BYTES_PER_MB) / (time_ms / 1000.0) : 0.0;
+}
+}        // namespace
+
+void Texture2Deleter::operator()(ktxTexture2 *texture) const
+{
+	if (texture)
+	{
+		ktxTexture_Destroy(ktxTexture(texture));
+	}
+}
+
+double TranscodeResult::throughput_mb_per_s() const
+{
+	return to_mb_per_s(transcoded_bytes, transcode_time_ms);
+}
+
+double TranscodeThroughput::mb_per_s() const
+{
+	return to_mb_per_s(transcoded_bytes, transcode_time_ms);
+}
+
+Transcoder::Transcoder(uint32_t thread_count, bool use_cache) :
+    use_cache{use_cache}
+{
+	if (thread_count == 0)
+	{
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	workers.reserve(thread_count);
+	for (uint32_t i = 0; i < thread_count; ++i)
+	{
+		workers.emplace_back(&Transcoder::worker_loop, this);
+	}
+}
+
+Transcoder::~Transcoder()
+{
+	{
+		std::lock_guard<std::mutex> lock{jobs_mutex};
+		stopping = true;
+	}
+	jobs_condition.notify_all();
+
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+}
+
+std::future<std::unique_ptr<TranscodeResult>> Transcoder::request(const std::string &filename, ktx_transcode_fmt_e target_format)
+{
+	std::packaged_task<std::unique_ptr<TranscodeResult>()> job{[this, filename, target_format]() {
+		return transcode(filename, target_format);
+	}};
+
+	auto future = job.get_future();
+	{
+		std::lock_guard<std::mutex> lock{jobs_mutex};
+		jobs.push_back(std::move(job));
+	}
+	jobs_condition.notify_one();
+
+	return future;
+}
+
+std::vector<std::future<std::unique_ptr<TranscodeResult>>> Transcoder::request(const std::vector<std::string> &filenames, ktx_transcode_fmt_e target_format)
+{
+	std::vector<std::future<std::unique_ptr<TranscodeResult>>> futures;
+	futures.reserve(filenames.size());
+	for (auto &filename : filenames)
+	{
+		futures.push_back(request(filename, target_format));
+	}
+	return futures;
+}
+
+TranscodeThroughput Transcoder::get_throughput(ktx_transcode_fmt_e target_format) const
+{
+	std::lock_guard<std::mutex> lock{throughput_mutex};
+
+	auto it = throughput.find(static_cast<int>(target_format));
+	return it != throughput.end() ? it->second : TranscodeThroughput{};
+}
+
+uint32_t Transcoder::get_thread_count() const
+{
+	return to_u32(workers.size());
+}
+
+void Transcoder::worker_loop()
+{
+	while (true)
+	{
+		std::packaged_task<std::unique_ptr<TranscodeResult>()> job;
+		{
+			std::unique_lock<std::mutex> lock{jobs_mutex};
+			jobs_condition.wait(lock, [this] { return stopping || !jobs.empty(); });
+
+			if (stopping && jobs.empty())
+			{
+				return;
+			}
+
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+
+		// Exceptions thrown by the job are stored in its future
+		job();
+	}
+}
+
+std::unique_ptr<TranscodeResult> Transcoder::transcode(const std::string &filename, ktx_transcode_fmt_e target_format)
+{
+	auto fs = vkb::filesystem::get();
+
+	// The file is read in chunks, each hashed for the cache key as soon as it is read
+	size_t               file_size = fs->stat_file(filename).size;
+	std::vector<uint8_t> source(file_size);
+
+	// The target format seeds the hash, so that each format has its own cache entry
+	vkb::ContentHasher hasher{static_cast<uint64_t>(target_format)};
+
+	size_t offset = 0;
+	while (offset < file_size)
+	{
+		auto chunk = fs->read_chunk(filename, offset, std::min(vkb::ContentHasher::CHUNK_SIZE, file_size - offset));
+		if (chunk.empty())
+		{
+			break;
+		}
+
+		chunk.resize(std::min(chunk.size(), file_size - offset));
+		hasher.update(std::span<const uint8_t>{chunk.data(), chunk.size()});
+		std::copy(chunk.begin(), chunk.end(), source.begin() + offset);
+		offset += chunk.size();
+	}
+
+	if (source.empty() || offset != file_size)
+	{
+		throw std::runtime_error{"Could not read KTX2 file: " + filename};
+	}
+
+	uint64_t key = hasher.digest64();
+
+	const std::string cache_path = fmt::format("{}/{:016x}.ktx2", BASISU_CACHE_DIRECTORY, key);
+
+	auto result           = std::make_unique<TranscodeResult>();
+	result->target_format = target_format;
+	result->source_bytes  = source.size();
+
+	Timer timer;
+	timer.start();
+
+	if (use_cache && fs->exists(cache_path))
+	{
+		auto         cached = fs->read_file_binary(cache_path);
+		ktxTexture2 *texture{nullptr};
+		if (ktxTexture2_CreateFromMemory(cached.data(), cached.size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &texture) == KTX_SUCCESS)
+		{
+			result->texture = Texture2Ptr{texture};
+			if (!ktxTexture2_NeedsTranscoding(texture))
+			{
+				result->from_cache        = true;
+				result->transcoded_bytes  = texture->dataSize;
+				result->transcode_time_ms = timer.stop<Timer::Milliseconds>();
+				LOGD("Loaded transcoded texture {} from cache file {}", filename, cache_path);
+				return result;
+			}
+		}
+		LOGW("Ignoring invalid transcode cache file {}", cache_path);
+	}
+
+	ktxTexture2 *texture{nullptr};
+	if (ktxTexture2_CreateFromMemory(source.data(), source.size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &texture) != KTX_SUCCESS)
+	{
+		throw std::runtime_error{"Could not load KTX2 file: " + filename};
+	}
+	result->texture = Texture2Ptr{texture};
+
+	// Restart the timer, so only the transcode itself is accounted for in the throughput
+	timer.stop();
+	timer.start();
+
+	if (ktxTexture2_NeedsTranscoding(texture))
+	{
+		if (ktxTexture2_TranscodeBasis(texture, target_format, 0) != KTX_SUCCESS)
+		{
+			throw std::runtime_error{"Could not transcode " + filename + " to the selected target format"};
+		}
+	}
+
+	result->transcode_time_ms = timer.stop<Timer::Milliseconds>();
+	result->transcoded_bytes  = texture->dataSize;
+
+	{
+		std::lock_guard<std::mutex> lock{throughput_mutex};
+
+		auto &format_throughput = throughput[static_cast<int>(target_format)];
+		format_throughput.transcoded_bytes += result->transcoded_bytes;
+		format_throughput.transcode_time_ms += result->transcode_time_ms;
+		format_throughput.texture_count++;
+	}
+
+	if (use_cache)
+	{
+		ktx_uint8_t *bytes{nullptr};
+		ktx_size_t   size{0};
+		if (ktxTexture_WriteToMemory(ktxTexture(texture), &bytes, &size) == KTX_SUCCESS)
+		{
+			try
+			{
+				fs->write_file(cache_path, std::vector<uint8_t>(bytes, bytes + size));
+			}
+			catch (const std::runtime_error &e)
+			{
+				LOGE("Could not write transcode cache file {}: {}", cache_path, e.what());
+			}
+			free(bytes);
+		}
+	}
+
+	return result;
+}
+}        // namespace ktx
+}        // namespace vkb
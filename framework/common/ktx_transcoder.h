@@ -0,0 +1,144 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <ktx.h>
+
+namespace vkb
+{
+namespace ktx
+{
+struct Texture2Deleter
+{
+	void operator()(ktxTexture2 *texture) const;
+};
+
+using Texture2Ptr = std::unique_ptr<ktxTexture2, Texture2Deleter>;
+
+/**
+ * @brief The outcome of a single transcode request
+ */
+struct TranscodeResult
+{
+	Texture2Ptr         texture;
+	ktx_transcode_fmt_e target_format     = KTX_TTF_NOSELECTION;
+	size_t              source_bytes      = 0;            // Size of the supercompressed KTX2 file
+	size_t              transcoded_bytes  = 0;            // Size of the native GPU payload
+	double              transcode_time_ms = 0.0;          // Time spent transcoding, or loading from the cache
+	bool                from_cache        = false;        // True if the payload was read from the transcode cache
+
+	/**
+	 * @brief Transcoded bytes per second, in MB/s
+	 */
+	double throughput_mb_per_s() const;
+};
+
+/**
+ * @brief Transcode throughput accumulated over all requests for one target format
+ */
+struct TranscodeThroughput
+{
+	size_t   transcoded_bytes  = 0;
+	double   transcode_time_ms = 0.0;
+	uint32_t texture_count     = 0;
+
+	/**
+	 * @brief Transcoded bytes per second, in MB/s
+	 */
+	double mb_per_s() const;
+};
+
+/**
+ * @brief Transcodes Basis Universal KTX2 textures to native GPU formats on a pool of worker threads
+ *
+ * Requests return immediately with a future, so callers can keep rendering with their previous
+ * texture until the transcoded one is ready. Transcoded payloads are written to a disk cache keyed
+ * by the hash of the source file and the target format, so each texture is transcoded only once.
+ */
+class Transcoder
+{
+  public:
+	/**
+	 * @param thread_count Number of worker threads, 0 uses the hardware concurrency
+	 * @param use_cache Whether transcoded payloads are read from and written to the disk cache
+	 */
+	explicit Transcoder(uint32_t thread_count = 0, bool use_cache = true);
+
+	Transcoder(const Transcoder &) = delete;
+
+	Transcoder(Transcoder &&) = delete;
+
+	~Transcoder();
+
+	Transcoder &operator=(const Transcoder &) = delete;
+
+	Transcoder &operator=(Transcoder &&) = delete;
+
+	/**
+	 * @brief Queues a KTX2 file for transcoding
+	 * @param filename Absolute path to the KTX2 file
+	 * @param target_format The native format to transcode to
+	 * @return A future that becomes ready once the texture has been transcoded
+	 */
+	std::future<std::unique_ptr<TranscodeResult>> request(const std::string &filename, ktx_transcode_fmt_e target_format);
+
+	/**
+	 * @brief Queues a list of KTX2 files for transcoding, so they are processed in parallel
+	 */
+	std::vector<std::future<std::unique_ptr<TranscodeResult>>> request(const std::vector<std::string> &filenames, ktx_transcode_fmt_e target_format);
+
+	/**
+	 * @return The throughput of all non-cached transcodes to the given format so far
+	 */
+	TranscodeThroughput get_throughput(ktx_transcode_fmt_e target_format) const;
+
+	uint32_t get_thread_count() const;
+
+  private:
+	std::unique_ptr<TranscodeResult> transcode(const std::string &filename, ktx_transcode_fmt_e target_format);
+
+	void worker_loop();
+
+	bool use_cache;
+
+	std::vector<std::thread> workers;
+
+	std::deque<std::packaged_task<std::unique_ptr<TranscodeResult>()>> jobs;
+
+	std::mutex jobs_mutex;
+
+	std::condition_variable jobs_condition;
+
+	bool stopping{false};
+
+	mutable std::mutex throughput_mutex;
+
+	std::unordered_map<int, TranscodeThroughput> throughput;
+};
+}        // namespace ktx
+}        // namespace vkb
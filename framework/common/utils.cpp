@@ -22,6 +22,7 @@
 
 #include "core/command_buffer.h"
 #include "rendering/render_frame.h"
+#include "rendering/render_graph.h"
 #include "scene_graph/components/material.h"
 #include "scene_graph/components/perspective_camera.h"
 #include "scene_graph/components/sub_mesh.h"
@@ -70,66 +71,43 @@ void screenshot(vkb::rendering::RenderContextC &render_context, const std::strin
 
 	cmd_buf->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 
-	// Enable destination buffer to be written to
-	{
-		BufferMemoryBarrier memory_barrier{};
-		memory_barrier.src_access_mask = 0;
-		memory_barrier.dst_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-
-		cmd_buf->buffer_memory_barrier(dst_buffer, 0, dst_size, memory_barrier);
-	}
-
-	// Enable framebuffer image view to be read from
-	{
-		ImageMemoryBarrier memory_barrier{};
-		memory_barrier.old_layout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-		memory_barrier.new_layout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-		memory_barrier.src_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-
-		cmd_buf->image_memory_barrier(src_image_view, memory_barrier);
-	}
-
 	// Check if framebuffer images are in a BGR format
 	auto bgr_formats = {VK_FORMAT_B8G8R8A8_SRGB, VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_B8G8R8A8_SNORM};
 	bool swizzle     = std::ranges::find(bgr_formats, src_image_view.get_format()) != bgr_formats.end();
 
-	// Copy framebuffer image memory
-	VkBufferImageCopy image_copy_region{};
-	image_copy_region.bufferRowLength             = width;
-	image_copy_region.bufferImageHeight           = height;
-	image_copy_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	image_copy_region.imageSubresource.layerCount = 1;
-	image_copy_region.imageExtent.width           = width;
-	image_copy_region.imageExtent.height          = height;
-	image_copy_region.imageExtent.depth           = 1;
-
-	cmd_buf->copy_image_to_buffer(
-	    src_image_view.get_image(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_buffer, {image_copy_region});
-
-	// Enable destination buffer to map memory
-	{
-		BufferMemoryBarrier memory_barrier{};
-		memory_barrier.src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		memory_barrier.dst_access_mask = VK_ACCESS_HOST_READ_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_HOST_BIT;
-
-		cmd_buf->buffer_memory_barrier(dst_buffer, 0, dst_size, memory_barrier);
-	}
-
-	// Revert back the framebuffer image view from transfer to present
-	{
-		ImageMemoryBarrier memory_barrier{};
-		memory_barrier.old_layout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-		memory_barrier.new_layout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-		memory_barrier.src_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-
-		cmd_buf->image_memory_barrier(src_image_view, memory_barrier);
-	}
+	// The frame was rendered then presented, the image goes back to present once copied and the buffer is read by the host
+	vkb::rendering::RenderGraph graph;
+
+	auto     subresource_range = src_image_view.get_subresource_range();
+	uint32_t image             = graph.import_image("Swapchain image",
+	                                                vk::Image{src_image_view.get_image().get_handle()},
+	                                                reinterpret_cast<vk::ImageSubresourceRange const &>(subresource_range),
+	                                                {vk::PipelineStageFlagBits2::eColorAttachmentOutput, vk::AccessFlagBits2::eColorAttachmentWrite, vk::ImageLayout::ePresentSrcKHR});
+	graph.set_final_state(image, vkb::rendering::access::present);
+
+	uint32_t buffer = graph.import_buffer("Screenshot buffer", vk::Buffer{dst_buffer.get_handle()}, 0, dst_size);
+	graph.set_final_state(buffer, vkb::rendering::access::host_read);
+
+	graph.add_pass("Screenshot copy")
+	    .read(image, vkb::rendering::access::transfer_read)
+	    .write(buffer, vkb::rendering::access::transfer_write)
+	    .set_execute_func([&](vk::CommandBuffer) {
+		    // Copy framebuffer image memory
+		    VkBufferImageCopy image_copy_region{};
+		    image_copy_region.bufferRowLength             = width;
+		    image_copy_region.bufferImageHeight           = height;
+		    image_copy_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		    image_copy_region.imageSubresource.layerCount = 1;
+		    image_copy_region.imageExtent.width           = width;
+		    image_copy_region.imageExtent.height          = height;
+		    image_copy_region.imageExtent.depth           = 1;
+
+		    cmd_buf->copy_image_to_buffer(
+		        src_image_view.get_image(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_buffer, {image_copy_region});
+	    });
+
+	graph.compile(queue.get_family_index(), queue.get_family_index());
+	graph.record(0, vk::CommandBuffer{cmd_buf->get_handle()}, render_context.get_device().is_synchronization2_enabled());
 
 	cmd_buf->end();
 
@@ -301,25 +279,4 @@ vkb::scene_graph::NodeC &
 	return *camera_node;
 }
 
-size_t calculate_hash(const std::vector<uint8_t> &data)
-{
-	static_assert(sizeof(data[0]) == 1);
-	constexpr size_t chunk_size = sizeof(size_t) / sizeof(data[0]);
-	size_t           data_hash  = 0;
-	size_t           offset     = 0;
-
-	for (; offset + chunk_size < data.size(); offset += chunk_size)
-	{
-		glm::detail::hash_combine(data_hash, *reinterpret_cast<size_t const *>(&data[offset]));
-	}
-
-	if (offset < data.size())
-	{
-		size_t it = 0;
-		std::memcpy(&it, &data[offset], data.size() - offset);
-		glm::detail::hash_combine(data_hash, it);
-	}
-	return data_hash;
-}
-
 }        // namespace vkb
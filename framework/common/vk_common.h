@@ -61,6 +61,16 @@ enum class RequestMode
 	Required
 };
 
+/**
+ * @brief How a command buffer provides the descriptor sets of the pipeline layouts it binds
+ */
+enum class DescriptorBackend
+{
+	Pooled,                // Descriptor sets allocated from descriptor pools and bound with vkCmdBindDescriptorSets
+	PushDescriptor,        // Small sets written into the command buffer with vkCmdPushDescriptorSetKHR
+	DescriptorBuffer       // Descriptors written into a per-frame descriptor heap, with VK_EXT_descriptor_buffer
+};
+
 /**
  * @brief Helper function to determine if a Vulkan format is depth only.
  * @param format Vulkan format to check.
@@ -1,4 +1,4 @@
-/* Copyright (c) 2021-2025, Sascha Willems
+/* Copyright (c) 2021-2026, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -32,6 +32,8 @@ AccelerationStructure::AccelerationStructure(vkb::core::DeviceC            &devi
 
 AccelerationStructure::~AccelerationStructure()
 {
+	release_compaction_source();
+
 	if (handle != VK_NULL_HANDLE)
 	{
 		vkDestroyAccelerationStructureKHR(device.get_handle(), handle, nullptr);
@@ -131,31 +133,57 @@ void AccelerationStructure::update_instance_geometry(uint64_t
 }
 
 void AccelerationStructure::build(VkQueue queue, VkBuildAccelerationStructureFlagsKHR flags, VkBuildAccelerationStructureModeKHR mode)
+{
+	VkDeviceSize scratch_size = prepare_build(flags, mode);
+
+	// Create a scratch buffer as a temporary storage for the acceleration structure build
+	scratch_buffer = std::make_unique<vkb::core::BufferC>(
+	    device,
+	    BufferBuilderC(scratch_size)
+	        .with_usage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+	        .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
+	        .with_alignment(scratch_buffer_alignment));
+
+	build_geometry_info.scratchData.deviceAddress = scratch_buffer->get_device_address();
+
+	// Build the acceleration structure on the device via a one-time command buffer submission
+	VkCommandBuffer command_buffer       = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+	auto            as_build_range_infos = build_range_infos.data();
+	vkCmdBuildAccelerationStructuresKHR(
+	    command_buffer,
+	    1,
+	    &build_geometry_info,
+	    &as_build_range_infos);
+	device.flush_command_buffer(command_buffer, queue);
+	scratch_buffer.reset();
+}
+
+VkDeviceSize AccelerationStructure::prepare_build(VkBuildAccelerationStructureFlagsKHR flags, VkBuildAccelerationStructureModeKHR mode)
 {
 	assert(!geometries.empty());
 
-	std::vector<VkAccelerationStructureGeometryKHR>       acceleration_structure_geometries;
-	std::vector<VkAccelerationStructureBuildRangeInfoKHR> acceleration_structure_build_range_infos;
-	std::vector<uint32_t>                                 primitive_counts;
+	build_geometries.clear();
+	build_range_infos.clear();
+	std::vector<uint32_t> primitive_counts;
 	for (auto &geometry : geometries)
 	{
 		if (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR && !geometry.second.updated)
 		{
 			continue;
 		}
-		acceleration_structure_geometries.push_back(geometry.second.geometry);
+		build_geometries.push_back(geometry.second.geometry);
 		// Infer build range info from geometry
 		VkAccelerationStructureBuildRangeInfoKHR build_range_info;
 		build_range_info.primitiveCount  = geometry.second.primitive_count;
 		build_range_info.primitiveOffset = 0;
 		build_range_info.firstVertex     = 0;
 		build_range_info.transformOffset = geometry.second.transform_offset;
-		acceleration_structure_build_range_infos.push_back(build_range_info);
+		build_range_infos.push_back(build_range_info);
 		primitive_counts.push_back(geometry.second.primitive_count);
 		geometry.second.updated = false;
 	}
 
-	VkAccelerationStructureBuildGeometryInfoKHR build_geometry_info{};
+	build_geometry_info       = {};
 	build_geometry_info.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
 	build_geometry_info.type  = type;
 	build_geometry_info.flags = flags;
@@ -165,8 +193,8 @@ void AccelerationStructure::build(VkQueue queue, VkBuildAccelerationStructureFla
 		build_geometry_info.srcAccelerationStructure = handle;
 		build_geometry_info.dstAccelerationStructure = handle;
 	}
-	build_geometry_info.geometryCount = static_cast<uint32_t>(acceleration_structure_geometries.size());
-	build_geometry_info.pGeometries   = acceleration_structure_geometries.data();
+	build_geometry_info.geometryCount = static_cast<uint32_t>(build_geometries.size());
+	build_geometry_info.pGeometries   = build_geometries.data();
 
 	// Get required build sizes
 	build_sizes_info.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
@@ -177,26 +205,85 @@ void AccelerationStructure::build(VkQueue queue, VkBuildAccelerationStructureFla
 	    primitive_counts.data(),
 	    &build_sizes_info);
 
-	// Create a buffer for the acceleration structure
-	if (!buffer || buffer->get_size() != build_sizes_info.accelerationStructureSize)
+	// Create a buffer for the acceleration structure, an update writes to the acceleration structure it reads from
+	if (!buffer || (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR && buffer->get_size() != build_sizes_info.accelerationStructureSize))
 	{
-		buffer = std::make_unique<vkb::core::BufferC>(
-		    device,
-		    build_sizes_info.accelerationStructureSize,
-		    VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-		    VMA_MEMORY_USAGE_GPU_ONLY);
-
-		VkAccelerationStructureCreateInfoKHR acceleration_structure_create_info{};
-		acceleration_structure_create_info.sType  = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
-		acceleration_structure_create_info.buffer = buffer->get_handle();
-		acceleration_structure_create_info.size   = build_sizes_info.accelerationStructureSize;
-		acceleration_structure_create_info.type   = type;
-		VkResult result                           = vkCreateAccelerationStructureKHR(device.get_handle(), &acceleration_structure_create_info, nullptr, &handle);
-
-		if (result != VK_SUCCESS)
-		{
-			throw VulkanException{result, "Could not create acceleration structure"};
-		}
+		create_handle(build_sizes_info.accelerationStructureSize);
+	}
+
+	build_geometry_info.dstAccelerationStructure = handle;
+
+	if (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR)
+	{
+		refit_count++;
+		return build_sizes_info.updateScratchSize;
+	}
+	refit_count = 0;
+	return build_sizes_info.buildScratchSize;
+}
+
+VkAccelerationStructureBuildGeometryInfoKHR &AccelerationStructure::get_build_geometry_info()
+{
+	return build_geometry_info;
+}
+
+const VkAccelerationStructureBuildRangeInfoKHR *AccelerationStructure::get_build_range_infos() const
+{
+	return build_range_infos.data();
+}
+
+void AccelerationStructure::compact(VkCommandBuffer command_buffer, VkDeviceSize compacted_size)
+{
+	assert(handle != VK_NULL_HANDLE && compaction_source_handle == VK_NULL_HANDLE);
+
+	compaction_source_handle = handle;
+	compaction_source_buffer = std::move(buffer);
+	handle                   = VK_NULL_HANDLE;
+
+	create_handle(compacted_size);
+
+	VkCopyAccelerationStructureInfoKHR copy_info{};
+	copy_info.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+	copy_info.src   = compaction_source_handle;
+	copy_info.dst   = handle;
+	copy_info.mode  = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+	vkCmdCopyAccelerationStructureKHR(command_buffer, &copy_info);
+}
+
+void AccelerationStructure::release_compaction_source()
+{
+	if (compaction_source_handle != VK_NULL_HANDLE)
+	{
+		vkDestroyAccelerationStructureKHR(device.get_handle(), compaction_source_handle, nullptr);
+		compaction_source_handle = VK_NULL_HANDLE;
+	}
+	compaction_source_buffer.reset();
+}
+
+void AccelerationStructure::create_handle(VkDeviceSize size)
+{
+	if (handle != VK_NULL_HANDLE)
+	{
+		vkDestroyAccelerationStructureKHR(device.get_handle(), handle, nullptr);
+		handle = VK_NULL_HANDLE;
+	}
+
+	buffer = std::make_unique<vkb::core::BufferC>(
+	    device,
+	    size,
+	    VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+	    VMA_MEMORY_USAGE_GPU_ONLY);
+
+	VkAccelerationStructureCreateInfoKHR acceleration_structure_create_info{};
+	acceleration_structure_create_info.sType  = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+	acceleration_structure_create_info.buffer = buffer->get_handle();
+	acceleration_structure_create_info.size   = size;
+	acceleration_structure_create_info.type   = type;
+	VkResult result                           = vkCreateAccelerationStructureKHR(device.get_handle(), &acceleration_structure_create_info, nullptr, &handle);
+
+	if (result != VK_SUCCESS)
+	{
+		throw VulkanException{result, "Could not create acceleration structure"};
 	}
 
 	// Get the acceleration structure's handle
@@ -204,28 +291,6 @@ void AccelerationStructure::build(VkQueue queue, VkBuildAccelerationStructureFla
 	acceleration_device_address_info.sType                 = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
 	acceleration_device_address_info.accelerationStructure = handle;
 	device_address                                         = vkGetAccelerationStructureDeviceAddressKHR(device.get_handle(), &acceleration_device_address_info);
-
-	// Create a scratch buffer as a temporary storage for the acceleration structure build
-	scratch_buffer = std::make_unique<vkb::core::BufferC>(
-	    device,
-	    BufferBuilderC(build_sizes_info.buildScratchSize)
-	        .with_usage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
-	        .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
-	        .with_alignment(scratch_buffer_alignment));
-
-	build_geometry_info.scratchData.deviceAddress = scratch_buffer->get_device_address();
-	build_geometry_info.dstAccelerationStructure  = handle;
-
-	// Build the acceleration structure on the device via a one-time command buffer submission
-	VkCommandBuffer command_buffer       = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-	auto            as_build_range_infos = &*acceleration_structure_build_range_infos.data();
-	vkCmdBuildAccelerationStructuresKHR(
-	    command_buffer,
-	    1,
-	    &build_geometry_info,
-	    &as_build_range_infos);
-	device.flush_command_buffer(command_buffer, queue);
-	scratch_buffer.reset();
 }
 
 VkAccelerationStructureKHR AccelerationStructure::get_handle() const
@@ -243,5 +308,20 @@ uint64_t AccelerationStructure::get_device_address() const
 	return device_address;
 }
 
+uint32_t AccelerationStructure::get_refit_count() const
+{
+	return refit_count;
+}
+
+VkDeviceSize AccelerationStructure::get_size() const
+{
+	return buffer ? buffer->get_size() : 0;
+}
+
+VkAccelerationStructureTypeKHR AccelerationStructure::get_type() const
+{
+	return type;
+}
+
 }        // namespace core
 }        // namespace vkb
\ No newline at end of file
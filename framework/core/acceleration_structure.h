@@ -1,4 +1,4 @@
-/* Copyright (c) 2021-2025, Sascha Willems
+/* Copyright (c) 2021-2026, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -117,12 +117,53 @@ class AccelerationStructure
 	           VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR,
 	           VkBuildAccelerationStructureModeKHR  mode  = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR);
 
+	/**
+	 * @brief Prepares a build recorded by the caller, creating the storage of the acceleration structure if needed
+	 *        (requires at least one geometry to be added)
+	 * @param flags Build flags
+	 * @param mode Build mode (build or update)
+	 * @returns Size of the scratch memory needed by the build
+	 */
+	VkDeviceSize prepare_build(VkBuildAccelerationStructureFlagsKHR flags, VkBuildAccelerationStructureModeKHR mode);
+
+	/**
+	 * @brief Geometry info of the prepared build, the caller sets its scratch data before recording it
+	 */
+	VkAccelerationStructureBuildGeometryInfoKHR &get_build_geometry_info();
+
+	/**
+	 * @brief Build range infos of the prepared build, one per geometry of the build geometry info
+	 */
+	const VkAccelerationStructureBuildRangeInfoKHR *get_build_range_infos() const;
+
+	/**
+	 * @brief Records a compacting copy of the acceleration structure, which is then replaced by the copy
+	 *        The replaced acceleration structure is kept until release_compaction_source is called, once the copy executed
+	 * @param command_buffer Command buffer recording the copy, the build of the acceleration structure must have completed
+	 * @param compacted_size Size queried with VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR
+	 */
+	void compact(VkCommandBuffer command_buffer, VkDeviceSize compacted_size);
+
+	void release_compaction_source();
+
 	VkAccelerationStructureKHR get_handle() const;
 
 	const VkAccelerationStructureKHR *get() const;
 
 	uint64_t get_device_address() const;
 
+	/**
+	 * @returns Number of updates since the acceleration structure was last built
+	 */
+	uint32_t get_refit_count() const;
+
+	/**
+	 * @returns Size of the memory storing the acceleration structure
+	 */
+	VkDeviceSize get_size() const;
+
+	VkAccelerationStructureTypeKHR get_type() const;
+
 	vkb::core::BufferC *get_buffer() const
 	{
 		return buffer.get();
@@ -139,6 +180,8 @@ class AccelerationStructure
 	}
 
   private:
+	void create_handle(VkDeviceSize size);
+
 	vkb::core::DeviceC &device;
 
 	VkAccelerationStructureKHR handle{VK_NULL_HANDLE};
@@ -164,6 +207,19 @@ class AccelerationStructure
 	std::map<uint64_t, Geometry> geometries{};
 
 	std::unique_ptr<vkb::core::BufferC> buffer{nullptr};
+
+	// State of the prepared build, referenced by build_geometry_info
+	std::vector<VkAccelerationStructureGeometryKHR>       build_geometries;
+	std::vector<VkAccelerationStructureBuildRangeInfoKHR> build_range_infos;
+
+	VkAccelerationStructureBuildGeometryInfoKHR build_geometry_info{};
+
+	uint32_t refit_count{0};
+
+	// Acceleration structure replaced by its compacted copy, until the copy executed
+	VkAccelerationStructureKHR compaction_source_handle{VK_NULL_HANDLE};
+
+	std::unique_ptr<vkb::core::BufferC> compaction_source_buffer;
 };
 }        // namespace core
 }        // namespace vkb
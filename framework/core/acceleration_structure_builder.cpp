@@ -0,0 +1,308 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "acceleration_structure_builder.h"
+
+#include "device.h"
+
+namespace vkb
+{
+namespace core
+{
+namespace
+{
+void record_build_barrier(VkCommandBuffer command_buffer)
+{
+	// Makes the acceleration structures written by previous builds readable by the next builds and copies
+	VkMemoryBarrier barrier{};
+	barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+	barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+	vkCmdPipelineBarrier(command_buffer,
+	                     VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+	                     VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+	                     0,
+	                     1,
+	                     &barrier,
+	                     0,
+	                     nullptr,
+	                     0,
+	                     nullptr);
+}
+
+void record_scratch_barrier(VkCommandBuffer command_buffer)
+{
+	// Orders the builds of a batch after the builds of the batches submitted before, which used the same scratch buffer
+	VkMemoryBarrier barrier{};
+	barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+	barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+	vkCmdPipelineBarrier(command_buffer,
+	                     VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+	                     VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+	                     0,
+	                     1,
+	                     &barrier,
+	                     0,
+	                     nullptr,
+	                     0,
+	                     nullptr);
+}
+}        // namespace
+
+AccelerationStructureBuilder::AccelerationStructureBuilder(vkb::core::DeviceC &device) :
+    device{device}
+{
+	VkPhysicalDeviceAccelerationStructurePropertiesKHR acceleration_structure_properties{};
+	acceleration_structure_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR;
+
+	VkPhysicalDeviceProperties2 device_properties{};
+	device_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+	device_properties.pNext = &acceleration_structure_properties;
+	vkGetPhysicalDeviceProperties2(device.get_gpu().get_handle(), &device_properties);
+
+	scratch_alignment = acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment;
+}
+
+void AccelerationStructureBuilder::add_build(AccelerationStructure &acceleration_structure, VkBuildAccelerationStructureFlagsKHR flags)
+{
+	requests.push_back({&acceleration_structure, flags, VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR, 0});
+}
+
+void AccelerationStructureBuilder::add_update(AccelerationStructure &acceleration_structure, VkBuildAccelerationStructureFlagsKHR flags)
+{
+	bool refit = (acceleration_structure.get_handle() != VK_NULL_HANDLE) &&
+	             (flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR) &&
+	             (acceleration_structure.get_refit_count() < max_refits);
+
+	requests.push_back({&acceleration_structure, flags, refit ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR, 0});
+}
+
+void AccelerationStructureBuilder::build(VkQueue queue)
+{
+	if (requests.empty())
+	{
+		return;
+	}
+
+	std::vector<Request *> bottom_level_requests;
+	std::vector<Request *> top_level_requests;
+	std::vector<Request *> compacted_requests;
+	prepare_batch(bottom_level_requests, top_level_requests, compacted_requests);
+
+	VkCommandBuffer command_buffer = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+	record_builds(command_buffer, bottom_level_requests);
+	if (!bottom_level_requests.empty() && !top_level_requests.empty())
+	{
+		record_build_barrier(command_buffer);
+	}
+	record_builds(command_buffer, top_level_requests);
+
+	if (!compacted_requests.empty())
+	{
+		uint32_t compacted_count = static_cast<uint32_t>(compacted_requests.size());
+		if (query_count < compacted_count)
+		{
+			VkQueryPoolCreateInfo query_pool_info{};
+			query_pool_info.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			query_pool_info.queryType  = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+			query_pool_info.queryCount = compacted_count;
+			query_pool                 = std::make_unique<vkb::QueryPool>(device, query_pool_info);
+			query_count                = compacted_count;
+		}
+
+		std::vector<VkAccelerationStructureKHR> handles;
+		handles.reserve(compacted_requests.size());
+		for (auto *request : compacted_requests)
+		{
+			handles.push_back(request->acceleration_structure->get_handle());
+		}
+
+		// The compacted sizes are only known once the builds completed
+		vkCmdResetQueryPool(command_buffer, query_pool->get_handle(), 0, compacted_count);
+		record_build_barrier(command_buffer);
+		vkCmdWriteAccelerationStructuresPropertiesKHR(command_buffer,
+		                                              compacted_count,
+		                                              handles.data(),
+		                                              VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+		                                              query_pool->get_handle(),
+		                                              0);
+	}
+
+	device.flush_command_buffer(command_buffer, queue);
+
+	if (!compacted_requests.empty())
+	{
+		compact(queue, compacted_requests);
+	}
+
+	requests.clear();
+}
+
+void AccelerationStructureBuilder::record(VkCommandBuffer command_buffer)
+{
+	if (requests.empty())
+	{
+		return;
+	}
+
+	std::vector<Request *> bottom_level_requests;
+	std::vector<Request *> top_level_requests;
+	std::vector<Request *> compacted_requests;
+	prepare_batch(bottom_level_requests, top_level_requests, compacted_requests);
+	assert(compacted_requests.empty() && "Acceleration structures are only compacted by build");
+
+	// The scratch buffer may still be written by the batch recorded for a previous frame
+	record_scratch_barrier(command_buffer);
+
+	record_builds(command_buffer, bottom_level_requests);
+	if (!bottom_level_requests.empty() && !top_level_requests.empty())
+	{
+		record_build_barrier(command_buffer);
+	}
+	record_builds(command_buffer, top_level_requests);
+
+	requests.clear();
+}
+
+void AccelerationStructureBuilder::set_max_refits(uint32_t max_refits_)
+{
+	max_refits = max_refits_;
+}
+
+const AccelerationStructureBuilder::Statistics &AccelerationStructureBuilder::get_statistics() const
+{
+	return statistics;
+}
+
+void AccelerationStructureBuilder::prepare_batch(std::vector<Request *> &bottom_level_requests,
+                                                 std::vector<Request *> &top_level_requests,
+                                                 std::vector<Request *> &compacted_requests)
+{
+	// Each build of the batch uses its own range of the scratch buffer, as the builds of a level may overlap
+	VkDeviceSize scratch_size = 0;
+	for (auto &request : requests)
+	{
+		VkDeviceSize request_scratch_size = request.acceleration_structure->prepare_build(request.flags, request.mode);
+
+		request.scratch_offset = scratch_size;
+		scratch_size           = scratch_size + request_scratch_size;
+		if (scratch_alignment > 0)
+		{
+			scratch_size = (scratch_size + scratch_alignment - 1) / scratch_alignment * scratch_alignment;
+		}
+	}
+	reserve_scratch(scratch_size);
+
+	for (auto &request : requests)
+	{
+		request.acceleration_structure->get_build_geometry_info().scratchData.deviceAddress = scratch_buffer->get_device_address() + request.scratch_offset;
+
+		if (request.acceleration_structure->get_type() == VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR)
+		{
+			bottom_level_requests.push_back(&request);
+		}
+		else
+		{
+			top_level_requests.push_back(&request);
+		}
+
+		if (request.mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR)
+		{
+			statistics.refit_count++;
+			continue;
+		}
+		statistics.build_count++;
+
+		if ((request.flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR) && !(request.flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR))
+		{
+			compacted_requests.push_back(&request);
+		}
+	}
+}
+
+void AccelerationStructureBuilder::reserve_scratch(VkDeviceSize size)
+{
+	if (scratch_buffer && scratch_buffer->get_size() >= size)
+	{
+		return;
+	}
+
+	scratch_buffer = std::make_unique<vkb::core::BufferC>(
+	    device,
+	    BufferBuilderC(size)
+	        .with_usage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+	        .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
+	        .with_alignment(scratch_alignment));
+
+	statistics.scratch_size = size;
+}
+
+void AccelerationStructureBuilder::record_builds(VkCommandBuffer command_buffer, const std::vector<Request *> &level_requests)
+{
+	if (level_requests.empty())
+	{
+		return;
+	}
+
+	std::vector<VkAccelerationStructureBuildGeometryInfoKHR>      build_geometry_infos;
+	std::vector<const VkAccelerationStructureBuildRangeInfoKHR *> build_range_infos;
+	build_geometry_infos.reserve(level_requests.size());
+	build_range_infos.reserve(level_requests.size());
+	for (auto *request : level_requests)
+	{
+		build_geometry_infos.push_back(request->acceleration_structure->get_build_geometry_info());
+		build_range_infos.push_back(request->acceleration_structure->get_build_range_infos());
+	}
+
+	vkCmdBuildAccelerationStructuresKHR(command_buffer,
+	                                    static_cast<uint32_t>(build_geometry_infos.size()),
+	                                    build_geometry_infos.data(),
+	                                    build_range_infos.data());
+}
+
+void AccelerationStructureBuilder::compact(VkQueue queue, const std::vector<Request *> &compacted_requests)
+{
+	std::vector<VkDeviceSize> compacted_sizes(compacted_requests.size());
+	VK_CHECK(query_pool->get_results(0,
+	                                 static_cast<uint32_t>(compacted_sizes.size()),
+	                                 compacted_sizes.size() * sizeof(VkDeviceSize),
+	                                 compacted_sizes.data(),
+	                                 sizeof(VkDeviceSize),
+	                                 VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT));
+
+	VkCommandBuffer command_buffer = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+	for (size_t i = 0; i < compacted_requests.size(); ++i)
+	{
+		auto &acceleration_structure = *compacted_requests[i]->acceleration_structure;
+
+		statistics.original_size  += acceleration_structure.get_size();
+		statistics.compacted_size += compacted_sizes[i];
+		statistics.compaction_count++;
+
+		acceleration_structure.compact(command_buffer, compacted_sizes[i]);
+	}
+	device.flush_command_buffer(command_buffer, queue);
+
+	for (auto *request : compacted_requests)
+	{
+		request->acceleration_structure->release_compaction_source();
+	}
+}
+}        // namespace core
+}        // namespace vkb
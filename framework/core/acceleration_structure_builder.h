@@ -0,0 +1,163 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "common/helpers.h"
+#include "common/vk_common.h"
+#include "core/acceleration_structure.h"
+#include "core/query_pool.h"
+
+namespace vkb
+{
+namespace core
+{
+/**
+ * @brief Builds batches of acceleration structures with a single build command per level
+ *
+ * Requests added to the builder are built together on the next call to build or record. The bottom level acceleration structures
+ * of a batch are built by one vkCmdBuildAccelerationStructuresKHR, followed by the top level ones, each build using its
+ * own range of a scratch buffer which is shared by the batch and kept for the next batches.
+ *
+ * Acceleration structures built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR, and without
+ * VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR, are compacted once built: their compacted size is queried,
+ * and they are replaced by a compacted copy. As this changes their device address, top level acceleration structures
+ * must be built in a later batch than the bottom level ones they instance, if those are compacted.
+ */
+class AccelerationStructureBuilder
+{
+  public:
+	/**
+	 * @brief Memory used by the acceleration structures built since the builder was created
+	 */
+	struct Statistics
+	{
+		uint32_t     build_count{0};            // Acceleration structures fully built
+		uint32_t     refit_count{0};            // Acceleration structures updated from their previous build
+		uint32_t     compaction_count{0};       // Acceleration structures replaced by a compacted copy
+		VkDeviceSize scratch_size{0};           // Size of the scratch buffer shared by the batches
+		VkDeviceSize original_size{0};          // Size of the compacted acceleration structures, before compaction
+		VkDeviceSize compacted_size{0};         // Size of the compacted acceleration structures, after compaction
+
+		VkDeviceSize get_saved_size() const
+		{
+			return original_size - compacted_size;
+		}
+	};
+
+	AccelerationStructureBuilder(vkb::core::DeviceC &device);
+
+	AccelerationStructureBuilder(const AccelerationStructureBuilder &) = delete;
+
+	AccelerationStructureBuilder(AccelerationStructureBuilder &&) = delete;
+
+	~AccelerationStructureBuilder() = default;
+
+	AccelerationStructureBuilder &operator=(const AccelerationStructureBuilder &) = delete;
+
+	AccelerationStructureBuilder &operator=(AccelerationStructureBuilder &&) = delete;
+
+	/**
+	 * @brief Requests a full build of an acceleration structure in the next batch
+	 * @param acceleration_structure Acceleration structure with its geometries added, must outlive the batch
+	 * @param flags Build flags
+	 */
+	void add_build(AccelerationStructure                &acceleration_structure,
+	               VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR);
+
+	/**
+	 * @brief Requests an update of an acceleration structure whose geometries changed in the next batch
+	 *        The acceleration structure is refit if it was built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR
+	 *        and was refit less than max_refits times since, otherwise it is rebuilt, as refits degrade its quality
+	 * @param acceleration_structure Acceleration structure with its geometries updated, must outlive the batch
+	 * @param flags Build flags, which must match the flags of the previous build for a refit
+	 */
+	void add_update(AccelerationStructure                &acceleration_structure,
+	                VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR);
+
+	/**
+	 * @brief Builds the requested acceleration structures on the device and waits for the builds to complete
+	 * @param queue Queue to use for the build process
+	 */
+	void build(VkQueue queue);
+
+	/**
+	 * @brief Records the builds of the requested acceleration structures into a command buffer, without submitting it
+	 *        The batches recorded for earlier frames must have completed before the scratch buffer grows, and the
+	 *        requests must not ask for compaction, which needs the builds to have completed
+	 * @param command_buffer Command buffer in the recording state
+	 */
+	void record(VkCommandBuffer command_buffer);
+
+	/**
+	 * @brief Sets the number of consecutive refits of an acceleration structure after which an update rebuilds it
+	 *        Zero rebuilds on every update
+	 */
+	void set_max_refits(uint32_t max_refits);
+
+	const Statistics &get_statistics() const;
+
+  private:
+	struct Request
+	{
+		AccelerationStructure               *acceleration_structure;
+		VkBuildAccelerationStructureFlagsKHR flags;
+		VkBuildAccelerationStructureModeKHR  mode;
+		VkDeviceSize                         scratch_offset;
+	};
+
+	/**
+	 * @brief Prepares the requests of a batch and their ranges of the scratch buffer, and sorts them by level
+	 */
+	void prepare_batch(std::vector<Request *> &bottom_level_requests,
+	                   std::vector<Request *> &top_level_requests,
+	                   std::vector<Request *> &compacted_requests);
+
+	/**
+	 * @brief Makes the scratch buffer large enough for a batch, without keeping its previous content
+	 */
+	void reserve_scratch(VkDeviceSize size);
+
+	/**
+	 * @brief Records a single build command for the requests of one level
+	 */
+	void record_builds(VkCommandBuffer command_buffer, const std::vector<Request *> &level_requests);
+
+	/**
+	 * @brief Replaces the compactable acceleration structures of the batch by compacted copies
+	 */
+	void compact(VkQueue queue, const std::vector<Request *> &compacted_requests);
+
+	vkb::core::DeviceC &device;
+
+	std::vector<Request> requests;
+
+	VkDeviceSize scratch_alignment{0};
+
+	std::unique_ptr<vkb::core::BufferC> scratch_buffer;
+
+	// Compacted size queries of the batch, grown to the number of compacted acceleration structures
+	std::unique_ptr<vkb::QueryPool> query_pool;
+
+	uint32_t query_count{0};
+
+	uint32_t max_refits{16};
+
+	Statistics statistics;
+};
+}        // namespace core
+}        // namespace vkb
@@ -19,6 +19,9 @@
 #include "allocated.h"
 #include "common/error.h"
 
+#include <array>
+#include <atomic>
+
 namespace vkb
 {
 
@@ -57,5 +60,75 @@ void shutdown()
 	}
 }
 
+namespace
+{
+std::array<std::atomic<vk::DeviceSize>, static_cast<size_t>(MemoryCategory::Count)> &get_memory_usages()
+{
+	static std::array<std::atomic<vk::DeviceSize>, static_cast<size_t>(MemoryCategory::Count)> memory_usages{};
+	return memory_usages;
+}
+
+bool is_host_accessible(VmaAllocationCreateInfo const &allocation_create_info)
+{
+	constexpr VmaAllocationCreateFlags host_access_flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+
+	switch (allocation_create_info.usage)
+	{
+		case VMA_MEMORY_USAGE_CPU_ONLY:
+		case VMA_MEMORY_USAGE_CPU_TO_GPU:
+		case VMA_MEMORY_USAGE_GPU_TO_CPU:
+		case VMA_MEMORY_USAGE_CPU_COPY:
+			return true;
+		default:
+			return (allocation_create_info.flags & host_access_flags) ||
+			       (allocation_create_info.requiredFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+	}
+}
+}        // namespace
+
+MemoryCategory get_memory_category(vk::BufferCreateInfo const &create_info, VmaAllocationCreateInfo const &allocation_create_info)
+{
+	if (create_info.usage & (vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer))
+	{
+		return MemoryCategory::Meshes;
+	}
+	if (is_host_accessible(allocation_create_info))
+	{
+		return MemoryCategory::Transient;
+	}
+	return MemoryCategory::Other;
+}
+
+MemoryCategory get_memory_category(vk::ImageCreateInfo const &create_info, VmaAllocationCreateInfo const &allocation_create_info)
+{
+	if (create_info.usage & vk::ImageUsageFlagBits::eTransientAttachment)
+	{
+		return MemoryCategory::Transient;
+	}
+	if (create_info.usage & (vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eInputAttachment))
+	{
+		return MemoryCategory::RenderTargets;
+	}
+	return MemoryCategory::Textures;
+}
+
+vk::DeviceSize get_memory_usage(MemoryCategory category)
+{
+	assert(category < MemoryCategory::Count);
+	return get_memory_usages()[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+}
+
+void add_memory_usage(MemoryCategory category, vk::DeviceSize size)
+{
+	assert(category < MemoryCategory::Count);
+	get_memory_usages()[static_cast<size_t>(category)].fetch_add(size, std::memory_order_relaxed);
+}
+
+void remove_memory_usage(MemoryCategory category, vk::DeviceSize size)
+{
+	assert(category < MemoryCategory::Count);
+	get_memory_usages()[static_cast<size_t>(category)].fetch_sub(size, std::memory_order_relaxed);
+}
+
 }        // namespace allocated
 }        // namespace vkb
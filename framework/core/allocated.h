@@ -104,6 +104,37 @@ void init(const DeviceType &device)
  */
 void shutdown();
 
+/**
+ * @brief Category of the memory of a buffer or an image, inferred from its create info when it is created.
+ */
+enum class MemoryCategory
+{
+	Textures,             // Images which are not attachments
+	Meshes,               // Vertex and index buffers
+	RenderTargets,        // Color, depth stencil and input attachments
+	Transient,            // Transient attachments and host accessible buffers, such as staging and per-frame buffers
+	Other,
+	Count
+};
+
+MemoryCategory get_memory_category(vk::BufferCreateInfo const &create_info, VmaAllocationCreateInfo const &allocation_create_info);
+
+MemoryCategory get_memory_category(vk::ImageCreateInfo const &create_info, VmaAllocationCreateInfo const &allocation_create_info);
+
+/**
+ * @brief Retrieves the memory currently allocated by the buffers and images of a category.
+ * @param category The memory category.
+ * @return The size of the allocations in bytes.
+ */
+vk::DeviceSize get_memory_usage(MemoryCategory category);
+
+/**
+ * @brief Accounts for an allocation made or released by an `Allocated` object.  Thread safe.
+ */
+void add_memory_usage(MemoryCategory category, vk::DeviceSize size);
+
+void remove_memory_usage(MemoryCategory category, vk::DeviceSize size);
+
 /**
  * @brief The `Allocated` class serves as a base class for wrappers around Vulkan that require memory allocation
  * (`VkImage` and `VkBuffer`).  This class mostly ensures proper behavior for a RAII pattern, preventing double-release by
@@ -170,6 +201,15 @@ class Allocated : public vkb::core::VulkanResource<bindingType, HandleType>
 	 */
 	void flush(DeviceSizeType offset = 0, DeviceSizeType size = VK_WHOLE_SIZE);
 
+	/**
+	 * @brief Invalidates memory if it is NOT `HOST_COHERENT`, so that device writes become visible to the host.
+	 * This is a no-op for `HOST_COHERENT` memory.
+	 *
+	 * @param offset The offset into the memory to invalidate.  Defaults to 0.
+	 * @param size The size of the memory to invalidate.  Defaults to the entire block of memory.
+	 */
+	void invalidate(DeviceSizeType offset = 0, DeviceSizeType size = VK_WHOLE_SIZE);
+
 	/**
 	 * @brief Retrieves a pointer to the host visible memory as an unsigned byte array.
 	 * @return The pointer to the host visible memory.
@@ -315,6 +355,23 @@ class Allocated : public vkb::core::VulkanResource<bindingType, HandleType>
 	 * instead of `protected`, and because it (mostly) isolates interaction with the VMA to a single class
 	 */
 	[[nodiscard]] ImageType create_image(ImageCreateInfoType const &create_info);
+	/**
+	 * @brief Internal method to create an image in memory which other images can alias, see `create_aliasing_image`.
+	 * Should only be called from the `Image` derived class.
+	 *
+	 * @param create_info The create info of the image.
+	 * @param memory_requirements The requirements of the memory to allocate, which must cover the ones of this image and
+	 * of all the images aliasing it.
+	 */
+	[[nodiscard]] ImageType create_image(ImageCreateInfoType const &create_info, vk::MemoryRequirements const &memory_requirements);
+	/**
+	 * @brief Internal method to create an image bound to the memory of another image, without allocating memory.
+	 * Should only be called from the `Image` derived class.
+	 *
+	 * The memory stays owned by `memory_owner`: the image must not be used once its owner is destroyed, and the images
+	 * sharing the memory must not be used at the same time.  The memory is accounted for by its owner only.
+	 */
+	[[nodiscard]] ImageType create_aliasing_image(ImageCreateInfoType const &create_info, Allocated const &memory_owner);
 
 	/**
 	 * @brief Internal method to retrieve the VMA allocation owned by this object.
@@ -365,9 +422,14 @@ class Allocated : public vkb::core::VulkanResource<bindingType, HandleType>
   private:
 	vk::Buffer create_buffer_impl(vk::BufferCreateInfo const &create_info, DeviceSizeType alignment);
 	vk::Image  create_image_impl(vk::ImageCreateInfo const &create_info);
+	vk::Image  create_image_impl(vk::ImageCreateInfo const &create_info, vk::MemoryRequirements const &memory_requirements);
+	vk::Image  create_aliasing_image_impl(vk::ImageCreateInfo const &create_info, VmaAllocation memory);
+	void       account_memory_usage(vk::ImageCreateInfo const &create_info, vk::DeviceSize size);
 
 	VmaAllocationCreateInfo allocation_create_info = {};
 	VmaAllocation           allocation             = VK_NULL_HANDLE;
+	MemoryCategory          memory_category        = MemoryCategory::Other;
+	vk::DeviceSize          allocation_size        = 0;        /// Size of the allocation accounted for in its memory category
 	/**
 	 * @brief A pointer to the allocation memory, if the memory is HOST_VISIBLE and is currently (or persistently) mapped.
 	 * Contains null otherwise.
@@ -388,6 +450,11 @@ class Allocated : public vkb::core::VulkanResource<bindingType, HandleType>
 	 * allocation information from the VMA, since this property won't change for the lifetime of the allocation.
 	 */
 	bool persistent = false;
+	/**
+	 * @brief This flag is set to true if the image is bound to the memory of another image, in which case `allocation` is null
+	 * and destroying the image does not release any memory.
+	 */
+	bool aliasing = false;
 };
 
 template <vkb::BindingType bindingType, typename HandleType>
@@ -395,9 +462,12 @@ inline Allocated<bindingType, HandleType>::Allocated(Allocated &&other) noexcept
     ParentType{static_cast<ParentType &&>(other)},
     allocation_create_info(std::exchange(other.allocation_create_info, {})),
     allocation(std::exchange(other.allocation, {})),
+    memory_category(std::exchange(other.memory_category, {})),
+    allocation_size(std::exchange(other.allocation_size, {})),
     mapped_data(std::exchange(other.mapped_data, {})),
     coherent(std::exchange(other.coherent, {})),
-    persistent(std::exchange(other.persistent, {}))
+    persistent(std::exchange(other.persistent, {})),
+    aliasing(std::exchange(other.aliasing, {}))
 {
 }
 
@@ -425,6 +495,8 @@ inline void Allocated<bindingType, HandleType>::clear()
 	mapped_data            = nullptr;
 	persistent             = false;
 	allocation_create_info = {};
+	allocation_size        = 0;
+	aliasing               = false;
 }
 
 template <vkb::BindingType bindingType, typename HandleType>
@@ -474,6 +546,10 @@ inline vk::Buffer Allocated<bindingType, HandleType>::create_buffer_impl(vk::Buf
 		throw VulkanException{result, "Cannot create Buffer"};
 	}
 	post_create(allocation_info);
+
+	memory_category = get_memory_category(create_info, allocation_create_info);
+	allocation_size = allocation_info.size;
+	add_memory_usage(memory_category, allocation_size);
 	return buffer;
 }
 
@@ -500,19 +576,19 @@ inline vk::Image Allocated<bindingType, HandleType>::create_image_impl(vk::Image
 	vk::Image         image = VK_NULL_HANDLE;
 	VmaAllocationInfo allocation_info{};
 
-#if 0
-	// If the image is an attachment, prefer dedicated memory
+	// If the image is an attachment, prefer dedicated memory. Images aliasing a memory block are created through
+	// the overload taking memory requirements instead, as a dedicated allocation cannot be shared.
 	constexpr vk::ImageUsageFlags attachment_only_flags = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eTransientAttachment;
 	if (create_info.usage & attachment_only_flags)
 	{
 		allocation_create_info.flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
 	}
 
+	// Transient attachments only live within a render pass, so on tile based GPUs they may never need backing memory
 	if (create_info.usage & vk::ImageUsageFlagBits::eTransientAttachment)
 	{
 		allocation_create_info.preferredFlags |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
 	}
-#endif
 
 	VkResult result = vmaCreateImage(get_memory_allocator(),
 	                                 reinterpret_cast<VkImageCreateInfo const *>(&create_info),
@@ -527,9 +603,107 @@ inline vk::Image Allocated<bindingType, HandleType>::create_image_impl(vk::Image
 	}
 
 	post_create(allocation_info);
+
+	account_memory_usage(create_info, allocation_info.size);
+	return image;
+}
+
+template <vkb::BindingType bindingType, typename HandleType>
+inline typename Allocated<bindingType, HandleType>::ImageType
+    Allocated<bindingType, HandleType>::create_image(ImageCreateInfoType const &create_info, vk::MemoryRequirements const &memory_requirements)
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return create_image_impl(create_info, memory_requirements);
+	}
+	else
+	{
+		return static_cast<VkImage>(create_image_impl(reinterpret_cast<vk::ImageCreateInfo const &>(create_info), memory_requirements));
+	}
+}
+
+template <vkb::BindingType bindingType, typename HandleType>
+inline vk::Image Allocated<bindingType, HandleType>::create_image_impl(vk::ImageCreateInfo const &create_info, vk::MemoryRequirements const &memory_requirements)
+{
+	VmaAllocationInfo allocation_info{};
+
+	VkResult result = vmaAllocateMemory(get_memory_allocator(),
+	                                    reinterpret_cast<VkMemoryRequirements const *>(&memory_requirements),
+	                                    &allocation_create_info,
+	                                    &allocation,
+	                                    &allocation_info);
+	if (result != VK_SUCCESS)
+	{
+		throw VulkanException{result, "Cannot allocate Image memory"};
+	}
+
+	vk::Image image;
+	try
+	{
+		image = create_aliasing_image_impl(create_info, allocation);
+	}
+	catch (...)
+	{
+		vmaFreeMemory(get_memory_allocator(), std::exchange(allocation, {}));
+		throw;
+	}
+
+	post_create(allocation_info);
+
+	account_memory_usage(create_info, allocation_info.size);
 	return image;
 }
 
+template <vkb::BindingType bindingType, typename HandleType>
+inline typename Allocated<bindingType, HandleType>::ImageType
+    Allocated<bindingType, HandleType>::create_aliasing_image(ImageCreateInfoType const &create_info, Allocated const &memory_owner)
+{
+	assert(memory_owner.allocation != VK_NULL_HANDLE && "Images can only alias memory owned by another image");
+
+	vk::ImageCreateInfo const &image_create_info = reinterpret_cast<vk::ImageCreateInfo const &>(create_info);
+
+	vk::Image image = create_aliasing_image_impl(image_create_info, memory_owner.allocation);
+	aliasing        = true;
+	account_memory_usage(image_create_info, 0);
+
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return image;
+	}
+	else
+	{
+		return static_cast<VkImage>(image);
+	}
+}
+
+template <vkb::BindingType bindingType, typename HandleType>
+inline vk::Image Allocated<bindingType, HandleType>::create_aliasing_image_impl(vk::ImageCreateInfo const &create_info, VmaAllocation memory)
+{
+	assert(0 < create_info.mipLevels && "Images should have at least one level");
+	assert(0 < create_info.arrayLayers && "Images should have at least one layer");
+	assert(create_info.usage && "Images should have at least one usage type");
+
+	vk::Image image  = VK_NULL_HANDLE;
+	VkResult  result = vmaCreateAliasingImage(get_memory_allocator(),
+	                                          memory,
+	                                          reinterpret_cast<VkImageCreateInfo const *>(&create_info),
+	                                          reinterpret_cast<VkImage *>(&image));
+
+	if (result != VK_SUCCESS)
+	{
+		throw VulkanException{result, "Cannot create aliasing Image"};
+	}
+	return image;
+}
+
+template <vkb::BindingType bindingType, typename HandleType>
+inline void Allocated<bindingType, HandleType>::account_memory_usage(vk::ImageCreateInfo const &create_info, vk::DeviceSize size)
+{
+	memory_category = get_memory_category(create_info, allocation_create_info);
+	allocation_size = size;
+	add_memory_usage(memory_category, allocation_size);
+}
+
 template <vkb::BindingType bindingType, typename HandleType>
 inline void Allocated<bindingType, HandleType>::destroy_buffer(BufferType handle)
 {
@@ -544,6 +718,7 @@ inline void Allocated<bindingType, HandleType>::destroy_buffer(BufferType handle
 		{
 			vmaDestroyBuffer(get_memory_allocator(), handle, allocation);
 		}
+		remove_memory_usage(memory_category, allocation_size);
 		clear();
 	}
 }
@@ -551,7 +726,8 @@ inline void Allocated<bindingType, HandleType>::destroy_buffer(BufferType handle
 template <vkb::BindingType bindingType, typename HandleType>
 inline void Allocated<bindingType, HandleType>::destroy_image(ImageType image)
 {
-	if (image != VK_NULL_HANDLE && allocation != VK_NULL_HANDLE)
+	// Aliasing images have no allocation, vmaDestroyImage then only destroys the image
+	if (image != VK_NULL_HANDLE && (allocation != VK_NULL_HANDLE || aliasing))
 	{
 		unmap();
 		if constexpr (bindingType == vkb::BindingType::Cpp)
@@ -562,6 +738,7 @@ inline void Allocated<bindingType, HandleType>::destroy_image(ImageType image)
 		{
 			vmaDestroyImage(get_memory_allocator(), image, allocation);
 		}
+		remove_memory_usage(memory_category, allocation_size);
 		clear();
 	}
 }
@@ -582,6 +759,22 @@ inline void Allocated<bindingType, HandleType>::flush(DeviceSizeType offset, Dev
 	}
 }
 
+template <vkb::BindingType bindingType, typename HandleType>
+inline void Allocated<bindingType, HandleType>::invalidate(DeviceSizeType offset, DeviceSizeType size)
+{
+	if (!coherent)
+	{
+		if constexpr (bindingType == vkb::BindingType::Cpp)
+		{
+			vmaInvalidateAllocation(get_memory_allocator(), allocation, static_cast<VkDeviceSize>(offset), static_cast<VkDeviceSize>(size));
+		}
+		else
+		{
+			vmaInvalidateAllocation(get_memory_allocator(), allocation, offset, size);
+		}
+	}
+}
+
 template <vkb::BindingType bindingType, typename HandleType>
 inline const uint8_t *Allocated<bindingType, HandleType>::get_data() const
 {
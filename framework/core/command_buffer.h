@@ -19,6 +19,7 @@
 #pragma once
 
 #include "common/hpp_vk_common.h"
+#include "core/command_pool_base.h"
 #include "core/device.h"
 #include "core/hpp_descriptor_set_layout.h"
 #include "core/hpp_framebuffer.h"
@@ -153,7 +154,7 @@ class CommandBuffer
 	void                   end_query(QueryPoolType const &query_pool, uint32_t query);
 	void                   end_render_pass();
 	void                   execute_commands(vkb::core::CommandBuffer<bindingType> &secondary_command_buffer);
-	void                   execute_commands(std::vector<std::shared_ptr<vkb::core::CommandBuffer<bindingType>>> &secondary_command_buffers);
+	void                   execute_commands(std::vector<vkb::core::CommandBufferHandle<bindingType>> &secondary_command_buffers);
 	CommandBufferLevelType get_level() const;
 	RenderPassType        &get_render_pass(vkb::rendering::RenderTarget<bindingType> const                          &render_target,
 	                                       std::vector<LoadStoreInfoType> const                                     &load_store_infos,
@@ -217,6 +218,8 @@ class CommandBuffer
 	bool is_render_size_optimal(const vk::Extent2D &extent, const vk::Rect2D &render_area);
 
   private:
+	vk::DeviceSize            align_descriptor_heap_size(vk::DeviceSize size) const;
+	vkb::BufferAllocationCpp  allocate_descriptor_heap(uint32_t descriptor_sets);
 	void                      begin_impl(vk::CommandBufferUsageFlags flags, vkb::core::CommandBuffer<bindingType> *primary_cmd_buf);
 	void                      begin_impl(vk::CommandBufferUsageFlags      flags,
 	                                     vkb::core::HPPRenderPass const  *render_pass,
@@ -235,7 +238,7 @@ class CommandBuffer
 	                                                     vk::DeviceSize                             size,
 	                                                     vkb::common::HPPBufferMemoryBarrier const &memory_barrier);
 	void                      copy_buffer_impl(vkb::core::BufferCpp const &src_buffer, vkb::core::BufferCpp const &dst_buffer, vk::DeviceSize size);
-	void                      execute_commands_impl(std::vector<std::shared_ptr<vkb::core::CommandBuffer<vkb::BindingType::Cpp>>> &secondary_command_buffers);
+	void                      execute_commands_impl(std::vector<vkb::core::CommandBufferHandleCpp> &secondary_command_buffers);
 	void                      flush_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point);
 	void                      flush_descriptor_state_impl(vk::PipelineBindPoint pipeline_bind_point);
 	void                      flush_pipeline_state_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point);
@@ -244,13 +247,19 @@ class CommandBuffer
 	                                               std::vector<vkb::common::HPPLoadStoreInfo> const               &load_store_infos,
 	                                               std::vector<std::unique_ptr<vkb::rendering::SubpassCpp>> const &subpasses);
 	void                      image_memory_barrier_impl(vkb::core::HPPImageView const &image_view, vkb::common::HPPImageMemoryBarrier const &memory_barrier) const;
+	void                      push_descriptor_set(vk::PipelineBindPoint                    pipeline_bind_point,
+	                                              uint32_t                                 descriptor_set_id,
+	                                              vkb::core::HPPDescriptorSetLayout const &descriptor_set_layout);
 	vk::Result                reset_impl(vkb::CommandBufferResetMode reset_mode);
+	void                      write_descriptor_buffer(vkb::core::HPPDescriptorSetLayout const &descriptor_set_layout,
+	                                                  vkb::BufferAllocationCpp                &descriptor_heap_allocation,
+	                                                  vk::DeviceSize                           offset);
 
   private:
 	vkb::core::CommandPoolCpp                                              &command_pool;
 	vkb::core::HPPFramebuffer const                                        *current_framebuffer = nullptr;
 	vkb::core::HPPRenderPass const                                         *current_render_pass = nullptr;
-	std::unordered_map<uint32_t, vkb::core::HPPDescriptorSetLayout const *> descriptor_set_layout_binding_state;
+	std::vector<vkb::core::HPPDescriptorSetLayout const *>                  descriptor_set_layout_binding_state;        // Indexed by set number
 	vk::Extent2D                                                            last_framebuffer_extent = {};
 	vk::Extent2D                                                            last_render_area_extent = {};
 	const vk::CommandBufferLevel                                            level                   = {};
@@ -259,6 +268,15 @@ class CommandBuffer
 	vkb::HPPResourceBindingState                                            resource_binding_state  = {};
 	std::vector<uint8_t>                                                    stored_push_constants   = {};
 
+	// Scratch storage of flush_descriptor_state_impl, kept between draws
+	BindingTable<vk::DescriptorBufferInfo> descriptor_buffer_infos;
+	BindingTable<vk::DescriptorImageInfo>  descriptor_image_infos;
+	std::vector<uint32_t>                  dynamic_offsets;
+	std::vector<vk::WriteDescriptorSet>    descriptor_writes;
+
+	// Descriptor heap bound with vkCmdBindDescriptorBuffersEXT, the sets of descriptor buffer layouts are written to it
+	vkb::core::BufferCpp const *bound_descriptor_heap = nullptr;
+
 	// If true, it becomes the responsibility of the caller to update ANY descriptor bindings
 	// that contain update after bind, as they wont be implicitly updated
 	bool update_after_bind = false;
@@ -356,6 +374,7 @@ inline void CommandBuffer<bindingType>::begin_impl(vk::CommandBufferUsageFlags
 	resource_binding_state.reset();
 	descriptor_set_layout_binding_state.clear();
 	stored_push_constants.clear();
+	bound_descriptor_heap = nullptr;
 
 	vk::CommandBufferBeginInfo       begin_info{.flags = flags};
 	vk::CommandBufferInheritanceInfo inheritance;
@@ -835,7 +854,7 @@ inline void CommandBuffer<bindingType>::execute_commands(vkb::core::CommandBuffe
 }
 
 template <vkb::BindingType bindingType>
-inline void CommandBuffer<bindingType>::execute_commands(std::vector<std::shared_ptr<vkb::core::CommandBuffer<bindingType>>> &secondary_command_buffers)
+inline void CommandBuffer<bindingType>::execute_commands(std::vector<vkb::core::CommandBufferHandle<bindingType>> &secondary_command_buffers)
 {
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
@@ -843,12 +862,12 @@ inline void CommandBuffer<bindingType>::execute_commands(std::vector<std::shared
 	}
 	else
 	{
-		execute_commands_impl(reinterpret_cast<std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> &>(secondary_command_buffers));
+		execute_commands_impl(reinterpret_cast<std::vector<vkb::core::CommandBufferHandleCpp> &>(secondary_command_buffers));
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline void CommandBuffer<bindingType>::execute_commands_impl(std::vector<std::shared_ptr<vkb::core::CommandBuffer<vkb::BindingType::Cpp>>> &secondary_command_buffers)
+inline void CommandBuffer<bindingType>::execute_commands_impl(std::vector<vkb::core::CommandBufferHandleCpp> &secondary_command_buffers)
 {
 	std::vector<vk::CommandBuffer> sec_cmd_buf_handles(secondary_command_buffers.size(), nullptr);
 	std::transform(secondary_command_buffers.begin(),
@@ -1294,149 +1313,326 @@ inline void CommandBuffer<bindingType>::flush_descriptor_state_impl(vk::Pipeline
 
 	const auto &pipeline_layout = pipeline_state.get_pipeline_layout();
 
-	std::unordered_set<uint32_t> update_descriptor_sets;
+	// Bit mask of the descriptor sets to update, as sets are numbered from zero and are few
+	uint32_t update_descriptor_sets = 0;
 
 	// Iterate over the shader sets to check if they have already been bound
 	// If they have, add the set so that the command buffer later updates it
 	for (auto &set_it : pipeline_layout.get_shader_sets())
 	{
 		uint32_t descriptor_set_id = set_it.first;
+		assert(descriptor_set_id < 32 && "Descriptor set numbers are expected to fit in a bit mask");
 
-		auto descriptor_set_layout_it = descriptor_set_layout_binding_state.find(descriptor_set_id);
-
-		if (descriptor_set_layout_it != descriptor_set_layout_binding_state.end())
+		if (descriptor_set_id < descriptor_set_layout_binding_state.size() && descriptor_set_layout_binding_state[descriptor_set_id])
 		{
-			if (descriptor_set_layout_it->second->get_handle() != pipeline_layout.get_descriptor_set_layout(descriptor_set_id).get_handle())
+			if (descriptor_set_layout_binding_state[descriptor_set_id]->get_handle() != pipeline_layout.get_descriptor_set_layout(descriptor_set_id).get_handle())
 			{
-				update_descriptor_sets.emplace(descriptor_set_id);
+				update_descriptor_sets |= 1U << descriptor_set_id;
 			}
 		}
 	}
 
 	// Validate that the bound descriptor set layouts exist in the pipeline layout
-	for (auto set_it = descriptor_set_layout_binding_state.begin(); set_it != descriptor_set_layout_binding_state.end();)
+	for (uint32_t descriptor_set_id = 0; descriptor_set_id < descriptor_set_layout_binding_state.size(); ++descriptor_set_id)
 	{
-		if (!pipeline_layout.has_descriptor_set_layout(set_it->first))
-		{
-			set_it = descriptor_set_layout_binding_state.erase(set_it);
-		}
-		else
+		if (descriptor_set_layout_binding_state[descriptor_set_id] && !pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
 		{
-			++set_it;
+			descriptor_set_layout_binding_state[descriptor_set_id] = nullptr;
 		}
 	}
 
 	// Check if a descriptor set needs to be created
-	if (resource_binding_state.is_dirty() || !update_descriptor_sets.empty())
+	if (!resource_binding_state.is_dirty() && !update_descriptor_sets)
 	{
-		resource_binding_state.clear_dirty();
+		return;
+	}
+
+	resource_binding_state.clear_dirty();
 
-		// Iterate over all of the resource sets bound by the command buffer
-		for (auto &resource_set_it : resource_binding_state.get_resource_sets())
+	// Collect the resource sets bound by the command buffer which have to be written
+	auto     resource_sets         = resource_binding_state.get_resource_sets();
+	uint32_t write_descriptor_sets = 0;
+	for (uint32_t descriptor_set_id = 0; descriptor_set_id < resource_sets.size(); ++descriptor_set_id)
+	{
+		auto const &resource_set = resource_sets[descriptor_set_id];
+
+		// Don't update resource set if it's empty, not in the update list OR its state hasn't changed
+		if (resource_set.is_empty() || (!resource_set.is_dirty() && !(update_descriptor_sets & (1U << descriptor_set_id))))
 		{
-			uint32_t descriptor_set_id = resource_set_it.first;
-			auto    &resource_set      = resource_set_it.second;
+			continue;
+		}
 
-			// Don't update resource set if it's not in the update list OR its state hasn't changed
-			if (!resource_set.is_dirty() && (update_descriptor_sets.find(descriptor_set_id) == update_descriptor_sets.end()))
+		// Clear dirty flag for resource set
+		resource_binding_state.clear_dirty(descriptor_set_id);
+
+		// Skip resource set if a descriptor set layout doesn't exist for it
+		if (pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
+		{
+			write_descriptor_sets |= 1U << descriptor_set_id;
+		}
+	}
+
+	// The sets of a descriptor buffer layout are written one after the other into the descriptor heap of the frame
+	vkb::BufferAllocationCpp descriptor_heap_allocation;
+	vk::DeviceSize           descriptor_heap_offset = 0;
+	if (pipeline_layout.get_descriptor_backend() == vkb::DescriptorBackend::DescriptorBuffer && write_descriptor_sets)
+	{
+		descriptor_heap_allocation = allocate_descriptor_heap(write_descriptor_sets);
+		while (&descriptor_heap_allocation.get_buffer() != bound_descriptor_heap)
+		{
+			bound_descriptor_heap = &descriptor_heap_allocation.get_buffer();
+
+			vk::DescriptorBufferBindingInfoEXT binding_info{.address = bound_descriptor_heap->get_device_address(),
+			                                                .usage   = vk::BufferUsageFlagBits::eResourceDescriptorBufferEXT |
+			                                                         vk::BufferUsageFlagBits::eSamplerDescriptorBufferEXT};
+			this->get_resource().bindDescriptorBuffersEXT(binding_info);
+
+			// Binding another heap invalidates the sets written to the previous one, so all of them are written again
+			for (uint32_t descriptor_set_id = 0; descriptor_set_id < resource_sets.size(); ++descriptor_set_id)
 			{
-				continue;
+				if (!resource_sets[descriptor_set_id].is_empty() && pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
+				{
+					write_descriptor_sets |= 1U << descriptor_set_id;
+				}
 			}
+			descriptor_heap_allocation = allocate_descriptor_heap(write_descriptor_sets);
+		}
+	}
+
+	for (uint32_t descriptor_set_id = 0; write_descriptor_sets >> descriptor_set_id; ++descriptor_set_id)
+	{
+		if (!(write_descriptor_sets & (1U << descriptor_set_id)))
+		{
+			continue;
+		}
+
+		auto const &resource_set          = resource_sets[descriptor_set_id];
+		auto       &descriptor_set_layout = pipeline_layout.get_descriptor_set_layout(descriptor_set_id);
+
+		// Make descriptor set layout bound for current set
+		if (descriptor_set_id >= descriptor_set_layout_binding_state.size())
+		{
+			descriptor_set_layout_binding_state.resize(descriptor_set_id + 1, nullptr);
+		}
+		descriptor_set_layout_binding_state[descriptor_set_id] = &descriptor_set_layout;
 
-			// Clear dirty flag for resource set
-			resource_binding_state.clear_dirty(descriptor_set_id);
+		// The infos are written into tables kept by the command buffer, so that flushing does not allocate
+		descriptor_buffer_infos.clear();
+		descriptor_image_infos.clear();
+		dynamic_offsets.clear();
 
-			// Skip resource set if a descriptor set layout doesn't exist for it
-			if (!pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
+		// Iterate over all resource bindings, sorted by binding then array element
+		auto resource_bindings = resource_set.get_resource_bindings().get_entries();
+		for (auto const &resource_binding : resource_bindings)
+		{
+			auto  binding_index = resource_binding.binding;
+			auto  array_element = resource_binding.array_element;
+			auto &resource_info = resource_binding.value;
+
+			// Check if binding exists in the pipeline layout
+			auto binding_info = descriptor_set_layout.find_layout_binding(binding_index);
+			if (!binding_info)
 			{
 				continue;
 			}
 
-			auto &descriptor_set_layout = pipeline_layout.get_descriptor_set_layout(descriptor_set_id);
+			// Pointer references
+			auto &buffer     = resource_info.buffer;
+			auto &sampler    = resource_info.sampler;
+			auto &image_view = resource_info.image_view;
 
-			// Make descriptor set layout bound for current set
-			descriptor_set_layout_binding_state[descriptor_set_id] = &descriptor_set_layout;
+			// Get buffer info
+			if (buffer != nullptr && vkb::common::is_buffer_descriptor_type(binding_info->descriptorType))
+			{
+				vk::DescriptorBufferInfo buffer_info{resource_info.buffer->get_handle(), resource_info.offset, resource_info.range};
 
-			BindingMap<vk::DescriptorBufferInfo> buffer_infos;
-			BindingMap<vk::DescriptorImageInfo>  image_infos;
+				if (vkb::common::is_dynamic_buffer_descriptor_type(binding_info->descriptorType))
+				{
+					dynamic_offsets.push_back(to_u32(buffer_info.offset));
+					buffer_info.offset = 0;
+				}
 
-			std::vector<uint32_t> dynamic_offsets;
+				descriptor_buffer_infos.set(binding_index, array_element, buffer_info);
+			}
 
-			// Iterate over all resource bindings
-			for (auto &binding_it : resource_set.get_resource_bindings())
+			// Get image info
+			else if (image_view != nullptr || sampler != nullptr)
 			{
-				auto  binding_index     = binding_it.first;
-				auto &binding_resources = binding_it.second;
+				// Can be null for input attachments
+				vk::DescriptorImageInfo image_info{sampler ? sampler->get_handle() : nullptr, image_view->get_handle()};
 
-				// Check if binding exists in the pipeline layout
-				if (auto binding_info = descriptor_set_layout.get_layout_binding(binding_index))
+				if (image_view != nullptr)
 				{
-					// Iterate over all binding resources
-					for (auto &element_it : binding_resources)
+					// Add image layout info based on descriptor type
+					switch (binding_info->descriptorType)
 					{
-						auto  array_element = element_it.first;
-						auto &resource_info = element_it.second;
-
-						// Pointer references
-						auto &buffer     = resource_info.buffer;
-						auto &sampler    = resource_info.sampler;
-						auto &image_view = resource_info.image_view;
-
-						// Get buffer info
-						if (buffer != nullptr && vkb::common::is_buffer_descriptor_type(binding_info->descriptorType))
-						{
-							vk::DescriptorBufferInfo buffer_info{resource_info.buffer->get_handle(), resource_info.offset, resource_info.range};
-
-							if (vkb::common::is_dynamic_buffer_descriptor_type(binding_info->descriptorType))
-							{
-								dynamic_offsets.push_back(to_u32(buffer_info.offset));
-								buffer_info.offset = 0;
-							}
-
-							buffer_infos[binding_index][array_element] = buffer_info;
-						}
-
-						// Get image info
-						else if (image_view != nullptr || sampler != nullptr)
-						{
-							// Can be null for input attachments
-							vk::DescriptorImageInfo image_info{sampler ? sampler->get_handle() : nullptr, image_view->get_handle()};
-
-							if (image_view != nullptr)
-							{
-								// Add image layout info based on descriptor type
-								switch (binding_info->descriptorType)
-								{
-									case vk::DescriptorType::eCombinedImageSampler:
-										image_info.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-										break;
-									case vk::DescriptorType::eInputAttachment:
-										image_info.imageLayout = vkb::common::is_depth_format(image_view->get_format()) ? vk::ImageLayout::eDepthStencilReadOnlyOptimal : vk::ImageLayout::eShaderReadOnlyOptimal;
-										break;
-									case vk::DescriptorType::eStorageImage:
-										image_info.imageLayout = vk::ImageLayout::eGeneral;
-										break;
-									default:
-										continue;
-								}
-							}
-
-							image_infos[binding_index][array_element] = image_info;
-						}
+						case vk::DescriptorType::eCombinedImageSampler:
+							image_info.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+							break;
+						case vk::DescriptorType::eInputAttachment:
+							image_info.imageLayout = vkb::common::is_depth_format(image_view->get_format()) ? vk::ImageLayout::eDepthStencilReadOnlyOptimal : vk::ImageLayout::eShaderReadOnlyOptimal;
+							break;
+						case vk::DescriptorType::eStorageImage:
+							image_info.imageLayout = vk::ImageLayout::eGeneral;
+							break;
+						default:
+							continue;
 					}
-
-					assert((!update_after_bind || (buffer_infos.count(binding_index) > 0 || (image_infos.count(binding_index) > 0))) &&
-					       "binding index with no buffer or image infos can't be checked for adding to bindings_to_update");
 				}
+
+				descriptor_image_infos.set(binding_index, array_element, image_info);
+			}
+		}
+
+		switch (descriptor_set_layout.get_backend())
+		{
+			case vkb::DescriptorBackend::PushDescriptor:
+				push_descriptor_set(pipeline_bind_point, descriptor_set_id, descriptor_set_layout);
+				break;
+			case vkb::DescriptorBackend::DescriptorBuffer:
+				write_descriptor_buffer(descriptor_set_layout, descriptor_heap_allocation, descriptor_heap_offset);
+				this->get_resource().setDescriptorBufferOffsetsEXT(
+				    pipeline_bind_point, pipeline_layout.get_handle(), descriptor_set_id, 0U, descriptor_heap_allocation.get_offset() + descriptor_heap_offset);
+				descriptor_heap_offset += align_descriptor_heap_size(descriptor_set_layout.get_descriptor_buffer_size());
+				break;
+			default:
+			{
+				assert((!update_after_bind || std::ranges::all_of(resource_bindings, [&](auto const &resource_binding) {
+					        return !descriptor_set_layout.find_layout_binding(resource_binding.binding) ||
+					               descriptor_buffer_infos.has_binding(resource_binding.binding) || descriptor_image_infos.has_binding(resource_binding.binding);
+				        })) &&
+				       "binding index with no buffer or image infos can't be checked for adding to bindings_to_update");
+
+				vk::DescriptorSet descriptor_set_handle = command_pool.get_render_frame()->request_descriptor_set(
+				    descriptor_set_layout, descriptor_buffer_infos, descriptor_image_infos, update_after_bind, command_pool.get_thread_index());
+
+				// Bind descriptor set, which also unbinds the descriptor heap
+				this->get_resource().bindDescriptorSets(pipeline_bind_point, pipeline_layout.get_handle(), descriptor_set_id, descriptor_set_handle, dynamic_offsets);
+				bound_descriptor_heap = nullptr;
+				break;
 			}
+		}
+	}
+}
 
-			vk::DescriptorSet descriptor_set_handle = command_pool.get_render_frame()->request_descriptor_set(
-			    descriptor_set_layout, buffer_infos, image_infos, update_after_bind, command_pool.get_thread_index());
+template <vkb::BindingType bindingType>
+inline vkb::BufferAllocationCpp CommandBuffer<bindingType>::allocate_descriptor_heap(uint32_t descriptor_sets)
+{
+	const auto &pipeline_layout = pipeline_state.get_pipeline_layout();
 
-			// Bind descriptor set
-			this->get_resource().bindDescriptorSets(pipeline_bind_point, pipeline_layout.get_handle(), descriptor_set_id, descriptor_set_handle, dynamic_offsets);
+	vk::DeviceSize size = 0;
+	for (uint32_t descriptor_set_id = 0; descriptor_sets >> descriptor_set_id; ++descriptor_set_id)
+	{
+		if (descriptor_sets & (1U << descriptor_set_id))
+		{
+			size += align_descriptor_heap_size(pipeline_layout.get_descriptor_set_layout(descriptor_set_id).get_descriptor_buffer_size());
 		}
 	}
+
+	return command_pool.get_render_frame()->allocate_descriptor_heap(size, command_pool.get_thread_index());
+}
+
+template <vkb::BindingType bindingType>
+inline vk::DeviceSize CommandBuffer<bindingType>::align_descriptor_heap_size(vk::DeviceSize size) const
+{
+	vk::DeviceSize alignment = reinterpret_cast<vkb::core::DeviceCpp const &>(this->get_device()).get_descriptor_buffer_properties().descriptorBufferOffsetAlignment;
+	return (size + alignment - 1) & ~(alignment - 1);
+}
+
+template <vkb::BindingType bindingType>
+inline void CommandBuffer<bindingType>::push_descriptor_set(vk::PipelineBindPoint                    pipeline_bind_point,
+                                                            uint32_t                                 descriptor_set_id,
+                                                            vkb::core::HPPDescriptorSetLayout const &descriptor_set_layout)
+{
+	// The writes point to the infos in the tables, which stay valid until the next set is flushed
+	descriptor_writes.clear();
+	for (auto const &entry : descriptor_buffer_infos.get_entries())
+	{
+		descriptor_writes.push_back({.dstBinding      = entry.binding,
+		                             .dstArrayElement = entry.array_element,
+		                             .descriptorCount = 1,
+		                             .descriptorType  = descriptor_set_layout.find_layout_binding(entry.binding)->descriptorType,
+		                             .pBufferInfo     = &entry.value});
+	}
+	for (auto const &entry : descriptor_image_infos.get_entries())
+	{
+		descriptor_writes.push_back({.dstBinding      = entry.binding,
+		                             .dstArrayElement = entry.array_element,
+		                             .descriptorCount = 1,
+		                             .descriptorType  = descriptor_set_layout.find_layout_binding(entry.binding)->descriptorType,
+		                             .pImageInfo      = &entry.value});
+	}
+
+	this->get_resource().pushDescriptorSetKHR(pipeline_bind_point, pipeline_state.get_pipeline_layout().get_handle(), descriptor_set_id, descriptor_writes);
+}
+
+template <vkb::BindingType bindingType>
+inline void CommandBuffer<bindingType>::write_descriptor_buffer(vkb::core::HPPDescriptorSetLayout const &descriptor_set_layout,
+                                                                vkb::BufferAllocationCpp                &descriptor_heap_allocation,
+                                                                vk::DeviceSize                           offset)
+{
+	auto const &device        = reinterpret_cast<vkb::core::DeviceCpp const &>(this->get_device());
+	auto const &properties    = device.get_descriptor_buffer_properties();
+	vk::Device  device_handle = device.get_handle();
+
+	auto    &heap        = descriptor_heap_allocation.get_buffer();
+	uint8_t *descriptors = heap.map() + descriptor_heap_allocation.get_offset() + offset;
+
+	// Descriptors are written at the offsets of their bindings, array elements follow each other
+	auto write_descriptor = [&](uint32_t binding, uint32_t array_element, vk::DescriptorGetInfoEXT const &get_info, size_t descriptor_size) {
+		device_handle.getDescriptorEXT(
+		    get_info, descriptor_size, descriptors + descriptor_set_layout.get_descriptor_buffer_offset(binding) + array_element * descriptor_size);
+	};
+
+	for (auto const &entry : descriptor_buffer_infos.get_entries())
+	{
+		vk::DescriptorAddressInfoEXT address_info{.address = device_handle.getBufferAddressKHR({.buffer = entry.value.buffer}) + entry.value.offset,
+		                                          .range   = entry.value.range};
+
+		vk::DescriptorGetInfoEXT get_info{.type = descriptor_set_layout.find_layout_binding(entry.binding)->descriptorType};
+		if (get_info.type == vk::DescriptorType::eUniformBuffer)
+		{
+			get_info.data.pUniformBuffer = &address_info;
+			write_descriptor(entry.binding, entry.array_element, get_info, properties.uniformBufferDescriptorSize);
+		}
+		else
+		{
+			get_info.data.pStorageBuffer = &address_info;
+			write_descriptor(entry.binding, entry.array_element, get_info, properties.storageBufferDescriptorSize);
+		}
+	}
+
+	for (auto const &entry : descriptor_image_infos.get_entries())
+	{
+		vk::DescriptorGetInfoEXT get_info{.type = descriptor_set_layout.find_layout_binding(entry.binding)->descriptorType};
+		switch (get_info.type)
+		{
+			case vk::DescriptorType::eCombinedImageSampler:
+				get_info.data.pCombinedImageSampler = &entry.value;
+				write_descriptor(entry.binding, entry.array_element, get_info, properties.combinedImageSamplerDescriptorSize);
+				break;
+			case vk::DescriptorType::eSampledImage:
+				get_info.data.pSampledImage = &entry.value;
+				write_descriptor(entry.binding, entry.array_element, get_info, properties.sampledImageDescriptorSize);
+				break;
+			case vk::DescriptorType::eStorageImage:
+				get_info.data.pStorageImage = &entry.value;
+				write_descriptor(entry.binding, entry.array_element, get_info, properties.storageImageDescriptorSize);
+				break;
+			case vk::DescriptorType::eInputAttachment:
+				get_info.data.pInputAttachmentImage = &entry.value;
+				write_descriptor(entry.binding, entry.array_element, get_info, properties.inputAttachmentDescriptorSize);
+				break;
+			case vk::DescriptorType::eSampler:
+				get_info.data.pSampler = &entry.value.sampler;
+				write_descriptor(entry.binding, entry.array_element, get_info, properties.samplerDescriptorSize);
+				break;
+			default:
+				break;
+		}
+	}
+
+	heap.flush(descriptor_heap_allocation.get_offset() + offset, descriptor_set_layout.get_descriptor_buffer_size());
 }
 
 template <vkb::BindingType bindingType>
@@ -75,14 +75,14 @@ class CommandPool : private vkb::core::CommandPoolBase
 	CommandPool &operator=(CommandPool<bindingType> &&other) = default;
 	~CommandPool()                                           = default;
 
-	vkb::core::Device<bindingType>                        &get_device();
-	CommandPoolType                                        get_handle() const;
-	uint32_t                                               get_queue_family_index() const;
-	vkb::rendering::RenderFrame<bindingType>              *get_render_frame();
-	vkb::CommandBufferResetMode                            get_reset_mode() const;
-	size_t                                                 get_thread_index() const;
-	std::shared_ptr<vkb::core::CommandBuffer<bindingType>> request_command_buffer(CommandBufferLevelType level = DefaultCommandBufferLevelValue<CommandBufferLevelType>::value);
-	void                                                   reset_pool();
+	vkb::core::Device<bindingType>           &get_device();
+	CommandPoolType                           get_handle() const;
+	uint32_t                                  get_queue_family_index() const;
+	vkb::rendering::RenderFrame<bindingType> *get_render_frame();
+	vkb::CommandBufferResetMode               get_reset_mode() const;
+	size_t                                    get_thread_index() const;
+	CommandBufferHandle<bindingType>          request_command_buffer(CommandBufferLevelType level = DefaultCommandBufferLevelValue<CommandBufferLevelType>::value);
+	void                                      reset_pool();
 };
 
 using CommandPoolC   = CommandPool<vkb::BindingType::C>;
@@ -159,7 +159,7 @@ inline size_t CommandPool<bindingType>::get_thread_index() const
 }
 
 template <vkb::BindingType bindingType>
-std::shared_ptr<vkb::core::CommandBuffer<bindingType>> CommandPool<bindingType>::request_command_buffer(CommandBufferLevelType level)
+vkb::core::CommandBufferHandle<bindingType> CommandPool<bindingType>::request_command_buffer(CommandBufferLevelType level)
 {
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
@@ -167,9 +167,9 @@ std::shared_ptr<vkb::core::CommandBuffer<bindingType>> CommandPool<bindingType>:
 	}
 	else
 	{
-		std::shared_ptr<vkb::core::CommandBufferCpp> command_buffer =
+		vkb::core::CommandBufferHandleCpp command_buffer =
 		    CommandPoolBase::request_command_buffer(reinterpret_cast<vkb::core::CommandPoolCpp &>(*this), static_cast<vk::CommandBufferLevel>(level));
-		return *reinterpret_cast<std::shared_ptr<CommandBufferC> *>(&command_buffer);
+		return vkb::core::CommandBufferHandleC{reinterpret_cast<vkb::core::CommandBufferC *>(command_buffer.get())};
 	}
 }
 
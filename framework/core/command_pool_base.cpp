@@ -105,38 +105,44 @@ size_t CommandPoolBase::get_thread_index() const
 	return thread_index;
 }
 
-std::shared_ptr<vkb::core::CommandBufferCpp> CommandPoolBase::request_command_buffer(vkb::core::CommandPoolCpp &commandPool, vk::CommandBufferLevel level)
+vkb::core::CommandBufferHandleCpp CommandPoolBase::request_command_buffer(vkb::core::CommandPoolCpp &commandPool, vk::CommandBufferLevel level)
 {
 	if (static_cast<vk::CommandBufferLevel>(level) == vk::CommandBufferLevel::ePrimary)
 	{
 		if (active_primary_command_buffer_count < primary_command_buffers.size())
 		{
-			return primary_command_buffers[active_primary_command_buffer_count++];
+			return vkb::core::CommandBufferHandleCpp{primary_command_buffers[active_primary_command_buffer_count++].get()};
 		}
 
-		primary_command_buffers.emplace_back(std::make_shared<vkb::core::CommandBufferCpp>(commandPool, level));
+		primary_command_buffers.emplace_back(std::make_unique<vkb::core::CommandBufferCpp>(commandPool, level));
 
 		active_primary_command_buffer_count++;
 
-		return primary_command_buffers.back();
+		return vkb::core::CommandBufferHandleCpp{primary_command_buffers.back().get()};
 	}
 	else
 	{
 		if (active_secondary_command_buffer_count < secondary_command_buffers.size())
 		{
-			return secondary_command_buffers[active_secondary_command_buffer_count++];
+			return vkb::core::CommandBufferHandleCpp{secondary_command_buffers[active_secondary_command_buffer_count++].get()};
 		}
 
-		secondary_command_buffers.emplace_back(std::make_shared<vkb::core::CommandBufferCpp>(commandPool, level));
+		secondary_command_buffers.emplace_back(std::make_unique<vkb::core::CommandBufferCpp>(commandPool, level));
 
 		active_secondary_command_buffer_count++;
 
-		return secondary_command_buffers.back();
+		return vkb::core::CommandBufferHandleCpp{secondary_command_buffers.back().get()};
 	}
 }
 
 void CommandPoolBase::reset_pool()
 {
+	// The pool was not used since it was last reset, its command buffers are already reset
+	if (active_primary_command_buffer_count == 0 && active_secondary_command_buffer_count == 0)
+	{
+		return;
+	}
+
 	switch (reset_mode)
 	{
 		case vkb::CommandBufferResetMode::ResetIndividually:
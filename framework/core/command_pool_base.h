@@ -40,6 +40,59 @@ template <vkb::BindingType bindingType>
 class CommandPool;
 using CommandPoolCpp = CommandPool<vkb::BindingType::Cpp>;
 
+/**
+ * @brief Non-owning handle to a command buffer, which is owned by the command pool it was requested from
+ *
+ * The pool keeps its command buffers and hands them out again once it is reset, so a handle is only valid until then:
+ * for the command pools of a RenderFrame, until the frame is reset. Copying a handle copies a pointer, without any
+ * reference counting.
+ */
+template <vkb::BindingType bindingType>
+class CommandBufferHandle
+{
+  public:
+	CommandBufferHandle() = default;
+
+	CommandBufferHandle(std::nullptr_t)
+	{}
+
+	explicit CommandBufferHandle(CommandBuffer<bindingType> *command_buffer) :
+	    command_buffer{command_buffer}
+	{}
+
+	CommandBuffer<bindingType> *get() const
+	{
+		return command_buffer;
+	}
+
+	CommandBuffer<bindingType> &operator*() const
+	{
+		return *command_buffer;
+	}
+
+	CommandBuffer<bindingType> *operator->() const
+	{
+		return command_buffer;
+	}
+
+	explicit operator bool() const
+	{
+		return command_buffer != nullptr;
+	}
+
+	bool operator==(CommandBufferHandle const &other) const = default;
+
+	void reset()
+	{
+		command_buffer = nullptr;
+	}
+
+  private:
+	CommandBuffer<bindingType> *command_buffer = nullptr;
+};
+using CommandBufferHandleC   = CommandBufferHandle<vkb::BindingType::C>;
+using CommandBufferHandleCpp = CommandBufferHandle<vkb::BindingType::Cpp>;
+
 template <vkb::BindingType bindingType>
 class Device;
 using DeviceCpp = Device<vkb::BindingType::Cpp>;
@@ -65,7 +118,7 @@ class CommandPoolBase
 	vkb::rendering::RenderFrameCpp              *get_render_frame();
 	vkb::CommandBufferResetMode                  get_reset_mode() const;
 	size_t                                       get_thread_index() const;
-	std::shared_ptr<vkb::core::CommandBufferCpp> request_command_buffer(vkb::core::CommandPoolCpp &commandPool, vk::CommandBufferLevel level);
+	vkb::core::CommandBufferHandleCpp            request_command_buffer(vkb::core::CommandPoolCpp &commandPool, vk::CommandBufferLevel level);
 	void                                         reset_pool();
 
   private:
@@ -74,9 +127,9 @@ class CommandPoolBase
 	vkb::rendering::RenderFrameCpp                           *render_frame       = nullptr;
 	size_t                                                    thread_index       = 0;
 	uint32_t                                                  queue_family_index = 0;
-	std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> primary_command_buffers;
+	std::vector<std::unique_ptr<vkb::core::CommandBufferCpp>> primary_command_buffers;
 	uint32_t                                                  active_primary_command_buffer_count = 0;
-	std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> secondary_command_buffers;
+	std::vector<std::unique_ptr<vkb::core::CommandBufferCpp>> secondary_command_buffers;
 	uint32_t                                                  active_secondary_command_buffer_count = 0;
 	vkb::CommandBufferResetMode                               reset_mode                            = vkb::CommandBufferResetMode::ResetPool;
 };
@@ -70,6 +70,14 @@ inline VkDescriptorType find_descriptor_type(ShaderResourceType resource_type, b
 	}
 }
 
+inline bool has_binding(const ShaderResource &resource)
+{
+	return resource.type != ShaderResourceType::Input &&
+	       resource.type != ShaderResourceType::Output &&
+	       resource.type != ShaderResourceType::PushConstant &&
+	       resource.type != ShaderResourceType::SpecializationConstant;
+}
+
 inline bool validate_binding(const VkDescriptorSetLayoutBinding &binding, const std::vector<VkDescriptorType> &blacklist)
 {
 	return !(std::ranges::find_if(blacklist, [binding](const VkDescriptorType &type) { return type == binding.descriptorType; }) != blacklist.end());
@@ -99,9 +107,11 @@ inline bool validate_flags(vkb::core::PhysicalDeviceC const                &gpu,
 DescriptorSetLayout::DescriptorSetLayout(vkb::core::DeviceC                &device,
                                          const uint32_t                     set_index,
                                          const std::vector<ShaderModule *> &shader_modules,
-                                         const std::vector<ShaderResource> &resource_set) :
+                                         const std::vector<ShaderResource> &resource_set,
+                                         DescriptorBackend                  backend) :
     device{device},
     set_index{set_index},
+    backend{backend},
     shader_modules{shader_modules}
 {
 	// NOTE: `shader_modules` is passed in mainly for hashing their handles in `request_resource`.
@@ -111,10 +121,7 @@ DescriptorSetLayout::DescriptorSetLayout(vkb::core::DeviceC                &devi
 	for (auto &resource : resource_set)
 	{
 		// Skip shader resources whitout a binding point
-		if (resource.type == ShaderResourceType::Input ||
-		    resource.type == ShaderResourceType::Output ||
-		    resource.type == ShaderResourceType::PushConstant ||
-		    resource.type == ShaderResourceType::SpecializationConstant)
+		if (!has_binding(resource))
 		{
 			continue;
 		}
@@ -181,6 +188,17 @@ DescriptorSetLayout::DescriptorSetLayout(vkb::core::DeviceC                &devi
 		create_info.flags |= std::ranges::find(binding_flags, VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT) != binding_flags.end() ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT : 0;
 	}
 
+	if (backend != DescriptorBackend::Pooled)
+	{
+		if (!supports_backend(device, resource_set, backend))
+		{
+			throw std::runtime_error("Cannot create descriptor set layout, the resources cannot use the requested descriptor backend.");
+		}
+
+		create_info.flags |= backend == DescriptorBackend::PushDescriptor ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR :
+		                                                                    VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+	}
+
 	// Create the Vulkan descriptor set layout handle
 	VkResult result = vkCreateDescriptorSetLayout(device.get_handle(), &create_info, nullptr, &handle);
 
@@ -188,6 +206,51 @@ DescriptorSetLayout::DescriptorSetLayout(vkb::core::DeviceC                &devi
 	{
 		throw VulkanException{result, "Cannot create DescriptorSetLayout"};
 	}
+
+	// Descriptors are written at fixed offsets of the set in a descriptor buffer, the driver decides of the layout of the set
+	if (backend == DescriptorBackend::DescriptorBuffer)
+	{
+		vk::Device              device_handle{device.get_handle()};
+		vk::DescriptorSetLayout layout_handle{handle};
+
+		descriptor_buffer_size = device_handle.getDescriptorSetLayoutSizeEXT(layout_handle);
+		for (auto &binding : bindings)
+		{
+			descriptor_buffer_offsets_lookup.emplace(binding.binding, device_handle.getDescriptorSetLayoutBindingOffsetEXT(layout_handle, binding.binding));
+		}
+	}
+}
+
+bool DescriptorSetLayout::supports_backend(vkb::core::DeviceC &device, const std::vector<ShaderResource> &resource_set, DescriptorBackend backend)
+{
+	if ((backend == DescriptorBackend::PushDescriptor && !device.is_push_descriptor_enabled()) ||
+	    (backend == DescriptorBackend::DescriptorBuffer && !device.is_descriptor_buffer_enabled()))
+	{
+		return false;
+	}
+	if (backend == DescriptorBackend::Pooled)
+	{
+		return true;
+	}
+
+	uint32_t descriptor_count = 0;
+	for (auto &resource : resource_set)
+	{
+		if (!has_binding(resource))
+		{
+			continue;
+		}
+
+		// Neither backend has dynamic descriptors, and their descriptors are written when the set is bound
+		if (resource.mode != ShaderResourceMode::Static)
+		{
+			return false;
+		}
+
+		descriptor_count += resource.array_size;
+	}
+
+	return backend != DescriptorBackend::PushDescriptor || descriptor_count <= device.get_max_push_descriptors();
 }
 
 DescriptorSetLayout::DescriptorSetLayout(DescriptorSetLayout &&other) :
@@ -195,11 +258,14 @@ DescriptorSetLayout::DescriptorSetLayout(DescriptorSetLayout &&other) :
     shader_modules{other.shader_modules},
     handle{other.handle},
     set_index{other.set_index},
+    backend{other.backend},
     bindings{std::move(other.bindings)},
     binding_flags{std::move(other.binding_flags)},
     bindings_lookup{std::move(other.bindings_lookup)},
     binding_flags_lookup{std::move(other.binding_flags_lookup)},
-    resources_lookup{std::move(other.resources_lookup)}
+    resources_lookup{std::move(other.resources_lookup)},
+    descriptor_buffer_size{other.descriptor_buffer_size},
+    descriptor_buffer_offsets_lookup{std::move(other.descriptor_buffer_offsets_lookup)}
 {
 	other.handle = VK_NULL_HANDLE;
 }
@@ -223,6 +289,25 @@ const uint32_t DescriptorSetLayout::get_index() const
 	return set_index;
 }
 
+DescriptorBackend DescriptorSetLayout::get_backend() const
+{
+	return backend;
+}
+
+VkDeviceSize DescriptorSetLayout::get_descriptor_buffer_size() const
+{
+	return descriptor_buffer_size;
+}
+
+VkDeviceSize DescriptorSetLayout::get_descriptor_buffer_offset(const uint32_t binding_index) const
+{
+	auto it = descriptor_buffer_offsets_lookup.find(binding_index);
+
+	assert(it != descriptor_buffer_offsets_lookup.end() && "The binding is not in the descriptor buffer layout");
+
+	return it->second;
+}
+
 const std::vector<VkDescriptorSetLayoutBinding> &DescriptorSetLayout::get_bindings() const
 {
 	return bindings;
@@ -245,6 +330,13 @@ std::unique_ptr<VkDescriptorSetLayoutBinding> DescriptorSetLayout::get_layout_bi
 	return std::make_unique<VkDescriptorSetLayoutBinding>(it->second);
 }
 
+const VkDescriptorSetLayoutBinding *DescriptorSetLayout::find_layout_binding(uint32_t binding_index) const
+{
+	auto it = bindings_lookup.find(binding_index);
+
+	return it != bindings_lookup.end() ? &it->second : nullptr;
+}
+
 std::unique_ptr<VkDescriptorSetLayoutBinding> DescriptorSetLayout::get_layout_binding(const std::string &name) const
 {
 	auto it = resources_lookup.find(name);
@@ -47,11 +47,13 @@ class DescriptorSetLayout
 	 * @param set_index The descriptor set index this layout maps to
 	 * @param shader_modules The shader modules this set layout will be used for
 	 * @param resource_set A grouping of shader resources belonging to the same set
+	 * @param backend How the descriptors of the set are provided, see supports_backend
 	 */
 	DescriptorSetLayout(vkb::core::DeviceC                &device,
 	                    const uint32_t                     set_index,
 	                    const std::vector<ShaderModule *> &shader_modules,
-	                    const std::vector<ShaderResource> &resource_set);
+	                    const std::vector<ShaderResource> &resource_set,
+	                    DescriptorBackend                  backend = DescriptorBackend::Pooled);
 
 	DescriptorSetLayout(const DescriptorSetLayout &) = delete;
 
@@ -63,8 +65,27 @@ class DescriptorSetLayout
 
 	DescriptorSetLayout &operator=(DescriptorSetLayout &&) = delete;
 
+	/**
+	 * @brief Checks whether a set of resources can use a descriptor backend
+	 *        Push descriptors and descriptor buffers have no dynamic or update-after-bind descriptors,
+	 *        and a push descriptor set has no more descriptors than the device can push
+	 */
+	static bool supports_backend(vkb::core::DeviceC &device, const std::vector<ShaderResource> &resource_set, DescriptorBackend backend);
+
 	VkDescriptorSetLayout get_handle() const;
 
+	DescriptorBackend get_backend() const;
+
+	/**
+	 * @return The size of the set in a descriptor buffer, zero if the layout is not for descriptor buffers
+	 */
+	VkDeviceSize get_descriptor_buffer_size() const;
+
+	/**
+	 * @return The offset of a binding in the set, in a descriptor buffer
+	 */
+	VkDeviceSize get_descriptor_buffer_offset(const uint32_t binding_index) const;
+
 	const uint32_t get_index() const;
 
 	const std::vector<VkDescriptorSetLayoutBinding> &get_bindings() const;
@@ -73,6 +94,12 @@ class DescriptorSetLayout
 
 	std::unique_ptr<VkDescriptorSetLayoutBinding> get_layout_binding(const std::string &name) const;
 
+	/**
+	 * @brief Looks up a binding without copying it, as done for each resource when flushing a command buffer
+	 * @return The binding, or nullptr if the layout has no such binding
+	 */
+	const VkDescriptorSetLayoutBinding *find_layout_binding(const uint32_t binding_index) const;
+
 	const std::vector<VkDescriptorBindingFlagsEXT> &get_binding_flags() const;
 
 	VkDescriptorBindingFlagsEXT get_layout_binding_flag(const uint32_t binding_index) const;
@@ -86,6 +113,8 @@ class DescriptorSetLayout
 
 	const uint32_t set_index;
 
+	DescriptorBackend backend;
+
 	std::vector<VkDescriptorSetLayoutBinding> bindings;
 
 	std::vector<VkDescriptorBindingFlagsEXT> binding_flags;
@@ -97,5 +126,9 @@ class DescriptorSetLayout
 	std::unordered_map<std::string, uint32_t> resources_lookup;
 
 	std::vector<ShaderModule *> shader_modules;
+
+	VkDeviceSize descriptor_buffer_size{0};
+
+	std::unordered_map<uint32_t, VkDeviceSize> descriptor_buffer_offsets_lookup;
 };
 }        // namespace vkb
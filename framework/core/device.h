@@ -21,11 +21,13 @@
 #include "common/vk_common.h"
 #include "core/buffer.h"
 #include "core/physical_device.h"
+#include "core/upload_manager.h"
 #include "hpp_debug.h"
 #include "hpp_fence_pool.h"
 #include "hpp_queue.h"
 #include "hpp_resource_cache.h"
 #include "queue.h"
+#include <mutex>
 #include <utility>
 #include <vulkan/vulkan.hpp>
 
@@ -117,15 +119,34 @@ class Device
 	void                                 flush_command_buffer(CommandBufferType command_buffer, QueueType queue, bool free = true, SemaphoreType signal_semaphore = VK_NULL_HANDLE) const;
 	vkb::core::CommandPool<bindingType> &get_command_pool() const;
 	DebugUtilsType const                &get_debug_utils() const;
+	vkb::DescriptorBackend               get_descriptor_backend() const;
 	FencePoolType                       &get_fence_pool() const;
 	PhysicalDevice<bindingType> const   &get_gpu() const;
+	uint32_t                             get_max_push_descriptors() const;        // Queried when push descriptors are enabled
 	CoreQueueType const                 &get_queue(uint32_t queue_family_index, uint32_t queue_index) const;
 	CoreQueueType const                 &get_queue_by_flags(QueueFlagsType queue_flags, uint32_t queue_index) const;
 	CoreQueueType const                 &get_queue_by_present(uint32_t queue_index) const;
 	ResourceCacheType                   &get_resource_cache();
+	vkb::core::UploadManager            &get_upload_manager();        // Created on first use, from any thread
+	bool                                 is_descriptor_buffer_enabled() const;        // Requested with the descriptorBuffer and bufferDeviceAddress features
 	bool                                 is_extension_enabled(const char *extension) const;
 	bool                                 is_image_format_supported(FormatType format) const;
-	void                                 wait_idle() const;
+	bool                                 is_push_descriptor_enabled() const;           // Requested with VK_KHR_push_descriptor
+	bool                                 is_synchronization2_enabled() const;          // Requested with the synchronization2 feature
+	bool                                 is_timeline_semaphore_enabled() const;        // Requested with the timelineSemaphore feature
+
+	/**
+	 * @brief Selects how command buffers provide the descriptor sets of the pipeline layouts requested afterwards
+	 *        Falls back to pooled descriptor sets if the backend is not enabled on the device
+	 */
+	void set_descriptor_backend(vkb::DescriptorBackend backend);
+
+	/**
+	 * @brief Gets the sizes and alignments of descriptors in descriptor buffers, queried when descriptor buffers are enabled
+	 */
+	vk::PhysicalDeviceDescriptorBufferPropertiesEXT const &get_descriptor_buffer_properties() const;
+
+	void wait_idle() const;
 
   private:
 	void                                   copy_buffer_impl(vk::Device device, vkb::core::BufferCpp const &src, vkb::core::BufferCpp &dst, vk::Queue queue, vk::BufferCopy const *copy_region);
@@ -136,17 +157,23 @@ class Device
 	void flush_command_buffer_impl(
 	    vk::Device device, vk::CommandBuffer command_buffer, vk::Queue queue, bool free = true, vk::Semaphore signal_semaphore = nullptr) const;
 	vkb::core::HPPQueue const &get_queue_by_flags_impl(vk::QueueFlags queue_flags, uint32_t queue_index) const;
+	std::unique_lock<std::mutex> lock_queue_impl(vk::Queue queue) const;
 	void                       init(std::unordered_map<const char *, bool> const &requested_extensions, std::function<void(vkb::core::PhysicalDevice<bindingType> &)> request_gpu_features);
 
   private:
-	std::unique_ptr<vkb::core::CommandPoolCpp>    command_pool;
-	std::unique_ptr<vkb::core::HPPDebugUtils>     debug_utils;
-	std::vector<const char *>                     enabled_extensions{};
-	std::unique_ptr<vkb::HPPFencePool>            fence_pool;
-	vkb::core::PhysicalDeviceCpp                 &gpu;
-	std::vector<std::vector<vkb::core::HPPQueue>> queues;
-	vkb::HPPResourceCache                         resource_cache;
-	vk::SurfaceKHR                                surface = nullptr;
+	std::unique_ptr<vkb::core::CommandPoolCpp>      command_pool;
+	std::unique_ptr<vkb::core::HPPDebugUtils>       debug_utils;
+	vkb::DescriptorBackend                          descriptor_backend = vkb::DescriptorBackend::Pooled;
+	vk::PhysicalDeviceDescriptorBufferPropertiesEXT descriptor_buffer_properties;
+	std::vector<const char *>                       enabled_extensions{};
+	std::unique_ptr<vkb::HPPFencePool>              fence_pool;
+	vkb::core::PhysicalDeviceCpp                   &gpu;
+	uint32_t                                        max_push_descriptors = 0;
+	std::vector<std::vector<vkb::core::HPPQueue>>   queues;
+	vkb::HPPResourceCache                           resource_cache;
+	vk::SurfaceKHR                                  surface = nullptr;
+	std::unique_ptr<vkb::core::UploadManager>       upload_manager;
+	std::once_flag                                  upload_manager_created;        // Loader threads request the upload manager concurrently
 };
 
 using DeviceC   = Device<vkb::BindingType::C>;
@@ -201,6 +228,7 @@ inline Device<vkb::BindingType::C>::Device(vkb::core::PhysicalDeviceC &gpu, VkDe
 template <vkb::BindingType bindingType>
 inline Device<bindingType>::~Device()
 {
+	upload_manager.reset();
 	resource_cache.clear();
 	command_pool.reset();
 	fence_pool.reset();
@@ -379,6 +407,18 @@ inline typename Device<bindingType>::DebugUtilsType const &Device<bindingType>::
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline vkb::DescriptorBackend Device<bindingType>::get_descriptor_backend() const
+{
+	return descriptor_backend;
+}
+
+template <vkb::BindingType bindingType>
+inline vk::PhysicalDeviceDescriptorBufferPropertiesEXT const &Device<bindingType>::get_descriptor_buffer_properties() const
+{
+	return descriptor_buffer_properties;
+}
+
 template <vkb::BindingType bindingType>
 inline typename Device<bindingType>::FencePoolType &Device<bindingType>::get_fence_pool() const
 {
@@ -405,6 +445,12 @@ inline PhysicalDevice<bindingType> const &Device<bindingType>::get_gpu() const
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline uint32_t Device<bindingType>::get_max_push_descriptors() const
+{
+	return max_push_descriptors;
+}
+
 template <vkb::BindingType bindingType>
 inline typename Device<bindingType>::CoreQueueType const &Device<bindingType>::get_queue(uint32_t queue_family_index, uint32_t queue_index) const
 {
@@ -469,6 +515,52 @@ inline typename Device<bindingType>::ResourceCacheType &Device<bindingType>::get
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline vkb::core::UploadManager &Device<bindingType>::get_upload_manager()
+{
+	std::call_once(upload_manager_created, [this]() {
+		if constexpr (bindingType == vkb::BindingType::Cpp)
+		{
+			upload_manager = std::make_unique<vkb::core::UploadManager>(*this);
+		}
+		else
+		{
+			upload_manager = std::make_unique<vkb::core::UploadManager>(*reinterpret_cast<vkb::core::DeviceCpp *>(this));
+		}
+	});
+	return *upload_manager;
+}
+
+template <vkb::BindingType bindingType>
+inline bool Device<bindingType>::is_descriptor_buffer_enabled() const
+{
+	// Descriptors of buffers are written with their device address, VMA only allocates buffers with one if the extension is enabled
+	if (!is_extension_enabled(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME) || !is_extension_enabled(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME))
+	{
+		return false;
+	}
+
+	// Look for the features in the structure chain used at device creation, buffer device address is either standalone or part of the Vulkan 1.2 features
+	bool descriptor_buffer     = false;
+	bool buffer_device_address = false;
+	for (auto feature = static_cast<vk::BaseOutStructure const *>(gpu.get_extension_feature_chain()); feature; feature = feature->pNext)
+	{
+		if (feature->sType == vk::StructureType::ePhysicalDeviceDescriptorBufferFeaturesEXT)
+		{
+			descriptor_buffer = reinterpret_cast<vk::PhysicalDeviceDescriptorBufferFeaturesEXT const *>(feature)->descriptorBuffer;
+		}
+		else if (feature->sType == vk::StructureType::ePhysicalDeviceBufferDeviceAddressFeatures)
+		{
+			buffer_device_address |= !!reinterpret_cast<vk::PhysicalDeviceBufferDeviceAddressFeatures const *>(feature)->bufferDeviceAddress;
+		}
+		else if (feature->sType == vk::StructureType::ePhysicalDeviceVulkan12Features)
+		{
+			buffer_device_address |= !!reinterpret_cast<vk::PhysicalDeviceVulkan12Features const *>(feature)->bufferDeviceAddress;
+		}
+	}
+	return descriptor_buffer && buffer_device_address;
+}
+
 template <vkb::BindingType bindingType>
 inline bool Device<bindingType>::is_extension_enabled(const char *extension) const
 {
@@ -486,6 +578,60 @@ inline bool Device<bindingType>::is_image_format_supported(FormatType format) co
 	           static_cast<vk::Format>(format), vk::ImageType::e2D, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eSampled, {}, &format_properties);
 }
 
+template <vkb::BindingType bindingType>
+inline bool Device<bindingType>::is_push_descriptor_enabled() const
+{
+	return is_extension_enabled(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+}
+
+template <vkb::BindingType bindingType>
+inline bool Device<bindingType>::is_synchronization2_enabled() const
+{
+	// Look for the feature in the structure chain used at device creation, where it is either standalone or part of the Vulkan 1.3 features
+	for (auto feature = static_cast<vk::BaseOutStructure const *>(gpu.get_extension_feature_chain()); feature; feature = feature->pNext)
+	{
+		if (feature->sType == vk::StructureType::ePhysicalDeviceSynchronization2Features)
+		{
+			return reinterpret_cast<vk::PhysicalDeviceSynchronization2Features const *>(feature)->synchronization2;
+		}
+		if (feature->sType == vk::StructureType::ePhysicalDeviceVulkan13Features)
+		{
+			return reinterpret_cast<vk::PhysicalDeviceVulkan13Features const *>(feature)->synchronization2;
+		}
+	}
+	return false;
+}
+
+template <vkb::BindingType bindingType>
+inline bool Device<bindingType>::is_timeline_semaphore_enabled() const
+{
+	// Look for the feature in the structure chain used at device creation, where it is either standalone or part of the Vulkan 1.2 features
+	for (auto feature = static_cast<vk::BaseOutStructure const *>(gpu.get_extension_feature_chain()); feature; feature = feature->pNext)
+	{
+		if (feature->sType == vk::StructureType::ePhysicalDeviceTimelineSemaphoreFeatures)
+		{
+			return reinterpret_cast<vk::PhysicalDeviceTimelineSemaphoreFeatures const *>(feature)->timelineSemaphore;
+		}
+		if (feature->sType == vk::StructureType::ePhysicalDeviceVulkan12Features)
+		{
+			return reinterpret_cast<vk::PhysicalDeviceVulkan12Features const *>(feature)->timelineSemaphore;
+		}
+	}
+	return false;
+}
+
+template <vkb::BindingType bindingType>
+inline void Device<bindingType>::set_descriptor_backend(vkb::DescriptorBackend backend)
+{
+	if ((backend == vkb::DescriptorBackend::PushDescriptor && !is_push_descriptor_enabled()) ||
+	    (backend == vkb::DescriptorBackend::DescriptorBuffer && !is_descriptor_buffer_enabled()))
+	{
+		LOGW("Descriptor backend is not enabled on the device, using pooled descriptor sets");
+		backend = vkb::DescriptorBackend::Pooled;
+	}
+	descriptor_backend = backend;
+}
+
 template <vkb::BindingType bindingType>
 inline void Device<bindingType>::wait_idle() const
 {
@@ -562,6 +708,24 @@ inline std::pair<vk::Image, vk::DeviceMemory> Device<bindingType>::create_image_
 	return std::make_pair(image, memory);
 }
 
+template <vkb::BindingType bindingType>
+inline std::unique_lock<std::mutex> Device<bindingType>::lock_queue_impl(vk::Queue queue) const
+{
+	for (auto const &family_queues : queues)
+	{
+		for (auto const &family_queue : family_queues)
+		{
+			if (family_queue.get_handle() == queue)
+			{
+				return family_queue.lock();
+			}
+		}
+	}
+
+	// Queues not retrieved through this device are synchronized by their owner
+	return {};
+}
+
 template <vkb::BindingType bindingType>
 inline void Device<bindingType>::flush_command_buffer_impl(
     vk::Device device, vk::CommandBuffer command_buffer, vk::Queue queue, bool free, vk::Semaphore signal_semaphore) const
@@ -580,7 +744,10 @@ inline void Device<bindingType>::flush_command_buffer_impl(
 		vk::Fence fence = device.createFence({});
 
 		// Submit to the queue
-		queue.submit(submit_info, fence);
+		{
+			auto guard = lock_queue_impl(queue);
+			queue.submit(submit_info, fence);
+		}
 
 		// Wait for the fence to signal that command buffer has finished executing
 		vk::Result result = device.waitForFences(fence, true, DEFAULT_FENCE_TIMEOUT);
@@ -748,7 +915,8 @@ inline void Device<bindingType>::init(std::unordered_map<const char *, bool> con
 	{
 		const vk::QueueFamilyProperties &queue_family_property = gpu.get_queue_family_properties()[queue_family_index];
 
-		vk::Bool32 present_supported = gpu.get_handle().getSurfaceSupportKHR(queue_family_index, surface);
+		// Without a surface, e.g. in offscreen mode, no queue presents
+		vk::Bool32 present_supported = surface ? gpu.get_handle().getSurfaceSupportKHR(queue_family_index, surface) : VK_FALSE;
 
 		for (uint32_t queue_index = 0U; queue_index < queue_family_property.queueCount; ++queue_index)
 		{
@@ -766,6 +934,21 @@ inline void Device<bindingType>::init(std::unordered_map<const char *, bool> con
 
 	vkb::allocated::init(*this);
 
+	// Limits of the descriptor backends, used when creating descriptor set layouts for them
+	if (is_push_descriptor_enabled())
+	{
+		max_push_descriptors = gpu.get_handle()
+		                           .getProperties2KHR<vk::PhysicalDeviceProperties2KHR, vk::PhysicalDevicePushDescriptorPropertiesKHR>()
+		                           .template get<vk::PhysicalDevicePushDescriptorPropertiesKHR>()
+		                           .maxPushDescriptors;
+	}
+	if (is_descriptor_buffer_enabled())
+	{
+		descriptor_buffer_properties = gpu.get_handle()
+		                                   .getProperties2KHR<vk::PhysicalDeviceProperties2KHR, vk::PhysicalDeviceDescriptorBufferPropertiesEXT>()
+		                                   .template get<vk::PhysicalDeviceDescriptorBufferPropertiesEXT>();
+	}
+
 	if constexpr (bindingType == BindingType::Cpp)
 	{
 		command_pool = std::make_unique<vkb::core::CommandPoolCpp>(
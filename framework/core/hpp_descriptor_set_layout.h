@@ -40,19 +40,40 @@ struct HPPShaderResource;
 class HPPDescriptorSetLayout : private vkb::DescriptorSetLayout
 {
   public:
+	using vkb::DescriptorSetLayout::get_backend;
 	using vkb::DescriptorSetLayout::get_index;
 
   public:
 	HPPDescriptorSetLayout(vkb::core::DeviceCpp                            &device,
 	                       const uint32_t                                   set_index,
 	                       const std::vector<vkb::core::HPPShaderModule *> &shader_modules,
-	                       const std::vector<vkb::core::HPPShaderResource> &resource_set) :
+	                       const std::vector<vkb::core::HPPShaderResource> &resource_set,
+	                       vkb::DescriptorBackend                           backend = vkb::DescriptorBackend::Pooled) :
 	    vkb::DescriptorSetLayout(reinterpret_cast<vkb::core::DeviceC &>(device),
 	                             set_index,
 	                             reinterpret_cast<std::vector<vkb::ShaderModule *> const &>(shader_modules),
-	                             reinterpret_cast<std::vector<vkb::ShaderResource> const &>(resource_set))
+	                             reinterpret_cast<std::vector<vkb::ShaderResource> const &>(resource_set),
+	                             backend)
 	{}
 
+	static bool supports_backend(vkb::core::DeviceCpp                            &device,
+	                             const std::vector<vkb::core::HPPShaderResource> &resource_set,
+	                             vkb::DescriptorBackend                           backend)
+	{
+		return vkb::DescriptorSetLayout::supports_backend(
+		    reinterpret_cast<vkb::core::DeviceC &>(device), reinterpret_cast<std::vector<vkb::ShaderResource> const &>(resource_set), backend);
+	}
+
+	vk::DeviceSize get_descriptor_buffer_size() const
+	{
+		return static_cast<vk::DeviceSize>(vkb::DescriptorSetLayout::get_descriptor_buffer_size());
+	}
+
+	vk::DeviceSize get_descriptor_buffer_offset(const uint32_t binding_index) const
+	{
+		return static_cast<vk::DeviceSize>(vkb::DescriptorSetLayout::get_descriptor_buffer_offset(binding_index));
+	}
+
 	vk::DescriptorSetLayout get_handle() const
 	{
 		return static_cast<vk::DescriptorSetLayout>(vkb::DescriptorSetLayout::get_handle());
@@ -70,6 +91,11 @@ class HPPDescriptorSetLayout : private vkb::DescriptorSetLayout
 		    reinterpret_cast<vk::DescriptorSetLayoutBinding *>(vkb::DescriptorSetLayout::get_layout_binding(name).release()));
 	}
 
+	vk::DescriptorSetLayoutBinding const *find_layout_binding(const uint32_t binding_index) const
+	{
+		return reinterpret_cast<vk::DescriptorSetLayoutBinding const *>(vkb::DescriptorSetLayout::find_layout_binding(binding_index));
+	}
+
 	vk::DescriptorBindingFlagsEXT get_layout_binding_flag(const uint32_t binding_index) const
 	{
 		return static_cast<vk::DescriptorBindingFlagsEXT>(vkb::DescriptorSetLayout::get_layout_binding_flag(binding_index));
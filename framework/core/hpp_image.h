@@ -130,6 +130,22 @@ class HPPImage : public vkb::allocated::AllocatedCpp<vk::Image>
 	HPPImage(vkb::core::DeviceCpp  &device,
 	         HPPImageBuilder const &builder);
 
+	/**
+	 * @brief Creates an image in memory meeting the given requirements, which other images can alias
+	 * @param memory_requirements Requirements covering the ones of this image and of the images aliasing its memory
+	 */
+	HPPImage(vkb::core::DeviceCpp         &device,
+	         HPPImageBuilder const        &builder,
+	         vk::MemoryRequirements const &memory_requirements);
+
+	/**
+	 * @brief Creates an image bound to the memory of another image, which keeps owning it
+	 * @param memory_owner Image created with memory requirements covering the ones of this image
+	 */
+	HPPImage(vkb::core::DeviceCpp  &device,
+	         HPPImageBuilder const &builder,
+	         HPPImage const        &memory_owner);
+
 	HPPImage(const HPPImage &) = delete;
 
 	HPPImage(HPPImage &&other) noexcept;
@@ -90,6 +90,30 @@ HPPImage::HPPImage(vkb::core::DeviceCpp &device, HPPImageBuilder const &builder)
 	}
 }
 
+HPPImage::HPPImage(vkb::core::DeviceCpp &device, HPPImageBuilder const &builder, vk::MemoryRequirements const &memory_requirements) :
+    vkb::allocated::AllocatedCpp<vk::Image>{builder.get_allocation_create_info(), nullptr, &device}, create_info{builder.get_create_info()}
+{
+	get_handle()           = create_image(create_info, memory_requirements);
+	subresource.arrayLayer = create_info.arrayLayers;
+	subresource.mipLevel   = create_info.mipLevels;
+	if (!builder.get_debug_name().empty())
+	{
+		set_debug_name(builder.get_debug_name());
+	}
+}
+
+HPPImage::HPPImage(vkb::core::DeviceCpp &device, HPPImageBuilder const &builder, HPPImage const &memory_owner) :
+    vkb::allocated::AllocatedCpp<vk::Image>{builder.get_allocation_create_info(), nullptr, &device}, create_info{builder.get_create_info()}
+{
+	get_handle()           = create_aliasing_image(create_info, memory_owner);
+	subresource.arrayLayer = create_info.arrayLayers;
+	subresource.mipLevel   = create_info.mipLevels;
+	if (!builder.get_debug_name().empty())
+	{
+		set_debug_name(builder.get_debug_name());
+	}
+}
+
 HPPImage::HPPImage(vkb::core::DeviceCpp   &device,
                    vk::Image               handle,
                    const vk::Extent3D     &extent,
@@ -18,13 +18,17 @@
 #include "hpp_pipeline_layout.h"
 #include "core/device.h"
 
+#include <optional>
+
 #include <core/hpp_shader_module.h>
 
 namespace vkb
 {
 namespace core
 {
-HPPPipelineLayout::HPPPipelineLayout(vkb::core::DeviceCpp &device, const std::vector<vkb::core::HPPShaderModule *> &shader_modules) :
+HPPPipelineLayout::HPPPipelineLayout(vkb::core::DeviceCpp                            &device,
+                                     const std::vector<vkb::core::HPPShaderModule *> &shader_modules,
+                                     vkb::DescriptorBackend                           backend) :
     device{device},
     shader_modules{shader_modules}
 {
@@ -78,11 +82,45 @@ HPPPipelineLayout::HPPPipelineLayout(vkb::core::DeviceCpp &device, const std::ve
 		}
 	}
 
+	// Pipelines bind either descriptor buffers or descriptor sets, so all the sets have to use descriptor buffers
+	if (backend == vkb::DescriptorBackend::DescriptorBuffer &&
+	    !std::ranges::all_of(shader_sets, [&device](auto const &shader_set_it) {
+		    return vkb::core::HPPDescriptorSetLayout::supports_backend(device, shader_set_it.second, vkb::DescriptorBackend::DescriptorBuffer);
+	    }))
+	{
+		backend = vkb::DescriptorBackend::Pooled;
+	}
+
+	// A single set of a pipeline layout can be pushed
+	std::optional<uint32_t> push_descriptor_set;
+	if (backend == vkb::DescriptorBackend::PushDescriptor)
+	{
+		for (auto &shader_set_it : shader_sets)
+		{
+			if ((!push_descriptor_set || shader_set_it.first < *push_descriptor_set) &&
+			    vkb::core::HPPDescriptorSetLayout::supports_backend(device, shader_set_it.second, vkb::DescriptorBackend::PushDescriptor))
+			{
+				push_descriptor_set = shader_set_it.first;
+			}
+		}
+		if (!push_descriptor_set)
+		{
+			backend = vkb::DescriptorBackend::Pooled;
+		}
+	}
+	descriptor_backend = backend;
+
 	// Create a descriptor set layout for each shader set in the shader modules
 	for (auto &shader_set_it : shader_sets)
 	{
+		vkb::DescriptorBackend set_backend = backend;
+		if (backend == vkb::DescriptorBackend::PushDescriptor && shader_set_it.first != *push_descriptor_set)
+		{
+			set_backend = vkb::DescriptorBackend::Pooled;
+		}
+
 		descriptor_set_layouts.emplace_back(
-		    &device.get_resource_cache().request_descriptor_set_layout(shader_set_it.first, shader_modules, shader_set_it.second));
+		    &device.get_resource_cache().request_descriptor_set_layout(shader_set_it.first, shader_modules, shader_set_it.second, set_backend));
 	}
 
 	// Collect all the descriptor set layout handles, maintaining set order
@@ -114,7 +152,8 @@ HPPPipelineLayout::HPPPipelineLayout(HPPPipelineLayout &&other) :
     shader_modules{std::move(other.shader_modules)},
     shader_resources{std::move(other.shader_resources)},
     shader_sets{std::move(other.shader_sets)},
-    descriptor_set_layouts{std::move(other.descriptor_set_layouts)}
+    descriptor_set_layouts{std::move(other.descriptor_set_layouts)},
+    descriptor_backend{other.descriptor_backend}
 {
 	other.handle = nullptr;
 }
@@ -128,6 +167,11 @@ HPPPipelineLayout::~HPPPipelineLayout()
 	}
 }
 
+vkb::DescriptorBackend HPPPipelineLayout::get_descriptor_backend() const
+{
+	return descriptor_backend;
+}
+
 vkb::core::HPPDescriptorSetLayout const &HPPPipelineLayout::get_descriptor_set_layout(const uint32_t set_index) const
 {
 	auto it = std::ranges::find_if(descriptor_set_layouts,
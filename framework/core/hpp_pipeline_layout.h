@@ -34,7 +34,9 @@ class HPPDescriptorSetLayout;
 class HPPPipelineLayout
 {
   public:
-	HPPPipelineLayout(vkb::core::DeviceCpp &device, const std::vector<vkb::core::HPPShaderModule *> &shader_modules);
+	HPPPipelineLayout(vkb::core::DeviceCpp                            &device,
+	                  const std::vector<vkb::core::HPPShaderModule *> &shader_modules,
+	                  vkb::DescriptorBackend                           backend = vkb::DescriptorBackend::Pooled);
 	HPPPipelineLayout(const HPPPipelineLayout &) = delete;
 	HPPPipelineLayout(HPPPipelineLayout &&other);
 	~HPPPipelineLayout();
@@ -42,6 +44,7 @@ class HPPPipelineLayout
 	HPPPipelineLayout &operator=(const HPPPipelineLayout &) = delete;
 	HPPPipelineLayout &operator=(HPPPipelineLayout &&)      = delete;
 
+	vkb::DescriptorBackend                                                         get_descriptor_backend() const;
 	vkb::core::HPPDescriptorSetLayout const                                       &get_descriptor_set_layout(const uint32_t set_index) const;
 	vk::PipelineLayout                                                             get_handle() const;
 	vk::ShaderStageFlags                                                           get_push_constant_range_stage(uint32_t size, uint32_t offset = 0) const;
@@ -58,6 +61,7 @@ class HPPPipelineLayout
 	std::unordered_map<std::string, vkb::core::HPPShaderResource>           shader_resources;              // The shader resources that this pipeline layout uses, indexed by their name
 	std::unordered_map<uint32_t, std::vector<vkb::core::HPPShaderResource>> shader_sets;                   // A map of each set and the resources it owns used by the pipeline layout
 	std::vector<vkb::core::HPPDescriptorSetLayout *>                        descriptor_set_layouts;        // The different descriptor set layouts for this pipeline layout
+	vkb::DescriptorBackend                                                  descriptor_backend = vkb::DescriptorBackend::Pooled;
 };
 }        // namespace core
 }        // namespace vkb
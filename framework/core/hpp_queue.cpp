@@ -35,7 +35,8 @@ HPPQueue::HPPQueue(HPPQueue &&other) :
     family_index(std::exchange(other.family_index, {})),
     index(std::exchange(other.index, 0)),
     can_present(std::exchange(other.can_present, false)),
-    properties(std::exchange(other.properties, {}))
+    properties(std::exchange(other.properties, {})),
+    submit_mutex(other.submit_mutex)
 {}
 
 const vkb::core::DeviceCpp &HPPQueue::get_device() const
@@ -72,6 +73,7 @@ void HPPQueue::submit(const vkb::core::CommandBufferCpp &command_buffer, vk::Fen
 {
 	vk::CommandBuffer commandBuffer = command_buffer.get_handle();
 	vk::SubmitInfo    submit_info{.commandBufferCount = 1, .pCommandBuffers = &commandBuffer};
+	auto              guard = lock();
 	handle.submit(submit_info, fence);
 }
 
@@ -82,7 +84,13 @@ vk::Result HPPQueue::present(const vk::PresentInfoKHR &present_info) const
 		return vk::Result::eErrorIncompatibleDisplayKHR;
 	}
 
+	auto guard = lock();
 	return handle.presentKHR(present_info);
 }
+
+std::unique_lock<std::mutex> HPPQueue::lock() const
+{
+	return std::unique_lock<std::mutex>(*submit_mutex);
+}
 }        // namespace core
 }        // namespace vkb
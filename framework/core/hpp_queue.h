@@ -18,6 +18,8 @@
 #pragma once
 
 #include "common/vk_common.h"
+#include <memory>
+#include <mutex>
 #include <vulkan/vulkan.hpp>
 
 namespace vkb
@@ -65,6 +67,14 @@ class HPPQueue
 
 	vk::Result present(const vk::PresentInfoKHR &present_infos) const;
 
+	/**
+	 * @brief Locks the mutex serializing host access to the queue, which Vulkan requires to be externally synchronized
+	 *
+	 * submit() and present() take the lock themselves. Code calling submit, presentKHR or waitIdle on the handle directly
+	 * while other threads may use the queue has to hold it.
+	 */
+	std::unique_lock<std::mutex> lock() const;
+
   private:
 	vkb::core::DeviceCpp &device;
 
@@ -77,6 +87,9 @@ class HPPQueue
 	vk::Bool32 can_present = false;
 
 	vk::QueueFamilyProperties properties{};
+
+	// Shared by copies of the wrapper, which refer to the same queue
+	std::shared_ptr<std::mutex> submit_mutex = std::make_shared<std::mutex>();
 };
 }        // namespace core
 }        // namespace vkb
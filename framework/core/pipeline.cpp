@@ -113,6 +113,11 @@ ComputePipeline::ComputePipeline(vkb::core::DeviceC             &device,
 	create_info.layout = pipeline_state.get_pipeline_layout().get_handle();
 	create_info.stage  = stage;
 
+	if (pipeline_state.get_pipeline_layout().get_descriptor_backend() == DescriptorBackend::DescriptorBuffer)
+	{
+		create_info.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+	}
+
 	result = vkCreateComputePipelines(device.get_handle(), pipeline_cache, 1, &create_info, nullptr, &handle);
 
 	if (result != VK_SUCCESS)
@@ -290,6 +295,11 @@ GraphicsPipeline::GraphicsPipeline(vkb::core::DeviceC             &device,
 	create_info.renderPass = pipeline_state.get_render_pass()->get_handle();
 	create_info.subpass    = pipeline_state.get_subpass_index();
 
+	if (pipeline_state.get_pipeline_layout().get_descriptor_backend() == DescriptorBackend::DescriptorBuffer)
+	{
+		create_info.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+	}
+
 	auto result = vkCreateGraphicsPipelines(device.get_handle(), pipeline_cache, 1, &create_info, nullptr, &handle);
 
 	if (result != VK_SUCCESS)
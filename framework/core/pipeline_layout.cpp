@@ -17,6 +17,8 @@
 
 #include "pipeline_layout.h"
 
+#include <optional>
+
 #include "descriptor_set_layout.h"
 #include "device.h"
 #include "pipeline.h"
@@ -25,7 +27,7 @@
 
 namespace vkb
 {
-PipelineLayout::PipelineLayout(vkb::core::DeviceC &device, const std::vector<ShaderModule *> &shader_modules) :
+PipelineLayout::PipelineLayout(vkb::core::DeviceC &device, const std::vector<ShaderModule *> &shader_modules, DescriptorBackend backend) :
     device{device},
     shader_modules{shader_modules}
 {
@@ -79,10 +81,45 @@ PipelineLayout::PipelineLayout(vkb::core::DeviceC &device, const std::vector<Sha
 		}
 	}
 
+	// Pipelines bind either descriptor buffers or descriptor sets, so all the sets have to use descriptor buffers
+	if (backend == DescriptorBackend::DescriptorBuffer &&
+	    !std::ranges::all_of(shader_sets, [&device](auto const &shader_set_it) {
+		    return DescriptorSetLayout::supports_backend(device, shader_set_it.second, DescriptorBackend::DescriptorBuffer);
+	    }))
+	{
+		backend = DescriptorBackend::Pooled;
+	}
+
+	// A single set of a pipeline layout can be pushed
+	std::optional<uint32_t> push_descriptor_set;
+	if (backend == DescriptorBackend::PushDescriptor)
+	{
+		for (auto &shader_set_it : shader_sets)
+		{
+			if ((!push_descriptor_set || shader_set_it.first < *push_descriptor_set) &&
+			    DescriptorSetLayout::supports_backend(device, shader_set_it.second, DescriptorBackend::PushDescriptor))
+			{
+				push_descriptor_set = shader_set_it.first;
+			}
+		}
+		if (!push_descriptor_set)
+		{
+			backend = DescriptorBackend::Pooled;
+		}
+	}
+	descriptor_backend = backend;
+
 	// Create a descriptor set layout for each shader set in the shader modules
 	for (auto &shader_set_it : shader_sets)
 	{
-		descriptor_set_layouts.emplace_back(&device.get_resource_cache().request_descriptor_set_layout(shader_set_it.first, shader_modules, shader_set_it.second));
+		DescriptorBackend set_backend = backend;
+		if (backend == DescriptorBackend::PushDescriptor && shader_set_it.first != *push_descriptor_set)
+		{
+			set_backend = DescriptorBackend::Pooled;
+		}
+
+		descriptor_set_layouts.emplace_back(
+		    &device.get_resource_cache().request_descriptor_set_layout(shader_set_it.first, shader_modules, shader_set_it.second, set_backend));
 	}
 
 	// Collect all the descriptor set layout handles, maintaining set order
@@ -128,7 +165,8 @@ PipelineLayout::PipelineLayout(PipelineLayout &&other) :
     shader_modules{std::move(other.shader_modules)},
     shader_resources{std::move(other.shader_resources)},
     shader_sets{std::move(other.shader_sets)},
-    descriptor_set_layouts{std::move(other.descriptor_set_layouts)}
+    descriptor_set_layouts{std::move(other.descriptor_set_layouts)},
+    descriptor_backend{other.descriptor_backend}
 {
 	other.handle = VK_NULL_HANDLE;
 }
@@ -194,6 +232,11 @@ DescriptorSetLayout &PipelineLayout::get_descriptor_set_layout(const uint32_t se
 	throw std::runtime_error("Couldn't find descriptor set layout at set index " + to_string(set_index));
 }
 
+DescriptorBackend PipelineLayout::get_descriptor_backend() const
+{
+	return descriptor_backend;
+}
+
 VkShaderStageFlags PipelineLayout::get_push_constant_range_stage(uint32_t size, uint32_t offset) const
 {
 	VkShaderStageFlags stages = 0;
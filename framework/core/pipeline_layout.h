@@ -30,7 +30,14 @@ class DescriptorSetLayout;
 class PipelineLayout
 {
   public:
-	PipelineLayout(vkb::core::DeviceC &device, const std::vector<ShaderModule *> &shader_modules);
+	/**
+	 * @brief Creates a pipeline layout, with the descriptor set layouts of the resources of its shader modules
+	 * @param device A valid Vulkan device
+	 * @param shader_modules The shader modules of the pipelines using the layout
+	 * @param backend The preferred descriptor backend. Descriptor buffers are only used if all the sets can use them,
+	 *        push descriptors for the first set which can be pushed. The other sets are pooled.
+	 */
+	PipelineLayout(vkb::core::DeviceC &device, const std::vector<ShaderModule *> &shader_modules, DescriptorBackend backend = DescriptorBackend::Pooled);
 
 	PipelineLayout(const PipelineLayout &) = delete;
 
@@ -56,6 +63,11 @@ class PipelineLayout
 
 	VkShaderStageFlags get_push_constant_range_stage(uint32_t size, uint32_t offset = 0) const;
 
+	/**
+	 * @return DescriptorBuffer if the sets use descriptor buffers, PushDescriptor if a set is pushed, Pooled otherwise
+	 */
+	DescriptorBackend get_descriptor_backend() const;
+
   private:
 	vkb::core::DeviceC &device;
 
@@ -72,5 +84,7 @@ class PipelineLayout
 
 	// The different descriptor set layouts for this pipeline layout
 	std::vector<DescriptorSetLayout *> descriptor_set_layouts;
+
+	DescriptorBackend descriptor_backend{DescriptorBackend::Pooled};
 };
 }        // namespace vkb
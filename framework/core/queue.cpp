@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -34,7 +34,8 @@ Queue::Queue(Queue &&other) :
     family_index{other.family_index},
     index{other.index},
     can_present{other.can_present},
-    properties{other.properties}
+    properties{other.properties},
+    submit_mutex{other.submit_mutex}
 {
 	other.handle       = VK_NULL_HANDLE;
 	other.family_index = {};
@@ -75,6 +76,7 @@ VkBool32 Queue::support_present() const
 
 VkResult Queue::submit(const std::vector<VkSubmitInfo> &submit_infos, VkFence fence) const
 {
+	auto guard = lock();
 	return vkQueueSubmit(handle, to_u32(submit_infos.size()), submit_infos.data(), fence);
 }
 
@@ -94,11 +96,18 @@ VkResult Queue::present(const VkPresentInfoKHR &present_info) const
 		return VK_ERROR_INCOMPATIBLE_DISPLAY_KHR;
 	}
 
+	auto guard = lock();
 	return vkQueuePresentKHR(handle, &present_info);
 }        // namespace vkb
 
 VkResult Queue::wait_idle() const
 {
+	auto guard = lock();
 	return vkQueueWaitIdle(handle);
 }
+
+std::unique_lock<std::mutex> Queue::lock() const
+{
+	return std::unique_lock<std::mutex>(*submit_mutex);
+}
 }        // namespace vkb
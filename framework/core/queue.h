@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -21,6 +21,9 @@
 #include "common/vk_common.h"
 #include "core/swapchain.h"
 
+#include <memory>
+#include <mutex>
+
 namespace vkb
 {
 
@@ -64,6 +67,14 @@ class Queue
 
 	VkResult wait_idle() const;
 
+	/**
+	 * @brief Locks the mutex serializing host access to the queue, which Vulkan requires to be externally synchronized
+	 *
+	 * submit(), present() and wait_idle() take the lock themselves. Code calling vkQueueSubmit, vkQueuePresentKHR or
+	 * vkQueueWaitIdle on the handle directly while other threads may use the queue has to hold it.
+	 */
+	std::unique_lock<std::mutex> lock() const;
+
   private:
 	vkb::core::DeviceC &device;
 
@@ -76,5 +87,8 @@ class Queue
 	VkBool32 can_present{VK_FALSE};
 
 	VkQueueFamilyProperties properties{};
+
+	// Shared by copies of the wrapper, which refer to the same queue
+	std::shared_ptr<std::mutex> submit_mutex = std::make_shared<std::mutex>();
 };
 }        // namespace vkb
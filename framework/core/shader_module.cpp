@@ -17,6 +17,7 @@
 
 #include "shader_module.h"
 
+#include "common/content_hash.h"
 #include "core/util/logging.hpp"
 #include "device.h"
 #include "filesystem/legacy.h"
@@ -46,9 +47,9 @@ ShaderModule::ShaderModule(vkb::core::DeviceC   &device,
 	}
 
 	// Generate a unique id, determined by source and variant
-	std::hash<std::string> hasher{};
-	id = hasher(std::string{reinterpret_cast<const char *>(spirv.data()),
-	                        reinterpret_cast<const char *>(spirv.data() + spirv.size())});
+	vkb::ContentHasher hasher;
+	hasher.update_values(std::span<const uint32_t>{spirv});
+	id = static_cast<size_t>(hasher.digest64());
 }
 
 ShaderModule::ShaderModule(ShaderModule &&other) :
@@ -153,8 +154,7 @@ ShaderSource::ShaderSource(const std::string &filename) :
     filename{filename},
     source{fs::read_text_file(filename)}
 {
-	std::hash<std::string> hasher{};
-	id = hasher(std::string{this->source.cbegin(), this->source.cend()});
+	id = static_cast<size_t>(content_hash64(this->source));
 }
 
 size_t ShaderSource::get_id() const
@@ -170,8 +170,7 @@ const std::string &ShaderSource::get_filename() const
 void ShaderSource::set_source(const std::string &source_)
 {
 	source = source_;
-	std::hash<std::string> hasher{};
-	id = hasher(std::string{this->source.cbegin(), this->source.cend()});
+	id = static_cast<size_t>(content_hash64(this->source));
 }
 
 const std::string &ShaderSource::get_source() const
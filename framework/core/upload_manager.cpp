@@ -0,0 +1,514 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/upload_manager.h"
+
+#include <cstring>
+
+#include "core/buffer.h"
+#include "core/device.h"
+
+namespace vkb
+{
+namespace core
+{
+namespace
+{
+// Uploaded images are sampled by the shaders of later draws and dispatches
+constexpr vk::PipelineStageFlags IMAGE_READ_STAGES =
+    vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader;
+}        // namespace
+
+UploadManager::UploadManager(vkb::core::DeviceCpp &device, vk::DeviceSize staging_size, bool use_transfer_queue) :
+    device{device}
+{
+	auto const &queue     = device.get_queue_by_flags(vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute, 0);
+	graphics_queue        = &queue;
+	graphics_family_index = queue.get_family_index();
+
+	if (use_transfer_queue)
+	{
+		// A queue family without graphics and compute is usually backed by a copy engine running alongside the graphics queue
+		auto const &queue_family_properties = device.get_gpu().get_queue_family_properties();
+		for (uint32_t family_index = 0; family_index < queue_family_properties.size(); ++family_index)
+		{
+			auto const &properties = queue_family_properties[family_index];
+			if ((properties.queueFlags & vk::QueueFlagBits::eTransfer) &&
+			    !(properties.queueFlags & (vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute)) && properties.queueCount > 0)
+			{
+				transfer_queue        = &device.get_queue(family_index, 0);
+				transfer_family_index = family_index;
+				break;
+			}
+		}
+	}
+
+	vk::Device handle = device.get_handle();
+
+	graphics_command_pool = handle.createCommandPool(
+	    {.flags = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer, .queueFamilyIndex = graphics_family_index});
+	if (transfer_queue)
+	{
+		transfer_command_pool = handle.createCommandPool(
+		    {.flags = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer, .queueFamilyIndex = transfer_family_index});
+	}
+
+	if (device.is_timeline_semaphore_enabled())
+	{
+		vk::SemaphoreTypeCreateInfo semaphore_type_info{.semaphoreType = vk::SemaphoreType::eTimeline, .initialValue = 0};
+		timeline_semaphore = handle.createSemaphore({.pNext = &semaphore_type_info});
+	}
+
+	staging_alignment = std::max<vk::DeviceSize>(staging_alignment, device.get_gpu().get_properties().limits.optimalBufferCopyOffsetAlignment);
+
+	staging_buffer = std::make_unique<vkb::core::BufferCpp>(vkb::core::BufferCpp::create_staging_buffer(device, staging_size, nullptr));
+	staging_buffer->set_debug_name("Upload staging ring");
+	staging_data = staging_buffer->map();
+
+	LOGI("Upload manager: {} MB staging ring, {}, {} completion",
+	     staging_size / (1024 * 1024),
+	     transfer_queue ? "dedicated transfer queue" : "graphics queue",
+	     timeline_semaphore ? "timeline semaphore" : "fence");
+}
+
+UploadManager::~UploadManager()
+{
+	wait_idle();
+
+	vk::Device handle = device.get_handle();
+
+	for (auto semaphore : free_semaphores)
+	{
+		handle.destroySemaphore(semaphore);
+	}
+	for (auto fence : free_fences)
+	{
+		handle.destroyFence(fence);
+	}
+	if (timeline_semaphore)
+	{
+		handle.destroySemaphore(timeline_semaphore);
+	}
+
+	// Destroying the pools frees their command buffers
+	handle.destroyCommandPool(graphics_command_pool);
+	if (transfer_command_pool)
+	{
+		handle.destroyCommandPool(transfer_command_pool);
+	}
+
+	staging_buffer.reset();
+}
+
+UploadToken UploadManager::upload_buffer(const void *data, vk::DeviceSize size, vk::Buffer buffer, vk::DeviceSize offset)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto [staging, staging_offset] = stage(data, size);
+
+	begin_batch();
+
+	pending.copy_command_buffer.copyBuffer(staging, buffer, vk::BufferCopy{.srcOffset = staging_offset, .dstOffset = offset, .size = size});
+
+	if (transfer_queue)
+	{
+		// Release the range to the graphics queue family, which acquires it in the same batch
+		vk::BufferMemoryBarrier barrier{.srcAccessMask       = vk::AccessFlagBits::eTransferWrite,
+		                                .srcQueueFamilyIndex = transfer_family_index,
+		                                .dstQueueFamilyIndex = graphics_family_index,
+		                                .buffer              = buffer,
+		                                .offset              = offset,
+		                                .size                = size};
+		pending.copy_command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, {}, {}, barrier, {});
+
+		barrier.srcAccessMask = {};
+		barrier.dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite;
+		pending.acquire_command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eAllCommands, {}, {}, barrier, {});
+	}
+
+	return {pending.value};
+}
+
+UploadToken UploadManager::upload_buffer(const void *data, VkDeviceSize size, VkBuffer buffer, VkDeviceSize offset)
+{
+	return upload_buffer(data, static_cast<vk::DeviceSize>(size), static_cast<vk::Buffer>(buffer), static_cast<vk::DeviceSize>(offset));
+}
+
+UploadToken UploadManager::upload_image(const void                          *data,
+                                        vk::DeviceSize                       size,
+                                        vk::Image                            image,
+                                        std::span<const vk::BufferImageCopy> regions,
+                                        vk::ImageSubresourceRange const     &subresource_range,
+                                        vk::ImageLayout                      final_layout)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto [staging, staging_offset] = stage(data, size);
+
+	begin_batch();
+
+	std::vector<vk::BufferImageCopy> staging_regions(regions.begin(), regions.end());
+	for (auto &region : staging_regions)
+	{
+		region.bufferOffset += staging_offset;
+	}
+
+	vk::ImageMemoryBarrier barrier{.dstAccessMask       = vk::AccessFlagBits::eTransferWrite,
+	                               .oldLayout           = vk::ImageLayout::eUndefined,
+	                               .newLayout           = vk::ImageLayout::eTransferDstOptimal,
+	                               .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	                               .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	                               .image               = image,
+	                               .subresourceRange    = subresource_range};
+	pending.copy_command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrier);
+
+	pending.copy_command_buffer.copyBufferToImage(staging, image, vk::ImageLayout::eTransferDstOptimal, staging_regions);
+
+	barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+	barrier.oldLayout     = vk::ImageLayout::eTransferDstOptimal;
+	barrier.newLayout     = final_layout;
+
+	if (transfer_queue)
+	{
+		// The layout transition is part of the ownership transfer, so both halves carry it
+		barrier.dstAccessMask       = {};
+		barrier.srcQueueFamilyIndex = transfer_family_index;
+		barrier.dstQueueFamilyIndex = graphics_family_index;
+		pending.copy_command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, {}, {}, {}, barrier);
+
+		barrier.srcAccessMask = {};
+		barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+		pending.acquire_command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, IMAGE_READ_STAGES, {}, {}, {}, barrier);
+	}
+	else
+	{
+		barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+		pending.copy_command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, IMAGE_READ_STAGES, {}, {}, {}, barrier);
+	}
+
+	return {pending.value};
+}
+
+UploadToken UploadManager::upload_image(const void                        *data,
+                                        VkDeviceSize                       size,
+                                        VkImage                            image,
+                                        std::span<const VkBufferImageCopy> regions,
+                                        VkImageSubresourceRange const     &subresource_range,
+                                        VkImageLayout                      final_layout)
+{
+	return upload_image(data,
+	                    static_cast<vk::DeviceSize>(size),
+	                    static_cast<vk::Image>(image),
+	                    std::span<const vk::BufferImageCopy>(reinterpret_cast<vk::BufferImageCopy const *>(regions.data()), regions.size()),
+	                    reinterpret_cast<vk::ImageSubresourceRange const &>(subresource_range),
+	                    static_cast<vk::ImageLayout>(final_layout));
+}
+
+UploadToken UploadManager::flush()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	return submit_batch();
+}
+
+bool UploadManager::is_complete(UploadToken token)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	return token.value <= retire_batches();
+}
+
+void UploadManager::wait(UploadToken token)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (!pending.empty() && pending.value <= token.value)
+	{
+		submit_batch();
+	}
+
+	wait_value(token.value);
+}
+
+void UploadManager::wait_idle()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	submit_batch();
+
+	if (!in_flight.empty())
+	{
+		wait_value(in_flight.back().value);
+	}
+}
+
+vk::Semaphore UploadManager::get_timeline_semaphore() const
+{
+	return timeline_semaphore;
+}
+
+bool UploadManager::uses_transfer_queue() const
+{
+	return transfer_queue != nullptr;
+}
+
+std::pair<vk::Buffer, vk::DeviceSize> UploadManager::stage(const void *data, vk::DeviceSize size)
+{
+	vk::DeviceSize capacity = staging_buffer->get_size();
+
+	if (size > capacity)
+	{
+		auto       buffer = std::make_unique<vkb::core::BufferCpp>(vkb::core::BufferCpp::create_staging_buffer(device, size, data));
+		vk::Buffer handle = buffer->get_handle();
+		pending.dedicated_staging_buffers.push_back(std::move(buffer));
+		return {handle, 0};
+	}
+
+	while (true)
+	{
+		// The ring is used in submission order, so the free space is the range following the head
+		vk::DeviceSize offset = (staging_head + staging_alignment - 1) / staging_alignment * staging_alignment;
+		if (offset + size > capacity)
+		{
+			// Wrap around, the end of the ring is lost until the batch completes
+			offset = 0;
+		}
+		vk::DeviceSize used = (offset >= staging_head ? offset - staging_head : capacity - staging_head) + size;
+
+		if (staging_in_use + used <= capacity)
+		{
+			std::memcpy(staging_data + offset, data, size);
+			staging_buffer->flush(offset, size);
+
+			staging_head = offset + size;
+			staging_in_use += used;
+			pending.staging_bytes += used;
+
+			return {staging_buffer->get_handle(), offset};
+		}
+
+		// Make room, by submitting the pending batch once it is the only one left, and waiting for the oldest batch
+		if (in_flight.empty())
+		{
+			submit_batch();
+		}
+		if (!in_flight.empty())
+		{
+			wait_value(in_flight.front().value);
+		}
+	}
+}
+
+void UploadManager::begin_batch()
+{
+	if (!pending.empty())
+	{
+		return;
+	}
+
+	pending.value = next_value++;
+
+	if (transfer_queue)
+	{
+		pending.copy_command_buffer    = request_command_buffer(transfer_command_pool, free_transfer_command_buffers);
+		pending.acquire_command_buffer = request_command_buffer(graphics_command_pool, free_graphics_command_buffers);
+		pending.acquire_command_buffer.begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+	}
+	else
+	{
+		pending.copy_command_buffer = request_command_buffer(graphics_command_pool, free_graphics_command_buffers);
+	}
+
+	pending.copy_command_buffer.begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+}
+
+UploadToken UploadManager::submit_batch()
+{
+	if (pending.empty())
+	{
+		// Every batch with a value is submitted
+		return {next_value - 1};
+	}
+
+	Batch batch = std::move(pending);
+	pending     = {};
+
+	vk::PipelineStageFlags wait_stage = vk::PipelineStageFlagBits::eAllCommands;
+
+	vk::SubmitInfo submit_info;
+
+	if (transfer_queue)
+	{
+		batch.copy_command_buffer.end();
+		batch.acquire_command_buffer.end();
+
+		if (free_semaphores.empty())
+		{
+			batch.ownership_semaphore = device.get_handle().createSemaphore({});
+		}
+		else
+		{
+			batch.ownership_semaphore = free_semaphores.back();
+			free_semaphores.pop_back();
+		}
+
+		vk::SubmitInfo copy_submit_info{.commandBufferCount   = 1,
+		                                .pCommandBuffers      = &batch.copy_command_buffer,
+		                                .signalSemaphoreCount = 1,
+		                                .pSignalSemaphores    = &batch.ownership_semaphore};
+		auto guard = transfer_queue->lock();
+		transfer_queue->get_handle().submit(copy_submit_info);
+
+		submit_info.setWaitSemaphores(batch.ownership_semaphore);
+		submit_info.setWaitDstStageMask(wait_stage);
+		submit_info.setCommandBuffers(batch.acquire_command_buffer);
+	}
+	else
+	{
+		// Make the copies visible to all later commands on the queue
+		vk::MemoryBarrier barrier{.srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+		                          .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite};
+		batch.copy_command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, {}, barrier, {}, {});
+		batch.copy_command_buffer.end();
+
+		submit_info.setCommandBuffers(batch.copy_command_buffer);
+	}
+
+	vk::TimelineSemaphoreSubmitInfo timeline_submit_info{.signalSemaphoreValueCount = 1, .pSignalSemaphoreValues = &batch.value};
+	if (timeline_semaphore)
+	{
+		submit_info.setPNext(&timeline_submit_info);
+		submit_info.setSignalSemaphores(timeline_semaphore);
+	}
+	else if (free_fences.empty())
+	{
+		batch.fence = device.get_handle().createFence({});
+	}
+	else
+	{
+		batch.fence = free_fences.back();
+		free_fences.pop_back();
+	}
+
+	{
+		// Loader threads upload while the render thread submits frames to the same queue
+		auto guard = graphics_queue->lock();
+		graphics_queue->get_handle().submit(submit_info, batch.fence);
+	}
+
+	in_flight.push_back(std::move(batch));
+
+	return {in_flight.back().value};
+}
+
+uint64_t UploadManager::retire_batches()
+{
+	vk::Device handle = device.get_handle();
+
+	if (timeline_semaphore)
+	{
+		completed_value = handle.getSemaphoreCounterValue(timeline_semaphore);
+	}
+
+	while (!in_flight.empty())
+	{
+		auto &batch = in_flight.front();
+
+		if (timeline_semaphore ? batch.value > completed_value : handle.getFenceStatus(batch.fence) != vk::Result::eSuccess)
+		{
+			break;
+		}
+
+		completed_value = std::max(completed_value, batch.value);
+
+		if (transfer_queue)
+		{
+			free_transfer_command_buffers.push_back(batch.copy_command_buffer);
+			free_graphics_command_buffers.push_back(batch.acquire_command_buffer);
+			free_semaphores.push_back(batch.ownership_semaphore);
+		}
+		else
+		{
+			free_graphics_command_buffers.push_back(batch.copy_command_buffer);
+		}
+
+		if (batch.fence)
+		{
+			handle.resetFences(batch.fence);
+			free_fences.push_back(batch.fence);
+		}
+
+		staging_in_use -= batch.staging_bytes;
+
+		in_flight.pop_front();
+	}
+
+	if (staging_in_use == 0)
+	{
+		staging_head = 0;
+	}
+
+	return completed_value;
+}
+
+void UploadManager::wait_value(uint64_t value)
+{
+	if (value <= retire_batches())
+	{
+		return;
+	}
+
+	vk::Result result;
+	if (timeline_semaphore)
+	{
+		vk::SemaphoreWaitInfo wait_info{.semaphoreCount = 1, .pSemaphores = &timeline_semaphore, .pValues = &value};
+		result = device.get_handle().waitSemaphores(wait_info, DEFAULT_FENCE_TIMEOUT);
+	}
+	else
+	{
+		std::vector<vk::Fence> fences;
+		for (auto &batch : in_flight)
+		{
+			if (batch.value <= value)
+			{
+				fences.push_back(batch.fence);
+			}
+		}
+		result = device.get_handle().waitForFences(fences, true, DEFAULT_FENCE_TIMEOUT);
+	}
+
+	if (result != vk::Result::eSuccess)
+	{
+		throw VulkanException(static_cast<VkResult>(result), "Failed to wait for uploads");
+	}
+
+	retire_batches();
+}
+
+vk::CommandBuffer UploadManager::request_command_buffer(vk::CommandPool pool, std::vector<vk::CommandBuffer> &free_command_buffers)
+{
+	if (!free_command_buffers.empty())
+	{
+		vk::CommandBuffer command_buffer = free_command_buffers.back();
+		free_command_buffers.pop_back();
+		return command_buffer;
+	}
+
+	return device.get_handle().allocateCommandBuffers({.commandPool = pool, .level = vk::CommandBufferLevel::ePrimary, .commandBufferCount = 1}).front();
+}
+}        // namespace core
+}        // namespace vkb
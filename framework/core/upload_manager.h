@@ -0,0 +1,259 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "common/vk_common.h"
+#include <vulkan/vulkan.hpp>
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class Buffer;
+using BufferCpp = Buffer<vkb::BindingType::Cpp>;
+
+template <vkb::BindingType bindingType>
+class Device;
+using DeviceCpp = Device<vkb::BindingType::Cpp>;
+
+class HPPQueue;
+
+/**
+ * @brief Completion token of an upload, which can be polled or waited on with the UploadManager that returned it
+ *
+ * Tokens are increasing values of the upload timeline. A default constructed token refers to no upload and is always complete.
+ */
+struct UploadToken
+{
+	uint64_t value = 0;
+
+	explicit operator bool() const
+	{
+		return value != 0;
+	}
+};
+
+/**
+ * @brief Device-wide upload service, which copies host data into buffers and images through a persistently mapped staging ring
+ *
+ * Uploads are recorded into a pending batch, which is submitted on flush(), or earlier if the staging ring runs out of space.
+ * Each upload returns the token of its batch, so callers can batch any number of uploads and wait once.
+ * Uploads larger than the staging ring use a dedicated staging buffer, kept alive until the batch completes.
+ *
+ * If the device has a queue family dedicated to transfers, the copies run on it and the ownership of the destinations is
+ * transferred to the graphics queue family, which is where the batch completes. Otherwise the copies run on the graphics queue.
+ *
+ * Completion is tracked with a timeline semaphore if the timelineSemaphore feature is enabled on the device, and with a fence
+ * per batch otherwise. The destinations are made visible to all later commands on the graphics queue, and images are left
+ * in the requested layout.
+ */
+class UploadManager
+{
+  public:
+	/**
+	 * @brief Creates the upload manager
+	 * @param device The device to upload to
+	 * @param staging_size Size of the staging ring in bytes
+	 * @param use_transfer_queue Whether to copy on a dedicated transfer queue family, if the device has one
+	 */
+	UploadManager(vkb::core::DeviceCpp &device, vk::DeviceSize staging_size = 64 * 1024 * 1024, bool use_transfer_queue = true);
+
+	UploadManager(const UploadManager &) = delete;
+
+	UploadManager(UploadManager &&) = delete;
+
+	~UploadManager();
+
+	UploadManager &operator=(const UploadManager &) = delete;
+
+	UploadManager &operator=(UploadManager &&) = delete;
+
+	/**
+	 * @brief Records the copy of host data into a buffer
+	 * @param data Data to copy
+	 * @param size Size of the data in bytes
+	 * @param buffer Destination buffer, which needs the transfer destination usage
+	 * @param offset Byte offset into the destination buffer
+	 * @return The token of the batch holding the copy
+	 */
+	UploadToken upload_buffer(const void *data, vk::DeviceSize size, vk::Buffer buffer, vk::DeviceSize offset = 0);
+
+	UploadToken upload_buffer(const void *data, VkDeviceSize size, VkBuffer buffer, VkDeviceSize offset = 0);
+
+	/**
+	 * @brief Records the copy of host data into an image, whose whole content is replaced
+	 * @param data Data to copy
+	 * @param size Size of the data in bytes
+	 * @param image Destination image, which needs the transfer destination usage
+	 * @param regions Copy regions, with buffer offsets relative to the data
+	 * @param subresource_range Subresources of the image written by the regions
+	 * @param final_layout Layout of the image once the upload completes
+	 * @return The token of the batch holding the copy
+	 */
+	UploadToken upload_image(const void                          *data,
+	                         vk::DeviceSize                       size,
+	                         vk::Image                            image,
+	                         std::span<const vk::BufferImageCopy> regions,
+	                         vk::ImageSubresourceRange const     &subresource_range,
+	                         vk::ImageLayout                      final_layout = vk::ImageLayout::eShaderReadOnlyOptimal);
+
+	UploadToken upload_image(const void                       *data,
+	                         VkDeviceSize                      size,
+	                         VkImage                           image,
+	                         std::span<const VkBufferImageCopy> regions,
+	                         VkImageSubresourceRange const    &subresource_range,
+	                         VkImageLayout                     final_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+	/**
+	 * @brief Submits the pending batch
+	 * @return The token of the submitted batch, or of the last submitted batch if nothing was pending
+	 */
+	UploadToken flush();
+
+	/**
+	 * @return True if all uploads up to the token have completed, without blocking
+	 */
+	bool is_complete(UploadToken token);
+
+	/**
+	 * @brief Blocks until all uploads up to the token have completed, flushing the pending batch first if it holds the token
+	 */
+	void wait(UploadToken token);
+
+	/**
+	 * @brief Submits the pending batch and waits for all uploads
+	 */
+	void wait_idle();
+
+	/**
+	 * @return The timeline semaphore signaled with the token values, or a null handle if timeline semaphores are not enabled
+	 *
+	 * Can be waited on by other submissions, instead of waiting on the host.
+	 */
+	vk::Semaphore get_timeline_semaphore() const;
+
+	/**
+	 * @return True if the copies run on a dedicated transfer queue family
+	 */
+	bool uses_transfer_queue() const;
+
+  private:
+	struct Batch
+	{
+		uint64_t value = 0;
+
+		// Records the copies, on the transfer queue if there is one
+		vk::CommandBuffer copy_command_buffer;
+
+		// Acquires the ownership of the destinations on the graphics queue, only with a transfer queue
+		vk::CommandBuffer acquire_command_buffer;
+
+		// Orders the acquire after the copies, only with a transfer queue
+		vk::Semaphore ownership_semaphore;
+
+		// Completion of the batch, only without timeline semaphores
+		vk::Fence fence;
+
+		// Bytes of the staging ring used by the batch, including alignment padding
+		vk::DeviceSize staging_bytes = 0;
+
+		std::vector<std::unique_ptr<vkb::core::BufferCpp>> dedicated_staging_buffers;
+
+		bool empty() const
+		{
+			return !copy_command_buffer;
+		}
+	};
+
+	/**
+	 * @brief Copies data into the staging ring, or into a dedicated staging buffer if it does not fit
+	 * @return The staging buffer and the offset of the data in it
+	 */
+	std::pair<vk::Buffer, vk::DeviceSize> stage(const void *data, vk::DeviceSize size);
+
+	/**
+	 * @brief Starts recording the pending batch, if it isn't already
+	 */
+	void begin_batch();
+
+	UploadToken submit_batch();
+
+	/**
+	 * @brief Queries the completed timeline value and recycles the completed batches
+	 */
+	uint64_t retire_batches();
+
+	void wait_value(uint64_t value);
+
+	vk::CommandBuffer request_command_buffer(vk::CommandPool pool, std::vector<vk::CommandBuffer> &free_command_buffers);
+
+	vkb::core::DeviceCpp &device;
+
+	std::mutex mutex;
+
+	HPPQueue const *graphics_queue = nullptr;
+
+	uint32_t graphics_family_index = 0;
+
+	HPPQueue const *transfer_queue = nullptr;
+
+	uint32_t transfer_family_index = 0;
+
+	vk::CommandPool graphics_command_pool;
+
+	vk::CommandPool transfer_command_pool;
+
+	std::vector<vk::CommandBuffer> free_graphics_command_buffers;
+
+	std::vector<vk::CommandBuffer> free_transfer_command_buffers;
+
+	std::vector<vk::Semaphore> free_semaphores;
+
+	std::vector<vk::Fence> free_fences;
+
+	vk::Semaphore timeline_semaphore;
+
+	std::unique_ptr<vkb::core::BufferCpp> staging_buffer;
+
+	uint8_t *staging_data = nullptr;
+
+	vk::DeviceSize staging_alignment = 16;
+
+	// Next write position in the staging ring
+	vk::DeviceSize staging_head = 0;
+
+	// Bytes of the staging ring used by the pending and in-flight batches
+	vk::DeviceSize staging_in_use = 0;
+
+	Batch pending;
+
+	std::deque<Batch> in_flight;
+
+	uint64_t next_value = 1;
+
+	uint64_t completed_value = 0;
+};
+}        // namespace core
+}        // namespace vkb
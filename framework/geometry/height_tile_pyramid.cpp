@@ -0,0 +1,503 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "height_tile_pyramid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <ktx.h>
+
+#include "common/error.h"
+#include "core/util/logging.hpp"
+#include "filesystem/legacy.h"
+
+#include <filesystem/filesystem.hpp>
+
+namespace vkb
+{
+namespace
+{
+constexpr uint32_t TILE_FILE_VERSION = 1;
+
+constexpr uint32_t TILE_FILE_MAGIC = 0x534c5448;        // "HTLS"
+
+struct TileFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t dimension;
+	uint32_t tile_size;
+	uint32_t level_count;
+};
+
+uint64_t count_tiles(uint32_t level_count)
+{
+	// The coarsest level has a single tile, each finer level four times as many
+	uint64_t count = 0;
+	for (uint32_t level = 0; level < level_count; ++level)
+	{
+		count += uint64_t(1) << (2 * level);
+	}
+	return count;
+}
+
+// Number of heightmap rows read from the heightmap file at once
+constexpr uint32_t STRIP_ROWS = 64;
+
+/**
+ * @brief Writes the tiles of every level as the rows of the heightmap arrive
+ *        Each level only keeps the rows spanned by a row of tiles, the rows of the next level are averaged from pairs
+ *        of rows as they arrive, and a row of tiles is written once its last row, including the border, is known
+ */
+class TileFileWriter
+{
+  public:
+	TileFileWriter(std::ofstream &file, size_t tiles_offset, uint32_t dimension, uint32_t tile_size, uint32_t level_count) :
+	    file{file}, tiles_offset{tiles_offset}, tile_size{tile_size}, stride{tile_size + 1 + 2 * HeightTilePyramid::TILE_BORDER}, height_ranges(count_tiles(level_count))
+	{
+		uint64_t first_tile = 0;
+		for (uint32_t level = 0; level < level_count; ++level)
+		{
+			uint32_t level_dimension = dimension >> level;
+			levels.push_back({level_dimension, first_tile, std::vector<uint16_t>(static_cast<size_t>(stride) * level_dimension), std::vector<uint16_t>(level_dimension / 2)});
+			first_tile += uint64_t(1) << (2 * (level_count - 1 - level));
+		}
+		tile_samples.resize(static_cast<size_t>(stride) * stride);
+	}
+
+	void push_row(uint32_t level, uint32_t y, const uint16_t *samples)
+	{
+		Level &current = levels[level];
+		std::copy_n(samples, current.dimension, &current.rows[static_cast<size_t>(y % stride) * current.dimension]);
+
+		// Rows past the last one are clamped, so the last row of tiles is complete with the last row of the level
+		uint32_t tiles_per_side = current.dimension / tile_size;
+		while (current.next_tile_row < tiles_per_side &&
+		       y >= std::min(current.next_tile_row * tile_size + tile_size + HeightTilePyramid::TILE_BORDER, current.dimension - 1))
+		{
+			write_tile_row(level, current.next_tile_row++);
+		}
+
+		// Each sample of the next level is the average of four samples of this level
+		if (y % 2 == 1 && level + 1 < levels.size())
+		{
+			const uint16_t *previous_row = &current.rows[static_cast<size_t>((y - 1) % stride) * current.dimension];
+			const uint16_t *row          = &current.rows[static_cast<size_t>(y % stride) * current.dimension];
+			for (uint32_t x = 0; x < current.dimension / 2; ++x)
+			{
+				uint32_t sum        = previous_row[2 * x] + previous_row[2 * x + 1] + row[2 * x] + row[2 * x + 1];
+				current.next_row[x] = static_cast<uint16_t>((sum + 2) / 4);
+			}
+			push_row(level + 1, y / 2, current.next_row.data());
+		}
+	}
+
+	const std::vector<glm::u16vec2> &get_height_ranges() const
+	{
+		return height_ranges;
+	}
+
+  private:
+	struct Level
+	{
+		uint32_t dimension = 0;
+
+		uint64_t first_tile = 0;
+
+		// The last rows of the level, row y is stored at y % stride
+		std::vector<uint16_t> rows;
+
+		// Row of the next level being averaged
+		std::vector<uint16_t> next_row;
+
+		uint32_t next_tile_row = 0;
+	};
+
+	void write_tile_row(uint32_t level, uint32_t tile_y)
+	{
+		const Level &current        = levels[level];
+		int32_t      last_sample    = static_cast<int32_t>(current.dimension) - 1;
+		uint32_t     tiles_per_side = current.dimension / tile_size;
+		size_t       tile_bytes     = tile_samples.size() * sizeof(uint16_t);
+
+		for (uint32_t tile_x = 0; tile_x < tiles_per_side; ++tile_x)
+		{
+			glm::u16vec2 range{UINT16_MAX, 0};
+			for (uint32_t y = 0; y < stride; ++y)
+			{
+				// Samples outside of the heightmap are clamped to its edges
+				int32_t         source_y = std::clamp(static_cast<int32_t>(tile_y * tile_size + y) - static_cast<int32_t>(HeightTilePyramid::TILE_BORDER), 0, last_sample);
+				const uint16_t *row      = &current.rows[static_cast<size_t>(source_y % stride) * current.dimension];
+				for (uint32_t x = 0; x < stride; ++x)
+				{
+					int32_t  source_x = std::clamp(static_cast<int32_t>(tile_x * tile_size + x) - static_cast<int32_t>(HeightTilePyramid::TILE_BORDER), 0, last_sample);
+					uint16_t sample   = row[source_x];
+
+					tile_samples[y * stride + x] = sample;
+					if (x >= HeightTilePyramid::TILE_BORDER && x <= HeightTilePyramid::TILE_BORDER + tile_size &&
+					    y >= HeightTilePyramid::TILE_BORDER && y <= HeightTilePyramid::TILE_BORDER + tile_size)
+					{
+						range = {std::min(range.x, sample), std::max(range.y, sample)};
+					}
+				}
+			}
+
+			uint64_t index       = current.first_tile + static_cast<uint64_t>(tile_y) * tiles_per_side + tile_x;
+			height_ranges[index] = range;
+			file.seekp(tiles_offset + index * tile_bytes);
+			file.write(reinterpret_cast<const char *>(tile_samples.data()), tile_bytes);
+		}
+	}
+
+	std::ofstream &file;
+
+	size_t tiles_offset = 0;
+
+	uint32_t tile_size = 0;
+
+	uint32_t stride = 0;
+
+	std::vector<Level> levels;
+
+	std::vector<uint16_t> tile_samples;
+
+	// Minimum and maximum height of each tile, indexed like the tiles of the tile file
+	std::vector<glm::u16vec2> height_ranges;
+};
+}        // namespace
+
+void HeightTilePyramid::create_tile_file(const std::string &heightmap_file, const std::filesystem::path &tile_file, uint32_t tile_size)
+{
+	std::string file_path = fs::path::get(fs::path::Assets, heightmap_file);
+
+	// Only the header is loaded, the image data is read in strips below
+	ktxTexture *ktx_texture = nullptr;
+	if (ktxTexture_CreateFromNamedFile(file_path.c_str(), KTX_TEXTURE_CREATE_NO_FLAGS, &ktx_texture) != KTX_SUCCESS)
+	{
+		throw std::runtime_error{"Failed to load heightmap " + heightmap_file};
+	}
+
+	uint32_t dimension       = ktx_texture->baseWidth;
+	bool     is_square       = ktx_texture->baseHeight == dimension;
+	bool     is_ktx1         = ktx_texture->classId == ktxTexture1_c;
+	bool     is_uncompressed = !ktx_texture->isCompressed && ktxTexture_GetElementSize(ktx_texture) == sizeof(uint16_t) &&
+	                       (is_ktx1 || reinterpret_cast<ktxTexture2 *>(ktx_texture)->supercompressionScheme == KTX_SS_NONE);
+	ktxTexture_Destroy(ktx_texture);
+
+	if (!is_uncompressed)
+	{
+		throw std::runtime_error{"Heightmap " + heightmap_file + " is not an uncompressed 16 bit texture"};
+	}
+
+	uint32_t tiles = tile_size > 0 ? dimension / tile_size : 0;
+	if (!is_square || tiles == 0 || dimension % tile_size != 0 || (tiles & (tiles - 1)) != 0)
+	{
+		throw std::runtime_error{"Heightmap " + heightmap_file + " is not a power of two multiple of the tile size"};
+	}
+
+	uint32_t level_count = 1;
+	while ((tiles >> (level_count - 1)) > 1)
+	{
+		level_count++;
+	}
+
+	// libktx only reads whole levels, so the first level is located in the file from the ktx header
+	auto                 fs         = vkb::filesystem::get();
+	std::vector<uint8_t> ktx_header = fs->read_chunk(file_path, 0, 88);
+	if (ktx_header.size() != 88)
+	{
+		throw std::runtime_error{"Failed to read heightmap " + heightmap_file};
+	}
+
+	uint64_t data_offset = 0;
+	size_t   row_pitch   = static_cast<size_t>(dimension) * sizeof(uint16_t);
+	if (is_ktx1)
+	{
+		// The first level follows the key value data and its image size, with rows aligned to 4 bytes
+		uint32_t key_value_bytes = 0;
+		std::memcpy(&key_value_bytes, &ktx_header[60], sizeof(key_value_bytes));
+		data_offset = 64 + key_value_bytes + sizeof(uint32_t);
+		row_pitch   = (row_pitch + 3) & ~size_t(3);
+	}
+	else
+	{
+		// The level index follows the header, starting with the first level
+		std::memcpy(&data_offset, &ktx_header[80], sizeof(data_offset));
+	}
+
+	std::ofstream file{tile_file, std::ios::binary | std::ios::trunc};
+	if (!file.is_open())
+	{
+		throw std::runtime_error{"Failed to open tile file for writing at path: " + tile_file.string()};
+	}
+
+	// The height ranges are only known once all tiles are written, they are written over this placeholder at the end
+	TileFileHeader            header{TILE_FILE_MAGIC, TILE_FILE_VERSION, dimension, tile_size, level_count};
+	std::vector<glm::u16vec2> height_ranges(count_tiles(level_count));
+	file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char *>(height_ranges.data()), height_ranges.size() * sizeof(glm::u16vec2));
+
+	TileFileWriter        writer{file, sizeof(header) + height_ranges.size() * sizeof(glm::u16vec2), dimension, tile_size, level_count};
+	std::vector<uint16_t> row(dimension);
+	for (uint32_t strip_y = 0; strip_y < dimension; strip_y += STRIP_ROWS)
+	{
+		uint32_t strip_rows = std::min(STRIP_ROWS, dimension - strip_y);
+		auto     strip      = fs->read_chunk(file_path, data_offset + strip_y * row_pitch, strip_rows * row_pitch);
+		if (strip.size() != strip_rows * row_pitch)
+		{
+			throw std::runtime_error{"Failed to read heightmap " + heightmap_file};
+		}
+
+		for (uint32_t y = 0; y < strip_rows; ++y)
+		{
+			std::memcpy(row.data(), &strip[y * row_pitch], row.size() * sizeof(uint16_t));
+			writer.push_row(0, strip_y + y, row.data());
+		}
+	}
+
+	file.seekp(sizeof(header));
+	file.write(reinterpret_cast<const char *>(writer.get_height_ranges().data()), writer.get_height_ranges().size() * sizeof(glm::u16vec2));
+
+	if (!file)
+	{
+		throw std::runtime_error{"Failed to write tile file at path: " + tile_file.string()};
+	}
+}
+
+HeightTilePyramid::HeightTilePyramid(const std::filesystem::path &tile_file, size_t capacity) :
+    tile_file{tile_file}, capacity{std::max<size_t>(capacity, 1)}
+{
+	auto fs = vkb::filesystem::get();
+
+	auto header_data = fs->read_chunk(tile_file, 0, sizeof(TileFileHeader));
+
+	TileFileHeader header{};
+	if (header_data.size() == sizeof(TileFileHeader))
+	{
+		std::memcpy(&header, header_data.data(), sizeof(TileFileHeader));
+	}
+	if (header.magic != TILE_FILE_MAGIC || header.version != TILE_FILE_VERSION || header.tile_size == 0 ||
+	    header.level_count == 0 || header.level_count > 16 || header.dimension != header.tile_size << (header.level_count - 1))
+	{
+		throw std::runtime_error{"Invalid tile file at path: " + tile_file.string()};
+	}
+
+	dimension   = header.dimension;
+	tile_size   = header.tile_size;
+	level_count = header.level_count;
+
+	uint64_t tile_count = 0;
+	for (uint32_t level = 0; level < level_count; ++level)
+	{
+		level_offsets.push_back(tile_count);
+		tile_count += uint64_t(1) << (2 * (level_count - 1 - level));
+	}
+
+	auto range_data = fs->read_chunk(tile_file, sizeof(TileFileHeader), tile_count * sizeof(glm::u16vec2));
+	if (range_data.size() != tile_count * sizeof(glm::u16vec2))
+	{
+		throw std::runtime_error{"Invalid tile file at path: " + tile_file.string()};
+	}
+	height_ranges.resize(tile_count);
+	std::memcpy(height_ranges.data(), range_data.data(), range_data.size());
+
+	tiles_offset = sizeof(TileFileHeader) + range_data.size();
+
+	// The coarsest level is a single tile, which stays resident so that the whole terrain can always be drawn
+	if (!load_tile(level_count - 1, 0, 0))
+	{
+		throw std::runtime_error{"Invalid tile file at path: " + tile_file.string()};
+	}
+}
+
+const HeightTilePyramid::Tile *HeightTilePyramid::find_tile(uint32_t level, uint32_t x, uint32_t y)
+{
+	auto it = tile_lookup.find(get_tile_index(level, x, y));
+	if (it == tile_lookup.end())
+	{
+		return nullptr;
+	}
+
+	tiles.splice(tiles.begin(), tiles, it->second);
+	it->second->last_use = stream_count;
+	return &*it->second;
+}
+
+void HeightTilePyramid::request_tile(uint32_t level, uint32_t x, uint32_t y)
+{
+	uint64_t index = get_tile_index(level, x, y);
+	if (!tile_lookup.contains(index) && pending_lookup.insert(index).second)
+	{
+		pending_tiles.push_back(index);
+		statistics.pending_tiles = pending_tiles.size();
+	}
+}
+
+void HeightTilePyramid::stream(uint32_t max_loads)
+{
+	// Tiles requested last are needed for the current view, so they are loaded first
+	uint32_t loads = 0;
+	while (!pending_tiles.empty() && loads < max_loads)
+	{
+		uint64_t index = pending_tiles.back();
+		pending_tiles.pop_back();
+		pending_lookup.erase(index);
+
+		uint32_t level = static_cast<uint32_t>(std::upper_bound(level_offsets.begin(), level_offsets.end(), index) - level_offsets.begin()) - 1;
+		uint32_t side  = get_tiles_per_side(level);
+		uint64_t local = index - level_offsets[level];
+		if (!load_tile(level, static_cast<uint32_t>(local % side), static_cast<uint32_t>(local / side)))
+		{
+			break;
+		}
+		loads++;
+	}
+
+	// Requests which were not served are dropped, the tiles still needed are requested again by the next selection
+	pending_tiles.clear();
+	pending_lookup.clear();
+
+	statistics.resident_tiles = tiles.size();
+	statistics.pending_tiles  = 0;
+
+	stream_count++;
+}
+
+std::vector<uint16_t> HeightTilePyramid::read_level(uint32_t level) const
+{
+	uint32_t              level_dimension = dimension >> level;
+	uint32_t              tiles_per_side  = get_tiles_per_side(level);
+	uint32_t              stride          = get_tile_stride();
+	size_t                tile_bytes      = static_cast<size_t>(stride) * stride * sizeof(uint16_t);
+	std::vector<uint16_t> samples(static_cast<size_t>(level_dimension) * level_dimension);
+
+	// The tiles of a level are contiguous in the tile file, each one is read and its samples inside the border copied
+	auto data = vkb::filesystem::get()->read_chunk(tile_file, tiles_offset + level_offsets[level] * tile_bytes, tiles_per_side * tiles_per_side * tile_bytes);
+	if (data.size() != tiles_per_side * tiles_per_side * tile_bytes)
+	{
+		throw std::runtime_error{"Failed to read level " + std::to_string(level) + " from " + tile_file.string()};
+	}
+
+	for (uint32_t tile_y = 0; tile_y < tiles_per_side; ++tile_y)
+	{
+		for (uint32_t tile_x = 0; tile_x < tiles_per_side; ++tile_x)
+		{
+			const uint8_t *tile = &data[(static_cast<size_t>(tile_y) * tiles_per_side + tile_x) * tile_bytes];
+			for (uint32_t y = 0; y < tile_size; ++y)
+			{
+				std::memcpy(&samples[static_cast<size_t>(tile_y * tile_size + y) * level_dimension + tile_x * tile_size],
+				            tile + ((y + TILE_BORDER) * stride + TILE_BORDER) * sizeof(uint16_t),
+				            tile_size * sizeof(uint16_t));
+			}
+		}
+	}
+
+	return samples;
+}
+
+glm::vec2 HeightTilePyramid::get_height_range(uint32_t level, uint32_t x, uint32_t y) const
+{
+	return glm::vec2(height_ranges[get_tile_index(level, x, y)]) / 65535.0f;
+}
+
+float HeightTilePyramid::get_height(const Tile &tile, int32_t x, int32_t y) const
+{
+	uint32_t stride = get_tile_stride();
+	return tile.samples[(y + TILE_BORDER) * stride + (x + TILE_BORDER)] / 65535.0f;
+}
+
+uint32_t HeightTilePyramid::get_dimension() const
+{
+	return dimension;
+}
+
+uint32_t HeightTilePyramid::get_level_count() const
+{
+	return level_count;
+}
+
+uint32_t HeightTilePyramid::get_tile_size() const
+{
+	return tile_size;
+}
+
+uint32_t HeightTilePyramid::get_tile_stride() const
+{
+	return tile_size + 1 + 2 * TILE_BORDER;
+}
+
+uint32_t HeightTilePyramid::get_tiles_per_side(uint32_t level) const
+{
+	return 1u << (level_count - 1 - level);
+}
+
+const HeightTilePyramid::Statistics &HeightTilePyramid::get_statistics() const
+{
+	return statistics;
+}
+
+uint64_t HeightTilePyramid::get_tile_index(uint32_t level, uint32_t x, uint32_t y) const
+{
+	assert(level < level_count && x < get_tiles_per_side(level) && y < get_tiles_per_side(level));
+	return level_offsets[level] + static_cast<uint64_t>(y) * get_tiles_per_side(level) + x;
+}
+
+bool HeightTilePyramid::load_tile(uint32_t level, uint32_t x, uint32_t y)
+{
+	uint64_t index = get_tile_index(level, x, y);
+	if (tile_lookup.contains(index))
+	{
+		return true;
+	}
+
+	// Evict the least recently used tile, unless it is still in use, the coarsest level is never evicted
+	if (tiles.size() >= capacity)
+	{
+		auto victim = std::find_if(tiles.rbegin(), tiles.rend(), [this](const Tile &tile) { return tile.level != level_count - 1; });
+		if (victim == tiles.rend() || victim->last_use == stream_count)
+		{
+			return false;
+		}
+
+		tile_lookup.erase(get_tile_index(victim->level, victim->x, victim->y));
+		tiles.erase(std::next(victim).base());
+		statistics.evicted_tiles++;
+	}
+
+	size_t tile_bytes = static_cast<size_t>(get_tile_stride()) * get_tile_stride() * sizeof(uint16_t);
+	auto   data       = vkb::filesystem::get()->read_chunk(tile_file, tiles_offset + index * tile_bytes, tile_bytes);
+	if (data.size() != tile_bytes)
+	{
+		LOGE("Failed to read tile {} of level {} from {}", index - level_offsets[level], level, tile_file.string());
+		return false;
+	}
+
+	Tile tile{level, x, y, std::vector<uint16_t>(tile_bytes / sizeof(uint16_t)), stream_count};
+	std::memcpy(tile.samples.data(), data.data(), tile_bytes);
+
+	tiles.push_front(std::move(tile));
+	tile_lookup[index] = tiles.begin();
+	statistics.loaded_tiles++;
+	statistics.resident_tiles = tiles.size();
+
+	return true;
+}
+}        // namespace vkb
@@ -0,0 +1,180 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Heightmap split into square tiles for each level of its mip pyramid, streamed from a tile file on demand
+ *
+ * Level 0 is the full resolution heightmap, each following level halves its resolution, up to a single tile. Each tile
+ * holds its tile_size + 1 samples per side, so that the tiles of a level share their edges, surrounded by a border of
+ * TILE_BORDER samples from the neighboring tiles, which lets normals be filtered without accessing other tiles.
+ *
+ * Only the tile file header and the height range of each tile are kept in memory. Tiles are read from the tile file
+ * when requested, up to a budget per call to stream, and the least recently used tiles are evicted once the number of
+ * resident tiles reaches its capacity, so the memory used does not depend on the size of the heightmap.
+ */
+class HeightTilePyramid
+{
+  public:
+	static constexpr uint32_t TILE_BORDER = 1;
+
+	struct Tile
+	{
+		uint32_t level = 0;
+
+		uint32_t x = 0;
+
+		uint32_t y = 0;
+
+		// Row major normalized heights, including the border
+		std::vector<uint16_t> samples;
+
+		// Number of calls to stream when the tile was last found
+		uint64_t last_use = 0;
+	};
+
+	struct Statistics
+	{
+		size_t resident_tiles = 0;
+
+		size_t loaded_tiles = 0;
+
+		size_t evicted_tiles = 0;
+
+		size_t pending_tiles = 0;
+	};
+
+	/**
+	 * @brief Creates the tile file of a heightmap
+	 *        The heightmap is read in strips of rows, and each level is built from the rows of the previous one as they
+	 *        arrive, so only a few rows of each level are kept in memory while the file is created
+	 * @param heightmap_file An uncompressed ktx texture with a single 16 bit channel, relative to the assets directory
+	 * @param tile_file Path of the created tile file
+	 * @param tile_size Number of samples per tile side, the size of the heightmap must be a power of two multiple of it
+	 */
+	static void create_tile_file(const std::string &heightmap_file, const std::filesystem::path &tile_file, uint32_t tile_size);
+
+	/**
+	 * @brief Opens a tile file, and loads the coarsest level which stays resident
+	 * @param tile_file Tile file created by create_tile_file
+	 * @param capacity Maximum number of resident tiles
+	 * @throws std::runtime_error if the tile file is invalid
+	 */
+	HeightTilePyramid(const std::filesystem::path &tile_file, size_t capacity);
+
+	/**
+	 * @brief Looks up a resident tile, and marks it as used
+	 * @return The tile, or nullptr if it is not resident
+	 */
+	const Tile *find_tile(uint32_t level, uint32_t x, uint32_t y);
+
+	/**
+	 * @brief Requests a tile to be loaded by the next calls to stream
+	 */
+	void request_tile(uint32_t level, uint32_t x, uint32_t y);
+
+	/**
+	 * @brief Loads requested tiles, evicting the least recently used ones if needed
+	 *        Tiles found since the previous call are not evicted, loading stops early if no other tile can be evicted
+	 * @param max_loads Maximum number of tiles read from the tile file
+	 */
+	void stream(uint32_t max_loads);
+
+	/**
+	 * @brief Reads all the samples of a level from the tile file, without changing the resident tiles
+	 * @return Row major normalized heights, with get_dimension() >> level samples per side
+	 */
+	std::vector<uint16_t> read_level(uint32_t level) const;
+
+	/**
+	 * @return The minimum and maximum normalized heights of a tile
+	 */
+	glm::vec2 get_height_range(uint32_t level, uint32_t x, uint32_t y) const;
+
+	/**
+	 * @return Normalized height of a sample of a tile, with coordinates relative to its first sample inside the border
+	 */
+	float get_height(const Tile &tile, int32_t x, int32_t y) const;
+
+	uint32_t get_dimension() const;
+
+	uint32_t get_level_count() const;
+
+	uint32_t get_tile_size() const;
+
+	/**
+	 * @return Number of samples per side of a tile, including its border
+	 */
+	uint32_t get_tile_stride() const;
+
+	uint32_t get_tiles_per_side(uint32_t level) const;
+
+	const Statistics &get_statistics() const;
+
+  private:
+	uint64_t get_tile_index(uint32_t level, uint32_t x, uint32_t y) const;
+
+	/**
+	 * @return Whether the tile is resident, false if it could not be read or no tile could be evicted for it
+	 */
+	bool load_tile(uint32_t level, uint32_t x, uint32_t y);
+
+	std::filesystem::path tile_file;
+
+	size_t capacity = 0;
+
+	uint32_t dimension = 0;
+
+	uint32_t tile_size = 0;
+
+	uint32_t level_count = 0;
+
+	// Index of the first tile of each level
+	std::vector<uint64_t> level_offsets;
+
+	// Minimum and maximum height of each tile, indexed like the tiles of the tile file
+	std::vector<glm::u16vec2> height_ranges;
+
+	size_t tiles_offset = 0;
+
+	// Resident tiles, the most recently used first
+	std::list<Tile> tiles;
+
+	std::unordered_map<uint64_t, std::list<Tile>::iterator> tile_lookup;
+
+	std::vector<uint64_t> pending_tiles;
+
+	std::unordered_set<uint64_t> pending_lookup;
+
+	uint64_t stream_count = 0;
+
+	Statistics statistics;
+};
+}        // namespace vkb
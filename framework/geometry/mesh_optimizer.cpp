@@ -0,0 +1,579 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+#include "common/content_hash.h"
+#include "common/error.h"
+#include "common/helpers.h"
+#include "core/util/logging.hpp"
+
+#include <filesystem/filesystem.hpp>
+
+#define MESH_OPTIMIZER_CACHE_DIRECTORY "cache/mesh_optimizer"
+
+namespace vkb
+{
+namespace
+{
+// Bump whenever the optimization algorithms or the cache key change, to invalidate cached results
+constexpr uint32_t MESH_OPTIMIZER_VERSION = 3;
+
+constexpr uint32_t MESH_OPTIMIZER_MAGIC = 0x504f4356;        // "VCOP"
+
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+struct CacheHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t index_count;
+	uint32_t vertex_count;
+};
+
+/**
+ * @brief Vertex score from Forsyth's "Linear-Speed Vertex Cache Optimisation"
+ */
+float vertex_score(int32_t cache_position, uint32_t remaining_triangles)
+{
+	if (remaining_triangles == 0)
+	{
+		// No triangle needs this vertex anymore
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+
+	if (cache_position >= 0)
+	{
+		if (cache_position < 3)
+		{
+			// The vertices of the last triangle get a fixed score, so they are not favoured over the rest of the cache
+			score = 0.75f;
+		}
+		else
+		{
+			float scaler = 1.0f - static_cast<float>(cache_position - 3) / static_cast<float>(VERTEX_CACHE_SIZE - 3);
+			score        = std::pow(scaler, 1.5f);
+		}
+	}
+
+	// Boost vertices with few remaining triangles, to avoid leaving lone triangles behind
+	return score + 2.0f / std::sqrt(static_cast<float>(remaining_triangles));
+}
+
+uint64_t hash_mesh(const std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, uint32_t vertex_count)
+{
+	std::array<uint32_t, 3> header{MESH_OPTIMIZER_VERSION, vertex_count, to_u32(indices.size())};
+
+	ContentHasher hasher;
+	hasher.update_values(std::span<const uint32_t>(header));
+	hasher.update_values(std::span<const uint32_t>(indices));
+	hasher.update_values(std::span<const glm::vec3>(positions));
+	return hasher.digest64();
+}
+
+bool read_cache_file(const std::string &path, uint32_t index_count, uint32_t vertex_count, OptimizedMesh &mesh)
+{
+	auto fs = vkb::filesystem::get();
+
+	if (!fs->exists(path))
+	{
+		return false;
+	}
+
+	auto data = fs->read_file_binary(path);
+
+	CacheHeader header{};
+	if (data.size() != sizeof(CacheHeader) + (static_cast<size_t>(index_count) + vertex_count) * sizeof(uint32_t))
+	{
+		LOGW("Ignoring invalid mesh optimizer cache file {}", path);
+		return false;
+	}
+
+	std::memcpy(&header, data.data(), sizeof(CacheHeader));
+	if (header.magic != MESH_OPTIMIZER_MAGIC || header.version != MESH_OPTIMIZER_VERSION ||
+	    header.index_count != index_count || header.vertex_count != vertex_count)
+	{
+		LOGW("Ignoring invalid mesh optimizer cache file {}", path);
+		return false;
+	}
+
+	mesh.indices.resize(index_count);
+	mesh.vertex_order.resize(vertex_count);
+
+	const uint8_t *payload = data.data() + sizeof(CacheHeader);
+	std::memcpy(mesh.indices.data(), payload, index_count * sizeof(uint32_t));
+	std::memcpy(mesh.vertex_order.data(), payload + index_count * sizeof(uint32_t), vertex_count * sizeof(uint32_t));
+
+	return true;
+}
+
+void write_cache_file(const std::string &path, const OptimizedMesh &mesh)
+{
+	CacheHeader header{MESH_OPTIMIZER_MAGIC, MESH_OPTIMIZER_VERSION, to_u32(mesh.indices.size()), to_u32(mesh.vertex_order.size())};
+
+	std::vector<uint8_t> data(sizeof(CacheHeader) + (mesh.indices.size() + mesh.vertex_order.size()) * sizeof(uint32_t));
+
+	uint8_t *payload = data.data();
+	std::memcpy(payload, &header, sizeof(CacheHeader));
+	payload += sizeof(CacheHeader);
+	std::memcpy(payload, mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+	payload += mesh.indices.size() * sizeof(uint32_t);
+	std::memcpy(payload, mesh.vertex_order.data(), mesh.vertex_order.size() * sizeof(uint32_t));
+
+	try
+	{
+		vkb::filesystem::get()->write_file(path, data);
+	}
+	catch (const std::runtime_error &e)
+	{
+		LOGE("Could not write mesh optimizer cache file {}: {}", path, e.what());
+	}
+}
+}        // namespace
+
+float VertexCacheStatistics::acmr() const
+{
+	return triangle_count > 0 ? static_cast<float>(vertices_transformed) / static_cast<float>(triangle_count) : 0.0f;
+}
+
+float VertexCacheStatistics::atvr() const
+{
+	return vertex_count > 0 ? static_cast<float>(vertices_transformed) / static_cast<float>(vertex_count) : 0.0f;
+}
+
+VertexCacheStatistics &VertexCacheStatistics::operator+=(const VertexCacheStatistics &other)
+{
+	triangle_count += other.triangle_count;
+	vertices_transformed += other.vertices_transformed;
+	vertex_count += other.vertex_count;
+	return *this;
+}
+
+VertexCacheStatistics analyze_vertex_cache(const std::vector<uint32_t> &indices, uint32_t vertex_count, uint32_t cache_size)
+{
+	VertexCacheStatistics statistics;
+	statistics.triangle_count = indices.size() / 3;
+
+	// A vertex is in the FIFO cache if less than cache_size misses happened since it was transformed
+	std::vector<uint32_t> timestamps(vertex_count, 0);
+	uint32_t              time = cache_size + 1;
+
+	for (auto index : indices)
+	{
+		assert(index < vertex_count);
+
+		if (timestamps[index] == 0)
+		{
+			statistics.vertex_count++;
+		}
+
+		if (time - timestamps[index] > cache_size)
+		{
+			timestamps[index] = time++;
+			statistics.vertices_transformed++;
+		}
+	}
+
+	return statistics;
+}
+
+std::vector<uint32_t> optimize_vertex_cache(const std::vector<uint32_t> &indices, uint32_t vertex_count)
+{
+	const size_t triangle_count = indices.size() / 3;
+
+	if (triangle_count == 0)
+	{
+		return indices;
+	}
+
+	// Triangles adjacent to each vertex, the first remaining_triangles[vertex] entries are the ones not emitted yet
+	std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+	for (auto index : indices)
+	{
+		assert(index < vertex_count);
+		adjacency_offsets[index + 1]++;
+	}
+	std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+
+	std::vector<uint32_t> remaining_triangles(vertex_count);
+	for (uint32_t vertex = 0; vertex < vertex_count; ++vertex)
+	{
+		remaining_triangles[vertex] = adjacency_offsets[vertex + 1] - adjacency_offsets[vertex];
+	}
+
+	std::vector<uint32_t> adjacency(indices.size());
+	{
+		std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			adjacency[fill[indices[i]]++] = to_u32(i / 3);
+		}
+	}
+
+	std::vector<float> vertex_scores(vertex_count);
+	for (uint32_t vertex = 0; vertex < vertex_count; ++vertex)
+	{
+		vertex_scores[vertex] = vertex_score(-1, remaining_triangles[vertex]);
+	}
+
+	std::vector<float> triangle_scores(triangle_count);
+	for (size_t triangle = 0; triangle < triangle_count; ++triangle)
+	{
+		triangle_scores[triangle] = vertex_scores[indices[triangle * 3]] + vertex_scores[indices[triangle * 3 + 1]] + vertex_scores[indices[triangle * 3 + 2]];
+	}
+
+	std::vector<bool> emitted(triangle_count, false);
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+
+	// The cache holds up to 3 more entries than modelled while it is updated, these are evicted afterwards
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> new_cache;
+	cache.reserve(VERTEX_CACHE_SIZE + 3);
+	new_cache.reserve(VERTEX_CACHE_SIZE + 3);
+
+	size_t best_triangle = std::distance(triangle_scores.begin(), std::max_element(triangle_scores.begin(), triangle_scores.end()));
+
+	// Fallback to the next triangle in input order when no triangle in the cache is left
+	size_t input_cursor = 0;
+
+	while (best_triangle != INVALID_INDEX)
+	{
+		emitted[best_triangle] = true;
+
+		const uint32_t *triangle = &indices[best_triangle * 3];
+
+		new_cache.clear();
+		for (uint32_t corner = 0; corner < 3; ++corner)
+		{
+			uint32_t vertex = triangle[corner];
+			result.push_back(vertex);
+
+			// Remove the triangle from the adjacency of the vertex
+			uint32_t *vertex_triangles = &adjacency[adjacency_offsets[vertex]];
+			uint32_t  count            = remaining_triangles[vertex];
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (vertex_triangles[i] == best_triangle)
+				{
+					std::swap(vertex_triangles[i], vertex_triangles[count - 1]);
+					break;
+				}
+			}
+			remaining_triangles[vertex]--;
+
+			if (std::find(new_cache.begin(), new_cache.end(), vertex) == new_cache.end())
+			{
+				new_cache.push_back(vertex);
+			}
+		}
+
+		for (auto vertex : cache)
+		{
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+			{
+				new_cache.push_back(vertex);
+			}
+		}
+
+		std::swap(cache, new_cache);
+
+		// Update the scores of all vertices which moved in or out of the cache, and of their triangles
+		for (size_t i = 0; i < cache.size(); ++i)
+		{
+			uint32_t vertex   = cache[i];
+			int32_t  position = i < VERTEX_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+
+			float score = vertex_score(position, remaining_triangles[vertex]);
+			float delta = score - vertex_scores[vertex];
+
+			vertex_scores[vertex] = score;
+
+			const uint32_t *vertex_triangles = &adjacency[adjacency_offsets[vertex]];
+			for (uint32_t t = 0; t < remaining_triangles[vertex]; ++t)
+			{
+				triangle_scores[vertex_triangles[t]] += delta;
+			}
+		}
+
+		if (cache.size() > VERTEX_CACHE_SIZE)
+		{
+			cache.resize(VERTEX_CACHE_SIZE);
+		}
+
+		// The next triangle is the best one using a cached vertex
+		best_triangle    = INVALID_INDEX;
+		float best_score = -std::numeric_limits<float>::max();
+
+		for (auto vertex : cache)
+		{
+			const uint32_t *vertex_triangles = &adjacency[adjacency_offsets[vertex]];
+			for (uint32_t t = 0; t < remaining_triangles[vertex]; ++t)
+			{
+				uint32_t candidate = vertex_triangles[t];
+				if (triangle_scores[candidate] > best_score)
+				{
+					best_triangle = candidate;
+					best_score    = triangle_scores[candidate];
+				}
+			}
+		}
+
+		if (best_triangle == INVALID_INDEX)
+		{
+			while (input_cursor < triangle_count && emitted[input_cursor])
+			{
+				input_cursor++;
+			}
+
+			if (input_cursor < triangle_count)
+			{
+				best_triangle = input_cursor;
+			}
+		}
+	}
+
+	return result;
+}
+
+std::vector<uint32_t> optimize_overdraw(const std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, float threshold)
+{
+	const size_t triangle_count = indices.size() / 3;
+	const auto   vertex_count   = to_u32(positions.size());
+
+	if (triangle_count < 2 || positions.empty())
+	{
+		return indices;
+	}
+
+	// Simulate the cache, so clusters can start where it is cold anyway
+	std::vector<uint32_t> triangle_misses(triangle_count, 0);
+	{
+		std::vector<uint32_t> timestamps(vertex_count, 0);
+		uint32_t              time = VERTEX_CACHE_SIZE + 1;
+
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			uint32_t index = indices[i];
+			assert(index < vertex_count);
+
+			if (time - timestamps[index] > VERTEX_CACHE_SIZE)
+			{
+				timestamps[index] = time++;
+				triangle_misses[i / 3]++;
+			}
+		}
+	}
+
+	// Hard boundaries, where all vertices of a triangle miss the cache
+	std::vector<size_t> hard_boundaries;
+	for (size_t triangle = 0; triangle < triangle_count; ++triangle)
+	{
+		if (triangle == 0 || triangle_misses[triangle] == 3)
+		{
+			hard_boundaries.push_back(triangle);
+		}
+	}
+	hard_boundaries.push_back(triangle_count);
+
+	// The clusters are reordered, so each one starts with a cold cache: its misses are simulated from its first triangle
+	std::vector<uint32_t> cluster_timestamps(vertex_count, 0);
+	uint32_t              cluster_time = VERTEX_CACHE_SIZE + 1;
+
+	auto flush_cache = [&cluster_time]() {
+		cluster_time += VERTEX_CACHE_SIZE + 1;
+	};
+
+	auto cold_misses = [&](size_t triangle) {
+		uint32_t misses = 0;
+		for (size_t corner = 0; corner < 3; ++corner)
+		{
+			uint32_t index = indices[triangle * 3 + corner];
+			if (cluster_time - cluster_timestamps[index] > VERTEX_CACHE_SIZE)
+			{
+				cluster_timestamps[index] = cluster_time++;
+				misses++;
+			}
+		}
+		return misses;
+	};
+
+	// Soft boundaries, wherever the cache miss ratio of the cluster so far stays within the threshold of the hard cluster's
+	std::vector<size_t> clusters;
+	for (size_t h = 0; h + 1 < hard_boundaries.size(); ++h)
+	{
+		size_t begin = hard_boundaries[h];
+		size_t end   = hard_boundaries[h + 1];
+
+		flush_cache();
+		size_t cluster_misses = 0;
+		for (size_t triangle = begin; triangle < end; ++triangle)
+		{
+			cluster_misses += cold_misses(triangle);
+		}
+		float cluster_acmr = static_cast<float>(cluster_misses) / static_cast<float>(end - begin);
+
+		clusters.push_back(begin);
+
+		flush_cache();
+		size_t misses = 0;
+		size_t count  = 0;
+		for (size_t triangle = begin; triangle + 1 < end; ++triangle)
+		{
+			misses += cold_misses(triangle);
+			count++;
+
+			if (static_cast<float>(misses) / static_cast<float>(count) <= cluster_acmr * threshold)
+			{
+				clusters.push_back(triangle + 1);
+				flush_cache();
+				misses = 0;
+				count  = 0;
+			}
+		}
+	}
+	clusters.push_back(triangle_count);
+
+	glm::vec3 mesh_center{0.0f};
+	for (auto &position : positions)
+	{
+		mesh_center += position;
+	}
+	mesh_center /= static_cast<float>(vertex_count);
+
+	// Clusters facing away from the mesh center are more likely to occlude others, so they are drawn first
+	const size_t       cluster_count = clusters.size() - 1;
+	std::vector<float> sort_keys(cluster_count);
+
+	for (size_t c = 0; c < cluster_count; ++c)
+	{
+		glm::vec3 centroid{0.0f};
+		glm::vec3 normal{0.0f};
+		float     area = 0.0f;
+
+		for (size_t triangle = clusters[c]; triangle < clusters[c + 1]; ++triangle)
+		{
+			const glm::vec3 &p0 = positions[indices[triangle * 3]];
+			const glm::vec3 &p1 = positions[indices[triangle * 3 + 1]];
+			const glm::vec3 &p2 = positions[indices[triangle * 3 + 2]];
+
+			glm::vec3 triangle_normal = glm::cross(p1 - p0, p2 - p0);
+			float     triangle_area   = glm::length(triangle_normal);
+
+			centroid += (p0 + p1 + p2) * (triangle_area / 3.0f);
+			normal += triangle_normal;
+			area += triangle_area;
+		}
+
+		float normal_length = glm::length(normal);
+		if (area > 0.0f && normal_length > 0.0f)
+		{
+			sort_keys[c] = glm::dot(centroid / area - mesh_center, normal / normal_length);
+		}
+		else
+		{
+			sort_keys[c] = 0.0f;
+		}
+	}
+
+	std::vector<size_t> cluster_order(cluster_count);
+	std::iota(cluster_order.begin(), cluster_order.end(), 0);
+	std::stable_sort(cluster_order.begin(), cluster_order.end(), [&sort_keys](size_t lhs, size_t rhs) {
+		return sort_keys[lhs] > sort_keys[rhs];
+	});
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+
+	for (auto c : cluster_order)
+	{
+		result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+	}
+
+	return result;
+}
+
+std::vector<uint32_t> optimize_vertex_fetch(std::vector<uint32_t> &indices, uint32_t vertex_count)
+{
+	std::vector<uint32_t> remap(vertex_count, INVALID_INDEX);
+	std::vector<uint32_t> vertex_order;
+	vertex_order.reserve(vertex_count);
+
+	for (auto &index : indices)
+	{
+		assert(index < vertex_count);
+
+		if (remap[index] == INVALID_INDEX)
+		{
+			remap[index] = to_u32(vertex_order.size());
+			vertex_order.push_back(index);
+		}
+
+		index = remap[index];
+	}
+
+	// Unreferenced vertices are kept at the end, so the vertex count does not change
+	for (uint32_t vertex = 0; vertex < vertex_count; ++vertex)
+	{
+		if (remap[vertex] == INVALID_INDEX)
+		{
+			vertex_order.push_back(vertex);
+		}
+	}
+
+	return vertex_order;
+}
+
+OptimizedMesh optimize_mesh(const std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, uint32_t vertex_count, bool use_cache)
+{
+	assert(positions.empty() || positions.size() == vertex_count);
+
+	OptimizedMesh mesh;
+	mesh.before = analyze_vertex_cache(indices, vertex_count);
+
+	const std::string cache_path = fmt::format("{}/{:016x}.bin", MESH_OPTIMIZER_CACHE_DIRECTORY, hash_mesh(indices, positions, vertex_count));
+
+	if (use_cache && read_cache_file(cache_path, to_u32(indices.size()), vertex_count, mesh))
+	{
+		mesh.from_cache = true;
+	}
+	else
+	{
+		mesh.indices      = optimize_overdraw(optimize_vertex_cache(indices, vertex_count), positions);
+		mesh.vertex_order = optimize_vertex_fetch(mesh.indices, vertex_count);
+
+		if (use_cache)
+		{
+			write_cache_file(cache_path, mesh);
+		}
+	}
+
+	mesh.after = analyze_vertex_cache(mesh.indices, vertex_count);
+
+	return mesh;
+}
+}        // namespace vkb
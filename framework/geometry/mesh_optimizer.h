@@ -0,0 +1,117 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Size of the FIFO post-transform vertex cache used to optimize and analyze index buffers
+ */
+constexpr uint32_t VERTEX_CACHE_SIZE = 32;
+
+/**
+ * @brief Post-transform vertex cache efficiency of an indexed triangle list
+ */
+struct VertexCacheStatistics
+{
+	size_t triangle_count = 0;
+
+	/// Number of vertex shader invocations, i.e. cache misses
+	size_t vertices_transformed = 0;
+
+	/// Number of distinct vertices referenced by the indices
+	size_t vertex_count = 0;
+
+	/**
+	 * @brief Average cache miss ratio, transformed vertices per triangle (0.5 is optimal for large grids, 3 is the worst case)
+	 */
+	float acmr() const;
+
+	/**
+	 * @brief Average transform to vertex ratio, transformed vertices per referenced vertex (1 is optimal)
+	 */
+	float atvr() const;
+
+	VertexCacheStatistics &operator+=(const VertexCacheStatistics &other);
+};
+
+/**
+ * @brief Simulates a FIFO post-transform vertex cache over an indexed triangle list
+ */
+VertexCacheStatistics analyze_vertex_cache(const std::vector<uint32_t> &indices, uint32_t vertex_count, uint32_t cache_size = VERTEX_CACHE_SIZE);
+
+/**
+ * @brief Reorders triangles for post-transform vertex cache locality, using Tom Forsyth's linear-speed algorithm
+ * @return The reordered indices
+ */
+std::vector<uint32_t> optimize_vertex_cache(const std::vector<uint32_t> &indices, uint32_t vertex_count);
+
+/**
+ * @brief Reorders clusters of a cache optimized triangle list to reduce overdraw, following Sander et al.'s Tipsy
+ *
+ * The triangle list is split into clusters where the vertex cache is cold, and where the cache miss ratio
+ * allows it within the given threshold. As clusters are drawn in any order, the miss ratio of each cluster is
+ * simulated starting from a cold cache. Clusters are then sorted so that outward facing clusters far from
+ * the mesh center, which are likely to occlude the rest of the mesh, are drawn first.
+ * @param indices Cache optimized indices
+ * @param positions Vertex positions
+ * @param threshold The ACMR increase allowed in exchange for better overdraw, 1.0 keeps the cache efficiency
+ * @return The reordered indices
+ */
+std::vector<uint32_t> optimize_overdraw(const std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, float threshold = 1.05f);
+
+/**
+ * @brief Reorders vertices in order of first use, for vertex fetch locality
+ * @param indices The indices to remap, they are updated to reference the reordered vertices
+ * @return For each new vertex, the index of the vertex it was moved from
+ */
+std::vector<uint32_t> optimize_vertex_fetch(std::vector<uint32_t> &indices, uint32_t vertex_count);
+
+/**
+ * @brief The outcome of optimizing a mesh
+ */
+struct OptimizedMesh
+{
+	std::vector<uint32_t> indices;
+
+	/// For each new vertex, the index of the vertex it was moved from
+	std::vector<uint32_t> vertex_order;
+
+	VertexCacheStatistics before;
+
+	VertexCacheStatistics after;
+
+	bool from_cache = false;
+};
+
+/**
+ * @brief Runs the vertex cache, overdraw and vertex fetch optimizations on an indexed triangle list
+ *
+ * Results are written to a disk cache keyed by the hash of the indices and positions, so a mesh is only optimized once.
+ * @param indices Triangle list indices
+ * @param positions Vertex positions, used for the overdraw optimization which is skipped if empty
+ * @param vertex_count Number of vertices referenced by the indices
+ * @param use_cache Whether results are read from and written to the disk cache
+ */
+OptimizedMesh optimize_mesh(const std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, uint32_t vertex_count, bool use_cache = true);
+}        // namespace vkb
@@ -0,0 +1,293 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "terrain_quadtree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// vsqrtq_f32 and vdivq_f32 are only available on AArch64
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	include <xmmintrin.h>
+#	define VKB_TERRAIN_SSE
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#	include <arm_neon.h>
+#	define VKB_TERRAIN_NEON
+#endif
+
+namespace vkb
+{
+namespace
+{
+/**
+ * @brief Computes the normals of a row of samples with a Sobel filter, as three arrays of components
+ *        Each row holds count + 2 heights, the normal of sample i is centered on the height i + 1 of row
+ */
+void compute_normal_row(const float *above, const float *row, const float *below, uint32_t count, float gradient_scale, float *normal_x, float *normal_y, float *normal_z)
+{
+	uint32_t x = 0;
+
+#if defined(VKB_TERRAIN_SSE)
+	const __m128 scale_4 = _mm_set1_ps(gradient_scale);
+	const __m128 two     = _mm_set1_ps(2.0f);
+	const __m128 one     = _mm_set1_ps(1.0f);
+	const __m128 quarter = _mm_set1_ps(0.25f);
+	const __m128 zero    = _mm_setzero_ps();
+
+	for (; x + 4 <= count; x += 4)
+	{
+		__m128 left   = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(&above[x]), _mm_loadu_ps(&below[x])), _mm_mul_ps(two, _mm_loadu_ps(&row[x])));
+		__m128 right  = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(&above[x + 2]), _mm_loadu_ps(&below[x + 2])), _mm_mul_ps(two, _mm_loadu_ps(&row[x + 2])));
+		__m128 top    = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(&above[x]), _mm_loadu_ps(&above[x + 2])), _mm_mul_ps(two, _mm_loadu_ps(&above[x + 1])));
+		__m128 bottom = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(&below[x]), _mm_loadu_ps(&below[x + 2])), _mm_mul_ps(two, _mm_loadu_ps(&below[x + 1])));
+
+		__m128 gx = _mm_mul_ps(_mm_sub_ps(left, right), scale_4);
+		__m128 gz = _mm_mul_ps(_mm_sub_ps(top, bottom), scale_4);
+		__m128 gy = _mm_mul_ps(quarter, _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(one, _mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gz, gz))), zero)));
+		gx        = _mm_mul_ps(gx, two);
+		gz        = _mm_mul_ps(gz, two);
+
+		__m128 inverse_length = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gy, gy)), _mm_mul_ps(gz, gz))));
+		_mm_storeu_ps(&normal_x[x], _mm_mul_ps(gx, inverse_length));
+		_mm_storeu_ps(&normal_y[x], _mm_mul_ps(gy, inverse_length));
+		_mm_storeu_ps(&normal_z[x], _mm_mul_ps(gz, inverse_length));
+	}
+#elif defined(VKB_TERRAIN_NEON)
+	const float32x4_t scale_4 = vdupq_n_f32(gradient_scale);
+	const float32x4_t one     = vdupq_n_f32(1.0f);
+	const float32x4_t zero    = vdupq_n_f32(0.0f);
+
+	for (; x + 4 <= count; x += 4)
+	{
+		float32x4_t left   = vmlaq_n_f32(vaddq_f32(vld1q_f32(&above[x]), vld1q_f32(&below[x])), vld1q_f32(&row[x]), 2.0f);
+		float32x4_t right  = vmlaq_n_f32(vaddq_f32(vld1q_f32(&above[x + 2]), vld1q_f32(&below[x + 2])), vld1q_f32(&row[x + 2]), 2.0f);
+		float32x4_t top    = vmlaq_n_f32(vaddq_f32(vld1q_f32(&above[x]), vld1q_f32(&above[x + 2])), vld1q_f32(&above[x + 1]), 2.0f);
+		float32x4_t bottom = vmlaq_n_f32(vaddq_f32(vld1q_f32(&below[x]), vld1q_f32(&below[x + 2])), vld1q_f32(&below[x + 1]), 2.0f);
+
+		float32x4_t gx = vmulq_f32(vsubq_f32(left, right), scale_4);
+		float32x4_t gz = vmulq_f32(vsubq_f32(top, bottom), scale_4);
+		float32x4_t gy = vmulq_n_f32(vsqrtq_f32(vmaxq_f32(vmlsq_f32(vmlsq_f32(one, gx, gx), gz, gz), zero)), 0.25f);
+		gx             = vmulq_n_f32(gx, 2.0f);
+		gz             = vmulq_n_f32(gz, 2.0f);
+
+		float32x4_t inverse_length = vdivq_f32(one, vsqrtq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(gx, gx), gy, gy), gz, gz)));
+		vst1q_f32(&normal_x[x], vmulq_f32(gx, inverse_length));
+		vst1q_f32(&normal_y[x], vmulq_f32(gy, inverse_length));
+		vst1q_f32(&normal_z[x], vmulq_f32(gz, inverse_length));
+	}
+#endif
+
+	for (; x < count; ++x)
+	{
+		float left   = above[x] + 2.0f * row[x] + below[x];
+		float right  = above[x + 2] + 2.0f * row[x + 2] + below[x + 2];
+		float top    = above[x] + 2.0f * above[x + 1] + above[x + 2];
+		float bottom = below[x] + 2.0f * below[x + 1] + below[x + 2];
+
+		float gx = (left - right) * gradient_scale;
+		float gz = (top - bottom) * gradient_scale;
+
+		// The up component is derived from the filtered gradients, its factor controls the bump strength
+		glm::vec3 normal = glm::normalize(glm::vec3(2.0f * gx, 0.25f * std::sqrt(std::max(1.0f - gx * gx - gz * gz, 0.0f)), 2.0f * gz));
+
+		normal_x[x] = normal.x;
+		normal_y[x] = normal.y;
+		normal_z[x] = normal.z;
+	}
+}
+}        // namespace
+
+TerrainQuadtree::TerrainQuadtree(HeightTilePyramid &pyramid, float world_size, float height_scale, uint32_t max_nodes) :
+    pyramid{pyramid}, world_size{world_size}, height_scale{height_scale}, max_nodes{std::max(max_nodes, 1u)}
+{
+	uint32_t stride = pyramid.get_tile_stride();
+	heights.resize(static_cast<size_t>(stride) * stride);
+	normals.resize(3 * static_cast<size_t>(stride));
+}
+
+bool TerrainQuadtree::select(Frustum &frustum, const glm::vec3 &camera_position)
+{
+	std::swap(previous_nodes, selected_nodes);
+	selected_nodes.clear();
+	statistics = {};
+
+	node_stack.clear();
+	node_stack.push_back({pyramid.get_level_count() - 1, 0, 0});
+
+	while (!node_stack.empty())
+	{
+		Node node = node_stack.back();
+		node_stack.pop_back();
+		statistics.visited_nodes++;
+
+		float     node_size    = world_size / pyramid.get_tiles_per_side(node.level);
+		glm::vec2 height_range = pyramid.get_height_range(node.level, node.x, node.y) * height_scale;
+
+		// Heights displace the terrain downwards
+		glm::vec3 min_corner{node.x * node_size - world_size * 0.5f, -height_range.y, node.y * node_size - world_size * 0.5f};
+		glm::vec3 max_corner{min_corner.x + node_size, -height_range.x, min_corner.z + node_size};
+		glm::vec3 center = (min_corner + max_corner) * 0.5f;
+		float     radius = glm::length(max_corner - center);
+
+		if (!frustum.check_sphere(center, radius))
+		{
+			statistics.culled_nodes++;
+			continue;
+		}
+
+		// Splitting replaces a node by up to four, the nodes still on the stack are each selected at least once
+		float distance = std::max(glm::length(camera_position - center) - radius, 0.0f);
+		bool  split    = node.level > 0 && distance < lod_factor * node_size && selected_nodes.size() + node_stack.size() + 4 <= max_nodes;
+
+		if (split)
+		{
+			for (uint32_t child = 0; child < 4; ++child)
+			{
+				Node child_node{node.level - 1, node.x * 2 + (child & 1), node.y * 2 + (child >> 1)};
+				if (!pyramid.find_tile(child_node.level, child_node.x, child_node.y))
+				{
+					pyramid.request_tile(child_node.level, child_node.x, child_node.y);
+					split = false;
+				}
+			}
+		}
+
+		if (split)
+		{
+			for (uint32_t child = 0; child < 4; ++child)
+			{
+				node_stack.push_back({node.level - 1, node.x * 2 + (child & 1), node.y * 2 + (child >> 1)});
+			}
+		}
+		else
+		{
+			// Keeps the tile of the node as recently used, so that it is not evicted while drawn
+			pyramid.find_tile(node.level, node.x, node.y);
+			selected_nodes.push_back(node);
+		}
+	}
+
+	statistics.selected_nodes = selected_nodes.size();
+
+	return selected_nodes != previous_nodes;
+}
+
+uint32_t TerrainQuadtree::generate_patches(std::span<PatchVertex> vertices, std::span<uint32_t> indices)
+{
+	const uint32_t tile_size    = pyramid.get_tile_size();
+	const uint32_t stride       = pyramid.get_tile_stride();
+	const uint32_t side         = tile_size + 1;
+	const uint32_t vertex_count = get_patch_vertex_count();
+	const uint32_t index_count  = get_patch_index_count();
+
+	assert(vertices.size() >= selected_nodes.size() * vertex_count && indices.size() >= selected_nodes.size() * index_count);
+
+	float *normal_x = normals.data();
+	float *normal_y = normal_x + stride;
+	float *normal_z = normal_y + stride;
+
+	uint32_t generated_indices = 0;
+	for (size_t i = 0; i < selected_nodes.size(); ++i)
+	{
+		const Node &node = selected_nodes[i];
+		const auto *tile = pyramid.find_tile(node.level, node.x, node.y);
+		if (!tile)
+		{
+			continue;
+		}
+
+		std::transform(tile->samples.begin(), tile->samples.end(), heights.begin(), [](uint16_t sample) { return sample / 65535.0f; });
+
+		// Coordinates of the first sample of the node and distance between samples, in samples of the finest level
+		uint32_t sample_spacing = 1u << node.level;
+		uint32_t sample_x       = node.x * tile_size * sample_spacing;
+		uint32_t sample_y       = node.y * tile_size * sample_spacing;
+		float    dimension      = static_cast<float>(pyramid.get_dimension());
+		float    world_spacing  = world_size * sample_spacing / dimension;
+		float    gradient_scale = normal_scale / world_spacing;
+
+		uint32_t     base_vertex    = static_cast<uint32_t>(i) * vertex_count;
+		PatchVertex *patch_vertices = &vertices[base_vertex];
+		for (uint32_t y = 0; y < side; ++y)
+		{
+			const float *row = &heights[(y + HeightTilePyramid::TILE_BORDER) * stride];
+			compute_normal_row(row - stride, row, row + stride, side, gradient_scale, normal_x, normal_y, normal_z);
+
+			for (uint32_t x = 0; x < side; ++x)
+			{
+				glm::vec2 uv{static_cast<float>(sample_x + x * sample_spacing) / dimension, static_cast<float>(sample_y + y * sample_spacing) / dimension};
+
+				// The tessellation evaluation shader displaces the vertices with the heightmap
+				patch_vertices[y * side + x] = {glm::vec3(uv.x * world_size - world_size * 0.5f, 0.0f, uv.y * world_size - world_size * 0.5f),
+				                                glm::vec3(normal_x[x], normal_y[x], normal_z[x]),
+				                                uv};
+			}
+		}
+
+		for (uint32_t y = 0; y < tile_size; ++y)
+		{
+			for (uint32_t x = 0; x < tile_size; ++x)
+			{
+				uint32_t *quad = &indices[generated_indices];
+				quad[0]        = base_vertex + x + y * side;
+				quad[1]        = quad[0] + side;
+				quad[2]        = quad[1] + 1;
+				quad[3]        = quad[0] + 1;
+				generated_indices += 4;
+			}
+		}
+	}
+
+	return generated_indices;
+}
+
+void TerrainQuadtree::set_lod_factor(float lod_factor_)
+{
+	lod_factor = lod_factor_;
+}
+
+void TerrainQuadtree::set_normal_scale(float normal_scale_)
+{
+	normal_scale = normal_scale_;
+}
+
+uint32_t TerrainQuadtree::get_max_nodes() const
+{
+	return max_nodes;
+}
+
+uint32_t TerrainQuadtree::get_patch_vertex_count() const
+{
+	return (pyramid.get_tile_size() + 1) * (pyramid.get_tile_size() + 1);
+}
+
+uint32_t TerrainQuadtree::get_patch_index_count() const
+{
+	return pyramid.get_tile_size() * pyramid.get_tile_size() * 4;
+}
+
+const std::vector<TerrainQuadtree::Node> &TerrainQuadtree::get_selected_nodes() const
+{
+	return selected_nodes;
+}
+
+const TerrainQuadtree::Statistics &TerrainQuadtree::get_statistics() const
+{
+	return statistics;
+}
+}        // namespace vkb
@@ -0,0 +1,137 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "common/glm_common.h"
+#include "geometry/frustum.h"
+#include "geometry/height_tile_pyramid.h"
+
+namespace vkb
+{
+/**
+ * @brief Selects the tiles of a HeightTilePyramid to draw as terrain patches, with a level of detail based on distance
+ *
+ * The terrain spans world_size units on the x and z axes, centered on the origin. Heights displace the terrain towards
+ * negative y by up to height_scale units, as the tessellation shaders of the terrain do. Each selected node is drawn
+ * as a patch of tile_size * tile_size quads, so the number of vertices drawn only depends on the number of nodes.
+ */
+class TerrainQuadtree
+{
+  public:
+	struct PatchVertex
+	{
+		glm::vec3 position;
+		glm::vec3 normal;
+		glm::vec2 uv;
+	};
+
+	struct Node
+	{
+		uint32_t level = 0;
+
+		uint32_t x = 0;
+
+		uint32_t y = 0;
+
+		bool operator==(const Node &other) const = default;
+	};
+
+	struct Statistics
+	{
+		size_t visited_nodes = 0;
+
+		size_t culled_nodes = 0;
+
+		size_t selected_nodes = 0;
+	};
+
+	/**
+	 * @param pyramid Tiles of the heightmap, tiles are requested from it as the selection needs them
+	 * @param world_size Size of the terrain on the x and z axes
+	 * @param height_scale Displacement of the highest height
+	 * @param max_nodes Maximum number of selected nodes
+	 */
+	TerrainQuadtree(HeightTilePyramid &pyramid, float world_size, float height_scale, uint32_t max_nodes);
+
+	/**
+	 * @brief Selects the visible nodes, splitting the nodes close to the camera whose child tiles are resident
+	 *        Missing child tiles are requested, so that the next selections can use them once streamed
+	 * @return Whether the selection changed
+	 */
+	bool select(Frustum &frustum, const glm::vec3 &camera_position);
+
+	/**
+	 * @brief Generates the patches of the selected nodes
+	 * @param vertices Storage for get_patch_vertex_count vertices per selected node
+	 * @param indices Storage for get_patch_index_count indices per selected node, four per quad
+	 * @return Number of indices generated
+	 */
+	uint32_t generate_patches(std::span<PatchVertex> vertices, std::span<uint32_t> indices);
+
+	/**
+	 * @brief Sets the distance to a node, relative to its size, under which it is split
+	 */
+	void set_lod_factor(float lod_factor);
+
+	/**
+	 * @brief Sets the world distance between samples for which the filtered height gradients are used unscaled
+	 */
+	void set_normal_scale(float normal_scale);
+
+	uint32_t get_max_nodes() const;
+
+	uint32_t get_patch_vertex_count() const;
+
+	uint32_t get_patch_index_count() const;
+
+	const std::vector<Node> &get_selected_nodes() const;
+
+	const Statistics &get_statistics() const;
+
+  private:
+	HeightTilePyramid &pyramid;
+
+	float world_size = 0.0f;
+
+	float height_scale = 0.0f;
+
+	uint32_t max_nodes = 0;
+
+	float lod_factor = 2.0f;
+
+	float normal_scale = 2.0f;
+
+	std::vector<Node> selected_nodes;
+
+	// Selection of the previous call to select, to detect changes
+	std::vector<Node> previous_nodes;
+
+	// Nodes left to visit while selecting
+	std::vector<Node> node_stack;
+
+	// Heights of a tile including its border, converted once per patch for filtering
+	std::vector<float> heights;
+
+	std::vector<float> normals;
+
+	Statistics statistics;
+};
+}        // namespace vkb
@@ -19,6 +19,8 @@
 #define TINYGLTF_IMPLEMENTATION
 #include "gltf_loader.h"
 
+#include <cmath>
+#include <cstring>
 #include <future>
 #include <limits>
 #include <queue>
@@ -26,6 +28,7 @@
 #include "common/error.h"
 
 #include "common/glm_common.h"
+#include <glm/gtc/packing.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <core/util/profiling.hpp>
@@ -37,6 +40,7 @@
 #include "core/image.h"
 #include "core/util/logging.hpp"
 #include "filesystem/legacy.h"
+#include "geometry/mesh_optimizer.h"
 #include "scene_graph/components/camera.h"
 #include "scene_graph/components/image.h"
 #include "scene_graph/components/image/astc.h"
@@ -284,23 +288,8 @@ inline std::vector<uint8_t> convert_underlying_data_stride(const std::vector<uin
 	return result;
 }
 
-inline void upload_image_to_gpu(vkb::core::CommandBufferC &command_buffer, vkb::core::BufferC &staging_buffer, sg::Image &image)
+inline vkb::core::UploadToken upload_image_to_gpu(vkb::core::UploadManager &upload_manager, sg::Image &image)
 {
-	// Clean up the image data, as they are copied in the staging buffer
-	image.clear_data();
-
-	{
-		ImageMemoryBarrier memory_barrier{};
-		memory_barrier.old_layout      = VK_IMAGE_LAYOUT_UNDEFINED;
-		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		memory_barrier.src_access_mask = 0;
-		memory_barrier.dst_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_HOST_BIT;
-		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-
-		command_buffer.image_memory_barrier(image.get_vk_image_view(), memory_barrier);
-	}
-
 	// Create a buffer image copy for every mip level
 	auto &mipmaps = image.get_mipmaps();
 
@@ -318,19 +307,16 @@ inline void upload_image_to_gpu(vkb::core::CommandBufferC &command_buffer, vkb::
 		copy_region.imageExtent               = mipmap.extent;
 	}
 
-	command_buffer.copy_buffer_to_image(staging_buffer, image.get_vk_image(), buffer_copy_regions);
+	auto token = upload_manager.upload_image(image.get_data().data(),
+	                                         image.get_data().size(),
+	                                         image.get_vk_image().get_handle(),
+	                                         buffer_copy_regions,
+	                                         image.get_vk_image_view().get_subresource_range());
 
-	{
-		ImageMemoryBarrier memory_barrier{};
-		memory_barrier.old_layout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		memory_barrier.src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		memory_barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	// Clean up the image data, as they are copied in the staging ring
+	image.clear_data();
 
-		command_buffer.image_memory_barrier(image.get_vk_image_view(), memory_barrier);
-	}
+	return token;
 }
 
 inline void prepare_meshlets(std::vector<Meshlet> &meshlets, std::unique_ptr<vkb::sg::SubMesh> &submesh, std::vector<unsigned char> &index_data)
@@ -383,6 +369,325 @@ inline void prepare_meshlets(std::vector<Meshlet> &meshlets, std::unique_ptr<vkb
 	}
 }
 
+/**
+ * @brief Packs all vertex attributes of a primitive into one interleaved vertex stream, quantizing float attributes as requested
+ * @return The interleaved vertex data, the attributes of the submesh are set to point into it
+ */
+inline std::vector<uint8_t> interleave_vertex_attributes(const tinygltf::Model &model, const tinygltf::Primitive &gltf_primitive, const GLTFLoader::VertexLayout &layout, sg::SubMesh &submesh)
+{
+	enum class Conversion
+	{
+		Copy,
+		Snorm16,
+		Half,
+		BoundsUnorm16
+	};
+
+	struct InterleavedAttribute
+	{
+		std::string name;
+		uint32_t    accessor_id;
+		uint32_t    component_count;
+		uint32_t    source_size;
+		Conversion  conversion;
+		VkFormat    format;
+		uint32_t    offset;
+	};
+
+	std::vector<InterleavedAttribute> attributes;
+	uint32_t                          stride       = 0;
+	size_t                            vertex_count = 0;
+
+	for (auto &attribute : gltf_primitive.attributes)
+	{
+		std::string attrib_name = attribute.first;
+		std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
+
+		assert(attribute.second < model.accessors.size());
+		auto &accessor = model.accessors[attribute.second];
+
+		InterleavedAttribute interleaved{};
+		interleaved.name            = attrib_name;
+		interleaved.accessor_id     = to_u32(attribute.second);
+		interleaved.component_count = to_u32(tinygltf::GetNumComponentsInType(accessor.type));
+		interleaved.source_size     = interleaved.component_count * to_u32(tinygltf::GetComponentSizeInBytes(accessor.componentType));
+		interleaved.conversion      = Conversion::Copy;
+		interleaved.format          = get_attribute_format(&model, attribute.second);
+
+		uint32_t size = interleaved.source_size;
+
+		if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT)
+		{
+			if (layout.quantize_normals && (attrib_name == "normal" || attrib_name == "tangent"))
+			{
+				interleaved.conversion = Conversion::Snorm16;
+				interleaved.format     = VK_FORMAT_R16G16B16A16_SNORM;
+				size                   = 4 * sizeof(int16_t);
+			}
+			else if (layout.quantize_texcoords && attrib_name.rfind("texcoord_", 0) == 0 && interleaved.component_count == 2)
+			{
+				interleaved.conversion = Conversion::Half;
+				interleaved.format     = VK_FORMAT_R16G16_SFLOAT;
+				size                   = 2 * sizeof(uint16_t);
+			}
+			else if (layout.quantize_positions && attrib_name == "position" && interleaved.component_count == 3)
+			{
+				interleaved.conversion = Conversion::BoundsUnorm16;
+				interleaved.format     = VK_FORMAT_R16G16B16A16_UNORM;
+				size                   = 4 * sizeof(uint16_t);
+			}
+		}
+
+		// Keep every attribute 4 byte aligned
+		interleaved.offset = stride;
+		stride += (size + 3) & ~3u;
+
+		if (attrib_name == "position")
+		{
+			vertex_count = accessor.count;
+		}
+
+		attributes.push_back(interleaved);
+	}
+
+	if (vertex_count == 0 && !attributes.empty())
+	{
+		vertex_count = model.accessors[attributes.front().accessor_id].count;
+	}
+
+	std::vector<uint8_t> vertex_data(vertex_count * stride, 0);
+
+	for (auto &attribute : attributes)
+	{
+		auto &accessor    = model.accessors[attribute.accessor_id];
+		auto &buffer_view = model.bufferViews[accessor.bufferView];
+		auto &buffer      = model.buffers[buffer_view.buffer];
+
+		size_t         source_stride = accessor.ByteStride(buffer_view);
+		const uint8_t *source        = buffer.data.data() + accessor.byteOffset + buffer_view.byteOffset;
+		uint8_t       *destination   = vertex_data.data() + attribute.offset;
+
+		assert(accessor.count == vertex_count && "All attributes of a primitive need to have the same count");
+
+		// Positions are stored relative to the bounding box of the primitive, which the vertex shader scales back
+		glm::vec3 bounds_min{0.0f};
+		glm::vec3 bounds_extent{1.0f};
+		if (attribute.conversion == Conversion::BoundsUnorm16)
+		{
+			glm::vec3 bounds_max{std::numeric_limits<float>::lowest()};
+			bounds_min = glm::vec3{std::numeric_limits<float>::max()};
+
+			const uint8_t *position = source;
+			for (size_t vertex = 0; vertex < vertex_count; ++vertex, position += source_stride)
+			{
+				glm::vec3 value;
+				std::memcpy(&value, position, sizeof(value));
+				bounds_min = glm::min(bounds_min, value);
+				bounds_max = glm::max(bounds_max, value);
+			}
+
+			// A flat axis keeps a unit extent, so that its quantized value of 0 maps back to the minimum
+			bounds_extent = bounds_max - bounds_min;
+			for (glm::length_t axis = 0; axis < 3; ++axis)
+			{
+				if (bounds_extent[axis] <= 0.0f)
+				{
+					bounds_extent[axis] = 1.0f;
+				}
+			}
+
+			submesh.position_scale = bounds_extent;
+			submesh.position_bias  = bounds_min;
+		}
+
+		for (size_t vertex = 0; vertex < vertex_count; ++vertex, source += source_stride, destination += stride)
+		{
+			switch (attribute.conversion)
+			{
+				case Conversion::Copy:
+					std::memcpy(destination, source, attribute.source_size);
+					break;
+				case Conversion::Snorm16:
+				{
+					float   values[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+					int16_t packed[4];
+					std::memcpy(values, source, attribute.component_count * sizeof(float));
+					for (uint32_t i = 0; i < 4; ++i)
+					{
+						packed[i] = static_cast<int16_t>(std::round(glm::clamp(values[i], -1.0f, 1.0f) * 32767.0f));
+					}
+					std::memcpy(destination, packed, sizeof(packed));
+					break;
+				}
+				case Conversion::Half:
+				{
+					float    values[2];
+					uint16_t packed[2];
+					std::memcpy(values, source, sizeof(values));
+					for (uint32_t i = 0; i < 2; ++i)
+					{
+						packed[i] = glm::packHalf1x16(values[i]);
+					}
+					std::memcpy(destination, packed, sizeof(packed));
+					break;
+				}
+				case Conversion::BoundsUnorm16:
+				{
+					glm::vec3 value;
+					std::memcpy(&value, source, sizeof(value));
+
+					// A fourth component of 1.0 keeps the data valid for shaders consuming a vec4
+					uint16_t packed[4] = {0, 0, 0, 65535};
+					for (glm::length_t i = 0; i < 3; ++i)
+					{
+						packed[i] = static_cast<uint16_t>(std::round(glm::clamp((value[i] - bounds_min[i]) / bounds_extent[i], 0.0f, 1.0f) * 65535.0f));
+					}
+					std::memcpy(destination, packed, sizeof(packed));
+					break;
+				}
+			}
+		}
+
+		sg::VertexAttribute attrib;
+		attrib.format = attribute.format;
+		attrib.stride = stride;
+		attrib.offset = attribute.offset;
+
+		submesh.set_attribute(attribute.name, attrib);
+	}
+
+	submesh.vertices_count = to_u32(vertex_count);
+
+	return vertex_data;
+}
+
+inline bool is_triangle_list(const tinygltf::Primitive &gltf_primitive)
+{
+	// A missing mode defaults to triangles
+	return gltf_primitive.mode == TINYGLTF_MODE_TRIANGLES || gltf_primitive.mode == -1;
+}
+
+inline std::vector<uint32_t> get_indices_u32(const tinygltf::Model &model, uint32_t accessor_id)
+{
+	auto &accessor    = model.accessors[accessor_id];
+	auto &buffer_view = model.bufferViews[accessor.bufferView];
+	auto &buffer      = model.buffers[buffer_view.buffer];
+
+	size_t         stride = accessor.ByteStride(buffer_view);
+	const uint8_t *data   = buffer.data.data() + accessor.byteOffset + buffer_view.byteOffset;
+
+	std::vector<uint32_t> indices(accessor.count);
+
+	for (size_t i = 0; i < accessor.count; ++i, data += stride)
+	{
+		switch (accessor.componentType)
+		{
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+				indices[i] = *data;
+				break;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+				indices[i] = *reinterpret_cast<const uint16_t *>(data);
+				break;
+			default:
+				indices[i] = *reinterpret_cast<const uint32_t *>(data);
+				break;
+		}
+	}
+
+	return indices;
+}
+
+/**
+ * @brief Reads the float positions of a primitive, returns an empty vector if they are stored in any other format
+ */
+inline std::vector<glm::vec3> get_positions(const tinygltf::Model &model, uint32_t accessor_id)
+{
+	auto &accessor = model.accessors[accessor_id];
+
+	if (accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || accessor.type != TINYGLTF_TYPE_VEC3)
+	{
+		return {};
+	}
+
+	auto &buffer_view = model.bufferViews[accessor.bufferView];
+	auto &buffer      = model.buffers[buffer_view.buffer];
+
+	size_t         stride = accessor.ByteStride(buffer_view);
+	const uint8_t *data   = buffer.data.data() + accessor.byteOffset + buffer_view.byteOffset;
+
+	std::vector<glm::vec3> positions(accessor.count);
+
+	for (size_t i = 0; i < accessor.count; ++i, data += stride)
+	{
+		std::memcpy(&positions[i], data, sizeof(glm::vec3));
+	}
+
+	return positions;
+}
+
+/**
+ * @brief Optimizes the triangle and vertex order of an indexed triangle list
+ * @return The optimized mesh, which is empty if the primitive can't be optimized
+ */
+inline OptimizedMesh optimize_primitive(const tinygltf::Model &model, const tinygltf::Primitive &gltf_primitive, const std::string &name)
+{
+	auto position = gltf_primitive.attributes.find("POSITION");
+
+	if (gltf_primitive.indices < 0 || !is_triangle_list(gltf_primitive) || position == gltf_primitive.attributes.end())
+	{
+		return {};
+	}
+
+	Timer timer;
+	timer.start();
+
+	auto optimized = optimize_mesh(get_indices_u32(model, gltf_primitive.indices),
+	                               get_positions(model, position->second),
+	                               to_u32(model.accessors[position->second].count));
+
+	auto elapsed = timer.stop<Timer::Milliseconds>();
+
+	LOGD("{}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f} ({} in {:.2f} ms)", name,
+	     optimized.before.acmr(), optimized.after.acmr(), optimized.before.atvr(), optimized.after.atvr(),
+	     optimized.from_cache ? "cached" : "optimized", elapsed);
+
+	return optimized;
+}
+
+/**
+ * @brief Reorders vertex data with the given stride, following the vertex order of an optimized mesh
+ */
+inline std::vector<uint8_t> remap_vertex_data(const std::vector<uint8_t> &vertex_data, size_t stride, const std::vector<uint32_t> &vertex_order)
+{
+	assert(vertex_data.size() >= vertex_order.size() * stride);
+
+	std::vector<uint8_t> result(vertex_data.size());
+
+	for (size_t vertex = 0; vertex < vertex_order.size(); ++vertex)
+	{
+		std::memcpy(result.data() + vertex * stride, vertex_data.data() + vertex_order[vertex] * stride, stride);
+	}
+
+	return result;
+}
+
+inline std::vector<uint8_t> pack_indices(const std::vector<uint32_t> &indices, VkIndexType index_type)
+{
+	if (index_type == VK_INDEX_TYPE_UINT16)
+	{
+		std::vector<uint8_t> result(indices.size() * sizeof(uint16_t));
+		auto                *destination = reinterpret_cast<uint16_t *>(result.data());
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			destination[i] = static_cast<uint16_t>(indices[i]);
+		}
+		return result;
+	}
+
+	auto *source = reinterpret_cast<const uint8_t *>(indices.data());
+	return {source, source + indices.size() * sizeof(uint32_t)};
+}
+
 static inline bool texture_needs_srgb_colorspace(const std::string &name)
 {
 	// The gltf spec states that the base and emissive textures MUST be encoded with the sRGB
@@ -407,6 +712,11 @@ GLTFLoader::GLTFLoader(vkb::core::DeviceC &device) :
 {
 }
 
+void GLTFLoader::set_vertex_layout(const VertexLayout &layout)
+{
+	vertex_layout = layout;
+}
+
 std::unique_ptr<vkb::scene_graph::SceneC> GLTFLoader::read_scene_from_file(const std::string &file_name, int scene_index, VkBufferUsageFlags additional_buffer_usage_flags)
 {
 	PROFILE_SCOPE("Load GLTF Scene");
@@ -567,54 +877,21 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 
 	std::vector<std::unique_ptr<sg::Image>> image_components;
 
-	// Upload images to GPU. We do this in batches of 64MB of data to avoid needing
-	// double the amount of memory (all the images and all the corresponding buffers).
-	// This helps keep memory footprint lower which is helpful on smaller devices.
-	size_t image_index = 0;
-	while (image_index < image_count)
+	// Upload images to GPU through the staging ring of the upload manager. Each image is released once it is copied
+	// into the ring, and ring space is reused as the copies complete. This keeps the memory footprint low on smaller
+	// devices, without stalling between batches of images.
+	auto                  &upload_manager = device.get_upload_manager();
+	vkb::core::UploadToken upload_token;
+	for (size_t image_index = 0; image_index < image_count; ++image_index)
 	{
-		std::vector<vkb::core::BufferC> transient_buffers;
-
-		auto command_buffer = device.get_command_pool().request_command_buffer();
-
-		command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, 0);
-
-		size_t batch_size = 0;
-
-		// Deal with 64MB of image data at a time to keep memory footprint low
-		while (image_index < image_count && batch_size < 64 * 1024 * 1024)
-		{
-			// Wait for this image to complete loading, then stage for upload
-			image_components.push_back(image_component_futures[image_index].get());
-
-			auto &image = image_components[image_index];
-
-			core::Buffer stage_buffer = vkb::core::BufferC::create_staging_buffer(device, image->get_data());
+		// Wait for this image to complete loading, then stage for upload
+		image_components.push_back(image_component_futures[image_index].get());
 
-			batch_size += image->get_data().size();
-
-			upload_image_to_gpu(*command_buffer, stage_buffer, *image);
-
-			transient_buffers.push_back(std::move(stage_buffer));
-
-			image_index++;
-		}
-
-		command_buffer->end();
-
-		auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-		queue.submit(*command_buffer, device.get_fence_pool().request_fence());
-
-		device.get_fence_pool().wait();
-		device.get_fence_pool().reset();
-		device.get_command_pool().reset_pool();
-		device.wait_idle();
-
-		// Remove the staging buffers for the batch we just processed
-		transient_buffers.clear();
+		upload_token = upload_image_to_gpu(upload_manager, *image_components.back());
 	}
 
+	upload_manager.wait(upload_token);
+
 	scene.set_components(std::move(image_components));
 
 	auto elapsed_time = timer.stop();
@@ -672,8 +949,8 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 	}
 
 	// Load materials
-	bool                            has_textures = scene.has_component<sg::Texture>();
-	std::vector<vkb::sg::Texture *> textures;
+	bool                                has_textures = scene.has_component<sg::Texture>();
+	std::span<vkb::sg::Texture *const> textures;
 	if (has_textures)
 	{
 		textures = scene.get_components<sg::Texture>();
@@ -727,6 +1004,17 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 	// Load meshes
 	auto materials = scene.get_components<sg::PBRMaterial>();
 
+	const bool interleave_vertices = vertex_layout.interleaved || vertex_layout.shared_buffer;
+
+	// Interleaved vertices of all submeshes, when they share a single vertex buffer
+	std::vector<uint8_t>                                shared_vertex_data;
+	std::vector<std::pair<sg::SubMesh *, VkDeviceSize>> shared_vertex_submeshes;
+
+	size_t vertex_buffer_bytes = 0;
+
+	VertexCacheStatistics vertex_cache_before;
+	VertexCacheStatistics vertex_cache_after;
+
 	for (auto &gltf_mesh : model.meshes)
 	{
 		PROFILE_SCOPE("Processing Mesh");
@@ -740,12 +1028,60 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 			auto submesh_name = fmt::format("'{}' mesh, primitive #{}", gltf_mesh.name, i_primitive);
 			auto submesh      = std::make_unique<sg::SubMesh>(std::move(submesh_name));
 
+			OptimizedMesh optimized;
+			if (vertex_layout.optimize_vertex_order)
+			{
+				optimized = optimize_primitive(model, gltf_primitive, submesh->get_name());
+				vertex_cache_before += optimized.before;
+				vertex_cache_after += optimized.after;
+			}
+
+			if (interleave_vertices)
+			{
+				auto vertex_data = interleave_vertex_attributes(model, gltf_primitive, vertex_layout, *submesh);
+				vertex_buffer_bytes += vertex_data.size();
+
+				if (!optimized.vertex_order.empty())
+				{
+					vertex_data = remap_vertex_data(vertex_data, vertex_data.size() / optimized.vertex_order.size(), optimized.vertex_order);
+				}
+
+				if (vertex_layout.shared_buffer)
+				{
+					// Align each submesh to 16 bytes, which satisfies the alignment of all attribute formats
+					shared_vertex_data.resize((shared_vertex_data.size() + 15) & ~size_t(15));
+					shared_vertex_submeshes.emplace_back(submesh.get(), shared_vertex_data.size());
+					shared_vertex_data.insert(shared_vertex_data.end(), vertex_data.begin(), vertex_data.end());
+				}
+				else if (!vertex_data.empty())
+				{
+					submesh->interleaved_vertex_buffer = std::make_shared<vkb::core::BufferC>(device,
+					                                                                          vertex_data.size(),
+					                                                                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
+					                                                                          VMA_MEMORY_USAGE_CPU_TO_GPU);
+					submesh->interleaved_vertex_buffer->update(vertex_data);
+					submesh->interleaved_vertex_buffer->set_debug_name(fmt::format("'{}' mesh, primitive #{}: interleaved vertex buffer",
+					                                                               gltf_mesh.name, i_primitive));
+				}
+			}
+
 			for (auto &attribute : gltf_primitive.attributes)
 			{
+				if (interleave_vertices)
+				{
+					break;
+				}
+
 				std::string attrib_name = attribute.first;
 				std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
 
 				auto vertex_data = get_attribute_data(&model, attribute.second);
+				vertex_buffer_bytes += vertex_data.size();
+
+				if (!optimized.vertex_order.empty())
+				{
+					vertex_data = remap_vertex_data(vertex_data, get_attribute_stride(&model, attribute.second), optimized.vertex_order);
+				}
 
 				if (attrib_name == "position")
 				{
@@ -796,6 +1132,11 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 						break;
 				}
 
+				if (!optimized.indices.empty())
+				{
+					index_data = pack_indices(optimized.indices, submesh->index_type);
+				}
+
 				submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
 				                                                             index_data.size(),
 				                                                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | additional_buffer_usage_flags,
@@ -828,6 +1169,31 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 		scene.add_component(std::move(mesh));
 	}
 
+	if (!shared_vertex_data.empty())
+	{
+		auto shared_vertex_buffer = std::make_shared<vkb::core::BufferC>(device,
+		                                                                 shared_vertex_data.size(),
+		                                                                 VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
+		                                                                 VMA_MEMORY_USAGE_CPU_TO_GPU);
+		shared_vertex_buffer->update(shared_vertex_data);
+		shared_vertex_buffer->set_debug_name("shared interleaved vertex buffer");
+
+		for (auto &[submesh, offset] : shared_vertex_submeshes)
+		{
+			submesh->interleaved_vertex_buffer = shared_vertex_buffer;
+			submesh->interleaved_vertex_offset = offset;
+		}
+	}
+
+	LOGI("Vertex data: {} KB in {} layout", vertex_buffer_bytes / 1024,
+	     vertex_layout.shared_buffer ? "shared interleaved" : (vertex_layout.interleaved ? "interleaved" : "separate"));
+
+	if (vertex_cache_before.triangle_count > 0)
+	{
+		LOGI("Vertex cache ({} triangles): ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}", vertex_cache_before.triangle_count,
+		     vertex_cache_before.acmr(), vertex_cache_after.acmr(), vertex_cache_before.atvr(), vertex_cache_after.atvr());
+	}
+
 	device.get_fence_pool().wait();
 	device.get_fence_pool().reset();
 	device.get_command_pool().reset_pool();
@@ -1100,13 +1466,9 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 
 	auto submesh = std::make_unique<sg::SubMesh>();
 
-	std::vector<vkb::core::BufferC> transient_buffers;
-
-	auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-	auto command_buffer = device.get_command_pool().request_command_buffer();
-
-	command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+	// All buffers of the submesh are uploaded in one batch, which is waited for once at the end
+	auto                  &upload_manager = device.get_upload_manager();
+	vkb::core::UploadToken upload_token;
 
 	assert(index < model.meshes.size());
 	auto &gltf_mesh = model.meshes[index];
@@ -1173,47 +1535,53 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 
 	bool has_skin = (joints && weights);
 
+	OptimizedMesh optimized;
+	if (vertex_layout.optimize_vertex_order)
+	{
+		optimized = optimize_primitive(model, gltf_primitive, fmt::format("'{}' mesh", gltf_mesh.name));
+	}
+
 	if (storage_buffer)
 	{
 		for (size_t v = 0; v < vertex_count; v++)
 		{
+			const size_t src = optimized.vertex_order.empty() ? v : optimized.vertex_order[v];
+
 			AlignedVertex vert{};
-			vert.pos    = glm::vec4(glm::make_vec3(&pos[v * 3]), 1.0f);
-			vert.normal = normals ? glm::vec4(glm::normalize(glm::make_vec3(&normals[v * 3])), 0.0f) : glm::vec4(0.0f);
+			vert.pos    = glm::vec4(glm::make_vec3(&pos[src * 3]), 1.0f);
+			vert.normal = normals ? glm::vec4(glm::normalize(glm::make_vec3(&normals[src * 3])), 0.0f) : glm::vec4(0.0f);
 			aligned_vertex_data.push_back(vert);
 		}
 
-		vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(device, aligned_vertex_data);
-
 		vkb::core::BufferC buffer{device,
 		                          aligned_vertex_data.size() * sizeof(AlignedVertex),
 		                          VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
 		                          VMA_MEMORY_USAGE_GPU_ONLY};
 
-		command_buffer->copy_buffer(stage_buffer, buffer, aligned_vertex_data.size() * sizeof(AlignedVertex));
+		upload_token = upload_manager.upload_buffer(aligned_vertex_data.data(), aligned_vertex_data.size() * sizeof(AlignedVertex), buffer.get_handle());
 
 		auto pair = std::make_pair("vertex_buffer", std::move(buffer));
 		submesh->vertex_buffers.insert(std::move(pair));
-
-		transient_buffers.push_back(std::move(stage_buffer));
 	}
 	else
 	{
 		for (size_t v = 0; v < vertex_count; v++)
 		{
+			const size_t src = optimized.vertex_order.empty() ? v : optimized.vertex_order[v];
+
 			Vertex vert{};
-			vert.pos    = glm::vec4(glm::make_vec3(&pos[v * 3]), 1.0f);
-			vert.normal = glm::normalize(glm::vec3(normals ? glm::make_vec3(&normals[v * 3]) : glm::vec3(0.0f)));
-			vert.uv     = uvs ? glm::make_vec2(&uvs[v * 2]) : glm::vec3(0.0f);
+			vert.pos    = glm::vec4(glm::make_vec3(&pos[src * 3]), 1.0f);
+			vert.normal = glm::normalize(glm::vec3(normals ? glm::make_vec3(&normals[src * 3]) : glm::vec3(0.0f)));
+			vert.uv     = uvs ? glm::make_vec2(&uvs[src * 2]) : glm::vec3(0.0f);
 			if (colors)
 			{
 				switch (color_component_count)
 				{
 					case 3:
-						vert.color = glm::vec4(glm::make_vec3(&colors[v * 3]), 1.0f);
+						vert.color = glm::vec4(glm::make_vec3(&colors[src * 3]), 1.0f);
 						break;
 					case 4:
-						vert.color = glm::make_vec4(&colors[v * 4]);
+						vert.color = glm::make_vec4(&colors[src * 4]);
 						break;
 				}
 			}
@@ -1221,24 +1589,20 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 			{
 				vert.color = glm::vec4(1.0f);
 			}
-			vert.joint0  = has_skin ? glm::vec4(glm::make_vec4(&joints[v * 4])) : glm::vec4(0.0f);
-			vert.weight0 = has_skin ? glm::make_vec4(&weights[v * 4]) : glm::vec4(0.0f);
+			vert.joint0  = has_skin ? glm::vec4(glm::make_vec4(&joints[src * 4])) : glm::vec4(0.0f);
+			vert.weight0 = has_skin ? glm::make_vec4(&weights[src * 4]) : glm::vec4(0.0f);
 			vertex_data.push_back(vert);
 		}
 
-		vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(device, vertex_data);
-
 		vkb::core::BufferC buffer{device,
 		                          vertex_data.size() * sizeof(Vertex),
 		                          VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
 		                          VMA_MEMORY_USAGE_GPU_ONLY};
 
-		command_buffer->copy_buffer(stage_buffer, buffer, vertex_data.size() * sizeof(Vertex));
+		upload_token = upload_manager.upload_buffer(vertex_data.data(), vertex_data.size() * sizeof(Vertex), buffer.get_handle());
 
 		auto pair = std::make_pair("vertex_buffer", std::move(buffer));
 		submesh->vertex_buffers.insert(std::move(pair));
-
-		transient_buffers.push_back(std::move(stage_buffer));
 	}
 
 	if (gltf_primitive.indices >= 0)
@@ -1274,6 +1638,11 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 		// Always do uint32
 		submesh->index_type = VK_INDEX_TYPE_UINT32;
 
+		if (!optimized.indices.empty())
+		{
+			index_data = pack_indices(optimized.indices, submesh->index_type);
+		}
+
 		if (storage_buffer)
 		{
 			// prepare meshlets
@@ -1283,39 +1652,25 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 			// vertex_indices and index_buffer are used for meshlets now
 			submesh->vertex_indices = static_cast<uint32_t>(meshlets.size());
 
-			vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(device, meshlets);
-
 			submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
 			                                                             meshlets.size() * sizeof(Meshlet),
 			                                                             VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
 			                                                             VMA_MEMORY_USAGE_GPU_ONLY);
 
-			command_buffer->copy_buffer(stage_buffer, *submesh->index_buffer, meshlets.size() * sizeof(Meshlet));
-
-			transient_buffers.push_back(std::move(stage_buffer));
+			upload_token = upload_manager.upload_buffer(meshlets.data(), meshlets.size() * sizeof(Meshlet), submesh->index_buffer->get_handle());
 		}
 		else
 		{
-			vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(device, index_data);
-
 			submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
 			                                                             index_data.size(),
 			                                                             VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
 			                                                             VMA_MEMORY_USAGE_GPU_ONLY);
 
-			command_buffer->copy_buffer(stage_buffer, *submesh->index_buffer, index_data.size());
-
-			transient_buffers.push_back(std::move(stage_buffer));
+			upload_token = upload_manager.upload_buffer(index_data.data(), index_data.size(), submesh->index_buffer->get_handle());
 		}
 	}
 
-	command_buffer->end();
-
-	queue.submit(*command_buffer, device.get_fence_pool().request_fence());
-
-	device.get_fence_pool().wait();
-	device.get_fence_pool().reset();
-	device.get_command_pool().reset_pool();
+	upload_manager.wait(upload_token);
 
 	return std::move(submesh);
 }
@@ -80,10 +80,45 @@ struct TypeCast
 class GLTFLoader
 {
   public:
+	/**
+	 * @brief Controls the layout of the vertex buffers created for the submeshes of a scene
+	 */
+	struct VertexLayout
+	{
+		/// Store all attributes of a submesh interleaved in a single vertex buffer
+		bool interleaved = false;
+
+		/// Store the interleaved vertices of all submeshes in one shared vertex buffer, implies interleaved
+		bool shared_buffer = false;
+
+		/// Store float normals and tangents as snorm16 (interleaved layouts only)
+		bool quantize_normals = false;
+
+		/// Store float texture coordinates as half floats (interleaved layouts only)
+		bool quantize_texcoords = false;
+
+		/**
+		 * @brief Store float positions as unorm16 relative to the bounding box of each submesh (interleaved layouts only)
+		 *
+		 * The vertex shader has to restore model space positions with the SubMesh position_scale and position_bias.
+		 */
+		bool quantize_positions = false;
+
+		/// Reorder triangles for the post-transform vertex cache and overdraw, and vertices for fetch locality.
+		/// Results are cached on disk, so each mesh is only optimized once
+		bool optimize_vertex_order = false;
+	};
+
 	GLTFLoader(vkb::core::DeviceC &device);
 
 	virtual ~GLTFLoader() = default;
 
+	/**
+	 * @brief Sets the vertex buffer layout used by subsequent calls to read_scene_from_file.
+	 *        Only the vertex order is applied by read_model_from_file
+	 */
+	void set_vertex_layout(const VertexLayout &layout);
+
 	std::unique_ptr<vkb::scene_graph::SceneC> read_scene_from_file(const std::string &file_name, int scene_index = -1, VkBufferUsageFlags additional_buffer_usage_flags = 0);
 
 	/**
@@ -139,6 +174,8 @@ class GLTFLoader
 
 	std::string model_path;
 
+	VertexLayout vertex_layout;
+
 	/// The extensions that the GLTFLoader can load mapped to whether they should be enabled or not
 	static std::unordered_map<std::string, bool> supported_extensions;
 
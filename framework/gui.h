@@ -318,6 +318,11 @@ class Gui
 
 	void upload_draw_data(const ImDrawData *draw_data, uint8_t *vertex_data, uint8_t *index_data);
 
+	/**
+	 * @brief Waits for the font upload, the first time the font is used
+	 */
+	void wait_for_font_upload();
+
   private:
 	float                                    content_scale_factor = 1.0f;        //  Scale factor to apply due to a difference between the window and GL pixel sizes
 	DebugView                                debug_view;
@@ -330,6 +335,7 @@ class Gui
 	std::vector<Font>                        fonts;
 	std::unique_ptr<vkb::core::HPPImage>     font_image;
 	std::unique_ptr<vkb::core::HPPImageView> font_image_view;
+	vkb::core::UploadToken                   font_upload_token;
 	std::unique_ptr<vkb::core::BufferCpp>    index_buffer;
 	vk::Pipeline                             pipeline;
 	vkb::core::HPPPipelineLayout            *pipeline_layout = nullptr;
@@ -426,58 +432,20 @@ inline Gui<bindingType>::Gui(
 	font_image_view = std::make_unique<vkb::core::HPPImageView>(*font_image, vk::ImageViewType::e2D);
 	font_image_view->set_debug_name("View on GUI font image");
 
-	// Upload font data into the vulkan image memory
+	// Upload font data into the vulkan image memory, and prepare it for the fragment shader
 	{
-		vkb::core::BufferCpp stage_buffer = vkb::core::BufferCpp::create_staging_buffer(device, upload_size, font_data);
-
-		auto command_buffer = device.get_command_pool().request_command_buffer();
-
-		vkb::HPPFencePool fence_pool{device};
-
-		// Begin recording
-		command_buffer->begin(vk::CommandBufferUsageFlagBits::eOneTimeSubmit, 0);
-
-		{
-			// Prepare for transfer
-			vkb::common::HPPImageMemoryBarrier memory_barrier = {.src_stage_mask  = vk::PipelineStageFlagBits::eHost,
-			                                                     .dst_stage_mask  = vk::PipelineStageFlagBits::eTransfer,
-			                                                     .dst_access_mask = vk::AccessFlagBits::eTransferWrite,
-			                                                     .old_layout      = vk::ImageLayout::eUndefined,
-			                                                     .new_layout      = vk::ImageLayout::eTransferDstOptimal};
-
-			command_buffer->image_memory_barrier(*font_image_view, memory_barrier);
-		}
-
-		// Copy
 		vk::BufferImageCopy buffer_copy_region = {.imageSubresource = {.aspectMask = font_image_view->get_subresource_range().aspectMask,
 		                                                               .layerCount = font_image_view->get_subresource_range().layerCount},
 		                                          .imageExtent      = font_image->get_extent()};
 
-		command_buffer->copy_buffer_to_image(stage_buffer, *font_image, {buffer_copy_region});
-
-		{
-			// Prepare for fragment shader
-			vkb::common::HPPImageMemoryBarrier memory_barrier = {.src_stage_mask  = vk::PipelineStageFlagBits::eTransfer,
-			                                                     .dst_stage_mask  = vk::PipelineStageFlagBits::eFragmentShader,
-			                                                     .src_access_mask = vk::AccessFlagBits::eTransferWrite,
-			                                                     .dst_access_mask = vk::AccessFlagBits::eShaderRead,
-			                                                     .old_layout      = vk::ImageLayout::eTransferDstOptimal,
-			                                                     .new_layout      = vk::ImageLayout::eShaderReadOnlyOptimal};
-
-			command_buffer->image_memory_barrier(*font_image_view, memory_barrier);
-		}
-
-		// End recording
-		command_buffer->end();
-
-		auto &queue = device.get_queue_by_flags(vk::QueueFlagBits::eGraphics, 0);
-
-		queue.submit(*command_buffer, device.get_fence_pool().request_fence());
-
-		// Wait for the command buffer to finish its work before destroying the staging buffer
-		device.get_fence_pool().wait();
-		device.get_fence_pool().reset();
-		device.get_command_pool().reset_pool();
+		// The copy runs while the rest of the sample is prepared, the first draw waits for it
+		auto &upload_manager = device.get_upload_manager();
+		font_upload_token    = upload_manager.upload_image(font_data,
+		                                                   static_cast<vk::DeviceSize>(upload_size),
+		                                                   font_image->get_handle(),
+		                                                   std::span<const vk::BufferImageCopy>(&buffer_copy_region, 1),
+		                                                   font_image_view->get_subresource_range());
+		upload_manager.flush();
 	}
 
 	// Calculate valid filter
@@ -520,6 +488,9 @@ inline Gui<bindingType>::Gui(
 template <vkb::BindingType bindingType>
 inline Gui<bindingType>::~Gui()
 {
+	// The font image may not have been used yet, its copy has to complete before it is destroyed
+	wait_for_font_upload();
+
 	vk::Device device = render_context.get_device().get_handle();
 	device.destroyDescriptorPool(descriptor_pool);
 	device.destroyDescriptorSetLayout(descriptor_set_layout);
@@ -610,6 +581,8 @@ inline void
 		return;
 	}
 
+	wait_for_font_upload();
+
 	command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
 	command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, descriptor_set, {});
 
@@ -680,6 +653,8 @@ inline void Gui<bindingType>::draw_impl(vkb::core::CommandBufferCpp &command_buf
 		return;
 	}
 
+	wait_for_font_upload();
+
 	vkb::core::HPPScopedDebugLabel debug_label{command_buffer, "GUI"};
 
 	// Vertex input state
@@ -1497,6 +1472,15 @@ inline void Gui<bindingType>::upload_draw_data(const ImDrawData *draw_data, uint
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline void Gui<bindingType>::wait_for_font_upload()
+{
+	if (font_upload_token)
+	{
+		render_context.get_device().get_upload_manager().wait(std::exchange(font_upload_token, {}));
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline Gui<bindingType>::StatsView::StatsView(const vkb::stats::Stats<bindingType> *stats)
 {
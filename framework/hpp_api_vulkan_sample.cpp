@@ -25,6 +25,13 @@ VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 
 bool HPPApiVulkanSample::prepare(const vkb::ApplicationOptions &options)
 {
+	// The API samples acquire and present the swapchain images themselves, so they can't render without a swapchain
+	if (options.window && options.window->get_window_mode() == vkb::Window::Mode::Offscreen)
+	{
+		LOGE("{} acquires and presents swapchain images, it does not support the --offscreen window mode", get_name());
+		return false;
+	}
+
 	if (!vkb::VulkanSampleCpp::prepare(options))
 	{
 		return false;
@@ -482,6 +489,12 @@ void HPPApiVulkanSample::draw_ui(const vk::CommandBuffer command_buffer, uint32_
 
 void HPPApiVulkanSample::prepare_frame()
 {
+	if (texture_upload_token)
+	{
+		// Uploads complete in submission order, so waiting on the latest one covers all textures loaded so far
+		get_device().get_upload_manager().wait(std::exchange(texture_upload_token, {}));
+	}
+
 	if (get_render_context().has_swapchain())
 	{
 		handle_surface_changes();
@@ -491,6 +504,9 @@ void HPPApiVulkanSample::prepare_frame()
 		try
 		{
 			std::tie(result, current_buffer) = get_render_context().get_swapchain().acquire_next_image(semaphores.acquired_image_ready);
+
+			// The captures copied the last time this image was presented are read back now
+			get_render_context().collect_captures(current_buffer);
 		}
 		// Recreate the swapchain if it's no longer compatible with the surface (eErrorOutOfDateKHR)
 		// Don't catch other failures here, they are propagated up the calling hierarchy
@@ -511,11 +527,15 @@ void HPPApiVulkanSample::submit_frame()
 
 		vk::SwapchainKHR swapchain = get_render_context().get_swapchain().get_handle();
 
+		// The sample presents without end_frame(), so the captures requested with F12 or --screenshot are copied here,
+		// between the rendering and the presentation, and read back when the image is acquired again
+		vk::Semaphore present_wait_semaphore = get_render_context().submit_capture(current_buffer, semaphores.render_complete);
+
 		vk::PresentInfoKHR present_info{.swapchainCount = 1, .pSwapchains = &swapchain, .pImageIndices = &current_buffer};
 		// Check if a wait semaphore has been specified to wait for before presenting the image
-		if (semaphores.render_complete)
+		if (present_wait_semaphore)
 		{
-			present_info.setWaitSemaphores(semaphores.render_complete);
+			present_info.setWaitSemaphores(present_wait_semaphore);
 		}
 
 		vk::DisplayPresentInfoKHR disp_present_info;
@@ -551,7 +571,9 @@ void HPPApiVulkanSample::submit_frame()
 	// DO NOT USE
 	// vkDeviceWaitIdle and vkQueueWaitIdle are extremely expensive functions, and are used here purely for demonstrating the vulkan API
 	// without having to concern ourselves with proper syncronization. These functions should NEVER be used inside the render loop like this (every frame).
-	get_device().get_queue_by_present(0).get_handle().waitIdle();
+	auto const &queue = get_device().get_queue_by_present(0);
+	auto        guard = queue.lock();
+	queue.get_handle().waitIdle();
 }
 
 HPPApiVulkanSample::~HPPApiVulkanSample()
@@ -906,12 +928,6 @@ HPPTexture HPPApiVulkanSample::load_texture(const std::string &file, vkb::scene_
 	texture.image = vkb::scene_graph::components::HPPImage::load(file, file, content_type);
 	texture.image->create_vk_image(get_device());
 
-	const auto &queue = get_device().get_queue_by_flags(vk::QueueFlagBits::eGraphics, 0);
-
-	vk::CommandBuffer command_buffer = get_device().create_command_buffer(vk::CommandBufferLevel::ePrimary, true);
-
-	vkb::core::BufferCpp stage_buffer = vkb::core::BufferCpp::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<vk::BufferImageCopy> bufferCopyRegions;
 
@@ -934,23 +950,14 @@ HPPTexture HPPApiVulkanSample::load_texture(const std::string &file, vkb::scene_
 
 	vk::ImageSubresourceRange subresource_range{vk::ImageAspectFlagBits::eColor, 0, vkb::to_u32(mipmaps.size()), 0, 1};
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::common::image_layout_transition(
-	    command_buffer, texture.image->get_vk_image().get_handle(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, subresource_range);
-
-	// Copy mip levels from staging buffer
-	command_buffer.copyBufferToImage(
-	    stage_buffer.get_handle(), texture.image->get_vk_image().get_handle(), vk::ImageLayout::eTransferDstOptimal, bufferCopyRegions);
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::common::image_layout_transition(command_buffer,
-	                                     texture.image->get_vk_image().get_handle(),
-	                                     vk::ImageLayout::eTransferDstOptimal,
-	                                     vk::ImageLayout::eShaderReadOnlyOptimal,
-	                                     subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy all mip levels through the staging ring without blocking, the first frame waits for the upload to complete
+	auto &upload_manager = get_device().get_upload_manager();
+	texture_upload_token = upload_manager.upload_image(texture.image->get_data().data(),
+	                                                   texture.image->get_data().size(),
+	                                                   texture.image->get_vk_image().get_handle(),
+	                                                   bufferCopyRegions,
+	                                                   subresource_range);
+	upload_manager.flush();
 
 	texture.sampler = create_default_sampler(address_mode, mipmaps.size(), texture.image->get_format());
 
@@ -964,12 +971,6 @@ HPPTexture HPPApiVulkanSample::load_texture_array(const std::string &file, vkb::
 	texture.image = vkb::scene_graph::components::HPPImage::load(file, file, content_type);
 	texture.image->create_vk_image(get_device(), vk::ImageViewType::e2DArray);
 
-	const auto &queue = get_device().get_queue_by_flags(vk::QueueFlagBits::eGraphics, 0);
-
-	vk::CommandBuffer command_buffer = get_device().create_command_buffer(vk::CommandBufferLevel::ePrimary, true);
-
-	vkb::core::BufferCpp stage_buffer = vkb::core::BufferCpp::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<vk::BufferImageCopy> buffer_copy_regions;
 
@@ -998,23 +999,14 @@ HPPTexture HPPApiVulkanSample::load_texture_array(const std::string &file, vkb::
 
 	vk::ImageSubresourceRange subresource_range{vk::ImageAspectFlagBits::eColor, 0, vkb::to_u32(mipmaps.size()), 0, layers};
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::common::image_layout_transition(
-	    command_buffer, texture.image->get_vk_image().get_handle(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, subresource_range);
-
-	// Copy mip levels from staging buffer
-	command_buffer.copyBufferToImage(
-	    stage_buffer.get_handle(), texture.image->get_vk_image().get_handle(), vk::ImageLayout::eTransferDstOptimal, buffer_copy_regions);
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::common::image_layout_transition(command_buffer,
-	                                     texture.image->get_vk_image().get_handle(),
-	                                     vk::ImageLayout::eTransferDstOptimal,
-	                                     vk::ImageLayout::eShaderReadOnlyOptimal,
-	                                     subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy all mip levels through the staging ring without blocking, the first frame waits for the upload to complete
+	auto &upload_manager = get_device().get_upload_manager();
+	texture_upload_token = upload_manager.upload_image(texture.image->get_data().data(),
+	                                                   texture.image->get_data().size(),
+	                                                   texture.image->get_vk_image().get_handle(),
+	                                                   buffer_copy_regions,
+	                                                   subresource_range);
+	upload_manager.flush();
 
 	texture.sampler = create_default_sampler(address_mode, mipmaps.size(), texture.image->get_format());
 
@@ -1028,12 +1020,6 @@ HPPTexture HPPApiVulkanSample::load_texture_cubemap(const std::string &file, vkb
 	texture.image = vkb::scene_graph::components::HPPImage::load(file, file, content_type);
 	texture.image->create_vk_image(get_device(), vk::ImageViewType::eCube, vk::ImageCreateFlagBits::eCubeCompatible);
 
-	const auto &queue = get_device().get_queue_by_flags(vk::QueueFlagBits::eGraphics, 0);
-
-	vk::CommandBuffer command_buffer = get_device().create_command_buffer(vk::CommandBufferLevel::ePrimary, true);
-
-	vkb::core::BufferCpp stage_buffer = vkb::core::BufferCpp::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<vk::BufferImageCopy> buffer_copy_regions;
 
@@ -1062,23 +1048,14 @@ HPPTexture HPPApiVulkanSample::load_texture_cubemap(const std::string &file, vkb
 
 	vk::ImageSubresourceRange subresource_range{vk::ImageAspectFlagBits::eColor, 0, vkb::to_u32(mipmaps.size()), 0, layers};
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::common::image_layout_transition(
-	    command_buffer, texture.image->get_vk_image().get_handle(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, subresource_range);
-
-	// Copy mip levels from staging buffer
-	command_buffer.copyBufferToImage(
-	    stage_buffer.get_handle(), texture.image->get_vk_image().get_handle(), vk::ImageLayout::eTransferDstOptimal, buffer_copy_regions);
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::common::image_layout_transition(command_buffer,
-	                                     texture.image->get_vk_image().get_handle(),
-	                                     vk::ImageLayout::eTransferDstOptimal,
-	                                     vk::ImageLayout::eShaderReadOnlyOptimal,
-	                                     subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy all mip levels through the staging ring without blocking, the first frame waits for the upload to complete
+	auto &upload_manager = get_device().get_upload_manager();
+	texture_upload_token = upload_manager.upload_image(texture.image->get_data().data(),
+	                                                   texture.image->get_data().size(),
+	                                                   texture.image->get_vk_image().get_handle(),
+	                                                   buffer_copy_regions,
+	                                                   subresource_range);
+	upload_manager.flush();
 
 	texture.sampler = create_default_sampler(vk::SamplerAddressMode::eClampToEdge, mipmaps.size(), texture.image->get_format());
 
@@ -382,6 +382,9 @@ class HPPApiVulkanSample : public vkb::VulkanSampleCpp
 	vk::Extent2D dest_extent;
 	bool         resizing = false;
 
+	/// Latest texture upload submitted by the load_texture* helpers, waited on once before the next frame is recorded
+	vkb::core::UploadToken texture_upload_token;
+
 	void handle_mouse_move(int32_t x, int32_t y);
 
 #if defined(VKB_DEBUG) || defined(VKB_VALIDATION_LAYERS)
@@ -30,6 +30,10 @@ namespace vkb
  */
 class HPPGLTFLoader : private vkb::GLTFLoader
 {
+  public:
+	using vkb::GLTFLoader::set_vertex_layout;
+	using VertexLayout = vkb::GLTFLoader::VertexLayout;
+
   public:
 	HPPGLTFLoader(vkb::core::DeviceCpp &device) :
 	    GLTFLoader(reinterpret_cast<vkb::core::DeviceC &>(device))
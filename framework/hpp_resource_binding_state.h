@@ -50,11 +50,12 @@ class HPPResourceSet : private vkb::ResourceSet
 {
   public:
 	using vkb::ResourceSet::is_dirty;
+	using vkb::ResourceSet::is_empty;
 
   public:
-	const BindingMap<HPPResourceInfo> &get_resource_bindings() const
+	const BindingTable<HPPResourceInfo> &get_resource_bindings() const
 	{
-		return reinterpret_cast<BindingMap<HPPResourceInfo> const &>(vkb::ResourceSet::get_resource_bindings());
+		return reinterpret_cast<BindingTable<HPPResourceInfo> const &>(vkb::ResourceSet::get_resource_bindings());
 	}
 };
 
@@ -92,9 +93,10 @@ class HPPResourceBindingState : private vkb::ResourceBindingState
 		vkb::ResourceBindingState::bind_input(reinterpret_cast<vkb::core::ImageView const &>(image_view), set, binding, array_element);
 	}
 
-	const std::unordered_map<uint32_t, vkb::HPPResourceSet> &get_resource_sets()
+	std::span<const vkb::HPPResourceSet> get_resource_sets() const
 	{
-		return reinterpret_cast<std::unordered_map<uint32_t, vkb::HPPResourceSet> const &>(vkb::ResourceBindingState::get_resource_sets());
+		auto resource_sets = vkb::ResourceBindingState::get_resource_sets();
+		return {reinterpret_cast<vkb::HPPResourceSet const *>(resource_sets.data()), resource_sets.size()};
 	}
 };
 }        // namespace vkb
@@ -85,9 +85,10 @@ vkb::core::HPPDescriptorSet &HPPResourceCache::request_descriptor_set(vkb::core:
 
 vkb::core::HPPDescriptorSetLayout &HPPResourceCache::request_descriptor_set_layout(const uint32_t                                   set_index,
                                                                                    const std::vector<vkb::core::HPPShaderModule *> &shader_modules,
-                                                                                   const std::vector<vkb::core::HPPShaderResource> &set_resources)
+                                                                                   const std::vector<vkb::core::HPPShaderResource> &set_resources,
+                                                                                   vkb::DescriptorBackend                           backend)
 {
-	return request_resource(device, recorder, descriptor_set_layout_mutex, state.descriptor_set_layouts, set_index, shader_modules, set_resources);
+	return request_resource(device, recorder, descriptor_set_layout_mutex, state.descriptor_set_layouts, set_index, shader_modules, set_resources, backend);
 }
 
 vkb::core::HPPFramebuffer &HPPResourceCache::request_framebuffer(const vkb::rendering::RenderTargetCpp &render_target,
@@ -103,7 +104,9 @@ vkb::core::HPPGraphicsPipeline &HPPResourceCache::request_graphics_pipeline(vkb:
 
 vkb::core::HPPPipelineLayout &HPPResourceCache::request_pipeline_layout(const std::vector<vkb::core::HPPShaderModule *> &shader_modules)
 {
-	return request_resource(device, recorder, pipeline_layout_mutex, state.pipeline_layouts, shader_modules);
+	// The backend is part of the key, so that changing the backend of the device creates new layouts
+	vkb::DescriptorBackend backend = device.get_descriptor_backend();
+	return request_resource(device, recorder, pipeline_layout_mutex, state.pipeline_layouts, shader_modules, backend);
 }
 
 vkb::core::HPPRenderPass &HPPResourceCache::request_render_pass(const std::vector<vkb::rendering::AttachmentCpp> &attachments,
@@ -88,7 +88,8 @@ class HPPResourceCache
 	                                                          const BindingMap<vk::DescriptorImageInfo>  &image_infos);
 	vkb::core::HPPDescriptorSetLayout &request_descriptor_set_layout(const uint32_t                                   set_index,
 	                                                                 const std::vector<vkb::core::HPPShaderModule *> &shader_modules,
-	                                                                 const std::vector<vkb::core::HPPShaderResource> &set_resources);
+	                                                                 const std::vector<vkb::core::HPPShaderResource> &set_resources,
+	                                                                 vkb::DescriptorBackend                           backend = vkb::DescriptorBackend::Pooled);
 	vkb::core::HPPFramebuffer         &request_framebuffer(const vkb::rendering::RenderTargetCpp &render_target, const vkb::core::HPPRenderPass &render_pass);
 	vkb::core::HPPGraphicsPipeline    &request_graphics_pipeline(vkb::rendering::PipelineStateCpp &pipeline_state);
 	vkb::core::HPPPipelineLayout      &request_pipeline_layout(const std::vector<vkb::core::HPPShaderModule *> &shader_modules);
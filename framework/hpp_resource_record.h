@@ -54,9 +54,9 @@ class HPPResourceRecord : private vkb::ResourceRecord
 		                                                       reinterpret_cast<vkb::rendering::PipelineStateC &>(pipeline_state));
 	}
 
-	size_t register_pipeline_layout(const std::vector<vkb::core::HPPShaderModule *> &shader_modules)
+	size_t register_pipeline_layout(const std::vector<vkb::core::HPPShaderModule *> &shader_modules, vkb::DescriptorBackend backend)
 	{
-		return vkb::ResourceRecord::register_pipeline_layout(reinterpret_cast<std::vector<vkb::ShaderModule *> const &>(shader_modules));
+		return vkb::ResourceRecord::register_pipeline_layout(reinterpret_cast<std::vector<vkb::ShaderModule *> const &>(shader_modules), backend);
 	}
 
 	size_t register_render_pass(const std::vector<vkb::rendering::AttachmentCpp> &attachments,
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -35,7 +35,7 @@ VkSurfaceKHR AndroidWindow::create_surface(vkb::core::InstanceC &instance)
 
 VkSurfaceKHR AndroidWindow::create_surface(VkInstance instance, VkPhysicalDevice)
 {
-	if (instance == VK_NULL_HANDLE || !handle || properties.mode == Mode::Headless)
+	if (instance == VK_NULL_HANDLE || !handle || properties.mode == Mode::Headless || properties.mode == Mode::Offscreen)
 	{
 		return VK_NULL_HANDLE;
 	}
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -25,6 +25,7 @@ namespace vkb
  * @brief Surface-less implementation of a Window using VK_EXT_headless_surface.
  * A surface and swapchain are still created but the the present operation resolves to a no op.
  * Useful for testing and benchmarking in CI environments.
+ * In Offscreen mode no surface is created at all, and the RenderContext renders into offscreen images.
  */
 class HeadlessWindow : public Window
 {
@@ -399,12 +399,13 @@ void Platform::set_focus(bool _focused)
 
 void Platform::set_window_properties(const Window::OptionalProperties &properties)
 {
-	window_properties.title         = properties.title.has_value() ? properties.title.value() : window_properties.title;
-	window_properties.mode          = properties.mode.has_value() ? properties.mode.value() : window_properties.mode;
-	window_properties.resizable     = properties.resizable.has_value() ? properties.resizable.value() : window_properties.resizable;
-	window_properties.vsync         = properties.vsync.has_value() ? properties.vsync.value() : window_properties.vsync;
-	window_properties.extent.width  = properties.extent.width.has_value() ? properties.extent.width.value() : window_properties.extent.width;
-	window_properties.extent.height = properties.extent.height.has_value() ? properties.extent.height.value() : window_properties.extent.height;
+	window_properties.title                 = properties.title.has_value() ? properties.title.value() : window_properties.title;
+	window_properties.mode                  = properties.mode.has_value() ? properties.mode.value() : window_properties.mode;
+	window_properties.resizable             = properties.resizable.has_value() ? properties.resizable.value() : window_properties.resizable;
+	window_properties.vsync                 = properties.vsync.has_value() ? properties.vsync.value() : window_properties.vsync;
+	window_properties.extent.width          = properties.extent.width.has_value() ? properties.extent.width.value() : window_properties.extent.width;
+	window_properties.extent.height         = properties.extent.height.has_value() ? properties.extent.height.value() : window_properties.extent.height;
+	window_properties.offscreen_frame_count = properties.offscreen_frame_count.has_value() ? properties.offscreen_frame_count.value() : window_properties.offscreen_frame_count;
 }
 
 std::string &Platform::get_last_error()
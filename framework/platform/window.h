@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -47,6 +47,7 @@ class Window
 		Fullscreen,
 		FullscreenBorderless,
 		FullscreenStretch,
+		Offscreen,        // No surface nor swapchain, the frames are rendered into a ring of offscreen images
 		Default
 	};
 
@@ -64,15 +65,17 @@ class Window
 		Optional<bool>        resizable;
 		Optional<Vsync>       vsync;
 		OptionalExtent        extent;
+		Optional<uint32_t>    offscreen_frame_count;
 	};
 
 	struct Properties
 	{
-		std::string title     = "";
-		Mode        mode      = Mode::Default;
-		bool        resizable = true;
-		Vsync       vsync     = Vsync::Default;
-		Extent      extent    = {1280, 720};
+		std::string title                 = "";
+		Mode        mode                  = Mode::Default;
+		bool        resizable             = true;
+		Vsync       vsync                 = Vsync::Default;
+		Extent      extent                = {1280, 720};
+		uint32_t    offscreen_frame_count = 3;        // Depth of the ring of offscreen images, in Offscreen mode
 	};
 
 	/**
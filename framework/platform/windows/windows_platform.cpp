@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -34,7 +34,7 @@ WindowsPlatform::WindowsPlatform(const PlatformContext &context) :
 
 void WindowsPlatform::create_window(const Window::Properties &properties)
 {
-	if (properties.mode == vkb::Window::Mode::Headless)
+	if (properties.mode == vkb::Window::Mode::Headless || properties.mode == vkb::Window::Mode::Offscreen)
 	{
 		window = std::make_unique<HeadlessWindow>(properties);
 	}
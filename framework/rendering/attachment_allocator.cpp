@@ -0,0 +1,249 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rendering/attachment_allocator.h"
+
+#include <algorithm>
+#include <memory>
+#include <span>
+
+#include "core/device.h"
+
+namespace vkb
+{
+namespace rendering
+{
+namespace
+{
+constexpr double BYTES_PER_MIB = 1024.0 * 1024.0;
+}        // namespace
+
+AttachmentAllocator::AttachmentAllocator(vkb::core::DeviceCpp &device) :
+    device{device}
+{
+	auto const &memory_properties = device.get_gpu().get_memory_properties();
+	for (uint32_t i = 0; i < memory_properties.memoryTypeCount; ++i)
+	{
+		if (memory_properties.memoryTypes[i].propertyFlags & vk::MemoryPropertyFlagBits::eLazilyAllocated)
+		{
+			lazy_memory_type_bits |= 1U << i;
+		}
+	}
+}
+
+uint32_t AttachmentAllocator::add_attachment(vkb::core::HPPImageBuilder const &builder, AttachmentLifetime const &lifetime)
+{
+	Attachment attachment{.create_info            = builder.get_create_info(),
+	                      .allocation_create_info = builder.get_allocation_create_info(),
+	                      .debug_name             = builder.get_debug_name(),
+	                      .lifetime               = lifetime};
+
+	// The create info may outlive the queue families it points to
+	auto const &create_info = builder.get_create_info();
+	attachment.queue_families.assign(create_info.pQueueFamilyIndices, create_info.pQueueFamilyIndices + create_info.queueFamilyIndexCount);
+	attachment.create_info.queueFamilyIndexCount = 0;
+	attachment.create_info.pQueueFamilyIndices   = nullptr;
+
+	attachments.push_back(std::move(attachment));
+	return static_cast<uint32_t>(attachments.size() - 1);
+}
+
+std::vector<vkb::core::HPPImage> AttachmentAllocator::allocate()
+{
+	unaliased_size        = 0;
+	allocated_size        = 0;
+	lazily_allocated_size = 0;
+
+	std::vector<uint32_t> candidates;
+	for (uint32_t i = 0; i < attachments.size(); ++i)
+	{
+		auto &attachment               = attachments[i];
+		attachment.memory_requirements = get_memory_requirements(attachment.create_info);
+
+		if (is_lazily_allocated(attachment))
+		{
+			lazily_allocated_size += attachment.memory_requirements.size;
+		}
+		else
+		{
+			unaliased_size += attachment.memory_requirements.size;
+			candidates.push_back(i);
+		}
+	}
+
+	// The largest attachments are placed first, so that the first attachment of a block is the largest one and owns the memory
+	std::ranges::stable_sort(candidates, std::ranges::greater{}, [this](uint32_t index) { return attachments[index].memory_requirements.size; });
+
+	std::vector<Block> blocks;
+	for (uint32_t index : candidates)
+	{
+		add_to_block(blocks, index);
+	}
+
+	std::vector<std::unique_ptr<vkb::core::HPPImage>> images(attachments.size());
+	for (auto const &block : blocks)
+	{
+		uint32_t owner = block.attachments.front();
+		{
+			vkb::core::HPPImageBuilder builder{attachments[owner].create_info.extent};
+			init_builder(builder, attachments[owner]);
+			images[owner] = std::make_unique<vkb::core::HPPImage>(device, builder, block.memory_requirements);
+		}
+
+		for (uint32_t index : std::span(block.attachments).subspan(1))
+		{
+			vkb::core::HPPImageBuilder builder{attachments[index].create_info.extent};
+			init_builder(builder, attachments[index]);
+			images[index] = std::make_unique<vkb::core::HPPImage>(device, builder, *images[owner]);
+		}
+
+		allocated_size += block.memory_requirements.size;
+	}
+
+	for (uint32_t i = 0; i < attachments.size(); ++i)
+	{
+		if (!images[i])
+		{
+			// Transient attachments prefer lazily allocated memory, see vkb::allocated::Allocated::create_image
+			vkb::core::HPPImageBuilder builder{attachments[i].create_info.extent};
+			init_builder(builder, attachments[i]);
+			images[i] = std::make_unique<vkb::core::HPPImage>(device, builder);
+		}
+	}
+
+	LOGI("Render target memory: {:.1f} MiB for {} attachments without aliasing, {:.1f} MiB in {} memory blocks, {:.1f} MiB lazily allocated",
+	     unaliased_size / BYTES_PER_MIB,
+	     candidates.size(),
+	     allocated_size / BYTES_PER_MIB,
+	     blocks.size(),
+	     lazily_allocated_size / BYTES_PER_MIB);
+
+	std::vector<vkb::core::HPPImage> result;
+	result.reserve(images.size());
+	for (auto &image : images)
+	{
+		result.push_back(std::move(*image));
+	}
+	return result;
+}
+
+bool AttachmentAllocator::supports_lazy_allocation() const
+{
+	return lazy_memory_type_bits != 0;
+}
+
+vk::DeviceSize AttachmentAllocator::get_unaliased_size() const
+{
+	return unaliased_size;
+}
+
+vk::DeviceSize AttachmentAllocator::get_allocated_size() const
+{
+	return allocated_size;
+}
+
+vk::DeviceSize AttachmentAllocator::get_lazily_allocated_size() const
+{
+	return lazily_allocated_size;
+}
+
+void AttachmentAllocator::init_builder(vkb::core::HPPImageBuilder &builder, Attachment const &attachment)
+{
+	auto const &create_info            = attachment.create_info;
+	auto const &allocation_create_info = attachment.allocation_create_info;
+
+	builder.with_image_type(create_info.imageType)
+	    .with_format(create_info.format)
+	    .with_mip_levels(create_info.mipLevels)
+	    .with_array_layers(create_info.arrayLayers)
+	    .with_sample_count(create_info.samples)
+	    .with_tiling(create_info.tiling)
+	    .with_usage(create_info.usage)
+	    .with_flags(create_info.flags)
+	    .with_queue_families(attachment.queue_families)
+	    .with_sharing_mode(create_info.sharingMode)
+	    .with_vma_usage(allocation_create_info.usage)
+	    .with_vma_flags(allocation_create_info.flags)
+	    .with_vma_required_flags(vk::MemoryPropertyFlags{allocation_create_info.requiredFlags})
+	    .with_vma_preferred_flags(vk::MemoryPropertyFlags{allocation_create_info.preferredFlags})
+	    .with_memory_type_bits(allocation_create_info.memoryTypeBits)
+	    .with_vma_pool(allocation_create_info.pool);
+
+	if (!attachment.debug_name.empty())
+	{
+		builder.with_debug_name(attachment.debug_name);
+	}
+}
+
+vk::MemoryRequirements AttachmentAllocator::get_memory_requirements(vk::ImageCreateInfo const &create_info) const
+{
+	// The requirements of an image depend on its create info only, a temporary image without memory is enough to query them
+	vk::Device             device_handle       = device.get_handle();
+	vk::Image              image               = device_handle.createImage(create_info);
+	vk::MemoryRequirements memory_requirements = device_handle.getImageMemoryRequirements(image);
+	device_handle.destroyImage(image);
+	return memory_requirements;
+}
+
+bool AttachmentAllocator::is_lazily_allocated(Attachment const &attachment) const
+{
+	return (attachment.create_info.usage & vk::ImageUsageFlagBits::eTransientAttachment) &&
+	       (attachment.memory_requirements.memoryTypeBits & lazy_memory_type_bits);
+}
+
+void AttachmentAllocator::add_to_block(std::vector<Block> &blocks, uint32_t attachment_index) const
+{
+	auto const &attachment = attachments[attachment_index];
+
+	auto overlaps = [&attachment](Attachment const &other) {
+		auto const &lifetime       = attachment.lifetime;
+		auto const &other_lifetime = other.lifetime;
+		if (!lifetime.is_used() || !other_lifetime.is_used())
+		{
+			// The layout transitions of an unused attachment may write its memory while the used one is live
+			return lifetime.is_used() != other_lifetime.is_used();
+		}
+		return other_lifetime.first_pass <= lifetime.last_pass && lifetime.first_pass <= other_lifetime.last_pass;
+	};
+
+	for (auto &block : blocks)
+	{
+		// The memory is allocated as requested by the owner of the block
+		auto const &owner = attachments[block.attachments.front()];
+		if (owner.allocation_create_info.usage != attachment.allocation_create_info.usage ||
+		    owner.allocation_create_info.requiredFlags != attachment.allocation_create_info.requiredFlags ||
+		    !(block.memory_requirements.memoryTypeBits & attachment.memory_requirements.memoryTypeBits))
+		{
+			continue;
+		}
+
+		if (std::ranges::any_of(block.attachments, [&](uint32_t index) { return overlaps(attachments[index]); }))
+		{
+			continue;
+		}
+
+		block.memory_requirements.size           = std::max(block.memory_requirements.size, attachment.memory_requirements.size);
+		block.memory_requirements.alignment      = std::max(block.memory_requirements.alignment, attachment.memory_requirements.alignment);
+		block.memory_requirements.memoryTypeBits = block.memory_requirements.memoryTypeBits & attachment.memory_requirements.memoryTypeBits;
+		block.attachments.push_back(attachment_index);
+		return;
+	}
+
+	blocks.push_back({.memory_requirements = attachment.memory_requirements, .attachments = {attachment_index}});
+}
+}        // namespace rendering
+}        // namespace vkb
@@ -0,0 +1,174 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "core/hpp_image.h"
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class Device;
+using DeviceCpp = Device<vkb::BindingType::Cpp>;
+}        // namespace core
+
+namespace rendering
+{
+/**
+ * @brief The range of passes using an attachment
+ */
+struct AttachmentLifetime
+{
+	uint32_t first_pass = std::numeric_limits<uint32_t>::max();
+
+	uint32_t last_pass = 0;
+
+	/**
+	 * @return Whether any pass uses the attachment
+	 */
+	bool is_used() const
+	{
+		return first_pass <= last_pass;
+	}
+
+	/**
+	 * @brief Extends the range to a pass using the attachment
+	 */
+	void add_pass(uint32_t pass)
+	{
+		first_pass = std::min(first_pass, pass);
+		last_pass  = std::max(last_pass, pass);
+	}
+};
+
+/**
+ * @brief Creates the images of render targets, sharing memory between the attachments which are never live at the same time
+ *
+ * Each attachment is declared with the range of passes using it, from the pass writing it to the last pass reading it.
+ * RenderPipeline::add_attachment_lifetimes and PostProcessingPipeline::add_attachment_lifetimes derive these ranges from
+ * the attachments of their subpasses, as the MSAA and subpasses samples do when creating their render targets. Attachments
+ * with disjoint ranges are packed into the same memory block, largest first, and their images alias that memory. A pass
+ * writing an image which aliases others must not expect its previous contents, i.e. it transitions it from an undefined
+ * layout and clears or discards it, and the passes must be separated by barriers, as the passes of a PostProcessingPipeline are.
+ *
+ * Attachments which no pass uses, for instance a resolve attachment while resolving is disabled, still go through the
+ * layout transitions of the render passes of their framebuffer, which may write their memory. They only alias each other.
+ *
+ * Transient attachments, which only live within a render pass, are rather allocated from lazily allocated memory when
+ * the device has some, where they may never need any backing memory. They do not alias other attachments.
+ */
+class AttachmentAllocator
+{
+  public:
+	explicit AttachmentAllocator(vkb::core::DeviceCpp &device);
+
+	/**
+	 * @brief Declares an attachment
+	 * @param builder Description of the image of the attachment
+	 * @param lifetime Range of passes using the attachment, empty if none does
+	 * @return Index of the image of the attachment in the vector returned by allocate
+	 */
+	uint32_t add_attachment(vkb::core::HPPImageBuilder const &builder, AttachmentLifetime const &lifetime);
+
+	/**
+	 * @brief Assigns the declared attachments to memory blocks and creates their images
+	 * @return The images, in the order of their declaration. Those sharing a memory block must be destroyed together.
+	 */
+	std::vector<vkb::core::HPPImage> allocate();
+
+	/**
+	 * @return Whether the device has lazily allocated memory for transient attachments
+	 */
+	bool supports_lazy_allocation() const;
+
+	/**
+	 * @return The memory the attachments would use with one allocation each, as computed by the last allocate
+	 */
+	vk::DeviceSize get_unaliased_size() const;
+
+	/**
+	 * @return The memory allocated by the last allocate, excluding lazily allocated memory
+	 */
+	vk::DeviceSize get_allocated_size() const;
+
+	/**
+	 * @return The lazily allocated memory of the transient attachments, as reported by the last allocate
+	 */
+	vk::DeviceSize get_lazily_allocated_size() const;
+
+  private:
+	struct Attachment
+	{
+		vk::ImageCreateInfo create_info;
+
+		VmaAllocationCreateInfo allocation_create_info = {};
+
+		std::vector<uint32_t> queue_families;
+
+		std::string debug_name;
+
+		AttachmentLifetime lifetime;
+
+		vk::MemoryRequirements memory_requirements;
+	};
+
+	struct Block
+	{
+		// Requirements covering the ones of all the attachments of the block
+		vk::MemoryRequirements memory_requirements;
+
+		// Attachments of the block, the first one owns the memory
+		std::vector<uint32_t> attachments;
+	};
+
+	/**
+	 * @brief Sets up a builder with the description of an attachment, as builders cannot be copied
+	 */
+	static void init_builder(vkb::core::HPPImageBuilder &builder, Attachment const &attachment);
+
+	vk::MemoryRequirements get_memory_requirements(vk::ImageCreateInfo const &create_info) const;
+
+	bool is_lazily_allocated(Attachment const &attachment) const;
+
+	/**
+	 * @brief Adds an attachment to the first block it can alias, which has no attachment live during its passes, or to a new block
+	 * @remarks An unused attachment can only alias unused attachments, and a used one used attachments
+	 */
+	void add_to_block(std::vector<Block> &blocks, uint32_t attachment_index) const;
+
+	vkb::core::DeviceCpp &device;
+
+	std::vector<Attachment> attachments;
+
+	// Memory types which are lazily allocated
+	uint32_t lazy_memory_type_bits = 0;
+
+	vk::DeviceSize unaliased_size = 0;
+
+	vk::DeviceSize allocated_size = 0;
+
+	vk::DeviceSize lazily_allocated_size = 0;
+};
+}        // namespace rendering
+}        // namespace vkb
@@ -0,0 +1,480 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rendering/frame_capture.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include "common/hpp_vk_common.h"
+#include "core/buffer.h"
+#include "core/device.h"
+#include "core/hpp_image_view.h"
+#include "filesystem/legacy.h"
+
+namespace vkb
+{
+namespace rendering
+{
+namespace
+{
+/**
+ * @brief Encodes RGBA8 pixels as a QOI image, following the specification at https://qoiformat.org
+ */
+std::vector<uint8_t> encode_qoi(const uint8_t *data, uint32_t width, uint32_t height)
+{
+	constexpr uint8_t QOI_OP_INDEX = 0x00;
+	constexpr uint8_t QOI_OP_DIFF  = 0x40;
+	constexpr uint8_t QOI_OP_LUMA  = 0x80;
+	constexpr uint8_t QOI_OP_RUN   = 0xc0;
+	constexpr uint8_t QOI_OP_RGB   = 0xfe;
+	constexpr uint8_t QOI_OP_RGBA  = 0xff;
+
+	size_t pixel_count = static_cast<size_t>(width) * height;
+
+	std::vector<uint8_t> encoded;
+	// Worst case of QOI_OP_RGBA for every pixel, plus the header and the end marker
+	encoded.reserve(14 + pixel_count * 5 + 8);
+
+	auto push_u32 = [&encoded](uint32_t value) {
+		encoded.push_back(static_cast<uint8_t>(value >> 24));
+		encoded.push_back(static_cast<uint8_t>(value >> 16));
+		encoded.push_back(static_cast<uint8_t>(value >> 8));
+		encoded.push_back(static_cast<uint8_t>(value));
+	};
+
+	encoded.insert(encoded.end(), {'q', 'o', 'i', 'f'});
+	push_u32(width);
+	push_u32(height);
+	encoded.push_back(4);        // RGBA
+	encoded.push_back(0);        // sRGB with linear alpha
+
+	std::array<std::array<uint8_t, 4>, 64> index{};
+	std::array<uint8_t, 4>                 previous{0, 0, 0, 255};
+	uint8_t                                run = 0;
+
+	for (size_t i = 0; i < pixel_count; ++i)
+	{
+		std::array<uint8_t, 4> pixel{data[i * 4], data[i * 4 + 1], data[i * 4 + 2], data[i * 4 + 3]};
+
+		if (pixel == previous)
+		{
+			if (++run == 62 || i + 1 == pixel_count)
+			{
+				encoded.push_back(QOI_OP_RUN | (run - 1));
+				run = 0;
+			}
+			continue;
+		}
+
+		if (run > 0)
+		{
+			encoded.push_back(QOI_OP_RUN | (run - 1));
+			run = 0;
+		}
+
+		uint8_t hash = (pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64;
+		if (index[hash] == pixel)
+		{
+			encoded.push_back(QOI_OP_INDEX | hash);
+		}
+		else
+		{
+			index[hash] = pixel;
+
+			if (pixel[3] == previous[3])
+			{
+				// Differences wrap around, as the components are 8-bit
+				auto dr = static_cast<int8_t>(pixel[0] - previous[0]);
+				auto dg = static_cast<int8_t>(pixel[1] - previous[1]);
+				auto db = static_cast<int8_t>(pixel[2] - previous[2]);
+
+				auto dr_dg = static_cast<int8_t>(dr - dg);
+				auto db_dg = static_cast<int8_t>(db - dg);
+
+				if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2)
+				{
+					encoded.push_back(QOI_OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+				}
+				else if (dr_dg > -9 && dr_dg < 8 && dg > -33 && dg < 32 && db_dg > -9 && db_dg < 8)
+				{
+					encoded.push_back(QOI_OP_LUMA | (dg + 32));
+					encoded.push_back(static_cast<uint8_t>((dr_dg + 8) << 4 | (db_dg + 8)));
+				}
+				else
+				{
+					encoded.insert(encoded.end(), {QOI_OP_RGB, pixel[0], pixel[1], pixel[2]});
+				}
+			}
+			else
+			{
+				encoded.insert(encoded.end(), {QOI_OP_RGBA, pixel[0], pixel[1], pixel[2], pixel[3]});
+			}
+		}
+
+		previous = pixel;
+	}
+
+	encoded.insert(encoded.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+	return encoded;
+}
+
+/**
+ * @return True if captures of images in the format can be converted to RGBA8
+ */
+bool is_capture_format_supported(vk::Format format)
+{
+	switch (format)
+	{
+		case vk::Format::eR8G8B8A8Unorm:
+		case vk::Format::eR8G8B8A8Srgb:
+		case vk::Format::eR8G8B8A8Snorm:
+		case vk::Format::eA8B8G8R8UnormPack32:
+		case vk::Format::eA8B8G8R8SrgbPack32:
+		case vk::Format::eB8G8R8A8Unorm:
+		case vk::Format::eB8G8R8A8Srgb:
+		case vk::Format::eB8G8R8A8Snorm:
+		case vk::Format::eA2B10G10R10UnormPack32:
+		case vk::Format::eA2R10G10B10UnormPack32:
+		case vk::Format::eR16G16B16A16Sfloat:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief Converts a pixel to opaque RGBA8, the source and destination may be the same 4 byte pixel
+ */
+void convert_to_rgba8(vk::Format format, const uint8_t *src, uint8_t *dst)
+{
+	switch (format)
+	{
+		case vk::Format::eB8G8R8A8Unorm:
+		case vk::Format::eB8G8R8A8Srgb:
+		case vk::Format::eB8G8R8A8Snorm:
+		{
+			uint8_t blue = src[0];
+			dst[0]       = src[2];
+			dst[1]       = src[1];
+			dst[2]       = blue;
+			break;
+		}
+		case vk::Format::eA2B10G10R10UnormPack32:
+		case vk::Format::eA2R10G10B10UnormPack32:
+		{
+			uint32_t packed;
+			std::memcpy(&packed, src, sizeof(packed));
+
+			// Keep the top 8 bits of each 10-bit component, the lowest one is red in A2B10G10R10
+			uint8_t low    = static_cast<uint8_t>(packed >> 2);
+			uint8_t middle = static_cast<uint8_t>(packed >> 12);
+			uint8_t high   = static_cast<uint8_t>(packed >> 22);
+
+			bool bgr = format == vk::Format::eA2R10G10B10UnormPack32;
+			dst[0]   = bgr ? high : low;
+			dst[1]   = middle;
+			dst[2]   = bgr ? low : high;
+			break;
+		}
+		case vk::Format::eR16G16B16A16Sfloat:
+			for (size_t component = 0; component < 3; ++component)
+			{
+				uint16_t half;
+				std::memcpy(&half, src + component * sizeof(half), sizeof(half));
+				dst[component] = static_cast<uint8_t>(glm::clamp(glm::unpackHalf1x16(half), 0.0f, 1.0f) * 255.0f + 0.5f);
+			}
+			break;
+		default:
+			// RGBA8 and its packed equivalent are already in the right order
+			if (dst != src)
+			{
+				std::memcpy(dst, src, 3);
+			}
+			break;
+	}
+
+	// Remove transparency
+	dst[3] = 255;
+}
+}        // namespace
+
+FrameCapture::FrameCapture(vkb::core::DeviceCpp &device, uint32_t queue_family_index, uint32_t slot_count, uint32_t worker_count) :
+    device{device}, slots(std::max(slot_count, 1u))
+{
+	command_pool = device.get_handle().createCommandPool(
+	    {.flags = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer, .queueFamilyIndex = queue_family_index});
+
+	auto command_buffers = device.get_handle().allocateCommandBuffers(
+	    {.commandPool = command_pool, .level = vk::CommandBufferLevel::ePrimary, .commandBufferCount = to_u32(slots.size())});
+	for (size_t i = 0; i < slots.size(); ++i)
+	{
+		slots[i].command_buffer = command_buffers[i];
+	}
+
+	for (uint32_t i = 0; i < std::max(worker_count, 1u); ++i)
+	{
+		workers.emplace_back(&FrameCapture::worker_loop, this);
+	}
+}
+
+FrameCapture::~FrameCapture()
+{
+	// Write the captures still in flight
+	device.get_handle().waitIdle();
+	collect_all();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stop_workers = true;
+	}
+	work_condition.notify_all();
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+
+	// Destroying the pool frees the command buffers
+	device.get_handle().destroyCommandPool(command_pool);
+}
+
+void FrameCapture::request(CaptureRequest request)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	requests.push_back(std::move(request));
+}
+
+bool FrameCapture::has_requests() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return !requests.empty();
+}
+
+vk::CommandBuffer FrameCapture::record(vkb::core::HPPImageView const &image_view, vk::ImageLayout layout, uint32_t frame_index)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+
+	if (requests.empty())
+	{
+		return nullptr;
+	}
+
+	CaptureRequest request = std::move(requests.front());
+	requests.pop_front();
+
+	// The next slot of the ring holds the oldest capture, so it is the first to be written
+	Slot &slot = slots[next_slot];
+	if (slot.state == SlotState::Recorded)
+	{
+		LOGW("Frame capture ring is smaller than the number of frames in flight, dropping capture \"{}\"", request.filename);
+		return nullptr;
+	}
+	encoded_condition.wait(lock, [&slot] { return slot.state == SlotState::Free; });
+	next_slot = (next_slot + 1) % slots.size();
+	lock.unlock();
+
+	if (!is_capture_format_supported(image_view.get_format()))
+	{
+		LOGW("Frame capture does not support the format {}, dropping capture \"{}\"", vk::to_string(image_view.get_format()), request.filename);
+		return nullptr;
+	}
+
+	auto const    &image           = image_view.get_image();
+	vk::Extent2D   extent{image.get_extent().width, image.get_extent().height};
+	uint32_t       bytes_per_pixel = to_u32(vkb::common::get_bits_per_pixel(image_view.get_format())) / 8;
+	vk::DeviceSize size            = static_cast<vk::DeviceSize>(extent.width) * extent.height * bytes_per_pixel;
+
+	if (!slot.buffer || slot.buffer->get_size() < size)
+	{
+		slot.buffer = vkb::core::BufferBuilderCpp(size)
+		                  .with_usage(vk::BufferUsageFlagBits::eTransferDst)
+		                  .with_vma_usage(VMA_MEMORY_USAGE_GPU_TO_CPU)
+		                  .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT)
+		                  .build_unique(device);
+		slot.buffer->set_debug_name("Frame capture readback");
+	}
+
+	slot.request     = std::move(request);
+	slot.frame_index = frame_index;
+	slot.extent      = extent;
+	slot.format      = image_view.get_format();
+
+	vk::ImageSubresourceRange subresource_range = image_view.get_subresource_range();
+
+	vk::CommandBuffer command_buffer = slot.command_buffer;
+	command_buffer.begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+
+	// Wait for the rendering of the frame, also ordered by the semaphore the submission waits on when there is a swapchain
+	vk::ImageMemoryBarrier to_transfer{.srcAccessMask       = vk::AccessFlagBits::eColorAttachmentWrite,
+	                                   .dstAccessMask       = vk::AccessFlagBits::eTransferRead,
+	                                   .oldLayout           = layout,
+	                                   .newLayout           = vk::ImageLayout::eTransferSrcOptimal,
+	                                   .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	                                   .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	                                   .image               = image.get_handle(),
+	                                   .subresourceRange    = subresource_range};
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eColorAttachmentOutput, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, to_transfer);
+
+	vk::ImageSubresourceLayers subresource{.aspectMask     = vk::ImageAspectFlagBits::eColor,
+	                                       .mipLevel       = subresource_range.baseMipLevel,
+	                                       .baseArrayLayer = subresource_range.baseArrayLayer,
+	                                       .layerCount     = 1};
+
+	vk::BufferImageCopy region{.bufferRowLength   = extent.width,
+	                           .bufferImageHeight = extent.height,
+	                           .imageSubresource  = subresource,
+	                           .imageExtent       = {extent.width, extent.height, 1}};
+	command_buffer.copyImageToBuffer(image.get_handle(), vk::ImageLayout::eTransferSrcOptimal, slot.buffer->get_handle(), region);
+
+	// Make the copy visible to the host, which reads it once the frame completes
+	vk::BufferMemoryBarrier to_host{.srcAccessMask       = vk::AccessFlagBits::eTransferWrite,
+	                                .dstAccessMask       = vk::AccessFlagBits::eHostRead,
+	                                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	                                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	                                .buffer              = slot.buffer->get_handle(),
+	                                .offset              = 0,
+	                                .size                = size};
+
+	// The image goes back to the layout it was rendered to, presentation waits on the semaphore signaled by the submission
+	// and the next rendering of an offscreen image discards it, so no later stage needs to wait on the transition
+	vk::ImageMemoryBarrier to_layout{.srcAccessMask       = vk::AccessFlagBits::eTransferRead,
+	                                 .dstAccessMask       = {},
+	                                 .oldLayout           = vk::ImageLayout::eTransferSrcOptimal,
+	                                 .newLayout           = layout,
+	                                 .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	                                 .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	                                 .image               = image.get_handle(),
+	                                 .subresourceRange    = subresource_range};
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, {}, to_host, {});
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, {}, {}, {}, to_layout);
+
+	command_buffer.end();
+
+	lock.lock();
+	slot.state = SlotState::Recorded;
+
+	return command_buffer;
+}
+
+void FrameCapture::collect(uint32_t frame_index)
+{
+	collect([frame_index](Slot const &slot) { return slot.frame_index == frame_index; });
+}
+
+void FrameCapture::collect_all()
+{
+	collect([](Slot const &) { return true; });
+}
+
+void FrameCapture::wait_encoded()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	encoded_condition.wait(lock, [this] { return std::ranges::none_of(slots, [](Slot const &slot) { return slot.state == SlotState::Encoding; }); });
+}
+
+void FrameCapture::collect(std::function<bool(Slot const &)> const &filter)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto &slot : slots)
+		{
+			if (slot.state == SlotState::Recorded && filter(slot))
+			{
+				// Readback memory may not be host coherent
+				slot.buffer->invalidate();
+
+				slot.state = SlotState::Encoding;
+				encode_queue.push_back(&slot);
+			}
+		}
+	}
+	work_condition.notify_all();
+}
+
+void FrameCapture::encode(Slot &slot)
+{
+	uint32_t width           = slot.extent.width;
+	uint32_t height          = slot.extent.height;
+	uint32_t bytes_per_pixel = to_u32(vkb::common::get_bits_per_pixel(slot.format)) / 8;
+	uint8_t *readback        = slot.buffer->map();
+
+	// Pixels of 4 bytes are converted in place, wider ones into a separate RGBA8 image
+	std::vector<uint8_t> converted;
+	uint8_t             *data        = readback;
+	size_t               pixel_count = static_cast<size_t>(width) * height;
+	if (bytes_per_pixel != 4)
+	{
+		converted.resize(pixel_count * 4);
+		data = converted.data();
+	}
+
+	for (size_t i = 0; i < pixel_count; ++i)
+	{
+		convert_to_rgba8(slot.format, readback + i * bytes_per_pixel, data + i * 4);
+	}
+
+	switch (slot.request.format)
+	{
+		case CaptureFormat::Png:
+			vkb::fs::write_image(data, slot.request.filename, width, height, 4, width * 4);
+			break;
+		case CaptureFormat::Qoi:
+			vkb::fs::write_image_file(encode_qoi(data, width, height), slot.request.filename + ".qoi");
+			break;
+		case CaptureFormat::Raw:
+			vkb::fs::write_image_file(std::vector<uint8_t>(data, data + pixel_count * 4), slot.request.filename + ".rgba");
+			break;
+	}
+}
+
+void FrameCapture::worker_loop()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		work_condition.wait(lock, [this] { return stop_workers || !encode_queue.empty(); });
+		if (encode_queue.empty())
+		{
+			// Only stop once all the collected captures are written
+			break;
+		}
+
+		Slot *slot = encode_queue.front();
+		encode_queue.pop_front();
+		lock.unlock();
+
+		try
+		{
+			encode(*slot);
+		}
+		catch (std::exception const &e)
+		{
+			LOGE("Failed to write capture \"{}\": {}", slot->request.filename, e.what());
+		}
+
+		lock.lock();
+		slot->state = SlotState::Free;
+		encoded_condition.notify_all();
+	}
+}
+}        // namespace rendering
+}        // namespace vkb
@@ -0,0 +1,198 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/vk_common.h"
+#include <vulkan/vulkan.hpp>
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class Buffer;
+using BufferCpp = Buffer<vkb::BindingType::Cpp>;
+
+template <vkb::BindingType bindingType>
+class Device;
+using DeviceCpp = Device<vkb::BindingType::Cpp>;
+
+class HPPImageView;
+}        // namespace core
+
+namespace rendering
+{
+/**
+ * @brief File format of a captured frame, written to the screenshots directory
+ */
+enum class CaptureFormat
+{
+	Png,        // PNG through stb, the smallest files but the slowest to encode
+	Qoi,        // Quite OK Image format, lossless and an order of magnitude faster to encode than PNG
+	Raw         // Tightly packed RGBA8 rows without a header, with the ".rgba" extension
+};
+
+/**
+ * @brief A frame to capture
+ */
+struct CaptureRequest
+{
+	// Name of the file, without an extension
+	std::string filename;
+
+	CaptureFormat format = CaptureFormat::Png;
+};
+
+/**
+ * @brief Non-blocking capture of rendered frames, for screenshots and image sequences
+ *
+ * The copy of a frame is recorded into a command buffer submitted with the other submissions of that frame, before
+ * its presentation, so it is covered by the frame's fence or timeline points. Once the RenderContext has waited on those,
+ * when the same frame is begun again, the capture is collected and handed to worker threads that convert it to RGBA and
+ * encode it. The render thread never waits on the GPU or on encoding.
+ *
+ * The image is read back in its own format, which can be any 8-bit RGBA or BGRA format, a 10-bit packed format or
+ * R16G16B16A16_SFLOAT, and is converted to RGBA8 by the encoding threads.
+ *
+ * Captures go through a ring of persistently mapped readback buffers. A slot returns to the ring once its capture is
+ * written, so a ring at least as large as the number of frames in flight only runs out if encoding falls behind, in which
+ * case the render thread waits for the oldest capture to be written.
+ */
+class FrameCapture
+{
+  public:
+	/**
+	 * @brief Creates the capture ring
+	 * @param device The device rendering the frames
+	 * @param queue_family_index Family of the queue the copies are submitted to
+	 * @param slot_count Number of readback buffers, which should be at least the number of frames in flight
+	 * @param worker_count Number of encoding threads
+	 */
+	FrameCapture(vkb::core::DeviceCpp &device, uint32_t queue_family_index, uint32_t slot_count, uint32_t worker_count = 2);
+
+	FrameCapture(const FrameCapture &) = delete;
+
+	FrameCapture(FrameCapture &&) = delete;
+
+	~FrameCapture();
+
+	FrameCapture &operator=(const FrameCapture &) = delete;
+
+	FrameCapture &operator=(FrameCapture &&) = delete;
+
+	/**
+	 * @brief Queues a capture of the next frame to end
+	 */
+	void request(CaptureRequest request);
+
+	/**
+	 * @return True if a capture is queued for the next frame to end
+	 */
+	bool has_requests() const;
+
+	/**
+	 * @brief Records the copy of a rendered image for the oldest queued request
+	 * @param image_view View of the rendered image
+	 * @param layout Layout of the rendered image, which it is left in
+	 * @param frame_index Index of the frame whose submissions include the returned command buffer
+	 * @return The command buffer holding the copy, or a null handle if the capture had to be dropped
+	 */
+	vk::CommandBuffer record(vkb::core::HPPImageView const &image_view, vk::ImageLayout layout, uint32_t frame_index);
+
+	/**
+	 * @brief Hands the captures recorded in a frame to the encoding threads, the frame must have completed on the GPU
+	 */
+	void collect(uint32_t frame_index);
+
+	/**
+	 * @brief Hands all the recorded captures to the encoding threads, the device must be idle
+	 */
+	void collect_all();
+
+	/**
+	 * @brief Blocks until all the collected captures are written
+	 */
+	void wait_encoded();
+
+  private:
+	enum class SlotState
+	{
+		Free,
+		Recorded,        // Copy submitted, waiting for the frame to complete
+		Encoding         // Handed to the encoding threads
+	};
+
+	struct Slot
+	{
+		std::unique_ptr<vkb::core::BufferCpp> buffer;
+
+		vk::CommandBuffer command_buffer;
+
+		SlotState state = SlotState::Free;
+
+		uint32_t frame_index = 0;
+
+		CaptureRequest request;
+
+		vk::Extent2D extent;
+
+		// Format of the captured image, which the readback is in
+		vk::Format format = vk::Format::eUndefined;
+	};
+
+	void collect(std::function<bool(Slot const &)> const &filter);
+
+	void encode(Slot &slot);
+
+	void worker_loop();
+
+	vkb::core::DeviceCpp &device;
+
+	vk::CommandPool command_pool;
+
+	std::vector<Slot> slots;
+
+	// Next slot of the ring to record into
+	size_t next_slot = 0;
+
+	std::deque<CaptureRequest> requests;
+
+	// Guards the slot states and the encoding queue
+	mutable std::mutex mutex;
+
+	std::condition_variable work_condition;
+
+	std::condition_variable encoded_condition;
+
+	std::deque<Slot *> encode_queue;
+
+	bool stop_workers = false;
+
+	std::vector<std::thread> workers;
+};
+}        // namespace rendering
+}        // namespace vkb
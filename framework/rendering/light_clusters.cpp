@@ -0,0 +1,573 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "light_clusters.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	include <xmmintrin.h>
+#	define VKB_LIGHT_CLUSTERS_SSE
+#elif defined(__ARM_NEON)
+#	include <arm_neon.h>
+#	define VKB_LIGHT_CLUSTERS_NEON
+#endif
+
+#include "common/helpers.h"
+#include "core/command_buffer.h"
+#include "scene_graph/components/camera.h"
+#include "scene_graph/components/light.h"
+#include "scene_graph/components/transform.h"
+#include "scene_graph/node.h"
+#include "timer.h"
+
+namespace vkb
+{
+namespace rendering
+{
+namespace
+{
+// Point light attenuation is 1 / (distance * ATTENUATION_SCALE)^2, as in lighting.h
+constexpr float ATTENUATION_SCALE = 0.005f;
+
+// Contribution below which a point light without a range is considered out of reach
+constexpr float LIGHT_CUTOFF = 0.01f;
+
+// Radius of lights which reach every cluster, finite so that it can be squared
+constexpr float GLOBAL_RADIUS = 1e18f;
+
+// Local size of the culling shader, which processes one cluster per invocation
+constexpr uint32_t CULLING_WORKGROUP_SIZE = 64;
+
+/**
+ * @brief Uniform data of clustered_lighting.h
+ */
+struct alignas(16) ClusterInfo
+{
+	glm::mat4  view;
+	glm::uvec4 grid;         // xyz: number of clusters, w: number of directional lights
+	glm::vec4  scale;        // xy: clusters per pixel, z: depth slice scale, w: depth slice bias
+};
+
+/**
+ * @brief Push constants of the culling shader
+ */
+struct CullingParameters
+{
+	uint32_t cluster_count;
+	uint32_t light_count;
+	uint32_t light_offset;
+	uint32_t max_lights_per_cluster;
+};
+
+/**
+ * @brief Range of normalized device coordinates covered by the view-space interval [low, high] between two view depths
+ */
+glm::vec2 project_range(float low, float high, float depth_min, float depth_max, float scale, float offset)
+{
+	float a = scale * low / depth_min;
+	float b = scale * low / depth_max;
+	float c = scale * high / depth_min;
+	float d = scale * high / depth_max;
+
+	return glm::vec2{std::min({a, b, c, d}), std::max({a, b, c, d})} - offset;
+}
+
+/**
+ * @brief View-space interval covered by the normalized device coordinates [ndc_low, ndc_high] between two view depths
+ */
+glm::vec2 unproject_range(float ndc_low, float ndc_high, float depth_min, float depth_max, float scale, float offset)
+{
+	float a = (ndc_low + offset) * depth_min / scale;
+	float b = (ndc_low + offset) * depth_max / scale;
+	float c = (ndc_high + offset) * depth_min / scale;
+	float d = (ndc_high + offset) * depth_max / scale;
+
+	return {std::min({a, b, c, d}), std::max({a, b, c, d})};
+}
+
+uint32_t to_tile(float ndc, uint32_t tile_count)
+{
+	float tile = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tile_count));
+	return static_cast<uint32_t>(std::clamp(tile, 0.0f, static_cast<float>(tile_count - 1)));
+}
+
+template <typename T>
+BufferAllocationC upload_storage(RenderFrameC &render_frame, const std::vector<T> &data)
+{
+	// Empty lists still need a valid buffer to bind
+	VkDeviceSize size       = data.size() * sizeof(T);
+	auto         allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, std::max<VkDeviceSize>(size, sizeof(T)));
+
+	if (!data.empty())
+	{
+		allocation.get_buffer().update(data.data(), size, allocation.get_offset());
+	}
+
+	return allocation;
+}
+}        // namespace
+
+LightClusters::LightClusters(LightCullingMode mode, const glm::uvec3 &grid_size) :
+    mode{mode},
+    grid_size{grid_size}
+{
+	if (grid_size.x == 0 || grid_size.y == 0 || grid_size.z == 0)
+	{
+		throw std::runtime_error("LightClusters: the cluster grid can't be empty");
+	}
+}
+
+void LightClusters::set_mode(LightCullingMode mode_)
+{
+	mode = mode_;
+}
+
+LightCullingMode LightClusters::get_mode() const
+{
+	return mode;
+}
+
+const glm::uvec3 &LightClusters::get_grid_size() const
+{
+	return grid_size;
+}
+
+void LightClusters::update(vkb::core::CommandBufferC       &command_buffer,
+                           RenderFrameC                    &render_frame,
+                           std::span<vkb::sg::Light *const> lights,
+                           vkb::sg::Camera                 &camera,
+                           const VkExtent2D                &extent_)
+{
+	auto camera_view       = camera.get_view();
+	auto camera_projection = vulkan_style_projection(camera.get_projection());
+
+	if (mode == LightCullingMode::CPU)
+	{
+		bin_lights(lights, camera_view, camera_projection, extent_);
+	}
+	else
+	{
+		Timer timer;
+		timer.start();
+
+		prepare_lights(lights, camera_view);
+		update_bounds(camera_projection, extent_);
+
+		statistics                    = {};
+		statistics.light_count        = to_u32(packed_lights.size());
+		statistics.culled_light_count = to_u32(light_spheres.size());
+		statistics.binning_time_ms    = timer.stop<Timer::Milliseconds>();
+	}
+
+	ClusterInfo info;
+	info.view  = view;
+	info.grid  = glm::uvec4{grid_size, directional_light_count};
+	info.scale = glm::vec4{static_cast<float>(grid_size.x) / extent.width,
+	                       static_cast<float>(grid_size.y) / extent.height,
+	                       slice_scale,
+	                       slice_bias};
+
+	info_buffer = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(ClusterInfo));
+	info_buffer.update(info);
+
+	light_buffer = upload_storage(render_frame, packed_lights);
+
+	if (mode == LightCullingMode::CPU)
+	{
+		range_buffer = upload_storage(render_frame, cluster_ranges);
+		index_buffer = upload_storage(render_frame, light_indices);
+	}
+	else
+	{
+		dispatch(command_buffer, render_frame);
+	}
+}
+
+void LightClusters::bin_lights(std::span<vkb::sg::Light *const> lights, const glm::mat4 &view_, const glm::mat4 &projection_, const VkExtent2D &extent_)
+{
+	Timer timer;
+	timer.start();
+
+	prepare_lights(lights, view_);
+	update_bounds(projection_, extent_);
+	bin();
+
+	statistics                    = {};
+	statistics.light_count        = to_u32(packed_lights.size());
+	statistics.culled_light_count = to_u32(light_spheres.size());
+	statistics.index_count        = to_u32(light_indices.size());
+	for (auto &range : cluster_ranges)
+	{
+		statistics.max_lights_per_cluster = std::max(statistics.max_lights_per_cluster, range.y);
+	}
+	statistics.binning_time_ms = timer.stop<Timer::Milliseconds>();
+}
+
+void LightClusters::bind(vkb::core::CommandBufferC &command_buffer, uint32_t set, uint32_t first_binding)
+{
+	assert(!info_buffer.empty() && "LightClusters::update must be called before binding the clusters");
+
+	command_buffer.bind_buffer(info_buffer.get_buffer(), info_buffer.get_offset(), info_buffer.get_size(), set, first_binding, 0);
+	command_buffer.bind_buffer(light_buffer.get_buffer(), light_buffer.get_offset(), light_buffer.get_size(), set, first_binding + 1, 0);
+	command_buffer.bind_buffer(range_buffer.get_buffer(), range_buffer.get_offset(), range_buffer.get_size(), set, first_binding + 2, 0);
+	command_buffer.bind_buffer(index_buffer.get_buffer(), index_buffer.get_offset(), index_buffer.get_size(), set, first_binding + 3, 0);
+}
+
+const std::vector<glm::uvec2> &LightClusters::get_cluster_ranges() const
+{
+	return cluster_ranges;
+}
+
+const std::vector<uint32_t> &LightClusters::get_light_indices() const
+{
+	return light_indices;
+}
+
+const LightClusters::Statistics &LightClusters::get_statistics() const
+{
+	return statistics;
+}
+
+void LightClusters::prepare_lights(std::span<vkb::sg::Light *const> lights, const glm::mat4 &view_)
+{
+	view = view_;
+
+	packed_lights.clear();
+	light_spheres.clear();
+
+	auto pack = [](vkb::sg::Light &light) {
+		const auto &properties = light.get_properties();
+		auto       &transform  = light.get_node()->get_transform();
+
+		return vkb::rendering::Light{{transform.get_translation(), static_cast<float>(light.get_light_type())},
+		                             {properties.color, properties.intensity},
+		                             {transform.get_rotation() * properties.direction, properties.range},
+		                             {properties.inner_cone_angle, properties.outer_cone_angle}};
+	};
+
+	// Directional lights reach every pixel, they come first and are not culled
+	for (auto light : lights)
+	{
+		if (light->get_light_type() == sg::LightType::Directional)
+		{
+			packed_lights.push_back(pack(*light));
+		}
+	}
+
+	directional_light_count = to_u32(packed_lights.size());
+
+	for (auto light : lights)
+	{
+		auto type = light->get_light_type();
+		if (type != sg::LightType::Point && type != sg::LightType::Spot)
+		{
+			continue;
+		}
+
+		const auto &properties = light->get_properties();
+
+		float radius = properties.range;
+		if (radius <= 0.0f)
+		{
+			if (type == sg::LightType::Point)
+			{
+				// Distance at which the attenuated light falls below the cutoff
+				float max_color = std::max({properties.color.r, properties.color.g, properties.color.b});
+				radius          = std::sqrt(properties.intensity * max_color / LIGHT_CUTOFF) / ATTENUATION_SCALE;
+			}
+			else
+			{
+				// Spot lights are not attenuated by distance
+				radius = GLOBAL_RADIUS;
+			}
+		}
+
+		auto center = view * glm::vec4{light->get_node()->get_transform().get_translation(), 1.0f};
+
+		packed_lights.push_back(pack(*light));
+		light_spheres.emplace_back(glm::vec3{center}, radius);
+	}
+}
+
+void LightClusters::update_bounds(const glm::mat4 &projection_, const VkExtent2D &extent_)
+{
+	if (projection_ == projection && extent_.width == extent.width && extent_.height == extent.height)
+	{
+		return;
+	}
+
+	if (projection_[2][3] == 0.0f)
+	{
+		throw std::runtime_error("LightClusters: only perspective projections are supported");
+	}
+
+	projection = projection_;
+	extent     = extent_;
+
+	// A view depth d maps to the depth -P22 + P32 / d, which is 0 and 1 at the near and far planes,
+	// or the other way around with a reversed depth buffer
+	float depth_0 = projection[3][2] / projection[2][2];
+	float depth_1 = projection[3][2] / (projection[2][2] + 1.0f);
+
+	near_plane = std::min(std::abs(depth_0), std::abs(depth_1));
+	far_plane  = std::max(std::abs(depth_0), std::abs(depth_1));
+
+	if (!std::isfinite(far_plane))
+	{
+		// Infinite far plane
+		far_plane = near_plane * 10000.0f;
+	}
+
+	float log_depth_ratio = std::log(far_plane / near_plane);
+
+	slice_scale = grid_size.z / log_depth_ratio;
+	slice_bias  = -(grid_size.z * std::log(near_plane)) / log_depth_ratio;
+
+	size_t cluster_count = static_cast<size_t>(grid_size.x) * grid_size.y * grid_size.z;
+
+	min_x.resize(cluster_count);
+	min_y.resize(cluster_count);
+	min_z.resize(cluster_count);
+	max_x.resize(cluster_count);
+	max_y.resize(cluster_count);
+	max_z.resize(cluster_count);
+	cluster_bounds.resize(cluster_count * 2);
+
+	for (uint32_t slice = 0; slice < grid_size.z; ++slice)
+	{
+		float depth_min = near_plane * std::pow(far_plane / near_plane, static_cast<float>(slice) / grid_size.z);
+		float depth_max = near_plane * std::pow(far_plane / near_plane, static_cast<float>(slice + 1) / grid_size.z);
+
+		for (uint32_t y = 0; y < grid_size.y; ++y)
+		{
+			auto range_y = unproject_range(2.0f * y / grid_size.y - 1.0f, 2.0f * (y + 1) / grid_size.y - 1.0f,
+			                               depth_min, depth_max, projection[1][1], projection[2][1]);
+
+			for (uint32_t x = 0; x < grid_size.x; ++x)
+			{
+				auto range_x = unproject_range(2.0f * x / grid_size.x - 1.0f, 2.0f * (x + 1) / grid_size.x - 1.0f,
+				                               depth_min, depth_max, projection[0][0], projection[2][0]);
+
+				size_t index = (static_cast<size_t>(slice) * grid_size.y + y) * grid_size.x + x;
+
+				// The camera looks down the negative z axis
+				min_x[index] = range_x.x;
+				min_y[index] = range_y.x;
+				min_z[index] = -depth_max;
+				max_x[index] = range_x.y;
+				max_y[index] = range_y.y;
+				max_z[index] = -depth_min;
+
+				cluster_bounds[index * 2]     = glm::vec4{range_x.x, range_y.x, -depth_max, 0.0f};
+				cluster_bounds[index * 2 + 1] = glm::vec4{range_x.y, range_y.y, -depth_min, 0.0f};
+			}
+		}
+	}
+}
+
+void LightClusters::bin()
+{
+	overlaps.clear();
+
+	auto get_slice = [this](float depth) {
+		float slice = std::floor(std::log(depth) * slice_scale + slice_bias);
+		return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(grid_size.z - 1)));
+	};
+
+	for (uint32_t light_index = 0; light_index < light_spheres.size(); ++light_index)
+	{
+		const auto &sphere = light_spheres[light_index];
+		float       radius = sphere.w;
+		float       depth  = -sphere.z;
+
+		float depth_min = depth - radius;
+		float depth_max = depth + radius;
+
+		if (depth_max < near_plane || depth_min > far_plane)
+		{
+			continue;
+		}
+
+		uint32_t slice_begin = get_slice(std::max(depth_min, near_plane));
+		uint32_t slice_end   = get_slice(std::min(depth_max, far_plane));
+
+		glm::uvec2 tile_begin{0, 0};
+		glm::uvec2 tile_end{grid_size.x - 1, grid_size.y - 1};
+
+		if (depth_min > 0.0f)
+		{
+			// The bounding box of the sphere is in front of the camera, so its projection bounds the projection of the sphere
+			auto range_x = project_range(sphere.x - radius, sphere.x + radius, depth_min, depth_max, projection[0][0], projection[2][0]);
+			auto range_y = project_range(sphere.y - radius, sphere.y + radius, depth_min, depth_max, projection[1][1], projection[2][1]);
+
+			if (range_x.y < -1.0f || range_x.x > 1.0f || range_y.y < -1.0f || range_y.x > 1.0f)
+			{
+				continue;
+			}
+
+			tile_begin = {to_tile(range_x.x, grid_size.x), to_tile(range_y.x, grid_size.y)};
+			tile_end   = {to_tile(range_x.y, grid_size.x), to_tile(range_y.y, grid_size.y)};
+		}
+
+		uint32_t packed_index   = directional_light_count + light_index;
+		float    radius_squared = radius * radius;
+
+#if defined(VKB_LIGHT_CLUSTERS_SSE)
+		const __m128 center_x = _mm_set1_ps(sphere.x);
+		const __m128 center_y = _mm_set1_ps(sphere.y);
+		const __m128 center_z = _mm_set1_ps(sphere.z);
+		const __m128 radius_4 = _mm_set1_ps(radius_squared);
+		const __m128 zero     = _mm_setzero_ps();
+#elif defined(VKB_LIGHT_CLUSTERS_NEON)
+		const float32x4_t center_x = vdupq_n_f32(sphere.x);
+		const float32x4_t center_y = vdupq_n_f32(sphere.y);
+		const float32x4_t center_z = vdupq_n_f32(sphere.z);
+		const float32x4_t radius_4 = vdupq_n_f32(radius_squared);
+		const float32x4_t zero     = vdupq_n_f32(0.0f);
+#endif
+
+		for (uint32_t slice = slice_begin; slice <= slice_end; ++slice)
+		{
+			for (uint32_t y = tile_begin.y; y <= tile_end.y; ++y)
+			{
+				// Clusters of a row are consecutive, so the sphere is tested against four of them at a time
+				uint32_t row   = (slice * grid_size.y + y) * grid_size.x;
+				uint32_t index = row + tile_begin.x;
+				uint32_t end   = row + tile_end.x + 1;
+
+#if defined(VKB_LIGHT_CLUSTERS_SSE)
+				for (; index + 4 <= end; index += 4)
+				{
+					__m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&min_x[index]), center_x), _mm_sub_ps(center_x, _mm_loadu_ps(&max_x[index]))), zero);
+					__m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&min_y[index]), center_y), _mm_sub_ps(center_y, _mm_loadu_ps(&max_y[index]))), zero);
+					__m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&min_z[index]), center_z), _mm_sub_ps(center_z, _mm_loadu_ps(&max_z[index]))), zero);
+
+					__m128 distance_squared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+					int mask = _mm_movemask_ps(_mm_cmple_ps(distance_squared, radius_4));
+					for (uint32_t lane = 0; mask; ++lane, mask >>= 1)
+					{
+						if (mask & 1)
+						{
+							overlaps.emplace_back(index + lane, packed_index);
+						}
+					}
+				}
+#elif defined(VKB_LIGHT_CLUSTERS_NEON)
+				for (; index + 4 <= end; index += 4)
+				{
+					float32x4_t dx = vmaxq_f32(vmaxq_f32(vsubq_f32(vld1q_f32(&min_x[index]), center_x), vsubq_f32(center_x, vld1q_f32(&max_x[index]))), zero);
+					float32x4_t dy = vmaxq_f32(vmaxq_f32(vsubq_f32(vld1q_f32(&min_y[index]), center_y), vsubq_f32(center_y, vld1q_f32(&max_y[index]))), zero);
+					float32x4_t dz = vmaxq_f32(vmaxq_f32(vsubq_f32(vld1q_f32(&min_z[index]), center_z), vsubq_f32(center_z, vld1q_f32(&max_z[index]))), zero);
+
+					float32x4_t distance_squared = vmlaq_f32(vmlaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz);
+
+					uint32_t lanes[4];
+					vst1q_u32(lanes, vcleq_f32(distance_squared, radius_4));
+					for (uint32_t lane = 0; lane < 4; ++lane)
+					{
+						if (lanes[lane])
+						{
+							overlaps.emplace_back(index + lane, packed_index);
+						}
+					}
+				}
+#endif
+
+				for (; index < end; ++index)
+				{
+					float dx = std::max({min_x[index] - sphere.x, sphere.x - max_x[index], 0.0f});
+					float dy = std::max({min_y[index] - sphere.y, sphere.y - max_y[index], 0.0f});
+					float dz = std::max({min_z[index] - sphere.z, sphere.z - max_z[index], 0.0f});
+
+					if (dx * dx + dy * dy + dz * dz <= radius_squared)
+					{
+						overlaps.emplace_back(index, packed_index);
+					}
+				}
+			}
+		}
+	}
+
+	// Counting sort of the overlaps by cluster, which keeps the lights of each cluster in order
+	cluster_ranges.assign(min_x.size(), glm::uvec2{0, 0});
+	for (auto &overlap : overlaps)
+	{
+		cluster_ranges[overlap.x].y++;
+	}
+
+	uint32_t offset = 0;
+	for (auto &range : cluster_ranges)
+	{
+		range.x = offset;
+		offset += range.y;
+		range.y = 0;
+	}
+
+	light_indices.resize(overlaps.size());
+	for (auto &overlap : overlaps)
+	{
+		auto &range                        = cluster_ranges[overlap.x];
+		light_indices[range.x + range.y++] = overlap.y;
+	}
+}
+
+void LightClusters::dispatch(vkb::core::CommandBufferC &command_buffer, RenderFrameC &render_frame)
+{
+	uint32_t cluster_count = to_u32(min_x.size());
+
+	auto sphere_buffer = upload_storage(render_frame, light_spheres);
+	auto bounds_buffer = upload_storage(render_frame, cluster_bounds);
+
+	// Each cluster owns a fixed number of index slots, so that invocations don't need to synchronize
+	range_buffer = render_frame.allocate_buffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, cluster_count * sizeof(glm::uvec2));
+	index_buffer = render_frame.allocate_buffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, cluster_count * MAX_LIGHTS_PER_CLUSTER * sizeof(uint32_t));
+
+	if (!culling_shader)
+	{
+		culling_shader = std::make_unique<ShaderSource>("clustered/light_culling.comp.spv");
+	}
+
+	auto &resource_cache  = command_buffer.get_device().get_resource_cache();
+	auto &shader_module   = resource_cache.request_shader_module(VK_SHADER_STAGE_COMPUTE_BIT, *culling_shader, culling_variant);
+	auto &pipeline_layout = resource_cache.request_pipeline_layout({&shader_module});
+	command_buffer.bind_pipeline_layout(pipeline_layout);
+
+	command_buffer.bind_buffer(sphere_buffer.get_buffer(), sphere_buffer.get_offset(), sphere_buffer.get_size(), 0, 0, 0);
+	command_buffer.bind_buffer(bounds_buffer.get_buffer(), bounds_buffer.get_offset(), bounds_buffer.get_size(), 0, 1, 0);
+	command_buffer.bind_buffer(range_buffer.get_buffer(), range_buffer.get_offset(), range_buffer.get_size(), 0, 2, 0);
+	command_buffer.bind_buffer(index_buffer.get_buffer(), index_buffer.get_offset(), index_buffer.get_size(), 0, 3, 0);
+
+	CullingParameters parameters{cluster_count, to_u32(light_spheres.size()), directional_light_count, MAX_LIGHTS_PER_CLUSTER};
+	command_buffer.push_constants(parameters);
+
+	command_buffer.dispatch((cluster_count + CULLING_WORKGROUP_SIZE - 1) / CULLING_WORKGROUP_SIZE, 1, 1);
+
+	// Make the light lists visible to the fragment shaders
+	BufferMemoryBarrier barrier;
+	barrier.src_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	barrier.dst_stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	barrier.src_access_mask = VK_ACCESS_SHADER_WRITE_BIT;
+	barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
+
+	command_buffer.buffer_memory_barrier(range_buffer.get_buffer(), range_buffer.get_offset(), range_buffer.get_size(), barrier);
+	command_buffer.buffer_memory_barrier(index_buffer.get_buffer(), index_buffer.get_offset(), index_buffer.get_size(), barrier);
+}
+}        // namespace rendering
+}        // namespace vkb
@@ -0,0 +1,212 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "common/glm_common.h"
+#include "core/shader_module.h"
+#include "rendering/render_frame.h"
+#include "rendering/subpass.h"
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class CommandBuffer;
+using CommandBufferC = CommandBuffer<vkb::BindingType::C>;
+}        // namespace core
+
+namespace sg
+{
+class Camera;
+class Light;
+}        // namespace sg
+
+namespace rendering
+{
+/**
+ * @brief Where the lights are binned into clusters
+ */
+enum class LightCullingMode
+{
+	CPU,
+	GPU
+};
+
+/**
+ * @brief Clustered light culling, which bins the point and spot lights of a scene into a view-space froxel grid
+ *
+ * The view frustum is split into screen tiles and exponentially distributed depth slices. Each cluster gets the
+ * list of lights whose bounding sphere overlaps it, so shaders only evaluate the lights which can reach a pixel
+ * instead of every light in the scene. Directional lights are not culled and are applied everywhere.
+ *
+ * Lights are binned either on the CPU, testing four clusters at a time with SIMD, or by a compute shader. The
+ * light lists are uploaded through the buffer pools of the active frame and bound to four consecutive bindings,
+ * which are read by the shaders with `clustered_lighting.h`.
+ * Perspective cameras only, pre-rotation is not supported.
+ */
+class LightClusters
+{
+  public:
+	/// Number of light index slots of each cluster in GPU mode, lights beyond that are dropped
+	static constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 256;
+
+	/**
+	 * @brief Outcome of the last update
+	 */
+	struct Statistics
+	{
+		uint32_t light_count            = 0;
+		uint32_t culled_light_count     = 0;          // Point and spot lights binned into clusters
+		uint32_t index_count            = 0;          // CPU mode only, number of light references across all clusters
+		uint32_t max_lights_per_cluster = 0;          // CPU mode only
+		double   binning_time_ms        = 0.0;        // CPU time, which in GPU mode only covers the light preparation
+	};
+
+	LightClusters(LightCullingMode mode = LightCullingMode::CPU, const glm::uvec3 &grid_size = {16, 9, 24});
+
+	LightClusters(const LightClusters &) = delete;
+
+	LightClusters(LightClusters &&) = default;
+
+	~LightClusters() = default;
+
+	LightClusters &operator=(const LightClusters &) = delete;
+
+	LightClusters &operator=(LightClusters &&) = default;
+
+	void set_mode(LightCullingMode mode);
+
+	LightCullingMode get_mode() const;
+
+	const glm::uvec3 &get_grid_size() const;
+
+	/**
+	 * @brief Bins the lights for the current frame and uploads the light lists through the frame's buffer pools
+	 *
+	 * Must be recorded outside of a render pass, as the GPU mode dispatches the culling compute shader.
+	 * @param command_buffer Command buffer recording the frame
+	 * @param render_frame Frame whose buffer pools hold the light lists
+	 * @param lights Lights to bin
+	 * @param camera Camera used to render the frame
+	 * @param extent Extent of the render target
+	 */
+	void update(vkb::core::CommandBufferC          &command_buffer,
+	            RenderFrameC                       &render_frame,
+	            std::span<vkb::sg::Light *const>    lights,
+	            vkb::sg::Camera                    &camera,
+	            const VkExtent2D                   &extent);
+
+	/**
+	 * @brief Bins the lights on the CPU, without uploading them
+	 * @param lights Lights to bin
+	 * @param view View matrix
+	 * @param projection Vulkan style projection matrix
+	 * @param extent Extent of the render target
+	 */
+	void bin_lights(std::span<vkb::sg::Light *const> lights, const glm::mat4 &view, const glm::mat4 &projection, const VkExtent2D &extent);
+
+	/**
+	 * @brief Binds the cluster info, lights, cluster ranges and light indices to four consecutive bindings
+	 */
+	void bind(vkb::core::CommandBufferC &command_buffer, uint32_t set, uint32_t first_binding);
+
+	/**
+	 * @return For each cluster, the offset and number of its lights in the light indices, after a CPU binning
+	 */
+	const std::vector<glm::uvec2> &get_cluster_ranges() const;
+
+	const std::vector<uint32_t> &get_light_indices() const;
+
+	const Statistics &get_statistics() const;
+
+  private:
+	/**
+	 * @brief Packs the lights with the directional lights first, and computes the view-space bounding spheres of the others
+	 */
+	void prepare_lights(std::span<vkb::sg::Light *const> lights, const glm::mat4 &view);
+
+	/**
+	 * @brief Computes the depth slices and the view-space bounds of the clusters, if the projection or extent changed
+	 */
+	void update_bounds(const glm::mat4 &projection, const VkExtent2D &extent);
+
+	void bin();
+
+	void dispatch(vkb::core::CommandBufferC &command_buffer, RenderFrameC &render_frame);
+
+	LightCullingMode mode;
+
+	glm::uvec3 grid_size;
+
+	glm::mat4 view{1.0f};
+
+	glm::mat4 projection{0.0f};
+
+	VkExtent2D extent{};
+
+	float near_plane = 0.0f;
+
+	float far_plane = 0.0f;
+
+	// Depth slice of a view depth d is log(d) * slice_scale + slice_bias
+	float slice_scale = 0.0f;
+
+	float slice_bias = 0.0f;
+
+	// View-space bounds of the clusters, as separate arrays for SIMD tests of consecutive clusters
+	std::vector<float> min_x, min_y, min_z, max_x, max_y, max_z;
+
+	// The same bounds, as pairs of min and max for the culling shader
+	std::vector<glm::vec4> cluster_bounds;
+
+	std::vector<vkb::rendering::Light> packed_lights;
+
+	uint32_t directional_light_count = 0;
+
+	// View-space center and radius of each culled light, which follow the directional lights in packed_lights
+	std::vector<glm::vec4> light_spheres;
+
+	// Cluster and light index of each overlap found by the binning
+	std::vector<glm::uvec2> overlaps;
+
+	std::vector<glm::uvec2> cluster_ranges;
+
+	std::vector<uint32_t> light_indices;
+
+	std::unique_ptr<ShaderSource> culling_shader;
+
+	ShaderVariant culling_variant;
+
+	BufferAllocationC info_buffer;
+
+	BufferAllocationC light_buffer;
+
+	BufferAllocationC range_buffer;
+
+	BufferAllocationC index_buffer;
+
+	Statistics statistics;
+};
+}        // namespace rendering
+}        // namespace vkb
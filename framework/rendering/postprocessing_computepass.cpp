@@ -18,6 +18,7 @@
 #include "postprocessing_computepass.h"
 
 #include "postprocessing_pipeline.h"
+#include "rendering/render_graph.h"
 
 namespace vkb
 {
@@ -106,6 +107,50 @@ void PostProcessingComputePass::transition_images(vkb::core::CommandBufferC &com
 	auto &shader_module   = resource_cache.request_shader_module(VK_SHADER_STAGE_COMPUTE_BIT, cs_source, cs_variant);
 	auto &pipeline_layout = resource_cache.request_pipeline_layout({&shader_module});
 
+	// The render graph derives the barriers from the state the previous pass left the attachments in, and records them as a
+	// single pipeline barrier. Attachments already in the layout of the dispatch still get one if the previous pass wrote them.
+	vkb::rendering::RenderGraph graph;
+
+	auto &pass = graph.add_pass("Postprocessing compute").set_side_effects();
+
+	struct Attachment
+	{
+		vkb::rendering::RenderTargetC *render_target;
+		uint32_t                       index;
+		uint32_t                       resource;
+		VkImageLayout                  layout;
+	};
+	std::vector<Attachment> attachments;
+
+	auto use_attachment = [&](vkb::rendering::RenderTargetC &render_target, uint32_t index, vkb::rendering::ResourceAccess const &access, bool write) {
+		auto it = std::ranges::find_if(attachments, [&](Attachment const &attachment) {
+			return attachment.render_target == &render_target && attachment.index == index;
+		});
+		if (it == attachments.end())
+		{
+			assert(index < render_target.get_views().size());
+			auto const &view              = render_target.get_views()[index];
+			auto        subresource_range = view.get_subresource_range();
+
+			uint32_t resource = graph.import_image("Postprocessing attachment",
+			                                       vk::Image{view.get_image().get_handle()},
+			                                       reinterpret_cast<vk::ImageSubresourceRange const &>(subresource_range),
+			                                       {vk::PipelineStageFlags2{prev_pass_barrier_info.pipeline_stage},
+			                                        vk::AccessFlags2{prev_pass_barrier_info.image_write_access},
+			                                        static_cast<vk::ImageLayout>(render_target.get_layout(index))});
+			it = attachments.insert(attachments.end(), {&render_target, index, resource, static_cast<VkImageLayout>(access.layout)});
+		}
+
+		if (write)
+		{
+			pass.write(it->resource, access);
+		}
+		else
+		{
+			pass.read(it->resource, access);
+		}
+	};
+
 	for (const auto &sampled : sampled_images)
 	{
 		if (const uint32_t *attachment = sampled.second.get_target_attachment())
@@ -116,28 +161,10 @@ void PostProcessingComputePass::transition_images(vkb::core::CommandBufferC &com
 				sampled_rt = &default_render_target;
 			}
 
-			if (sampled_rt->get_layout(*attachment) == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-			{
-				// No-op
-				continue;
-			}
-
-			vkb::ImageMemoryBarrier barrier;
-			barrier.old_layout      = sampled_rt->get_layout(*attachment);
-			barrier.new_layout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			barrier.src_access_mask = prev_pass_barrier_info.image_write_access;
-			barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
-			barrier.src_stage_mask  = prev_pass_barrier_info.pipeline_stage;
-			barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-
-			assert(*attachment < sampled_rt->get_views().size());
-			command_buffer.image_memory_barrier(sampled_rt->get_views()[*attachment], barrier);
-			sampled_rt->set_layout(*attachment, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+			use_attachment(*sampled_rt, *attachment, vkb::rendering::access::compute_shader_sampled_read, false);
 		}
 	}
 
-	const auto &bindings = pipeline_layout.get_descriptor_set_layout(0);
-
 	for (const auto &storage : storage_images)
 	{
 		if (const uint32_t *attachment = storage.second.get_target_attachment())
@@ -164,35 +191,35 @@ void PostProcessingComputePass::transition_images(vkb::core::CommandBufferC &com
 			const bool readable = !(resource->qualifiers & ShaderResourceQualifiers::NonReadable);
 			const bool writable = !(resource->qualifiers & ShaderResourceQualifiers::NonReadable);
 
-			vkb::ImageMemoryBarrier barrier;
-			barrier.old_layout = storage_rt->get_layout(*attachment);
-			barrier.new_layout = (readable && !writable) ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
-
-			if (storage_rt->get_layout(*attachment) == barrier.new_layout)
-			{
-				// No-op
-				continue;
-			}
-
-			barrier.src_stage_mask = prev_pass_barrier_info.pipeline_stage;
-			barrier.dst_stage_mask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-
-			barrier.src_access_mask = prev_pass_barrier_info.image_write_access;
-			barrier.dst_access_mask = 0;
+			vkb::rendering::ResourceAccess access{vk::PipelineStageFlagBits2::eComputeShader,
+			                                      {},
+			                                      (readable && !writable) ? vk::ImageLayout::eShaderReadOnlyOptimal : vk::ImageLayout::eGeneral};
 			if (readable)
 			{
-				barrier.dst_access_mask |= VK_ACCESS_SHADER_READ_BIT;
+				access.access_mask |= vk::AccessFlagBits2::eShaderRead;
 			}
 			if (writable)
 			{
-				barrier.dst_access_mask |= VK_ACCESS_SHADER_WRITE_BIT;
+				access.access_mask |= vk::AccessFlagBits2::eShaderWrite;
 			}
 
-			assert(*attachment < storage_rt->get_views().size());
-			command_buffer.image_memory_barrier(storage_rt->get_views()[*attachment], barrier);
-			storage_rt->set_layout(*attachment, barrier.new_layout);
+			use_attachment(*storage_rt, *attachment, access, writable);
 		}
 	}
+
+	if (attachments.empty())
+	{
+		return;
+	}
+
+	// All the accesses are on the queue the pass is recorded for, there is no queue family ownership transfer
+	graph.compile(VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED);
+	graph.record(0, vk::CommandBuffer{command_buffer.get_handle()}, command_buffer.get_device().is_synchronization2_enabled());
+
+	for (const auto &attachment : attachments)
+	{
+		attachment.render_target->set_layout(attachment.index, attachment.layout);
+	}
 }
 
 void PostProcessingComputePass::draw(vkb::core::CommandBufferC &command_buffer, vkb::rendering::RenderTargetC &default_render_target)
@@ -18,6 +18,8 @@
 #include "postprocessing_pipeline.h"
 
 #include "common/utils.h"
+#include "postprocessing_computepass.h"
+#include "postprocessing_renderpass.h"
 
 namespace vkb
 {
@@ -66,4 +68,68 @@ void PostProcessingPipeline::draw(vkb::core::CommandBufferC &command_buffer, vkb
 	current_pass_index = 0;
 }
 
+uint32_t PostProcessingPipeline::add_attachment_lifetimes(std::vector<vkb::rendering::AttachmentLifetime> &lifetimes, uint32_t first_pass) const
+{
+	uint32_t pass_index = first_pass;
+
+	auto use_attachment = [&lifetimes, &pass_index](uint32_t attachment) {
+		if (attachment < lifetimes.size())
+		{
+			lifetimes[attachment].add_pass(pass_index);
+		}
+	};
+
+	// An image without a render target refers to the one of its pass, which is the one passed to draw() if the pass has none
+	auto use_image = [&use_attachment](core::SampledImage const &image, vkb::rendering::RenderTargetC *pass_render_target) {
+		const uint32_t *attachment = image.get_target_attachment();
+		if (attachment && !image.get_render_target() && !pass_render_target)
+		{
+			use_attachment(*attachment);
+		}
+	};
+
+	for (auto const &pass : passes)
+	{
+		if (auto *render_pass = dynamic_cast<PostProcessingRenderPass *>(pass.get()))
+		{
+			auto *render_target = render_pass->get_render_target();
+			for (size_t subpass_index = 0; subpass_index < render_pass->get_subpass_count(); subpass_index++)
+			{
+				auto &subpass = render_pass->get_subpass(subpass_index);
+				if (!render_target)
+				{
+					for (auto const &input_attachment : subpass.get_input_attachments())
+					{
+						use_attachment(input_attachment.second);
+					}
+					for (uint32_t output_attachment : subpass.get_output_attachments())
+					{
+						use_attachment(output_attachment);
+					}
+				}
+				for (auto const &sampled_image : subpass.get_sampled_images())
+				{
+					use_image(sampled_image.second, render_target);
+				}
+			}
+		}
+		else if (auto *compute_pass = dynamic_cast<PostProcessingComputePass *>(pass.get()))
+		{
+			// Compute passes have no render target of their own
+			for (auto const &sampled_image : compute_pass->get_sampled_images())
+			{
+				use_image(sampled_image.second, nullptr);
+			}
+			for (auto const &storage_image : compute_pass->get_storage_images())
+			{
+				use_image(storage_image.second, nullptr);
+			}
+		}
+
+		pass_index++;
+	}
+
+	return pass_index;
+}
+
 }        // namespace vkb
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "postprocessing_pass.h"
+#include "rendering/attachment_allocator.h"
 
 namespace vkb
 {
@@ -79,6 +80,16 @@ class PostProcessingPipeline
 		return added_pass;
 	}
 
+	/**
+	 * @brief Adds the passes of this pipeline to the lifetimes of the attachments of the render target passed to draw() which
+	 *        they draw to, read as input attachments, sample or store to, one pass index per pass.
+	 * @param lifetimes Lifetimes of the attachments of the render target passed to draw(), in the order of its attachments
+	 * @param first_pass Index of the first pass of this pipeline, following the passes drawing to the same render target before it
+	 * @return Index of the pass following the last one of this pipeline
+	 * @remarks Attachments of the render targets set on a pass, or on a sampled or storage image, are not included.
+	 */
+	uint32_t add_attachment_lifetimes(std::vector<vkb::rendering::AttachmentLifetime> &lifetimes, uint32_t first_pass) const;
+
 	/**
 	 * @brief Returns the current render context.
 	 */
@@ -243,6 +243,14 @@ class PostProcessingRenderPass : public PostProcessingPass<PostProcessingRenderP
 		return *dynamic_cast<PostProcessingSubpass *>(pipeline.get_subpasses()[index].get());
 	}
 
+	/**
+	 * @brief Gets the number of steps.
+	 */
+	inline size_t get_subpass_count()
+	{
+		return pipeline.get_subpasses().size();
+	}
+
 	/**
 	 * @brief Constructs a new PostProcessingSubpass and adds it to the tail of the pipeline.
 	 * @remarks `this`, the render context and the vertex shader source are passed automatically before `args`.
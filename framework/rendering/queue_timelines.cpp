@@ -0,0 +1,116 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rendering/queue_timelines.h"
+
+#include <vector>
+
+#include "core/device.h"
+
+namespace vkb
+{
+namespace rendering
+{
+QueueTimelines::QueueTimelines(vkb::core::DeviceCpp &device) :
+    device{device}
+{
+	if (!device.is_timeline_semaphore_enabled())
+	{
+		throw std::runtime_error("Queue timelines require the timelineSemaphore feature to be enabled");
+	}
+}
+
+QueueTimelines::~QueueTimelines()
+{
+	std::vector<TimelinePoint> points;
+	for (auto &[queue, timeline] : timelines)
+	{
+		points.push_back({queue.first, queue.second, timeline.value});
+	}
+
+	// The semaphores may still be signaled by submissions in flight
+	wait(points);
+
+	for (auto &[queue, timeline] : timelines)
+	{
+		device.get_handle().destroySemaphore(timeline.semaphore);
+	}
+}
+
+vk::Semaphore QueueTimelines::get_semaphore(uint32_t queue_family_index, uint32_t queue_index)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	return get_timeline(queue_family_index, queue_index).semaphore;
+}
+
+TimelinePoint QueueTimelines::request_point(uint32_t queue_family_index, uint32_t queue_index)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	return {queue_family_index, queue_index, ++get_timeline(queue_family_index, queue_index).value};
+}
+
+bool QueueTimelines::is_complete(TimelinePoint const &point)
+{
+	if (point.value == 0)
+	{
+		return true;
+	}
+
+	return point.value <= device.get_handle().getSemaphoreCounterValue(get_semaphore(point.queue_family_index, point.queue_index));
+}
+
+void QueueTimelines::wait(std::span<const TimelinePoint> points, uint64_t timeout)
+{
+	std::vector<vk::Semaphore> semaphores;
+	std::vector<uint64_t>      values;
+	for (auto &point : points)
+	{
+		if (point.value != 0)
+		{
+			semaphores.push_back(get_semaphore(point.queue_family_index, point.queue_index));
+			values.push_back(point.value);
+		}
+	}
+
+	if (semaphores.empty())
+	{
+		return;
+	}
+
+	vk::SemaphoreWaitInfo wait_info{.semaphoreCount = to_u32(semaphores.size()), .pSemaphores = semaphores.data(), .pValues = values.data()};
+
+	vk::Result result = device.get_handle().waitSemaphores(wait_info, timeout);
+	if (result != vk::Result::eSuccess)
+	{
+		throw VulkanException(static_cast<VkResult>(result), "Failed to wait for queue timelines");
+	}
+}
+
+QueueTimelines::Timeline &QueueTimelines::get_timeline(uint32_t queue_family_index, uint32_t queue_index)
+{
+	auto [it, inserted] = timelines.try_emplace({queue_family_index, queue_index});
+	if (inserted)
+	{
+		vk::SemaphoreTypeCreateInfo semaphore_type_info{.semaphoreType = vk::SemaphoreType::eTimeline, .initialValue = 0};
+		it->second.semaphore = device.get_handle().createSemaphore({.pNext = &semaphore_type_info});
+	}
+	return it->second;
+}
+}        // namespace rendering
+}        // namespace vkb
@@ -0,0 +1,119 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <limits>
+#include <map>
+#include <mutex>
+#include <span>
+
+#include "common/vk_common.h"
+#include <vulkan/vulkan.hpp>
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class Device;
+using DeviceCpp = Device<vkb::BindingType::Cpp>;
+}        // namespace core
+
+namespace rendering
+{
+/**
+ * @brief How the RenderContext tracks the completion of the frames
+ */
+enum class FrameSyncMode
+{
+	Fences,                   // A fence per submission, waited on and reset by the frame
+	TimelineSemaphores        // A timeline semaphore per queue, each submission signals the next value of its queue
+};
+
+/**
+ * @brief A submission, identified by its queue and the value it signals on the timeline of that queue
+ *
+ * A default constructed point refers to no submission and is always complete.
+ */
+struct TimelinePoint
+{
+	uint32_t queue_family_index = 0;
+	uint32_t queue_index        = 0;
+	uint64_t value              = 0;
+};
+
+/**
+ * @brief One timeline semaphore per queue, whose values identify the submissions to that queue
+ *
+ * Values are handed out in increasing order per queue, so waiting for a value also waits for all earlier submissions
+ * to the same queue. Semaphores are created on first use of a queue.
+ */
+class QueueTimelines
+{
+  public:
+	QueueTimelines(vkb::core::DeviceCpp &device);
+
+	QueueTimelines(const QueueTimelines &) = delete;
+
+	QueueTimelines(QueueTimelines &&) = delete;
+
+	~QueueTimelines();
+
+	QueueTimelines &operator=(const QueueTimelines &) = delete;
+
+	QueueTimelines &operator=(QueueTimelines &&) = delete;
+
+	/**
+	 * @return The timeline semaphore of a queue
+	 */
+	vk::Semaphore get_semaphore(uint32_t queue_family_index, uint32_t queue_index);
+
+	/**
+	 * @brief Reserves the value to be signaled by the next submission to a queue
+	 */
+	TimelinePoint request_point(uint32_t queue_family_index, uint32_t queue_index);
+
+	/**
+	 * @return True if the submission has completed, without blocking
+	 */
+	bool is_complete(TimelinePoint const &point);
+
+	/**
+	 * @brief Blocks until all the submissions have completed
+	 */
+	void wait(std::span<const TimelinePoint> points, uint64_t timeout = std::numeric_limits<uint64_t>::max());
+
+  private:
+	struct Timeline
+	{
+		vk::Semaphore semaphore;
+
+		// Last value handed out
+		uint64_t value = 0;
+	};
+
+	Timeline &get_timeline(uint32_t queue_family_index, uint32_t queue_index);
+
+	vkb::core::DeviceCpp &device;
+
+	std::mutex mutex;
+
+	std::map<std::pair<uint32_t, uint32_t>, Timeline> timelines;
+};
+}        // namespace rendering
+}        // namespace vkb
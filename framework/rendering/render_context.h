@@ -21,7 +21,10 @@
 #include "core/device.h"
 #include "core/hpp_swapchain.h"
 #include "platform/window.h"
+#include "rendering/frame_capture.h"
 #include "rendering/render_frame.h"
+#include "rendering/residency_manager.h"
+#include "rendering/submit_builder.h"
 #include <vulkan/vulkan.hpp>
 
 namespace vkb
@@ -37,6 +40,11 @@ class CommandBuffer;
 class HPPQueue;
 }        // namespace core
 
+namespace sg
+{
+class SceneSnapshot;
+}        // namespace sg
+
 namespace rendering
 {
 template <BindingType bindingType>
@@ -56,7 +64,9 @@ using RenderFrameCpp = RenderFrame<BindingType::Cpp>;
  * swapchain. A RenderFrame will then be created for each Swapchain image.
  *
  * For offscreen rendering (no swapchain), the RenderContext can be given a valid Device, and
- * a width and height. A single RenderFrame will then be created.
+ * a width and height. A ring of RenderFrames rendering into offscreen RenderTargets will then be
+ * created, see @ref set_offscreen_frame_count. The frames are used in turn without any acquire
+ * or present, so the rendering is only paced by the fences of the frames.
  */
 template <vkb::BindingType bindingType>
 class RenderContext
@@ -120,7 +130,7 @@ class RenderContext
 	 * @returns A valid command buffer to record commands to be submitted
 	 * Also ensures that there is an active frame if there is no existing active frame already
 	 */
-	std::shared_ptr<vkb::core::CommandBuffer<bindingType>> begin(vkb::CommandBufferResetMode reset_mode = vkb::CommandBufferResetMode::ResetPool);
+	vkb::core::CommandBufferHandle<bindingType> begin(vkb::CommandBufferResetMode reset_mode = vkb::CommandBufferResetMode::ResetPool);
 
 	/**
 	 * @brief begin_frame
@@ -135,6 +145,12 @@ class RenderContext
 
 	void end_frame(SemaphoreType semaphore);
 
+	/**
+	 * @brief Makes the submissions accumulated so far in the frame, when they are batched
+	 *        Can be used to start GPU work early, while the rest of the frame is recorded
+	 */
+	void flush_submissions();
+
 	/**
 	 * @brief An error should be raised if the frame is not active.
 	 *        A frame is active after @ref begin_frame has been called.
@@ -165,10 +181,21 @@ class RenderContext
 
 	std::vector<std::unique_ptr<vkb::rendering::RenderFrame<bindingType>>> &get_render_frames();
 
+	/**
+	 * @return The snapshot of the scene to record, or nullptr if subpasses read the scene directly
+	 */
+	vkb::sg::SceneSnapshot const *get_scene_snapshot() const;
+
 	Extent2DType const &get_surface_extent() const;
 
+	SubmitBuilder &get_submit_builder();
+
+	SubmitMode get_submit_mode() const;
+
 	SwapchainType const &get_swapchain() const;
 
+	FrameSyncMode get_sync_mode() const;
+
 	/**
 	 * @brief Handles surface changes, only applicable if the render_context makes use of a swapchain
 	 */
@@ -179,6 +206,12 @@ class RenderContext
 	 */
 	bool has_swapchain();
 
+	/**
+	 * @return The layout the color image of a frame is left in once rendered: the present source layout with a swapchain,
+	 *         and the transfer source layout of the offscreen images otherwise, which are only read by copies
+	 */
+	vk::ImageLayout get_final_layout() const;
+
 	/**
 	 * @brief Prepares the RenderFrames for rendering
 	 * @param thread_count The number of threads in the application, necessary to allocate this many resource pools for each RenderFrame
@@ -196,6 +229,74 @@ class RenderContext
 	 */
 	void recreate_swapchain();
 
+	/**
+	 * @brief Sets the number of RenderFrames created by @ref prepare when there is no swapchain
+	 *        Each frame has its own RenderTarget, so up to that many frames can be in flight.
+	 * @param count The depth of the ring of offscreen frames
+	 */
+	void set_offscreen_frame_count(uint32_t count);
+
+	/**
+	 * @brief Sets the snapshot of the scene the subpasses record from, instead of reading the transforms of the scene
+	 *        The snapshot must stay unchanged until the frame is recorded.
+	 * @param snapshot The snapshot, or nullptr to read the scene directly
+	 */
+	void set_scene_snapshot(vkb::sg::SceneSnapshot const *snapshot);
+
+	/**
+	 * @brief Selects how the completion of the frames is tracked
+	 *        With timeline semaphores, each submission signals the next value of the timeline of its queue, no fence is used,
+	 *        and RenderFrame::reset waits on the values signaled by the frame. The switch applies to the next submissions.
+	 * @param new_sync_mode The synchronization mode
+	 * @return False if timeline semaphores are requested but the timelineSemaphore feature is not enabled, in which case fences are kept
+	 */
+	bool set_sync_mode(FrameSyncMode new_sync_mode);
+
+	/**
+	 * @brief Selects when the submissions of a frame are made
+	 *        Batched submissions are made at the end of the frame, before presenting, with as few submit calls as possible.
+	 *        With the submission thread, queues must not be used directly between a submission and the end of the frame.
+	 * @param new_submit_mode The submission mode
+	 */
+	void set_submit_mode(SubmitMode new_submit_mode);
+
+	/**
+	 * @brief Captures the next frame to end into an image file, without blocking
+	 *        The copy is submitted with the frame before it is presented, and the file is written by worker threads
+	 *        once the frame has completed, when it is begun again. Use @ref wait_captures to wait for the files.
+	 * @param request The file name and format of the capture
+	 */
+	void request_capture(CaptureRequest request);
+
+	/**
+	 * @brief Submits the copy of a swapchain image for the oldest pending capture, for samples presenting without end_frame()
+	 *        The copy waits on the rendering of the image and signals a fence of the frame created from that image.
+	 *        @ref collect_captures hands it to the threads writing the files when the image is acquired again.
+	 * @param image_index Index of the swapchain image, which is in the present source layout
+	 * @param wait_semaphore Semaphore signaled by the rendering of the image, may be a null handle
+	 * @return The semaphore the presentation must wait on instead of wait_semaphore, which is returned if no capture is pending
+	 */
+	vk::Semaphore submit_capture(uint32_t image_index, vk::Semaphore wait_semaphore);
+
+	/**
+	 * @brief Hands the captures submitted with @ref submit_capture for a swapchain image to the encoding threads
+	 *        Called once the image is acquired again, frames later, so that the fence of the copy has usually signaled
+	 * @param image_index Index of the acquired swapchain image
+	 */
+	void collect_captures(uint32_t image_index);
+
+	/**
+	 * @brief Keeps the memory used by the application within a fraction of the memory budget, by dropping the top mip levels
+	 *        of the least recently used textures registered with the returned residency manager. It is updated when frames begin.
+	 * @param budget_fraction Fraction of the budget of each device local heap the application may use
+	 */
+	ResidencyManager &enable_residency_management(float budget_fraction = 0.9f);
+
+	/**
+	 * @return The residency manager, or nullptr if residency management is not enabled
+	 */
+	ResidencyManager *get_residency_manager();
+
 	void          release_owned_semaphore(SemaphoreType semaphore);
 	SemaphoreType request_semaphore();
 	SemaphoreType request_semaphore_with_ownership();
@@ -204,23 +305,36 @@ class RenderContext
 	 * @brief Submits the command buffer to the right queue
 	 * @param command_buffer A command buffer containing recorded commands
 	 */
-	void submit(std::shared_ptr<vkb::core::CommandBuffer<bindingType>> command_buffer);
+	void submit(vkb::core::CommandBufferHandle<bindingType> command_buffer);
 
 	/**
 	 * @brief Submits multiple command buffers to the right queue
 	 * @param command_buffers Command buffers containing recorded commands
 	 */
-	void submit(const std::vector<std::shared_ptr<vkb::core::CommandBuffer<bindingType>>> &command_buffers);
+	void submit(const std::vector<vkb::core::CommandBufferHandle<bindingType>> &command_buffers);
 
-	SemaphoreType submit(const QueueType                                                           &queue,
-	                     const std::vector<std::shared_ptr<vkb::core::CommandBuffer<bindingType>>> &command_buffers,
-	                     SemaphoreType                                                              wait_semaphore,
-	                     PipelineStageFlagsType                                                     wait_pipeline_stage);
+	SemaphoreType submit(const QueueType                                                &queue,
+	                     const std::vector<vkb::core::CommandBufferHandle<bindingType>> &command_buffers,
+	                     SemaphoreType                                                   wait_semaphore,
+	                     PipelineStageFlagsType                                          wait_pipeline_stage);
 
 	/**
 	 * @brief Submits a command buffer related to a frame to a queue
 	 */
-	void submit(const QueueType &queue, const std::vector<std::shared_ptr<vkb::core::CommandBuffer<bindingType>>> &command_buffers);
+	void submit(const QueueType &queue, const std::vector<vkb::core::CommandBufferHandle<bindingType>> &command_buffers);
+
+	/**
+	 * @brief Submits command buffers related to a frame to a queue, after other submissions, only with timeline semaphores
+	 * @param queue The queue to submit to
+	 * @param command_buffers Command buffers containing recorded commands
+	 * @param wait_points Submissions, possibly on other queues, to wait for
+	 * @param wait_pipeline_stage Stages of the command buffers which wait for the submissions
+	 * @return The timeline point of the submission, which can be waited for by later submissions
+	 */
+	TimelinePoint submit(const QueueType                                                &queue,
+	                     const std::vector<vkb::core::CommandBufferHandle<bindingType>> &command_buffers,
+	                     std::vector<TimelinePoint> const                               &wait_points,
+	                     PipelineStageFlagsType                                          wait_pipeline_stage);
 
 	/**
 	 * @brief Updates the swapchains extent, if a swapchain exists
@@ -259,14 +373,45 @@ class RenderContext
 	 */
 	virtual void wait_frame();
 
+	/**
+	 * @brief Waits for all the captured frames to be written, waiting for the device to be idle first
+	 */
+	void wait_captures();
+
   private:
+	vk::Semaphore capture_frame(vk::Semaphore wait_semaphore);
 	void          initialize_swapchain(vk::SurfaceKHR surface, vk::PresentModeKHR present_movde, std::vector<vk::PresentModeKHR> const &present_mode_priority_list, std::vector<vk::SurfaceFormatKHR> const &surface_format_priority_list);
-	void          submit_impl(const std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> &command_buffers);
-	vk::Semaphore submit_impl(vkb::core::HPPQueue const                                       &queue,
-	                          std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> const &command_buffers,
-	                          vk::Semaphore                                                    wait_semaphore,
-	                          vk::PipelineStageFlags                                           wait_pipeline_stage);
-	void          submit_impl(vkb::core::HPPQueue const &queue, std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> const &command_buffers);
+	void          submit_impl(const std::vector<vkb::core::CommandBufferHandleCpp> &command_buffers);
+	void          update_residency();
+	vk::Semaphore submit_impl(vkb::core::HPPQueue const                            &queue,
+	                          std::vector<vkb::core::CommandBufferHandleCpp> const &command_buffers,
+	                          vk::Semaphore                                         wait_semaphore,
+	                          vk::PipelineStageFlags                                wait_pipeline_stage);
+	void          submit_impl(vkb::core::HPPQueue const &queue, std::vector<vkb::core::CommandBufferHandleCpp> const &command_buffers);
+	TimelinePoint submit_impl(vkb::core::HPPQueue const                            &queue,
+	                          std::vector<vkb::core::CommandBufferHandleCpp> const &command_buffers,
+	                          std::vector<TimelinePoint> const                     &wait_points,
+	                          vk::PipelineStageFlags                                wait_pipeline_stage);
+
+	/**
+	 * @brief Hands command buffers of the active frame to the submit builder, and flushes it unless submissions are batched
+	 *        Their completion is tracked with a fence per queue and flush, or with the timeline of the queue
+	 * @return The timeline point of the submission, or an empty point with fences
+	 */
+	TimelinePoint submit_frame_impl(vkb::core::HPPQueue const                            &queue,
+	                                std::vector<vkb::core::CommandBufferHandleCpp> const &command_buffers,
+	                                vk::Semaphore                                         wait_semaphore,
+	                                vk::PipelineStageFlags                                wait_semaphore_stage,
+	                                std::vector<TimelinePoint> const                     &wait_points,
+	                                vk::PipelineStageFlags                                wait_points_stage,
+	                                vk::Semaphore                                         signal_semaphore);
+	TimelinePoint submit_frame_impl(vkb::core::HPPQueue const            &queue,
+	                                std::vector<vk::CommandBuffer> const &command_buffers,
+	                                vk::Semaphore                         wait_semaphore,
+	                                vk::PipelineStageFlags                wait_semaphore_stage,
+	                                std::vector<TimelinePoint> const     &wait_points,
+	                                vk::PipelineStageFlags                wait_points_stage,
+	                                vk::Semaphore                         signal_semaphore);
 	void          update_swapchain_impl(vk::Extent2D const &extent, vk::SurfaceTransformFlagBitsKHR transform);
 
   private:
@@ -275,13 +420,21 @@ class RenderContext
 	RenderTargetCpp::CreateFunc                                  create_render_target_func = RenderTargetCpp::DEFAULT_CREATE_FUNC;
 	vkb::core::DeviceCpp                                        &device;
 	bool                                                         frame_active = false;        // Whether a frame is active or not
+	std::unique_ptr<FrameCapture>                                frame_capture;               // Created on the first capture request
 	std::vector<std::unique_ptr<vkb::rendering::RenderFrameCpp>> frames;
-	vk::SurfaceTransformFlagBitsKHR                              pre_transform = vk::SurfaceTransformFlagBitsKHR::eIdentity;
-	bool                                                         prepared      = false;
+	uint32_t                                                     offscreen_frame_count = 1;        // Frames created without a swapchain
+	vk::SurfaceTransformFlagBitsKHR                              pre_transform         = vk::SurfaceTransformFlagBitsKHR::eIdentity;
+	bool                                                         prepared              = false;
 	const vkb::core::HPPQueue                                   &queue;        // If swapchain exists, then this will be a present supported queue, else a graphics queue
+	std::unique_ptr<QueueTimelines>                              queue_timelines;        // Created when switching to timeline semaphores, kept afterwards
+	std::unique_ptr<ResidencyManager>                            residency_manager;        // Created when residency management is enabled
+	vkb::sg::SceneSnapshot const                                *scene_snapshot = nullptr;
+	SubmitBuilder                                                submit_builder;
+	SubmitMode                                                   submit_mode = SubmitMode::Immediate;
 	vk::Extent2D                                                 surface_extent;
 	std::unique_ptr<vkb::core::HPPSwapchain>                     swapchain;
 	vkb::core::HPPSwapchainProperties                            swapchain_properties;
+	FrameSyncMode                                                sync_mode    = FrameSyncMode::Fences;
 	size_t                                                       thread_count = 1;
 	const vkb::Window                                           &window;
 };
@@ -301,6 +454,7 @@ inline RenderContextCpp::RenderContext(vkb::core::DeviceCpp                    &
     device(device),
     window(window),
     queue(device.get_queue_by_flags(vk::QueueFlagBits::eGraphics, 0)),
+    submit_builder(device),
     surface_extent{window.get_extent().width, window.get_extent().height}
 {
 	initialize_swapchain(surface, present_mode, present_mode_priority_list, surface_format_priority_list);
@@ -316,6 +470,7 @@ inline RenderContextC::RenderContext(vkb::core::DeviceC                    &devi
     device(reinterpret_cast<vkb::core::DeviceCpp &>(device)),
     window(window),
     queue(reinterpret_cast<vkb::core::HPPQueue const &>(device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0))),
+    submit_builder(reinterpret_cast<vkb::core::DeviceCpp &>(device)),
     surface_extent{window.get_extent().width, window.get_extent().height}
 {
 	initialize_swapchain(static_cast<vk::SurfaceKHR>(surface),
@@ -347,7 +502,7 @@ inline void RenderContext<bindingType>::initialize_swapchain(vk::SurfaceKHR
 }
 
 template <vkb::BindingType bindingType>
-inline std::shared_ptr<vkb::core::CommandBuffer<bindingType>> RenderContext<bindingType>::begin(vkb::CommandBufferResetMode reset_mode)
+inline vkb::core::CommandBufferHandle<bindingType> RenderContext<bindingType>::begin(vkb::CommandBufferResetMode reset_mode)
 {
 	assert(prepared && "HPPRenderContext not prepared for rendering, call prepare()");
 
@@ -356,7 +511,7 @@ inline std::shared_ptr<vkb::core::CommandBuffer<bindingType>> RenderContext<bind
 		begin_frame();
 	}
 
-	if (!acquired_semaphore)
+	if (swapchain && !acquired_semaphore)
 	{
 		throw std::runtime_error("Couldn't begin frame");
 	}
@@ -383,14 +538,14 @@ inline void RenderContext<bindingType>::begin_frame()
 
 	assert(!frame_active && "Frame is still active, please call end_frame");
 
-	auto &prev_frame = *frames[active_frame_index];
-
-	// We will use the acquired semaphore in a different frame context,
-	// so we need to hold ownership.
-	acquired_semaphore = prev_frame.get_semaphore_pool().request_semaphore_with_ownership();
-
 	if (swapchain)
 	{
+		auto &prev_frame = *frames[active_frame_index];
+
+		// We will use the acquired semaphore in a different frame context,
+		// so we need to hold ownership.
+		acquired_semaphore = prev_frame.get_semaphore_pool().request_semaphore_with_ownership();
+
 		vk::Result result;
 		try
 		{
@@ -426,12 +581,66 @@ inline void RenderContext<bindingType>::begin_frame()
 			return;
 		}
 	}
+	else
+	{
+		// Without a swapchain nothing is acquired, the frames are used in turn and wait_frame waits for the fences of the next one
+		active_frame_index = (active_frame_index + 1) % to_u32(frames.size());
+	}
 
 	// Now the frame is active again
 	frame_active = true;
 
 	// Wait on all resource to be freed from the previous render to this frame
 	wait_frame();
+
+	// The captures recorded the last time this frame was rendered have completed
+	if (frame_capture)
+	{
+		frame_capture->collect(active_frame_index);
+	}
+
+	if (residency_manager)
+	{
+		update_residency();
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::update_residency()
+{
+	vk::CommandBuffer command_buffer = residency_manager->update(active_frame_index);
+
+	// The descriptor sets cached by the frame may refer to images which were replaced
+	if (residency_manager->has_replaced_images(active_frame_index))
+	{
+		frames[active_frame_index]->clear_descriptors();
+	}
+
+	// The copies are submitted ahead of the rendering of the frame, which samples the new images
+	if (command_buffer)
+	{
+		submit_frame_impl(queue, std::vector<vk::CommandBuffer>{command_buffer}, nullptr, {}, {}, {}, nullptr);
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline vk::Semaphore RenderContext<bindingType>::capture_frame(vk::Semaphore wait_semaphore)
+{
+	vkb::rendering::RenderFrameCpp &frame = *frames[active_frame_index];
+	assert(!frame.get_render_target().get_views().empty());
+
+	vk::CommandBuffer command_buffer = frame_capture->record(frame.get_render_target().get_views()[0], get_final_layout(), active_frame_index);
+	if (!command_buffer)
+	{
+		return wait_semaphore;
+	}
+
+	// Without a swapchain nothing waits on the image, and a binary semaphore must not be left signaled
+	vk::Semaphore signal_semaphore = swapchain ? frame.get_semaphore_pool().request_semaphore() : nullptr;
+
+	submit_frame_impl(queue, std::vector<vk::CommandBuffer>{command_buffer}, wait_semaphore, vk::PipelineStageFlagBits::eTransfer, {}, {}, signal_semaphore);
+
+	return signal_semaphore;
 }
 
 template <vkb::BindingType bindingType>
@@ -446,18 +655,26 @@ inline void RenderContext<bindingType>::end_frame(SemaphoreType semaphore)
 {
 	assert(frame_active && "Frame is not active, please call begin_frame");
 
+	vk::Semaphore present_wait_semaphore = static_cast<vk::Semaphore>(semaphore);
+
+	// The image is copied before it is handed to the presentation engine
+	if (frame_capture && frame_capture->has_requests())
+	{
+		present_wait_semaphore = capture_frame(present_wait_semaphore);
+	}
+
+	// The semaphore waited on by the presentation must be signaled by a submission made before
+	flush_submissions();
+	submit_builder.wait_submitted();
+
 	if (swapchain)
 	{
 		vk::SwapchainKHR   vk_swapchain = swapchain->get_handle();
-		vk::PresentInfoKHR present_info{.waitSemaphoreCount = 1, .swapchainCount = 1, .pSwapchains = &vk_swapchain, .pImageIndices = &active_frame_index};
-		if constexpr (bindingType == BindingType::Cpp)
-		{
-			present_info.pWaitSemaphores = &semaphore;
-		}
-		else
-		{
-			present_info.pWaitSemaphores = reinterpret_cast<vk::Semaphore *>(&semaphore);
-		}
+		vk::PresentInfoKHR present_info{.waitSemaphoreCount = 1,
+		                                .pWaitSemaphores    = &present_wait_semaphore,
+		                                .swapchainCount     = 1,
+		                                .pSwapchains        = &vk_swapchain,
+		                                .pImageIndices      = &active_frame_index};
 
 		vk::DisplayPresentInfoKHR disp_present_info;
 		if (device.get_gpu().is_extension_supported(VK_KHR_DISPLAY_SWAPCHAIN_EXTENSION_NAME) &&
@@ -492,6 +709,21 @@ inline void RenderContext<bindingType>::end_frame(SemaphoreType semaphore)
 	frame_active = false;
 }
 
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::flush_submissions()
+{
+	if (sync_mode == FrameSyncMode::Fences)
+	{
+		// One fence per queue, signaled once all the batches of the frame on that queue complete
+		for (auto *pending_queue : submit_builder.get_pending_queues())
+		{
+			submit_builder.set_fence(*pending_queue, frames[active_frame_index]->get_fence_pool().request_fence());
+		}
+	}
+
+	submit_builder.flush();
+}
+
 template <vkb::BindingType bindingType>
 inline vkb::rendering::RenderFrame<bindingType> &RenderContext<bindingType>::get_active_frame()
 {
@@ -567,6 +799,12 @@ inline std::vector<std::unique_ptr<vkb::rendering::RenderFrame<bindingType>>> &R
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline vkb::sg::SceneSnapshot const *RenderContext<bindingType>::get_scene_snapshot() const
+{
+	return scene_snapshot;
+}
+
 template <vkb::BindingType bindingType>
 inline typename RenderContext<bindingType>::Extent2DType const &RenderContext<bindingType>::get_surface_extent() const
 {
@@ -580,6 +818,18 @@ inline typename RenderContext<bindingType>::Extent2DType const &RenderContext<bi
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline SubmitBuilder &RenderContext<bindingType>::get_submit_builder()
+{
+	return submit_builder;
+}
+
+template <vkb::BindingType bindingType>
+inline SubmitMode RenderContext<bindingType>::get_submit_mode() const
+{
+	return submit_mode;
+}
+
 template <vkb::BindingType bindingType>
 inline typename RenderContext<bindingType>::SwapchainType const &RenderContext<bindingType>::get_swapchain() const
 {
@@ -594,6 +844,12 @@ inline typename RenderContext<bindingType>::SwapchainType const &RenderContext<b
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline FrameSyncMode RenderContext<bindingType>::get_sync_mode() const
+{
+	return sync_mode;
+}
+
 template <vkb::BindingType bindingType>
 inline bool RenderContext<bindingType>::handle_surface_changes(bool force_update)
 {
@@ -644,6 +900,12 @@ inline bool RenderContext<bindingType>::has_swapchain()
 	return swapchain != nullptr;
 }
 
+template <vkb::BindingType bindingType>
+inline vk::ImageLayout RenderContext<bindingType>::get_final_layout() const
+{
+	return swapchain ? vk::ImageLayout::ePresentSrcKHR : vk::ImageLayout::eTransferSrcOptimal;
+}
+
 template <vkb::BindingType bindingType>
 inline void RenderContext<bindingType>::prepare(size_t thread_count, typename vkb::rendering::RenderTarget<bindingType>::CreateFunc create_render_target_func_)
 {
@@ -658,6 +920,10 @@ inline void RenderContext<bindingType>::prepare(size_t thread_count, typename vk
 
 	device.get_handle().waitIdle();
 
+	// Only the render targets allocate memory until the frames are prepared, which gives the memory they use
+	vk::DeviceSize render_target_memory = vkb::allocated::get_memory_usage(vkb::allocated::MemoryCategory::RenderTargets);
+	vk::DeviceSize transient_memory     = vkb::allocated::get_memory_usage(vkb::allocated::MemoryCategory::Transient);
+
 	if (swapchain)
 	{
 		surface_extent = swapchain->get_extent();
@@ -669,23 +935,38 @@ inline void RenderContext<bindingType>::prepare(size_t thread_count, typename vk
 			vkb::core::HPPImage swapchain_image{device, image_handle, extent, swapchain->get_format(), swapchain->get_usage()};
 			auto                render_target = create_render_target_func(std::move(swapchain_image));
 			frames.emplace_back(std::make_unique<vkb::rendering::RenderFrameCpp>(device, std::move(render_target), thread_count));
+			frames.back()->set_queue_timelines(queue_timelines.get());
 		}
 	}
 	else
 	{
-		// Otherwise, create a single RenderFrame
+		// Otherwise, create a ring of RenderFrames with their own offscreen images
 		swapchain = nullptr;
 
-		auto color_image = vkb::core::HPPImage{device,
-		                                       vk::Extent3D{surface_extent.width, surface_extent.height, 1},
-		                                       DEFAULT_VK_FORMAT,        // We can use any format here that we like
-		                                       vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
-		                                       VMA_MEMORY_USAGE_GPU_ONLY};
+		for (uint32_t i = 0; i < offscreen_frame_count; ++i)
+		{
+			auto color_image = vkb::core::HPPImage{device,
+			                                       vk::Extent3D{surface_extent.width, surface_extent.height, 1},
+			                                       DEFAULT_VK_FORMAT,        // We can use any format here that we like
+			                                       vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
+			                                       VMA_MEMORY_USAGE_GPU_ONLY};
+
+			std::unique_ptr<RenderTargetCpp> render_target = create_render_target_func(std::move(color_image));
+			frames.emplace_back(std::make_unique<vkb::rendering::RenderFrameCpp>(device, std::move(render_target), thread_count));
+			frames.back()->set_queue_timelines(queue_timelines.get());
+		}
 
-		std::unique_ptr<RenderTargetCpp> render_target = create_render_target_func(std::move(color_image));
-		frames.emplace_back(std::make_unique<vkb::rendering::RenderFrameCpp>(device, std::move(render_target), thread_count));
+		// The first frame begun is the first one of the ring
+		active_frame_index = offscreen_frame_count - 1;
 	}
 
+	render_target_memory = vkb::allocated::get_memory_usage(vkb::allocated::MemoryCategory::RenderTargets) - render_target_memory;
+	transient_memory     = vkb::allocated::get_memory_usage(vkb::allocated::MemoryCategory::Transient) - transient_memory;
+	LOGI("Render targets of {} frames: {:.1f} MiB of attachments, {:.1f} MiB of transient attachments",
+	     frames.size(),
+	     render_target_memory / (1024.0 * 1024.0),
+	     transient_memory / (1024.0 * 1024.0));
+
 	this->thread_count = thread_count;
 	this->prepared     = true;
 }
@@ -714,6 +995,7 @@ inline void RenderContext<bindingType>::recreate()
 		{
 			// Create a new frame if the new swapchain has more images than current frames
 			frames.emplace_back(std::make_unique<vkb::rendering::RenderFrameCpp>(device, std::move(render_target), thread_count));
+			frames.back()->set_queue_timelines(queue_timelines.get());
 		}
 
 		++frame_it;
@@ -743,12 +1025,145 @@ inline void RenderContext<bindingType>::recreate_swapchain()
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::set_offscreen_frame_count(uint32_t count)
+{
+	assert(!prepared && "The offscreen frames are created by prepare()");
+	assert(0 < count);
+
+	offscreen_frame_count = count;
+}
+
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::set_scene_snapshot(vkb::sg::SceneSnapshot const *snapshot)
+{
+	scene_snapshot = snapshot;
+}
+
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::set_submit_mode(SubmitMode new_submit_mode)
+{
+	assert(!frame_active && "The submission mode can't change in the middle of a frame");
+
+	submit_builder.set_submit_thread(new_submit_mode == SubmitMode::BatchedOnThread);
+	submit_mode = new_submit_mode;
+}
+
+template <vkb::BindingType bindingType>
+inline bool RenderContext<bindingType>::set_sync_mode(FrameSyncMode new_sync_mode)
+{
+	if (new_sync_mode == FrameSyncMode::TimelineSemaphores && !queue_timelines)
+	{
+		if (!device.is_timeline_semaphore_enabled())
+		{
+			LOGW("Can't synchronize frames with timeline semaphores. The timelineSemaphore feature is not enabled, keeping fences.");
+			return false;
+		}
+
+		queue_timelines = std::make_unique<QueueTimelines>(device);
+		for (auto &frame : frames)
+		{
+			frame->set_queue_timelines(queue_timelines.get());
+		}
+	}
+
+	// Submissions already made are still waited on by their frames, whatever they were tracked with
+	sync_mode = new_sync_mode;
+	return true;
+}
+
 template <vkb::BindingType bindingType>
 inline void RenderContext<bindingType>::release_owned_semaphore(SemaphoreType semaphore)
 {
 	get_active_frame().get_semaphore_pool().release_owned_semaphore(semaphore);
 }
 
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::request_capture(CaptureRequest request)
+{
+	assert(prepared && "RenderContext not prepared for rendering, call prepare()");
+
+	if (!frame_capture)
+	{
+		// One readback buffer per frame in flight, and one more for the captures being written
+		frame_capture = std::make_unique<FrameCapture>(device, queue.get_family_index(), to_u32(frames.size()) + 1);
+	}
+	frame_capture->request(std::move(request));
+}
+
+template <vkb::BindingType bindingType>
+inline vk::Semaphore RenderContext<bindingType>::submit_capture(uint32_t image_index, vk::Semaphore wait_semaphore)
+{
+	assert(image_index < frames.size() && "Swapchain image index out of bounds");
+
+	if (!frame_capture || !frame_capture->has_requests())
+	{
+		return wait_semaphore;
+	}
+
+	// The frames are created from the swapchain images, in the same order
+	vkb::rendering::RenderFrameCpp &frame          = *frames[image_index];
+	vk::CommandBuffer               command_buffer = frame_capture->record(frame.get_render_target().get_views()[0], vk::ImageLayout::ePresentSrcKHR, image_index);
+	if (!command_buffer)
+	{
+		return wait_semaphore;
+	}
+
+	vk::Semaphore          signal_semaphore = frame.get_semaphore_pool().request_semaphore();
+	vk::PipelineStageFlags wait_stage       = vk::PipelineStageFlagBits::eTransfer;
+	vk::SubmitInfo         submit_info{.commandBufferCount = 1, .pCommandBuffers = &command_buffer, .signalSemaphoreCount = 1, .pSignalSemaphores = &signal_semaphore};
+	if (wait_semaphore)
+	{
+		submit_info.setWaitSemaphores(wait_semaphore);
+		submit_info.setWaitDstStageMask(wait_stage);
+	}
+
+	{
+		auto guard = queue.lock();
+		queue.get_handle().submit(submit_info, frame.get_fence_pool().request_fence());
+	}
+
+	return signal_semaphore;
+}
+
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::collect_captures(uint32_t image_index)
+{
+	assert(image_index < frames.size() && "Swapchain image index out of bounds");
+
+	if (!frame_capture)
+	{
+		return;
+	}
+
+	// The copy was submitted when the image was last presented, frames ago, so its fence has usually signaled by now
+	vkb::rendering::RenderFrameCpp &frame = *frames[image_index];
+	VK_CHECK(frame.get_fence_pool().wait());
+	VK_CHECK(frame.get_fence_pool().reset());
+	frame.get_semaphore_pool().reset();
+
+	frame_capture->collect(image_index);
+}
+
+template <vkb::BindingType bindingType>
+inline ResidencyManager &RenderContext<bindingType>::enable_residency_management(float budget_fraction)
+{
+	assert(prepared && "RenderContext not prepared for rendering, call prepare()");
+
+	if (!residency_manager)
+	{
+		residency_manager = std::make_unique<ResidencyManager>(device, queue.get_family_index(), to_u32(frames.size()), budget_fraction);
+	}
+	residency_manager->set_budget_fraction(budget_fraction);
+	return *residency_manager;
+}
+
+template <vkb::BindingType bindingType>
+inline ResidencyManager *RenderContext<bindingType>::get_residency_manager()
+{
+	return residency_manager.get();
+}
+
 template <vkb::BindingType bindingType>
 inline typename RenderContext<bindingType>::SemaphoreType RenderContext<bindingType>::request_semaphore()
 {
@@ -762,14 +1177,14 @@ inline typename RenderContext<bindingType>::SemaphoreType RenderContext<bindingT
 }
 
 template <vkb::BindingType bindingType>
-inline void RenderContext<bindingType>::submit(std::shared_ptr<vkb::core::CommandBuffer<bindingType>> command_buffer)
+inline void RenderContext<bindingType>::submit(vkb::core::CommandBufferHandle<bindingType> command_buffer)
 {
-	std::vector<std::shared_ptr<vkb::core::CommandBuffer<bindingType>>> command_buffers(1, command_buffer);
+	std::vector<vkb::core::CommandBufferHandle<bindingType>> command_buffers(1, command_buffer);
 	submit(command_buffers);
 }
 
 template <vkb::BindingType bindingType>
-inline void RenderContext<bindingType>::submit(const std::vector<std::shared_ptr<vkb::core::CommandBuffer<bindingType>>> &command_buffers)
+inline void RenderContext<bindingType>::submit(const std::vector<vkb::core::CommandBufferHandle<bindingType>> &command_buffers)
 {
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
@@ -777,12 +1192,12 @@ inline void RenderContext<bindingType>::submit(const std::vector<std::shared_ptr
 	}
 	else
 	{
-		submit_impl(reinterpret_cast<std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> const &>(command_buffers));
+		submit_impl(reinterpret_cast<std::vector<vkb::core::CommandBufferHandleCpp> const &>(command_buffers));
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline void RenderContext<bindingType>::submit_impl(std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> const &command_buffers)
+inline void RenderContext<bindingType>::submit_impl(std::vector<vkb::core::CommandBufferHandleCpp> const &command_buffers)
 {
 	assert(frame_active && "RenderContext is inactive, cannot submit command buffer. Please call begin()");
 
@@ -803,10 +1218,10 @@ inline void RenderContext<bindingType>::submit_impl(std::vector<std::shared_ptr<
 
 template <vkb::BindingType bindingType>
 inline typename RenderContext<bindingType>::SemaphoreType
-    RenderContext<bindingType>::submit(const QueueType                                                           &queue,
-                                       const std::vector<std::shared_ptr<vkb::core::CommandBuffer<bindingType>>> &command_buffers,
-                                       SemaphoreType                                                              wait_semaphore,
-                                       PipelineStageFlagsType                                                     wait_pipeline_stage)
+    RenderContext<bindingType>::submit(const QueueType                                                &queue,
+                                       const std::vector<vkb::core::CommandBufferHandle<bindingType>> &command_buffers,
+                                       SemaphoreType                                                   wait_semaphore,
+                                       PipelineStageFlagsType                                          wait_pipeline_stage)
 {
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
@@ -815,71 +1230,150 @@ inline typename RenderContext<bindingType>::SemaphoreType
 	else
 	{
 		return static_cast<VkSemaphore>(submit_impl(reinterpret_cast<vkb::core::HPPQueue const &>(queue),
-		                                            reinterpret_cast<std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> const &>(command_buffers),
+		                                            reinterpret_cast<std::vector<vkb::core::CommandBufferHandleCpp> const &>(command_buffers),
 		                                            static_cast<vk::Semaphore>(wait_semaphore),
 		                                            static_cast<vk::PipelineStageFlags>(wait_pipeline_stage)));
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline vk::Semaphore RenderContext<bindingType>::submit_impl(const vkb::core::HPPQueue                                       &queue,
-                                                             const std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> &command_buffers,
-                                                             vk::Semaphore                                                    wait_semaphore,
-                                                             vk::PipelineStageFlags                                           wait_pipeline_stage)
+inline vk::Semaphore RenderContext<bindingType>::submit_impl(const vkb::core::HPPQueue                            &queue,
+                                                             const std::vector<vkb::core::CommandBufferHandleCpp> &command_buffers,
+                                                             vk::Semaphore                                         wait_semaphore,
+                                                             vk::PipelineStageFlags                                wait_pipeline_stage)
 {
-	std::vector<vk::CommandBuffer> cmd_buf_handles(command_buffers.size(), nullptr);
-	std::ranges::transform(command_buffers, cmd_buf_handles.begin(), [](auto const &cmd_buf) { return cmd_buf->get_handle(); });
-
-	vkb::rendering::RenderFrameCpp &frame = *frames[active_frame_index];
+	vk::Semaphore signal_semaphore = frames[active_frame_index]->get_semaphore_pool().request_semaphore();
 
-	vk::Semaphore signal_semaphore = frame.get_semaphore_pool().request_semaphore();
+	submit_frame_impl(queue, command_buffers, wait_semaphore, wait_pipeline_stage, {}, {}, signal_semaphore);
 
-	vk::SubmitInfo submit_info{.commandBufferCount   = to_u32(cmd_buf_handles.size()),
-	                           .pCommandBuffers      = cmd_buf_handles.data(),
-	                           .signalSemaphoreCount = 1,
-	                           .pSignalSemaphores    = &signal_semaphore};
+	return signal_semaphore;
+}
 
-	if (wait_semaphore != nullptr)
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::submit(const QueueType                                                &queue,
+                                               const std::vector<vkb::core::CommandBufferHandle<bindingType>> &command_buffers)
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
-		submit_info.waitSemaphoreCount = 1;
-		submit_info.pWaitSemaphores    = &wait_semaphore;
-		submit_info.pWaitDstStageMask  = &wait_pipeline_stage;
+		submit_impl(queue, command_buffers);
 	}
+	else
+	{
+		submit_impl(reinterpret_cast<vkb::core::HPPQueue const &>(queue),
+		            reinterpret_cast<std::vector<vkb::core::CommandBufferHandleCpp> const &>(command_buffers));
+	}
+}
 
-	vk::Fence fence = frame.get_fence_pool().request_fence();
-
-	queue.get_handle().submit(submit_info, fence);
-
-	return signal_semaphore;
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::submit_impl(vkb::core::HPPQueue const                            &queue,
+                                                    const std::vector<vkb::core::CommandBufferHandleCpp> &command_buffers)
+{
+	submit_frame_impl(queue, command_buffers, nullptr, {}, {}, {}, nullptr);
 }
 
 template <vkb::BindingType bindingType>
-inline void RenderContext<bindingType>::submit(const QueueType                                                           &queue,
-                                               const std::vector<std::shared_ptr<vkb::core::CommandBuffer<bindingType>>> &command_buffers)
+inline TimelinePoint RenderContext<bindingType>::submit(const QueueType                                                &queue,
+                                                        const std::vector<vkb::core::CommandBufferHandle<bindingType>> &command_buffers,
+                                                        std::vector<TimelinePoint> const                               &wait_points,
+                                                        PipelineStageFlagsType                                          wait_pipeline_stage)
 {
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
-		submit_impl(queue, command_buffers);
+		return submit_impl(queue, command_buffers, wait_points, wait_pipeline_stage);
 	}
 	else
 	{
-		submit_impl(reinterpret_cast<vkb::core::HPPQueue const &>(queue),
-		            reinterpret_cast<std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> const &>(command_buffers));
+		return submit_impl(reinterpret_cast<vkb::core::HPPQueue const &>(queue),
+		                   reinterpret_cast<std::vector<vkb::core::CommandBufferHandleCpp> const &>(command_buffers),
+		                   wait_points,
+		                   static_cast<vk::PipelineStageFlags>(wait_pipeline_stage));
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline void RenderContext<bindingType>::submit_impl(vkb::core::HPPQueue const                                       &queue,
-                                                    const std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> &command_buffers)
+inline TimelinePoint RenderContext<bindingType>::submit_impl(vkb::core::HPPQueue const                            &queue,
+                                                             std::vector<vkb::core::CommandBufferHandleCpp> const &command_buffers,
+                                                             std::vector<TimelinePoint> const                     &wait_points,
+                                                             vk::PipelineStageFlags                                wait_pipeline_stage)
+{
+	if (sync_mode != FrameSyncMode::TimelineSemaphores)
+	{
+		throw std::runtime_error("Submissions can only wait on timeline points when frames are synchronized with timeline semaphores");
+	}
+
+	return submit_frame_impl(queue, command_buffers, nullptr, {}, wait_points, wait_pipeline_stage, nullptr);
+}
+
+template <vkb::BindingType bindingType>
+inline TimelinePoint RenderContext<bindingType>::submit_frame_impl(vkb::core::HPPQueue const                            &queue,
+                                                                   std::vector<vkb::core::CommandBufferHandleCpp> const &command_buffers,
+                                                                   vk::Semaphore                                         wait_semaphore,
+                                                                   vk::PipelineStageFlags                                wait_semaphore_stage,
+                                                                   std::vector<TimelinePoint> const                     &wait_points,
+                                                                   vk::PipelineStageFlags                                wait_points_stage,
+                                                                   vk::Semaphore                                         signal_semaphore)
 {
 	std::vector<vk::CommandBuffer> cmd_buf_handles(command_buffers.size(), nullptr);
 	std::ranges::transform(command_buffers, cmd_buf_handles.begin(), [](auto const &cmd_buf) { return cmd_buf->get_handle(); });
 
-	vk::SubmitInfo submit_info{.commandBufferCount = to_u32(cmd_buf_handles.size()), .pCommandBuffers = cmd_buf_handles.data()};
+	return submit_frame_impl(queue, cmd_buf_handles, wait_semaphore, wait_semaphore_stage, wait_points, wait_points_stage, signal_semaphore);
+}
+
+template <vkb::BindingType bindingType>
+inline TimelinePoint RenderContext<bindingType>::submit_frame_impl(vkb::core::HPPQueue const            &queue,
+                                                                   std::vector<vk::CommandBuffer> const &command_buffers,
+                                                                   vk::Semaphore                         wait_semaphore,
+                                                                   vk::PipelineStageFlags                wait_semaphore_stage,
+                                                                   std::vector<TimelinePoint> const     &wait_points,
+                                                                   vk::PipelineStageFlags                wait_points_stage,
+                                                                   vk::Semaphore                         signal_semaphore)
+{
+	vkb::rendering::RenderFrameCpp &frame = *frames[active_frame_index];
+
+	// Legacy stage bits keep their values in the synchronization2 stages
+	auto to_stage_mask2 = [](vk::PipelineStageFlags stage_mask) {
+		return static_cast<vk::PipelineStageFlags2>(static_cast<VkPipelineStageFlags>(stage_mask));
+	};
+
+	// Binary semaphores take a value of 0, which is ignored
+	std::vector<SemaphoreSubmit> wait_semaphores;
+	std::vector<SemaphoreSubmit> signal_semaphores;
+
+	if (wait_semaphore)
+	{
+		wait_semaphores.push_back({.semaphore = wait_semaphore, .stage_mask = to_stage_mask2(wait_semaphore_stage)});
+	}
+
+	for (auto &point : wait_points)
+	{
+		if (point.value != 0)
+		{
+			wait_semaphores.push_back({.semaphore  = queue_timelines->get_semaphore(point.queue_family_index, point.queue_index),
+			                           .value      = point.value,
+			                           .stage_mask = to_stage_mask2(wait_points_stage)});
+		}
+	}
+
+	if (signal_semaphore)
+	{
+		signal_semaphores.push_back({.semaphore = signal_semaphore});
+	}
+
+	TimelinePoint point;
+	if (sync_mode == FrameSyncMode::TimelineSemaphores)
+	{
+		point = frame.request_timeline_point(queue);
+		signal_semaphores.push_back({.semaphore = queue_timelines->get_semaphore(point.queue_family_index, point.queue_index), .value = point.value});
+	}
 
-	vk::Fence fence = frames[active_frame_index]->get_fence_pool().request_fence();
+	submit_builder.add(queue, command_buffers, wait_semaphores, signal_semaphores);
+
+	if (submit_mode == SubmitMode::Immediate)
+	{
+		flush_submissions();
+	}
 
-	queue.get_handle().submit(submit_info, fence);
+	return point;
 }
 
 template <vkb::BindingType bindingType>
@@ -1012,5 +1506,16 @@ inline void RenderContext<bindingType>::wait_frame()
 	get_active_frame().reset();
 }
 
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::wait_captures()
+{
+	if (frame_capture)
+	{
+		device.get_handle().waitIdle();
+		frame_capture->collect_all();
+		frame_capture->wait_encoded();
+	}
+}
+
 }        // namespace rendering
 }        // namespace vkb
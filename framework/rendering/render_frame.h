@@ -18,11 +18,13 @@
 #pragma once
 
 #include "buffer_pool.h"
+#include "common/binding_table.h"
 #include "common/hpp_resource_caching.h"
 #include "core/command_pool.h"
 #include "core/hpp_queue.h"
 #include "core/queue.h"
 #include "hpp_semaphore_pool.h"
+#include "rendering/queue_timelines.h"
 
 namespace vkb
 {
@@ -86,6 +88,16 @@ class RenderFrame
 	 */
 	vkb::BufferAllocation<bindingType> allocate_buffer(BufferUsageFlagsType usage, DeviceSizeType size, size_t thread_index = 0);
 
+	/**
+	 * @brief Allocates memory for descriptors from the descriptor heap of the frame, a buffer of descriptors for VK_EXT_descriptor_buffer
+	 *        The heap is emptied when the frame is reset, and frames are reset in turn, so that their heaps form a ring.
+	 *        When the heap is full it is replaced by a larger one, the previous heap is kept until the frame is reset.
+	 * @param size Amount of memory required
+	 * @param thread_index Index of the descriptor heap to be used by the current thread
+	 * @return The requested allocation, whose buffer changes when the heap is replaced
+	 */
+	vkb::BufferAllocation<bindingType> allocate_descriptor_heap(DeviceSizeType size, size_t thread_index = 0);
+
 	void clear_descriptors();
 
 	/**
@@ -106,13 +118,32 @@ class RenderFrame
 	vkb::rendering::RenderTarget<bindingType> const &get_render_target() const;
 	SemaphorePoolType                               &get_semaphore_pool();
 	SemaphorePoolType const                         &get_semaphore_pool() const;
+	std::vector<TimelinePoint> const                &get_timeline_points() const;
 	DescriptorSetType                                request_descriptor_set(DescriptorSetLayoutType const              &descriptor_set_layout,
 	                                                                        BindingMap<DescriptorBufferInfoType> const &buffer_infos,
 	                                                                        BindingMap<DescriptorImageInfoType> const  &image_infos,
 	                                                                        bool                                        update_after_bind,
 	                                                                        size_t                                      thread_index = 0);
+	DescriptorSetType                                request_descriptor_set(DescriptorSetLayoutType const                &descriptor_set_layout,
+	                                                                        BindingTable<DescriptorBufferInfoType> const &buffer_infos,
+	                                                                        BindingTable<DescriptorImageInfoType> const  &image_infos,
+	                                                                        bool                                          update_after_bind,
+	                                                                        size_t                                        thread_index = 0);
 	void                                             reset();
 
+	/**
+	 * @brief Reserves the timeline value to be signaled by the next submission of this frame to a queue
+	 *        The frame keeps the latest value per queue, and reset() waits on them instead of on fences
+	 * @param queue The queue the submission will be made on
+	 * @return The timeline point of the submission
+	 */
+	TimelinePoint request_timeline_point(QueueType const &queue);
+
+	/**
+	 * @brief Sets the queue timelines used to track the submissions of the frame, or nullptr to track them with fences only
+	 */
+	void set_queue_timelines(QueueTimelines *new_queue_timelines);
+
 	/**
 	 * @brief Sets a new buffer allocation strategy
 	 * @param new_strategy The new buffer allocation strategy
@@ -138,33 +169,40 @@ class RenderFrame
 
   private:
 	vkb::BufferAllocationCpp   allocate_buffer_impl(vk::BufferUsageFlags usage, vk::DeviceSize size, size_t thread_index);
+	vkb::BufferAllocationCpp   allocate_descriptor_heap_impl(vk::DeviceSize size, size_t thread_index);
 	vkb::core::CommandPoolCpp &get_command_pool_impl(vkb::core::HPPQueue const &queue, vkb::CommandBufferResetMode reset_mode, size_t thread_index);
 
 	/**
-	 * @brief Retrieve the frame's command pool(s)
-	 * @param queue The queue command buffers will be submitted on
-	 * @param reset_mode Indicate how the command buffers will be reset after execution,
-	 *        may trigger a pool re-creation to set necessary flags
-	 * @return The frame's command pool(s)
+	 * @brief Requests a descriptor set, cached sets are looked up with the hashes the tables keep of their infos
 	 */
-	std::vector<vkb::core::CommandPoolCpp> &get_command_pools(const vkb::core::HPPQueue &queue, vkb::CommandBufferResetMode reset_mode);
+	vk::DescriptorSet request_descriptor_set_impl(vkb::core::HPPDescriptorSetLayout const      &descriptor_set_layout,
+	                                              BindingTable<vk::DescriptorBufferInfo> const &buffer_infos,
+	                                              BindingTable<vk::DescriptorImageInfo> const  &image_infos,
+	                                              bool                                          update_after_bind,
+	                                              size_t                                        thread_index = 0);
 
-	vk::DescriptorSet request_descriptor_set_impl(vkb::core::HPPDescriptorSetLayout const    &descriptor_set_layout,
-	                                              BindingMap<vk::DescriptorBufferInfo> const &buffer_infos,
-	                                              BindingMap<vk::DescriptorImageInfo> const  &image_infos,
-	                                              bool                                        update_after_bind,
-	                                              size_t                                      thread_index = 0);
+	struct DescriptorHeap
+	{
+		std::unique_ptr<vkb::core::BufferCpp>              buffer;
+		std::vector<std::unique_ptr<vkb::core::BufferCpp>> retired_buffers;        // Replaced heaps, which commands of the frame may still use
+		vk::DeviceSize                                     offset = 0;
+	};
 
   private:
 	vkb::core::DeviceCpp                                                                             &device;
 	std::map<vk::BufferUsageFlags, std::vector<std::pair<vkb::BufferPoolCpp, vkb::BufferBlockCpp *>>> buffer_pools;
-	std::map<uint32_t, std::vector<vkb::core::CommandPoolCpp>>                                        command_pools;           // Commands pools per queue family index
+	std::vector<std::vector<std::unique_ptr<vkb::core::CommandPoolCpp>>>                              command_pools;           // Command pools per thread and queue family index, created on first use
+	std::vector<std::vector<std::unique_ptr<vkb::core::CommandPoolCpp>>>                              retired_command_pools;   // Command pools per thread replaced this frame, released once the frame is reset
 	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorPool>>                        descriptor_pools;        // Descriptor pools per thread
 	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorSet>>                         descriptor_sets;         // Descriptor sets per thread
+	std::vector<std::vector<uint32_t>>                                                                bindings_to_update;      // Scratch list of bindings to update per thread
+	std::vector<DescriptorHeap>                                                                       descriptor_heaps;        // Descriptor heaps per thread, created on first use
 	vkb::HPPFencePool                                                                                 fence_pool;
 	vkb::HPPSemaphorePool                                                                             semaphore_pool;
 	std::unique_ptr<vkb::rendering::RenderTargetCpp>                                                  swapchain_render_target;
 	size_t                                                                                            thread_count;
+	QueueTimelines                                                                                   *queue_timelines = nullptr;
+	std::vector<TimelinePoint>                                                                        timeline_points;        // Latest submission per queue
 	BufferAllocationStrategy                                                                          buffer_allocation_strategy     = BufferAllocationStrategy::MultipleAllocationsPerBuffer;
 	DescriptorManagementStrategy                                                                      descriptor_management_strategy = DescriptorManagementStrategy::StoreInCache;
 };
@@ -176,7 +214,7 @@ template <vkb::BindingType bindingType>
 inline RenderFrame<bindingType>::RenderFrame(vkb::core::Device<bindingType>                              &device_,
                                              std::unique_ptr<vkb::rendering::RenderTarget<bindingType>> &&render_target,
                                              size_t                                                       thread_count) :
-    device(reinterpret_cast<vkb::core::DeviceCpp &>(device_)), fence_pool{device}, semaphore_pool{device}, thread_count{thread_count}, descriptor_pools(thread_count), descriptor_sets(thread_count)
+    device(reinterpret_cast<vkb::core::DeviceCpp &>(device_)), fence_pool{device}, semaphore_pool{device}, thread_count{thread_count}, command_pools(thread_count), retired_command_pools(thread_count), descriptor_pools(thread_count), descriptor_sets(thread_count), bindings_to_update(thread_count), descriptor_heaps(thread_count)
 {
 	static constexpr uint32_t BUFFER_POOL_BLOCK_SIZE = 256;        // Block size of a buffer pool in kilobytes
 
@@ -187,6 +225,19 @@ inline RenderFrame<bindingType>::RenderFrame(vkb::core::Device<bindingType>
 	    {vk::BufferUsageFlagBits::eVertexBuffer, 1},
 	    {vk::BufferUsageFlagBits::eIndexBuffer, 1}};
 
+	// Descriptor buffers reference buffers by their device address
+	vk::BufferUsageFlags device_address_usage;
+	if (device.is_descriptor_buffer_enabled())
+	{
+		device_address_usage = vk::BufferUsageFlagBits::eShaderDeviceAddress;
+	}
+
+	// Each thread only accesses its own pools, which are looked up by index, so threads can request them without locking
+	for (auto &command_pools_per_thread : command_pools)
+	{
+		command_pools_per_thread.resize(device.get_gpu().get_queue_family_properties().size());
+	}
+
 	update_render_target(std::move(render_target));
 	for (auto &usage_it : supported_usage_map)
 	{
@@ -199,7 +250,7 @@ inline RenderFrame<bindingType>::RenderFrame(vkb::core::Device<bindingType>
 		for (size_t i = 0; i < thread_count; ++i)
 		{
 			buffer_pools_it->second.push_back(
-			    std::make_pair(vkb::BufferPoolCpp{device, BUFFER_POOL_BLOCK_SIZE * 1024 * usage_it.second, usage_it.first}, nullptr));
+			    std::make_pair(vkb::BufferPoolCpp{device, BUFFER_POOL_BLOCK_SIZE * 1024 * usage_it.second, usage_it.first | device_address_usage}, nullptr));
 		}
 	}
 }
@@ -249,57 +300,81 @@ inline vkb::BufferAllocationCpp RenderFrame<bindingType>::allocate_buffer_impl(v
 }
 
 template <vkb::BindingType bindingType>
-inline void RenderFrame<bindingType>::clear_descriptors()
+inline BufferAllocation<bindingType> RenderFrame<bindingType>::allocate_descriptor_heap(DeviceSizeType size, size_t thread_index)
 {
-	for (auto &desc_sets_per_thread : descriptor_sets)
+	assert(thread_index < thread_count && "Thread index is out of bounds");
+
+	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
-		desc_sets_per_thread.clear();
+		return allocate_descriptor_heap_impl(size, thread_index);
 	}
-
-	for (auto &desc_pools_per_thread : descriptor_pools)
+	else
 	{
-		for (auto &desc_pool : desc_pools_per_thread)
-		{
-			desc_pool.second.reset();
-		}
+		vkb::BufferAllocationCpp buffer_allocation = allocate_descriptor_heap_impl(static_cast<vk::DeviceSize>(size), thread_index);
+		return *reinterpret_cast<vkb::BufferAllocationC *>(&buffer_allocation);
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline std::vector<vkb::core::CommandPoolCpp> &RenderFrame<bindingType>::get_command_pools(const vkb::core::HPPQueue  &queue,
-                                                                                           vkb::CommandBufferResetMode reset_mode)
+inline vkb::BufferAllocationCpp RenderFrame<bindingType>::allocate_descriptor_heap_impl(vk::DeviceSize size, size_t thread_index)
 {
-	auto command_pool_it = command_pools.find(queue.get_family_index());
+	static constexpr vk::DeviceSize DESCRIPTOR_HEAP_SIZE = 256 * 1024;        // Initial size of a descriptor heap in bytes
+
+	assert(device.is_descriptor_buffer_enabled() && "Descriptor heaps require descriptor buffers");
 
-	if (command_pool_it != command_pools.end())
+	auto const &properties = device.get_descriptor_buffer_properties();
+	auto       &heap       = descriptor_heaps[thread_index];
+
+	vk::DeviceSize alignment = properties.descriptorBufferOffsetAlignment;
+	vk::DeviceSize offset    = (heap.offset + alignment - 1) & ~(alignment - 1);
+
+	if (!heap.buffer || heap.buffer->get_size() < offset + size)
 	{
-		assert(!command_pool_it->second.empty());
-		if (command_pool_it->second[0].get_reset_mode() != reset_mode)
+		// Descriptors are addressed relative to the start of the heap, which limits its size
+		vk::DeviceSize max_heap_size = std::min(properties.maxResourceDescriptorBufferRange, properties.maxSamplerDescriptorBufferRange);
+		vk::DeviceSize heap_size     = std::min(std::max(heap.buffer ? 2 * heap.buffer->get_size() : DESCRIPTOR_HEAP_SIZE, 2 * size), max_heap_size);
+		if (heap_size < size)
 		{
-			device.get_handle().waitIdle();
-
-			// Delete pools
-			command_pools.erase(command_pool_it);
+			throw std::runtime_error("Descriptor heap allocation exceeds the range of a descriptor buffer");
 		}
-		else
+
+		if (heap.buffer)
 		{
-			return command_pool_it->second;
+			heap.retired_buffers.push_back(std::move(heap.buffer));
 		}
+
+		vkb::core::BufferBuilderCpp builder(heap_size);
+		builder
+		    .with_usage(vk::BufferUsageFlagBits::eResourceDescriptorBufferEXT | vk::BufferUsageFlagBits::eSamplerDescriptorBufferEXT |
+		                vk::BufferUsageFlagBits::eShaderDeviceAddress)
+		    .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
+		    .with_alignment(alignment)
+		    .with_debug_name("Descriptor heap");
+		heap.buffer = std::make_unique<vkb::core::BufferCpp>(device, builder);
+
+		offset = 0;
 	}
 
-	bool inserted                       = false;
-	std::tie(command_pool_it, inserted) = command_pools.emplace(queue.get_family_index(), std::vector<vkb::core::CommandPoolCpp>{});
-	if (!inserted)
+	heap.offset = offset + size;
+
+	return vkb::BufferAllocationCpp{*heap.buffer, size, offset};
+}
+
+template <vkb::BindingType bindingType>
+inline void RenderFrame<bindingType>::clear_descriptors()
+{
+	for (auto &desc_sets_per_thread : descriptor_sets)
 	{
-		throw std::runtime_error("Failed to insert command pool");
+		desc_sets_per_thread.clear();
 	}
 
-	for (size_t i = 0; i < thread_count; i++)
+	for (auto &desc_pools_per_thread : descriptor_pools)
 	{
-		command_pool_it->second.emplace_back(device, queue.get_family_index(), reinterpret_cast<vkb::rendering::RenderFrameCpp *>(this), i, reset_mode);
+		for (auto &desc_pool : desc_pools_per_thread)
+		{
+			desc_pool.second.reset();
+		}
 	}
-
-	return command_pool_it->second;
 }
 
 template <vkb::BindingType bindingType>
@@ -322,14 +397,23 @@ inline vkb::core::CommandPoolCpp &
     RenderFrame<bindingType>::get_command_pool_impl(vkb::core::HPPQueue const &queue, vkb::CommandBufferResetMode reset_mode, size_t thread_index)
 {
 	assert(thread_index < thread_count && "Thread index is out of bounds");
+	assert(queue.get_family_index() < command_pools[thread_index].size());
 
-	auto &command_pools = get_command_pools(queue, reset_mode);
+	auto &command_pool = command_pools[thread_index][queue.get_family_index()];
 
-	auto command_pool_it = std::ranges::find_if(
-	    command_pools, [&thread_index](vkb::core::CommandPoolCpp &cmd_pool) { return cmd_pool.get_thread_index() == thread_index; });
-	assert(command_pool_it != command_pools.end());
+	if (!command_pool || command_pool->get_reset_mode() != reset_mode)
+	{
+		if (command_pool)
+		{
+			// The command buffers of the pool may still be recorded or in flight, keep it until the frame is reset
+			retired_command_pools[thread_index].push_back(std::move(command_pool));
+		}
 
-	return *command_pool_it;
+		command_pool = std::make_unique<vkb::core::CommandPoolCpp>(
+		    device, queue.get_family_index(), reinterpret_cast<vkb::rendering::RenderFrameCpp *>(this), thread_index, reset_mode);
+	}
+
+	return *command_pool;
 }
 
 template <vkb::BindingType bindingType>
@@ -423,6 +507,12 @@ inline typename RenderFrame<bindingType>::SemaphorePoolType const &RenderFrame<b
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline std::vector<TimelinePoint> const &RenderFrame<bindingType>::get_timeline_points() const
+{
+	return timeline_points;
+}
+
 template <vkb::BindingType bindingType>
 inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingType>::request_descriptor_set(DescriptorSetLayoutType const              &descriptor_set_layout,
                                                                                                              BindingMap<DescriptorBufferInfoType> const &buffer_infos,
@@ -433,6 +523,35 @@ inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingT
 	assert(thread_index < thread_count && "Thread index is out of bounds");
 	assert(thread_index < descriptor_pools.size());
 
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return request_descriptor_set(descriptor_set_layout,
+		                              BindingTable<vk::DescriptorBufferInfo>::from_binding_map(buffer_infos),
+		                              BindingTable<vk::DescriptorImageInfo>::from_binding_map(image_infos),
+		                              update_after_bind,
+		                              thread_index);
+	}
+	else
+	{
+		return static_cast<VkDescriptorSet>(request_descriptor_set_impl(
+		    reinterpret_cast<vkb::core::HPPDescriptorSetLayout const &>(descriptor_set_layout),
+		    BindingTable<vk::DescriptorBufferInfo>::from_binding_map(reinterpret_cast<BindingMap<vk::DescriptorBufferInfo> const &>(buffer_infos)),
+		    BindingTable<vk::DescriptorImageInfo>::from_binding_map(reinterpret_cast<BindingMap<vk::DescriptorImageInfo> const &>(image_infos)),
+		    update_after_bind,
+		    thread_index));
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingType>::request_descriptor_set(DescriptorSetLayoutType const                &descriptor_set_layout,
+                                                                                                             BindingTable<DescriptorBufferInfoType> const &buffer_infos,
+                                                                                                             BindingTable<DescriptorImageInfoType> const  &image_infos,
+                                                                                                             bool                                          update_after_bind,
+                                                                                                             size_t                                        thread_index)
+{
+	assert(thread_index < thread_count && "Thread index is out of bounds");
+	assert(thread_index < descriptor_pools.size());
+
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
 		return request_descriptor_set_impl(descriptor_set_layout, buffer_infos, image_infos, update_after_bind, thread_index);
@@ -440,34 +559,36 @@ inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingT
 	else
 	{
 		return static_cast<VkDescriptorSet>(request_descriptor_set_impl(reinterpret_cast<vkb::core::HPPDescriptorSetLayout const &>(descriptor_set_layout),
-		                                                                reinterpret_cast<BindingMap<vk::DescriptorBufferInfo> const &>(buffer_infos),
-		                                                                reinterpret_cast<BindingMap<vk::DescriptorImageInfo> const &>(image_infos),
+		                                                                reinterpret_cast<BindingTable<vk::DescriptorBufferInfo> const &>(buffer_infos),
+		                                                                reinterpret_cast<BindingTable<vk::DescriptorImageInfo> const &>(image_infos),
 		                                                                update_after_bind,
 		                                                                thread_index));
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(vkb::core::HPPDescriptorSetLayout const    &descriptor_set_layout,
-                                                                               BindingMap<vk::DescriptorBufferInfo> const &buffer_infos,
-                                                                               BindingMap<vk::DescriptorImageInfo> const  &image_infos,
-                                                                               bool                                        update_after_bind,
-                                                                               size_t                                      thread_index)
+inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(vkb::core::HPPDescriptorSetLayout const      &descriptor_set_layout,
+                                                                               BindingTable<vk::DescriptorBufferInfo> const &buffer_infos,
+                                                                               BindingTable<vk::DescriptorImageInfo> const  &image_infos,
+                                                                               bool                                          update_after_bind,
+                                                                               size_t                                        thread_index)
 {
 	auto &descriptor_pool = vkb::common::request_resource(device, nullptr, descriptor_pools[thread_index], descriptor_set_layout);
 	if (descriptor_management_strategy == DescriptorManagementStrategy::StoreInCache)
 	{
 		// The bindings we want to update before binding, if empty we update all bindings
-		std::set<uint32_t> bindings_to_update;
+		auto &thread_bindings_to_update = bindings_to_update[thread_index];
+		thread_bindings_to_update.clear();
 		// If update after bind is enabled, we store the binding index of each binding that need to be updated before being bound
 		if (update_after_bind)
 		{
-			auto aggregate_binding_to_update = [&bindings_to_update, &descriptor_set_layout](const auto &infos_map) {
-				for (const auto &[binding_index, ignored] : infos_map)
+			auto aggregate_binding_to_update = [&thread_bindings_to_update, &descriptor_set_layout](const auto &infos) {
+				for (const auto &entry : infos.get_entries())
 				{
-					if (!(descriptor_set_layout.get_layout_binding_flag(binding_index) & vk::DescriptorBindingFlagBits::eUpdateAfterBind))
+					if (!(descriptor_set_layout.get_layout_binding_flag(entry.binding) & vk::DescriptorBindingFlagBits::eUpdateAfterBind) &&
+					    std::ranges::find(thread_bindings_to_update, entry.binding) == thread_bindings_to_update.end())
 					{
-						bindings_to_update.insert(binding_index);
+						thread_bindings_to_update.push_back(entry.binding);
 					}
 				}
 			};
@@ -475,17 +596,28 @@ inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(v
 			aggregate_binding_to_update(image_infos);
 		}
 
+		// The tables keep the hashes of their infos, so a cached set is found without rehashing them
+		size_t hash = 0;
+		hash_combine(hash, descriptor_set_layout.get_handle());
+		hash_combine(hash, buffer_infos.get_hash());
+		hash_combine(hash, image_infos.get_hash());
+
 		// Request a descriptor set from the render frame, and write the buffer infos and image infos of all the specified bindings
 		assert(thread_index < descriptor_sets.size());
-		auto &descriptor_set =
-		    vkb::common::request_resource(device, nullptr, descriptor_sets[thread_index], descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
-		descriptor_set.update({bindings_to_update.begin(), bindings_to_update.end()});
-		return descriptor_set.get_handle();
+		auto &thread_descriptor_sets = descriptor_sets[thread_index];
+		auto  descriptor_set_it      = thread_descriptor_sets.find(hash);
+		if (descriptor_set_it == thread_descriptor_sets.end())
+		{
+			vkb::core::HPPDescriptorSet descriptor_set{device, descriptor_set_layout, descriptor_pool, buffer_infos.to_binding_map(), image_infos.to_binding_map()};
+			descriptor_set_it = thread_descriptor_sets.emplace(hash, std::move(descriptor_set)).first;
+		}
+		descriptor_set_it->second.update(thread_bindings_to_update);
+		return descriptor_set_it->second.get_handle();
 	}
 	else
 	{
 		// Request a descriptor pool, allocate a descriptor set, write buffer and image data to it
-		vkb::core::HPPDescriptorSet descriptor_set{device, descriptor_set_layout, descriptor_pool, buffer_infos, image_infos};
+		vkb::core::HPPDescriptorSet descriptor_set{device, descriptor_set_layout, descriptor_pool, buffer_infos.to_binding_map(), image_infos.to_binding_map()};
 		descriptor_set.apply_writes();
 		return descriptor_set.get_handle();
 	}
@@ -494,18 +626,33 @@ inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(v
 template <vkb::BindingType bindingType>
 inline void RenderFrame<bindingType>::reset()
 {
+	if (!timeline_points.empty())
+	{
+		assert(queue_timelines);
+		queue_timelines->wait(timeline_points);
+		timeline_points.clear();
+	}
+
 	VK_CHECK(fence_pool.wait());
 
 	fence_pool.reset();
 
-	for (auto &command_pools_per_queue : command_pools)
+	for (auto &command_pools_per_thread : command_pools)
 	{
-		for (auto &command_pool : command_pools_per_queue.second)
+		for (auto &command_pool : command_pools_per_thread)
 		{
-			command_pool.reset_pool();
+			if (command_pool)
+			{
+				command_pool->reset_pool();
+			}
 		}
 	}
 
+	for (auto &retired_command_pools_per_thread : retired_command_pools)
+	{
+		retired_command_pools_per_thread.clear();
+	}
+
 	for (auto &buffer_pools_per_usage : buffer_pools)
 	{
 		for (auto &buffer_pool : buffer_pools_per_usage.second)
@@ -515,6 +662,12 @@ inline void RenderFrame<bindingType>::reset()
 		}
 	}
 
+	for (auto &descriptor_heap : descriptor_heaps)
+	{
+		descriptor_heap.retired_buffers.clear();
+		descriptor_heap.offset = 0;
+	}
+
 	semaphore_pool.reset();
 
 	if (descriptor_management_strategy == DescriptorManagementStrategy::CreateDirectly)
@@ -523,6 +676,28 @@ inline void RenderFrame<bindingType>::reset()
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline TimelinePoint RenderFrame<bindingType>::request_timeline_point(QueueType const &queue)
+{
+	assert(queue_timelines && "Queue timelines are not set on the frame");
+
+	TimelinePoint point = queue_timelines->request_point(queue.get_family_index(), queue.get_index());
+
+	auto point_it = std::ranges::find_if(timeline_points, [&point](TimelinePoint const &p) {
+		return p.queue_family_index == point.queue_family_index && p.queue_index == point.queue_index;
+	});
+	if (point_it != timeline_points.end())
+	{
+		point_it->value = point.value;
+	}
+	else
+	{
+		timeline_points.push_back(point);
+	}
+
+	return point;
+}
+
 template <vkb::BindingType bindingType>
 inline void RenderFrame<bindingType>::set_buffer_allocation_strategy(BufferAllocationStrategy new_strategy)
 {
@@ -535,6 +710,13 @@ inline void RenderFrame<bindingType>::set_descriptor_management_strategy(Descrip
 	descriptor_management_strategy = new_strategy;
 }
 
+template <vkb::BindingType bindingType>
+inline void RenderFrame<bindingType>::set_queue_timelines(QueueTimelines *new_queue_timelines)
+{
+	assert(timeline_points.empty() && "The frame has submissions tracked by the previous queue timelines");
+	queue_timelines = new_queue_timelines;
+}
+
 template <vkb::BindingType bindingType>
 inline void RenderFrame<bindingType>::update_descriptor_sets(size_t thread_index)
 {
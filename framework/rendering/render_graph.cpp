@@ -0,0 +1,505 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rendering/render_graph.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "common/helpers.h"
+
+namespace vkb
+{
+namespace rendering
+{
+namespace
+{
+constexpr vk::AccessFlags2 WRITE_ACCESS_MASK =
+    vk::AccessFlagBits2::eShaderWrite | vk::AccessFlagBits2::eShaderStorageWrite | vk::AccessFlagBits2::eColorAttachmentWrite |
+    vk::AccessFlagBits2::eDepthStencilAttachmentWrite | vk::AccessFlagBits2::eTransferWrite | vk::AccessFlagBits2::eHostWrite |
+    vk::AccessFlagBits2::eMemoryWrite | vk::AccessFlagBits2::eAccelerationStructureWriteKHR;
+
+bool includes(vk::PipelineStageFlags2 stages, vk::AccessFlags2 access, vk::PipelineStageFlags2 other_stages, vk::AccessFlags2 other_access)
+{
+	return (other_stages & ~stages) == vk::PipelineStageFlags2{} && (other_access & ~access) == vk::AccessFlags2{};
+}
+
+// The stages and accesses of vkCmdPipelineBarrier are the first 32 bits of the synchronization2 ones
+vk::PipelineStageFlags to_legacy_stages(vk::PipelineStageFlags2 stages)
+{
+	return static_cast<vk::PipelineStageFlags>(static_cast<VkPipelineStageFlags>(static_cast<VkPipelineStageFlags2>(stages)));
+}
+
+vk::AccessFlags to_legacy_access(vk::AccessFlags2 access)
+{
+	return static_cast<vk::AccessFlags>(static_cast<VkAccessFlags>(static_cast<VkAccessFlags2>(access)));
+}
+}        // namespace
+
+RenderGraph::Pass::Pass(std::string const &name, RenderGraphQueue queue) :
+    name{name}, queue{queue}
+{
+}
+
+RenderGraph::Pass &RenderGraph::Pass::read(uint32_t resource, ResourceAccess const &access)
+{
+	uses.push_back({.resource = resource, .access = access, .write = false});
+	return *this;
+}
+
+RenderGraph::Pass &RenderGraph::Pass::write(uint32_t resource, ResourceAccess const &access)
+{
+	uses.push_back({.resource = resource, .access = access, .write = true});
+	return *this;
+}
+
+RenderGraph::Pass &RenderGraph::Pass::set_side_effects(bool side_effects_)
+{
+	side_effects = side_effects_;
+	return *this;
+}
+
+RenderGraph::Pass &RenderGraph::Pass::set_execute_func(ExecuteFunc &&execute_func_)
+{
+	execute_func = std::move(execute_func_);
+	return *this;
+}
+
+std::string const &RenderGraph::Pass::get_name() const
+{
+	return name;
+}
+
+RenderGraphQueue RenderGraph::Pass::get_queue() const
+{
+	return queue;
+}
+
+bool RenderGraph::BarrierBatch::empty() const
+{
+	return image_barriers.empty() && buffer_barriers.empty();
+}
+
+uint32_t RenderGraph::import_image(std::string const &name, vk::Image image, vk::ImageSubresourceRange const &subresource_range,
+                                   ResourceAccess const &initial_state, vk::SharingMode sharing_mode)
+{
+	resources.push_back({.name              = name,
+	                     .image             = image,
+	                     .subresource_range = subresource_range,
+	                     .initial_state     = initial_state,
+	                     .sharing_mode      = sharing_mode});
+	return to_u32(resources.size() - 1);
+}
+
+uint32_t RenderGraph::import_buffer(std::string const &name, vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize size,
+                                    ResourceAccess const &initial_state, vk::SharingMode sharing_mode)
+{
+	resources.push_back({.name          = name,
+	                     .buffer        = buffer,
+	                     .offset        = offset,
+	                     .size          = size,
+	                     .initial_state = initial_state,
+	                     .sharing_mode  = sharing_mode});
+	return to_u32(resources.size() - 1);
+}
+
+void RenderGraph::set_final_state(uint32_t resource, ResourceAccess const &final_state)
+{
+	resources[resource].final_state = final_state;
+}
+
+RenderGraph::Pass &RenderGraph::add_pass(std::string const &name, RenderGraphQueue queue)
+{
+	passes.push_back(Pass{name, queue});
+	return passes.back();
+}
+
+void RenderGraph::compile(uint32_t graphics_queue_family, uint32_t compute_queue_family)
+{
+	culled = cull_passes();
+	submissions.clear();
+
+	states.assign(resources.size(), {});
+	for (size_t i = 0; i < resources.size(); ++i)
+	{
+		auto const &initial_state = resources[i].initial_state;
+		auto       &state         = states[i];
+		if (initial_state.access_mask & WRITE_ACCESS_MASK)
+		{
+			state.write_stages = initial_state.stage_mask;
+			state.write_access = initial_state.access_mask & WRITE_ACCESS_MASK;
+		}
+		else
+		{
+			state.read_stages = initial_state.stage_mask;
+		}
+		state.layout = initial_state.layout;
+	}
+
+	for (uint32_t i = 0; i < passes.size(); ++i)
+	{
+		if (culled[i])
+		{
+			continue;
+		}
+
+		auto const &pass = passes[i];
+		if (submissions.empty() || submissions.back().queue != pass.queue)
+		{
+			submissions.push_back({.queue = pass.queue});
+		}
+		uint32_t queue_family = pass.queue == RenderGraphQueue::Graphics ? graphics_queue_family : compute_queue_family;
+
+		// The uses of a resource by a pass are merged, so that it gets at most one barrier
+		std::vector<Pass::Use> uses;
+		for (auto const &use : pass.uses)
+		{
+			auto it = std::ranges::find(uses, use.resource, &Pass::Use::resource);
+			if (it == uses.end())
+			{
+				uses.push_back(use);
+				continue;
+			}
+
+			auto const &resource = resources[use.resource];
+			if (resource.image && it->access.layout != use.access.layout)
+			{
+				throw std::runtime_error(fmt::format("Pass \"{}\" uses image \"{}\" in two different layouts", pass.name, resource.name));
+			}
+			it->access.stage_mask |= use.access.stage_mask;
+			it->access.access_mask |= use.access.access_mask;
+			it->write = it->write || use.write;
+		}
+
+		CompiledPass compiled{.pass = i};
+		for (auto const &use : uses)
+		{
+			add_access(use.resource, use.access, use.write, queue_family, compiled.barriers);
+		}
+		submissions.back().passes.push_back(std::move(compiled));
+	}
+
+	// Resources used after the graph are transitioned at the end of the last submission using them
+	for (uint32_t i = 0; i < resources.size(); ++i)
+	{
+		auto const &resource = resources[i];
+		auto const &state    = states[i];
+		if (!resource.final_state || !state.submission)
+		{
+			continue;
+		}
+
+		auto const &final_state   = *resource.final_state;
+		bool        layout_change = resource.image && final_state.layout != state.layout;
+		bool        needs_access  = state.write_access && !includes(state.visible_stages, state.visible_access, final_state.stage_mask, final_state.access_mask);
+		if (layout_change || needs_access)
+		{
+			add_barrier(submissions[*state.submission].final_barriers,
+			            resource,
+			            state.write_stages | state.read_stages,
+			            state.write_access,
+			            final_state.stage_mask,
+			            final_state.access_mask,
+			            state.layout,
+			            resource.image ? final_state.layout : vk::ImageLayout::eUndefined);
+		}
+	}
+}
+
+void RenderGraph::record(uint32_t submission, vk::CommandBuffer command_buffer, bool synchronization2) const
+{
+	for (auto const &compiled : submissions[submission].passes)
+	{
+		record_barriers(command_buffer, compiled.barriers, synchronization2);
+
+		auto const &pass = passes[compiled.pass];
+		if (pass.execute_func)
+		{
+			pass.execute_func(command_buffer);
+		}
+	}
+
+	record_barriers(command_buffer, submissions[submission].final_barriers, synchronization2);
+}
+
+void RenderGraph::record_barriers(vk::CommandBuffer command_buffer, BarrierBatch const &barriers, bool synchronization2)
+{
+	if (barriers.empty())
+	{
+		return;
+	}
+
+	if (synchronization2)
+	{
+		vk::DependencyInfo dependency_info{.bufferMemoryBarrierCount = to_u32(barriers.buffer_barriers.size()),
+		                                   .pBufferMemoryBarriers    = barriers.buffer_barriers.data(),
+		                                   .imageMemoryBarrierCount  = to_u32(barriers.image_barriers.size()),
+		                                   .pImageMemoryBarriers     = barriers.image_barriers.data()};
+		command_buffer.pipelineBarrier2(dependency_info);
+		return;
+	}
+
+	// Without synchronization2 the barriers of a batch share their stage masks
+	vk::PipelineStageFlags src_stages;
+	vk::PipelineStageFlags dst_stages;
+
+	std::vector<vk::BufferMemoryBarrier> buffer_barriers;
+	buffer_barriers.reserve(barriers.buffer_barriers.size());
+	for (auto const &barrier : barriers.buffer_barriers)
+	{
+		src_stages |= to_legacy_stages(barrier.srcStageMask);
+		dst_stages |= to_legacy_stages(barrier.dstStageMask);
+		buffer_barriers.push_back({.srcAccessMask       = to_legacy_access(barrier.srcAccessMask),
+		                           .dstAccessMask       = to_legacy_access(barrier.dstAccessMask),
+		                           .srcQueueFamilyIndex = barrier.srcQueueFamilyIndex,
+		                           .dstQueueFamilyIndex = barrier.dstQueueFamilyIndex,
+		                           .buffer              = barrier.buffer,
+		                           .offset              = barrier.offset,
+		                           .size                = barrier.size});
+	}
+
+	std::vector<vk::ImageMemoryBarrier> image_barriers;
+	image_barriers.reserve(barriers.image_barriers.size());
+	for (auto const &barrier : barriers.image_barriers)
+	{
+		src_stages |= to_legacy_stages(barrier.srcStageMask);
+		dst_stages |= to_legacy_stages(barrier.dstStageMask);
+		image_barriers.push_back({.srcAccessMask       = to_legacy_access(barrier.srcAccessMask),
+		                          .dstAccessMask       = to_legacy_access(barrier.dstAccessMask),
+		                          .oldLayout           = barrier.oldLayout,
+		                          .newLayout           = barrier.newLayout,
+		                          .srcQueueFamilyIndex = barrier.srcQueueFamilyIndex,
+		                          .dstQueueFamilyIndex = barrier.dstQueueFamilyIndex,
+		                          .image               = barrier.image,
+		                          .subresourceRange    = barrier.subresourceRange});
+	}
+
+	// Stage masks cannot be empty without synchronization2
+	if (!src_stages)
+	{
+		src_stages = vk::PipelineStageFlagBits::eTopOfPipe;
+	}
+	if (!dst_stages)
+	{
+		dst_stages = vk::PipelineStageFlagBits::eBottomOfPipe;
+	}
+
+	command_buffer.pipelineBarrier(src_stages, dst_stages, {}, {}, buffer_barriers, image_barriers);
+}
+
+std::vector<RenderGraph::Submission> const &RenderGraph::get_submissions() const
+{
+	return submissions;
+}
+
+bool RenderGraph::is_culled(uint32_t pass) const
+{
+	return culled[pass];
+}
+
+RenderGraph::Pass const &RenderGraph::get_pass(uint32_t pass) const
+{
+	return passes[pass];
+}
+
+void RenderGraph::clear()
+{
+	resources.clear();
+	passes.clear();
+	culled.clear();
+	states.clear();
+	submissions.clear();
+}
+
+std::vector<bool> RenderGraph::cull_passes() const
+{
+	std::vector<bool> culled_passes(passes.size(), true);
+
+	// Walking the passes backwards, a resource is needed when a later pass reads it or it is used after the graph
+	std::vector<bool> needed(resources.size());
+	for (size_t i = 0; i < resources.size(); ++i)
+	{
+		needed[i] = resources[i].final_state.has_value();
+	}
+
+	for (size_t i = passes.size(); i-- > 0;)
+	{
+		auto const &pass = passes[i];
+		bool        keep = pass.side_effects ||
+		            std::ranges::any_of(pass.uses, [&needed](Pass::Use const &use) { return use.write && needed[use.resource]; });
+		if (!keep)
+		{
+			continue;
+		}
+		culled_passes[i] = false;
+
+		// Writes which do not read the resource overwrite it, the passes before only need it if this pass reads it
+		for (auto const &use : pass.uses)
+		{
+			if (use.write && !(use.access.access_mask & ~WRITE_ACCESS_MASK))
+			{
+				needed[use.resource] = false;
+			}
+		}
+		for (auto const &use : pass.uses)
+		{
+			if (!use.write || (use.access.access_mask & ~WRITE_ACCESS_MASK))
+			{
+				needed[use.resource] = true;
+			}
+		}
+	}
+
+	return culled_passes;
+}
+
+void RenderGraph::add_access(uint32_t resource_index, ResourceAccess const &access, bool write, uint32_t queue_family, BarrierBatch &barriers)
+{
+	auto const &resource = resources[resource_index];
+	auto       &state    = states[resource_index];
+
+	uint32_t        current       = to_u32(submissions.size() - 1);
+	vk::ImageLayout layout        = resource.image ? access.layout : vk::ImageLayout::eUndefined;
+	bool            layout_change = resource.image && layout != state.layout;
+
+	if (state.submission && submissions[*state.submission].queue != submissions[current].queue)
+	{
+		// The semaphore wait makes the accesses of the other queue available and visible to the waiting stages
+		auto &waits = submissions[current].waits;
+		auto  it    = std::ranges::find(waits, *state.submission, &SubmissionWait::submission);
+		if (it == waits.end())
+		{
+			waits.push_back({.submission = *state.submission, .stage_mask = access.stage_mask});
+		}
+		else
+		{
+			it->stage_mask |= access.stage_mask;
+		}
+		submissions[*state.submission].signals = true;
+
+		if (resource.sharing_mode == vk::SharingMode::eExclusive && state.queue_family && *state.queue_family != queue_family)
+		{
+			// The release ends the submission which last used the resource, the acquire chains with the semaphore wait
+			add_barrier(submissions[*state.submission].final_barriers,
+			            resource,
+			            state.write_stages | state.read_stages,
+			            state.write_access,
+			            {},
+			            {},
+			            state.layout,
+			            layout,
+			            *state.queue_family,
+			            queue_family);
+			add_barrier(barriers, resource, access.stage_mask, {}, access.stage_mask, access.access_mask, state.layout, layout, *state.queue_family, queue_family);
+		}
+		else if (layout_change)
+		{
+			add_barrier(barriers, resource, access.stage_mask, {}, access.stage_mask, access.access_mask, state.layout, layout);
+		}
+
+		// From now on only the accesses on this queue matter
+		state.write_stages   = access.stage_mask;
+		state.write_access   = write ? access.access_mask & WRITE_ACCESS_MASK : vk::AccessFlags2{};
+		state.read_stages    = {};
+		state.visible_stages = write ? vk::PipelineStageFlags2{} : access.stage_mask;
+		state.visible_access = write ? vk::AccessFlags2{} : access.access_mask;
+	}
+	else if (write || layout_change)
+	{
+		// Writes and layout transitions wait for all the previous accesses. The previous write only needs to be made available
+		// when no barrier did it already, write after read hazards only need an execution dependency.
+		vk::PipelineStageFlags2 src_stages = state.write_stages | state.read_stages;
+		vk::AccessFlags2        src_access = state.visible_access ? vk::AccessFlags2{} : state.write_access;
+		if (src_stages || layout_change)
+		{
+			add_barrier(barriers, resource, src_stages, src_access, access.stage_mask, access.access_mask, state.layout, layout);
+		}
+
+		state.write_stages = access.stage_mask;
+		if (write)
+		{
+			state.write_access   = access.access_mask & WRITE_ACCESS_MASK;
+			state.read_stages    = {};
+			state.visible_stages = {};
+			state.visible_access = {};
+		}
+		else
+		{
+			// A layout transition is a write already visible to the read following it
+			state.write_access   = {};
+			state.read_stages    = access.stage_mask;
+			state.visible_stages = access.stage_mask;
+			state.visible_access = access.access_mask;
+		}
+	}
+	else
+	{
+		// Reads after reads, or after a write already visible to them, need no barrier
+		if (state.write_stages && !includes(state.visible_stages, state.visible_access, access.stage_mask, access.access_mask))
+		{
+			add_barrier(barriers, resource, state.write_stages, state.write_access, access.stage_mask, access.access_mask, state.layout, layout);
+			state.visible_stages |= access.stage_mask;
+			state.visible_access |= access.access_mask;
+		}
+		state.read_stages |= access.stage_mask;
+	}
+
+	state.layout       = layout;
+	state.submission   = current;
+	state.queue_family = queue_family;
+}
+
+void RenderGraph::add_barrier(BarrierBatch &barriers, Resource const &resource, vk::PipelineStageFlags2 src_stages, vk::AccessFlags2 src_access,
+                              vk::PipelineStageFlags2 dst_stages, vk::AccessFlags2 dst_access, vk::ImageLayout old_layout, vk::ImageLayout new_layout,
+                              uint32_t src_queue_family, uint32_t dst_queue_family) const
+{
+	if (src_queue_family == dst_queue_family)
+	{
+		src_queue_family = VK_QUEUE_FAMILY_IGNORED;
+		dst_queue_family = VK_QUEUE_FAMILY_IGNORED;
+	}
+
+	if (resource.image)
+	{
+		barriers.image_barriers.push_back({.srcStageMask        = src_stages,
+		                                   .srcAccessMask       = src_access,
+		                                   .dstStageMask        = dst_stages,
+		                                   .dstAccessMask       = dst_access,
+		                                   .oldLayout           = old_layout,
+		                                   .newLayout           = new_layout,
+		                                   .srcQueueFamilyIndex = src_queue_family,
+		                                   .dstQueueFamilyIndex = dst_queue_family,
+		                                   .image               = resource.image,
+		                                   .subresourceRange    = resource.subresource_range});
+	}
+	else
+	{
+		barriers.buffer_barriers.push_back({.srcStageMask        = src_stages,
+		                                    .srcAccessMask       = src_access,
+		                                    .dstStageMask        = dst_stages,
+		                                    .dstAccessMask       = dst_access,
+		                                    .srcQueueFamilyIndex = src_queue_family,
+		                                    .dstQueueFamilyIndex = dst_queue_family,
+		                                    .buffer              = resource.buffer,
+		                                    .offset              = resource.offset,
+		                                    .size                = resource.size});
+	}
+}
+}        // namespace rendering
+}        // namespace vkb
@@ -0,0 +1,349 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+namespace vkb
+{
+namespace rendering
+{
+enum class RenderGraphQueue
+{
+	Graphics,
+	AsyncCompute
+};
+
+/**
+ * @brief How a pass accesses a resource, or the state of a resource before or after the graph
+ */
+struct ResourceAccess
+{
+	vk::PipelineStageFlags2 stage_mask;
+
+	vk::AccessFlags2 access_mask;
+
+	// Ignored for buffers
+	vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+
+	bool operator==(ResourceAccess const &) const = default;
+};
+
+/**
+ * @brief Common accesses, using the stages and access flags which also exist without synchronization2
+ */
+namespace access
+{
+inline constexpr ResourceAccess color_attachment_write{vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                                                       vk::AccessFlagBits2::eColorAttachmentRead | vk::AccessFlagBits2::eColorAttachmentWrite,
+                                                       vk::ImageLayout::eColorAttachmentOptimal};
+
+inline constexpr ResourceAccess depth_stencil_attachment_write{vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+                                                               vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+                                                               vk::ImageLayout::eDepthStencilAttachmentOptimal};
+
+inline constexpr ResourceAccess fragment_shader_sampled_read{vk::PipelineStageFlagBits2::eFragmentShader,
+                                                             vk::AccessFlagBits2::eShaderRead,
+                                                             vk::ImageLayout::eShaderReadOnlyOptimal};
+
+inline constexpr ResourceAccess compute_shader_sampled_read{vk::PipelineStageFlagBits2::eComputeShader,
+                                                            vk::AccessFlagBits2::eShaderRead,
+                                                            vk::ImageLayout::eShaderReadOnlyOptimal};
+
+inline constexpr ResourceAccess compute_shader_storage_read{vk::PipelineStageFlagBits2::eComputeShader,
+                                                            vk::AccessFlagBits2::eShaderRead,
+                                                            vk::ImageLayout::eGeneral};
+
+inline constexpr ResourceAccess compute_shader_storage_write{vk::PipelineStageFlagBits2::eComputeShader,
+                                                             vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite,
+                                                             vk::ImageLayout::eGeneral};
+
+inline constexpr ResourceAccess vertex_input_read{vk::PipelineStageFlagBits2::eVertexInput,
+                                                  vk::AccessFlagBits2::eVertexAttributeRead | vk::AccessFlagBits2::eIndexRead};
+
+inline constexpr ResourceAccess transfer_read{vk::PipelineStageFlagBits2::eTransfer,
+                                              vk::AccessFlagBits2::eTransferRead,
+                                              vk::ImageLayout::eTransferSrcOptimal};
+
+inline constexpr ResourceAccess transfer_write{vk::PipelineStageFlagBits2::eTransfer,
+                                               vk::AccessFlagBits2::eTransferWrite,
+                                               vk::ImageLayout::eTransferDstOptimal};
+
+inline constexpr ResourceAccess host_read{vk::PipelineStageFlagBits2::eHost,
+                                          vk::AccessFlagBits2::eHostRead};
+
+// Swapchain images are presented after the semaphore signaled by the last submission, no stage waits for them
+inline constexpr ResourceAccess present{vk::PipelineStageFlagBits2::eNone,
+                                        vk::AccessFlagBits2::eNone,
+                                        vk::ImageLayout::ePresentSrcKHR};
+}        // namespace access
+
+/**
+ * @brief Derives the barriers between passes from the resources they declare to read and write
+ *
+ * Images and buffers are imported with the state they are in before the graph, and the resources used after the graph are
+ * given a final state. Passes are then added in the order they should execute, each on the graphics or the async compute
+ * queue, with their accesses and a function recording their commands.
+ *
+ * Compiling the graph culls the passes whose writes are never read, by a later pass or after the graph, unless they have
+ * side effects. It splits the remaining passes into submissions, one per run of consecutive passes on the same queue, and
+ * computes the barriers recorded before each pass, merged into a single vkCmdPipelineBarrier2. Only the dependencies
+ * which are not already satisfied get a barrier: reads of a write already made visible to their stages and reads after
+ * reads in the same layout need none, writes after reads only need an execution dependency. Resources used on both queues
+ * make the later submission wait on the earlier one, with a queue family ownership transfer when the families differ.
+ *
+ * Compiling only runs on the CPU, the submissions and barriers it produces can be compared against expected ones without
+ * a device.
+ */
+class RenderGraph
+{
+  public:
+	using ExecuteFunc = std::function<void(vk::CommandBuffer command_buffer)>;
+
+	class Pass
+	{
+	  public:
+		/**
+		 * @brief Declares that the pass reads a resource
+		 */
+		Pass &read(uint32_t resource, ResourceAccess const &access);
+
+		/**
+		 * @brief Declares that the pass writes a resource, the access may also read it
+		 */
+		Pass &write(uint32_t resource, ResourceAccess const &access);
+
+		/**
+		 * @brief Keeps the pass when its writes are not used, for instance when it signals the host
+		 */
+		Pass &set_side_effects(bool side_effects = true);
+
+		Pass &set_execute_func(ExecuteFunc &&execute_func);
+
+		std::string const &get_name() const;
+
+		RenderGraphQueue get_queue() const;
+
+	  private:
+		friend class RenderGraph;
+
+		struct Use
+		{
+			uint32_t resource = 0;
+
+			ResourceAccess access;
+
+			bool write = false;
+		};
+
+		Pass(std::string const &name, RenderGraphQueue queue);
+
+		std::string name;
+
+		RenderGraphQueue queue;
+
+		std::vector<Use> uses;
+
+		bool side_effects = false;
+
+		ExecuteFunc execute_func;
+	};
+
+	struct BarrierBatch
+	{
+		std::vector<vk::ImageMemoryBarrier2> image_barriers;
+
+		std::vector<vk::BufferMemoryBarrier2> buffer_barriers;
+
+		bool empty() const;
+
+		bool operator==(BarrierBatch const &) const = default;
+	};
+
+	struct CompiledPass
+	{
+		// Index of the pass, in the order passes were added
+		uint32_t pass = 0;
+
+		// Recorded before the pass
+		BarrierBatch barriers;
+
+		bool operator==(CompiledPass const &) const = default;
+	};
+
+	struct SubmissionWait
+	{
+		// Index of the submission signaling the semaphore waited on
+		uint32_t submission = 0;
+
+		vk::PipelineStageFlags2 stage_mask;
+
+		bool operator==(SubmissionWait const &) const = default;
+	};
+
+	struct Submission
+	{
+		RenderGraphQueue queue = RenderGraphQueue::Graphics;
+
+		std::vector<SubmissionWait> waits;
+
+		std::vector<CompiledPass> passes;
+
+		// Recorded after the passes: releases of queue family ownership and transitions to the final states
+		BarrierBatch final_barriers;
+
+		// Whether a later submission waits on this one
+		bool signals = false;
+
+		bool operator==(Submission const &) const = default;
+	};
+
+	/**
+	 * @brief Adds an image used by the graph
+	 * @param name Name of the image, for error messages
+	 * @param image The image
+	 * @param subresource_range Subresources accessed by the passes
+	 * @param initial_state Last access to the image before the graph
+	 * @param sharing_mode Concurrent images need no queue family ownership transfer
+	 * @return Index of the resource
+	 */
+	uint32_t import_image(std::string const &name, vk::Image image, vk::ImageSubresourceRange const &subresource_range,
+	                      ResourceAccess const &initial_state = {}, vk::SharingMode sharing_mode = vk::SharingMode::eExclusive);
+
+	/**
+	 * @brief Adds a buffer used by the graph
+	 * @return Index of the resource
+	 */
+	uint32_t import_buffer(std::string const &name, vk::Buffer buffer, vk::DeviceSize offset = 0, vk::DeviceSize size = VK_WHOLE_SIZE,
+	                       ResourceAccess const &initial_state = {}, vk::SharingMode sharing_mode = vk::SharingMode::eExclusive);
+
+	/**
+	 * @brief Marks a resource as used after the graph, its writes are not culled and it is transitioned to the given state
+	 */
+	void set_final_state(uint32_t resource, ResourceAccess const &final_state);
+
+	/**
+	 * @brief Adds a pass executed after the passes already added, the reference stays valid until the graph is cleared
+	 */
+	Pass &add_pass(std::string const &name, RenderGraphQueue queue = RenderGraphQueue::Graphics);
+
+	/**
+	 * @brief Culls the unused passes, and computes the submissions and their barriers
+	 * @param graphics_queue_family Family of the graphics queue
+	 * @param compute_queue_family Family of the async compute queue, which may be the graphics family
+	 */
+	void compile(uint32_t graphics_queue_family, uint32_t compute_queue_family);
+
+	/**
+	 * @brief Records the barriers and the passes of a compiled submission
+	 * @param synchronization2 Whether vkCmdPipelineBarrier2 can be used, otherwise barriers are recorded with vkCmdPipelineBarrier
+	 */
+	void record(uint32_t submission, vk::CommandBuffer command_buffer, bool synchronization2) const;
+
+	/**
+	 * @brief Records a batch of barriers as a single pipeline barrier
+	 */
+	static void record_barriers(vk::CommandBuffer command_buffer, BarrierBatch const &barriers, bool synchronization2);
+
+	std::vector<Submission> const &get_submissions() const;
+
+	bool is_culled(uint32_t pass) const;
+
+	Pass const &get_pass(uint32_t pass) const;
+
+	/**
+	 * @brief Removes the resources and passes, to build the graph of another frame
+	 */
+	void clear();
+
+  private:
+	struct Resource
+	{
+		std::string name;
+
+		vk::Image image;
+
+		vk::ImageSubresourceRange subresource_range;
+
+		vk::Buffer buffer;
+
+		vk::DeviceSize offset = 0;
+
+		vk::DeviceSize size = VK_WHOLE_SIZE;
+
+		ResourceAccess initial_state;
+
+		std::optional<ResourceAccess> final_state;
+
+		vk::SharingMode sharing_mode = vk::SharingMode::eExclusive;
+	};
+
+	/**
+	 * @brief Synchronization state of a resource while compiling
+	 */
+	struct ResourceState
+	{
+		// Last write, or layout transition, and the reads which followed it on the current queue
+		vk::PipelineStageFlags2 write_stages;
+
+		vk::AccessFlags2 write_access;
+
+		vk::PipelineStageFlags2 read_stages;
+
+		// Stages and accesses the last write is visible to
+		vk::PipelineStageFlags2 visible_stages;
+
+		vk::AccessFlags2 visible_access;
+
+		vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+
+		// Last submission accessing the resource, and the queue family owning it
+		std::optional<uint32_t> submission;
+
+		std::optional<uint32_t> queue_family;
+	};
+
+	std::vector<bool> cull_passes() const;
+
+	/**
+	 * @brief Computes the barrier of an access, adding it to the barriers of the pass and the waits of the submission
+	 */
+	void add_access(uint32_t resource, ResourceAccess const &access, bool write, uint32_t queue_family, BarrierBatch &barriers);
+
+	void add_barrier(BarrierBatch &barriers, Resource const &resource, vk::PipelineStageFlags2 src_stages, vk::AccessFlags2 src_access,
+	                 vk::PipelineStageFlags2 dst_stages, vk::AccessFlags2 dst_access, vk::ImageLayout old_layout, vk::ImageLayout new_layout,
+	                 uint32_t src_queue_family = VK_QUEUE_FAMILY_IGNORED, uint32_t dst_queue_family = VK_QUEUE_FAMILY_IGNORED) const;
+
+	std::vector<Resource> resources;
+
+	std::deque<Pass> passes;
+
+	std::vector<bool> culled;
+
+	std::vector<ResourceState> states;
+
+	std::vector<Submission> submissions;
+};
+}        // namespace rendering
+}        // namespace vkb
@@ -21,6 +21,7 @@
 #include "common/hpp_vk_common.h"
 #include "common/vk_common.h"
 #include "core/command_buffer.h"
+#include "rendering/attachment_allocator.h"
 #include "rendering/render_target.h"
 #include "rendering/subpass.h"
 #include <vulkan/vulkan.hpp>
@@ -64,6 +65,15 @@ class RenderPipeline
 	 */
 	void add_subpass(std::unique_ptr<vkb::rendering::Subpass<bindingType>> &&subpass);
 
+	/**
+	 * @brief Adds a pass drawing this pipeline to the lifetimes of the attachments its subpasses read, write or resolve to
+	 * @param lifetimes Lifetimes of the attachments of the render target, in the order of its attachments
+	 * @param depth_attachment Index of the first attachment of the render target with a depth format, which the render pass
+	 *        uses as depth attachment unless the subpass disables it, or VK_ATTACHMENT_UNUSED
+	 * @param pass Index of the pass drawing this pipeline
+	 */
+	void add_attachment_lifetimes(std::vector<vkb::rendering::AttachmentLifetime> &lifetimes, uint32_t depth_attachment, uint32_t pass) const;
+
 	/**
 	 * @brief Record draw commands for each Subpass
 	 */
@@ -147,6 +157,44 @@ void RenderPipeline<bindingType>::add_subpass(std::unique_ptr<vkb::rendering::Su
 	}
 }
 
+template <vkb::BindingType bindingType>
+void RenderPipeline<bindingType>::add_attachment_lifetimes(std::vector<vkb::rendering::AttachmentLifetime> &lifetimes, uint32_t depth_attachment, uint32_t pass) const
+{
+	auto use_attachment = [&lifetimes, pass](uint32_t attachment) {
+		// Also skips VK_ATTACHMENT_UNUSED
+		if (attachment < lifetimes.size())
+		{
+			lifetimes[attachment].add_pass(pass);
+		}
+	};
+
+	for (auto const &subpass : subpasses)
+	{
+		for (uint32_t attachment : subpass->get_input_attachments())
+		{
+			use_attachment(attachment);
+		}
+		for (uint32_t attachment : subpass->get_output_attachments())
+		{
+			use_attachment(attachment);
+		}
+		for (uint32_t attachment : subpass->get_color_resolve_attachments())
+		{
+			use_attachment(attachment);
+		}
+		if (!subpass->get_disable_depth_stencil_attachment() && depth_attachment != VK_ATTACHMENT_UNUSED)
+		{
+			use_attachment(depth_attachment);
+
+			// The depth attachment is only resolved when the subpass uses it
+			if (subpass->get_depth_stencil_resolve_mode() != vk::ResolveModeFlagBits::eNone)
+			{
+				use_attachment(subpass->get_depth_stencil_resolve_attachment());
+			}
+		}
+	}
+}
+
 template <vkb::BindingType bindingType>
 void RenderPipeline<bindingType>::draw(vkb::core::CommandBuffer<bindingType> &command_buffer, vkb::rendering::RenderTarget<bindingType> &render_target, SubpassContentsType contents)
 {
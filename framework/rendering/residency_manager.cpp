@@ -0,0 +1,479 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rendering/residency_manager.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+
+#include "core/buffer.h"
+#include "core/device.h"
+#include "core/hpp_image.h"
+#include "core/hpp_image_view.h"
+#include "scene_graph/components/image.h"
+#include <vulkan/vulkan_format_traits.hpp>
+
+namespace vkb
+{
+namespace rendering
+{
+namespace
+{
+// Levels smaller than this are not worth the copies of an eviction
+constexpr vk::DeviceSize MIN_DROPPED_LEVEL_SIZE = 256 * 1024;
+
+// Bounds the copies recorded into a single frame
+constexpr vk::DeviceSize MAX_DROPPED_SIZE_PER_FRAME = 64 * 1024 * 1024;
+
+// Restored textures must fit under this fraction of the target, so that a restoration does not trigger an eviction right away
+constexpr float RESTORE_HEADROOM = 0.9f;
+
+constexpr vk::ImageUsageFlags TEXTURE_USAGE = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc;
+
+constexpr vk::PipelineStageFlags SHADER_STAGES =
+    vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader;
+
+vk::ImageMemoryBarrier image_barrier(vk::Image       image,
+                                     vk::AccessFlags src_access_mask,
+                                     vk::AccessFlags dst_access_mask,
+                                     vk::ImageLayout old_layout,
+                                     vk::ImageLayout new_layout,
+                                     uint32_t        base_level,
+                                     uint32_t        level_count)
+{
+	return {.srcAccessMask       = src_access_mask,
+	        .dstAccessMask       = dst_access_mask,
+	        .oldLayout           = old_layout,
+	        .newLayout           = new_layout,
+	        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	        .image               = image,
+	        .subresourceRange    = {.aspectMask = vk::ImageAspectFlagBits::eColor, .baseMipLevel = base_level, .levelCount = level_count, .layerCount = 1}};
+}
+
+vk::Extent3D get_level_extent(vkb::sg::Image const &image, uint32_t level)
+{
+	auto const &extent = image.get_mipmaps()[level].extent;
+	return {extent.width, extent.height, extent.depth};
+}
+}        // namespace
+
+ResidencyManager::ResidencyManager(vkb::core::DeviceCpp &device, uint32_t queue_family_index, uint32_t frame_count, float budget_fraction) :
+    device{device}, budget_fraction{budget_fraction}, replaced_images(frame_count, false)
+{
+	command_pool = device.get_handle().createCommandPool(
+	    {.flags = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer, .queueFamilyIndex = queue_family_index});
+
+	command_buffers = device.get_handle().allocateCommandBuffers(
+	    {.commandPool = command_pool, .level = vk::CommandBufferLevel::ePrimary, .commandBufferCount = frame_count});
+
+	const VkPhysicalDeviceMemoryProperties *memory_properties = nullptr;
+	vmaGetMemoryProperties(vkb::allocated::get_memory_allocator(), &memory_properties);
+
+	heap_budgets.resize(memory_properties->memoryHeapCount);
+	for (uint32_t i = 0; i < memory_properties->memoryHeapCount; ++i)
+	{
+		device_local_heaps.push_back(memory_properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT);
+	}
+}
+
+ResidencyManager::~ResidencyManager()
+{
+	// The replaced images and the readbacks may still be in use
+	device.get_handle().waitIdle();
+	retired_images.clear();
+	entries.clear();
+
+	// Destroying the pool frees the command buffers
+	device.get_handle().destroyCommandPool(command_pool);
+}
+
+void ResidencyManager::set_budget_fraction(float budget_fraction_)
+{
+	budget_fraction = budget_fraction_;
+}
+
+void ResidencyManager::add_image(vkb::sg::Image &image)
+{
+	if ((image.get_layers() != 1) || (image.get_extent().depth != 1) || (image.get_mipmaps().size() < 2) ||
+	    std::ranges::any_of(entries, [&image](Entry const &entry) { return entry.image == &image; }))
+	{
+		return;
+	}
+
+	entries.push_back({.image = &image, .last_used_frame = frame_counter});
+}
+
+void ResidencyManager::remove_image(vkb::sg::Image &image)
+{
+	remove_entries([&image](Entry const &entry) { return entry.image == &image; });
+}
+
+void ResidencyManager::set_images(std::span<vkb::sg::Image *const> images)
+{
+	remove_entries([&images](Entry const &entry) { return std::ranges::find(images, entry.image) == images.end(); });
+	for (auto *image : images)
+	{
+		add_image(*image);
+	}
+}
+
+void ResidencyManager::remove_entries(std::function<bool(Entry const &)> const &filter)
+{
+	// The readbacks and uploads of the removed textures must complete before their buffers and images are destroyed
+	if (std::ranges::any_of(entries, [&filter](Entry const &entry) { return (entry.state != State::Resident) && filter(entry); }))
+	{
+		device.get_handle().waitIdle();
+	}
+	std::erase_if(entries, filter);
+}
+
+vk::CommandBuffer ResidencyManager::update(uint32_t frame_index)
+{
+	if (command_buffers.size() <= frame_index)
+	{
+		// The swapchain was recreated with more images
+		auto new_command_buffers = device.get_handle().allocateCommandBuffers(
+		    {.commandPool = command_pool, .level = vk::CommandBufferLevel::ePrimary, .commandBufferCount = frame_index + 1 - to_u32(command_buffers.size())});
+		command_buffers.insert(command_buffers.end(), new_command_buffers.begin(), new_command_buffers.end());
+		replaced_images.resize(frame_index + 1, false);
+	}
+
+	++frame_counter;
+
+	// The frame has completed, and so has everything submitted before it
+	std::erase_if(retired_images, [frame_index](RetiredImage const &retired_image) { return retired_image.frame_index == frame_index; });
+
+	for (auto &entry : entries)
+	{
+		if (entry.image->consume_used())
+		{
+			entry.last_used_frame = frame_counter;
+		}
+
+		if ((entry.state == State::Evicting) && (entry.readback_frame_index == frame_index))
+		{
+			// Readback memory may not be host coherent
+			entry.readback_buffer->invalidate();
+			const uint8_t *data = entry.readback_buffer->get_data();
+			entry.dropped_data.insert(entry.dropped_data.end(), data, data + get_level_size(*entry.image, entry.dropped_levels - 1));
+			entry.readback_buffer.reset();
+			entry.state = State::Resident;
+		}
+	}
+
+	// Restorations whose uploads have completed
+	auto &upload_manager = device.get_upload_manager();
+
+	std::vector<Entry *> restored_entries;
+	for (auto &entry : entries)
+	{
+		if ((entry.state == State::Restoring) && upload_manager.is_complete(entry.restore_token))
+		{
+			restored_entries.push_back(&entry);
+		}
+	}
+
+	// Drop a level of the least recently used textures while over budget, until enough memory is freed
+	std::vector<Entry *> evicted_entries;
+
+	vk::DeviceSize excess = poll_budgets();
+	if (0 < excess)
+	{
+		std::vector<Entry *> candidates;
+		for (auto &entry : entries)
+		{
+			uint32_t remaining_levels = to_u32(entry.image->get_mipmaps().size()) - entry.dropped_levels;
+			if ((entry.state == State::Resident) && (1 < remaining_levels) && (MIN_DROPPED_LEVEL_SIZE <= get_level_size(*entry.image, entry.dropped_levels)))
+			{
+				candidates.push_back(&entry);
+			}
+		}
+		std::ranges::sort(candidates, {}, &Entry::last_used_frame);
+
+		vk::DeviceSize dropped_size = 0;
+		for (auto *entry : candidates)
+		{
+			if ((excess <= dropped_size) || (MAX_DROPPED_SIZE_PER_FRAME <= dropped_size))
+			{
+				break;
+			}
+			dropped_size += get_level_size(*entry->image, entry->dropped_levels);
+			evicted_entries.push_back(entry);
+		}
+	}
+	else if (std::ranges::none_of(entries, [](Entry const &entry) { return entry.state == State::Restoring; }))
+	{
+		// Restore the most recently used of the textures used by the last frames, if it fits under the budget
+		Entry *candidate = nullptr;
+		for (auto &entry : entries)
+		{
+			if ((entry.state == State::Resident) && (0 < entry.dropped_levels) && (frame_counter <= entry.last_used_frame + command_buffers.size()) &&
+			    (!candidate || (candidate->last_used_frame < entry.last_used_frame)))
+			{
+				candidate = &entry;
+			}
+		}
+
+		if (candidate)
+		{
+			bool fits = true;
+			for (size_t i = 0; i < heap_budgets.size(); ++i)
+			{
+				auto target = static_cast<vk::DeviceSize>(static_cast<double>(heap_budgets[i].budget) * budget_fraction * RESTORE_HEADROOM);
+				if (device_local_heaps[i] && (target < heap_budgets[i].usage + candidate->dropped_data.size()))
+				{
+					fits = false;
+				}
+			}
+
+			if (fits)
+			{
+				begin_restore(*candidate);
+			}
+		}
+	}
+
+	if (restored_entries.empty() && evicted_entries.empty())
+	{
+		return nullptr;
+	}
+
+	vk::CommandBuffer command_buffer = command_buffers[frame_index];
+	command_buffer.begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+	for (auto *entry : restored_entries)
+	{
+		record_restore(*entry, command_buffer, frame_index);
+	}
+	for (auto *entry : evicted_entries)
+	{
+		record_eviction(*entry, command_buffer, frame_index);
+	}
+	command_buffer.end();
+
+	return command_buffer;
+}
+
+bool ResidencyManager::has_replaced_images(uint32_t frame_index)
+{
+	assert(frame_index < replaced_images.size());
+	bool replaced                = replaced_images[frame_index];
+	replaced_images[frame_index] = false;
+	return replaced;
+}
+
+std::vector<VmaBudget> const &ResidencyManager::get_heap_budgets() const
+{
+	return heap_budgets;
+}
+
+uint32_t ResidencyManager::get_evicted_image_count() const
+{
+	return to_u32(std::ranges::count_if(entries, [](Entry const &entry) { return 0 < entry.dropped_levels; }));
+}
+
+vk::DeviceSize ResidencyManager::get_evicted_size() const
+{
+	vk::DeviceSize size = 0;
+	for (auto const &entry : entries)
+	{
+		size += entry.dropped_data.size();
+	}
+	return size;
+}
+
+vk::DeviceSize ResidencyManager::get_level_size(vkb::sg::Image const &image, uint32_t level)
+{
+	vk::Format   format       = static_cast<vk::Format>(image.get_format());
+	vk::Extent3D extent       = get_level_extent(image, level);
+	auto         block_extent = vk::blockExtent(format);
+
+	vk::DeviceSize block_count = static_cast<vk::DeviceSize>((extent.width + block_extent[0] - 1) / block_extent[0]) *
+	                             ((extent.height + block_extent[1] - 1) / block_extent[1]) * extent.depth;
+	return block_count * vk::blockSize(format);
+}
+
+vk::DeviceSize ResidencyManager::poll_budgets()
+{
+	vmaGetHeapBudgets(vkb::allocated::get_memory_allocator(), heap_budgets.data());
+
+	vk::DeviceSize excess = 0;
+	for (size_t i = 0; i < heap_budgets.size(); ++i)
+	{
+		auto target = static_cast<vk::DeviceSize>(static_cast<double>(heap_budgets[i].budget) * budget_fraction);
+		if (device_local_heaps[i] && (target < heap_budgets[i].usage))
+		{
+			excess = std::max(excess, heap_budgets[i].usage - target);
+		}
+	}
+	return excess;
+}
+
+void ResidencyManager::record_eviction(Entry &entry, vk::CommandBuffer command_buffer, uint32_t frame_index)
+{
+	auto const &image            = *entry.image;
+	auto const &current_image    = reinterpret_cast<vkb::core::HPPImage const &>(image.get_vk_image());
+	uint32_t    dropped_level    = entry.dropped_levels;
+	uint32_t    remaining_levels = to_u32(image.get_mipmaps().size()) - dropped_level - 1;
+	vk::Format  format           = static_cast<vk::Format>(image.get_format());
+
+	entry.readback_buffer = vkb::core::BufferBuilderCpp(get_level_size(image, dropped_level))
+	                            .with_usage(vk::BufferUsageFlagBits::eTransferDst)
+	                            .with_vma_usage(VMA_MEMORY_USAGE_GPU_TO_CPU)
+	                            .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT)
+	                            .build_unique(device);
+	entry.readback_buffer->set_debug_name("Residency readback of " + image.get_name());
+
+	auto smaller_image = vkb::core::HPPImageBuilder(get_level_extent(image, dropped_level + 1))
+	                         .with_format(format)
+	                         .with_mip_levels(remaining_levels)
+	                         .with_usage(TEXTURE_USAGE)
+	                         .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
+	                         .with_debug_name(image.get_name())
+	                         .build_unique(device);
+
+	// The image is only read by the previous frames, waiting for them is enough before changing its layout
+	std::array<vk::ImageMemoryBarrier, 2> to_transfer{
+	    image_barrier(current_image.get_handle(), {}, vk::AccessFlagBits::eTransferRead, vk::ImageLayout::eShaderReadOnlyOptimal, vk::ImageLayout::eTransferSrcOptimal, 0, remaining_levels + 1),
+	    image_barrier(smaller_image->get_handle(), {}, vk::AccessFlagBits::eTransferWrite, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, 0, remaining_levels)};
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, to_transfer);
+
+	// The dropped level goes to host memory, tightly packed
+	vk::BufferImageCopy readback_region{.imageSubresource = {.aspectMask = vk::ImageAspectFlagBits::eColor, .mipLevel = 0, .layerCount = 1},
+	                                    .imageExtent      = get_level_extent(image, dropped_level)};
+	command_buffer.copyImageToBuffer(current_image.get_handle(), vk::ImageLayout::eTransferSrcOptimal, entry.readback_buffer->get_handle(), readback_region);
+
+	std::vector<vk::ImageCopy> regions;
+	for (uint32_t level = 0; level < remaining_levels; ++level)
+	{
+		regions.push_back({.srcSubresource = {.aspectMask = vk::ImageAspectFlagBits::eColor, .mipLevel = level + 1, .layerCount = 1},
+		                   .dstSubresource = {.aspectMask = vk::ImageAspectFlagBits::eColor, .mipLevel = level, .layerCount = 1},
+		                   .extent         = get_level_extent(image, dropped_level + 1 + level)});
+	}
+	command_buffer.copyImage(current_image.get_handle(), vk::ImageLayout::eTransferSrcOptimal, smaller_image->get_handle(), vk::ImageLayout::eTransferDstOptimal, regions);
+
+	vk::BufferMemoryBarrier to_host{.srcAccessMask       = vk::AccessFlagBits::eTransferWrite,
+	                                .dstAccessMask       = vk::AccessFlagBits::eHostRead,
+	                                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	                                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+	                                .buffer              = entry.readback_buffer->get_handle(),
+	                                .offset              = 0,
+	                                .size                = VK_WHOLE_SIZE};
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, {}, to_host, {});
+
+	vk::ImageMemoryBarrier to_shader =
+	    image_barrier(smaller_image->get_handle(), vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal, 0, remaining_levels);
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, SHADER_STAGES, {}, {}, {}, to_shader);
+
+	entry.state                = State::Evicting;
+	entry.readback_frame_index = frame_index;
+	entry.dropped_levels++;
+
+	replace_image(entry, std::move(smaller_image), frame_index);
+}
+
+void ResidencyManager::begin_restore(Entry &entry)
+{
+	auto const &image       = *entry.image;
+	uint32_t    level_count = to_u32(image.get_mipmaps().size());
+
+	entry.restored_image = vkb::core::HPPImageBuilder(get_level_extent(image, 0))
+	                           .with_format(static_cast<vk::Format>(image.get_format()))
+	                           .with_mip_levels(level_count)
+	                           .with_usage(TEXTURE_USAGE)
+	                           .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
+	                           .with_debug_name(image.get_name())
+	                           .build_unique(device);
+
+	std::vector<vk::BufferImageCopy> regions;
+	vk::DeviceSize                   offset = 0;
+	for (uint32_t level = 0; level < entry.dropped_levels; ++level)
+	{
+		regions.push_back({.bufferOffset     = offset,
+		                   .imageSubresource = {.aspectMask = vk::ImageAspectFlagBits::eColor, .mipLevel = level, .layerCount = 1},
+		                   .imageExtent      = get_level_extent(image, level)});
+		offset += get_level_size(image, level);
+	}
+	assert(offset == entry.dropped_data.size());
+
+	// The remaining levels are copied from the current image once the upload has completed
+	auto &upload_manager = device.get_upload_manager();
+	entry.restore_token  = upload_manager.upload_image(entry.dropped_data.data(),
+	                                                   entry.dropped_data.size(),
+	                                                   entry.restored_image->get_handle(),
+	                                                   regions,
+	                                                   {.aspectMask = vk::ImageAspectFlagBits::eColor, .levelCount = entry.dropped_levels, .layerCount = 1});
+	upload_manager.flush();
+
+	entry.state = State::Restoring;
+}
+
+void ResidencyManager::record_restore(Entry &entry, vk::CommandBuffer command_buffer, uint32_t frame_index)
+{
+	auto const &image            = *entry.image;
+	auto const &current_image    = reinterpret_cast<vkb::core::HPPImage const &>(image.get_vk_image());
+	uint32_t    dropped_levels   = entry.dropped_levels;
+	uint32_t    remaining_levels = to_u32(image.get_mipmaps().size()) - dropped_levels;
+	vk::Image   restored_image   = entry.restored_image->get_handle();
+
+	std::array<vk::ImageMemoryBarrier, 2> to_transfer{
+	    image_barrier(current_image.get_handle(), {}, vk::AccessFlagBits::eTransferRead, vk::ImageLayout::eShaderReadOnlyOptimal, vk::ImageLayout::eTransferSrcOptimal, 0, remaining_levels),
+	    image_barrier(restored_image, {}, vk::AccessFlagBits::eTransferWrite, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, dropped_levels, remaining_levels)};
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, to_transfer);
+
+	std::vector<vk::ImageCopy> regions;
+	for (uint32_t level = 0; level < remaining_levels; ++level)
+	{
+		regions.push_back({.srcSubresource = {.aspectMask = vk::ImageAspectFlagBits::eColor, .mipLevel = level, .layerCount = 1},
+		                   .dstSubresource = {.aspectMask = vk::ImageAspectFlagBits::eColor, .mipLevel = dropped_levels + level, .layerCount = 1},
+		                   .extent         = get_level_extent(image, dropped_levels + level)});
+	}
+	command_buffer.copyImage(current_image.get_handle(), vk::ImageLayout::eTransferSrcOptimal, restored_image, vk::ImageLayout::eTransferDstOptimal, regions);
+
+	vk::ImageMemoryBarrier to_shader =
+	    image_barrier(restored_image, vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal, dropped_levels, remaining_levels);
+	command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, SHADER_STAGES, {}, {}, {}, to_shader);
+
+	entry.state           = State::Resident;
+	entry.dropped_levels  = 0;
+	entry.last_used_frame = frame_counter;
+	entry.dropped_data.clear();
+	entry.dropped_data.shrink_to_fit();
+	entry.restore_token = {};
+
+	replace_image(entry, std::move(entry.restored_image), frame_index);
+}
+
+void ResidencyManager::replace_image(Entry &entry, std::unique_ptr<vkb::core::HPPImage> &&image, uint32_t frame_index)
+{
+	auto image_view = std::make_unique<vkb::core::HPPImageView>(*image, vk::ImageViewType::e2D);
+	image_view->set_debug_name("View on " + entry.image->get_name());
+
+	// The scene graph images hold the C bindings of the same classes
+	auto [old_image, old_image_view] =
+	    entry.image->replace_vk_image(std::unique_ptr<vkb::core::Image>(reinterpret_cast<vkb::core::Image *>(image.release())),
+	                                  std::unique_ptr<vkb::core::ImageView>(reinterpret_cast<vkb::core::ImageView *>(image_view.release())));
+
+	retired_images.push_back({.frame_index = frame_index,
+	                          .image       = std::unique_ptr<vkb::core::HPPImage>(reinterpret_cast<vkb::core::HPPImage *>(old_image.release())),
+	                          .image_view  = std::unique_ptr<vkb::core::HPPImageView>(reinterpret_cast<vkb::core::HPPImageView *>(old_image_view.release()))});
+
+	std::fill(replaced_images.begin(), replaced_images.end(), true);
+}
+}        // namespace rendering
+}        // namespace vkb
@@ -0,0 +1,220 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "common/vk_common.h"
+#include "core/upload_manager.h"
+#include <vulkan/vulkan.hpp>
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class Buffer;
+using BufferCpp = Buffer<vkb::BindingType::Cpp>;
+
+template <vkb::BindingType bindingType>
+class Device;
+using DeviceCpp = Device<vkb::BindingType::Cpp>;
+
+class HPPImage;
+class HPPImageView;
+}        // namespace core
+
+namespace sg
+{
+class Image;
+}        // namespace sg
+
+namespace rendering
+{
+/**
+ * @brief Keeps the device memory used by the application within its budget, by dropping the top mip levels of textures
+ *
+ * The heap budgets of the memory allocator are polled each frame. While a device local heap uses more than a fraction of
+ * its budget, the least recently used textures lose their most detailed mip level: the level is read back into host memory
+ * and the others are copied into a smaller image, which replaces the image of the texture. Once the heaps are back under
+ * budget with some headroom, the textures used again get their levels back, uploaded through the UploadManager.
+ *
+ * Textures are marked as used by the subpasses sampling them, see vkb::sg::Image::mark_used. The copies are recorded into
+ * a command buffer submitted with the frame, and the replaced images are destroyed once that frame has completed. The
+ * descriptor sets cached by a frame may refer to replaced images, so they must be cleared before the frame is recorded
+ * when has_replaced_images returns true.
+ */
+class ResidencyManager
+{
+  public:
+	/**
+	 * @brief Creates the residency manager
+	 * @param device The device holding the textures
+	 * @param queue_family_index Family of the queue the copies are submitted to
+	 * @param frame_count Number of frames in flight
+	 * @param budget_fraction Fraction of the budget of each device local heap the application may use
+	 */
+	ResidencyManager(vkb::core::DeviceCpp &device, uint32_t queue_family_index, uint32_t frame_count, float budget_fraction = 0.9f);
+
+	ResidencyManager(const ResidencyManager &) = delete;
+
+	ResidencyManager(ResidencyManager &&) = delete;
+
+	~ResidencyManager();
+
+	ResidencyManager &operator=(const ResidencyManager &) = delete;
+
+	ResidencyManager &operator=(ResidencyManager &&) = delete;
+
+	void set_budget_fraction(float budget_fraction);
+
+	/**
+	 * @brief Registers a texture whose top mip levels may be dropped, it must be removed before it is destroyed
+	 *
+	 * Only single layer 2D images with more than one mip level are managed, other images are ignored.
+	 */
+	void add_image(vkb::sg::Image &image);
+
+	/**
+	 * @brief Unregisters a texture, which keeps the mip levels it has
+	 */
+	void remove_image(vkb::sg::Image &image);
+
+	/**
+	 * @brief Registers the given textures and unregisters the others, for instance with the images of a scene which changed
+	 */
+	void set_images(std::span<vkb::sg::Image *const> images);
+
+	/**
+	 * @brief Polls the heap budgets and records the evictions and restorations of the frame
+	 * @param frame_index Index of the frame being begun, whose previous submissions have completed
+	 * @return The command buffer to submit before the rendering of the frame, or a null handle if there is nothing to copy
+	 */
+	vk::CommandBuffer update(uint32_t frame_index);
+
+	/**
+	 * @return Whether images were replaced since the frame was last begun, in which case its cached descriptor sets are stale
+	 */
+	bool has_replaced_images(uint32_t frame_index);
+
+	/**
+	 * @return The budgets of the memory heaps, as polled by the last update
+	 */
+	std::vector<VmaBudget> const &get_heap_budgets() const;
+
+	/**
+	 * @return The number of registered textures missing their top mip levels
+	 */
+	uint32_t get_evicted_image_count() const;
+
+	/**
+	 * @return The size of the mip levels held in host memory while their textures are evicted
+	 */
+	vk::DeviceSize get_evicted_size() const;
+
+  private:
+	enum class State
+	{
+		Resident,         // All the remaining levels are in the image, and nothing is in flight
+		Evicting,         // The top level is read back by a frame which has not completed yet
+		Restoring         // The dropped levels are uploaded into the restored image
+	};
+
+	struct Entry
+	{
+		vkb::sg::Image *image = nullptr;
+
+		State state = State::Resident;
+
+		uint64_t last_used_frame = 0;
+
+		// Number of top mip levels dropped from the image
+		uint32_t dropped_levels = 0;
+
+		// Dropped levels, tightly packed from the most detailed one
+		std::vector<uint8_t> dropped_data;
+
+		// Readback of the level being dropped, and the frame it was recorded in
+		std::unique_ptr<vkb::core::BufferCpp> readback_buffer;
+
+		uint32_t readback_frame_index = 0;
+
+		// Image with all the levels, valid while restoring
+		std::unique_ptr<vkb::core::HPPImage> restored_image;
+
+		vkb::core::UploadToken restore_token;
+	};
+
+	struct RetiredImage
+	{
+		uint32_t frame_index = 0;
+
+		std::unique_ptr<vkb::core::HPPImage> image;
+
+		std::unique_ptr<vkb::core::HPPImageView> image_view;
+	};
+
+	/**
+	 * @brief Size of a mip level of a registered image
+	 */
+	static vk::DeviceSize get_level_size(vkb::sg::Image const &image, uint32_t level);
+
+	void remove_entries(std::function<bool(Entry const &)> const &filter);
+
+	/**
+	 * @return The bytes to free to get all device local heaps under their target, or zero
+	 */
+	vk::DeviceSize poll_budgets();
+
+	void record_eviction(Entry &entry, vk::CommandBuffer command_buffer, uint32_t frame_index);
+
+	void begin_restore(Entry &entry);
+
+	void record_restore(Entry &entry, vk::CommandBuffer command_buffer, uint32_t frame_index);
+
+	/**
+	 * @brief Puts a new image in place of the image of a texture, which is destroyed once the frame has completed
+	 */
+	void replace_image(Entry &entry, std::unique_ptr<vkb::core::HPPImage> &&image, uint32_t frame_index);
+
+	vkb::core::DeviceCpp &device;
+
+	float budget_fraction = 0.9f;
+
+	vk::CommandPool command_pool;
+
+	// One command buffer per frame in flight
+	std::vector<vk::CommandBuffer> command_buffers;
+
+	std::vector<bool> replaced_images;
+
+	std::vector<Entry> entries;
+
+	std::vector<RetiredImage> retired_images;
+
+	std::vector<VmaBudget> heap_budgets;
+
+	std::vector<bool> device_local_heaps;
+
+	uint64_t frame_counter = 0;
+};
+}        // namespace rendering
+}        // namespace vkb
@@ -0,0 +1,358 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rendering/submit_builder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+#include "core/device.h"
+#include "core/hpp_queue.h"
+
+namespace vkb
+{
+namespace rendering
+{
+SubmitBuilder::SubmitBuilder(vkb::core::DeviceCpp &device) :
+    device{device}, use_synchronization2{device.is_synchronization2_enabled()}
+{
+}
+
+SubmitBuilder::~SubmitBuilder()
+{
+	set_submit_thread(false);
+}
+
+void SubmitBuilder::add(vkb::core::HPPQueue const         &queue,
+                        std::span<const vk::CommandBuffer> command_buffers,
+                        std::span<const SemaphoreSubmit>   wait_semaphores,
+                        std::span<const SemaphoreSubmit>   signal_semaphores)
+{
+	Batch batch{.command_buffers   = std::vector<vk::CommandBuffer>(command_buffers.begin(), command_buffers.end()),
+	            .wait_semaphores   = std::vector<SemaphoreSubmit>(wait_semaphores.begin(), wait_semaphores.end()),
+	            .signal_semaphores = std::vector<SemaphoreSubmit>(signal_semaphores.begin(), signal_semaphores.end())};
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	// Walk back to the last open call to the queue, stopping at any call signaling a semaphore the batch waits on
+	auto merge_it = pending.rend();
+	for (auto call_it = pending.rbegin(); call_it != pending.rend(); ++call_it)
+	{
+		if (call_it->queue == &queue)
+		{
+			if (!call_it->fence)
+			{
+				merge_it = call_it;
+			}
+			break;
+		}
+
+		bool signals_wait = std::ranges::any_of(call_it->batches, [&batch](Batch const &other) {
+			return std::ranges::any_of(other.signal_semaphores, [&batch](SemaphoreSubmit const &signal) {
+				return std::ranges::any_of(batch.wait_semaphores, [&signal](SemaphoreSubmit const &wait) { return wait.semaphore == signal.semaphore; });
+			});
+		});
+		if (signals_wait)
+		{
+			break;
+		}
+	}
+
+	if (merge_it != pending.rend())
+	{
+		merge_it->batches.push_back(std::move(batch));
+	}
+	else
+	{
+		pending.push_back({.queue = &queue});
+		pending.back().batches.push_back(std::move(batch));
+	}
+}
+
+void SubmitBuilder::set_fence(vkb::core::HPPQueue const &queue, vk::Fence fence)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto call_it = std::ranges::find_if(pending.rbegin(), pending.rend(), [&queue](Call const &call) { return call.queue == &queue; });
+	if (call_it == pending.rend())
+	{
+		// Nothing is pending on the queue, signal the fence with an empty call
+		pending.push_back({.queue = &queue, .fence = fence});
+	}
+	else
+	{
+		assert(!call_it->fence && "The pending batches of the queue already signal a fence");
+		call_it->fence = fence;
+	}
+}
+
+std::vector<vkb::core::HPPQueue const *> SubmitBuilder::get_pending_queues() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	std::vector<vkb::core::HPPQueue const *> queues;
+	for (auto &call : pending)
+	{
+		if (std::ranges::find(queues, call.queue) == queues.end())
+		{
+			queues.push_back(call.queue);
+		}
+	}
+	return queues;
+}
+
+void SubmitBuilder::flush()
+{
+	std::vector<Call> calls;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::swap(calls, pending);
+	}
+
+	if (calls.empty())
+	{
+		return;
+	}
+
+	if (submit_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(thread_mutex);
+			std::ranges::move(calls, std::back_inserter(queued));
+		}
+		thread_condition.notify_one();
+	}
+	else
+	{
+		submit(calls);
+	}
+}
+
+void SubmitBuilder::wait_submitted()
+{
+	std::unique_lock<std::mutex> lock(thread_mutex);
+	submitted_condition.wait(lock, [this] { return queued.empty() && !submitting; });
+
+	if (thread_exception)
+	{
+		std::rethrow_exception(std::exchange(thread_exception, nullptr));
+	}
+}
+
+void SubmitBuilder::set_submit_thread(bool enable)
+{
+	if (enable == submit_thread.joinable())
+	{
+		return;
+	}
+
+	if (enable)
+	{
+		stop_thread   = false;
+		submit_thread = std::thread(&SubmitBuilder::submit_thread_loop, this);
+	}
+	else
+	{
+		{
+			std::lock_guard<std::mutex> lock(thread_mutex);
+			stop_thread = true;
+		}
+		thread_condition.notify_one();
+		submit_thread.join();
+
+		if (thread_exception)
+		{
+			LOGE("Submission thread stopped with an error");
+			thread_exception = nullptr;
+		}
+	}
+}
+
+bool SubmitBuilder::has_submit_thread() const
+{
+	return submit_thread.joinable();
+}
+
+SubmitStats SubmitBuilder::collect_stats()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return std::exchange(stats, {});
+}
+
+void SubmitBuilder::submit(std::vector<Call> const &calls)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	uint32_t batch_count = 0;
+	for (auto &call : calls)
+	{
+		batch_count += to_u32(call.batches.size());
+
+		// Reserve everything up front, so that the pointers into the arrays stay valid
+		size_t command_buffer_count = 0;
+		size_t semaphore_count      = 0;
+		for (auto &batch : call.batches)
+		{
+			command_buffer_count += batch.command_buffers.size();
+			semaphore_count += batch.wait_semaphores.size() + batch.signal_semaphores.size();
+		}
+
+		if (use_synchronization2)
+		{
+			std::vector<vk::CommandBufferSubmitInfo> command_buffer_infos;
+			std::vector<vk::SemaphoreSubmitInfo>     semaphore_infos;
+			std::vector<vk::SubmitInfo2>             submit_infos;
+			command_buffer_infos.reserve(command_buffer_count);
+			semaphore_infos.reserve(semaphore_count);
+			submit_infos.reserve(call.batches.size());
+
+			auto add_semaphores = [&semaphore_infos](std::vector<SemaphoreSubmit> const &semaphores) {
+				for (auto &semaphore : semaphores)
+				{
+					semaphore_infos.push_back({.semaphore = semaphore.semaphore, .value = semaphore.value, .stageMask = semaphore.stage_mask});
+				}
+				return semaphore_infos.data() + semaphore_infos.size() - semaphores.size();
+			};
+
+			for (auto &batch : call.batches)
+			{
+				auto *wait_infos = add_semaphores(batch.wait_semaphores);
+
+				for (auto command_buffer : batch.command_buffers)
+				{
+					command_buffer_infos.push_back({.commandBuffer = command_buffer});
+				}
+				auto *batch_command_buffer_infos = command_buffer_infos.data() + command_buffer_infos.size() - batch.command_buffers.size();
+
+				auto *signal_infos = add_semaphores(batch.signal_semaphores);
+
+				submit_infos.push_back({.waitSemaphoreInfoCount   = to_u32(batch.wait_semaphores.size()),
+				                        .pWaitSemaphoreInfos      = wait_infos,
+				                        .commandBufferInfoCount   = to_u32(batch.command_buffers.size()),
+				                        .pCommandBufferInfos      = batch_command_buffer_infos,
+				                        .signalSemaphoreInfoCount = to_u32(batch.signal_semaphores.size()),
+				                        .pSignalSemaphoreInfos    = signal_infos});
+			}
+
+			auto guard = call.queue->lock();
+			call.queue->get_handle().submit2(submit_infos, call.fence);
+		}
+		else
+		{
+			std::vector<vk::CommandBuffer>               command_buffers;
+			std::vector<vk::Semaphore>                   semaphores;
+			std::vector<uint64_t>                        values;
+			std::vector<vk::PipelineStageFlags>          wait_stages;
+			std::vector<vk::TimelineSemaphoreSubmitInfo> timeline_infos;
+			std::vector<vk::SubmitInfo>                  submit_infos;
+			command_buffers.reserve(command_buffer_count);
+			semaphores.reserve(semaphore_count);
+			values.reserve(semaphore_count);
+			wait_stages.reserve(semaphore_count);
+			timeline_infos.reserve(call.batches.size());
+			submit_infos.reserve(call.batches.size());
+
+			for (auto &batch : call.batches)
+			{
+				bool uses_timeline = false;
+
+				size_t wait_offset       = semaphores.size();
+				size_t wait_stage_offset = wait_stages.size();
+				for (auto &wait : batch.wait_semaphores)
+				{
+					semaphores.push_back(wait.semaphore);
+					values.push_back(wait.value);
+					// The stages of vkQueueSubmit are the first 32 bits of the synchronization2 stages
+					wait_stages.push_back(static_cast<vk::PipelineStageFlags>(static_cast<VkPipelineStageFlags>(static_cast<VkPipelineStageFlags2>(wait.stage_mask))));
+					uses_timeline |= wait.value != 0;
+				}
+
+				size_t signal_offset = semaphores.size();
+				for (auto &signal : batch.signal_semaphores)
+				{
+					semaphores.push_back(signal.semaphore);
+					values.push_back(signal.value);
+					uses_timeline |= signal.value != 0;
+				}
+
+				size_t command_buffer_offset = command_buffers.size();
+				command_buffers.insert(command_buffers.end(), batch.command_buffers.begin(), batch.command_buffers.end());
+
+				timeline_infos.push_back({.waitSemaphoreValueCount   = to_u32(batch.wait_semaphores.size()),
+				                          .pWaitSemaphoreValues      = values.data() + wait_offset,
+				                          .signalSemaphoreValueCount = to_u32(batch.signal_semaphores.size()),
+				                          .pSignalSemaphoreValues    = values.data() + signal_offset});
+
+				submit_infos.push_back({.pNext                = uses_timeline ? &timeline_infos.back() : nullptr,
+				                        .waitSemaphoreCount   = to_u32(batch.wait_semaphores.size()),
+				                        .pWaitSemaphores      = semaphores.data() + wait_offset,
+				                        .pWaitDstStageMask    = wait_stages.data() + wait_stage_offset,
+				                        .commandBufferCount   = to_u32(batch.command_buffers.size()),
+				                        .pCommandBuffers      = command_buffers.data() + command_buffer_offset,
+				                        .signalSemaphoreCount = to_u32(batch.signal_semaphores.size()),
+				                        .pSignalSemaphores    = semaphores.data() + signal_offset});
+			}
+
+			auto guard = call.queue->lock();
+			call.queue->get_handle().submit(submit_infos, call.fence);
+		}
+	}
+
+	std::chrono::duration<double> cpu_time = std::chrono::steady_clock::now() - start;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	stats.submit_calls += to_u32(calls.size());
+	stats.batches += batch_count;
+	stats.cpu_time += cpu_time.count();
+}
+
+void SubmitBuilder::submit_thread_loop()
+{
+	std::unique_lock<std::mutex> lock(thread_mutex);
+	while (true)
+	{
+		thread_condition.wait(lock, [this] { return stop_thread || !queued.empty(); });
+		if (queued.empty())
+		{
+			// Only stop once all the calls handed to the thread are made
+			break;
+		}
+
+		std::vector<Call> calls;
+		std::swap(calls, queued);
+		submitting = true;
+		lock.unlock();
+
+		try
+		{
+			submit(calls);
+		}
+		catch (...)
+		{
+			lock.lock();
+			thread_exception = std::current_exception();
+			lock.unlock();
+		}
+
+		lock.lock();
+		submitting = false;
+		submitted_condition.notify_all();
+	}
+}
+}        // namespace rendering
+}        // namespace vkb
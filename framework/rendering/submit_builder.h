@@ -0,0 +1,205 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "common/vk_common.h"
+#include <vulkan/vulkan.hpp>
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class Device;
+using DeviceCpp = Device<vkb::BindingType::Cpp>;
+
+class HPPQueue;
+}        // namespace core
+
+namespace rendering
+{
+/**
+ * @brief When the RenderContext hands the submissions of a frame to the driver
+ */
+enum class SubmitMode
+{
+	Immediate,             // Each submission is made when it is requested
+	Batched,               // Submissions are accumulated per queue and made at the end of the frame
+	BatchedOnThread        // As Batched, but the submit calls are made by a dedicated submission thread
+};
+
+/**
+ * @brief A semaphore to wait on or to signal, with the value used for timeline semaphores
+ */
+struct SemaphoreSubmit
+{
+	vk::Semaphore semaphore;
+
+	// Ignored for binary semaphores
+	uint64_t value = 0;
+
+	// Stages waiting on the semaphore, or stages completed before signaling it
+	vk::PipelineStageFlags2 stage_mask = vk::PipelineStageFlagBits2::eAllCommands;
+};
+
+/**
+ * @brief Submission counters, accumulated until they are collected
+ */
+struct SubmitStats
+{
+	// Calls to vkQueueSubmit2, or to vkQueueSubmit without synchronization2
+	uint32_t submit_calls = 0;
+
+	// Batches of command buffers submitted by the calls
+	uint32_t batches = 0;
+
+	// CPU time spent in the submit calls, in seconds
+	double cpu_time = 0.0;
+};
+
+/**
+ * @brief Accumulates batches of command buffers, with their semaphores, and submits them with as few calls as possible
+ *
+ * Consecutive batches to the same queue share one submit call. A batch is also merged into an earlier call to its queue,
+ * unless it waits on a semaphore signaled by a later call, so that binary semaphores are always signaled by a submission
+ * made before the submission waiting on them. Submissions use vkQueueSubmit2 if the synchronization2 feature is enabled,
+ * and vkQueueSubmit with one submit info per batch otherwise.
+ *
+ * Optionally, the submit calls are made by a dedicated thread, so that flushing never blocks in the driver. In that case
+ * the queues must not be used directly, for example to present, before wait_submitted() returns.
+ */
+class SubmitBuilder
+{
+  public:
+	SubmitBuilder(vkb::core::DeviceCpp &device);
+
+	SubmitBuilder(const SubmitBuilder &) = delete;
+
+	SubmitBuilder(SubmitBuilder &&) = delete;
+
+	~SubmitBuilder();
+
+	SubmitBuilder &operator=(const SubmitBuilder &) = delete;
+
+	SubmitBuilder &operator=(SubmitBuilder &&) = delete;
+
+	/**
+	 * @brief Adds a batch of command buffers to the pending submissions of a queue
+	 * @param queue The queue to submit to
+	 * @param command_buffers Command buffers, executed in order
+	 * @param wait_semaphores Semaphores waited on before the command buffers execute
+	 * @param signal_semaphores Semaphores signaled once the command buffers complete
+	 */
+	void add(vkb::core::HPPQueue const         &queue,
+	         std::span<const vk::CommandBuffer> command_buffers,
+	         std::span<const SemaphoreSubmit>   wait_semaphores   = {},
+	         std::span<const SemaphoreSubmit>   signal_semaphores = {});
+
+	/**
+	 * @brief Signals a fence once the pending batches of a queue complete, later batches to the queue go to a new call
+	 */
+	void set_fence(vkb::core::HPPQueue const &queue, vk::Fence fence);
+
+	/**
+	 * @return The queues with pending batches, in the order of their first pending batch
+	 */
+	std::vector<vkb::core::HPPQueue const *> get_pending_queues() const;
+
+	/**
+	 * @brief Submits the pending batches, or hands them to the submission thread if it is enabled
+	 */
+	void flush();
+
+	/**
+	 * @brief Blocks until the submission thread has made all the calls handed to it, and rethrows its errors
+	 */
+	void wait_submitted();
+
+	/**
+	 * @brief Starts or stops the submission thread, stopping it waits for the calls already handed to it
+	 */
+	void set_submit_thread(bool enable);
+
+	bool has_submit_thread() const;
+
+	/**
+	 * @return The counters accumulated since the last collection, which are then reset
+	 */
+	SubmitStats collect_stats();
+
+  private:
+	struct Batch
+	{
+		std::vector<vk::CommandBuffer> command_buffers;
+
+		std::vector<SemaphoreSubmit> wait_semaphores;
+
+		std::vector<SemaphoreSubmit> signal_semaphores;
+	};
+
+	struct Call
+	{
+		vkb::core::HPPQueue const *queue = nullptr;
+
+		// Signaled once all the batches complete, no batch is added to the call once it is set
+		vk::Fence fence;
+
+		std::vector<Batch> batches;
+	};
+
+	void submit(std::vector<Call> const &calls);
+
+	void submit_thread_loop();
+
+	vkb::core::DeviceCpp &device;
+
+	bool use_synchronization2 = false;
+
+	// Guards the pending calls and the stats
+	mutable std::mutex mutex;
+
+	std::vector<Call> pending;
+
+	SubmitStats stats;
+
+	// Guards the calls handed to the submission thread
+	std::mutex thread_mutex;
+
+	std::condition_variable thread_condition;
+
+	std::condition_variable submitted_condition;
+
+	std::vector<Call> queued;
+
+	bool submitting = false;
+
+	bool stop_thread = false;
+
+	std::exception_ptr thread_exception;
+
+	std::thread submit_thread;
+};
+}        // namespace rendering
+}        // namespace vkb
@@ -18,12 +18,15 @@
 
 #pragma once
 
+#include <span>
+
 #include "buffer_pool.h"
 #include "rendering/pipeline_state.h"
 #include "rendering/render_context.h"
 #include "rendering/render_frame.h"
 #include "scene_graph/components/light.h"
 #include "scene_graph/node.h"
+#include "scene_graph/scene_snapshot.h"
 
 namespace vkb
 {
@@ -108,8 +111,8 @@ class Subpass
 	 * @param max_lights_per_type The maximum amount of lights allowed for any given type of light.
 	 */
 	template <typename T>
-	void allocate_lights(const std::vector<sg::Light *> &scene_lights,
-	                     size_t                          max_lights_per_type);
+	void allocate_lights(std::span<sg::Light *const> scene_lights,
+	                     size_t                      max_lights_per_type);
 
 	const std::vector<uint32_t>                               &get_color_resolve_attachments() const;
 	const std::string                                         &get_debug_name() const;
@@ -295,24 +298,28 @@ inline const typename Subpass<bindingType>::ShaderSourceType &Subpass<bindingTyp
 
 template <vkb::BindingType bindingType>
 template <typename T>
-void Subpass<bindingType>::allocate_lights(const std::vector<sg::Light *> &scene_lights,
-                                           size_t                          max_lights_per_type)
+void Subpass<bindingType>::allocate_lights(std::span<sg::Light *const> scene_lights,
+                                           size_t                      max_lights_per_type)
 {
 	lighting_state.directional_lights.clear();
 	lighting_state.point_lights.clear();
 	lighting_state.spot_lights.clear();
 
+	// Lights recorded from a snapshot use the state they had when the scene was extracted
+	auto const *snapshot = render_context.get_scene_snapshot();
+
 	for (auto &scene_light : scene_lights)
 	{
-		const auto &properties = scene_light->get_properties();
-		auto       &transform  = scene_light->get_node()->get_transform();
+		auto const *snapshot_light = snapshot ? snapshot->find_light(*scene_light) : nullptr;
+		auto const  light_state    = snapshot_light ? *snapshot_light : sg::SceneSnapshot::capture_light(*scene_light);
+		auto const &properties     = light_state.properties;
 
-		Light light{{transform.get_translation(), static_cast<float>(scene_light->get_light_type())},
+		Light light{{light_state.translation, static_cast<float>(light_state.type)},
 		            {properties.color, properties.intensity},
-		            {transform.get_rotation() * properties.direction, properties.range},
+		            {light_state.rotation * properties.direction, properties.range},
 		            {properties.inner_cone_angle, properties.outer_cone_angle}};
 
-		switch (scene_light->get_light_type())
+		switch (light_state.type)
 		{
 			case sg::LightType::Directional:
 			{
@@ -322,7 +329,7 @@ void Subpass<bindingType>::allocate_lights(const std::vector<sg::Light *> &scene
 				}
 				else
 				{
-					LOGE("Subpass::allocate_lights: exceeding max_lights_per_type of {} for directional lights", max_lights_per_type);
+					LOGE_RATE_LIMITED("Subpass::allocate_lights: exceeding max_lights_per_type of {} for directional lights", max_lights_per_type);
 				}
 				break;
 			}
@@ -334,7 +341,7 @@ void Subpass<bindingType>::allocate_lights(const std::vector<sg::Light *> &scene
 				}
 				else
 				{
-					LOGE("Subpass::allocate_lights: exceeding max_lights_per_type of {} for point lights", max_lights_per_type);
+					LOGE_RATE_LIMITED("Subpass::allocate_lights: exceeding max_lights_per_type of {} for point lights", max_lights_per_type);
 				}
 				break;
 			}
@@ -346,12 +353,12 @@ void Subpass<bindingType>::allocate_lights(const std::vector<sg::Light *> &scene
 				}
 				else
 				{
-					LOGE("Subpass::allocate_lights: exceeding max_lights_per_type of {} for spot lights", max_lights_per_type);
+					LOGE_RATE_LIMITED("Subpass::allocate_lights: exceeding max_lights_per_type of {} for spot lights", max_lights_per_type);
 				}
 				break;
 			}
 			default:
-				LOGE("Subpass::allocate_lights: encountered unknown light type {}", to_string(scene_light->get_light_type()));
+				LOGE_RATE_LIMITED("Subpass::allocate_lights: encountered unknown light type {}", to_string(light_state.type));
 				break;
 		}
 	}
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "buffer_pool.h"
+#include "rendering/light_clusters.h"
 #include "rendering/subpasses/geometry_subpass.h"
 
 // This value is per type of light that we feed into the shader
@@ -76,6 +77,18 @@ class ForwardSubpass : public vkb::rendering::subpasses::GeometrySubpass<binding
 	// from vkb::rendering::Subpass
 	void draw(vkb::core::CommandBuffer<bindingType> &command_buffer) override;
 	void prepare() override;
+
+	/**
+	 * @brief Switches to clustered lighting, where the fragment shader only evaluates the lights of each cluster
+	 *
+	 * The fragment shader must read the light lists with `clustered_lighting.h`, as `base_clustered.frag` does.
+	 * The owner of the clusters updates them every frame, before the render pass begins.
+	 * Pass nullptr to go back to the fixed light arrays.
+	 */
+	void set_light_clusters(vkb::rendering::LightClusters *light_clusters);
+
+  private:
+	vkb::rendering::LightClusters *light_clusters = nullptr;
 };
 
 using ForwardSubpassC   = ForwardSubpass<vkb::BindingType::C>;
@@ -95,8 +108,15 @@ inline ForwardSubpass<bindingType>::ForwardSubpass(vkb::rendering::RenderContext
 template <vkb::BindingType bindingType>
 inline void ForwardSubpass<bindingType>::draw(vkb::core::CommandBuffer<bindingType> &command_buffer)
 {
-	this->template allocate_lights<ForwardLights>(this->get_scene().template get_components<sg::Light>(), MAX_FORWARD_LIGHT_COUNT);
-	command_buffer.bind_lighting(this->get_lighting_state(), 0, 4);
+	if (light_clusters)
+	{
+		light_clusters->bind(reinterpret_cast<vkb::core::CommandBufferC &>(command_buffer), 0, 5);
+	}
+	else
+	{
+		this->template allocate_lights<ForwardLights>(this->get_scene().template get_components<sg::Light>(), MAX_FORWARD_LIGHT_COUNT);
+		command_buffer.bind_lighting(this->get_lighting_state(), 0, 4);
+	}
 
 	GeometrySubpass<bindingType>::draw(command_buffer);
 }
@@ -116,6 +136,12 @@ inline void ForwardSubpass<bindingType>::prepare()
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline void ForwardSubpass<bindingType>::set_light_clusters(vkb::rendering::LightClusters *light_clusters_)
+{
+	light_clusters = light_clusters_;
+}
+
 }        // namespace subpasses
 }        // namespace rendering
 }        // namespace vkb
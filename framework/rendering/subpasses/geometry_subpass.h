@@ -27,6 +27,7 @@
 #include "scene_graph/components/pbr_material.h"
 #include "scene_graph/components/sub_mesh.h"
 #include "scene_graph/scene.h"
+#include "scene_graph/scene_snapshot.h"
 
 namespace vkb
 {
@@ -127,6 +128,7 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	void                                                   draw_submesh(vkb::core::CommandBuffer<bindingType> &command_buffer, SubMeshType &sub_mesh, FrontFaceType front_face = DefaultFrontFaceTypeValue<FrontFaceType>::value);
 	virtual void                                           draw_submesh_command(vkb::core::CommandBuffer<bindingType> &command_buffer, SubMeshType &sub_mesh);
 	vkb::sg::Camera const                                 &get_camera() const;
+	vkb::sg::SceneSnapshot::CameraState                    get_camera_state();
 	std::vector<MeshType *> const                         &get_meshes() const;
 	vkb::rendering::RasterizationState<bindingType> const &get_rasterization_state() const;
 	vkb::scene_graph::Scene<bindingType> const            &get_scene() const;
@@ -139,6 +141,13 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	                      std::multimap<float, std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &transparent_nodes);
 
 	uint32_t                    get_thread_index() const;
+
+	/**
+	 * @brief Gets the world matrix of a node, from the snapshot of the scene if the frame is recorded from one
+	 *        Subpasses overriding update_uniform should use it rather than reading the transform of the node.
+	 */
+	glm::mat4 get_world_matrix(vkb::scene_graph::Node<bindingType> &node);
+
 	void                        set_rasterization_state(const vkb::rendering::RasterizationState<bindingType> &rasterization_state);
 	virtual PipelineLayoutType &prepare_pipeline_layout(vkb::core::CommandBuffer<bindingType> &command_buffer, const std::vector<ShaderModuleType *> &shader_modules);
 	virtual void                prepare_pipeline_state(vkb::core::CommandBuffer<bindingType> &command_buffer, FrontFaceType front_face, bool double_sided_material);
@@ -190,7 +199,8 @@ inline GeometrySubpass<bindingType>::GeometrySubpass(vkb::rendering::RenderConte
 	{
 		scene = reinterpret_cast<vkb::scene_graph::SceneCpp *>(&scene_);
 	}
-	meshes = scene->get_components<vkb::scene_graph::components::HPPMesh>();
+	auto scene_meshes = scene->get_components<vkb::scene_graph::components::HPPMesh>();
+	meshes.assign(scene_meshes.begin(), scene_meshes.end());
 }
 
 template <vkb::BindingType bindingType>
@@ -214,6 +224,8 @@ inline void GeometrySubpass<bindingType>::draw_impl(vkb::core::CommandBufferCpp
 
 	get_sorted_nodes_impl(opaque_nodes, transparent_nodes);
 
+	auto const *snapshot = this->get_render_context_impl().get_scene_snapshot();
+
 	// Draw opaque objects in front-to-back order
 	{
 		vkb::core::HPPScopedDebugLabel opaque_debug_label{command_buffer, "Opaque objects"};
@@ -232,8 +244,16 @@ inline void GeometrySubpass<bindingType>::draw_impl(vkb::core::CommandBufferCpp
 			}
 
 			// Invert the front face if the mesh was flipped
-			const auto   &scale      = node_it->second.first->get_transform().get_scale();
-			bool          flipped    = scale.x * scale.y * scale.z < 0;
+			bool flipped = false;
+			if (auto const *instance = snapshot ? snapshot->find_mesh_instance(*node_it->second.first) : nullptr)
+			{
+				flipped = instance->flipped;
+			}
+			else
+			{
+				const auto &scale = node_it->second.first->get_transform().get_scale();
+				flipped           = scale.x * scale.y * scale.z < 0;
+			}
 			vk::FrontFace front_face = flipped ? vk::FrontFace::eClockwise : vk::FrontFace::eCounterClockwise;
 
 			draw_submesh_impl(command_buffer, *node_it->second.second, front_face);
@@ -288,6 +308,9 @@ inline void GeometrySubpass<bindingType>::prepare()
 			auto &variant     = sub_mesh->get_shader_variant();
 			auto &vert_module = resource_cache.request_shader_module(vk::ShaderStageFlagBits::eVertex, this->get_vertex_shader_impl(), variant);
 			auto &frag_module = resource_cache.request_shader_module(vk::ShaderStageFlagBits::eFragment, this->get_fragment_shader_impl(), variant);
+
+			// Resolve the vertex attributes up front, so draws bind pre-resolved slots instead of looking up attributes by name
+			sub_mesh->prepare_vertex_input_bindings(vert_module.get_id(), vert_module.get_resources());
 		}
 	}
 }
@@ -339,6 +362,19 @@ inline vkb::sg::Camera const &GeometrySubpass<bindingType>::get_camera() const
 	return camera;
 }
 
+template <vkb::BindingType bindingType>
+inline vkb::sg::SceneSnapshot::CameraState GeometrySubpass<bindingType>::get_camera_state()
+{
+	if (auto const *snapshot = this->get_render_context_impl().get_scene_snapshot())
+	{
+		if (auto const *camera_state = snapshot->find_camera(camera))
+		{
+			return *camera_state;
+		}
+	}
+	return vkb::sg::SceneSnapshot::capture_camera(camera);
+}
+
 template <vkb::BindingType bindingType>
 inline std::vector<typename GeometrySubpass<bindingType>::MeshType *> const &GeometrySubpass<bindingType>::get_meshes() const
 {
@@ -400,31 +436,44 @@ inline void GeometrySubpass<bindingType>::get_sorted_nodes_impl(
     std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &opaque_nodes,
     std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &transparent_nodes)
 {
-	auto camera_transform = camera.get_node()->get_transform().get_world_matrix();
+	auto camera_transform = get_camera_state().world_matrix;
 
-	for (auto &mesh : meshes)
-	{
-		for (auto &node : mesh->get_nodes())
-		{
-			auto node_transform = node->get_transform().get_world_matrix();
+	auto add_node = [&](vkb::scene_graph::components::HPPMesh &mesh, vkb::scene_graph::NodeCpp *node, const glm::mat4 &node_transform) {
+		const sg::AABB &mesh_bounds = mesh.get_bounds();
 
-			const sg::AABB &mesh_bounds = mesh->get_bounds();
+		sg::AABB world_bounds{mesh_bounds.get_min(), mesh_bounds.get_max()};
+		world_bounds.transform(node_transform);
 
-			sg::AABB world_bounds{mesh_bounds.get_min(), mesh_bounds.get_max()};
-			world_bounds.transform(node_transform);
+		float distance = glm::length(glm::vec3(camera_transform[3]) - world_bounds.get_center());
 
-			float distance = glm::length(glm::vec3(camera_transform[3]) - world_bounds.get_center());
+		for (auto &sub_mesh : mesh.get_submeshes())
+		{
+			if (sub_mesh->get_material()->get_alpha_mode() == sg::AlphaMode::Blend)
+			{
+				transparent_nodes.emplace(distance, std::make_pair(node, sub_mesh));
+			}
+			else
+			{
+				opaque_nodes.emplace(distance, std::make_pair(node, sub_mesh));
+			}
+		}
+	};
 
-			for (auto &sub_mesh : mesh->get_submeshes())
+	if (auto const *snapshot = this->get_render_context_impl().get_scene_snapshot())
+	{
+		// The snapshot holds the mesh nodes of the scene, which are the meshes of the subpass
+		for (auto const &instance : snapshot->get_mesh_instances())
+		{
+			add_node(*instance.mesh, instance.node, instance.world_matrix);
+		}
+	}
+	else
+	{
+		for (auto &mesh : meshes)
+		{
+			for (auto &node : mesh->get_nodes())
 			{
-				if (sub_mesh->get_material()->get_alpha_mode() == sg::AlphaMode::Blend)
-				{
-					transparent_nodes.emplace(distance, std::make_pair(node, sub_mesh));
-				}
-				else
-				{
-					opaque_nodes.emplace(distance, std::make_pair(node, sub_mesh));
-				}
+				add_node(*mesh, node, node->get_transform().get_world_matrix());
 			}
 		}
 	}
@@ -436,6 +485,21 @@ inline uint32_t GeometrySubpass<bindingType>::get_thread_index() const
 	return thread_index;
 }
 
+template <vkb::BindingType bindingType>
+inline glm::mat4 GeometrySubpass<bindingType>::get_world_matrix(vkb::scene_graph::Node<bindingType> &node)
+{
+	auto &node_cpp = reinterpret_cast<vkb::scene_graph::NodeCpp &>(node);
+
+	if (auto const *snapshot = this->get_render_context_impl().get_scene_snapshot())
+	{
+		if (auto const *instance = snapshot->find_mesh_instance(node_cpp))
+		{
+			return instance->world_matrix;
+		}
+	}
+	return node_cpp.get_transform().get_world_matrix();
+}
+
 template <vkb::BindingType bindingType>
 inline void GeometrySubpass<bindingType>::set_rasterization_state(const vkb::rendering::RasterizationState<bindingType> &rasterization_state)
 {
@@ -539,43 +603,26 @@ inline void GeometrySubpass<bindingType>::draw_submesh_impl(vkb::core::CommandBu
 	{
 		if (auto layout_binding = descriptor_set_layout.get_layout_binding(texture.first))
 		{
+			texture.second->get_image()->mark_used();
 			command_buffer.bind_image(
 			    texture.second->get_image()->get_vk_image_view(), texture.second->get_sampler()->get_core_sampler(), 0, layout_binding->binding, 0);
 		}
 	}
 
-	auto vertex_input_resources = pipeline_layout.get_resources(vkb::core::HPPShaderResourceType::Input, vk::ShaderStageFlagBits::eVertex);
-
-	vkb::rendering::VertexInputStateCpp vertex_input_state;
-
-	for (auto &input_resource : vertex_input_resources)
+	// Fall back to resolving the vertex inputs on the fly if the submesh was not known when the subpass was prepared
+	vkb::scene_graph::components::HPPVertexInputBindings        fallback_bindings;
+	vkb::scene_graph::components::HPPVertexInputBindings const *vertex_input_bindings = sub_mesh.get_vertex_input_bindings(vert_shader_module.get_id());
+	if (!vertex_input_bindings)
 	{
-		vkb::scene_graph::components::HPPVertexAttribute attribute;
-		if (!sub_mesh.get_attribute(input_resource.name, attribute))
-		{
-			continue;
-		}
-
-		vertex_input_state.attributes.push_back(
-		    {.location = input_resource.location, .binding = input_resource.location, .format = attribute.format, .offset = attribute.offset});
-		vertex_input_state.bindings.push_back({.binding = input_resource.location, .stride = attribute.stride});
+		fallback_bindings     = sub_mesh.create_vertex_input_bindings(vert_shader_module.get_id(), vert_shader_module.get_resources());
+		vertex_input_bindings = &fallback_bindings;
 	}
 
-	command_buffer.set_vertex_input_state(vertex_input_state);
+	command_buffer.set_vertex_input_state(vertex_input_bindings->vertex_input_state);
 
-	// Find submesh vertex buffers matching the shader input attribute names
-	for (auto &input_resource : vertex_input_resources)
+	for (auto &range : vertex_input_bindings->ranges)
 	{
-		auto const *buffer_ptr = sub_mesh.find_vertex_buffer(input_resource.name);
-
-		if (buffer_ptr)
-		{
-			std::vector<std::reference_wrapper<const vkb::core::BufferCpp>> buffers;
-			buffers.emplace_back(std::ref(*buffer_ptr));
-
-			// Bind vertex buffers only for the attribute locations defined
-			command_buffer.bind_vertex_buffers(input_resource.location, std::move(buffers), {0});
-		}
+		command_buffer.bind_vertex_buffers(range.first_binding, range.buffers, range.offsets);
 	}
 
 	if constexpr (bindingType == BindingType::Cpp)
@@ -678,17 +725,17 @@ inline void
 {
 	GlobalUniform global_uniform;
 
-	global_uniform.camera_view_proj = camera.get_pre_rotation() * vkb::rendering::vulkan_style_projection(camera.get_projection()) * camera.get_view();
+	auto camera_state = get_camera_state();
 
-	auto &render_frame = this->get_render_context_impl().get_active_frame();
+	global_uniform.camera_view_proj = camera_state.pre_rotation * vkb::rendering::vulkan_style_projection(camera_state.projection) * camera_state.view;
 
-	auto &transform = node.get_transform();
+	auto &render_frame = this->get_render_context_impl().get_active_frame();
 
 	auto allocation = render_frame.allocate_buffer(vk::BufferUsageFlagBits::eUniformBuffer, sizeof(GlobalUniform), thread_index);
 
-	global_uniform.model = transform.get_world_matrix();
+	global_uniform.model = get_world_matrix(reinterpret_cast<vkb::scene_graph::Node<bindingType> &>(node));
 
-	global_uniform.camera_position = glm::vec3(glm::inverse(camera.get_view())[3]);
+	global_uniform.camera_position = glm::vec3(glm::inverse(camera_state.view)[3]);
 
 	allocation.update(global_uniform);
 
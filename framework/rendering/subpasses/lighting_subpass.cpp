@@ -19,10 +19,12 @@
 
 #include "buffer_pool.h"
 #include "core/command_buffer.h"
+#include "rendering/light_clusters.h"
 #include "rendering/render_context.h"
 #include "resource_cache.h"
 #include "scene_graph/components/camera.h"
 #include "scene_graph/scene.h"
+#include "scene_graph/scene_snapshot.h"
 
 namespace vkb
 {
@@ -42,8 +44,15 @@ void LightingSubpass::prepare()
 
 void LightingSubpass::draw(vkb::core::CommandBufferC &command_buffer)
 {
-	allocate_lights<DeferredLights>(scene.get_components<sg::Light>(), MAX_DEFERRED_LIGHT_COUNT);
-	command_buffer.bind_lighting(get_lighting_state(), 0, 4);
+	if (light_clusters)
+	{
+		light_clusters->bind(command_buffer, 0, 5);
+	}
+	else
+	{
+		allocate_lights<DeferredLights>(scene.get_components<sg::Light>(), MAX_DEFERRED_LIGHT_COUNT);
+		command_buffer.bind_lighting(get_lighting_state(), 0, 4);
+	}
 
 	// Get shaders from cache
 	auto &resource_cache     = command_buffer.get_device().get_resource_cache();
@@ -87,8 +96,13 @@ void LightingSubpass::draw(vkb::core::CommandBufferC &command_buffer)
 	light_uniform.inv_resolution.x = 1.0f / render_target.get_extent().width;
 	light_uniform.inv_resolution.y = 1.0f / render_target.get_extent().height;
 
-	// Inverse view projection
-	light_uniform.inv_view_proj = glm::inverse(vkb::rendering::vulkan_style_projection(camera.get_projection()) * camera.get_view());
+	// Inverse view projection, from the snapshot of the scene if the frame is recorded from one
+	auto const *snapshot     = get_render_context().get_scene_snapshot();
+	auto const *camera_state = snapshot ? snapshot->find_camera(camera) : nullptr;
+	auto const  camera_view  = camera_state ? camera_state->view : camera.get_view();
+	auto const  projection   = camera_state ? camera_state->projection : camera.get_projection();
+
+	light_uniform.inv_view_proj = glm::inverse(vkb::rendering::vulkan_style_projection(projection) * camera_view);
 
 	// Allocate a buffer using the buffer pool from the active frame to store uniform values and bind it
 	auto &render_frame = get_render_context().get_active_frame();
@@ -99,4 +113,9 @@ void LightingSubpass::draw(vkb::core::CommandBufferC &command_buffer)
 	// Draw full screen triangle triangle
 	command_buffer.draw(3, 1, 0, 0);
 }
+
+void LightingSubpass::set_light_clusters(vkb::rendering::LightClusters *light_clusters_)
+{
+	light_clusters = light_clusters_;
+}
 }        // namespace vkb
@@ -41,6 +41,11 @@ class Light;
 class Scene;
 }        // namespace sg
 
+namespace rendering
+{
+class LightClusters;
+}        // namespace rendering
+
 /**
  * @brief Light uniform structure for lighting shader
  * Inverse view projection matrix and inverse resolution vector are used
@@ -72,9 +77,19 @@ class LightingSubpass : public vkb::rendering::SubpassC
 
 	void draw(vkb::core::CommandBufferC &command_buffer) override;
 
+	/**
+	 * @brief Switches to clustered lighting, where the fragment shader only evaluates the lights of each cluster
+	 *
+	 * The fragment shader must read the light lists with `clustered_lighting.h`. The owner of the clusters updates
+	 * them every frame, before the render pass begins. Pass nullptr to go back to the fixed light arrays.
+	 */
+	void set_light_clusters(vkb::rendering::LightClusters *light_clusters);
+
   private:
 	sg::Camera &camera;
 
+	vkb::rendering::LightClusters *light_clusters = nullptr;
+
 	vkb::scene_graph::SceneC &scene;
 
 	ShaderVariant lighting_variant;
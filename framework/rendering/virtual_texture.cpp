@@ -0,0 +1,896 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "virtual_texture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "core/buffer.h"
+#include "core/device.h"
+#include "core/image.h"
+#include "core/image_view.h"
+#include "core/util/logging.hpp"
+#include "scene_graph/components/image.h"
+
+#include <filesystem/filesystem.hpp>
+
+namespace vkb
+{
+namespace rendering
+{
+namespace
+{
+constexpr uint32_t PAGE_FILE_VERSION = 1;
+
+constexpr uint32_t PAGE_FILE_MAGIC = 0x53505456;        // "VTPS"
+
+// Pages of device memory per allocation
+constexpr uint32_t PAGES_PER_BLOCK = 64;
+
+// Pages queued for the loader threads, further requests are dropped until the queue drains
+constexpr size_t MAX_QUEUED_LOADS = 256;
+
+constexpr uint32_t TEXEL_SIZE = 4;
+
+struct PageFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t format;
+	uint32_t width;
+	uint32_t height;
+	uint32_t page_width;
+	uint32_t page_height;
+	uint32_t mip_count;
+	uint32_t paged_level_count;
+};
+
+// Page table header read by the shaders, followed by the most detailed resident level of each page of the finest level
+struct TableHeader
+{
+	uint32_t pages_x;
+	uint32_t pages_y;
+	uint32_t tail_level;
+	uint32_t mip_count;
+};
+
+bool is_power_of_two(uint32_t value)
+{
+	return value != 0 && (value & (value - 1)) == 0;
+}
+
+bool is_supported_format(VkFormat format)
+{
+	return format == VK_FORMAT_R8G8B8A8_UNORM || format == VK_FORMAT_R8G8B8A8_SRGB ||
+	       format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SRGB;
+}
+
+/**
+ * @brief Image of a virtual texture, whose Vulkan image is the sparse image of the texture
+ */
+class VirtualImage : public vkb::sg::Image
+{
+  public:
+	VirtualImage(const std::string &name, VkFormat format, std::vector<vkb::sg::Mipmap> &&mipmaps) :
+	    Image{name, {}, std::move(mipmaps)}
+	{
+		set_format(format);
+	}
+
+	using Image::set_vk_image;
+};
+}        // namespace
+
+VkExtent2D VirtualTexture::get_page_extent(vkb::core::PhysicalDeviceC &gpu, VkFormat format)
+{
+	uint32_t property_count = 0;
+	vkGetPhysicalDeviceSparseImageFormatProperties(gpu.get_handle(), format, VK_IMAGE_TYPE_2D, VK_SAMPLE_COUNT_1_BIT,
+	                                               VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, VK_IMAGE_TILING_OPTIMAL,
+	                                               &property_count, nullptr);
+
+	std::vector<VkSparseImageFormatProperties> properties(property_count);
+	vkGetPhysicalDeviceSparseImageFormatProperties(gpu.get_handle(), format, VK_IMAGE_TYPE_2D, VK_SAMPLE_COUNT_1_BIT,
+	                                               VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, VK_IMAGE_TILING_OPTIMAL,
+	                                               &property_count, properties.data());
+
+	for (auto &property : properties)
+	{
+		if (property.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT)
+		{
+			return {property.imageGranularity.width, property.imageGranularity.height};
+		}
+	}
+	return {};
+}
+
+void VirtualTexture::create_page_file(const std::string &image_uri, const std::filesystem::path &page_file, VkExtent2D page_extent)
+{
+	auto image = vkb::sg::Image::load(image_uri, image_uri, vkb::sg::Image::Color);
+	if (!image)
+	{
+		throw std::runtime_error{"Failed to load virtual texture " + image_uri};
+	}
+
+	VkExtent3D extent = image->get_extent();
+	if (!is_supported_format(image->get_format()) || image->get_layers() != 1 || !is_power_of_two(extent.width) || !is_power_of_two(extent.height))
+	{
+		throw std::runtime_error{"Virtual texture " + image_uri + " must be a single 2D image with four 8 bit channels and power of two dimensions"};
+	}
+	if (!is_power_of_two(page_extent.width) || !is_power_of_two(page_extent.height))
+	{
+		throw std::runtime_error{"Virtual texture pages must have power of two dimensions"};
+	}
+
+	if (image->get_mipmaps().size() == 1)
+	{
+		image->generate_mipmaps();
+	}
+
+	const auto &mipmaps = image->get_mipmaps();
+	const auto &data    = image->get_data();
+
+	// The levels at least as large as a page are split into pages, the smaller ones are stored whole
+	uint32_t paged_level_count = 0;
+	while (paged_level_count < mipmaps.size() && mipmaps[paged_level_count].extent.width >= page_extent.width &&
+	       mipmaps[paged_level_count].extent.height >= page_extent.height)
+	{
+		paged_level_count++;
+	}
+
+	std::ofstream file{page_file, std::ios::binary | std::ios::trunc};
+	if (!file.is_open())
+	{
+		throw std::runtime_error{"Failed to open page file for writing at path: " + page_file.string()};
+	}
+
+	PageFileHeader header{PAGE_FILE_MAGIC, PAGE_FILE_VERSION, static_cast<uint32_t>(image->get_format()), extent.width, extent.height,
+	                      page_extent.width, page_extent.height, static_cast<uint32_t>(mipmaps.size()), paged_level_count};
+	file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+	const size_t         row_size = static_cast<size_t>(page_extent.width) * TEXEL_SIZE;
+	std::vector<uint8_t> page(row_size * page_extent.height);
+	for (uint32_t level = 0; level < paged_level_count; ++level)
+	{
+		const auto &mipmap = mipmaps[level];
+		for (uint32_t page_y = 0; page_y < mipmap.extent.height / page_extent.height; ++page_y)
+		{
+			for (uint32_t page_x = 0; page_x < mipmap.extent.width / page_extent.width; ++page_x)
+			{
+				for (uint32_t row = 0; row < page_extent.height; ++row)
+				{
+					size_t source = mipmap.offset + ((static_cast<size_t>(page_y) * page_extent.height + row) * mipmap.extent.width + page_x * page_extent.width) * TEXEL_SIZE;
+					std::memcpy(&page[row * row_size], &data[source], row_size);
+				}
+				file.write(reinterpret_cast<const char *>(page.data()), page.size());
+			}
+		}
+	}
+
+	for (uint32_t level = paged_level_count; level < mipmaps.size(); ++level)
+	{
+		const auto &mipmap = mipmaps[level];
+		file.write(reinterpret_cast<const char *>(&data[mipmap.offset]), static_cast<size_t>(mipmap.extent.width) * mipmap.extent.height * TEXEL_SIZE);
+	}
+
+	if (!file)
+	{
+		throw std::runtime_error{"Failed to write page file at path: " + page_file.string()};
+	}
+}
+
+VirtualTexture::VirtualTexture(vkb::core::DeviceC &device, const std::filesystem::path &page_file, uint32_t physical_page_count, uint32_t frame_count, uint32_t loader_thread_count) :
+    device{device}, page_file{page_file}
+{
+	auto header_data = vkb::filesystem::get()->read_chunk(page_file, 0, sizeof(PageFileHeader));
+
+	PageFileHeader header{};
+	if (header_data.size() == sizeof(PageFileHeader))
+	{
+		std::memcpy(&header, header_data.data(), sizeof(PageFileHeader));
+	}
+	if (header.magic != PAGE_FILE_MAGIC || header.version != PAGE_FILE_VERSION || !is_supported_format(static_cast<VkFormat>(header.format)) ||
+	    !is_power_of_two(header.width) || !is_power_of_two(header.height) || !is_power_of_two(header.page_width) || !is_power_of_two(header.page_height) ||
+	    header.mip_count == 0 || header.mip_count > 32 || header.paged_level_count > header.mip_count)
+	{
+		throw std::runtime_error{"Invalid page file at path: " + page_file.string()};
+	}
+
+	format            = static_cast<VkFormat>(header.format);
+	extent            = {header.width, header.height};
+	page_extent       = {header.page_width, header.page_height};
+	mip_count         = header.mip_count;
+	paged_level_count = header.paged_level_count;
+	page_size         = static_cast<VkDeviceSize>(page_extent.width) * page_extent.height * TEXEL_SIZE;
+
+	sparse_queue = device.get_queue_by_flags(VK_QUEUE_SPARSE_BINDING_BIT, 0).get_handle();
+
+	create_image();
+
+	uint32_t page_count = 0;
+	for (uint32_t level = 0; level < tail_level; ++level)
+	{
+		level_offsets.push_back(page_count);
+		page_count += ((extent.width >> level) / page_extent.width) * ((extent.height >> level) / page_extent.height);
+	}
+	pages.resize(page_count);
+	min_lods.assign(std::max((extent.width / page_extent.width) * (extent.height / page_extent.height), 1u), tail_level);
+
+	allocate_memory(physical_page_count);
+
+	frames.resize(std::max(frame_count, 1u));
+	for (auto &frame : frames)
+	{
+		frame.feedback_buffer = std::make_unique<vkb::core::BufferC>(
+		    device,
+		    vkb::core::BufferBuilderC(std::max<VkDeviceSize>(pages.size(), 1) * sizeof(uint32_t))
+		        .with_usage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+		        .with_vma_usage(VMA_MEMORY_USAGE_GPU_TO_CPU)
+		        .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT));
+		std::memset(frame.feedback_buffer->map(), 0, frame.feedback_buffer->get_size());
+		frame.feedback_buffer->flush();
+
+		frame.table_buffer = std::make_unique<vkb::core::BufferC>(
+		    device,
+		    vkb::core::BufferBuilderC(sizeof(TableHeader) + min_lods.size() * sizeof(uint32_t))
+		        .with_usage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+		        .with_vma_usage(VMA_MEMORY_USAGE_CPU_TO_GPU)
+		        .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT));
+
+		VkSemaphoreCreateInfo semaphore_info{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+		VK_CHECK(vkCreateSemaphore(device.get_handle(), &semaphore_info, nullptr, &frame.bound_semaphore));
+	}
+
+	upload_mip_tail();
+
+	std::vector<vkb::sg::Mipmap> mipmaps;
+	for (uint32_t level = 0; level < mip_count; ++level)
+	{
+		mipmaps.push_back({level, 0, {std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u), 1}});
+	}
+
+	auto virtual_image = std::make_unique<VirtualImage>(page_file.stem().string(), format, std::move(mipmaps));
+	auto vk_image      = std::make_unique<vkb::core::Image>(device, image, VkExtent3D{extent.width, extent.height, 1}, format,
+	                                                        VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+	auto vk_image_view = std::make_unique<vkb::core::ImageView>(*vk_image, VK_IMAGE_VIEW_TYPE_2D, format, 0, 0, mip_count, 1);
+	virtual_image->set_vk_image(std::move(vk_image), std::move(vk_image_view));
+	sg_image = std::move(virtual_image);
+
+	for (uint32_t i = 0; i < std::max(loader_thread_count, 1u); ++i)
+	{
+		loaders.emplace_back(&VirtualTexture::loader_loop, this);
+	}
+}
+
+VirtualTexture::~VirtualTexture()
+{
+	{
+		std::lock_guard<std::mutex> lock(load_mutex);
+		stopping = true;
+	}
+	load_condition.notify_all();
+	for (auto &loader : loaders)
+	{
+		loader.join();
+	}
+
+	sg_image.reset();
+
+	for (auto &frame : frames)
+	{
+		vkDestroySemaphore(device.get_handle(), frame.bound_semaphore, nullptr);
+	}
+
+	vkDestroyImage(device.get_handle(), image, nullptr);
+
+	for (auto memory : memory_blocks)
+	{
+		vkFreeMemory(device.get_handle(), memory, nullptr);
+	}
+	if (tail_memory != VK_NULL_HANDLE)
+	{
+		vkFreeMemory(device.get_handle(), tail_memory, nullptr);
+	}
+}
+
+void VirtualTexture::begin_frame(uint32_t frame_index_)
+{
+	frame_index = frame_index_;
+	frame_counter++;
+
+	auto &frame = frames[frame_index];
+
+	// The frames which may have sampled the pages retired by this frame have completed, so their memory can be reused
+	for (uint32_t page_index : frame.retired_pages)
+	{
+		auto &page = pages[page_index];
+		free_physical_pages.push_back(page.physical_page);
+		page.state = PageState::NotResident;
+		unbound_pages.push_back(page_index);
+	}
+	retiring_count -= frame.retired_pages.size();
+	frame.retired_pages.clear();
+
+	frame.feedback_buffer->invalidate();
+	auto *feedback = reinterpret_cast<uint32_t *>(frame.feedback_buffer->map());
+
+	statistics.requested_pages = 0;
+	for (uint32_t page_index = 0; page_index < pages.size(); ++page_index)
+	{
+		if (feedback[page_index] != 0)
+		{
+			statistics.requested_pages++;
+			request_page(page_index);
+		}
+	}
+
+	std::memset(feedback, 0, pages.size() * sizeof(uint32_t));
+	frame.feedback_buffer->flush();
+
+	load_condition.notify_all();
+}
+
+VkSemaphore VirtualTexture::update(VkCommandBuffer command_buffer, uint32_t max_uploads)
+{
+	auto &frame = frames[frame_index];
+
+	{
+		std::lock_guard<std::mutex> lock(load_mutex);
+		statistics.loading_pages -= loaded_pages.size();
+		for (auto &loaded : loaded_pages)
+		{
+			pages[loaded.page_index].state = PageState::Loaded;
+			waiting_pages.push_back(std::move(loaded));
+		}
+		loaded_pages.clear();
+	}
+
+	// Evict the least recently used pages which were not requested by the last feedback, for the pages waiting for memory
+	size_t needed_pages = std::min<size_t>(waiting_pages.size(), max_uploads);
+	while (free_physical_pages.size() + retiring_count < needed_pages && lru_head != INVALID_PAGE && pages[lru_head].last_use < frame_counter)
+	{
+		retire_page(lru_head);
+	}
+
+	std::vector<VkSparseImageMemoryBind> binds;
+
+	VkDeviceSize staging_size = static_cast<VkDeviceSize>(std::max(max_uploads, 1u)) * page_size;
+	if (!frame.staging_buffer || frame.staging_buffer->get_size() < staging_size)
+	{
+		frame.staging_buffer = std::make_unique<vkb::core::BufferC>(
+		    device,
+		    vkb::core::BufferBuilderC(staging_size)
+		        .with_usage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+		        .with_vma_usage(VMA_MEMORY_USAGE_CPU_TO_GPU)
+		        .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT));
+	}
+
+	uint8_t                       *staging = frame.staging_buffer->map();
+	std::vector<VkBufferImageCopy> copies;
+	uint32_t                       min_level = mip_count;
+	uint32_t                       max_level = 0;
+
+	size_t waiting_index = 0;
+	for (; waiting_index < waiting_pages.size() && copies.size() < max_uploads && !free_physical_pages.empty(); ++waiting_index)
+	{
+		auto &loaded = waiting_pages[waiting_index];
+		auto &page   = pages[loaded.page_index];
+		if (loaded.data.size() != page_size)
+		{
+			page.state = PageState::NotResident;
+			continue;
+		}
+
+		page.physical_page = free_physical_pages.back();
+		free_physical_pages.pop_back();
+
+		VkDeviceSize staging_offset = copies.size() * page_size;
+		std::memcpy(staging + staging_offset, loaded.data.data(), page_size);
+
+		VkSparseImageMemoryBind bind = get_page_bind(loaded.page_index);
+		bind.memory                  = memory_blocks[page.physical_page / PAGES_PER_BLOCK];
+		bind.memoryOffset            = (page.physical_page % PAGES_PER_BLOCK) * memory_page_size;
+		binds.push_back(bind);
+
+		VkBufferImageCopy copy{};
+		copy.bufferOffset     = staging_offset;
+		copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, bind.subresource.mipLevel, 0, 1};
+		copy.imageOffset      = bind.offset;
+		copy.imageExtent      = bind.extent;
+		copies.push_back(copy);
+
+		min_level = std::min(min_level, bind.subresource.mipLevel);
+		max_level = std::max(max_level, bind.subresource.mipLevel);
+
+		page.state = PageState::Resident;
+		lru_push_back(loaded.page_index);
+		update_min_lods(loaded.page_index);
+		statistics.loaded_pages++;
+	}
+	waiting_pages.erase(waiting_pages.begin(), waiting_pages.begin() + waiting_index);
+
+	// Pages bound again by this update already replaced their previous binding
+	for (uint32_t page_index : unbound_pages)
+	{
+		if (pages[page_index].state != PageState::Resident)
+		{
+			binds.push_back(get_page_bind(page_index));
+		}
+	}
+	unbound_pages.clear();
+
+	VkSemaphore bound_semaphore = VK_NULL_HANDLE;
+	if (!binds.empty())
+	{
+		// All the pages bound and unbound by the frame are batched into a single call
+		VkSparseImageMemoryBindInfo image_bind_info{};
+		image_bind_info.image     = image;
+		image_bind_info.bindCount = static_cast<uint32_t>(binds.size());
+		image_bind_info.pBinds    = binds.data();
+
+		VkBindSparseInfo bind_info{VK_STRUCTURE_TYPE_BIND_SPARSE_INFO};
+		bind_info.imageBindCount       = 1;
+		bind_info.pImageBinds          = &image_bind_info;
+		bind_info.signalSemaphoreCount = 1;
+		bind_info.pSignalSemaphores    = &frame.bound_semaphore;
+		VK_CHECK(vkQueueBindSparse(sparse_queue, 1, &bind_info, VK_NULL_HANDLE));
+
+		bound_semaphore = frame.bound_semaphore;
+	}
+
+	if (!copies.empty())
+	{
+		frame.staging_buffer->flush();
+
+		// The other pages of the levels keep their content, so the levels are transitioned from their current layout
+		VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+		barrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.oldLayout           = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		barrier.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image               = image;
+		barrier.subresourceRange    = {VK_IMAGE_ASPECT_COLOR_BIT, min_level, max_level - min_level + 1, 0, 1};
+		vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+		vkCmdCopyBufferToImage(command_buffer, frame.staging_buffer->get_handle(), image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		                       static_cast<uint32_t>(copies.size()), copies.data());
+
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+	}
+
+	if (frame.table_version != table_version)
+	{
+		TableHeader table_header{extent.width / page_extent.width, extent.height / page_extent.height, tail_level, mip_count};
+		frame.table_buffer->update(&table_header, sizeof(TableHeader));
+		frame.table_buffer->update(min_lods.data(), min_lods.size() * sizeof(uint32_t), sizeof(TableHeader));
+		frame.table_version = table_version;
+	}
+
+	statistics.resident_pages = static_cast<size_t>(std::ranges::count(pages, PageState::Resident, &Page::state));
+
+	return bound_semaphore;
+}
+
+void VirtualTexture::end_frame(VkCommandBuffer command_buffer)
+{
+	// Makes the feedback written by the shaders visible to the host once the frame has completed
+	VkBufferMemoryBarrier barrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+	barrier.srcAccessMask       = VK_ACCESS_SHADER_WRITE_BIT;
+	barrier.dstAccessMask       = VK_ACCESS_HOST_READ_BIT;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.buffer              = frames[frame_index].feedback_buffer->get_handle();
+	barrier.size                = VK_WHOLE_SIZE;
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+vkb::sg::Image &VirtualTexture::get_image()
+{
+	return *sg_image;
+}
+
+const vkb::core::BufferC &VirtualTexture::get_table_buffer() const
+{
+	return *frames[frame_index].table_buffer;
+}
+
+const vkb::core::BufferC &VirtualTexture::get_feedback_buffer() const
+{
+	return *frames[frame_index].feedback_buffer;
+}
+
+const VirtualTexture::Statistics &VirtualTexture::get_statistics() const
+{
+	return statistics;
+}
+
+uint32_t VirtualTexture::get_level(uint32_t page_index) const
+{
+	return static_cast<uint32_t>(std::upper_bound(level_offsets.begin(), level_offsets.end(), page_index) - level_offsets.begin()) - 1;
+}
+
+size_t VirtualTexture::get_page_offset(uint32_t page_index) const
+{
+	// The pages of the levels above the mip tail are stored in the order of the page table
+	return sizeof(PageFileHeader) + page_index * page_size;
+}
+
+VkSparseImageMemoryBind VirtualTexture::get_page_bind(uint32_t page_index) const
+{
+	uint32_t level   = get_level(page_index);
+	uint32_t pages_x = (extent.width >> level) / page_extent.width;
+	uint32_t local   = page_index - level_offsets[level];
+
+	VkSparseImageMemoryBind bind{};
+	bind.subresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0};
+	bind.offset      = {static_cast<int32_t>((local % pages_x) * page_extent.width), static_cast<int32_t>((local / pages_x) * page_extent.height), 0};
+	bind.extent      = {page_extent.width, page_extent.height, 1};
+	return bind;
+}
+
+void VirtualTexture::create_image()
+{
+	VkImageCreateInfo image_info{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+	image_info.flags         = VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT;
+	image_info.imageType     = VK_IMAGE_TYPE_2D;
+	image_info.format        = format;
+	image_info.extent        = {extent.width, extent.height, 1};
+	image_info.mipLevels     = mip_count;
+	image_info.arrayLayers   = 1;
+	image_info.samples       = VK_SAMPLE_COUNT_1_BIT;
+	image_info.tiling        = VK_IMAGE_TILING_OPTIMAL;
+	image_info.usage         = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	image_info.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+	image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	VK_CHECK(vkCreateImage(device.get_handle(), &image_info, nullptr, &image));
+
+	uint32_t requirement_count = 0;
+	vkGetImageSparseMemoryRequirements(device.get_handle(), image, &requirement_count, nullptr);
+	std::vector<VkSparseImageMemoryRequirements> requirements(requirement_count);
+	vkGetImageSparseMemoryRequirements(device.get_handle(), image, &requirement_count, requirements.data());
+
+	auto color_requirements = std::ranges::find_if(requirements, [](const VkSparseImageMemoryRequirements &requirement) {
+		return requirement.formatProperties.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT;
+	});
+	if (color_requirements == requirements.end())
+	{
+		vkDestroyImage(device.get_handle(), image, nullptr);
+		throw std::runtime_error{"Sparse residency is not supported for the format of " + page_file.string()};
+	}
+	sparse_requirements = *color_requirements;
+
+	// The levels above the mip tail are bound page by page, which requires them to be made of whole pages of the page file
+	const VkExtent3D &granularity = sparse_requirements.formatProperties.imageGranularity;
+	tail_level                    = std::min(sparse_requirements.imageMipTailFirstLod, mip_count);
+	if (granularity.width != page_extent.width || granularity.height != page_extent.height || tail_level > paged_level_count)
+	{
+		vkDestroyImage(device.get_handle(), image, nullptr);
+		throw std::runtime_error{"The pages of " + page_file.string() + " do not match the sparse block size of the device"};
+	}
+}
+
+void VirtualTexture::allocate_memory(uint32_t physical_page_count)
+{
+	VkMemoryRequirements memory_requirements;
+	vkGetImageMemoryRequirements(device.get_handle(), image, &memory_requirements);
+
+	// Each page of the image is backed by one sparse block of memory
+	memory_page_size     = memory_requirements.alignment;
+	uint32_t memory_type = device.get_gpu().get_memory_type(memory_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+	physical_page_count  = std::min<uint32_t>(physical_page_count, static_cast<uint32_t>(pages.size()));
+
+	for (uint32_t first_page = 0; first_page < physical_page_count; first_page += PAGES_PER_BLOCK)
+	{
+		VkMemoryAllocateInfo allocate_info{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+		allocate_info.allocationSize  = std::min(PAGES_PER_BLOCK, physical_page_count - first_page) * memory_page_size;
+		allocate_info.memoryTypeIndex = memory_type;
+
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		VK_CHECK(vkAllocateMemory(device.get_handle(), &allocate_info, nullptr, &memory));
+		memory_blocks.push_back(memory);
+	}
+
+	// Popped from the back, so the first blocks are used first
+	for (uint32_t physical_page = physical_page_count; physical_page-- > 0;)
+	{
+		free_physical_pages.push_back(physical_page);
+	}
+
+	if (tail_level < mip_count)
+	{
+		VkMemoryAllocateInfo allocate_info{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+		allocate_info.allocationSize  = sparse_requirements.imageMipTailSize;
+		allocate_info.memoryTypeIndex = memory_type;
+		VK_CHECK(vkAllocateMemory(device.get_handle(), &allocate_info, nullptr, &tail_memory));
+	}
+}
+
+void VirtualTexture::upload_mip_tail()
+{
+	auto fs = vkb::filesystem::get();
+
+	std::vector<uint8_t>           tail_data;
+	std::vector<VkBufferImageCopy> copies;
+
+	// The paged levels of the mip tail are read page by page, the levels smaller than a page are stored whole after them
+	size_t file_offset = get_page_offset(static_cast<uint32_t>(pages.size()));
+	for (uint32_t level = tail_level; level < mip_count; ++level)
+	{
+		VkExtent2D level_extent{std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u)};
+		if (level < paged_level_count)
+		{
+			for (uint32_t page_y = 0; page_y < level_extent.height / page_extent.height; ++page_y)
+			{
+				for (uint32_t page_x = 0; page_x < level_extent.width / page_extent.width; ++page_x)
+				{
+					VkBufferImageCopy copy{};
+					copy.bufferOffset     = tail_data.size();
+					copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+					copy.imageOffset      = {static_cast<int32_t>(page_x * page_extent.width), static_cast<int32_t>(page_y * page_extent.height), 0};
+					copy.imageExtent      = {page_extent.width, page_extent.height, 1};
+					copies.push_back(copy);
+
+					auto data = fs->read_chunk(page_file, file_offset, page_size);
+					tail_data.insert(tail_data.end(), data.begin(), data.end());
+					file_offset += page_size;
+				}
+			}
+		}
+		else
+		{
+			VkBufferImageCopy copy{};
+			copy.bufferOffset     = tail_data.size();
+			copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+			copy.imageExtent      = {level_extent.width, level_extent.height, 1};
+			copies.push_back(copy);
+
+			size_t level_size = static_cast<size_t>(level_extent.width) * level_extent.height * TEXEL_SIZE;
+			auto   data       = fs->read_chunk(page_file, file_offset, level_size);
+			tail_data.insert(tail_data.end(), data.begin(), data.end());
+			file_offset += level_size;
+		}
+
+		if (tail_data.size() != copies.back().bufferOffset + static_cast<VkDeviceSize>(copies.back().imageExtent.width) * copies.back().imageExtent.height * TEXEL_SIZE)
+		{
+			throw std::runtime_error{"Invalid page file at path: " + page_file.string()};
+		}
+	}
+
+	if (tail_memory != VK_NULL_HANDLE)
+	{
+		VkSparseMemoryBind tail_bind{};
+		tail_bind.resourceOffset = sparse_requirements.imageMipTailOffset;
+		tail_bind.size           = sparse_requirements.imageMipTailSize;
+		tail_bind.memory         = tail_memory;
+
+		VkSparseImageOpaqueMemoryBindInfo opaque_bind_info{};
+		opaque_bind_info.image     = image;
+		opaque_bind_info.bindCount = 1;
+		opaque_bind_info.pBinds    = &tail_bind;
+
+		VkBindSparseInfo bind_info{VK_STRUCTURE_TYPE_BIND_SPARSE_INFO};
+		bind_info.imageOpaqueBindCount = 1;
+		bind_info.pImageOpaqueBinds    = &opaque_bind_info;
+
+		VkFenceCreateInfo fence_info{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+		VkFence           fence = VK_NULL_HANDLE;
+		VK_CHECK(vkCreateFence(device.get_handle(), &fence_info, nullptr, &fence));
+		VK_CHECK(vkQueueBindSparse(sparse_queue, 1, &bind_info, fence));
+		VK_CHECK(vkWaitForFences(device.get_handle(), 1, &fence, VK_TRUE, UINT64_MAX));
+		vkDestroyFence(device.get_handle(), fence, nullptr);
+	}
+
+	// The whole image is transitioned, the levels above the mip tail have no page bound yet
+	VkImageSubresourceRange subresource_range{VK_IMAGE_ASPECT_COLOR_BIT, 0, mip_count, 0, 1};
+	if (!tail_data.empty())
+	{
+		auto &upload_manager = device.get_upload_manager();
+		auto  upload_token   = upload_manager.upload_image(tail_data.data(), tail_data.size(), image, copies, subresource_range);
+		upload_manager.flush();
+		upload_manager.wait(upload_token);
+		return;
+	}
+
+	// Without a mip tail there is nothing to copy, only the layout of the image is set
+	VkCommandBuffer command_buffer = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+	VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+	barrier.dstAccessMask       = VK_ACCESS_SHADER_READ_BIT;
+	barrier.oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout           = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image               = image;
+	barrier.subresourceRange    = subresource_range;
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	device.flush_command_buffer(command_buffer, device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0).get_handle(), true);
+}
+
+void VirtualTexture::request_page(uint32_t page_index)
+{
+	uint32_t level   = get_level(page_index);
+	uint32_t pages_x = (extent.width >> level) / page_extent.width;
+	uint32_t local   = page_index - level_offsets[level];
+	uint32_t page_x  = local % pages_x;
+	uint32_t page_y  = local / pages_x;
+
+	// The pages covering the requested one are needed to sample it, they are loaded first
+	for (uint32_t chain_level = tail_level; chain_level-- > level;)
+	{
+		uint32_t shift       = chain_level - level;
+		uint32_t chain_index = level_offsets[chain_level] + (page_y >> shift) * ((extent.width >> chain_level) / page_extent.width) + (page_x >> shift);
+
+		touch_page(chain_index);
+
+		auto &page = pages[chain_index];
+		if (page.state == PageState::NotResident)
+		{
+			std::lock_guard<std::mutex> lock(load_mutex);
+			if (load_queue.size() < MAX_QUEUED_LOADS)
+			{
+				page.state = PageState::Loading;
+				load_queue.push_back(chain_index);
+				statistics.loading_pages++;
+			}
+		}
+	}
+}
+
+void VirtualTexture::retire_page(uint32_t page_index)
+{
+	auto &page = pages[page_index];
+
+	lru_remove(page_index);
+	page.state = PageState::Retiring;
+	frames[frame_index].retired_pages.push_back(page_index);
+	retiring_count++;
+	statistics.evicted_pages++;
+
+	update_min_lods(page_index);
+}
+
+void VirtualTexture::touch_page(uint32_t page_index)
+{
+	auto &page    = pages[page_index];
+	page.last_use = frame_counter;
+
+	if (page.state == PageState::Resident)
+	{
+		lru_remove(page_index);
+		lru_push_back(page_index);
+	}
+}
+
+void VirtualTexture::lru_remove(uint32_t page_index)
+{
+	auto &page = pages[page_index];
+
+	if (page.lru_previous != INVALID_PAGE)
+	{
+		pages[page.lru_previous].lru_next = page.lru_next;
+	}
+	else
+	{
+		lru_head = page.lru_next;
+	}
+
+	if (page.lru_next != INVALID_PAGE)
+	{
+		pages[page.lru_next].lru_previous = page.lru_previous;
+	}
+	else
+	{
+		lru_tail = page.lru_previous;
+	}
+
+	page.lru_previous = INVALID_PAGE;
+	page.lru_next     = INVALID_PAGE;
+}
+
+void VirtualTexture::lru_push_back(uint32_t page_index)
+{
+	auto &page = pages[page_index];
+
+	page.lru_previous = lru_tail;
+	page.lru_next     = INVALID_PAGE;
+
+	if (lru_tail != INVALID_PAGE)
+	{
+		pages[lru_tail].lru_next = page_index;
+	}
+	else
+	{
+		lru_head = page_index;
+	}
+	lru_tail = page_index;
+}
+
+void VirtualTexture::update_min_lods(uint32_t page_index)
+{
+	uint32_t level   = get_level(page_index);
+	uint32_t pages_x = (extent.width >> level) / page_extent.width;
+	uint32_t local   = page_index - level_offsets[level];
+
+	uint32_t finest_pages_x = extent.width / page_extent.width;
+	uint32_t begin_x        = (local % pages_x) << level;
+	uint32_t begin_y        = (local / pages_x) << level;
+
+	for (uint32_t y = begin_y; y < begin_y + (1u << level); ++y)
+	{
+		for (uint32_t x = begin_x; x < begin_x + (1u << level); ++x)
+		{
+			// A level can only be sampled if the pages of all the coarser levels covering it are resident
+			uint32_t min_lod = tail_level;
+			for (uint32_t chain_level = tail_level; chain_level-- > 0;)
+			{
+				uint32_t chain_index = level_offsets[chain_level] + (y >> chain_level) * (finest_pages_x >> chain_level) + (x >> chain_level);
+				if (pages[chain_index].state != PageState::Resident)
+				{
+					break;
+				}
+				min_lod = chain_level;
+			}
+			min_lods[y * finest_pages_x + x] = min_lod;
+		}
+	}
+
+	table_version++;
+}
+
+void VirtualTexture::loader_loop()
+{
+	auto fs = vkb::filesystem::get();
+
+	while (true)
+	{
+		uint32_t page_index = 0;
+		{
+			std::unique_lock<std::mutex> lock(load_mutex);
+			load_condition.wait(lock, [this] { return stopping || !load_queue.empty(); });
+			if (stopping)
+			{
+				return;
+			}
+
+			page_index = load_queue.front();
+			load_queue.pop_front();
+		}
+
+		LoadedPage loaded{page_index};
+		try
+		{
+			loaded.data = fs->read_chunk(page_file, get_page_offset(page_index), page_size);
+		}
+		catch (std::exception const &e)
+		{
+			LOGE("Failed to read page {} of {}: {}", page_index, page_file.string(), e.what());
+		}
+
+		std::lock_guard<std::mutex> lock(load_mutex);
+		loaded_pages.push_back(std::move(loaded));
+	}
+}
+}        // namespace rendering
+}        // namespace vkb
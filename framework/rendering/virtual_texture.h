@@ -0,0 +1,337 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/vk_common.h"
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class Buffer;
+using BufferC = Buffer<vkb::BindingType::C>;
+
+template <vkb::BindingType bindingType>
+class Device;
+using DeviceC = Device<vkb::BindingType::C>;
+
+template <vkb::BindingType bindingType>
+class PhysicalDevice;
+using PhysicalDeviceC = PhysicalDevice<vkb::BindingType::C>;
+}        // namespace core
+
+namespace sg
+{
+class Image;
+}        // namespace sg
+
+namespace rendering
+{
+/**
+ * @brief Texture streamed page by page into a sparse image, from the pages the shaders sampling it request
+ *
+ * The texture is read from a page file, which holds each mip level split into pages of the sparse block size of the
+ * device, followed by the levels smaller than a page. The levels of the mip tail are bound and uploaded once, every
+ * other level is only backed by the pages that were requested, so the texture may be much larger than device memory.
+ *
+ * Shaders sample the texture with sample_virtual_texture from shaders/includes/glsl/virtual_texture.h, which writes the
+ * pages it needs into a feedback buffer, and clamps the sampled level to the resident pages with the page table. Each
+ * frame in flight has its own feedback and page table buffers:
+ *  - begin_frame reads the feedback of the last submission of the frame, and queues the missing pages for loading
+ *  - update binds the pages loaded by the loader threads with a single vkQueueBindSparse, records their copies and
+ *    writes the page table of the frame
+ *  - end_frame makes the feedback of the frame readable by the host
+ *
+ * Once all physical pages are used, the least recently requested pages are evicted. An evicted page is removed from
+ * the page table right away, and its memory is only reused once the frames which may have sampled it have completed.
+ *
+ * The device needs the sparseBinding and sparseResidencyImage2D features, and a queue supporting sparse binding.
+ */
+class VirtualTexture
+{
+  public:
+	// Bindings of the page table and the feedback buffer in set 0, which must match shaders/includes/glsl/virtual_texture.h
+	static constexpr uint32_t TABLE_BINDING = 9;
+
+	static constexpr uint32_t FEEDBACK_BINDING = 10;
+
+	struct Statistics
+	{
+		size_t requested_pages = 0;        // Pages written into the last feedback read
+
+		size_t resident_pages = 0;
+
+		size_t loading_pages = 0;        // Pages queued for or being read by the loader threads
+
+		size_t loaded_pages = 0;        // Pages bound and uploaded since the texture was created
+
+		size_t evicted_pages = 0;        // Pages evicted since the texture was created
+	};
+
+	/**
+	 * @return The size of the pages of a 2D sparse image, or an empty extent if the format does not support sparse residency
+	 */
+	static VkExtent2D get_page_extent(vkb::core::PhysicalDeviceC &gpu, VkFormat format);
+
+	/**
+	 * @brief Creates the page file of a texture
+	 *        The full mip chain is built in host memory, so the texture must fit in host memory while the file is created
+	 * @param image_uri Asset path of an image with four 8 bit channels, whose dimensions are powers of two
+	 * @param page_file Path of the created page file
+	 * @param page_extent Size of the pages, as returned by get_page_extent
+	 */
+	static void create_page_file(const std::string &image_uri, const std::filesystem::path &page_file, VkExtent2D page_extent);
+
+	/**
+	 * @brief Creates the sparse image of a page file, and uploads its mip tail
+	 * @param device The device, with the sparse binding features enabled
+	 * @param page_file Page file created by create_page_file, with the page size of the device
+	 * @param physical_page_count Number of pages of device memory backing the levels above the mip tail
+	 * @param frame_count Number of frames in flight
+	 * @param loader_thread_count Number of threads reading pages from the page file
+	 * @throws std::runtime_error if the page file is invalid or does not match the device
+	 */
+	VirtualTexture(vkb::core::DeviceC &device, const std::filesystem::path &page_file, uint32_t physical_page_count, uint32_t frame_count, uint32_t loader_thread_count = 1);
+
+	VirtualTexture(const VirtualTexture &) = delete;
+
+	VirtualTexture(VirtualTexture &&) = delete;
+
+	~VirtualTexture();
+
+	VirtualTexture &operator=(const VirtualTexture &) = delete;
+
+	VirtualTexture &operator=(VirtualTexture &&) = delete;
+
+	/**
+	 * @brief Reads the feedback of the frame and queues the requested pages which are not resident
+	 * @param frame_index Index of the frame being begun, whose previous submissions have completed
+	 */
+	void begin_frame(uint32_t frame_index);
+
+	/**
+	 * @brief Binds the loaded pages, records their copies and writes the page table of the frame
+	 * @param command_buffer Command buffer of the frame, recorded before the draws sampling the texture
+	 * @param max_uploads Maximum number of pages uploaded by the frame
+	 * @return A semaphore the submission of the command buffer must wait on for the transfer stage,
+	 *         or a null handle if no page was bound
+	 */
+	VkSemaphore update(VkCommandBuffer command_buffer, uint32_t max_uploads = 16);
+
+	/**
+	 * @brief Makes the feedback written by the frame visible to the host, once the frame has completed
+	 * @param command_buffer Command buffer of the frame, recorded after the draws sampling the texture
+	 */
+	void end_frame(VkCommandBuffer command_buffer);
+
+	/**
+	 * @brief The image of the texture, which can be set on any sg::Texture
+	 *        It manages its own residency, so it must not be registered with a ResidencyManager
+	 */
+	vkb::sg::Image &get_image();
+
+	/**
+	 * @return The page table of the frame being recorded, read by the shaders at TABLE_BINDING
+	 */
+	const vkb::core::BufferC &get_table_buffer() const;
+
+	/**
+	 * @return The feedback buffer of the frame being recorded, written by the shaders at FEEDBACK_BINDING
+	 */
+	const vkb::core::BufferC &get_feedback_buffer() const;
+
+	const Statistics &get_statistics() const;
+
+  private:
+	static constexpr uint32_t INVALID_PAGE = UINT32_MAX;
+
+	enum class PageState : uint8_t
+	{
+		NotResident,
+		Loading,         // Queued for or being read by the loader threads
+		Loaded,          // Read, waiting for a physical page
+		Resident,
+		Retiring         // Evicted, its physical page is freed once the frames which may sample it have completed
+	};
+
+	/**
+	 * @brief Entry of the page table, for each page of the levels above the mip tail
+	 */
+	struct Page
+	{
+		PageState state = PageState::NotResident;
+
+		uint32_t physical_page = INVALID_PAGE;
+
+		// Value of the frame counter when the page or a more detailed page it covers was last requested
+		uint64_t last_use = 0;
+
+		// Neighbors in the list of resident pages, from the least recently used one
+		uint32_t lru_previous = INVALID_PAGE;
+
+		uint32_t lru_next = INVALID_PAGE;
+	};
+
+	struct LoadedPage
+	{
+		uint32_t page_index = 0;
+
+		std::vector<uint8_t> data;
+	};
+
+	struct Frame
+	{
+		std::unique_ptr<vkb::core::BufferC> feedback_buffer;
+
+		std::unique_ptr<vkb::core::BufferC> table_buffer;
+
+		std::unique_ptr<vkb::core::BufferC> staging_buffer;
+
+		VkSemaphore bound_semaphore = VK_NULL_HANDLE;
+
+		// Pages evicted while the frame was recorded
+		std::vector<uint32_t> retired_pages;
+
+		// Version of the page table last written into the table buffer
+		uint64_t table_version = 0;
+	};
+
+	uint32_t get_level(uint32_t page_index) const;
+
+	/**
+	 * @return Offset of a page in the page file
+	 */
+	size_t get_page_offset(uint32_t page_index) const;
+
+	VkSparseImageMemoryBind get_page_bind(uint32_t page_index) const;
+
+	void create_image();
+
+	void allocate_memory(uint32_t physical_page_count);
+
+	void upload_mip_tail();
+
+	void request_page(uint32_t page_index);
+
+	void retire_page(uint32_t page_index);
+
+	void touch_page(uint32_t page_index);
+
+	void lru_remove(uint32_t page_index);
+
+	void lru_push_back(uint32_t page_index);
+
+	/**
+	 * @brief Recomputes the most detailed resident level of the pages of the finest level covered by a page
+	 */
+	void update_min_lods(uint32_t page_index);
+
+	void loader_loop();
+
+	vkb::core::DeviceC &device;
+
+	std::filesystem::path page_file;
+
+	VkFormat format = VK_FORMAT_UNDEFINED;
+
+	VkExtent2D extent{};
+
+	VkExtent2D page_extent{};
+
+	uint32_t mip_count = 0;
+
+	// Number of levels stored as pages in the page file
+	uint32_t paged_level_count = 0;
+
+	// First level of the mip tail of the image, the levels above it are made of pages
+	uint32_t tail_level = 0;
+
+	// Size of a page in the page file, and of a page of device memory
+	VkDeviceSize page_size = 0;
+
+	VkDeviceSize memory_page_size = 0;
+
+	VkImage image = VK_NULL_HANDLE;
+
+	std::unique_ptr<vkb::sg::Image> sg_image;
+
+	VkSparseImageMemoryRequirements sparse_requirements{};
+
+	VkQueue sparse_queue = VK_NULL_HANDLE;
+
+	std::vector<VkDeviceMemory> memory_blocks;
+
+	VkDeviceMemory tail_memory = VK_NULL_HANDLE;
+
+	// Index of the first page of each level above the mip tail
+	std::vector<uint32_t> level_offsets;
+
+	std::vector<Page> pages;
+
+	std::vector<uint32_t> free_physical_pages;
+
+	uint32_t lru_head = INVALID_PAGE;
+
+	uint32_t lru_tail = INVALID_PAGE;
+
+	size_t retiring_count = 0;
+
+	// Most detailed resident level for each page of the finest level, copied into the table buffers
+	std::vector<uint32_t> min_lods;
+
+	uint64_t table_version = 1;
+
+	// Pages whose memory was freed, unbound by the next update
+	std::vector<uint32_t> unbound_pages;
+
+	// Loaded pages waiting for a physical page
+	std::vector<LoadedPage> waiting_pages;
+
+	std::vector<Frame> frames;
+
+	uint32_t frame_index = 0;
+
+	uint64_t frame_counter = 0;
+
+	Statistics statistics;
+
+	std::vector<std::thread> loaders;
+
+	// Pages to read, and pages read by the loader threads
+	std::deque<uint32_t> load_queue;
+
+	std::vector<LoadedPage> loaded_pages;
+
+	std::mutex load_mutex;
+
+	std::condition_variable load_condition;
+
+	bool stopping = false;
+};
+}        // namespace rendering
+}        // namespace vkb
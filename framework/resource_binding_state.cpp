@@ -23,7 +23,10 @@ void ResourceBindingState::reset()
 {
 	clear_dirty();
 
-	resource_sets.clear();
+	for (auto &resource_set : resource_sets)
+	{
+		resource_set.reset();
+	}
 }
 
 bool ResourceBindingState::is_dirty()
@@ -38,42 +41,51 @@ void ResourceBindingState::clear_dirty()
 
 void ResourceBindingState::clear_dirty(uint32_t set)
 {
-	resource_sets[set].clear_dirty();
+	get_resource_set(set).clear_dirty();
 }
 
 void ResourceBindingState::bind_buffer(const vkb::core::BufferC &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_buffer(buffer, offset, range, binding, array_element);
+	get_resource_set(set).bind_buffer(buffer, offset, range, binding, array_element);
 
 	dirty = true;
 }
 
 void ResourceBindingState::bind_image(const core::ImageView &image_view, const core::Sampler &sampler, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_image(image_view, sampler, binding, array_element);
+	get_resource_set(set).bind_image(image_view, sampler, binding, array_element);
 
 	dirty = true;
 }
 
 void ResourceBindingState::bind_image(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_image(image_view, binding, array_element);
+	get_resource_set(set).bind_image(image_view, binding, array_element);
 
 	dirty = true;
 }
 
 void ResourceBindingState::bind_input(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_input(image_view, binding, array_element);
+	get_resource_set(set).bind_input(image_view, binding, array_element);
 
 	dirty = true;
 }
 
-const std::unordered_map<uint32_t, ResourceSet> &ResourceBindingState::get_resource_sets()
+std::span<const ResourceSet> ResourceBindingState::get_resource_sets() const
 {
 	return resource_sets;
 }
 
+ResourceSet &ResourceBindingState::get_resource_set(uint32_t set)
+{
+	if (set >= resource_sets.size())
+	{
+		resource_sets.resize(set + 1);
+	}
+	return resource_sets[set];
+}
+
 void ResourceSet::reset()
 {
 	clear_dirty();
@@ -86,6 +98,11 @@ bool ResourceSet::is_dirty() const
 	return dirty;
 }
 
+bool ResourceSet::is_empty() const
+{
+	return resource_bindings.empty();
+}
+
 void ResourceSet::clear_dirty()
 {
 	dirty = false;
@@ -93,46 +110,54 @@ void ResourceSet::clear_dirty()
 
 void ResourceSet::clear_dirty(uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty = false;
+	resource_bindings.at(binding, array_element).dirty = false;
 }
 
 void ResourceSet::bind_buffer(const vkb::core::BufferC &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty  = true;
-	resource_bindings[binding][array_element].buffer = &buffer;
-	resource_bindings[binding][array_element].offset = offset;
-	resource_bindings[binding][array_element].range  = range;
+	auto &resource_info = resource_bindings.at(binding, array_element);
+
+	resource_info.dirty  = true;
+	resource_info.buffer = &buffer;
+	resource_info.offset = offset;
+	resource_info.range  = range;
 
 	dirty = true;
 }
 
 void ResourceSet::bind_image(const core::ImageView &image_view, const core::Sampler &sampler, uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty      = true;
-	resource_bindings[binding][array_element].image_view = &image_view;
-	resource_bindings[binding][array_element].sampler    = &sampler;
+	auto &resource_info = resource_bindings.at(binding, array_element);
+
+	resource_info.dirty      = true;
+	resource_info.image_view = &image_view;
+	resource_info.sampler    = &sampler;
 
 	dirty = true;
 }
 
 void ResourceSet::bind_image(const core::ImageView &image_view, uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty      = true;
-	resource_bindings[binding][array_element].image_view = &image_view;
-	resource_bindings[binding][array_element].sampler    = nullptr;
+	auto &resource_info = resource_bindings.at(binding, array_element);
+
+	resource_info.dirty      = true;
+	resource_info.image_view = &image_view;
+	resource_info.sampler    = nullptr;
 
 	dirty = true;
 }
 
 void ResourceSet::bind_input(const core::ImageView &image_view, const uint32_t binding, const uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty      = true;
-	resource_bindings[binding][array_element].image_view = &image_view;
+	auto &resource_info = resource_bindings.at(binding, array_element);
+
+	resource_info.dirty      = true;
+	resource_info.image_view = &image_view;
 
 	dirty = true;
 }
 
-const BindingMap<ResourceInfo> &ResourceSet::get_resource_bindings() const
+const BindingTable<ResourceInfo> &ResourceSet::get_resource_bindings() const
 {
 	return resource_bindings;
 }
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "common/binding_table.h"
 #include "common/vk_common.h"
 #include "core/buffer.h"
 
@@ -65,6 +66,8 @@ class ResourceSet
 
 	bool is_dirty() const;
 
+	bool is_empty() const;
+
 	void clear_dirty();
 
 	void clear_dirty(uint32_t binding, uint32_t array_element);
@@ -77,12 +80,12 @@ class ResourceSet
 
 	void bind_input(const core::ImageView &image_view, uint32_t binding, uint32_t array_element);
 
-	const BindingMap<ResourceInfo> &get_resource_bindings() const;
+	const BindingTable<ResourceInfo> &get_resource_bindings() const;
 
   private:
 	bool dirty{false};
 
-	BindingMap<ResourceInfo> resource_bindings;
+	BindingTable<ResourceInfo> resource_bindings;
 };
 
 /**
@@ -90,6 +93,9 @@ class ResourceSet
  *
  * Keeps track of all the resources bound by the command buffer. The ResourceBindingState is used by
  * the command buffer to create the appropriate descriptor sets when it comes to draw.
+ *
+ * Resource sets are indexed by their set number and are kept when the state is reset, so that binding resources
+ * does not allocate once the command buffer has been used.
  */
 class ResourceBindingState
 {
@@ -110,11 +116,16 @@ class ResourceBindingState
 
 	void bind_input(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element);
 
-	const std::unordered_map<uint32_t, ResourceSet> &get_resource_sets();
+	/**
+	 * @return The resource sets, indexed by set number, empty for the sets with no resources bound
+	 */
+	std::span<const ResourceSet> get_resource_sets() const;
 
   private:
+	ResourceSet &get_resource_set(uint32_t set);
+
 	bool dirty{false};
 
-	std::unordered_map<uint32_t, ResourceSet> resource_sets;
+	std::vector<ResourceSet> resource_sets;
 };
 }        // namespace vkb
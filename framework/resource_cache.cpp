@@ -65,14 +65,17 @@ ShaderModule &ResourceCache::request_shader_module(VkShaderStageFlagBits stage,
 
 PipelineLayout &ResourceCache::request_pipeline_layout(const std::vector<ShaderModule *> &shader_modules)
 {
-	return request_resource(device, recorder, pipeline_layout_mutex, state.pipeline_layouts, shader_modules);
+	// The backend is part of the key, so that changing the backend of the device creates new layouts
+	DescriptorBackend backend = device.get_descriptor_backend();
+	return request_resource(device, recorder, pipeline_layout_mutex, state.pipeline_layouts, shader_modules, backend);
 }
 
 DescriptorSetLayout &ResourceCache::request_descriptor_set_layout(const uint32_t                     set_index,
                                                                   const std::vector<ShaderModule *> &shader_modules,
-                                                                  const std::vector<ShaderResource> &set_resources)
+                                                                  const std::vector<ShaderResource> &set_resources,
+                                                                  DescriptorBackend                  backend)
 {
-	return request_resource(device, recorder, descriptor_set_layout_mutex, state.descriptor_set_layouts, set_index, shader_modules, set_resources);
+	return request_resource(device, recorder, descriptor_set_layout_mutex, state.descriptor_set_layouts, set_index, shader_modules, set_resources, backend);
 }
 
 GraphicsPipeline &ResourceCache::request_graphics_pipeline(vkb::rendering::PipelineStateC &pipeline_state)
@@ -103,7 +103,8 @@ class ResourceCache
 
 	DescriptorSetLayout &request_descriptor_set_layout(const uint32_t                     set_index,
 	                                                   const std::vector<ShaderModule *> &shader_modules,
-	                                                   const std::vector<ShaderResource> &set_resources);
+	                                                   const std::vector<ShaderResource> &set_resources,
+	                                                   DescriptorBackend                  backend = DescriptorBackend::Pooled);
 
 	GraphicsPipeline &request_graphics_pipeline(vkb::rendering::PipelineStateC &pipeline_state);
 
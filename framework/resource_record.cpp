@@ -64,7 +64,7 @@ size_t ResourceRecord::register_shader_module(VkShaderStageFlagBits stage, const
 	return shader_module_indices.back();
 }
 
-size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *> &shader_modules)
+size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *> &shader_modules, DescriptorBackend backend)
 {
 	pipeline_layout_indices.push_back(pipeline_layout_indices.size());
 
@@ -74,7 +74,8 @@ size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *
 
 	write(stream,
 	      ResourceType::PipelineLayout,
-	      shader_indices);
+	      shader_indices,
+	      backend);
 
 	return pipeline_layout_indices.back();
 }
@@ -102,9 +102,11 @@ void ResourceReplay::create_shader_module(ResourceCache &resource_cache, std::is
 void ResourceReplay::create_pipeline_layout(ResourceCache &resource_cache, std::istringstream &stream)
 {
 	std::vector<size_t> shader_indices;
+	DescriptorBackend   backend;
 
 	read(stream,
-	     shader_indices);
+	     shader_indices,
+	     backend);
 
 	std::vector<ShaderModule *> shader_stages(shader_indices.size());
 	std::transform(shader_indices.begin(),
@@ -115,6 +117,7 @@ void ResourceReplay::create_pipeline_layout(ResourceCache &resource_cache, std::
 		               return shader_modules[shader_index];
 	               });
 
+	// The layout is created for the descriptor backend of the device, which may differ from the recorded one
 	auto &pipeline_layout = resource_cache.request_pipeline_layout(shader_stages);
 
 	pipeline_layouts.push_back(&pipeline_layout);
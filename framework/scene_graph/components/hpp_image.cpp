@@ -17,6 +17,7 @@
 
 #include "hpp_image.h"
 
+#include "common/content_hash.h"
 #include "common/hpp_utils.h"
 #include "filesystem/legacy.h"
 #include "scene_graph/components/image/astc.h"
@@ -200,6 +201,11 @@ void HPPImage::coerce_format_to_srgb()
 	}
 }
 
+bool HPPImage::consume_used() const
+{
+	return used.exchange(false, std::memory_order_relaxed);
+}
+
 void HPPImage::create_vk_image(vkb::core::DeviceCpp &device, vk::ImageViewType image_view_type, vk::ImageCreateFlags flags)
 {
 	assert(!vk_image && !vk_image_view && "Vulkan HPPImage already constructed");
@@ -207,7 +213,7 @@ void HPPImage::create_vk_image(vkb::core::DeviceCpp &device, vk::ImageViewType i
 	vk_image = std::make_unique<vkb::core::HPPImage>(device,
 	                                                 get_extent(),
 	                                                 format,
-	                                                 vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst,
+	                                                 vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc,
 	                                                 VMA_MEMORY_USAGE_GPU_ONLY,
 	                                                 vk::SampleCountFlagBits::e1,
 	                                                 to_u32(mipmaps.size()),
@@ -268,7 +274,8 @@ void HPPImage::generate_mipmaps()
 
 void HPPImage::update_hash()
 {
-	data_hash = vkb::calculate_hash(data);
+	// Images are loaded on several threads at once, so each is hashed on its loading thread
+	data_hash = static_cast<size_t>(vkb::content_hash64(data));
 }
 
 void HPPImage::update_hash(size_t hash)
@@ -318,6 +325,11 @@ const vkb::core::HPPImageView &HPPImage::get_vk_image_view() const
 	return *vk_image_view;
 }
 
+void HPPImage::mark_used() const
+{
+	used.store(true, std::memory_order_relaxed);
+}
+
 vkb::scene_graph::components::HPPMipmap &HPPImage::get_mipmap(const size_t index)
 {
 	assert(index < mipmaps.size());
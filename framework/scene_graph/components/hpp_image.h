@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "common/vk_common.h"
 #include "core/hpp_image.h"
 #include "scene_graph/component.h"
@@ -77,6 +79,7 @@ class HPPImage : public vkb::sg::Component
 
 	void                                                        clear_data();
 	void                                                        coerce_format_to_srgb();
+	bool                                                        consume_used() const;
 	void                                                        create_vk_image(vkb::core::DeviceCpp &device, vk::ImageViewType image_view_type = vk::ImageViewType::e2D, vk::ImageCreateFlags flags = {});
 	void                                                        generate_mipmaps();
 	const std::vector<uint8_t>                                 &get_data() const;
@@ -87,6 +90,7 @@ class HPPImage : public vkb::sg::Component
 	const std::vector<std::vector<vk::DeviceSize>>             &get_offsets() const;
 	const vkb::core::HPPImage                                  &get_vk_image() const;
 	const vkb::core::HPPImageView                              &get_vk_image_view() const;
+	void                                                        mark_used() const;
 	void                                                        update_hash(size_t data_hash);
 	void                                                        update_hash();
 
@@ -111,6 +115,7 @@ class HPPImage : public vkb::sg::Component
 	std::vector<std::vector<vk::DeviceSize>>             offsets;        // Offsets stored like offsets[array_layer][mipmap_layer]
 	std::unique_ptr<vkb::core::HPPImage>                 vk_image;
 	std::unique_ptr<vkb::core::HPPImageView>             vk_image_view;
+	mutable std::atomic<bool>                            used{false};
 };
 
 }        // namespace scene_graph::components
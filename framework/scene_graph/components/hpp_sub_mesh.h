@@ -34,6 +34,24 @@ struct HPPVertexAttribute
 	std::uint32_t offset = 0;
 };
 
+struct HPPVertexInputBindings
+{
+	struct Range
+	{
+		std::uint32_t first_binding = 0;
+
+		std::vector<std::reference_wrapper<const vkb::core::BufferCpp>> buffers;
+
+		std::vector<vk::DeviceSize> offsets;
+	};
+
+	size_t shader_id = 0;
+
+	vkb::rendering::VertexInputStateCpp vertex_input_state;
+
+	std::vector<Range> ranges;
+};
+
 /**
  * @brief facade class around vkb::sg::SubMesh, providing a vulkan.hpp-based interface
  *
@@ -77,6 +95,22 @@ class HPPSubMesh : private vkb::sg::SubMesh
 		return reinterpret_cast<vkb::core::HPPShaderVariant const &>(vkb::sg::SubMesh::get_shader_variant());
 	}
 
+	HPPVertexInputBindings create_vertex_input_bindings(size_t shader_id, const std::vector<vkb::core::HPPShaderResource> &shader_resources) const
+	{
+		auto bindings = vkb::sg::SubMesh::create_vertex_input_bindings(shader_id, reinterpret_cast<std::vector<vkb::ShaderResource> const &>(shader_resources));
+		return std::move(reinterpret_cast<HPPVertexInputBindings &>(bindings));
+	}
+
+	void prepare_vertex_input_bindings(size_t shader_id, const std::vector<vkb::core::HPPShaderResource> &shader_resources)
+	{
+		vkb::sg::SubMesh::prepare_vertex_input_bindings(shader_id, reinterpret_cast<std::vector<vkb::ShaderResource> const &>(shader_resources));
+	}
+
+	const HPPVertexInputBindings *get_vertex_input_bindings(size_t shader_id) const
+	{
+		return reinterpret_cast<HPPVertexInputBindings const *>(vkb::sg::SubMesh::get_vertex_input_bindings(shader_id));
+	}
+
 	vkb::core::BufferCpp const &get_vertex_buffer(std::string const &name) const
 	{
 		return reinterpret_cast<vkb::core::BufferCpp const &>(vkb::sg::SubMesh::vertex_buffers.at(name));
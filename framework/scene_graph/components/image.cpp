@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <mutex>
 
+#include "common/content_hash.h"
 #include "common/error.h"
 
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
@@ -210,7 +211,7 @@ void Image::create_vk_image(vkb::core::DeviceC &device, VkImageViewType image_vi
 	vk_image = std::make_unique<core::Image>(device,
 	                                         get_extent(),
 	                                         format,
-	                                         VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+	                                         VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
 	                                         VMA_MEMORY_USAGE_GPU_ONLY,
 	                                         VK_SAMPLE_COUNT_1_BIT,
 	                                         to_u32(mipmaps.size()),
@@ -235,6 +236,32 @@ const core::ImageView &Image::get_vk_image_view() const
 	return *vk_image_view;
 }
 
+std::pair<std::unique_ptr<core::Image>, std::unique_ptr<core::ImageView>> Image::replace_vk_image(std::unique_ptr<core::Image>     &&image,
+                                                                                                  std::unique_ptr<core::ImageView> &&image_view)
+{
+	assert(vk_image && vk_image_view && "Vulkan image was not created");
+	assert(image && image_view && (&image_view->get_image() == image.get()));
+	return {std::exchange(vk_image, std::move(image)), std::exchange(vk_image_view, std::move(image_view))};
+}
+
+void Image::set_vk_image(std::unique_ptr<core::Image> &&image, std::unique_ptr<core::ImageView> &&image_view)
+{
+	assert(!vk_image && !vk_image_view && "Vulkan image already created");
+	assert(image && image_view && (&image_view->get_image() == image.get()));
+	vk_image      = std::move(image);
+	vk_image_view = std::move(image_view);
+}
+
+void Image::mark_used() const
+{
+	used.store(true, std::memory_order_relaxed);
+}
+
+bool Image::consume_used() const
+{
+	return used.exchange(false, std::memory_order_relaxed);
+}
+
 Mipmap &Image::get_mipmap(const size_t index)
 {
 	assert(index < mipmaps.size());
@@ -321,7 +348,8 @@ std::vector<uint8_t> &Image::get_mut_data()
 
 void Image::update_hash()
 {
-	data_hash = vkb::calculate_hash(data);
+	// Images are loaded on several threads at once, so each is hashed on its loading thread
+	data_hash = static_cast<size_t>(vkb::content_hash64(data));
 }
 
 void Image::update_hash(size_t hash)
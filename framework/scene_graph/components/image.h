@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <typeinfo>
@@ -102,6 +103,23 @@ class Image : public Component
 
 	const core::ImageView &get_vk_image_view() const;
 
+	/**
+	 * @brief Replaces the Vulkan image and its view, for instance by a copy holding fewer mip levels
+	 * @return The previous image and view, which must be kept until the GPU no longer uses them
+	 */
+	std::pair<std::unique_ptr<core::Image>, std::unique_ptr<core::ImageView>> replace_vk_image(std::unique_ptr<core::Image>     &&image,
+	                                                                                           std::unique_ptr<core::ImageView> &&image_view);
+
+	/**
+	 * @brief Marks the image as sampled by the frame being recorded, which keeps it resident in the ResidencyManager
+	 */
+	void mark_used() const;
+
+	/**
+	 * @return Whether the image was marked as used since the last call
+	 */
+	bool consume_used() const;
+
 	void coerce_format_to_srgb();
 
   protected:
@@ -111,6 +129,11 @@ class Image : public Component
 
 	void set_format(VkFormat format);
 
+	/**
+	 * @brief Sets a Vulkan image created outside of create_vk_image, with a view of the image
+	 */
+	void set_vk_image(std::unique_ptr<core::Image> &&image, std::unique_ptr<core::ImageView> &&image_view);
+
 	void set_width(uint32_t width);
 
 	void set_height(uint32_t height);
@@ -146,6 +169,8 @@ class Image : public Component
 	std::unique_ptr<core::Image> vk_image;
 
 	std::unique_ptr<core::ImageView> vk_image_view;
+
+	mutable std::atomic<bool> used{false};
 };
 
 }        // namespace sg
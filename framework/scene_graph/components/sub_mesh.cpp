@@ -17,6 +17,8 @@
 
 #include "sub_mesh.h"
 
+#include <algorithm>
+
 #include "material.h"
 #include "rendering/subpass.h"
 
@@ -77,6 +79,80 @@ bool SubMesh::get_attribute(const std::string &attribute_name, VertexAttribute &
 	return true;
 }
 
+VertexInputBindings SubMesh::create_vertex_input_bindings(size_t shader_id, const std::vector<ShaderResource> &shader_resources) const
+{
+	VertexInputBindings bindings;
+	bindings.shader_id = shader_id;
+
+	std::vector<std::pair<uint32_t, const vkb::core::BufferC *>> buffers;
+
+	for (auto &resource : shader_resources)
+	{
+		if (resource.type != ShaderResourceType::Input || !(resource.stages & VK_SHADER_STAGE_VERTEX_BIT))
+		{
+			continue;
+		}
+
+		auto attrib_it = vertex_attributes.find(resource.name);
+		if (attrib_it == vertex_attributes.end())
+		{
+			continue;
+		}
+		auto &attribute = attrib_it->second;
+
+		if (interleaved_vertex_buffer)
+		{
+			// All attributes are fetched from a single binding
+			if (bindings.vertex_input_state.bindings.empty())
+			{
+				bindings.vertex_input_state.bindings.push_back({0, attribute.stride, VK_VERTEX_INPUT_RATE_VERTEX});
+				bindings.ranges.push_back({0, {std::cref(*interleaved_vertex_buffer)}, {interleaved_vertex_offset}});
+			}
+			bindings.vertex_input_state.attributes.push_back({resource.location, 0, attribute.format, attribute.offset});
+		}
+		else
+		{
+			auto buffer_it = vertex_buffers.find(resource.name);
+			if (buffer_it == vertex_buffers.end())
+			{
+				continue;
+			}
+
+			bindings.vertex_input_state.bindings.push_back({resource.location, attribute.stride, VK_VERTEX_INPUT_RATE_VERTEX});
+			bindings.vertex_input_state.attributes.push_back({resource.location, resource.location, attribute.format, attribute.offset});
+			buffers.emplace_back(resource.location, &buffer_it->second);
+		}
+	}
+
+	// Merge consecutive binding slots, so they are bound with one command
+	std::sort(buffers.begin(), buffers.end(), [](auto const &lhs, auto const &rhs) { return lhs.first < rhs.first; });
+	for (auto &[binding, buffer] : buffers)
+	{
+		if (bindings.ranges.empty() || bindings.ranges.back().first_binding + to_u32(bindings.ranges.back().buffers.size()) != binding)
+		{
+			bindings.ranges.push_back({binding, {}, {}});
+		}
+		bindings.ranges.back().buffers.emplace_back(std::cref(*buffer));
+		bindings.ranges.back().offsets.push_back(0);
+	}
+
+	return bindings;
+}
+
+void SubMesh::prepare_vertex_input_bindings(size_t shader_id, const std::vector<ShaderResource> &shader_resources)
+{
+	if (!get_vertex_input_bindings(shader_id))
+	{
+		vertex_input_bindings.push_back(create_vertex_input_bindings(shader_id, shader_resources));
+	}
+}
+
+const VertexInputBindings *SubMesh::get_vertex_input_bindings(size_t shader_id) const
+{
+	auto it = std::find_if(vertex_input_bindings.begin(), vertex_input_bindings.end(), [shader_id](auto const &bindings) { return bindings.shader_id == shader_id; });
+	return it != vertex_input_bindings.end() ? &*it : nullptr;
+}
+
 void SubMesh::set_material(const Material &new_material)
 {
 	material = &new_material;
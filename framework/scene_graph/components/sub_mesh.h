@@ -17,15 +17,18 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
 #include <vector>
 
+#include "common/glm_common.h"
 #include "common/vk_common.h"
 #include "core/buffer.h"
 #include "core/shader_module.h"
+#include "rendering/pipeline_state.h"
 #include "scene_graph/component.h"
 
 namespace vkb
@@ -43,6 +46,28 @@ struct VertexAttribute
 	std::uint32_t offset = 0;
 };
 
+/**
+ * @brief Vertex input state and vertex buffer bindings of a submesh, resolved for one vertex shader
+ */
+struct VertexInputBindings
+{
+	/// A range of consecutive vertex buffer bindings, bound with a single command
+	struct Range
+	{
+		std::uint32_t first_binding = 0;
+
+		std::vector<std::reference_wrapper<const vkb::core::BufferC>> buffers;
+
+		std::vector<VkDeviceSize> offsets;
+	};
+
+	size_t shader_id = 0;
+
+	vkb::rendering::VertexInputStateC vertex_input_state;
+
+	std::vector<Range> ranges;
+};
+
 class SubMesh : public Component
 {
   public:
@@ -71,10 +96,42 @@ class SubMesh : public Component
 
 	std::unique_ptr<vkb::core::BufferC> index_buffer;
 
+	/// Vertex buffer holding all attributes interleaved, either owned by this submesh or shared with other submeshes
+	/// If set, all attributes are read from binding 0 of this buffer, and vertex_buffers is empty
+	std::shared_ptr<vkb::core::BufferC> interleaved_vertex_buffer;
+
+	/// Offset of the vertices of this submesh in the interleaved vertex buffer
+	VkDeviceSize interleaved_vertex_offset = 0;
+
+	/// Restores model space positions from positions quantized relative to the bounding box of this submesh:
+	/// position = quantized_position * position_scale + position_bias. Identity unless positions are quantized
+	glm::vec3 position_scale{1.0f};
+
+	glm::vec3 position_bias{0.0f};
+
 	void set_attribute(const std::string &name, const VertexAttribute &attribute);
 
 	bool get_attribute(const std::string &name, VertexAttribute &attribute) const;
 
+	/**
+	 * @brief Matches the vertex attributes and buffers of this submesh to the inputs of a vertex shader
+	 * @param shader_id The id of the vertex shader module
+	 * @param shader_resources The resources of the vertex shader module, only inputs are considered
+	 * @return The vertex input state and the vertex buffers to bind
+	 */
+	VertexInputBindings create_vertex_input_bindings(size_t shader_id, const std::vector<ShaderResource> &shader_resources) const;
+
+	/**
+	 * @brief Resolves and stores the vertex input bindings for a vertex shader, so drawing does not need to look up attributes by name
+	 *        Not thread safe, call it while preparing the subpass
+	 */
+	void prepare_vertex_input_bindings(size_t shader_id, const std::vector<ShaderResource> &shader_resources);
+
+	/**
+	 * @return The vertex input bindings prepared for a vertex shader, or nullptr if they have not been prepared
+	 */
+	const VertexInputBindings *get_vertex_input_bindings(size_t shader_id) const;
+
 	void set_material(const Material &material);
 
 	const Material *get_material() const;
@@ -86,6 +143,9 @@ class SubMesh : public Component
   private:
 	std::unordered_map<std::string, VertexAttribute> vertex_attributes;
 
+	// Usually holds a single entry, as a submesh is drawn with few vertex shaders
+	std::vector<VertexInputBindings> vertex_input_bindings;
+
 	const Material *material{nullptr};
 
 	ShaderVariant shader_variant;
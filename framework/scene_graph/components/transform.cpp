@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -21,6 +21,7 @@
 #include <glm/gtx/matrix_decompose.hpp>
 
 #include "scene_graph/node.h"
+#include "scene_graph/transform_hierarchy.h"
 
 namespace vkb
 {
@@ -95,6 +96,11 @@ glm::mat4 Transform::get_matrix() const
 
 glm::mat4 Transform::get_world_matrix()
 {
+	if (hierarchy && !hierarchy->is_invalid())
+	{
+		return hierarchy->get_world_matrix(hierarchy_index);
+	}
+
 	update_world_transform();
 
 	return world_matrix;
@@ -103,6 +109,19 @@ glm::mat4 Transform::get_world_matrix()
 void Transform::invalidate_world_matrix()
 {
 	update_world_matrix = true;
+
+	if (hierarchy)
+	{
+		hierarchy->mark_dirty(hierarchy_index);
+	}
+}
+
+void Transform::invalidate_hierarchy()
+{
+	if (hierarchy)
+	{
+		hierarchy->invalidate();
+	}
 }
 
 void Transform::update_world_transform()
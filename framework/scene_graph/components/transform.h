@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -40,8 +40,12 @@ using NodeC = Node<vkb::BindingType::C>;
 
 namespace sg
 {
+class TransformHierarchy;
+
 class Transform : public Component
 {
+	friend class TransformHierarchy;
+
   public:
 	Transform(vkb::scene_graph::NodeC &node);
 
@@ -67,6 +71,12 @@ class Transform : public Component
 
 	glm::mat4 get_matrix() const;
 
+	/**
+	 * @brief Returns the world matrix. For a transform registered in a hierarchy, this is the matrix computed by the last
+	 *        TransformHierarchy::update, which Scene::update_transforms runs once per frame, with any change made since
+	 *        then applied on the fly. It does not update the hierarchy, so concurrent reads are safe while no thread
+	 *        updates it or changes a transform.
+	 */
 	glm::mat4 get_world_matrix();
 
 	/**
@@ -76,6 +86,12 @@ class Transform : public Component
 	 */
 	void invalidate_world_matrix();
 
+	/**
+	 * @brief Marks the transform hierarchy this transform is registered in for a rebuild,
+	 *        after the parent of the node changed.
+	 */
+	void invalidate_hierarchy();
+
   private:
 	vkb::scene_graph::NodeC &node;
 
@@ -89,6 +105,11 @@ class Transform : public Component
 
 	bool update_world_matrix = false;
 
+	// The flattened hierarchy holding the world matrix, if the node is part of one
+	TransformHierarchy *hierarchy = nullptr;
+
+	uint32_t hierarchy_index = 0;
+
 	void update_world_transform();
 };
 
@@ -81,6 +81,8 @@ inline void Node<bindingType>::add_child(Node<bindingType> &child)
 	{
 		children.push_back(reinterpret_cast<vkb::scene_graph::NodeCpp *>(&child));
 	}
+
+	transform.invalidate_hierarchy();
 }
 
 template <vkb::BindingType bindingType>
@@ -172,6 +174,7 @@ inline void Node<bindingType>::set_parent(Node<bindingType> &p)
 	}
 
 	transform.invalidate_world_matrix();
+	transform.invalidate_hierarchy();
 }
 }        // namespace scene_graph
 }        // namespace vkb
@@ -18,6 +18,10 @@
 
 #pragma once
 
+#include <queue>
+#include <span>
+#include <tuple>
+
 #include "scene_graph/component.h"
 #include "scene_graph/components/camera.h"
 #include "scene_graph/components/hpp_mesh.h"
@@ -26,6 +30,7 @@
 #include "scene_graph/components/sub_mesh.h"
 #include "scene_graph/node.h"
 #include "scene_graph/scripts/animation.h"
+#include "scene_graph/transform_hierarchy.h"
 
 namespace vkb
 {
@@ -33,6 +38,17 @@ namespace scene_graph
 {
 
 /// @brief A collection of nodes organized in a tree structure.
+///
+/// Components are queried as spans over per-type pointer arrays, so queries don't allocate. A span stays valid until
+/// components of the same type are added, cleared or set, as add_component may reallocate the array it refers to. Any
+/// change to the components or nodes bumps the generation, which callers can compare against a stored value to know
+/// when their cached query results are stale.
+///
+/// find_node returns the node a breadth-first walk from the children of the root finds first. Unique names are looked up
+/// in an index instead of walking the tree.
+///
+/// The transforms of all nodes below the root are kept in a flattened hierarchy, which update_transforms refreshes once
+/// per frame, so world matrix queries only walk up the tree for transforms changed since the last refresh.
 template <vkb::BindingType bindingType>
 class Scene
 {
@@ -49,9 +65,11 @@ class Scene
 	void                                 clear_components();
 	vkb::scene_graph::Node<bindingType> *find_node(std::string const &name);
 	template <class T>
-	std::vector<T *>                     get_components() const;
+	std::span<T *const>                  get_components() const;
+	uint64_t                             get_generation() const;
 	std::string const                   &get_name() const;
 	vkb::scene_graph::Node<bindingType> &get_root_node();
+	vkb::sg::TransformHierarchy const   &get_transform_hierarchy() const;
 	template <class T>
 	bool has_component() const;
 	template <class T>
@@ -59,18 +77,45 @@ class Scene
 	void set_name(std::string const &name);
 	void set_nodes(std::vector<std::unique_ptr<vkb::scene_graph::Node<bindingType>>> &&nodes);
 	void set_root_node(vkb::scene_graph::Node<bindingType> &node);
+	void update_transforms();
 
   private:
+	template <class T>
+	void                                 append_component_pointer(std::vector<T *> &pointers, std::type_index const &type_index, vkb::sg::Component *component);
+	vkb::scene_graph::NodeCpp           *find_node_breadth_first(std::string const &name);
 	template <typename T>
-	std::type_index get_type_index() const;
-	bool            has_component(std::type_index const &type_info) const;
-	std::type_index map_type_index(std::type_index ti) const;
+	std::type_index                      get_type_index() const;
+	bool                                 has_component(std::type_index const &type_info) const;
+	void                                 index_node(vkb::scene_graph::NodeCpp &node);
+	bool                                 is_below_root(vkb::scene_graph::NodeCpp &node) const;
+	std::type_index                      map_type_index(std::type_index ti) const;
+	template <class T>
+	void                                 reset_component_pointers(std::vector<T *> &pointers, std::type_index const &type_index);
+	void                                 update_component_pointers(std::type_index const &type_index);
 
   private:
+	// One pointer array per type accepted by get_type_index, returned as span by get_components. The arrays are typed, so a
+	// span never accesses a Component pointer through a pointer of another type
+	using ComponentPointers = std::tuple<std::vector<vkb::scene_graph::components::HPPMesh *>,
+	                                     std::vector<vkb::scene_graph::components::SamplerC *>,
+	                                     std::vector<vkb::sg::Animation *>,
+	                                     std::vector<vkb::sg::Camera *>,
+	                                     std::vector<vkb::sg::Image *>,
+	                                     std::vector<vkb::sg::Light *>,
+	                                     std::vector<vkb::sg::Mesh *>,
+	                                     std::vector<vkb::sg::PBRMaterial *>,
+	                                     std::vector<vkb::sg::Script *>,
+	                                     std::vector<vkb::sg::SubMesh *>,
+	                                     std::vector<vkb::sg::Texture *>>;
+
+	ComponentPointers                                                                     component_pointers;
 	std::unordered_map<std::type_index, std::vector<std::unique_ptr<vkb::sg::Component>>> components;
+	uint64_t                                                                              generation = 0;
 	std::string                                                                           name;
-	std::vector<std::unique_ptr<vkb::scene_graph::NodeCpp>>                               nodes;        // List of all the nodes
+	std::unordered_map<std::string, std::vector<vkb::scene_graph::NodeCpp *>>             node_index;        // All nodes with each name
+	std::vector<std::unique_ptr<vkb::scene_graph::NodeCpp>>                               nodes;             // List of all the nodes
 	vkb::scene_graph::NodeCpp                                                            *root = nullptr;
+	vkb::sg::TransformHierarchy                                                           transform_hierarchy;        // Destroyed before the nodes it refers to
 };
 
 using SceneC   = Scene<vkb::BindingType::C>;
@@ -94,6 +139,8 @@ inline void Scene<bindingType>::add_child(vkb::scene_graph::Node<bindingType> &c
 	{
 		root->add_child(reinterpret_cast<vkb::scene_graph::NodeCpp &>(child));
 	}
+	transform_hierarchy.invalidate();
+	++generation;
 }
 
 template <vkb::BindingType bindingType>
@@ -101,7 +148,10 @@ inline void Scene<bindingType>::add_component(std::unique_ptr<vkb::sg::Component
 {
 	if (component)
 	{
-		components[map_type_index(component->get_type())].push_back(std::move(component));
+		auto type_index = map_type_index(component->get_type());
+		std::apply([&](auto &...pointers) { (append_component_pointer(pointers, type_index, component.get()), ...); }, component_pointers);
+		components[type_index].push_back(std::move(component));
+		++generation;
 	}
 }
 
@@ -112,6 +162,17 @@ inline void Scene<bindingType>::add_component(std::unique_ptr<vkb::sg::Component
 	add_component(std::move(component));
 }
 
+template <vkb::BindingType bindingType>
+template <class T>
+inline void Scene<bindingType>::append_component_pointer(std::vector<T *> &pointers, std::type_index const &type_index, vkb::sg::Component *component)
+{
+	if (get_type_index<T>() == type_index)
+	{
+		// The C and C++ binding types of a component share one storage, so the pointer is reinterpreted
+		pointers.push_back(reinterpret_cast<T *>(component));
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline void Scene<bindingType>::add_node(std::unique_ptr<vkb::scene_graph::Node<bindingType>> &&n)
 {
@@ -123,6 +184,9 @@ inline void Scene<bindingType>::add_node(std::unique_ptr<vkb::scene_graph::Node<
 	{
 		nodes.push_back(std::unique_ptr<vkb::scene_graph::NodeCpp>(reinterpret_cast<vkb::scene_graph::NodeCpp *>(n.release())));
 	}
+	index_node(*nodes.back());
+	transform_hierarchy.invalidate();
+	++generation;
 }
 
 template <vkb::BindingType bindingType>
@@ -130,10 +194,42 @@ template <class T>
 inline void Scene<bindingType>::clear_components()
 {
 	components[get_type_index<T>()].clear();
+	update_component_pointers(get_type_index<T>());
+	++generation;
 }
 
 template <vkb::BindingType bindingType>
 inline vkb::scene_graph::Node<bindingType> *Scene<bindingType>::find_node(std::string const &node_name)
+{
+	auto it = node_index.find(node_name);
+	if (it == node_index.end())
+	{
+		return nullptr;
+	}
+
+	// A unique name is resolved from the index, otherwise the tree is walked to find the same node as before
+	vkb::scene_graph::NodeCpp *node = nullptr;
+	if (it->second.size() == 1)
+	{
+		node = is_below_root(*it->second.front()) ? it->second.front() : nullptr;
+	}
+	else
+	{
+		node = find_node_breadth_first(node_name);
+	}
+
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return node;
+	}
+	else
+	{
+		return reinterpret_cast<vkb::scene_graph::NodeC *>(node);
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline vkb::scene_graph::NodeCpp *Scene<bindingType>::find_node_breadth_first(std::string const &node_name)
 {
 	assert(root);
 
@@ -149,14 +245,7 @@ inline vkb::scene_graph::Node<bindingType> *Scene<bindingType>::find_node(std::s
 
 			if (node->get_name() == node_name)
 			{
-				if constexpr (bindingType == vkb::BindingType::Cpp)
-				{
-					return node;
-				}
-				else
-				{
-					return reinterpret_cast<vkb::scene_graph::NodeC *>(node);
-				}
+				return node;
 			}
 
 			for (auto child_node : node->get_children())
@@ -171,21 +260,15 @@ inline vkb::scene_graph::Node<bindingType> *Scene<bindingType>::find_node(std::s
 
 template <vkb::BindingType bindingType>
 template <class T>
-inline std::vector<T *> Scene<bindingType>::get_components() const
+inline std::span<T *const> Scene<bindingType>::get_components() const
 {
-	std::vector<T *> result;
-	if (has_component(get_type_index<T>()))
-	{
-		auto &scene_components = components.at(get_type_index<T>());
-
-		result.resize(scene_components.size());
-		std::transform(scene_components.begin(), scene_components.end(), result.begin(),
-		               [](std::unique_ptr<vkb::sg::Component> const &component) -> T * {
-			               return reinterpret_cast<T *>(component.get());
-		               });
-	}
+	return std::get<std::vector<T *>>(component_pointers);
+}
 
-	return result;
+template <vkb::BindingType bindingType>
+inline uint64_t Scene<bindingType>::get_generation() const
+{
+	return generation;
 }
 
 template <vkb::BindingType bindingType>
@@ -207,6 +290,12 @@ inline vkb::scene_graph::Node<bindingType> &Scene<bindingType>::get_root_node()
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline vkb::sg::TransformHierarchy const &Scene<bindingType>::get_transform_hierarchy() const
+{
+	return transform_hierarchy;
+}
+
 template <vkb::BindingType bindingType>
 template <class T>
 inline bool Scene<bindingType>::has_component() const
@@ -241,6 +330,26 @@ inline bool Scene<bindingType>::has_component(std::type_index const &type_info)
 	return (component != components.end() && !component->second.empty());
 }
 
+template <vkb::BindingType bindingType>
+inline void Scene<bindingType>::index_node(vkb::scene_graph::NodeCpp &node)
+{
+	node_index[node.get_name()].push_back(&node);
+}
+
+template <vkb::BindingType bindingType>
+inline bool Scene<bindingType>::is_below_root(vkb::scene_graph::NodeCpp &node) const
+{
+	// The root itself is not searched, like in a walk starting from its children
+	for (auto parent = node.get_parent(); parent; parent = parent->get_parent())
+	{
+		if (parent == root)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 // map type_index from C-type to C++-type
 template <vkb::BindingType bindingType>
 inline std::type_index Scene<bindingType>::map_type_index(std::type_index ti) const
@@ -259,6 +368,25 @@ inline std::type_index Scene<bindingType>::map_type_index(std::type_index ti) co
 	}
 }
 
+template <vkb::BindingType bindingType>
+template <class T>
+inline void Scene<bindingType>::reset_component_pointers(std::vector<T *> &pointers, std::type_index const &type_index)
+{
+	if (get_type_index<T>() == type_index)
+	{
+		pointers.clear();
+
+		auto it = components.find(type_index);
+		if (it != components.end())
+		{
+			for (auto &component : it->second)
+			{
+				pointers.push_back(reinterpret_cast<T *>(component.get()));
+			}
+		}
+	}
+}
+
 template <vkb::BindingType bindingType>
 template <class T>
 inline void Scene<bindingType>::set_components(std::vector<std::unique_ptr<T>> &&new_components)
@@ -269,6 +397,8 @@ inline void Scene<bindingType>::set_components(std::vector<std::unique_ptr<T>> &
 		                       return std::unique_ptr<vkb::sg::Component>(std::move(component));
 	                       });
 	components[get_type_index<T>()] = std::move(result);
+	update_component_pointers(get_type_index<T>());
+	++generation;
 }
 
 template <vkb::BindingType bindingType>
@@ -293,6 +423,15 @@ inline void Scene<bindingType>::set_nodes(std::vector<std::unique_ptr<vkb::scene
 			nodes.push_back(std::unique_ptr<vkb::scene_graph::NodeCpp>(reinterpret_cast<vkb::scene_graph::NodeCpp *>(node.release())));
 		}
 	}
+
+	node_index.clear();
+	node_index.reserve(nodes.size());
+	for (auto &node : nodes)
+	{
+		index_node(*node);
+	}
+	transform_hierarchy.invalidate();
+	++generation;
 }
 
 template <vkb::BindingType bindingType>
@@ -306,6 +445,30 @@ inline void Scene<bindingType>::set_root_node(vkb::scene_graph::Node<bindingType
 	{
 		root = reinterpret_cast<vkb::scene_graph::NodeCpp *>(&node);
 	}
+	transform_hierarchy.invalidate();
+	++generation;
+}
+
+template <vkb::BindingType bindingType>
+inline void Scene<bindingType>::update_component_pointers(std::type_index const &type_index)
+{
+	std::apply([&](auto &...pointers) { (reset_component_pointers(pointers, type_index), ...); }, component_pointers);
+}
+
+template <vkb::BindingType bindingType>
+inline void Scene<bindingType>::update_transforms()
+{
+	if (!root)
+	{
+		return;
+	}
+
+	if (transform_hierarchy.is_invalid())
+	{
+		transform_hierarchy.build(*root);
+	}
+
+	transform_hierarchy.update();
 }
 
 }        // namespace scene_graph
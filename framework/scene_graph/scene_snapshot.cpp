@@ -0,0 +1,135 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_snapshot.h"
+
+#include <algorithm>
+
+#include "scene_graph/components/camera.h"
+#include "scene_graph/components/hpp_mesh.h"
+#include "scene_graph/node.h"
+#include "scene_graph/scene.h"
+
+namespace vkb
+{
+namespace sg
+{
+void SceneSnapshot::extract(vkb::scene_graph::SceneCpp &scene)
+{
+	clear();
+
+	for (auto mesh : scene.get_components<vkb::scene_graph::components::HPPMesh>())
+	{
+		for (auto node : mesh->get_nodes())
+		{
+			auto &transform = node->get_transform();
+			auto &scale     = transform.get_scale();
+
+			node_instances.try_emplace(node, mesh_instances.size());
+			mesh_instances.push_back({.mesh         = mesh,
+			                          .node         = node,
+			                          .world_matrix = transform.get_world_matrix(),
+			                          .flipped      = scale.x * scale.y * scale.z < 0});
+		}
+	}
+
+	for (auto camera : scene.get_components<Camera>())
+	{
+		if (camera->get_node())
+		{
+			cameras.push_back(capture_camera(*camera));
+		}
+	}
+
+	for (auto light : scene.get_components<Light>())
+	{
+		lights.push_back(capture_light(*light));
+	}
+}
+
+void SceneSnapshot::clear()
+{
+	mesh_instances.clear();
+	cameras.clear();
+	lights.clear();
+	node_instances.clear();
+}
+
+SceneSnapshot::CameraState SceneSnapshot::capture_camera(Camera &camera)
+{
+	return {.camera       = &camera,
+	        .view         = camera.get_view(),
+	        .projection   = camera.get_projection(),
+	        .pre_rotation = camera.get_pre_rotation(),
+	        .world_matrix = camera.get_node()->get_transform().get_world_matrix()};
+}
+
+SceneSnapshot::LightInstance SceneSnapshot::capture_light(Light &light)
+{
+	auto &transform = light.get_node()->get_transform();
+
+	return {.light       = &light,
+	        .type        = light.get_light_type(),
+	        .properties  = light.get_properties(),
+	        .translation = transform.get_translation(),
+	        .rotation    = transform.get_rotation()};
+}
+
+SceneSnapshot::MeshInstance const *SceneSnapshot::find_mesh_instance(vkb::scene_graph::NodeCpp const &node) const
+{
+	auto it = node_instances.find(&node);
+	return it != node_instances.end() ? &mesh_instances[it->second] : nullptr;
+}
+
+SceneSnapshot::CameraState const *SceneSnapshot::find_camera(Camera const &camera) const
+{
+	auto it = std::ranges::find(cameras, &camera, &CameraState::camera);
+	return it != cameras.end() ? &*it : nullptr;
+}
+
+SceneSnapshot::LightInstance const *SceneSnapshot::find_light(Light const &light) const
+{
+	auto it = std::ranges::find(lights, &light, &LightInstance::light);
+	return it != lights.end() ? &*it : nullptr;
+}
+
+std::span<SceneSnapshot::CameraState const> SceneSnapshot::get_cameras() const
+{
+	return cameras;
+}
+
+std::span<SceneSnapshot::LightInstance const> SceneSnapshot::get_lights() const
+{
+	return lights;
+}
+
+std::span<SceneSnapshot::MeshInstance const> SceneSnapshot::get_mesh_instances() const
+{
+	return mesh_instances;
+}
+
+uint64_t SceneSnapshot::get_frame_index() const
+{
+	return frame_index;
+}
+
+void SceneSnapshot::set_frame_index(uint64_t frame_index_)
+{
+	frame_index = frame_index_;
+}
+}        // namespace sg
+}        // namespace vkb
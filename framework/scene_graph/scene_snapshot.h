@@ -0,0 +1,157 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "common/glm_common.h"
+#include "common/vk_common.h"
+#include "scene_graph/components/light.h"
+
+namespace vkb
+{
+namespace scene_graph
+{
+template <vkb::BindingType bindingType>
+class Node;
+using NodeCpp = Node<vkb::BindingType::Cpp>;
+
+template <vkb::BindingType bindingType>
+class Scene;
+using SceneCpp = Scene<vkb::BindingType::Cpp>;
+
+namespace components
+{
+class HPPMesh;
+}
+}        // namespace scene_graph
+
+namespace sg
+{
+class Camera;
+
+/**
+ * @brief Copy of the scene state read while recording a frame
+ *
+ * A snapshot holds the world matrices of the mesh nodes, the matrices of the cameras and the lights, as they were
+ * at the end of a scene update. Recording from a snapshot does not read the transforms of the scene, which can
+ * then be updated for the next frame at the same time. Meshes, materials and textures are referenced, not copied,
+ * as they are not changed by scene updates.
+ */
+class SceneSnapshot
+{
+  public:
+	struct MeshInstance
+	{
+		vkb::scene_graph::components::HPPMesh *mesh = nullptr;
+
+		vkb::scene_graph::NodeCpp *node = nullptr;
+
+		glm::mat4 world_matrix{1.0f};
+
+		// Whether the scale of the node mirrors the mesh, which inverts its front face
+		bool flipped = false;
+	};
+
+	struct CameraState
+	{
+		Camera const *camera = nullptr;
+
+		glm::mat4 view{1.0f};
+
+		glm::mat4 projection{1.0f};
+
+		glm::mat4 pre_rotation{1.0f};
+
+		glm::mat4 world_matrix{1.0f};
+	};
+
+	struct LightInstance
+	{
+		Light const *light = nullptr;
+
+		LightType type = LightType::Directional;
+
+		LightProperties properties;
+
+		glm::vec3 translation{0.0f};
+
+		glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+	};
+
+	/**
+	 * @brief Copies the state of a scene whose transforms are up to date, reusing the storage of the previous extraction
+	 */
+	void extract(vkb::scene_graph::SceneCpp &scene);
+
+	void clear();
+
+	/**
+	 * @brief Captures the state of a camera, as it is stored in a snapshot
+	 */
+	static CameraState capture_camera(Camera &camera);
+
+	/**
+	 * @brief Captures the state of a light, as it is stored in a snapshot
+	 */
+	static LightInstance capture_light(Light &light);
+
+	/**
+	 * @return The first instance of the meshes of a node, or nullptr if the node has no mesh in the snapshot
+	 */
+	MeshInstance const *find_mesh_instance(vkb::scene_graph::NodeCpp const &node) const;
+
+	/**
+	 * @return The state of a camera, or nullptr if the camera is not part of the snapshot
+	 */
+	CameraState const *find_camera(Camera const &camera) const;
+
+	/**
+	 * @return The state of a light, or nullptr if the light is not part of the snapshot
+	 */
+	LightInstance const *find_light(Light const &light) const;
+
+	std::span<CameraState const> get_cameras() const;
+
+	std::span<LightInstance const> get_lights() const;
+
+	std::span<MeshInstance const> get_mesh_instances() const;
+
+	/**
+	 * @return Number of snapshots extracted before this one, which identifies the simulated frame
+	 */
+	uint64_t get_frame_index() const;
+
+	void set_frame_index(uint64_t frame_index);
+
+  private:
+	std::vector<MeshInstance> mesh_instances;
+
+	std::vector<CameraState> cameras;
+
+	std::vector<LightInstance> lights;
+
+	// First mesh instance of each node
+	std::unordered_map<vkb::scene_graph::NodeCpp const *, size_t> node_instances;
+
+	uint64_t frame_index = 0;
+};
+}        // namespace sg
+}        // namespace vkb
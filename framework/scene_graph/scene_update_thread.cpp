@@ -0,0 +1,149 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_update_thread.h"
+
+#include <utility>
+
+#include "core/util/logging.hpp"
+#include "scene_graph/scene.h"
+#include "timer.h"
+
+namespace vkb
+{
+namespace sg
+{
+SceneUpdateThread::SceneUpdateThread(vkb::scene_graph::SceneCpp &scene, UpdateFunc &&update_func) :
+    scene{scene}, update_func{std::move(update_func)}
+{
+	snapshots[front].extract(scene);
+	snapshots[front].set_frame_index(frame_index++);
+
+	thread = std::thread(&SceneUpdateThread::thread_loop, this);
+}
+
+SceneUpdateThread::~SceneUpdateThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stop_thread = true;
+	}
+	start_condition.notify_one();
+	thread.join();
+
+	if (thread_exception)
+	{
+		LOGE("Scene update thread stopped with an error");
+	}
+}
+
+void SceneUpdateThread::start(float delta_time)
+{
+	wait();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending_delta_time = delta_time;
+		updating           = true;
+	}
+	start_condition.notify_one();
+}
+
+void SceneUpdateThread::wait()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	done_condition.wait(lock, [this] { return !updating; });
+
+	if (thread_exception)
+	{
+		std::rethrow_exception(std::exchange(thread_exception, nullptr));
+	}
+}
+
+SceneSnapshot const &SceneUpdateThread::acquire()
+{
+	Timer timer;
+	timer.start();
+
+	wait();
+
+	statistics.wait_time_ms = timer.stop<Timer::Milliseconds>();
+
+	// The simulation thread is idle, so the snapshots can be swapped without locking
+	if (back_ready)
+	{
+		front      = 1 - front;
+		back_ready = false;
+	}
+
+	return snapshots[front];
+}
+
+SceneSnapshot const &SceneUpdateThread::get_front_snapshot() const
+{
+	return snapshots[front];
+}
+
+SceneUpdateThread::Statistics const &SceneUpdateThread::get_statistics() const
+{
+	return statistics;
+}
+
+void SceneUpdateThread::thread_loop()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		start_condition.wait(lock, [this] { return stop_thread || updating; });
+		if (!updating)
+		{
+			break;
+		}
+
+		float delta_time = pending_delta_time;
+		lock.unlock();
+
+		Timer timer;
+		timer.start();
+
+		auto &back = snapshots[1 - front];
+
+		try
+		{
+			update_func(delta_time);
+
+			back.extract(scene);
+			back.set_frame_index(frame_index++);
+		}
+		catch (...)
+		{
+			lock.lock();
+			thread_exception = std::current_exception();
+			lock.unlock();
+		}
+
+		double update_time_ms = timer.stop<Timer::Milliseconds>();
+
+		lock.lock();
+		back_ready                = !thread_exception;
+		statistics.update_time_ms = update_time_ms;
+		updating                  = false;
+		done_condition.notify_all();
+	}
+}
+}        // namespace sg
+}        // namespace vkb
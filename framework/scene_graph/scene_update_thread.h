@@ -0,0 +1,135 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "scene_graph/scene_snapshot.h"
+
+namespace vkb
+{
+namespace sg
+{
+/**
+ * @brief Updates a scene on a simulation thread, extracting each update into a snapshot
+ *
+ * The thread runs the update function, which must leave the transforms of the scene up to date, then extracts the
+ * scene into the back snapshot. Acquiring waits for the update in flight and swaps the snapshots, the front one then
+ * stays unchanged until the next acquisition, and matches the scene until the next update is started.
+ *
+ * While an update is in flight, the scene must not be accessed by other threads, apart from reading the meshes,
+ * materials and textures which updates do not change. Starting an update once the frame reading the scene is submitted
+ * lets it overlap the presentation and the wait for the next frame.
+ */
+class SceneUpdateThread
+{
+  public:
+	using UpdateFunc = std::function<void(float delta_time)>;
+
+	/**
+	 * @brief Timing of the last update, in milliseconds
+	 */
+	struct Statistics
+	{
+		double update_time_ms = 0.0;        // Scene update and extraction on the simulation thread
+		double wait_time_ms   = 0.0;        // Time the last acquisition blocked on the update in flight
+	};
+
+	/**
+	 * @brief Starts the simulation thread, and extracts the current state of the scene into the front snapshot
+	 * @param scene The scene to update, its transforms must be up to date
+	 * @param update_func Function updating the scene, called on the simulation thread
+	 */
+	SceneUpdateThread(vkb::scene_graph::SceneCpp &scene, UpdateFunc &&update_func);
+
+	SceneUpdateThread(const SceneUpdateThread &) = delete;
+
+	SceneUpdateThread(SceneUpdateThread &&) = delete;
+
+	/**
+	 * @brief Waits for the update in flight and stops the simulation thread
+	 */
+	~SceneUpdateThread();
+
+	SceneUpdateThread &operator=(const SceneUpdateThread &) = delete;
+
+	SceneUpdateThread &operator=(SceneUpdateThread &&) = delete;
+
+	/**
+	 * @brief Starts the update of the next frame on the simulation thread, waiting for the update in flight first
+	 */
+	void start(float delta_time);
+
+	/**
+	 * @brief Blocks until the update in flight completes, and rethrows its errors
+	 */
+	void wait();
+
+	/**
+	 * @brief Waits for the update in flight, and makes the snapshot it extracted the front snapshot
+	 * @return The front snapshot, unchanged until the next acquisition
+	 */
+	SceneSnapshot const &acquire();
+
+	SceneSnapshot const &get_front_snapshot() const;
+
+	Statistics const &get_statistics() const;
+
+  private:
+	void thread_loop();
+
+	vkb::scene_graph::SceneCpp &scene;
+
+	UpdateFunc update_func;
+
+	std::array<SceneSnapshot, 2> snapshots;
+
+	// Index of the snapshot read while recording, the other one is written by the simulation thread
+	size_t front = 0;
+
+	// Whether the back snapshot holds an update which was not acquired yet
+	bool back_ready = false;
+
+	uint64_t frame_index = 0;
+
+	Statistics statistics;
+
+	// Guards the state shared with the simulation thread
+	std::mutex mutex;
+
+	std::condition_variable start_condition;
+
+	std::condition_variable done_condition;
+
+	float pending_delta_time = 0.0f;
+
+	bool updating = false;
+
+	bool stop_thread = false;
+
+	std::exception_ptr thread_exception;
+
+	std::thread thread;
+};
+}        // namespace sg
+}        // namespace vkb
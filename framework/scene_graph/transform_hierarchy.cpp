@@ -0,0 +1,479 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transform_hierarchy.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	include <xmmintrin.h>
+#	define VKB_TRANSFORM_SSE
+#elif defined(__ARM_NEON)
+#	include <arm_neon.h>
+#	define VKB_TRANSFORM_NEON
+#endif
+
+#include "common/helpers.h"
+#include "scene_graph/components/transform.h"
+#include "scene_graph/node.h"
+#include "timer.h"
+
+namespace vkb
+{
+namespace sg
+{
+namespace
+{
+constexpr uint8_t DIRTY_LOCAL  = 1;        // The local transform changed
+constexpr uint8_t DIRTY_PARENT = 2;        // The world matrix of the parent changed
+
+constexpr uint32_t CLEAN = ~0u;
+
+// Smallest number of nodes handed to a thread
+constexpr uint32_t MIN_CHUNK_SIZE = 1024;
+
+/**
+ * @brief Column major 4x4 matrix multiply, result = a * b
+ */
+inline void multiply(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &result)
+{
+#if defined(VKB_TRANSFORM_SSE)
+	const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+	const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+	const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+	const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+
+	for (glm::length_t column = 0; column < 4; ++column)
+	{
+		__m128 r = _mm_mul_ps(a0, _mm_set1_ps(b[column][0]));
+		r        = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b[column][1])));
+		r        = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b[column][2])));
+		r        = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b[column][3])));
+		_mm_storeu_ps(&result[column][0], r);
+	}
+#elif defined(VKB_TRANSFORM_NEON)
+	const float32x4_t a0 = vld1q_f32(&a[0][0]);
+	const float32x4_t a1 = vld1q_f32(&a[1][0]);
+	const float32x4_t a2 = vld1q_f32(&a[2][0]);
+	const float32x4_t a3 = vld1q_f32(&a[3][0]);
+
+	for (glm::length_t column = 0; column < 4; ++column)
+	{
+		float32x4_t r = vmulq_n_f32(a0, b[column][0]);
+		r             = vmlaq_n_f32(r, a1, b[column][1]);
+		r             = vmlaq_n_f32(r, a2, b[column][2]);
+		r             = vmlaq_n_f32(r, a3, b[column][3]);
+		vst1q_f32(&result[column][0], r);
+	}
+#else
+	result = a * b;
+#endif
+}
+}        // namespace
+
+/**
+ * @brief Persistent threads running the chunks of one level update at a time, together with the updating thread
+ */
+class TransformHierarchy::Workers
+{
+  public:
+	explicit Workers(uint32_t thread_count)
+	{
+		threads.reserve(thread_count);
+		for (uint32_t i = 0; i < thread_count; ++i)
+		{
+			threads.emplace_back(&Workers::worker_loop, this);
+		}
+	}
+
+	~Workers()
+	{
+		{
+			std::lock_guard<std::mutex> lock{mutex};
+			stopping = true;
+		}
+		job_condition.notify_all();
+
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	/**
+	 * @brief Calls job for each index in [0, count) and returns once all calls returned
+	 */
+	void run(uint32_t count, const std::function<void(uint32_t)> &job)
+	{
+		{
+			std::lock_guard<std::mutex> lock{mutex};
+			current_job   = &job;
+			job_count     = count;
+			next_job      = 0;
+			finished_jobs = 0;
+		}
+		job_condition.notify_all();
+
+		// The calling thread takes jobs as well, instead of waiting idle
+		execute_jobs();
+
+		std::unique_lock<std::mutex> lock{mutex};
+		done_condition.wait(lock, [this] { return finished_jobs == job_count; });
+		current_job = nullptr;
+	}
+
+  private:
+	void execute_jobs()
+	{
+		while (true)
+		{
+			const std::function<void(uint32_t)> *job = nullptr;
+			uint32_t                              index;
+			{
+				std::lock_guard<std::mutex> lock{mutex};
+				if (!current_job || next_job == job_count)
+				{
+					return;
+				}
+				job   = current_job;
+				index = next_job++;
+			}
+
+			(*job)(index);
+
+			std::lock_guard<std::mutex> lock{mutex};
+			if (++finished_jobs == job_count)
+			{
+				done_condition.notify_one();
+			}
+		}
+	}
+
+	void worker_loop()
+	{
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock{mutex};
+				job_condition.wait(lock, [this] { return stopping || (current_job && next_job < job_count); });
+
+				if (stopping)
+				{
+					return;
+				}
+			}
+
+			execute_jobs();
+		}
+	}
+
+	std::vector<std::thread> threads;
+
+	std::mutex mutex;
+
+	std::condition_variable job_condition;
+
+	std::condition_variable done_condition;
+
+	const std::function<void(uint32_t)> *current_job = nullptr;
+
+	uint32_t job_count = 0;
+
+	uint32_t next_job = 0;
+
+	uint32_t finished_jobs = 0;
+
+	bool stopping = false;
+};
+
+TransformHierarchy::TransformHierarchy(TransformHierarchy &&other)
+{
+	*this = std::move(other);
+}
+
+TransformHierarchy::~TransformHierarchy()
+{
+	clear();
+}
+
+TransformHierarchy &TransformHierarchy::operator=(TransformHierarchy &&other)
+{
+	if (this != &other)
+	{
+		clear();
+
+		transforms         = std::move(other.transforms);
+		parents            = std::move(other.parents);
+		node_levels        = std::move(other.node_levels);
+		level_offsets      = std::move(other.level_offsets);
+		local_matrices     = std::move(other.local_matrices);
+		world_matrices     = std::move(other.world_matrices);
+		dirty              = std::move(other.dirty);
+		first_dirty_level  = other.first_dirty_level;
+		invalid            = other.invalid;
+		parallel_threshold = other.parallel_threshold;
+		statistics         = other.statistics;
+		workers            = std::move(other.workers);
+
+		for (auto transform : transforms)
+		{
+			transform->hierarchy = this;
+		}
+
+		other.clear();
+	}
+
+	return *this;
+}
+
+void TransformHierarchy::build(vkb::scene_graph::NodeCpp &root)
+{
+	clear();
+
+	// Breadth-first traversal, one level at a time, with the index of each node's parent
+	std::vector<std::pair<vkb::scene_graph::NodeCpp *, uint32_t>> level_nodes{{&root, NO_PARENT}};
+	std::vector<std::pair<vkb::scene_graph::NodeCpp *, uint32_t>> next_level_nodes;
+
+	while (!level_nodes.empty())
+	{
+		level_offsets.push_back(to_u32(transforms.size()));
+
+		for (auto &[node, parent] : level_nodes)
+		{
+			auto index = to_u32(transforms.size());
+
+			auto &transform           = node->get_transform();
+			transform.hierarchy       = this;
+			transform.hierarchy_index = index;
+
+			transforms.push_back(&transform);
+			parents.push_back(parent);
+			node_levels.push_back(to_u32(level_offsets.size() - 1));
+
+			for (auto child : node->get_children())
+			{
+				next_level_nodes.emplace_back(child, index);
+			}
+		}
+
+		std::swap(level_nodes, next_level_nodes);
+		next_level_nodes.clear();
+	}
+
+	level_offsets.push_back(to_u32(transforms.size()));
+
+	local_matrices.resize(transforms.size());
+	world_matrices.resize(transforms.size());
+	dirty.assign(transforms.size(), DIRTY_LOCAL);
+
+	first_dirty_level = 0;
+	invalid           = false;
+
+	statistics.node_count  = to_u32(transforms.size());
+	statistics.level_count = to_u32(level_offsets.size() - 1);
+}
+
+void TransformHierarchy::clear()
+{
+	for (auto transform : transforms)
+	{
+		// Fall back to the lazy update in the transform
+		transform->hierarchy = nullptr;
+		transform->invalidate_world_matrix();
+	}
+
+	transforms.clear();
+	parents.clear();
+	node_levels.clear();
+	level_offsets.clear();
+	local_matrices.clear();
+	world_matrices.clear();
+	dirty.clear();
+
+	first_dirty_level = CLEAN;
+	invalid           = true;
+	statistics        = {};
+}
+
+void TransformHierarchy::update()
+{
+	if (first_dirty_level == CLEAN)
+	{
+		return;
+	}
+
+	Timer timer;
+	timer.start();
+
+	const auto thread_count = std::max(1u, std::thread::hardware_concurrency());
+	uint32_t   updated      = 0;
+
+	for (size_t level = first_dirty_level; level + 1 < level_offsets.size(); ++level)
+	{
+		uint32_t begin = level_offsets[level];
+		uint32_t end   = level_offsets[level + 1];
+		uint32_t count = end - begin;
+
+		uint32_t chunk_count = count >= parallel_threshold ? std::min(thread_count, std::max(1u, count / MIN_CHUNK_SIZE)) : 1;
+
+		if (chunk_count == 1)
+		{
+			updated += update_range(begin, end);
+			continue;
+		}
+
+		if (!workers)
+		{
+			workers = std::make_unique<Workers>(thread_count - 1);
+		}
+
+		// Nodes of a level only depend on the previous level, so chunks of it can be updated concurrently
+		uint32_t chunk_size = (count + chunk_count - 1) / chunk_count;
+
+		std::vector<uint32_t> chunk_updated(chunk_count, 0);
+		workers->run(chunk_count, [&](uint32_t chunk) {
+			uint32_t chunk_begin = begin + chunk * chunk_size;
+			if (chunk_begin < end)
+			{
+				chunk_updated[chunk] = update_range(chunk_begin, std::min(chunk_begin + chunk_size, end));
+			}
+		});
+
+		for (auto chunk : chunk_updated)
+		{
+			updated += chunk;
+		}
+	}
+
+	std::fill(dirty.begin() + level_offsets[first_dirty_level], dirty.end(), 0);
+	first_dirty_level = CLEAN;
+
+	statistics.updated_count  = updated;
+	statistics.update_time_ms = timer.stop<Timer::Milliseconds>();
+}
+
+void TransformHierarchy::mark_dirty(uint32_t index)
+{
+	assert(index < dirty.size());
+
+	dirty[index] |= DIRTY_LOCAL;
+	first_dirty_level = std::min(first_dirty_level, node_levels[index]);
+}
+
+void TransformHierarchy::invalidate()
+{
+	invalid = true;
+}
+
+bool TransformHierarchy::is_invalid() const
+{
+	return invalid;
+}
+
+glm::mat4 TransformHierarchy::get_world_matrix(uint32_t index) const
+{
+	assert(index < world_matrices.size());
+
+	if (first_dirty_level == CLEAN)
+	{
+		return world_matrices[index];
+	}
+
+	// Find the highest ancestor changed since the last update
+	uint32_t changed = NO_PARENT;
+	for (uint32_t i = index; i != NO_PARENT; i = parents[i])
+	{
+		if (dirty[i] & DIRTY_LOCAL)
+		{
+			changed = i;
+		}
+	}
+
+	if (changed == NO_PARENT)
+	{
+		return world_matrices[index];
+	}
+
+	// Compose the local matrices up to it on the fly, without writing anything
+	glm::mat4 world = transforms[index]->get_matrix();
+	for (uint32_t i = index; i != changed;)
+	{
+		i     = parents[i];
+		world = transforms[i]->get_matrix() * world;
+	}
+
+	if (parents[changed] != NO_PARENT)
+	{
+		world = world_matrices[parents[changed]] * world;
+	}
+
+	return world;
+}
+
+const TransformHierarchy::Statistics &TransformHierarchy::get_statistics() const
+{
+	return statistics;
+}
+
+void TransformHierarchy::set_parallel_threshold(uint32_t threshold)
+{
+	parallel_threshold = threshold;
+}
+
+uint32_t TransformHierarchy::update_range(uint32_t begin, uint32_t end)
+{
+	uint32_t updated = 0;
+
+	for (uint32_t index = begin; index < end; ++index)
+	{
+		uint32_t parent = parents[index];
+
+		if (parent != NO_PARENT && dirty[parent])
+		{
+			dirty[index] |= DIRTY_PARENT;
+		}
+
+		if (!dirty[index])
+		{
+			continue;
+		}
+
+		if (dirty[index] & DIRTY_LOCAL)
+		{
+			local_matrices[index] = transforms[index]->get_matrix();
+		}
+
+		if (parent == NO_PARENT)
+		{
+			world_matrices[index] = local_matrices[index];
+		}
+		else
+		{
+			multiply(world_matrices[parent], local_matrices[index], world_matrices[index]);
+		}
+
+		updated++;
+	}
+
+	return updated;
+}
+}        // namespace sg
+}        // namespace vkb
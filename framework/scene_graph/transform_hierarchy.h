@@ -0,0 +1,154 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/error.h"
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+namespace scene_graph
+{
+template <vkb::BindingType bindingType>
+class Node;
+using NodeCpp = Node<vkb::BindingType::Cpp>;
+}        // namespace scene_graph
+
+namespace sg
+{
+class Transform;
+
+/**
+ * @brief Flattened transform hierarchy, which updates the world matrices of all dirty transforms in one pass
+ *
+ * The transforms of a node tree are stored in breadth-first order as arrays of parent indices, local and world
+ * matrices, and dirty flags. As each parent comes before its children, an update is one linear pass per tree
+ * level. Nodes within a level are independent of each other, so large levels are split across a pool of threads,
+ * which is started by the first update with such a level and kept for the lifetime of the hierarchy.
+ * Registered transforms mark themselves dirty here and read their world matrix from here, update is never called
+ * implicitly by a read. A read between a change and the next update composes the changed local matrices instead.
+ */
+class TransformHierarchy
+{
+  public:
+	/**
+	 * @brief Timing of the last update
+	 */
+	struct Statistics
+	{
+		uint32_t node_count     = 0;
+		uint32_t level_count    = 0;
+		uint32_t updated_count  = 0;        // Number of world matrices recomputed by the last update
+		double   update_time_ms = 0.0;
+	};
+
+	TransformHierarchy() = default;
+
+	TransformHierarchy(const TransformHierarchy &) = delete;
+
+	TransformHierarchy(TransformHierarchy &&other);
+
+	~TransformHierarchy();
+
+	TransformHierarchy &operator=(const TransformHierarchy &) = delete;
+
+	TransformHierarchy &operator=(TransformHierarchy &&other);
+
+	/**
+	 * @brief Registers all transforms of the tree below the given root, replacing any previous tree
+	 */
+	void build(vkb::scene_graph::NodeCpp &root);
+
+	/**
+	 * @brief Unregisters all transforms
+	 */
+	void clear();
+
+	/**
+	 * @brief Recomputes the world matrices of all dirty transforms and their descendants
+	 */
+	void update();
+
+	/**
+	 * @brief Marks a transform dirty, after its local transform changed
+	 */
+	void mark_dirty(uint32_t index);
+
+	/**
+	 * @brief Requests a rebuild, after the parent of a registered node changed
+	 */
+	void invalidate();
+
+	/**
+	 * @return True if the tree needs to be rebuilt
+	 */
+	bool is_invalid() const;
+
+	/**
+	 * @brief Returns the world matrix of a transform. Changes made since the last update are applied on the fly by
+	 *        composing the changed local matrices, so the result is never stale. It writes nothing, so concurrent
+	 *        reads are safe while no thread updates or changes the hierarchy.
+	 */
+	glm::mat4 get_world_matrix(uint32_t index) const;
+
+	const Statistics &get_statistics() const;
+
+	/**
+	 * @brief Sets the minimum number of nodes in a level for it to be split across threads
+	 */
+	void set_parallel_threshold(uint32_t threshold);
+
+  private:
+	class Workers;
+
+	uint32_t update_range(uint32_t begin, uint32_t end);
+
+	static constexpr uint32_t NO_PARENT = ~0u;
+
+	std::vector<Transform *> transforms;
+
+	std::vector<uint32_t> parents;
+
+	std::vector<uint32_t> node_levels;
+
+	std::vector<uint32_t> level_offsets;
+
+	std::vector<glm::mat4> local_matrices;
+
+	std::vector<glm::mat4> world_matrices;
+
+	// One byte per node, so threads can write flags of neighbouring nodes
+	std::vector<uint8_t> dirty;
+
+	uint32_t first_dirty_level = ~0u;
+
+	bool invalid = true;
+
+	uint32_t parallel_threshold = 4096;
+
+	Statistics statistics;
+
+	std::unique_ptr<Workers> workers;
+};
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,69 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_stats_provider.h"
+
+#include "core/allocated.h"
+
+namespace vkb
+{
+namespace
+{
+vkb::allocated::MemoryCategory get_memory_category(StatIndex index)
+{
+	switch (index)
+	{
+		case StatIndex::texture_memory:
+			return vkb::allocated::MemoryCategory::Textures;
+		case StatIndex::mesh_memory:
+			return vkb::allocated::MemoryCategory::Meshes;
+		case StatIndex::render_target_memory:
+			return vkb::allocated::MemoryCategory::RenderTargets;
+		case StatIndex::transient_memory:
+			return vkb::allocated::MemoryCategory::Transient;
+		default:
+			return vkb::allocated::MemoryCategory::Other;
+	}
+}
+}        // namespace
+
+MemoryStatsProvider::MemoryStatsProvider(std::set<StatIndex> &requested_stats)
+{
+	for (auto index : {StatIndex::texture_memory, StatIndex::mesh_memory, StatIndex::render_target_memory, StatIndex::transient_memory})
+	{
+		if (requested_stats.erase(index))
+		{
+			available_stats.insert(index);
+		}
+	}
+}
+
+bool MemoryStatsProvider::is_available(StatIndex index) const
+{
+	return available_stats.contains(index);
+}
+
+StatsProvider::Counters MemoryStatsProvider::sample(float delta_time)
+{
+	Counters res;
+	for (auto index : available_stats)
+	{
+		res[index].result = static_cast<double>(vkb::allocated::get_memory_usage(get_memory_category(index)));
+	}
+	return res;
+}
+}        // namespace vkb
@@ -23,8 +23,10 @@
 
 #include "core/util/profiling.hpp"
 #include "stats/frame_time_stats_provider.h"
+#include "stats/memory_stats_provider.h"
 #include "stats/stats_common.h"
 #include "stats/stats_provider.h"
+#include "stats/submit_stats_provider.h"
 #include "stats/vulkan_stats_provider.h"
 #include "timer.h"
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
@@ -146,7 +148,7 @@ class Stats
 	std::mutex                                       continuous_sampling_mutex;                       // A mutex for accessing measurements during continuous sampling
 	std::map<StatIndex, std::vector<float>>          counters;                                        // Circular buffers for counter data
 	float                                            fractional_pending_samples = 0.0f;               // A value which helps keep a steady pace of continuous samples output.
-	vkb::StatsProvider                              *frame_time_provider;                             // Provider that tracks frame times
+	std::vector<vkb::StatsProvider *>                frame_providers;                                 // Providers that track per-frame values, like frame times
 	vkb::Timer                                       main_timer;                                      // vkb::Timer used in the main thread to compute delta time
 	std::vector<vkb::StatsProvider::Counters>        pending_samples;                                 // The samples waiting to be displayed
 	std::vector<std::unique_ptr<vkb::StatsProvider>> providers;                                       // A list of stats providers to use in priority order
@@ -243,6 +245,18 @@ static inline char const *to_string(StatIndex index)
 			return "External Read Bytes (MiB/s)";
 		case StatIndex::gpu_ext_write_bytes:
 			return "External Write Bytes (MiB/s)";
+		case StatIndex::submit_calls:
+			return "Submit Calls (/frame)";
+		case StatIndex::submit_cpu_time:
+			return "Submit CPU Time (ms)";
+		case StatIndex::texture_memory:
+			return "Texture Memory (MiB)";
+		case StatIndex::mesh_memory:
+			return "Mesh Memory (MiB)";
+		case StatIndex::render_target_memory:
+			return "Render Target Memory (MiB)";
+		case StatIndex::transient_memory:
+			return "Transient Memory (MiB)";
 		default:
 			return nullptr;
 	}
@@ -499,14 +513,16 @@ inline void Stats<bindingType>::request_stats(const std::set<StatIndex> &wanted_
 	// All supported stats will be removed from the given 'stats' set by the provider's constructor
 	// so subsequent providers only see requests for stats that aren't already supported.
 	providers.emplace_back(std::make_unique<vkb::FrameTimeStatsProvider>(stats));
+	providers.emplace_back(std::make_unique<vkb::SubmitStatsProvider>(stats, render_context));
+	providers.emplace_back(std::make_unique<vkb::MemoryStatsProvider>(stats));
+	frame_providers = {providers[0].get(), providers[1].get(), providers[2].get()};
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
 	providers.emplace_back(std::make_unique<HWCPipeStatsProvider>(stats));
 #endif
 	providers.emplace_back(std::make_unique<vkb::VulkanStatsProvider>(stats, sampling_config, reinterpret_cast<vkb::rendering::RenderContextC &>(render_context)));
 
-	// In continuous sampling mode we still need to update the frame times as if we are polling
-	// Store the frame time provider here so we can easily access it later.
-	frame_time_provider = providers[0].get();
+	// In continuous sampling mode we still need to update the per-frame values, like frame times, as if we are polling
+	// The per-frame providers are stored above so we can easily access them later.
 
 	for (const auto &stat : requested_stats)
 	{
@@ -568,6 +584,14 @@ inline void Stats<bindingType>::update(float delta_time)
 		}
 		case CounterSamplingMode::Continuous:
 		{
+			// Get the per-frame stats, like frame times (not continuous stats), every frame so they stay per frame
+			vkb::StatsProvider::Counters frame_sample;
+			for (auto *p : frame_providers)
+			{
+				auto s = p->sample(delta_time);
+				frame_sample.insert(s.begin(), s.end());
+			}
+
 			// Check that we have no pending samples to be shown
 			if (pending_samples.size() == 0)
 			{
@@ -616,13 +640,10 @@ inline void Stats<bindingType>::update(float delta_time)
 			// Clamp the number of samples
 			sample_count = std::max<size_t>(1, std::min<size_t>(sample_count, pending_samples.size()));
 
-			// Get the frame time stats (not a continuous stat)
-			vkb::StatsProvider::Counters frame_time_sample = frame_time_provider->sample(delta_time);
-
 			// Push the samples to circular buffers
-			std::for_each(pending_samples.begin(), pending_samples.begin() + sample_count, [this, frame_time_sample](auto &s) {
-				// Write the correct frame time into the continuous stats
-				s.insert(frame_time_sample.begin(), frame_time_sample.end());
+			std::for_each(pending_samples.begin(), pending_samples.begin() + sample_count, [this, frame_sample](auto &s) {
+				// Write the correct per-frame values into the continuous stats
+				s.insert(frame_sample.begin(), frame_sample.end());
 				// Then push the sample to the counters list
 				this->push_sample(s);
 			});
@@ -63,6 +63,14 @@ enum class StatIndex
 	gpu_ext_read_bytes,
 	gpu_ext_write_bytes,
 	gpu_tex_cycles,
+
+	submit_calls,
+	submit_cpu_time,
+
+	texture_memory,
+	mesh_memory,
+	render_target_memory,
+	transient_memory,
 };
 
 struct StatIndexHash
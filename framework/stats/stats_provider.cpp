@@ -54,6 +54,14 @@ std::map<StatIndex, StatGraphData> StatsProvider::default_graph_map{
     {StatIndex::gpu_ext_write_stalls,  {"External Write Stalls",                       "{:4.1f} M/s",   static_cast<float>(1e-6)}},
     {StatIndex::gpu_ext_read_bytes,    {"External Read Bytes",                         "{:4.1f} MiB/s", 1.0f / (1024.0f * 1024.0f)}},
     {StatIndex::gpu_ext_write_bytes,   {"External Write Bytes",                        "{:4.1f} MiB/s", 1.0f / (1024.0f * 1024.0f)}},
+
+    {StatIndex::submit_calls,          {"Submit Calls",                                "{:3.1f}/frame"}},
+    {StatIndex::submit_cpu_time,       {"Submit CPU Time",                             "{:3.2f} ms",    1000.0f}},
+
+    {StatIndex::texture_memory,        {"Texture Memory",                              "{:4.1f} MiB",   1.0f / (1024.0f * 1024.0f)}},
+    {StatIndex::mesh_memory,           {"Mesh Memory",                                 "{:4.1f} MiB",   1.0f / (1024.0f * 1024.0f)}},
+    {StatIndex::render_target_memory,  {"Render Target Memory",                        "{:4.1f} MiB",   1.0f / (1024.0f * 1024.0f)}},
+    {StatIndex::transient_memory,      {"Transient Memory",                            "{:4.1f} MiB",   1.0f / (1024.0f * 1024.0f)}},
     // clang-format on
 };
 
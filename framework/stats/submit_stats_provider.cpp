@@ -0,0 +1,61 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "submit_stats_provider.h"
+
+#include "rendering/render_context.h"
+
+namespace vkb
+{
+SubmitStatsProvider::SubmitStatsProvider(std::set<StatIndex> &requested_stats, vkb::rendering::RenderContextCpp &render_context) :
+    render_context{render_context}
+{
+	for (auto index : {StatIndex::submit_calls, StatIndex::submit_cpu_time})
+	{
+		if (requested_stats.erase(index))
+		{
+			available_stats.insert(index);
+		}
+	}
+}
+
+bool SubmitStatsProvider::is_available(StatIndex index) const
+{
+	return available_stats.contains(index);
+}
+
+StatsProvider::Counters SubmitStatsProvider::sample(float delta_time)
+{
+	Counters res;
+	if (available_stats.empty())
+	{
+		return res;
+	}
+
+	// Samples are taken once per frame, so the counters collected since the last sample are per frame
+	vkb::rendering::SubmitStats stats = render_context.get_submit_builder().collect_stats();
+	if (available_stats.contains(StatIndex::submit_calls))
+	{
+		res[StatIndex::submit_calls].result = stats.submit_calls;
+	}
+	if (available_stats.contains(StatIndex::submit_cpu_time))
+	{
+		res[StatIndex::submit_cpu_time].result = stats.cpu_time;
+	}
+	return res;
+}
+}        // namespace vkb
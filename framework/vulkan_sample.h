@@ -27,6 +27,7 @@
 #include "platform/window.h"
 #include "rendering/render_pipeline.h"
 #include "scene_graph/components/camera.h"
+#include "scene_graph/scene_update_thread.h"
 #include "scene_graph/script.h"
 #include "scene_graph/scripts/animation.h"
 #include "stats/stats.h"
@@ -148,7 +149,25 @@ class VulkanSample : public vkb::Application
 	Configuration                                    &get_configuration();
 	vkb::rendering::RenderContext<bindingType>       &get_render_context();
 	vkb::rendering::RenderContext<bindingType> const &get_render_context() const;
+	vkb::scene_graph::Scene<bindingType>             &get_scene();
 	bool                                              has_render_context() const;
+	bool                                              has_scene();
+	bool                                              is_pipelined_update() const;
+
+	/**
+	 * @brief Timing of the last update of the scene on the simulation thread, zero without the pipelined update
+	 */
+	vkb::sg::SceneUpdateThread::Statistics get_scene_update_statistics() const;
+
+	/**
+	 * @brief Enables the pipelined update, in which the scene of the next frame is updated on a simulation thread once the
+	 *        current frame is submitted, while it is presented and the next frame waits for the GPU. The update is joined
+	 *        before recording, so recording may read the live scene as well as the snapshot.
+	 * Only applies to samples using VulkanSample::update whose draw_gui does not change the transforms of the scene.
+	 * Samples without a scene keep updating before recording.
+	 * @param enable If true, the scene is updated on the simulation thread, otherwise it is updated before recording.
+	 */
+	void set_pipelined_update(bool enable);
 
 	/// <summary>
 	/// PROTECTED VIRTUAL INTERFACE
@@ -261,7 +280,6 @@ class VulkanSample : public vkb::Application
 	vkb::core::Instance<bindingType> const            &get_instance() const;
 	vkb::rendering::RenderPipeline<bindingType>       &get_render_pipeline();
 	vkb::rendering::RenderPipeline<bindingType> const &get_render_pipeline() const;
-	vkb::scene_graph::Scene<bindingType>              &get_scene();
 	vkb::stats::Stats<bindingType>                    &get_stats();
 	SurfaceType                                        get_surface() const;
 	std::vector<SurfaceFormatType>                    &get_surface_priority_list();
@@ -270,14 +288,14 @@ class VulkanSample : public vkb::Application
 	bool                                               has_instance() const;
 	bool                                               has_gui() const;
 	bool                                               has_render_pipeline() const;
-	bool                                               has_scene();
 
 	/**
 	 * @brief Loads the scene
 	 *
 	 * @param path The path of the glTF file
+	 * @param vertex_layout The layout of the vertex buffers created for the scene's submeshes
 	 */
-	void load_scene(const std::string &path);
+	void load_scene(const std::string &path, const vkb::GLTFLoader::VertexLayout &vertex_layout = {});
 
 	/**
 	 * @brief Additional sample initialization
@@ -384,6 +402,15 @@ class VulkanSample : public vkb::Application
 	 */
 	std::unique_ptr<vkb::scene_graph::SceneCpp> scene;
 
+	/**
+	 * @brief Updates the scene between the submission of a frame and the recording of the next, if the pipelined update is enabled
+	 */
+	std::unique_ptr<vkb::sg::SceneUpdateThread> scene_update_thread;
+
+	// Timing of the pipelined update, shown in the debug window
+	float scene_update_time_ms = 0.0f;
+	float scene_wait_time_ms   = 0.0f;
+
 	std::unique_ptr<vkb::GuiCpp> gui;
 
 	std::unique_ptr<vkb::stats::StatsCpp> stats;
@@ -435,6 +462,7 @@ inline VulkanSample<bindingType>::~VulkanSample()
 		device->get_handle().waitIdle();
 	}
 
+	scene_update_thread.reset();
 	scene.reset();
 	stats.reset();
 	gui.reset();
@@ -539,6 +567,11 @@ void VulkanSample<bindingType>::create_render_context_impl(const std::vector<vk:
 
 	render_context =
 	    std::make_unique<vkb::rendering::RenderContextCpp>(*device, surface, *window, present_mode, present_mode_priority_list, surface_priority_list);
+
+	if (!surface)
+	{
+		render_context->set_offscreen_frame_count(window->get_properties().offscreen_frame_count);
+	}
 }
 
 template <vkb::BindingType bindingType>
@@ -559,6 +592,10 @@ inline size_t VulkanSample<bindingType>::determine_physical_device_score_impl(vk
 {
 	// Prefer discrete GPUs that support presenting to our surface, as they are most likely to provide good performance for rendering and presenting.
 	auto supports_surface = [this, &gpu]() {
+		if (!surface)
+		{
+			return true;
+		}
 		for (uint32_t queue_idx = 0; queue_idx < gpu.getQueueFamilyProperties().size(); ++queue_idx)
 		{
 			if (gpu.getSurfaceSupportKHR(queue_idx, surface))
@@ -636,12 +673,18 @@ inline void VulkanSample<bindingType>::draw_impl(vkb::core::CommandBufferCpp
 	}
 
 	{
+		// Without a swapchain, the offscreen image is only read by copies, such as the ones of the frame captures
 		vkb::common::HPPImageMemoryBarrier memory_barrier{};
 		memory_barrier.old_layout      = vk::ImageLayout::eColorAttachmentOptimal;
-		memory_barrier.new_layout      = vk::ImageLayout::ePresentSrcKHR;
+		memory_barrier.new_layout      = get_render_context().get_final_layout();
 		memory_barrier.src_access_mask = vk::AccessFlagBits::eColorAttachmentWrite;
 		memory_barrier.src_stage_mask  = vk::PipelineStageFlagBits::eColorAttachmentOutput;
 		memory_barrier.dst_stage_mask  = vk::PipelineStageFlagBits::eBottomOfPipe;
+		if (memory_barrier.new_layout == vk::ImageLayout::eTransferSrcOptimal)
+		{
+			memory_barrier.dst_access_mask = vk::AccessFlagBits::eTransferRead;
+			memory_barrier.dst_stage_mask  = vk::PipelineStageFlagBits::eTransfer;
+		}
 
 		command_buffer.image_memory_barrier(views[0], memory_barrier);
 		render_target.set_layout(0, memory_barrier.new_layout);
@@ -1149,6 +1192,18 @@ bool VulkanSample<bindingType>::has_scene()
 	return scene != nullptr;
 }
 
+template <vkb::BindingType bindingType>
+inline bool VulkanSample<bindingType>::is_pipelined_update() const
+{
+	return scene_update_thread != nullptr;
+}
+
+template <vkb::BindingType bindingType>
+inline vkb::sg::SceneUpdateThread::Statistics VulkanSample<bindingType>::get_scene_update_statistics() const
+{
+	return scene_update_thread ? scene_update_thread->get_statistics() : vkb::sg::SceneUpdateThread::Statistics{};
+}
+
 template <vkb::BindingType bindingType>
 inline void VulkanSample<bindingType>::input_event(const InputEvent &input_event)
 {
@@ -1163,6 +1218,12 @@ inline void VulkanSample<bindingType>::input_event(const InputEvent &input_event
 
 	if (!gui_captures_event)
 	{
+		if (scene_update_thread)
+		{
+			// Scripts handle events between updates
+			scene_update_thread->wait();
+		}
+
 		if (scene && scene->has_component<sg::Script>())
 		{
 			auto scripts = scene->get_components<sg::Script>();
@@ -1180,15 +1241,17 @@ inline void VulkanSample<bindingType>::input_event(const InputEvent &input_event
 		if (key_event.get_action() == KeyAction::Down &&
 		    (key_event.get_code() == KeyCode::PrintScreen || key_event.get_code() == KeyCode::F12))
 		{
-			vkb::common::screenshot(*render_context, "screenshot-" + get_name());
+			// Captured at the end of the next frame, without stalling it
+			render_context->request_capture({.filename = "screenshot-" + get_name()});
 		}
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline void VulkanSample<bindingType>::load_scene(const std::string &path)
+inline void VulkanSample<bindingType>::load_scene(const std::string &path, const vkb::GLTFLoader::VertexLayout &vertex_layout)
 {
 	vkb::HPPGLTFLoader loader(*device);
+	loader.set_vertex_layout(vertex_layout);
 
 	scene = loader.read_scene_from_file(path);
 
@@ -1282,11 +1345,14 @@ inline bool VulkanSample<bindingType>::prepare(const ApplicationOptions &options
 		}
 	}
 
-	// Getting a valid vulkan surface from the platform
-	surface = static_cast<vk::SurfaceKHR>(window->create_surface(reinterpret_cast<vkb::core::InstanceC &>(*instance)));
-	if (!surface)
+	// Getting a valid vulkan surface from the platform, unless rendering offscreen without a swapchain
+	if (window->get_window_mode() != Window::Mode::Offscreen)
 	{
-		throw std::runtime_error("Failed to create window surface.");
+		surface = static_cast<vk::SurfaceKHR>(window->create_surface(reinterpret_cast<vkb::core::InstanceC &>(*instance)));
+		if (!surface)
+		{
+			throw std::runtime_error("Failed to create window surface.");
+		}
 	}
 
 	select_physical_device();
@@ -1299,8 +1365,9 @@ inline bool VulkanSample<bindingType>::prepare(const ApplicationOptions &options
 		physical_device->get_mutable_requested_features().textureCompressionASTC_LDR = true;
 	}
 
-	// Creating vulkan device, specifying the swapchain extension always
+	// Creating vulkan device, specifying the swapchain extension unless rendering offscreen without a swapchain
 	// If using VK_EXT_headless_surface, we still create and use a swap-chain
+	if (window->get_window_mode() != Window::Mode::Offscreen)
 	{
 		add_device_extension(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 
@@ -1437,7 +1504,11 @@ inline void VulkanSample<bindingType>::request_instance_extensions(std::unordere
 
 	// We're going to use VK_KHR_swapchain on device creation, which requires VK_KHR_surface on instance creation
 	// Just in case the windowing system didn't already request it...
-	requested_extensions[VK_KHR_SURFACE_EXTENSION_NAME] = vkb::RequestMode::Required;
+	// Offscreen rendering creates neither a surface nor a swapchain, and its window requires no surface extension
+	if (window->get_window_mode() != Window::Mode::Offscreen)
+	{
+		requested_extensions[VK_KHR_SURFACE_EXTENSION_NAME] = vkb::RequestMode::Required;
+	}
 
 #if defined(VKB_VULKAN_DEBUG) || defined(VKB_DEBUG) || defined(VKB_VALIDATION_LAYERS)
 	requested_extensions[VK_EXT_DEBUG_UTILS_EXTENSION_NAME] = vkb::RequestMode::Required;
@@ -1537,6 +1608,11 @@ inline bool VulkanSample<bindingType>::resize(uint32_t width, uint32_t height)
 		gui->resize(width, height);
 	}
 
+	if (scene_update_thread)
+	{
+		scene_update_thread->wait();
+	}
+
 	if (scene && scene->has_component<sg::Script>())
 	{
 		auto scripts = scene->get_components<sg::Script>();
@@ -1604,6 +1680,36 @@ inline void VulkanSample<bindingType>::set_high_priority_graphics_queue_enable(b
 	high_priority_graphics_queue = enable;
 }
 
+template <vkb::BindingType bindingType>
+inline void VulkanSample<bindingType>::set_pipelined_update(bool enable)
+{
+	if (enable == (scene_update_thread != nullptr))
+	{
+		return;
+	}
+
+	if (enable)
+	{
+		if (!scene || !render_context)
+		{
+			LOGW("Pipelined update needs a scene and a render context, the scene is updated before recording");
+			return;
+		}
+
+		// Bring the transforms up to date, the state of the scene is the first snapshot
+		scene->update_transforms();
+		scene_update_thread = std::make_unique<vkb::sg::SceneUpdateThread>(*scene, [this](float delta_time) { update_scene(delta_time); });
+
+		get_debug_info().template insert<field::MinMax, float>("scene_update_ms", scene_update_time_ms);
+		get_debug_info().template insert<field::MinMax, float>("scene_wait_ms", scene_wait_time_ms);
+	}
+	else
+	{
+		scene_update_thread.reset();
+		render_context->set_scene_snapshot(nullptr);
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline void VulkanSample<bindingType>::set_render_context(std::unique_ptr<vkb::rendering::RenderContext<bindingType>> &&rc)
 {
@@ -1657,11 +1763,30 @@ inline void VulkanSample<bindingType>::update(float delta_time)
 {
 	vkb::Application::update(delta_time);
 
-	update_scene(delta_time);
+	vkb::core::CommandBufferHandleCpp command_buffer;
+	if (scene_update_thread)
+	{
+		// Waiting for the next frame overlaps the update started once the previous frame was submitted
+		command_buffer = render_context->begin();
+
+		// The update is joined before recording, the scene is then only read until this frame is submitted
+		render_context->set_scene_snapshot(&scene_update_thread->acquire());
+
+		auto const &update_statistics = scene_update_thread->get_statistics();
+		scene_update_time_ms          = static_cast<float>(update_statistics.update_time_ms);
+		scene_wait_time_ms            = static_cast<float>(update_statistics.wait_time_ms);
+	}
+	else
+	{
+		update_scene(delta_time);
+	}
 
 	update_gui(delta_time);
 
-	auto command_buffer = render_context->begin();
+	if (!command_buffer)
+	{
+		command_buffer = render_context->begin();
+	}
 
 	// Collect the performance data for the sample graphs
 	update_stats(delta_time);
@@ -1683,6 +1808,12 @@ inline void VulkanSample<bindingType>::update(float delta_time)
 	command_buffer->end();
 
 	render_context->submit(command_buffer);
+
+	if (scene_update_thread)
+	{
+		// Recording and the GUI are done with the scene, the next frame is simulated while this one is presented
+		scene_update_thread->start(delta_time);
+	}
 }
 
 template <vkb::BindingType bindingType>
@@ -1693,10 +1824,10 @@ inline void VulkanSample<bindingType>::update_debug_window()
 
 	get_debug_info().template insert<field::Static, std::string>("driver_version", driver_version_str);
 	get_debug_info().template insert<field::Static, std::string>("resolution",
-	                                                             to_string(static_cast<VkExtent2D const &>(render_context->get_swapchain().get_extent())));
+	                                                             to_string(static_cast<VkExtent2D const &>(render_context->get_surface_extent())));
 	get_debug_info().template insert<field::Static, std::string>("surface_format",
-	                                                             to_string(render_context->get_swapchain().get_format()) + " (" +
-	                                                                 to_string(vkb::common::get_bits_per_pixel(render_context->get_swapchain().get_format())) +
+	                                                             to_string(render_context->get_format()) + " (" +
+	                                                                 to_string(vkb::common::get_bits_per_pixel(render_context->get_format())) +
 	                                                                 "bpp)");
 
 	if (scene != nullptr)
@@ -1762,6 +1893,9 @@ inline void VulkanSample<bindingType>::update_scene(float delta_time)
 				animation->update(delta_time);
 			}
 		}
+
+		// Update all world matrices changed by scripts and animations at once, before they are read while drawing
+		scene->update_transforms();
 	}
 }
 
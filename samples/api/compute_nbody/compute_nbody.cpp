@@ -17,11 +17,38 @@
 
 /*
  * Compute shader N-body simulation using two passes and shared compute shader memory
+ * The Barnes-Hut mode replaces the first pass with passes building and walking a tree of the particles
  */
 
 #include "compute_nbody.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "benchmark_mode/benchmark_mode.h"
+#include "filesystem/legacy.h"
+#include "timer.h"
+
+// Sizes of the Barnes-Hut passes, matching shaders/compute_nbody/glsl/particle_tree.h
+// Each sort pass sorts 4 bits of the Morton codes, an even pass count leaves the sorted keys in the first buffers
+constexpr uint32_t     tree_group_size       = 128;
+constexpr uint32_t     tree_sort_tile_size   = tree_group_size * 8;
+constexpr uint32_t     tree_sort_digit_count = 16;
+constexpr uint32_t     tree_sort_pass_count  = 8;
+constexpr VkDeviceSize tree_node_size        = 64;
+
+// Multipliers of the particles per attractor selectable in Barnes-Hut mode
+constexpr std::array<uint32_t, 4> particle_scales = {1, 4, 16, 64};
+
+// Shaders of the Barnes-Hut passes, in shaders/compute_nbody/glsl
+constexpr std::array<const char *, 8> tree_shaders = {"particle_bounds.comp.spv",
+                                                      "particle_morton.comp.spv",
+                                                      "particle_sort_histogram.comp.spv",
+                                                      "particle_sort_scan.comp.spv",
+                                                      "particle_sort_scatter.comp.spv",
+                                                      "particle_tree_build.comp.spv",
+                                                      "particle_tree_summarize.comp.spv",
+                                                      "particle_tree_force.comp.spv"};
 
 ComputeNBody::ComputeNBody()
 {
@@ -57,6 +84,24 @@ ComputeNBody::~ComputeNBody()
 		vkDestroySemaphore(get_device().get_handle(), compute.semaphore, nullptr);
 		vkDestroyCommandPool(get_device().get_handle(), compute.command_pool, nullptr);
 
+		// Barnes-Hut
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			tree.keys[i].reset();
+			tree.values[i].reset();
+		}
+		tree.histogram.reset();
+		tree.nodes.reset();
+		tree.bounds.reset();
+		tree.capture.reset();
+		for (VkPipeline pipeline : {tree.bounds_pipeline, tree.morton_pipeline, tree.histogram_pipeline, tree.scan_pipeline,
+		                            tree.scatter_pipeline, tree.build_pipeline, tree.summarize_pipeline, tree.force_pipeline})
+		{
+			vkDestroyPipeline(get_device().get_handle(), pipeline, nullptr);
+		}
+		vkDestroyPipelineLayout(get_device().get_handle(), tree.pipeline_layout, nullptr);
+		vkDestroyDescriptorSetLayout(get_device().get_handle(), tree.descriptor_set_layout, nullptr);
+
 		vkDestroySampler(get_device().get_handle(), textures.particle.sampler, nullptr);
 		vkDestroySampler(get_device().get_handle(), textures.gradient.sampler, nullptr);
 	}
@@ -202,9 +247,17 @@ void ComputeNBody::build_compute_command_buffer()
 
 	// First pass: Calculate particle movement
 	// -------------------------------------------------------------------------------------------------------
-	vkCmdBindPipeline(compute.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute.pipeline_calculate);
-	vkCmdBindDescriptorSets(compute.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute.pipeline_layout, 0, 1, &compute.descriptor_set, 0, 0);
-	vkCmdDispatch(compute.command_buffer, num_particles / work_group_size, 1, 1);
+	if (barnes_hut)
+	{
+		// Approximated from a tree of the particles, instead of summing the interactions of all pairs of particles
+		record_tree_passes();
+	}
+	else
+	{
+		vkCmdBindPipeline(compute.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute.pipeline_calculate);
+		vkCmdBindDescriptorSets(compute.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute.pipeline_layout, 0, 1, &compute.descriptor_set, 0, 0);
+		vkCmdDispatch(compute.command_buffer, num_particles / work_group_size, 1, 1);
+	}
 
 	// Add memory barrier to ensure that the computer shader has finished writing to the buffer
 	VkBufferMemoryBarrier memory_barrier = vkb::initializers::buffer_memory_barrier();
@@ -227,8 +280,26 @@ void ComputeNBody::build_compute_command_buffer()
 	// Second pass: Integrate particles
 	// -------------------------------------------------------------------------------------------------------
 	vkCmdBindPipeline(compute.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute.pipeline_integrate);
+	vkCmdBindDescriptorSets(compute.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute.pipeline_layout, 0, 1, &compute.descriptor_set, 0, 0);
 	vkCmdDispatch(compute.command_buffer, num_particles / work_group_size, 1, 1);
 
+	// Make the captured accelerations visible to the host, once the fence of the dispatch is signaled
+	if (barnes_hut)
+	{
+		VkMemoryBarrier host_barrier = vkb::initializers::memory_barrier();
+		host_barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+		host_barrier.dstAccessMask   = VK_ACCESS_HOST_READ_BIT;
+
+		vkCmdPipelineBarrier(
+		    compute.command_buffer,
+		    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		    VK_PIPELINE_STAGE_HOST_BIT,
+		    VK_FLAGS_NONE,
+		    1, &host_barrier,
+		    0, nullptr,
+		    0, nullptr);
+	}
+
 	// Release
 	if (graphics.queue_family_index != compute.queue_family_index)
 	{
@@ -257,6 +328,88 @@ void ComputeNBody::build_compute_command_buffer()
 	vkEndCommandBuffer(compute.command_buffer);
 }
 
+void ComputeNBody::record_tree_passes()
+{
+	VkCommandBuffer command_buffer       = compute.command_buffer;
+	uint32_t        particle_group_count = (num_particles + tree_group_size - 1) / tree_group_size;
+
+	// Each pass reads the buffers written by the previous one
+	auto pass_barrier = [command_buffer](VkPipelineStageFlags src_stage_mask, VkAccessFlags src_access_mask) {
+		VkMemoryBarrier memory_barrier = vkb::initializers::memory_barrier();
+		memory_barrier.srcAccessMask   = src_access_mask;
+		memory_barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(
+		    command_buffer,
+		    src_stage_mask,
+		    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		    VK_FLAGS_NONE,
+		    1, &memory_barrier,
+		    0, nullptr,
+		    0, nullptr);
+	};
+
+	// Reset the bounds, once the passes of the previous dispatch have read them
+	vkCmdPipelineBarrier(
+	    command_buffer,
+	    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+	    VK_PIPELINE_STAGE_TRANSFER_BIT,
+	    VK_FLAGS_NONE,
+	    0, nullptr,
+	    0, nullptr,
+	    0, nullptr);
+	vkCmdFillBuffer(command_buffer, tree.bounds->get_handle(), 0, 3 * sizeof(uint32_t), 0xFFFFFFFF);
+	vkCmdFillBuffer(command_buffer, tree.bounds->get_handle(), 3 * sizeof(uint32_t), 3 * sizeof(uint32_t), 0);
+	pass_barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+	TreePushConstants push_constants{0, tree.sort_group_count};
+
+	// Morton codes of the particles, within the bounds of all particles
+	vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.pipeline_layout, 0, 1, &tree.descriptor_sets[0], 0, nullptr);
+	vkCmdPushConstants(command_buffer, tree.pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants), &push_constants);
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.bounds_pipeline);
+	vkCmdDispatch(command_buffer, particle_group_count, 1, 1);
+	pass_barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.morton_pipeline);
+	vkCmdDispatch(command_buffer, particle_group_count, 1, 1);
+	pass_barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+	// Radix sort of the particles by Morton code, each pass alternates between both sets of key buffers
+	for (uint32_t pass = 0; pass < tree_sort_pass_count; pass++)
+	{
+		push_constants.shift = pass * 4;
+		vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.pipeline_layout, 0, 1, &tree.descriptor_sets[pass % 2], 0, nullptr);
+		vkCmdPushConstants(command_buffer, tree.pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants), &push_constants);
+
+		vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.histogram_pipeline);
+		vkCmdDispatch(command_buffer, tree.sort_group_count, 1, 1);
+		pass_barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+		vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.scan_pipeline);
+		vkCmdDispatch(command_buffer, 1, 1, 1);
+		pass_barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+		vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.scatter_pipeline);
+		vkCmdDispatch(command_buffer, tree.sort_group_count, 1, 1);
+		pass_barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+	}
+
+	// Tree of the sorted particles, then the movement of each particle from the nodes it walks
+	vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.pipeline_layout, 0, 1, &tree.descriptor_sets[0], 0, nullptr);
+
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.build_pipeline);
+	vkCmdDispatch(command_buffer, (num_particles - 1 + tree_group_size - 1) / tree_group_size, 1, 1);
+	pass_barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.summarize_pipeline);
+	vkCmdDispatch(command_buffer, particle_group_count, 1, 1);
+	pass_barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, tree.force_pipeline);
+	vkCmdDispatch(command_buffer, particle_group_count, 1, 1);
+}
+
 // Setup and fill the compute shader storage buffers containing the particles
 void ComputeNBody::prepare_storage_buffers()
 {
@@ -276,7 +429,11 @@ void ComputeNBody::prepare_storage_buffers()
 	};
 #endif
 
-	num_particles = static_cast<uint32_t>(attractors.size()) * PARTICLES_PER_ATTRACTOR;
+	// The particle count is only scaled in Barnes-Hut mode, the light particles share the mass of a single particle
+	uint32_t particle_scale_factor   = barnes_hut ? particle_scales[particle_scale] : 1;
+	uint32_t particles_per_attractor = PARTICLES_PER_ATTRACTOR * particle_scale_factor;
+
+	num_particles = static_cast<uint32_t>(attractors.size()) * particles_per_attractor;
 
 	// Initial particle positions
 	std::vector<Particle> particle_buffer(num_particles);
@@ -286,9 +443,9 @@ void ComputeNBody::prepare_storage_buffers()
 
 	for (uint32_t i = 0; i < static_cast<uint32_t>(attractors.size()); i++)
 	{
-		for (uint32_t j = 0; j < PARTICLES_PER_ATTRACTOR; j++)
+		for (uint32_t j = 0; j < particles_per_attractor; j++)
 		{
-			Particle &particle = particle_buffer[i * PARTICLES_PER_ATTRACTOR + j];
+			Particle &particle = particle_buffer[i * particles_per_attractor + j];
 
 			// First particle in group as heavy center of gravity
 			if (j == 0)
@@ -307,7 +464,7 @@ void ComputeNBody::prepare_storage_buffers()
 				glm::vec3 angular  = glm::vec3(0.5f, 1.5f, 0.5f) * (((i % 2) == 0) ? 1.0f : -1.0f);
 				glm::vec3 velocity = glm::cross((position - attractors[i]), angular) + glm::vec3(rnd_distribution(rnd_engine), rnd_distribution(rnd_engine), rnd_distribution(rnd_engine) * 0.025f);
 
-				float mass   = (rnd_distribution(rnd_engine) * 0.5f + 0.5f) * 75.0f;
+				float mass   = (rnd_distribution(rnd_engine) * 0.5f + 0.5f) * 75.0f / particle_scale_factor;
 				particle.pos = glm::vec4(position, mass);
 				particle.vel = glm::vec4(velocity, 0.0f);
 			}
@@ -363,19 +520,55 @@ void ComputeNBody::prepare_storage_buffers()
 	get_device().flush_command_buffer(copy_command, queue, true);
 }
 
+// Setup the buffers of the Barnes-Hut passes, sized for the particles
+void ComputeNBody::prepare_tree_buffers()
+{
+	tree.sort_group_count = (num_particles + tree_sort_tile_size - 1) / tree_sort_tile_size;
+
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		tree.keys[i]   = std::make_unique<vkb::core::BufferC>(get_device(), num_particles * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+		tree.values[i] = std::make_unique<vkb::core::BufferC>(get_device(), num_particles * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+	}
+
+	tree.histogram = std::make_unique<vkb::core::BufferC>(get_device(),
+	                                                      tree_sort_digit_count * tree.sort_group_count * sizeof(uint32_t),
+	                                                      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+	                                                      VMA_MEMORY_USAGE_GPU_ONLY);
+
+	// Internal nodes, followed by one leaf per particle
+	tree.nodes = std::make_unique<vkb::core::BufferC>(get_device(),
+	                                                  (2 * num_particles - 1) * tree_node_size,
+	                                                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+	                                                  VMA_MEMORY_USAGE_GPU_ONLY);
+
+	// Minimum and maximum of the particle positions, reset before each dispatch
+	tree.bounds = std::make_unique<vkb::core::BufferC>(get_device(),
+	                                                   6 * sizeof(uint32_t),
+	                                                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+	                                                   VMA_MEMORY_USAGE_GPU_ONLY);
+
+	// Position and acceleration of each particle, read on the host
+	tree.capture = std::make_unique<vkb::core::BufferC>(get_device(),
+	                                                    2 * num_particles * sizeof(glm::vec4),
+	                                                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+	                                                    VMA_MEMORY_USAGE_GPU_TO_CPU);
+}
+
 void ComputeNBody::setup_descriptor_pool()
 {
 	std::vector<VkDescriptorPoolSize> pool_sizes =
 	    {
-	        vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2),
-	        vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1),
+	        vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 4),
+	        vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 19),
 	        vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2)};
 
+	// Graphics and compute sets, and both sets of the Barnes-Hut passes
 	VkDescriptorPoolCreateInfo descriptor_pool_create_info =
 	    vkb::initializers::descriptor_pool_create_info(
 	        static_cast<uint32_t>(pool_sizes.size()),
 	        pool_sizes.data(),
-	        2);
+	        4);
 
 	VK_CHECK(vkCreateDescriptorPool(get_device().get_handle(), &descriptor_pool_create_info, nullptr, &descriptor_pool));
 }
@@ -581,24 +774,7 @@ void ComputeNBody::prepare_compute()
 
 	VK_CHECK(vkAllocateDescriptorSets(get_device().get_handle(), &alloc_info, &compute.descriptor_set));
 
-	VkDescriptorBufferInfo            storage_buffer_descriptor = create_descriptor(*compute.storage_buffer);
-	VkDescriptorBufferInfo            uniform_buffer_descriptor = create_descriptor(*compute.uniform_buffer);
-	std::vector<VkWriteDescriptorSet> compute_write_descriptor_sets =
-	    {
-	        // Binding 0 : Particle position storage buffer
-	        vkb::initializers::write_descriptor_set(
-	            compute.descriptor_set,
-	            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-	            0,
-	            &storage_buffer_descriptor),
-	        // Binding 1 : Uniform buffer
-	        vkb::initializers::write_descriptor_set(
-	            compute.descriptor_set,
-	            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-	            1,
-	            &uniform_buffer_descriptor)};
-
-	vkUpdateDescriptorSets(get_device().get_handle(), static_cast<uint32_t>(compute_write_descriptor_sets.size()), compute_write_descriptor_sets.data(), 0, NULL);
+	update_compute_descriptor_sets();
 
 	// Create pipelines
 	VkComputePipelineCreateInfo compute_pipeline_create_info = vkb::initializers::compute_pipeline_create_info(compute.pipeline_layout, 0);
@@ -625,9 +801,9 @@ void ComputeNBody::prepare_compute()
 
 	specialization_data.workgroup_size   = work_group_size;
 	specialization_data.shared_data_size = shared_data_size;
-	specialization_data.gravity          = 0.002f;
-	specialization_data.power            = 0.75f;
-	specialization_data.soften           = 0.05f;
+	specialization_data.gravity          = interaction.gravity;
+	specialization_data.power            = interaction.power;
+	specialization_data.soften           = interaction.soften;
 
 	VkSpecializationInfo specialization_info =
 	    vkb::initializers::specialization_info(static_cast<uint32_t>(specialization_map_entries.size()), specialization_map_entries.data(), sizeof(specialization_data), &specialization_data);
@@ -680,6 +856,162 @@ void ComputeNBody::prepare_compute()
 	// Build a single command buffer containing the compute dispatch commands
 	build_compute_command_buffer();
 
+	transfer_storage_buffer_ownership();
+}
+
+// Create the resources of the Barnes-Hut passes, once the mode is first selected
+void ComputeNBody::prepare_tree()
+{
+	tree_prepared = true;
+
+	prepare_tree_buffers();
+
+	std::vector<VkDescriptorSetLayoutBinding> set_layout_bindings = {
+	    // Binding 0 : Particle position storage buffer
+	    vkb::initializers::descriptor_set_layout_binding(
+	        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+	        VK_SHADER_STAGE_COMPUTE_BIT,
+	        0),
+	    // Binding 1 : Uniform buffer
+	    vkb::initializers::descriptor_set_layout_binding(
+	        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+	        VK_SHADER_STAGE_COMPUTE_BIT,
+	        1),
+	};
+
+	// Bindings 2 to 9 : Sort keys and values, histogram, nodes, bounds and capture storage buffers
+	for (uint32_t binding = 2; binding <= 9; binding++)
+	{
+		set_layout_bindings.push_back(vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, binding));
+	}
+
+	VkDescriptorSetLayoutCreateInfo descriptor_layout =
+	    vkb::initializers::descriptor_set_layout_create_info(
+	        set_layout_bindings.data(),
+	        static_cast<uint32_t>(set_layout_bindings.size()));
+
+	VK_CHECK(vkCreateDescriptorSetLayout(get_device().get_handle(), &descriptor_layout, nullptr, &tree.descriptor_set_layout));
+
+	VkPipelineLayoutCreateInfo pipeline_layout_create_info =
+	    vkb::initializers::pipeline_layout_create_info(
+	        &tree.descriptor_set_layout,
+	        1);
+
+	// Push constants : Shift of the digit of a sort pass and number of sort tiles
+	VkPushConstantRange push_constant_range = vkb::initializers::push_constant_range(VK_SHADER_STAGE_COMPUTE_BIT, sizeof(TreePushConstants), 0);
+
+	pipeline_layout_create_info.pushConstantRangeCount = 1;
+	pipeline_layout_create_info.pPushConstantRanges    = &push_constant_range;
+
+	VK_CHECK(vkCreatePipelineLayout(get_device().get_handle(), &pipeline_layout_create_info, nullptr, &tree.pipeline_layout));
+
+	std::array<VkDescriptorSetLayout, 2> set_layouts = {tree.descriptor_set_layout, tree.descriptor_set_layout};
+	VkDescriptorSetAllocateInfo          alloc_info  =
+	    vkb::initializers::descriptor_set_allocate_info(
+	        descriptor_pool,
+	        set_layouts.data(),
+	        static_cast<uint32_t>(set_layouts.size()));
+
+	VK_CHECK(vkAllocateDescriptorSets(get_device().get_handle(), &alloc_info, tree.descriptor_sets));
+
+	// Create pipelines
+	VkComputePipelineCreateInfo compute_pipeline_create_info = vkb::initializers::compute_pipeline_create_info(tree.pipeline_layout, 0);
+
+	const std::vector<std::pair<std::string, VkPipeline *>> passes = {
+	    {"particle_bounds.comp.spv", &tree.bounds_pipeline},
+	    {"particle_morton.comp.spv", &tree.morton_pipeline},
+	    {"particle_sort_histogram.comp.spv", &tree.histogram_pipeline},
+	    {"particle_sort_scan.comp.spv", &tree.scan_pipeline},
+	    {"particle_sort_scatter.comp.spv", &tree.scatter_pipeline},
+	    {"particle_tree_build.comp.spv", &tree.build_pipeline},
+	    {"particle_tree_summarize.comp.spv", &tree.summarize_pipeline}};
+
+	for (auto &pass : passes)
+	{
+		compute_pipeline_create_info.stage = load_shader("compute_nbody", pass.first, VK_SHADER_STAGE_COMPUTE_BIT);
+		VK_CHECK(vkCreateComputePipelines(get_device().get_handle(), pipeline_cache, 1, &compute_pipeline_create_info, nullptr, pass.second));
+	}
+
+	// The force pass uses the same interactions as the 1st pass of the all pairs mode
+	compute_pipeline_create_info.stage = load_shader("compute_nbody", "particle_tree_force.comp.spv", VK_SHADER_STAGE_COMPUTE_BIT);
+
+	std::vector<VkSpecializationMapEntry> specialization_map_entries = {
+	    vkb::initializers::specialization_map_entry(2, offsetof(NBodyCpuSolver::Parameters, gravity), sizeof(float)),
+	    vkb::initializers::specialization_map_entry(3, offsetof(NBodyCpuSolver::Parameters, power), sizeof(float)),
+	    vkb::initializers::specialization_map_entry(4, offsetof(NBodyCpuSolver::Parameters, soften), sizeof(float))};
+
+	VkSpecializationInfo specialization_info =
+	    vkb::initializers::specialization_info(static_cast<uint32_t>(specialization_map_entries.size()), specialization_map_entries.data(), sizeof(interaction), &interaction);
+	compute_pipeline_create_info.stage.pSpecializationInfo = &specialization_info;
+
+	VK_CHECK(vkCreateComputePipelines(get_device().get_handle(), pipeline_cache, 1, &compute_pipeline_create_info, nullptr, &tree.force_pipeline));
+
+	// Largest particle count whose nodes fit in a storage buffer
+	VkDeviceSize max_storage_buffer_range = get_device().get_gpu().get_properties().limits.maxStorageBufferRange;
+	max_particle_scale                    = 0;
+	while (max_particle_scale + 1 < static_cast<int32_t>(particle_scales.size()) &&
+	       (2 * static_cast<VkDeviceSize>(num_particles) * particle_scales[max_particle_scale + 1] - 1) * tree_node_size <= max_storage_buffer_range)
+	{
+		max_particle_scale++;
+	}
+}
+
+void ComputeNBody::update_compute_descriptor_sets()
+{
+	VkDescriptorBufferInfo            storage_buffer_descriptor = create_descriptor(*compute.storage_buffer);
+	VkDescriptorBufferInfo            uniform_buffer_descriptor = create_descriptor(*compute.uniform_buffer);
+	std::vector<VkWriteDescriptorSet> compute_write_descriptor_sets =
+	    {
+	        // Binding 0 : Particle position storage buffer
+	        vkb::initializers::write_descriptor_set(
+	            compute.descriptor_set,
+	            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+	            0,
+	            &storage_buffer_descriptor),
+	        // Binding 1 : Uniform buffer
+	        vkb::initializers::write_descriptor_set(
+	            compute.descriptor_set,
+	            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+	            1,
+	            &uniform_buffer_descriptor)};
+
+	// Descriptors of the keys, values, histogram, nodes, bounds and capture buffers, the keys and values of both sets first
+	std::array<VkDescriptorBufferInfo, 8> tree_buffer_descriptors{};
+
+	if (tree_prepared)
+	{
+		tree_buffer_descriptors = {create_descriptor(*tree.keys[0]), create_descriptor(*tree.keys[1]),
+		                           create_descriptor(*tree.values[0]), create_descriptor(*tree.values[1]),
+		                           create_descriptor(*tree.histogram), create_descriptor(*tree.nodes),
+		                           create_descriptor(*tree.bounds), create_descriptor(*tree.capture)};
+
+		// Each sort pass reads the keys and values written by the previous one, with the other set
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			std::array<VkDescriptorBufferInfo *, 8> set_buffer_descriptors = {
+			    &tree_buffer_descriptors[i],            // Binding 2 : Keys read by the sort passes
+			    &tree_buffer_descriptors[2 + i],        // Binding 3 : Values read by the sort passes
+			    &tree_buffer_descriptors[1 - i],        // Binding 4 : Keys written by the sort passes
+			    &tree_buffer_descriptors[3 - i],        // Binding 5 : Values written by the sort passes
+			    &tree_buffer_descriptors[4],
+			    &tree_buffer_descriptors[5],
+			    &tree_buffer_descriptors[6],
+			    &tree_buffer_descriptors[7]};
+
+			compute_write_descriptor_sets.push_back(vkb::initializers::write_descriptor_set(tree.descriptor_sets[i], VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, &storage_buffer_descriptor));
+			compute_write_descriptor_sets.push_back(vkb::initializers::write_descriptor_set(tree.descriptor_sets[i], VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, &uniform_buffer_descriptor));
+			for (uint32_t binding = 2; binding <= 9; binding++)
+			{
+				compute_write_descriptor_sets.push_back(vkb::initializers::write_descriptor_set(tree.descriptor_sets[i], VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, binding, set_buffer_descriptors[binding - 2]));
+			}
+		}
+	}
+
+	vkUpdateDescriptorSets(get_device().get_handle(), static_cast<uint32_t>(compute_write_descriptor_sets.size()), compute_write_descriptor_sets.data(), 0, NULL);
+}
+
+void ComputeNBody::transfer_storage_buffer_ownership()
+{
 	// If necessary, acquire and immediately release the storage buffer, so that the initial acquire
 	// from the graphics command buffers are matched up properly.
 	if (graphics.queue_family_index != compute.queue_family_index)
@@ -787,7 +1119,8 @@ void ComputeNBody::prepare_uniform_buffers()
 
 void ComputeNBody::update_compute_uniform_buffers(float delta_time)
 {
-	compute.ubo.delta_time = paused ? 0.0f : delta_time;
+	compute.ubo.delta_time    = paused ? 0.0f : delta_time;
+	compute.ubo.opening_angle = opening_angle;
 	compute.uniform_buffer->convert_and_update(compute.ubo);
 }
 
@@ -834,6 +1167,83 @@ void ComputeNBody::draw()
 	VK_CHECK(vkQueueSubmit(compute.queue, 1, &compute_submit_info, compute.fence));
 }
 
+// Compare the accelerations captured by the Barnes-Hut passes with the ones of the CPU solver
+void ComputeNBody::validate_capture()
+{
+	tree.capture->invalidate();
+	const glm::vec4 *captured = reinterpret_cast<const glm::vec4 *>(tree.capture->get_data());
+
+	std::vector<glm::vec4> bodies(num_particles);
+	std::vector<glm::vec3> gpu_accelerations(num_particles);
+	for (uint32_t i = 0; i < num_particles; i++)
+	{
+		bodies[i]            = captured[2 * i];
+		gpu_accelerations[i] = glm::vec3(captured[2 * i + 1]);
+	}
+
+	NBodyCpuSolver::Parameters parameters = interaction;
+	parameters.opening_angle              = opening_angle;
+	NBodyCpuSolver solver(parameters);
+
+	// Scaling of the CPU solver, building the tree and computing the accelerations of all particles
+	std::vector<uint32_t> all_targets(num_particles);
+	std::iota(all_targets.begin(), all_targets.end(), 0);
+	std::vector<glm::vec3> cpu_accelerations(num_particles);
+
+	vkb::Timer timer;
+	validation.thread_count = solver.get_thread_count();
+	solver.set_thread_count(1);
+	timer.start();
+	solver.build_tree(bodies);
+	solver.compute_barnes_hut(all_targets, cpu_accelerations);
+	validation.single_thread_ms = timer.stop<vkb::Timer::Milliseconds>();
+
+	solver.set_thread_count(validation.thread_count);
+	timer.start();
+	solver.build_tree(bodies);
+	solver.compute_barnes_hut(all_targets, cpu_accelerations);
+	validation.multi_thread_ms = timer.stop<vkb::Timer::Milliseconds>();
+
+	// The exact accelerations sum the interactions of all particles, so they are only computed for a random subset
+	validation.sample_count = std::min(num_particles, 1024u);
+	std::vector<uint32_t>                   targets(validation.sample_count);
+	std::default_random_engine              rnd_engine(0);
+	std::uniform_int_distribution<uint32_t> rnd_distribution(0, num_particles - 1);
+	for (auto &target : targets)
+	{
+		target = rnd_distribution(rnd_engine);
+	}
+
+	std::vector<glm::vec3> exact_accelerations(validation.sample_count);
+	solver.compute_all_pairs(bodies, targets, exact_accelerations);
+
+	// Largest and root mean square errors, relative to the magnitude of the reference accelerations
+	auto compare = [&targets](const std::vector<glm::vec3> &accelerations, auto get_reference, float &max_error, float &rms_error) {
+		double sum_squared_errors = 0.0;
+		max_error                 = 0.0f;
+		for (size_t i = 0; i < targets.size(); i++)
+		{
+			glm::vec3 reference = get_reference(i);
+			float     error     = glm::length(accelerations[targets[i]] - reference) / std::max(glm::length(reference), 1e-12f);
+			max_error           = std::max(max_error, error);
+			sum_squared_errors += error * error;
+		}
+		rms_error = static_cast<float>(std::sqrt(sum_squared_errors / targets.size()));
+	};
+
+	float gpu_cpu_rms_error = 0.0f;
+	compare(gpu_accelerations, [&](size_t i) { return exact_accelerations[i]; }, validation.gpu_max_error, validation.gpu_rms_error);
+	compare(cpu_accelerations, [&](size_t i) { return exact_accelerations[i]; }, validation.cpu_max_error, validation.cpu_rms_error);
+	compare(gpu_accelerations, [&](size_t i) { return cpu_accelerations[targets[i]]; }, validation.gpu_cpu_max_error, gpu_cpu_rms_error);
+	validation.valid = true;
+
+	LOGI("Barnes-Hut validation of {} particles on {} samples, opening angle {}:", num_particles, validation.sample_count, opening_angle);
+	LOGI("  GPU relative error: max {:.3e}, rms {:.3e}", validation.gpu_max_error, validation.gpu_rms_error);
+	LOGI("  CPU relative error: max {:.3e}, rms {:.3e}", validation.cpu_max_error, validation.cpu_rms_error);
+	LOGI("  GPU to CPU relative difference: max {:.3e}", validation.gpu_cpu_max_error);
+	LOGI("  CPU solver: {:.1f} ms on 1 thread, {:.1f} ms on {} threads", validation.single_thread_ms, validation.multi_thread_ms, validation.thread_count);
+}
+
 bool ComputeNBody::prepare(const vkb::ApplicationOptions &options)
 {
 	if (!ApiVulkanSample::prepare(options))
@@ -850,6 +1260,20 @@ bool ComputeNBody::prepare(const vkb::ApplicationOptions &options)
 	// Same for shared data size for passing data between shader invocations
 	shared_data_size = std::min(static_cast<uint32_t>(1024), static_cast<uint32_t>(get_device().get_gpu().get_properties().limits.maxComputeSharedMemorySize / sizeof(glm::vec4)));
 
+	// The Barnes-Hut passes are only provided as GLSL shaders, and their SPIR-V may not have been compiled
+	tree_supported = get_shading_language() == vkb::ShadingLanguage::GLSL;
+	if (tree_supported)
+	{
+		tree_spirv_available = std::ranges::all_of(tree_shaders, [this](const char *shader) {
+			return vkb::fs::is_file(vkb::fs::path::get(vkb::fs::path::Shaders, "compute_nbody/" + get_shader_folder() + "/" + shader));
+		});
+		if (!tree_spirv_available)
+		{
+			LOGW("The SPIR-V of the Barnes-Hut passes is missing, the mode is disabled");
+			tree_supported = false;
+		}
+	}
+
 	load_assets();
 	setup_descriptor_pool();
 	prepare_graphics();
@@ -870,6 +1294,47 @@ void ComputeNBody::render(float delta_time)
 	VK_CHECK(vkWaitForFences(get_device().get_handle(), 1, &compute.fence, VK_TRUE, UINT64_MAX));
 	VK_CHECK(vkResetFences(get_device().get_handle(), 1, &compute.fence));
 
+	if (capture_pending)
+	{
+		validate_capture();
+	}
+
+	// The compute command buffer is no longer executing, so its descriptor sets can be written
+	if (barnes_hut && !tree_prepared)
+	{
+		prepare_tree();
+		update_compute_descriptor_sets();
+	}
+
+	if (particles_changed)
+	{
+		// The graphics command buffers may still be reading the particles
+		get_device().wait_idle();
+
+		prepare_storage_buffers();
+		if (tree_prepared)
+		{
+			prepare_tree_buffers();
+		}
+		update_compute_descriptor_sets();
+		transfer_storage_buffer_ownership();
+
+		rebuild_command_buffers();
+	}
+
+	// The compute command buffer is no longer executing, so it can be recorded again
+	if (particles_changed || mode_changed)
+	{
+		VK_CHECK(vkResetCommandPool(get_device().get_handle(), compute.command_pool, 0));
+		build_compute_command_buffer();
+	}
+
+	particles_changed    = false;
+	mode_changed         = false;
+	capture_pending      = barnes_hut && validation_requested;
+	validation_requested = false;
+	compute.ubo.capture  = capture_pending;
+
 	update_compute_uniform_buffers(delta_time);
 	if (camera.updated)
 	{
@@ -885,6 +1350,55 @@ bool ComputeNBody::resize(const uint32_t width, const uint32_t height)
 	return true;
 }
 
+void ComputeNBody::on_update_ui_overlay(vkb::Drawer &drawer)
+{
+	if (drawer.header("Settings"))
+	{
+		if (!tree_supported)
+		{
+			drawer.text(tree_spirv_available ? "Barnes-Hut mode requires GLSL shaders" : "Barnes-Hut mode requires compiled shaders");
+		}
+		else
+		{
+			if (drawer.checkbox("Barnes-Hut", &barnes_hut))
+			{
+				// The particle count is only scaled in Barnes-Hut mode
+				mode_changed      = true;
+				particles_changed = particle_scale != 0;
+			}
+			if (barnes_hut)
+			{
+				drawer.slider_float("Opening angle", &opening_angle, 0.1f, 1.5f);
+
+				std::vector<std::string> scale_names;
+				for (int32_t i = 0; i <= max_particle_scale; i++)
+				{
+					scale_names.push_back("x" + std::to_string(particle_scales[i]));
+				}
+				if (drawer.combo_box("Particles", &particle_scale, scale_names))
+				{
+					particles_changed = true;
+				}
+
+				if (drawer.button("Validate on CPU"))
+				{
+					validation_requested = true;
+				}
+			}
+		}
+		drawer.text("Particles: %u", num_particles);
+	}
+
+	if (validation.valid && drawer.header("Validation"))
+	{
+		drawer.text("Relative errors on %u particles", validation.sample_count);
+		drawer.text("GPU: max %.2e, rms %.2e", validation.gpu_max_error, validation.gpu_rms_error);
+		drawer.text("CPU: max %.2e, rms %.2e", validation.cpu_max_error, validation.cpu_rms_error);
+		drawer.text("GPU to CPU: max %.2e", validation.gpu_cpu_max_error);
+		drawer.text("CPU solver: %.1f ms, %.1f ms on %u threads", validation.single_thread_ms, validation.multi_thread_ms, validation.thread_count);
+	}
+}
+
 std::unique_ptr<vkb::Application> create_compute_nbody()
 {
 	return std::make_unique<ComputeNBody>();
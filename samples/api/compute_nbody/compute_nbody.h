@@ -17,11 +17,13 @@
 
 /*
  * Compute shader N-body simulation using two passes and shared compute shader memory
+ * The Barnes-Hut mode replaces the first pass with passes building and walking a tree of the particles
  */
 
 #pragma once
 
 #include "api_vulkan_sample.h"
+#include "nbody_cpu_solver.h"
 
 #if defined(__ANDROID__)
 // Lower particle count on Android for performance reasons
@@ -82,12 +84,67 @@ class ComputeNBody : public ApiVulkanSample
 		VkDescriptorSet                     descriptor_set_blur;
 		uint32_t                            queue_family_index;
 		struct ComputeUBO
-		{                              // Compute shader uniform block object
-			float   delta_time;        //		Frame delta time
-			int32_t particle_count;
+		{                               // Compute shader uniform block object
+			float    delta_time;        //		Frame delta time
+			int32_t  particle_count;
+			float    opening_angle;        //		Ratio of the size of a tree node to its distance below which it acts as a single particle
+			uint32_t capture;              //		Whether the Barnes-Hut passes write the accelerations into the capture buffer
 		} ubo;
 	} compute;
 
+	// Resources of the Barnes-Hut mode, which sorts the particles along a Morton curve and builds a tree over them
+	struct
+	{
+		std::unique_ptr<vkb::core::BufferC> keys[2];          // Morton codes of the particles, sorted back and forth between both buffers
+		std::unique_ptr<vkb::core::BufferC> values[2];        // Particle indices, moved along with their keys
+		std::unique_ptr<vkb::core::BufferC> histogram;        // Number of keys of each digit in each tile of a sort pass
+		std::unique_ptr<vkb::core::BufferC> nodes;            // Internal nodes of the tree, followed by its leaves
+		std::unique_ptr<vkb::core::BufferC> bounds;           // Bounds of the particles
+		std::unique_ptr<vkb::core::BufferC> capture;          // Positions and accelerations read back to validate the passes
+		VkDescriptorSetLayout               descriptor_set_layout = VK_NULL_HANDLE;
+		VkDescriptorSet                     descriptor_sets[2]    = {};        // Passes reading the keys from the first or the second buffers
+		VkPipelineLayout                    pipeline_layout       = VK_NULL_HANDLE;
+		VkPipeline                          bounds_pipeline       = VK_NULL_HANDLE;
+		VkPipeline                          morton_pipeline       = VK_NULL_HANDLE;
+		VkPipeline                          histogram_pipeline    = VK_NULL_HANDLE;
+		VkPipeline                          scan_pipeline         = VK_NULL_HANDLE;
+		VkPipeline                          scatter_pipeline      = VK_NULL_HANDLE;
+		VkPipeline                          build_pipeline        = VK_NULL_HANDLE;
+		VkPipeline                          summarize_pipeline    = VK_NULL_HANDLE;
+		VkPipeline                          force_pipeline        = VK_NULL_HANDLE;
+		uint32_t                            sort_group_count      = 0;        // Number of tiles of keys sorted by a workgroup
+	} tree;
+
+	// Accuracy of the GPU accelerations and performance of the CPU solver, from the last validation
+	struct
+	{
+		bool     valid             = false;
+		uint32_t sample_count      = 0;
+		float    gpu_max_error     = 0.0f;        // GPU Barnes-Hut against the exact accelerations
+		float    gpu_rms_error     = 0.0f;
+		float    cpu_max_error     = 0.0f;        // CPU Barnes-Hut against the exact accelerations
+		float    cpu_rms_error     = 0.0f;
+		float    gpu_cpu_max_error = 0.0f;        // GPU Barnes-Hut against CPU Barnes-Hut, which walk the same tree
+		uint32_t thread_count      = 1;
+		double   single_thread_ms  = 0.0;        // Time to build the tree and compute the accelerations of all particles
+		double   multi_thread_ms   = 0.0;
+	} validation;
+
+	bool    barnes_hut           = false;
+	bool    tree_supported       = false;
+	bool    tree_spirv_available = true;        // False if the SPIR-V of the Barnes-Hut passes is missing
+	bool    tree_prepared        = false;        // The Barnes-Hut pipelines are only created once the mode is selected
+	float   opening_angle        = 0.5f;
+	int32_t particle_scale       = 0;        // Index of the multiplier of the particles per attractor, in Barnes-Hut mode
+	int32_t max_particle_scale   = 0;        // Largest index whose tree fits in a storage buffer
+	bool    particles_changed    = false;
+	bool    mode_changed         = false;
+	bool    validation_requested = false;
+	bool    capture_pending      = false;        // Whether the last dispatch wrote the accelerations into the capture buffer
+
+	// Constants of the interactions, shared by the compute shaders and the CPU solver
+	NBodyCpuSolver::Parameters interaction;
+
 	// SSBO particle declaration
 	struct Particle
 	{
@@ -95,6 +152,13 @@ class ComputeNBody : public ApiVulkanSample
 		glm::vec4 vel;        // xyz = velocity, w = gradient texture position
 	};
 
+	// Push constants of the Barnes-Hut passes
+	struct TreePushConstants
+	{
+		uint32_t shift;              // First bit of the digit of a sort pass
+		uint32_t group_count;        // Number of tiles of the sort
+	};
+
 	ComputeNBody();
 	~ComputeNBody();
 	virtual void request_gpu_features(vkb::core::PhysicalDeviceC &gpu) override;
@@ -102,19 +166,26 @@ class ComputeNBody : public ApiVulkanSample
 	void         build_command_buffers() override;
 	void         build_compute_command_buffer();
 	void         prepare_storage_buffers();
+	void         prepare_tree_buffers();
+	void         update_compute_descriptor_sets();
+	void         transfer_storage_buffer_ownership();
+	void         record_tree_passes();
 	void         setup_descriptor_pool();
 	void         setup_descriptor_set_layout();
 	void         setup_descriptor_set();
 	void         prepare_pipelines();
 	void         prepare_graphics();
 	void         prepare_compute();
+	void         prepare_tree();
 	void         prepare_uniform_buffers();
 	void         update_compute_uniform_buffers(float delta_time);
 	void         update_graphics_uniform_buffers();
 	void         draw();
+	void         validate_capture();
 	bool         prepare(const vkb::ApplicationOptions &options) override;
 	virtual void render(float delta_time) override;
 	virtual bool resize(const uint32_t width, const uint32_t height) override;
+	virtual void on_update_ui_overlay(vkb::Drawer &drawer) override;
 };
 
 std::unique_ptr<vkb::Application> create_compute_nbody();
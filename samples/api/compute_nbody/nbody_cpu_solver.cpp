@@ -0,0 +1,447 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nbody_cpu_solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <thread>
+
+// vsqrtq_f32, vdivq_f32 and vaddvq_f32 are only available on AArch64
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	include <xmmintrin.h>
+#	define VKB_NBODY_SSE
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#	include <arm_neon.h>
+#	define VKB_NBODY_NEON
+#endif
+
+namespace
+{
+// Items processed by a worker thread before fetching the next range
+constexpr size_t PARALLEL_RANGE_SIZE = 64;
+
+// Bodies gathered from the tree before evaluating their interactions
+constexpr size_t INTERACTION_BATCH_SIZE = 64;
+
+// Interleaves the bits of a 10 bit integer with two zero bits, as the GPU passes
+uint32_t expand_bits(uint32_t value)
+{
+	value = (value * 0x00010001u) & 0xFF0000FFu;
+	value = (value * 0x00000101u) & 0x0F00F00Fu;
+	value = (value * 0x00000011u) & 0xC30C30C3u;
+	value = (value * 0x00000005u) & 0x49249249u;
+	return value;
+}
+
+/**
+ * @brief Bodies stored as arrays of coordinates and masses
+ */
+struct BodyArrays
+{
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+	std::vector<float> mass;
+
+	void push_back(const glm::vec4 &body)
+	{
+		x.push_back(body.x);
+		y.push_back(body.y);
+		z.push_back(body.z);
+		mass.push_back(body.w);
+	}
+
+	void clear()
+	{
+		x.clear();
+		y.clear();
+		z.clear();
+		mass.clear();
+	}
+
+	size_t size() const
+	{
+		return mass.size();
+	}
+};
+}        // namespace
+
+NBodyCpuSolver::NBodyCpuSolver(const Parameters &parameters, uint32_t thread_count) :
+    parameters{parameters}
+{
+	set_thread_count(thread_count);
+
+	float quarters = parameters.power * 4.0f;
+	if (quarters >= 1.0f && quarters <= 8.0f && quarters == std::round(quarters))
+	{
+		power_quarters = static_cast<uint32_t>(quarters);
+	}
+}
+
+void NBodyCpuSolver::set_thread_count(uint32_t thread_count_)
+{
+	thread_count = thread_count_ != 0 ? thread_count_ : std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+uint32_t NBodyCpuSolver::get_thread_count() const
+{
+	return thread_count;
+}
+
+void NBodyCpuSolver::compute_all_pairs(std::span<const glm::vec4> bodies, std::span<const uint32_t> targets, std::span<glm::vec3> accelerations) const
+{
+	assert(accelerations.size() >= targets.size());
+
+	BodyArrays arrays;
+	for (auto &body : bodies)
+	{
+		arrays.push_back(body);
+	}
+
+	parallel_for(targets.size(), [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			// A body does not accelerate itself, as its offset is zero
+			accelerations[i] = accumulate(glm::vec3(bodies[targets[i]]), arrays.x.data(), arrays.y.data(), arrays.z.data(), arrays.mass.data(), arrays.size());
+		}
+	});
+}
+
+void NBodyCpuSolver::build_tree(std::span<const glm::vec4> bodies)
+{
+	int32_t count = static_cast<int32_t>(bodies.size());
+	if (count == 0)
+	{
+		sorted_keys.clear();
+		sorted_indices.clear();
+		nodes.clear();
+		return;
+	}
+
+	glm::vec3 bounds_min{bodies[0]};
+	glm::vec3 bounds_max{bodies[0]};
+	for (auto &body : bodies)
+	{
+		bounds_min = glm::min(bounds_min, glm::vec3(body));
+		bounds_max = glm::max(bounds_max, glm::vec3(body));
+	}
+
+	glm::vec3 extent = bounds_max - bounds_min;
+	float     size   = std::max(std::max(extent.x, extent.y), std::max(extent.z, 1e-6f));
+
+	sorted_keys.resize(count);
+	parallel_for(count, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			glm::uvec3 cell = glm::uvec3(glm::clamp((glm::vec3(bodies[i]) - bounds_min) / size * 1024.0f, glm::vec3(0.0f), glm::vec3(1023.0f)));
+			uint64_t   code = expand_bits(cell.x) * 4u + expand_bits(cell.y) * 2u + expand_bits(cell.z);
+			sorted_keys[i]  = (code << 32) | i;
+		}
+	});
+
+	// Bodies with the same code keep their order, as with the stable radix sort of the GPU passes
+	std::sort(sorted_keys.begin(), sorted_keys.end());
+
+	int32_t leaf_offset = count - 1;
+	nodes.assign(2 * count - 1, {});
+	sorted_indices.resize(count);
+	for (int32_t leaf = 0; leaf < count; ++leaf)
+	{
+		uint32_t index        = static_cast<uint32_t>(sorted_keys[leaf]);
+		sorted_indices[index] = leaf;
+
+		Node &node          = nodes[leaf_offset + leaf];
+		node.center_of_mass = bodies[index];
+		node.bounds_min     = glm::vec3(bodies[index]);
+		node.bounds_max     = glm::vec3(bodies[index]);
+	}
+
+	// Internal nodes are built independently from the range of bodies they cover (Karras 2012)
+	parallel_for(count - 1, [&](size_t begin, size_t end) {
+		for (int32_t i = static_cast<int32_t>(begin); i < static_cast<int32_t>(end); ++i)
+		{
+			int32_t direction  = common_prefix(i, i + 1) > common_prefix(i, i - 1) ? 1 : -1;
+			int32_t min_prefix = common_prefix(i, i - direction);
+
+			int32_t max_length = 2;
+			while (common_prefix(i, i + max_length * direction) > min_prefix)
+			{
+				max_length *= 2;
+			}
+
+			int32_t length = 0;
+			for (int32_t step = max_length / 2; step >= 1; step /= 2)
+			{
+				if (common_prefix(i, i + (length + step) * direction) > min_prefix)
+				{
+					length += step;
+				}
+			}
+
+			int32_t j           = i + length * direction;
+			int32_t node_prefix = common_prefix(i, j);
+
+			int32_t split = 0;
+			for (int32_t divisor = 2;; divisor *= 2)
+			{
+				int32_t step = (length + divisor - 1) / divisor;
+				if (common_prefix(i, i + (split + step) * direction) > node_prefix)
+				{
+					split += step;
+				}
+				if (step <= 1)
+				{
+					break;
+				}
+			}
+
+			int32_t gamma  = i + split * direction + std::min(direction, 0);
+			nodes[i].left  = std::min(i, j) == gamma ? leaf_offset + gamma : gamma;
+			nodes[i].right = std::max(i, j) == gamma + 1 ? leaf_offset + gamma + 1 : gamma + 1;
+		}
+	});
+
+	if (count > 1)
+	{
+		summarize(0);
+	}
+}
+
+void NBodyCpuSolver::compute_barnes_hut(std::span<const uint32_t> targets, std::span<glm::vec3> accelerations) const
+{
+	assert(accelerations.size() >= targets.size());
+
+	int32_t leaf_offset = static_cast<int32_t>(sorted_indices.size()) - 1;
+	float   opening_2   = parameters.opening_angle * parameters.opening_angle;
+
+	parallel_for(targets.size(), [&](size_t begin, size_t end) {
+		BodyArrays           batch;
+		std::vector<int32_t> stack;
+
+		for (size_t i = begin; i < end; ++i)
+		{
+			int32_t   self     = leaf_offset + static_cast<int32_t>(sorted_indices[targets[i]]);
+			glm::vec3 position = glm::vec3(nodes[self].center_of_mass);
+			glm::vec3 acceleration{0.0f};
+
+			stack.assign(1, 0);
+			while (!stack.empty())
+			{
+				int32_t index = stack.back();
+				stack.pop_back();
+
+				const Node &node   = nodes[index];
+				glm::vec3   offset = glm::vec3(node.center_of_mass) - position;
+				if (index >= leaf_offset)
+				{
+					if (index != self)
+					{
+						batch.push_back(node.center_of_mass);
+					}
+				}
+				else if (node.size * node.size < opening_2 * glm::dot(offset, offset))
+				{
+					batch.push_back(node.center_of_mass);
+				}
+				else
+				{
+					stack.push_back(node.left);
+					stack.push_back(node.right);
+				}
+
+				if (batch.size() == INTERACTION_BATCH_SIZE)
+				{
+					acceleration += accumulate(position, batch.x.data(), batch.y.data(), batch.z.data(), batch.mass.data(), batch.size());
+					batch.clear();
+				}
+			}
+
+			acceleration += accumulate(position, batch.x.data(), batch.y.data(), batch.z.data(), batch.mass.data(), batch.size());
+			batch.clear();
+
+			accelerations[i] = acceleration;
+		}
+	});
+}
+
+int32_t NBodyCpuSolver::common_prefix(int32_t i, int32_t j) const
+{
+	if (j < 0 || j >= static_cast<int32_t>(sorted_keys.size()))
+	{
+		return -1;
+	}
+
+	// Equal codes are told apart by the position of the bodies in the sorted bodies
+	uint32_t code_i = static_cast<uint32_t>(sorted_keys[i] >> 32);
+	uint32_t code_j = static_cast<uint32_t>(sorted_keys[j] >> 32);
+	return code_i != code_j ? std::countl_zero(code_i ^ code_j) : 32 + std::countl_zero(static_cast<uint32_t>(i ^ j));
+}
+
+void NBodyCpuSolver::summarize(int32_t index)
+{
+	int32_t leaf_offset = static_cast<int32_t>(sorted_indices.size()) - 1;
+	if (index >= leaf_offset)
+	{
+		return;
+	}
+
+	Node &node = nodes[index];
+	summarize(node.left);
+	summarize(node.right);
+
+	const Node &left  = nodes[node.left];
+	const Node &right = nodes[node.right];
+
+	float     mass   = left.center_of_mass.w + right.center_of_mass.w;
+	glm::vec3 center = 0.5f * (glm::vec3(left.center_of_mass) + glm::vec3(right.center_of_mass));
+	if (mass > 0.0f)
+	{
+		center = (glm::vec3(left.center_of_mass) * left.center_of_mass.w + glm::vec3(right.center_of_mass) * right.center_of_mass.w) / mass;
+	}
+
+	node.center_of_mass = glm::vec4(center, mass);
+	node.bounds_min     = glm::min(left.bounds_min, right.bounds_min);
+	node.bounds_max     = glm::max(left.bounds_max, right.bounds_max);
+
+	glm::vec3 extent = node.bounds_max - node.bounds_min;
+	node.size        = std::max(extent.x, std::max(extent.y, extent.z));
+}
+
+glm::vec3 NBodyCpuSolver::accumulate(const glm::vec3 &target, const float *x, const float *y, const float *z, const float *mass, size_t count) const
+{
+	glm::vec3 acceleration{0.0f};
+	size_t    i = 0;
+
+	// The power is computed from the fourth root of the squared distances, a multiple of a quarter needs no pow
+	if (power_quarters != 0)
+	{
+#if defined(VKB_NBODY_SSE)
+		const __m128 target_x = _mm_set1_ps(target.x);
+		const __m128 target_y = _mm_set1_ps(target.y);
+		const __m128 target_z = _mm_set1_ps(target.z);
+		const __m128 gravity  = _mm_set1_ps(parameters.gravity);
+		const __m128 soften   = _mm_set1_ps(parameters.soften);
+
+		__m128 sum_x = _mm_setzero_ps();
+		__m128 sum_y = _mm_setzero_ps();
+		__m128 sum_z = _mm_setzero_ps();
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(&x[i]), target_x);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(&y[i]), target_y);
+			__m128 dz = _mm_sub_ps(_mm_loadu_ps(&z[i]), target_z);
+
+			__m128 distance_2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_add_ps(_mm_mul_ps(dz, dz), soften));
+			__m128 root       = _mm_sqrt_ps(_mm_sqrt_ps(distance_2));
+			__m128 divisor    = root;
+			for (uint32_t quarter = 1; quarter < power_quarters; ++quarter)
+			{
+				divisor = _mm_mul_ps(divisor, root);
+			}
+
+			__m128 scale = _mm_div_ps(_mm_mul_ps(gravity, _mm_loadu_ps(&mass[i])), divisor);
+			sum_x        = _mm_add_ps(sum_x, _mm_mul_ps(dx, scale));
+			sum_y        = _mm_add_ps(sum_y, _mm_mul_ps(dy, scale));
+			sum_z        = _mm_add_ps(sum_z, _mm_mul_ps(dz, scale));
+		}
+
+		alignas(16) float lanes[3][4];
+		_mm_store_ps(lanes[0], sum_x);
+		_mm_store_ps(lanes[1], sum_y);
+		_mm_store_ps(lanes[2], sum_z);
+		acceleration = glm::vec3(lanes[0][0] + lanes[0][1] + lanes[0][2] + lanes[0][3],
+		                         lanes[1][0] + lanes[1][1] + lanes[1][2] + lanes[1][3],
+		                         lanes[2][0] + lanes[2][1] + lanes[2][2] + lanes[2][3]);
+#elif defined(VKB_NBODY_NEON)
+		const float32x4_t target_x = vdupq_n_f32(target.x);
+		const float32x4_t target_y = vdupq_n_f32(target.y);
+		const float32x4_t target_z = vdupq_n_f32(target.z);
+		const float32x4_t soften   = vdupq_n_f32(parameters.soften);
+
+		float32x4_t sum_x = vdupq_n_f32(0.0f);
+		float32x4_t sum_y = vdupq_n_f32(0.0f);
+		float32x4_t sum_z = vdupq_n_f32(0.0f);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4_t dx = vsubq_f32(vld1q_f32(&x[i]), target_x);
+			float32x4_t dy = vsubq_f32(vld1q_f32(&y[i]), target_y);
+			float32x4_t dz = vsubq_f32(vld1q_f32(&z[i]), target_z);
+
+			float32x4_t distance_2 = vmlaq_f32(vmlaq_f32(vmlaq_f32(soften, dx, dx), dy, dy), dz, dz);
+			float32x4_t root       = vsqrtq_f32(vsqrtq_f32(distance_2));
+			float32x4_t divisor    = root;
+			for (uint32_t quarter = 1; quarter < power_quarters; ++quarter)
+			{
+				divisor = vmulq_f32(divisor, root);
+			}
+
+			float32x4_t scale = vdivq_f32(vmulq_n_f32(vld1q_f32(&mass[i]), parameters.gravity), divisor);
+			sum_x             = vmlaq_f32(sum_x, dx, scale);
+			sum_y             = vmlaq_f32(sum_y, dy, scale);
+			sum_z             = vmlaq_f32(sum_z, dz, scale);
+		}
+
+		acceleration = glm::vec3(vaddvq_f32(sum_x), vaddvq_f32(sum_y), vaddvq_f32(sum_z));
+#endif
+	}
+
+	for (; i < count; ++i)
+	{
+		glm::vec3 offset = glm::vec3(x[i], y[i], z[i]) - target;
+		acceleration += parameters.gravity * offset * mass[i] / std::pow(glm::dot(offset, offset) + parameters.soften, parameters.power);
+	}
+
+	return acceleration;
+}
+
+void NBodyCpuSolver::parallel_for(size_t count, const std::function<void(size_t begin, size_t end)> &function) const
+{
+	size_t worker_count = std::min<size_t>(thread_count, (count + PARALLEL_RANGE_SIZE - 1) / PARALLEL_RANGE_SIZE);
+	if (worker_count <= 1)
+	{
+		function(0, count);
+		return;
+	}
+
+	// Ranges are fetched as the workers complete them, which balances the cost of the targets walking more nodes
+	std::atomic<size_t> next_begin{0};
+
+	auto worker = [&]() {
+		for (size_t begin = next_begin.fetch_add(PARALLEL_RANGE_SIZE); begin < count; begin = next_begin.fetch_add(PARALLEL_RANGE_SIZE))
+		{
+			function(begin, std::min(begin + PARALLEL_RANGE_SIZE, count));
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < worker_count; ++i)
+	{
+		workers.emplace_back(worker);
+	}
+	worker();
+
+	for (auto &thread : workers)
+	{
+		thread.join();
+	}
+}
@@ -0,0 +1,130 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "common/glm_common.h"
+
+/**
+ * @brief CPU reference of the accelerations of the N-body simulation, used to validate the GPU passes
+ *
+ * The exact accelerations sum the interactions with all the bodies. The Barnes-Hut accelerations use the same tree as
+ * the GPU passes: the bodies are sorted along a Morton curve, then organized into a binary radix tree over their Morton
+ * codes, whose nodes act as a single body when they are small compared to their distance.
+ *
+ * Interactions are evaluated four at a time with SSE or NEON when the exponent of the interactions is a multiple of a
+ * quarter, and the targets are spread over worker threads.
+ */
+class NBodyCpuSolver
+{
+  public:
+	/**
+	 * @brief Constants of the interactions, an interaction accelerates a body by
+	 *        gravity * offset * mass / pow(dot(offset, offset) + soften, power)
+	 */
+	struct Parameters
+	{
+		float gravity = 0.002f;
+
+		float power = 0.75f;
+
+		float soften = 0.05f;
+
+		// Ratio of the size of a node to its distance below which it acts as a single body
+		float opening_angle = 0.5f;
+	};
+
+	/**
+	 * @param thread_count Number of threads evaluating the accelerations, all the hardware threads if zero
+	 */
+	explicit NBodyCpuSolver(const Parameters &parameters, uint32_t thread_count = 0);
+
+	void set_thread_count(uint32_t thread_count);
+
+	uint32_t get_thread_count() const;
+
+	/**
+	 * @brief Computes the exact accelerations of some of the bodies
+	 * @param bodies Positions of the bodies in xyz, and their mass in w
+	 * @param targets Indices of the bodies whose acceleration is computed
+	 * @param accelerations Acceleration of each target
+	 */
+	void compute_all_pairs(std::span<const glm::vec4> bodies, std::span<const uint32_t> targets, std::span<glm::vec3> accelerations) const;
+
+	/**
+	 * @brief Builds the tree of the bodies, used by compute_barnes_hut
+	 */
+	void build_tree(std::span<const glm::vec4> bodies);
+
+	/**
+	 * @brief Computes the approximate accelerations of some of the bodies of the tree
+	 * @param targets Indices of the bodies whose acceleration is computed, in the bodies the tree was built from
+	 * @param accelerations Acceleration of each target
+	 */
+	void compute_barnes_hut(std::span<const uint32_t> targets, std::span<glm::vec3> accelerations) const;
+
+  private:
+	struct Node
+	{
+		glm::vec4 center_of_mass{0.0f};        // xyz: center of mass, w: mass
+
+		glm::vec3 bounds_min{0.0f};
+
+		float size = 0.0f;        // Largest extent of the bounds
+
+		glm::vec3 bounds_max{0.0f};
+
+		int32_t left = -1;
+
+		int32_t right = -1;
+	};
+
+	int32_t common_prefix(int32_t i, int32_t j) const;
+
+	void summarize(int32_t node);
+
+	/**
+	 * @return The acceleration of a target from bodies given as arrays of coordinates and masses
+	 */
+	glm::vec3 accumulate(const glm::vec3 &target, const float *x, const float *y, const float *z, const float *mass, size_t count) const;
+
+	/**
+	 * @brief Calls a function on ranges of items from the worker threads, until all the items are processed
+	 */
+	void parallel_for(size_t count, const std::function<void(size_t begin, size_t end)> &function) const;
+
+	Parameters parameters;
+
+	uint32_t thread_count = 1;
+
+	// Exponent of the interactions in quarters, or 0 if it is not a multiple of a quarter
+	uint32_t power_quarters = 0;
+
+	// Morton code of the sorted bodies in the high bits, and their index in the low bits
+	std::vector<uint64_t> sorted_keys;
+
+	// Position of each body in the sorted bodies
+	std::vector<uint32_t> sorted_indices;
+
+	// Internal nodes, followed by one leaf per sorted body
+	std::vector<Node> nodes;
+};
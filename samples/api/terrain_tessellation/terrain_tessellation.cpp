@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Sascha Willems
+/* Copyright (c) 2019-2026, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -21,7 +21,7 @@
 
 #include "terrain_tessellation.h"
 
-#include "heightmap.h"
+#include <filesystem/filesystem.hpp>
 
 TerrainTessellation::TerrainTessellation()
 {
@@ -137,37 +137,15 @@ void TerrainTessellation::load_assets()
 	// Terrain textures are stored in a texture array with layers corresponding to terrain height
 	textures.terrain_array = load_texture_array("textures/terrain_texturearray_rgba.ktx", vkb::sg::Image::Color);
 
-	// Height data is stored in a one-channel texture
-	textures.heightmap = load_texture("textures/terrain_heightmap_r16.ktx", vkb::sg::Image::Other);
-
 	VkSamplerCreateInfo sampler_create_info = vkb::initializers::sampler_create_info();
 
 	// Calculate valid filter and mipmap modes
 	VkFilter            filter      = VK_FILTER_LINEAR;
 	VkSamplerMipmapMode mipmap_mode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-	vkb::make_filters_valid(get_device().get_gpu().get_handle(), textures.heightmap.image->get_format(), &filter, &mipmap_mode);
-
-	// Setup a mirroring sampler for the height map
-	vkDestroySampler(get_device().get_handle(), textures.heightmap.sampler, nullptr);
-	sampler_create_info.magFilter    = filter;
-	sampler_create_info.minFilter    = filter;
-	sampler_create_info.mipmapMode   = mipmap_mode;
-	sampler_create_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-	sampler_create_info.addressModeV = sampler_create_info.addressModeU;
-	sampler_create_info.addressModeW = sampler_create_info.addressModeU;
-	sampler_create_info.compareOp    = VK_COMPARE_OP_NEVER;
-	sampler_create_info.minLod       = 0.0f;
-	sampler_create_info.maxLod       = static_cast<float>(textures.heightmap.image->get_mipmaps().size());
-	sampler_create_info.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
-	VK_CHECK(vkCreateSampler(get_device().get_handle(), &sampler_create_info, nullptr, &textures.heightmap.sampler));
-
-	filter      = VK_FILTER_LINEAR;
-	mipmap_mode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
 	vkb::make_filters_valid(get_device().get_gpu().get_handle(), textures.terrain_array.image->get_format(), &filter, &mipmap_mode);
 
 	// Setup a repeating sampler for the terrain texture layers
 	vkDestroySampler(get_device().get_handle(), textures.terrain_array.sampler, nullptr);
-	sampler_create_info              = vkb::initializers::sampler_create_info();
 	sampler_create_info.magFilter    = filter;
 	sampler_create_info.minFilter    = filter;
 	sampler_create_info.mipmapMode   = mipmap_mode;
@@ -187,6 +165,16 @@ void TerrainTessellation::load_assets()
 }
 
 void TerrainTessellation::build_command_buffers()
+{
+	create_patch_buffers();
+	for (uint32_t i = 0; i < draw_cmd_buffers.size(); ++i)
+	{
+		build_command_buffer(i);
+	}
+}
+
+// Records a draw command buffer, which reads the patch buffers of the same index
+void TerrainTessellation::build_command_buffer(uint32_t index)
 {
 	VkCommandBufferBeginInfo command_buffer_begin_info = vkb::initializers::command_buffer_begin_info();
 
@@ -202,171 +190,197 @@ void TerrainTessellation::build_command_buffers()
 	render_pass_begin_info.renderArea.extent.height = height;
 	render_pass_begin_info.clearValueCount          = 2;
 	render_pass_begin_info.pClearValues             = clear_values;
+	render_pass_begin_info.framebuffer              = framebuffers[index];
 
-	for (int32_t i = 0; i < draw_cmd_buffers.size(); ++i)
-	{
-		render_pass_begin_info.framebuffer = framebuffers[i];
+	VkCommandBuffer     command_buffer = draw_cmd_buffers[index];
+	const PatchBuffers &patch_buffers  = terrain.patch_buffers[index];
 
-		VK_CHECK(vkBeginCommandBuffer(draw_cmd_buffers[i], &command_buffer_begin_info));
+	VK_CHECK(vkBeginCommandBuffer(command_buffer, &command_buffer_begin_info));
 
-		if (get_device().get_gpu().get_features().pipelineStatisticsQuery)
-		{
-			vkCmdResetQueryPool(draw_cmd_buffers[i], query_pool, 0, 2);
-		}
+	if (get_device().get_gpu().get_features().pipelineStatisticsQuery)
+	{
+		vkCmdResetQueryPool(command_buffer, query_pool, 0, 2);
+	}
 
-		vkCmdBeginRenderPass(draw_cmd_buffers[i], &render_pass_begin_info, VK_SUBPASS_CONTENTS_INLINE);
+	vkCmdBeginRenderPass(command_buffer, &render_pass_begin_info, VK_SUBPASS_CONTENTS_INLINE);
 
-		VkViewport viewport = vkb::initializers::viewport(static_cast<float>(width), static_cast<float>(height), 0.0f, 1.0f);
-		vkCmdSetViewport(draw_cmd_buffers[i], 0, 1, &viewport);
+	VkViewport viewport = vkb::initializers::viewport(static_cast<float>(width), static_cast<float>(height), 0.0f, 1.0f);
+	vkCmdSetViewport(command_buffer, 0, 1, &viewport);
 
-		VkRect2D scissor = vkb::initializers::rect2D(width, height, 0, 0);
-		vkCmdSetScissor(draw_cmd_buffers[i], 0, 1, &scissor);
+	VkRect2D scissor = vkb::initializers::rect2D(width, height, 0, 0);
+	vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
-		vkCmdSetLineWidth(draw_cmd_buffers[i], 1.0f);
+	vkCmdSetLineWidth(command_buffer, 1.0f);
 
-		VkDeviceSize offsets[1] = {0};
+	VkDeviceSize offsets[1] = {0};
 
-		// Skysphere
-		vkCmdBindPipeline(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.skysphere);
-		vkCmdBindDescriptorSets(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layouts.skysphere, 0, 1, &descriptor_sets.skysphere, 0, NULL);
-		draw_model(skysphere, draw_cmd_buffers[i]);
+	// Skysphere
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelines.skysphere);
+	vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layouts.skysphere, 0, 1, &descriptor_sets.skysphere, 0, NULL);
+	draw_model(skysphere, command_buffer);
 
-		// Terrain
-		if (get_device().get_gpu().get_features().pipelineStatisticsQuery)
-		{
-			// Begin pipeline statistics query
-			vkCmdBeginQuery(draw_cmd_buffers[i], query_pool, 0, 0);
-		}
-		// Render
-		vkCmdBindPipeline(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, wireframe ? pipelines.wireframe : pipelines.terrain);
-		vkCmdBindDescriptorSets(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layouts.terrain, 0, 1, &descriptor_sets.terrain, 0, NULL);
-		vkCmdBindVertexBuffers(draw_cmd_buffers[i], 0, 1, terrain.vertices->get(), offsets);
-		vkCmdBindIndexBuffer(draw_cmd_buffers[i], terrain.indices->get_handle(), 0, VK_INDEX_TYPE_UINT32);
-		vkCmdDrawIndexed(draw_cmd_buffers[i], terrain.index_count, 1, 0, 0, 0);
-		if (get_device().get_gpu().get_features().pipelineStatisticsQuery)
-		{
-			// End pipeline statistics query
-			vkCmdEndQuery(draw_cmd_buffers[i], query_pool, 0);
-		}
+	// Terrain
+	if (get_device().get_gpu().get_features().pipelineStatisticsQuery)
+	{
+		// Begin pipeline statistics query
+		vkCmdBeginQuery(command_buffer, query_pool, 0, 0);
+	}
+	// Render
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, wireframe ? pipelines.wireframe : pipelines.terrain);
+	vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layouts.terrain, 0, 1, &descriptor_sets.terrain, 0, NULL);
+	vkCmdBindVertexBuffers(command_buffer, 0, 1, patch_buffers.vertices->get(), offsets);
+	vkCmdBindIndexBuffer(command_buffer, patch_buffers.indices->get_handle(), 0, VK_INDEX_TYPE_UINT32);
+	vkCmdDrawIndexed(command_buffer, patch_buffers.index_count, 1, 0, 0, 0);
+	if (get_device().get_gpu().get_features().pipelineStatisticsQuery)
+	{
+		// End pipeline statistics query
+		vkCmdEndQuery(command_buffer, query_pool, 0);
+	}
 
-		draw_ui(draw_cmd_buffers[i]);
+	draw_ui(command_buffer);
 
-		vkCmdEndRenderPass(draw_cmd_buffers[i]);
+	vkCmdEndRenderPass(command_buffer);
 
-		VK_CHECK(vkEndCommandBuffer(draw_cmd_buffers[i]));
-	}
+	VK_CHECK(vkEndCommandBuffer(command_buffer));
 }
 
-// Generate a terrain quad patch for feeding to the tessellation control shader
+// Set up the streamed terrain, whose quad patches are fed to the tessellation control shader
 void TerrainTessellation::generate_terrain()
 {
-	const uint32_t      patch_size   = 64;
-	const float         uv_scale     = 1.0f;
-	const uint32_t      vertex_count = patch_size * patch_size;
-	std::vector<Vertex> vertices(vertex_count);
-
-	const float wx = 2.0f;
-	const float wy = 2.0f;
-
-	for (auto x = 0; x < patch_size; x++)
+	const uint32_t tile_size  = 32;
+	const uint32_t max_nodes  = 64;
+	const float    world_size = 128.0f;
+
+	// The heightmap is split into tiles once, the tiles are then streamed from the tile file as the view needs them
+	auto                  fs        = vkb::filesystem::get();
+	std::filesystem::path tile_file = fs->temp_directory() / "terrain_heightmap_r16.tiles";
+	if (!fs->exists(tile_file))
 	{
-		for (auto y = 0; y < patch_size; y++)
-		{
-			uint32_t index         = (x + y * patch_size);
-			vertices[index].pos[0] = x * wx + wx / 2.0f - static_cast<float>(patch_size) * wx / 2.0f;
-			vertices[index].pos[1] = 0.0f;
-			vertices[index].pos[2] = y * wy + wy / 2.0f - static_cast<float>(patch_size) * wy / 2.0f;
-			vertices[index].uv     = glm::vec2(static_cast<float>(x) / patch_size, static_cast<float>(y) / patch_size) * uv_scale;
-		}
+		vkb::HeightTilePyramid::create_tile_file("textures/terrain_heightmap_r16.ktx", tile_file, tile_size);
 	}
 
-	// Calculate normals from height map using a sobel filter
-	vkb::HeightMap heightmap("textures/terrain_heightmap_r16.ktx", patch_size);
-	for (auto x = 0; x < patch_size; x++)
-	{
-		for (auto y = 0; y < patch_size; y++)
-		{
-			// Get height samples centered around current position
-			float heights[3][3];
-			for (auto hx = -1; hx <= 1; hx++)
-			{
-				for (auto hy = -1; hy <= 1; hy++)
-				{
-					heights[hx + 1][hy + 1] = heightmap.get_height(x + hx, y + hy);
-				}
-			}
+	terrain.pyramid  = std::make_unique<vkb::HeightTilePyramid>(tile_file, 4 * max_nodes);
+	terrain.quadtree = std::make_unique<vkb::TerrainQuadtree>(*terrain.pyramid, world_size, ubo_tess.displacement_factor, max_nodes);
 
-			// Calculate the normal
-			glm::vec3 normal;
-			// Gx sobel filter
-			normal.x = heights[0][0] - heights[2][0] + 2.0f * heights[0][1] - 2.0f * heights[2][1] + heights[0][2] - heights[2][2];
-			// Gy sobel filter
-			normal.z = heights[0][0] + 2.0f * heights[1][0] + heights[2][0] - heights[0][2] - 2.0f * heights[1][2] - heights[2][2];
-			// Calculate missing up component of the normal using the filtered x and y axis
-			// The first value controls the bump strength
-			normal.y = 0.25f * sqrt(1.0f - normal.x * normal.x - normal.z * normal.z);
-
-			vertices[x + y * patch_size].normal = glm::normalize(normal * glm::vec3(2.0f, 1.0f, 2.0f));
-		}
+	terrain.patch_vertices.resize(max_nodes * terrain.quadtree->get_patch_vertex_count());
+	terrain.patch_indices.resize(max_nodes * terrain.quadtree->get_patch_index_count());
+
+	create_displacement_map();
+	create_patch_buffers();
+}
+
+namespace
+{
+// Single level image, whose samples are read from the tile pyramid rather than loaded from a ktx file
+class DisplacementImage : public vkb::sg::Image
+{
+  public:
+	DisplacementImage(vkb::core::DeviceC &device, const std::vector<uint16_t> &samples, uint32_t dimension) :
+	    vkb::sg::Image("terrain_displacement",
+	                   std::vector<uint8_t>(reinterpret_cast<const uint8_t *>(samples.data()), reinterpret_cast<const uint8_t *>(samples.data() + samples.size())),
+	                   {vkb::sg::Mipmap{0, 0, {dimension, dimension, 1}}})
+	{
+		vkb::sg::Image::set_format(VK_FORMAT_R16_UNORM);
+		vkb::sg::Image::create_vk_image(device);
 	}
+};
+}        // namespace
+
+// The displacement map is the finest level of the tile pyramid within a size limit, so the full heightmap is never uploaded
+void TerrainTessellation::create_displacement_map()
+{
+	const uint32_t max_dimension = 1024;
 
-	// Indices
-	const uint32_t        w           = (patch_size - 1);
-	const uint32_t        index_count = w * w * 4;
-	std::vector<uint32_t> indices(index_count);
-	for (auto x = 0; x < w; x++)
+	uint32_t level = 0;
+	while (level + 1 < terrain.pyramid->get_level_count() && (terrain.pyramid->get_dimension() >> level) > max_dimension)
 	{
-		for (auto y = 0; y < w; y++)
-		{
-			uint32_t index     = (x + y * w) * 4;
-			indices[index]     = (x + y * patch_size);
-			indices[index + 1] = indices[index] + patch_size;
-			indices[index + 2] = indices[index + 1] + 1;
-			indices[index + 3] = indices[index] + 1;
-		}
+		level++;
 	}
-	terrain.index_count = index_count;
 
-	uint32_t vertex_buffer_size = vertex_count * sizeof(Vertex);
-	uint32_t index_buffer_size  = index_count * sizeof(uint32_t);
+	uint32_t dimension       = terrain.pyramid->get_dimension() >> level;
+	textures.heightmap.image = std::make_unique<DisplacementImage>(get_device(), terrain.pyramid->read_level(level), dimension);
+
+	VkBufferImageCopy buffer_copy_region               = {};
+	buffer_copy_region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+	buffer_copy_region.imageSubresource.mipLevel       = 0;
+	buffer_copy_region.imageSubresource.baseArrayLayer = 0;
+	buffer_copy_region.imageSubresource.layerCount     = 1;
+	buffer_copy_region.imageExtent                     = textures.heightmap.image->get_extent();
+
+	VkImageSubresourceRange subresource_range = {};
+	subresource_range.aspectMask              = VK_IMAGE_ASPECT_COLOR_BIT;
+	subresource_range.baseMipLevel            = 0;
+	subresource_range.levelCount              = 1;
+	subresource_range.layerCount              = 1;
+
+	auto &upload_manager = get_device().get_upload_manager();
+	auto  upload_token   = upload_manager.upload_image(textures.heightmap.image->get_data().data(),
+	                                                   textures.heightmap.image->get_data().size(),
+	                                                   textures.heightmap.image->get_vk_image().get_handle(),
+	                                                   {&buffer_copy_region, 1},
+	                                                   subresource_range);
+	upload_manager.flush();
+	upload_manager.wait(upload_token);
 
-	// Create staging buffers
+	VkSamplerCreateInfo sampler_create_info = vkb::initializers::sampler_create_info();
 
-	vkb::core::BufferC vertex_staging = vkb::core::BufferC::create_staging_buffer(get_device(), vertices);
-	vkb::core::BufferC index_staging  = vkb::core::BufferC::create_staging_buffer(get_device(), indices);
+	// Calculate valid filter and mipmap modes
+	VkFilter            filter      = VK_FILTER_LINEAR;
+	VkSamplerMipmapMode mipmap_mode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+	vkb::make_filters_valid(get_device().get_gpu().get_handle(), textures.heightmap.image->get_format(), &filter, &mipmap_mode);
 
-	terrain.vertices = std::make_unique<vkb::core::BufferC>(get_device(),
-	                                                        vertex_buffer_size,
-	                                                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-	                                                        VMA_MEMORY_USAGE_GPU_ONLY);
+	// Setup a mirroring sampler for the height map
+	sampler_create_info.magFilter    = filter;
+	sampler_create_info.minFilter    = filter;
+	sampler_create_info.mipmapMode   = mipmap_mode;
+	sampler_create_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+	sampler_create_info.addressModeV = sampler_create_info.addressModeU;
+	sampler_create_info.addressModeW = sampler_create_info.addressModeU;
+	sampler_create_info.compareOp    = VK_COMPARE_OP_NEVER;
+	sampler_create_info.minLod       = 0.0f;
+	sampler_create_info.maxLod       = static_cast<float>(textures.heightmap.image->get_mipmaps().size());
+	sampler_create_info.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+	VK_CHECK(vkCreateSampler(get_device().get_handle(), &sampler_create_info, nullptr, &textures.heightmap.sampler));
+}
 
-	terrain.indices = std::make_unique<vkb::core::BufferC>(get_device(),
-	                                                       index_buffer_size,
-	                                                       VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-	                                                       VMA_MEMORY_USAGE_GPU_ONLY);
+// One pair of patch buffers per draw command buffer, so that changing the selection never waits for the frames in flight
+void TerrainTessellation::create_patch_buffers()
+{
+	terrain.patch_buffers.resize(draw_cmd_buffers.size());
+	for (auto &patch_buffers : terrain.patch_buffers)
+	{
+		if (patch_buffers.vertices)
+		{
+			continue;
+		}
 
-	// Copy from staging buffers
-	VkCommandBuffer copy_command = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+		// The buffers are sized for the largest selection, and written by the host before their command buffer is submitted
+		patch_buffers.vertices = std::make_unique<vkb::core::BufferC>(get_device(),
+		                                                              terrain.patch_vertices.size() * sizeof(Vertex),
+		                                                              VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+		                                                              VMA_MEMORY_USAGE_CPU_TO_GPU);
 
-	VkBufferCopy copy_region = {};
+		patch_buffers.indices = std::make_unique<vkb::core::BufferC>(get_device(),
+		                                                             terrain.patch_indices.size() * sizeof(uint32_t),
+		                                                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+		                                                             VMA_MEMORY_USAGE_CPU_TO_GPU);
+	}
+}
 
-	copy_region.size = vertex_buffer_size;
-	vkCmdCopyBuffer(
-	    copy_command,
-	    vertex_staging.get_handle(),
-	    terrain.vertices->get_handle(),
-	    1,
-	    &copy_region);
+// Stream the requested tiles, and regenerate the patches if the nodes selected for the view changed
+void TerrainTessellation::update_terrain()
+{
+	terrain.pyramid->stream(8);
 
-	copy_region.size = index_buffer_size;
-	vkCmdCopyBuffer(
-	    copy_command,
-	    index_staging.get_handle(),
-	    terrain.indices->get_handle(),
-	    1,
-	    &copy_region);
+	glm::vec3 camera_position = glm::inverse(camera.matrices.view)[3];
+	if (!terrain.quadtree->select(frustum, camera_position))
+	{
+		return;
+	}
 
-	get_device().flush_command_buffer(copy_command, queue, true);
+	// The patch buffers of each command buffer are written when it is next submitted
+	terrain.index_count = terrain.quadtree->generate_patches(terrain.patch_vertices, terrain.patch_indices);
+	terrain.generation++;
 }
 
 void TerrainTessellation::setup_descriptor_pool()
@@ -675,12 +689,29 @@ void TerrainTessellation::draw()
 {
 	ApiVulkanSample::prepare_frame();
 
+	// Only the previous submission of this command buffer reads its patch buffers
+	VK_CHECK(vkWaitForFences(get_device().get_handle(), 1, &wait_fences[current_buffer], VK_TRUE, UINT64_MAX));
+	VK_CHECK(vkResetFences(get_device().get_handle(), 1, &wait_fences[current_buffer]));
+
+	// Write the latest selection, and record the command buffer again if it changed since it was last submitted
+	PatchBuffers &patch_buffers = terrain.patch_buffers[current_buffer];
+	if (patch_buffers.generation != terrain.generation)
+	{
+		patch_buffers.vertices->update(terrain.patch_vertices);
+		patch_buffers.indices->update(terrain.patch_indices.data(), terrain.index_count * sizeof(uint32_t));
+		patch_buffers.index_count = terrain.index_count;
+		patch_buffers.generation  = terrain.generation;
+
+		recreate_current_command_buffer();
+		build_command_buffer(current_buffer);
+	}
+
 	// Command buffer to be submitted to the queue
 	submit_info.commandBufferCount = 1;
 	submit_info.pCommandBuffers    = &draw_cmd_buffers[current_buffer];
 
 	// Submit to queue
-	VK_CHECK(vkQueueSubmit(queue, 1, &submit_info, VK_NULL_HANDLE));
+	VK_CHECK(vkQueueSubmit(queue, 1, &submit_info, wait_fences[current_buffer]));
 
 	if (get_device().get_gpu().get_features().pipelineStatisticsQuery)
 	{
@@ -712,6 +743,7 @@ bool TerrainTessellation::prepare(const vkb::ApplicationOptions &options)
 		setup_query_result_buffer();
 	}
 	prepare_uniform_buffers();
+	update_terrain();
 	setup_descriptor_set_layouts();
 	prepare_pipelines();
 	setup_descriptor_pool();
@@ -727,6 +759,7 @@ void TerrainTessellation::render(float delta_time)
 	{
 		return;
 	}
+	update_terrain();
 	draw();
 }
 
@@ -763,6 +796,14 @@ void TerrainTessellation::on_update_ui_overlay(vkb::Drawer &drawer)
 			drawer.text("TE invocations: %d", pipeline_stats[1]);
 		}
 	}
+	if (drawer.header("Terrain streaming"))
+	{
+		const auto &quadtree_statistics = terrain.quadtree->get_statistics();
+		const auto &pyramid_statistics  = terrain.pyramid->get_statistics();
+		drawer.text("Nodes: %zu selected, %zu culled", quadtree_statistics.selected_nodes, quadtree_statistics.culled_nodes);
+		drawer.text("Tiles: %zu resident, %zu pending", pyramid_statistics.resident_tiles, pyramid_statistics.pending_tiles);
+		drawer.text("Tiles loaded: %zu, evicted: %zu", pyramid_statistics.loaded_tiles, pyramid_statistics.evicted_tiles);
+	}
 }
 
 std::unique_ptr<vkb::Application> create_terrain_tessellation()
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Sascha Willems
+/* Copyright (c) 2019-2026, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -24,6 +24,8 @@
 #include "api_vulkan_sample.h"
 #include "core/buffer.h"
 #include "geometry/frustum.h"
+#include "geometry/height_tile_pyramid.h"
+#include "geometry/terrain_quadtree.h"
 
 class TerrainTessellation : public ApiVulkanSample
 {
@@ -40,18 +42,29 @@ class TerrainTessellation : public ApiVulkanSample
 
 	std::unique_ptr<vkb::sg::SubMesh> skysphere;
 
-	struct Vertex
+	using Vertex = vkb::TerrainQuadtree::PatchVertex;
+
+	// Patch buffers read by one draw command buffer, only written once its previous submission completed
+	struct PatchBuffers
 	{
-		glm::vec3 pos;
-		glm::vec3 normal;
-		glm::vec2 uv;
+		std::unique_ptr<vkb::core::BufferC> vertices;
+		std::unique_ptr<vkb::core::BufferC> indices;
+		uint32_t                            index_count = 0;
+		// Selection the buffers were written for
+		uint64_t generation = 0;
 	};
 
+	// The terrain is drawn as one quad patch grid per node selected in the quadtree, rebuilt as the view changes
 	struct Terrain
 	{
-		std::unique_ptr<vkb::core::BufferC> vertices;
-		std::unique_ptr<vkb::core::BufferC> indices;
-		uint32_t                            index_count;
+		std::unique_ptr<vkb::HeightTilePyramid> pyramid;
+		std::unique_ptr<vkb::TerrainQuadtree>   quadtree;
+		std::vector<PatchBuffers>               patch_buffers;
+		std::vector<Vertex>                     patch_vertices;
+		std::vector<uint32_t>                   patch_indices;
+		uint32_t                                index_count = 0;
+		// Incremented each time the selection changes
+		uint64_t generation = 0;
 	} terrain;
 
 	struct
@@ -119,7 +132,11 @@ class TerrainTessellation : public ApiVulkanSample
 	void         get_query_results();
 	void         load_assets();
 	void         build_command_buffers() override;
+	void         build_command_buffer(uint32_t index);
 	void         generate_terrain();
+	void         create_displacement_map();
+	void         create_patch_buffers();
+	void         update_terrain();
 	void         setup_descriptor_pool();
 	void         setup_descriptor_set_layouts();
 	void         setup_descriptor_sets();
@@ -20,12 +20,14 @@
  */
 
 #include "ray_tracing_extended.h"
+#include "filesystem/legacy.h"
 #include "gltf_loader.h"
 #include "scene_graph/components/camera.h"
 #include "scene_graph/components/material.h"
 #include "scene_graph/components/mesh.h"
 #include "scene_graph/components/pbr_material.h"
 #include <map>
+#include <numeric>
 
 namespace
 {
@@ -49,6 +51,17 @@ struct QuickTimer
 		}
 	}
 };
+
+#ifndef USE_FRAMEWORK_ACCELERATION_STRUCTURE
+void record_build_barrier(VkCommandBuffer command_buffer)
+{
+	// Orders a build after the builds recorded or submitted before it, whose acceleration structures or scratch buffer it uses
+	VkMemoryBarrier barrier = vkb::initializers::memory_barrier();
+	barrier.srcAccessMask   = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+	barrier.dstAccessMask   = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+#endif
 }        // namespace
 
 #define ASSERT_LOG(cond, msg)              \
@@ -112,6 +125,12 @@ RaytracingExtended::~RaytracingExtended()
 	{
 		flame_texture.image.reset();
 		vkDestroySampler(get_device().get_handle(), flame_texture.sampler, nullptr);
+		for (auto flame_pipeline : flame_particles.pipelines)
+		{
+			vkDestroyPipeline(get_device().get_handle(), flame_pipeline, nullptr);
+		}
+		vkDestroyPipelineLayout(get_device().get_handle(), flame_particles.pipeline_layout, nullptr);
+		vkDestroyDescriptorSetLayout(get_device().get_handle(), flame_particles.descriptor_set_layout, nullptr);
 		vkDestroyPipeline(get_device().get_handle(), pipeline, nullptr);
 		vkDestroyPipelineLayout(get_device().get_handle(), pipeline_layout, nullptr);
 		vkDestroyDescriptorSetLayout(get_device().get_handle(), descriptor_set_layout, nullptr);
@@ -126,6 +145,12 @@ RaytracingExtended::~RaytracingExtended()
 		dynamic_vertex_buffer.reset();
 		index_buffer.reset();
 		dynamic_index_buffer.reset();
+		flame_particles.uniform_buffer.reset();
+		flame_particles.particle_buffer.reset();
+		flame_particles.dead_list_buffer.reset();
+		flame_particles.alive_lists_buffer.reset();
+		flame_particles.counter_buffer.reset();
+		flame_particles.vertex_staging_buffer.reset();
 		ubo.reset();
 	}
 }
@@ -227,27 +252,50 @@ uint64_t RaytracingExtended::get_buffer_device_address(VkBuffer buffer)
 
 void RaytracingExtended::create_flame_model()
 {
-	flame_texture                   = load_texture("textures/generated_flame.ktx", vkb::sg::Image::Color);
-	std::vector<glm::vec3> pts_     = {{0, 0, 0},
-	                                   {1, 0, 0},
-	                                   {1, 1, 0},
-	                                   {0, 1, 0}};
-	std::vector<Triangle>  indices_ = {{0, 1, 2},
-	                                   {0, 2, 3}};
-
-	std::vector<NewVertex> vertices;
-	for (auto &pt : pts_)
+	flame_texture = load_texture("textures/generated_flame.ktx", vkb::sg::Image::Color);
+
+	// The particles are emitted from a disk, and move along the emission direction
+	const glm::vec3 origin    = {-0.15f, -1.5f, -2.3f};
+	const glm::vec3 direction = {0.f, -1.f, 0.f};
+	const glm::vec3 u         = glm::normalize(std::abs(direction.z) > 0.9f ? glm::cross(direction, glm::vec3(1, 0, 0)) : glm::cross(direction, glm::vec3(0, 0, 1)));
+	const glm::vec3 v         = glm::normalize(glm::cross(direction, u));
+
+	auto &uniform_data          = flame_particles.uniform_data;
+	uniform_data.origin         = glm::vec4(origin, 0.5f);
+	uniform_data.direction      = glm::vec4(direction, 5.f);
+	uniform_data.u              = glm::vec4(u, 0.f);
+	uniform_data.v              = glm::vec4(v, 0.f);
+	uniform_data.particle_count = flame_particle_count;
+	uniform_data.particle_size  = 0.25f;
+
+	if (!flame_particles.use_compute)
 	{
-		NewVertex vertex;
-		vertex.pos       = pt - glm::vec3(0.5f, 0.5f, 0.f);        // center the point
-		vertex.normal    = {0, 0, 1};
-		vertex.tex_coord = {static_cast<float>(pt.x), 1.f - static_cast<float>(pt.y)};
-		vertices.push_back(vertex);
+		flame_generator = FlameParticleGenerator(origin, direction, uniform_data.origin.w, flame_particle_count);
 	}
 
+	// One billboard per particle slot, collapsed onto the emitter until the simulation writes it
+	const std::array<glm::vec2, 4> corners = {{{0, 0},
+	                                           {1, 0},
+	                                           {1, 1},
+	                                           {0, 1}}};
+
 	Model model;
-	model.vertices      = vertices;
-	model.triangles     = indices_;
+	model.vertices.reserve(corners.size() * flame_particle_count);
+	model.triangles.reserve(2 * flame_particle_count);
+	for (uint32_t i = 0; i < flame_particle_count; ++i)
+	{
+		for (auto &corner : corners)
+		{
+			NewVertex vertex;
+			vertex.pos       = origin;
+			vertex.normal    = {0, 0, 1};
+			vertex.tex_coord = {corner.x, 1.f - corner.y};
+			model.vertices.push_back(vertex);
+		}
+		model.triangles.push_back({4 * i, 4 * i + 1, 4 * i + 2});
+		model.triangles.push_back({4 * i, 4 * i + 2, 4 * i + 3});
+	}
+
 	model.object_type   = OBJECT_FLAME;
 	model.texture_index = static_cast<uint32_t>(raytracing_scene->imageInfos.size());
 	VkDescriptorImageInfo image_info;
@@ -257,8 +305,57 @@ void RaytracingExtended::create_flame_model()
 
 	raytracing_scene->models.emplace_back(std::move(model));
 	raytracing_scene->imageInfos.push_back(image_info);
+}
 
-	flame_generator = FlameParticleGenerator(glm::vec3{-0.15, -1.5, -2.3}, glm::vec3{0, -1, 0}, 0.5f, 512);
+/*
+    Create the particle lists of the flame, with all the particle slots in the dead list so that the first frame emits them
+*/
+void RaytracingExtended::create_flame_particle_buffers()
+{
+	auto &model_buffers = raytracing_scene->model_buffers;
+	auto  iter          = std::ranges::find_if(model_buffers, [](const ModelBuffer &model_buffer) {
+        return model_buffer.object_type == ObjectType::OBJECT_FLAME;
+    });
+	ASSERT_LOG(iter != model_buffers.cend(), "Can't find flame object.")
+	flame_particles.uniform_data.vertex_offset = static_cast<uint32_t>(iter->vertex_offset / sizeof(NewVertex));
+
+	if (!flame_particles.use_compute)
+	{
+		// The host simulation writes all billboards every frame, they are copied into the flame geometry by the frame
+		flame_particles.vertex_staging_buffer = std::make_unique<vkb::core::BufferC>(get_device(), iter->num_vertices * sizeof(NewVertex), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+		return;
+	}
+
+	flame_particles.uniform_buffer = std::make_unique<vkb::core::BufferC>(get_device(), sizeof(FlameParticleUniforms), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+	flame_particles.uniform_buffer->convert_and_update(flame_particles.uniform_data);
+
+	std::vector<uint32_t> dead_list(flame_particle_count);
+	std::iota(dead_list.begin(), dead_list.end(), 0);
+
+	// Dead count, alive counts, current alive list, emit count, seed and padding, then the emit and simulate dispatch arguments
+	std::array<uint32_t, 16> counters{};
+	counters[0] = flame_particle_count;
+
+	const VkBufferUsageFlags storage_usage_flags = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+	flame_particles.particle_buffer              = std::make_unique<vkb::core::BufferC>(get_device(), flame_particle_count * 2 * sizeof(glm::vec4), storage_usage_flags, VMA_MEMORY_USAGE_GPU_ONLY);
+	flame_particles.dead_list_buffer             = std::make_unique<vkb::core::BufferC>(get_device(), flame_particle_count * sizeof(uint32_t), storage_usage_flags, VMA_MEMORY_USAGE_GPU_ONLY);
+	flame_particles.alive_lists_buffer           = std::make_unique<vkb::core::BufferC>(get_device(), 2 * flame_particle_count * sizeof(uint32_t), storage_usage_flags, VMA_MEMORY_USAGE_GPU_ONLY);
+	flame_particles.counter_buffer               = std::make_unique<vkb::core::BufferC>(get_device(), sizeof(counters), storage_usage_flags | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+
+	vkb::core::BufferC dead_list_staging_buffer = vkb::core::BufferC::create_staging_buffer(get_device(), dead_list);
+	vkb::core::BufferC counter_staging_buffer   = vkb::core::BufferC::create_staging_buffer(get_device(), counters);
+
+	VkCommandBuffer command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+	VkBufferCopy    copy_region    = {0, 0, dead_list_staging_buffer.get_size()};
+	vkCmdCopyBuffer(command_buffer, dead_list_staging_buffer.get_handle(), flame_particles.dead_list_buffer->get_handle(), 1, &copy_region);
+	copy_region.size = counter_staging_buffer.get_size();
+	vkCmdCopyBuffer(command_buffer, counter_staging_buffer.get_handle(), flame_particles.counter_buffer->get_handle(), 1, &copy_region);
+
+	VkMemoryBarrier memory_barrier = vkb::initializers::memory_barrier();
+	memory_barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+	memory_barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+	get_device().flush_command_buffer(command_buffer, queue);
 }
 
 void RaytracingExtended::create_static_object_buffers()
@@ -285,8 +382,9 @@ void RaytracingExtended::create_static_object_buffers()
 	auto index_buffer_size  = nTotalTriangles * sizeof(Triangle);
 
 	// Create a staging buffer. (If staging buffer use is disabled, then this will be the final buffer)
+	// The final buffers are transfer destinations, as the host simulation of the flame copies its billboards into them
 	std::unique_ptr<vkb::core::BufferC> staging_vertex_buffer = nullptr, staging_index_buffer = nullptr;
-	static constexpr VkBufferUsageFlags buffer_usage_flags = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+	static constexpr VkBufferUsageFlags buffer_usage_flags = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 	const VkBufferUsageFlags            staging_flags      = scene_options.use_vertex_staging_buffer ? VK_BUFFER_USAGE_TRANSFER_SRC_BIT : buffer_usage_flags;
 	staging_vertex_buffer                                  = std::make_unique<vkb::core::BufferC>(get_device(), vertex_buffer_size, staging_flags, VMA_MEMORY_USAGE_CPU_TO_GPU);
 	staging_index_buffer                                   = std::make_unique<vkb::core::BufferC>(get_device(), index_buffer_size, staging_flags, VMA_MEMORY_USAGE_CPU_TO_GPU);
@@ -305,7 +403,7 @@ void RaytracingExtended::create_static_object_buffers()
 		auto cmd = get_device().get_command_pool().request_command_buffer();
 		cmd->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, VK_NULL_HANDLE);
 		auto copy = [this, &cmd](vkb::core::BufferC &staging_buffer) {
-			auto output_buffer = std::make_unique<vkb::core::BufferC>(get_device(), staging_buffer.get_size(), buffer_usage_flags | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+			auto output_buffer = std::make_unique<vkb::core::BufferC>(get_device(), staging_buffer.get_size(), buffer_usage_flags, VMA_MEMORY_USAGE_GPU_ONLY);
 			cmd->copy_buffer(staging_buffer, *output_buffer, staging_buffer.get_size());
 
 			vkb::BufferMemoryBarrier barrier;
@@ -336,6 +434,7 @@ void RaytracingExtended::create_static_object_buffers()
 		buffer.vertex_offset     = vertex_buffer_offsets[i];
 		buffer.index_offset      = index_buffer_offsets[i];
 		buffer.is_static         = true;
+		buffer.is_animated       = models[i].object_type == OBJECT_FLAME;
 		buffer.default_transform = models[i].default_transform;
 		buffer.num_vertices      = models[i].vertices.size();
 		buffer.num_triangles     = models[i].triangles.size();
@@ -347,15 +446,16 @@ void RaytracingExtended::create_static_object_buffers()
 
 /*
     Create the bottom level acceleration structure that contains the scene's geometry (triangles)
+    The builds are recorded into command_buffer if one is given, otherwise they are submitted and waited for
 */
-void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_update, bool print_time)
+void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_update, bool print_time, VkCommandBuffer command_buffer)
 {
 	QuickTimer timer{"BLAS Build", print_time};
 	assert(!!raytracing_scene);
 	/**
 	Though we use similar code to handle static and dynamic objects, several parts differ:
 	1. Static / dynamic objects have different buffers (device-only vs host-visible)
-	2. Dynamic objects use different flags (i.e. for fast rebuilds)
+	2. Animated objects use different flags (i.e. for fast rebuilds), the flame is animated in the static buffers by compute passes
 	*/
 
 	assert(!!vertex_buffer && !!index_buffer);
@@ -366,7 +466,7 @@ void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_upda
 	auto &model_buffers                  = raytracing_scene->model_buffers;
 	for (auto &model_buffer : model_buffers)
 	{
-		if (model_buffer.is_static && is_update)
+		if (!model_buffer.is_animated && is_update)
 		{
 			continue;
 		}
@@ -403,8 +503,8 @@ void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_upda
 		{
 			model_buffer.bottom_level_acceleration_structure->update_triangle_geometry(
 			    model_buffer.object_id,
-			    dynamic_vertex_buffer,
-			    dynamic_index_buffer,
+			    model_buffer.is_static ? vertex_buffer : dynamic_vertex_buffer,
+			    model_buffer.is_static ? index_buffer : dynamic_index_buffer,
 			    model_buffer.transform_matrix_buffer,
 			    static_cast<uint32_t>(model_buffer.num_triangles),
 			    static_cast<uint32_t>(model_buffer.num_vertices) - 1,
@@ -413,10 +513,18 @@ void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_upda
 			    model_buffer.vertex_offset + (model_buffer.is_static ? static_vertex_handle : dynamic_vertex_handle),
 			    model_buffer.index_offset + (model_buffer.is_static ? static_index_handle : dynamic_index_handle));
 		}
-		model_buffer.bottom_level_acceleration_structure->set_scrach_buffer_alignment(acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment);
-		model_buffer.bottom_level_acceleration_structure->build(queue,
-		                                                        model_buffer.is_static ? VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR : VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR,
-		                                                        is_update ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR);
+		// All the bottom level acceleration structures are built together once they are all added
+		// Static geometry is compacted, animated geometry is refit, and periodically rebuilt to keep its trace performance
+		if (!model_buffer.is_animated)
+		{
+			acceleration_structure_builder->add_build(*model_buffer.bottom_level_acceleration_structure,
+			                                          VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR);
+		}
+		else
+		{
+			acceleration_structure_builder->add_update(*model_buffer.bottom_level_acceleration_structure,
+			                                           VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR);
+		}
 #else
 		VkDeviceOrHostAddressConstKHR vertex_data_device_address{};
 		VkDeviceOrHostAddressConstKHR index_data_device_address{};
@@ -455,7 +563,7 @@ void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_upda
 		acceleration_structure_build_geometry_info.sType         = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
 		acceleration_structure_build_geometry_info.pNext         = nullptr;
 		acceleration_structure_build_geometry_info.type          = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-		acceleration_structure_build_geometry_info.flags         = model_buffer.is_static ? VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR : VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+		acceleration_structure_build_geometry_info.flags         = model_buffer.is_animated ? VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR : VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
 		acceleration_structure_build_geometry_info.geometryCount = 1;
 		if (is_update)
 		{
@@ -499,17 +607,21 @@ void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_upda
 		}
 		// The actual build process starts here
 
-		// Create a scratch buffer as a temporary storage for the acceleration structure build
-		auto scratch_buffer = std::make_unique<vkb::core::BufferC>(get_device(), vkb::core::BufferBuilderC(model_buffer.buildSize.buildScratchSize)
-		                                                                             .with_usage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
-		                                                                             .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
-		                                                                             .with_alignment(acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment));
+		// Create a scratch buffer as a storage for the acceleration structure builds, which is kept for the refits of the next frames
+		auto &scratch_buffer = bottom_level_acceleration_structure.scratch_buffer;
+		if (!scratch_buffer || scratch_buffer->get_size() < model_buffer.buildSize.buildScratchSize)
+		{
+			scratch_buffer = std::make_unique<vkb::core::BufferC>(get_device(), vkb::core::BufferBuilderC(model_buffer.buildSize.buildScratchSize)
+			                                                                        .with_usage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+			                                                                        .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
+			                                                                        .with_alignment(acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment));
+		}
 
 		{
 			VkAccelerationStructureBuildGeometryInfoKHR acceleration_build_geometry_info{};
 			acceleration_build_geometry_info.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
 			acceleration_build_geometry_info.type  = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-			acceleration_build_geometry_info.flags = model_buffer.is_static ? VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR : VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+			acceleration_build_geometry_info.flags = model_buffer.is_animated ? VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR : VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
 			acceleration_build_geometry_info.mode  = is_update ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
 			if (is_update)
 			{
@@ -520,20 +632,29 @@ void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_upda
 			acceleration_build_geometry_info.pGeometries               = &model_buffer.acceleration_structure_geometry;
 			acceleration_build_geometry_info.scratchData.deviceAddress = scratch_buffer->get_device_address();
 
-			// Build the acceleration structure on the device via a one-time command buffer submission
+			// Build the acceleration structure on the device, in the frame's command buffer or via a one-time command buffer submission
 			// Some implementations may support acceleration structure building on the host (VkPhysicalDeviceAccelerationStructureFeaturesKHR->accelerationStructureHostCommands), but we prefer device builds
-			VkCommandBuffer                                           command_buffer    = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+			VkCommandBuffer build_command_buffer = command_buffer;
+			if (build_command_buffer == VK_NULL_HANDLE)
+			{
+				build_command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+			}
+			else
+			{
+				record_build_barrier(build_command_buffer);
+			}
 			std::array<VkAccelerationStructureBuildRangeInfoKHR *, 1> build_range_infos = {&model_buffer.buildRangeInfo};
 			vkCmdBuildAccelerationStructuresKHR(
-			    command_buffer,
+			    build_command_buffer,
 			    1,
 			    &acceleration_build_geometry_info,
 			    &build_range_infos[0]);
-			get_device().flush_command_buffer(command_buffer, queue);
+			if (command_buffer == VK_NULL_HANDLE)
+			{
+				get_device().flush_command_buffer(build_command_buffer, queue);
+			}
 		}
 
-		scratch_buffer.reset();
-
 		// Get the bottom acceleration structure's handle, which will be used during the top level acceleration build
 		VkAccelerationStructureDeviceAddressInfoKHR acceleration_device_address_info{};
 		acceleration_device_address_info.sType                 = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
@@ -542,6 +663,17 @@ void RaytracingExtended::create_bottom_level_acceleration_structure(bool is_upda
 		    vkGetAccelerationStructureDeviceAddressKHR(get_device().get_handle(), &acceleration_device_address_info);
 #endif
 	}
+
+#ifdef USE_FRAMEWORK_ACCELERATION_STRUCTURE
+	if (command_buffer != VK_NULL_HANDLE)
+	{
+		acceleration_structure_builder->record(command_buffer);
+	}
+	else
+	{
+		acceleration_structure_builder->build(queue);
+	}
+#endif
 }
 
 VkTransformMatrixKHR RaytracingExtended::calculate_rotation(glm::vec3 pt, float scale, bool freeze_z)
@@ -567,8 +699,9 @@ VkTransformMatrixKHR RaytracingExtended::calculate_rotation(glm::vec3 pt, float
 
 /*
     Create the top level acceleration structure containing geometry instances of the bottom level acceleration structure(s)
+    The build is recorded into command_buffer if one is given, otherwise it is submitted and waited for
 */
-void RaytracingExtended::create_top_level_acceleration_structure(bool print_time)
+void RaytracingExtended::create_top_level_acceleration_structure(bool print_time, VkCommandBuffer command_buffer)
 {
 	/*
 	Often, good performance can be obtained when the TLAS uses PREFER_FAST_TRACE with full rebuilds.
@@ -613,36 +746,18 @@ void RaytracingExtended::create_top_level_acceleration_structure(bool print_time
 		ASSERT_LOG(scene_instance.object_type == ObjectType::OBJECT_REFRACTION || scene_instance.image_index < raytracing_scene->imageInfos.size(), "Only the refraction model can be texture less.")
 		model_instance_data.emplace_back(scene_instance);
 
-		// these objects have a single instance with the identity transform
+		// these objects have a single instance, the flame billboards are written in world space by the particle simulation
 		switch (model_buffer.object_type)
 		{
-			case (ObjectType::OBJECT_NORMAL):
-				add_instance(model_buffer, transform_matrix, static_cast<uint32_t>(i));
-				break;
 			case (ObjectType::OBJECT_REFRACTION):
 				add_instance(model_buffer, calculate_rotation({-0.25, -2.5, -2.35}, 1.f, true), static_cast<uint32_t>(i));
 				break;
 			default:
-				// handle flame separately
+				add_instance(model_buffer, transform_matrix, static_cast<uint32_t>(i));
 				break;
 		}
 	}
 
-	{
-		// find the flame particle object, then add the particles as instances
-		auto &model_buffers = raytracing_scene->model_buffers;
-		auto  iter          = std::ranges::find_if(model_buffers, [](const ModelBuffer &model_buffer) {
-            return model_buffer.object_type == ObjectType::OBJECT_FLAME;
-        });
-		ASSERT_LOG(iter != model_buffers.cend(), "Can't find flame object.")
-		auto    &model_buffer = *iter;
-		uint32_t index        = static_cast<uint32_t>(std::distance(model_buffers.begin(), iter));
-		for (auto &&particle : flame_generator.particles)
-		{
-			add_instance(model_buffer, calculate_rotation(particle.position, 0.25f, true), index);
-		}
-	}
-
 	size_t data_to_model_size = model_instance_data.size() * sizeof(model_instance_data[0]);
 	if (!data_to_model_buffer || data_to_model_buffer->get_size() < data_to_model_size)
 	{
@@ -670,8 +785,15 @@ void RaytracingExtended::create_top_level_acceleration_structure(bool print_time
 	{
 		top_level_acceleration_structure->update_instance_geometry(instance_uid, instances_buffer, static_cast<uint32_t>(instances.size()));
 	}
-	top_level_acceleration_structure->set_scrach_buffer_alignment(acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment);
-	top_level_acceleration_structure->build(queue);
+	acceleration_structure_builder->add_build(*top_level_acceleration_structure);
+	if (command_buffer != VK_NULL_HANDLE)
+	{
+		acceleration_structure_builder->record(command_buffer);
+	}
+	else
+	{
+		acceleration_structure_builder->build(queue);
+	}
 #else
 	VkDeviceOrHostAddressConstKHR instance_data_device_address{};
 	instance_data_device_address.deviceAddress = get_buffer_device_address(instances_buffer->get_handle());
@@ -733,12 +855,16 @@ void RaytracingExtended::create_top_level_acceleration_structure(bool print_time
 
 	// The actual build process starts here
 
-	// Create a scratch buffer as a temporary storage for the acceleration structure build
-	auto scratch_buffer = std::make_unique<vkb::core::BufferC>(get_device(),
-	                                                           vkb::core::BufferBuilderC(acceleration_structure_build_sizes_info.buildScratchSize)
-	                                                               .with_usage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_SHADER_DEVICE_ADDRESS_BIT)
-	                                                               .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
-	                                                               .with_alignment(acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment));
+	// Create a scratch buffer as a storage for the acceleration structure builds, which is kept for the updates of the next frames
+	auto &scratch_buffer = top_level_acceleration_structure.scratch_buffer;
+	if (!scratch_buffer || scratch_buffer->get_size() < acceleration_structure_build_sizes_info.buildScratchSize)
+	{
+		scratch_buffer = std::make_unique<vkb::core::BufferC>(get_device(),
+		                                                      vkb::core::BufferBuilderC(acceleration_structure_build_sizes_info.buildScratchSize)
+		                                                          .with_usage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+		                                                          .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
+		                                                          .with_alignment(acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment));
+	}
 
 	VkAccelerationStructureBuildGeometryInfoKHR acceleration_build_geometry_info{};
 	acceleration_build_geometry_info.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
@@ -761,17 +887,27 @@ void RaytracingExtended::create_top_level_acceleration_structure(bool print_time
 	acceleration_structure_build_range_info.transformOffset = 0;
 	std::vector<VkAccelerationStructureBuildRangeInfoKHR *> acceleration_build_structure_range_infos = {&acceleration_structure_build_range_info};
 
-	// Build the acceleration structure on the device via a one-time command buffer submission
+	// Build the acceleration structure on the device, in the frame's command buffer or via a one-time command buffer submission
 	// Some implementations may support acceleration structure building on the host (VkPhysicalDeviceAccelerationStructureFeaturesKHR->accelerationStructureHostCommands), but we prefer device builds
-	VkCommandBuffer command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+	VkCommandBuffer build_command_buffer = command_buffer;
+	if (build_command_buffer == VK_NULL_HANDLE)
+	{
+		build_command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+	}
+	else
+	{
+		// The instanced bottom level acceleration structures were built before in the same command buffer
+		record_build_barrier(build_command_buffer);
+	}
 	vkCmdBuildAccelerationStructuresKHR(
-	    command_buffer,
+	    build_command_buffer,
 	    1,
 	    &acceleration_build_geometry_info,
 	    acceleration_build_structure_range_infos.data());
-	get_device().flush_command_buffer(command_buffer, queue);
-
-	scratch_buffer.reset();
+	if (command_buffer == VK_NULL_HANDLE)
+	{
+		get_device().flush_command_buffer(build_command_buffer, queue);
+	}
 
 	// Get the top acceleration structure's handle, which will be used to set up its descriptor
 	VkAccelerationStructureDeviceAddressInfoKHR acceleration_device_address_info{};
@@ -837,9 +973,19 @@ void RaytracingExtended::create_scene()
 
 	create_flame_model();
 	create_static_object_buffers();
+	create_flame_particle_buffers();
 	create_dynamic_object_buffers(0.f);
+#ifdef USE_FRAMEWORK_ACCELERATION_STRUCTURE
+	acceleration_structure_builder = std::make_unique<vkb::core::AccelerationStructureBuilder>(get_device());
+#endif
 	create_bottom_level_acceleration_structure(false);
 #ifdef USE_FRAMEWORK_ACCELERATION_STRUCTURE
+	auto &statistics = acceleration_structure_builder->get_statistics();
+	LOGI("BLAS compaction: {} acceleration structures, {} KiB saved of {} KiB",
+	     statistics.compaction_count,
+	     statistics.get_saved_size() / 1024,
+	     statistics.original_size / 1024);
+
 	top_level_acceleration_structure = std::make_unique<vkb::core::AccelerationStructure>(get_device(), VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR);
 #endif
 	create_top_level_acceleration_structure();
@@ -913,8 +1059,11 @@ void RaytracingExtended::create_descriptor_sets()
 	    {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1},
 	    {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5},
 	    {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1},
-	    {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>(raytracing_scene->imageInfos.size())}};
-	VkDescriptorPoolCreateInfo descriptor_pool_create_info = vkb::initializers::descriptor_pool_create_info(pool_sizes, 1);
+	    {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>(raytracing_scene->imageInfos.size())},
+	    // Flame particles
+	    {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1},
+	    {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5}};
+	VkDescriptorPoolCreateInfo descriptor_pool_create_info = vkb::initializers::descriptor_pool_create_info(pool_sizes, 2);
 	VK_CHECK(vkCreateDescriptorPool(get_device().get_handle(), &descriptor_pool_create_info, nullptr, &descriptor_pool));
 
 	VkDescriptorSetAllocateInfo descriptor_set_allocate_info = vkb::initializers::descriptor_set_allocate_info(descriptor_pool, &descriptor_set_layout, 1);
@@ -971,6 +1120,30 @@ void RaytracingExtended::create_descriptor_sets()
 	    dynamic_vertex_buffer_write,
 	    dynamic_index_buffer_write};
 	vkUpdateDescriptorSets(get_device().get_handle(), static_cast<uint32_t>(write_descriptor_sets.size()), write_descriptor_sets.data(), 0, VK_NULL_HANDLE);
+
+	// The flame particle passes write the flame billboards into the static vertex buffer
+	if (!flame_particles.use_compute)
+	{
+		return;
+	}
+
+	descriptor_set_allocate_info = vkb::initializers::descriptor_set_allocate_info(descriptor_pool, &flame_particles.descriptor_set_layout, 1);
+	VK_CHECK(vkAllocateDescriptorSets(get_device().get_handle(), &descriptor_set_allocate_info, &flame_particles.descriptor_set));
+
+	VkDescriptorBufferInfo flame_uniform_descriptor     = create_descriptor(*flame_particles.uniform_buffer);
+	VkDescriptorBufferInfo flame_particle_descriptor    = create_descriptor(*flame_particles.particle_buffer);
+	VkDescriptorBufferInfo flame_dead_list_descriptor   = create_descriptor(*flame_particles.dead_list_buffer);
+	VkDescriptorBufferInfo flame_alive_lists_descriptor = create_descriptor(*flame_particles.alive_lists_buffer);
+	VkDescriptorBufferInfo flame_counter_descriptor     = create_descriptor(*flame_particles.counter_buffer);
+
+	std::vector<VkWriteDescriptorSet> flame_write_descriptor_sets = {
+	    vkb::initializers::write_descriptor_set(flame_particles.descriptor_set, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &flame_uniform_descriptor),
+	    vkb::initializers::write_descriptor_set(flame_particles.descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, &flame_particle_descriptor),
+	    vkb::initializers::write_descriptor_set(flame_particles.descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, &flame_dead_list_descriptor),
+	    vkb::initializers::write_descriptor_set(flame_particles.descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3, &flame_alive_lists_descriptor),
+	    vkb::initializers::write_descriptor_set(flame_particles.descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4, &flame_counter_descriptor),
+	    vkb::initializers::write_descriptor_set(flame_particles.descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5, &vertex_descriptor)};
+	vkUpdateDescriptorSets(get_device().get_handle(), static_cast<uint32_t>(flame_write_descriptor_sets.size()), flame_write_descriptor_sets.data(), 0, VK_NULL_HANDLE);
 }
 
 void RaytracingExtended::create_dynamic_object_buffers(float time)
@@ -1027,6 +1200,7 @@ void RaytracingExtended::create_dynamic_object_buffers(float time)
 		buffer.vertex_offset     = 0;
 		buffer.index_offset      = 0;
 		buffer.is_static         = false;
+		buffer.is_animated       = true;
 		buffer.default_transform = VkTransformMatrixKHR{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0};
 		buffer.num_vertices      = refraction_model.size();
 		buffer.num_triangles     = refraction_indices.size();
@@ -1207,6 +1381,42 @@ void RaytracingExtended::create_ray_tracing_pipeline()
 	VK_CHECK(vkCreateRayTracingPipelinesKHR(get_device().get_handle(), VK_NULL_HANDLE, VK_NULL_HANDLE, 1, &raytracing_pipeline_create_info, nullptr, &pipeline));
 }
 
+/*
+    Create the compute pipelines of the flame particle passes, one per pass of the same shader
+*/
+void RaytracingExtended::create_flame_particle_pipelines()
+{
+	if (!flame_particles.use_compute)
+	{
+		return;
+	}
+
+	std::vector<VkDescriptorSetLayoutBinding> set_layout_bindings = {
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 0),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 1),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 2),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 3),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 4),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 5)};
+	VkDescriptorSetLayoutCreateInfo descriptor_layout = vkb::initializers::descriptor_set_layout_create_info(set_layout_bindings);
+	VK_CHECK(vkCreateDescriptorSetLayout(get_device().get_handle(), &descriptor_layout, nullptr, &flame_particles.descriptor_set_layout));
+
+	VkPipelineLayoutCreateInfo pipeline_layout_create_info = vkb::initializers::pipeline_layout_create_info(&flame_particles.descriptor_set_layout, 1);
+	VK_CHECK(vkCreatePipelineLayout(get_device().get_handle(), &pipeline_layout_create_info, nullptr, &flame_particles.pipeline_layout));
+
+	VkComputePipelineCreateInfo compute_pipeline_create_info = vkb::initializers::compute_pipeline_create_info(flame_particles.pipeline_layout, 0);
+	compute_pipeline_create_info.stage                       = load_shader("ray_tracing_extended", "flame_particles.comp.spv", VK_SHADER_STAGE_COMPUTE_BIT);
+
+	// The pass is selected by a specialization constant
+	VkSpecializationMapEntry specialization_map_entry = vkb::initializers::specialization_map_entry(0, 0, sizeof(uint32_t));
+	for (uint32_t pass = 0; pass < flame_particles.pipelines.size(); ++pass)
+	{
+		VkSpecializationInfo specialization_info               = vkb::initializers::specialization_info(1, &specialization_map_entry, sizeof(pass), &pass);
+		compute_pipeline_create_info.stage.pSpecializationInfo = &specialization_info;
+		VK_CHECK(vkCreateComputePipelines(get_device().get_handle(), pipeline_cache, 1, &compute_pipeline_create_info, nullptr, &flame_particles.pipelines[pass]));
+	}
+}
+
 #ifndef USE_FRAMEWORK_ACCELERATION_STRUCTURE
 /*
     Deletes all resources acquired by an acceleration structure
@@ -1217,6 +1427,7 @@ void RaytracingExtended::delete_acceleration_structure(AccelerationStructureExte
 	{
 		acceleration_structure.buffer.reset();
 	}
+	acceleration_structure.scratch_buffer.reset();
 	if (acceleration_structure.handle)
 	{
 		vkDestroyAccelerationStructureKHR(get_device().get_handle(), acceleration_structure.handle, nullptr);
@@ -1239,6 +1450,7 @@ void RaytracingExtended::create_uniform_buffer()
 
 /*
     Command buffer generation
+    The command buffers are recorded every frame in draw(), only the storage image depends on the view port size
 */
 void RaytracingExtended::build_command_buffers()
 {
@@ -1256,112 +1468,183 @@ void RaytracingExtended::build_command_buffers()
 		VkWriteDescriptorSet result_image_write = vkb::initializers::write_descriptor_set(descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, &image_descriptor);
 		vkUpdateDescriptorSets(get_device().get_handle(), 1, &result_image_write, 0, VK_NULL_HANDLE);
 	}
+}
 
-	VkCommandBufferBeginInfo command_buffer_begin_info = vkb::initializers::command_buffer_begin_info();
+/*
+    Dispatch the ray tracing commands, once the acceleration structures of the frame are built
+*/
+void RaytracingExtended::trace_rays(VkCommandBuffer command_buffer)
+{
+	/*
+	    Set up the stride device address regions pointing at the shader identifiers in the shader binding table
+	*/
 
-	auto device_ptr   = get_device().get_handle();
-	auto command_pool = get_device().get_command_pool().get_handle();
-	if (!raytracing_command_buffers.empty())
-	{
-		vkFreeCommandBuffers(device_ptr, command_pool, static_cast<uint32_t>(raytracing_command_buffers.size()), &raytracing_command_buffers[0]);
-		raytracing_command_buffers.resize(0);
-	}
+	const uint32_t handle_size_aligned = aligned_size(ray_tracing_pipeline_properties.shaderGroupHandleSize, ray_tracing_pipeline_properties.shaderGroupHandleAlignment);
 
-	raytracing_command_buffers.resize(draw_cmd_buffers.size());
-	for (auto &&command_buffer : raytracing_command_buffers)
-	{
-		command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, false);
-	}
+	VkStridedDeviceAddressRegionKHR raygen_shader_sbt_entry{};
+	raygen_shader_sbt_entry.deviceAddress = get_buffer_device_address(raygen_shader_binding_table->get_handle());
+	raygen_shader_sbt_entry.stride        = handle_size_aligned;
+	raygen_shader_sbt_entry.size          = handle_size_aligned;
 
-	for (auto &raytracing_command_buffer : raytracing_command_buffers)
-	{
-		VK_CHECK(vkBeginCommandBuffer(raytracing_command_buffer, &command_buffer_begin_info));
+	VkStridedDeviceAddressRegionKHR miss_shader_sbt_entry{};
+	miss_shader_sbt_entry.deviceAddress = get_buffer_device_address(miss_shader_binding_table->get_handle());
+	miss_shader_sbt_entry.stride        = handle_size_aligned;
+	miss_shader_sbt_entry.size          = handle_size_aligned;
 
-		/*
-		    Set up the stride device address regions pointing at the shader identifiers in the shader binding table
-		*/
+	VkStridedDeviceAddressRegionKHR hit_shader_sbt_entry{};
+	hit_shader_sbt_entry.deviceAddress = get_buffer_device_address(hit_shader_binding_table->get_handle());
+	hit_shader_sbt_entry.stride        = handle_size_aligned;
+	hit_shader_sbt_entry.size          = handle_size_aligned;
 
-		const uint32_t handle_size_aligned = aligned_size(ray_tracing_pipeline_properties.shaderGroupHandleSize, ray_tracing_pipeline_properties.shaderGroupHandleAlignment);
+	VkStridedDeviceAddressRegionKHR callable_shader_sbt_entry{};
 
-		VkStridedDeviceAddressRegionKHR raygen_shader_sbt_entry{};
-		raygen_shader_sbt_entry.deviceAddress = get_buffer_device_address(raygen_shader_binding_table->get_handle());
-		raygen_shader_sbt_entry.stride        = handle_size_aligned;
-		raygen_shader_sbt_entry.size          = handle_size_aligned;
+	// The acceleration structures are built earlier in the same command buffer, the host written buffers are made visible by the submission
+	VkMemoryBarrier barrier = vkb::initializers::memory_barrier();
+	barrier.srcAccessMask   = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+	barrier.dstAccessMask   = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, 0, 1, &barrier, 0, nullptr, 0, nullptr);
 
-		VkStridedDeviceAddressRegionKHR miss_shader_sbt_entry{};
-		miss_shader_sbt_entry.deviceAddress = get_buffer_device_address(miss_shader_binding_table->get_handle());
-		miss_shader_sbt_entry.stride        = handle_size_aligned;
-		miss_shader_sbt_entry.size          = handle_size_aligned;
+	vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, pipeline);
+	vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, pipeline_layout, 0, 1, &descriptor_set, 0, nullptr);
 
-		VkStridedDeviceAddressRegionKHR hit_shader_sbt_entry{};
-		hit_shader_sbt_entry.deviceAddress = get_buffer_device_address(hit_shader_binding_table->get_handle());
-		hit_shader_sbt_entry.stride        = handle_size_aligned;
-		hit_shader_sbt_entry.size          = handle_size_aligned;
+	vkCmdTraceRaysKHR(
+	    command_buffer,
+	    &raygen_shader_sbt_entry,
+	    &miss_shader_sbt_entry,
+	    &hit_shader_sbt_entry,
+	    &callable_shader_sbt_entry,
+	    width,
+	    height,
+	    1);
+}
+
+void RaytracingExtended::update_uniform_buffers()
+{
+	uniform_data.proj_inverse = glm::inverse(camera.matrices.perspective);
+	uniform_data.view_inverse = glm::inverse(camera.matrices.view);
+	ubo->convert_and_update(uniform_data);
+}
+
+/*
+    Record the flame particle passes of a frame, the number of particles they process is only known by the device
+*/
+void RaytracingExtended::record_flame_particles(VkCommandBuffer command_buffer)
+{
+	if (!flame_particles.use_compute)
+	{
+		record_flame_particle_copy(command_buffer);
+		return;
+	}
+
+	// The passes of the previous frame wrote the particles and lists, and the billboards read by its refit and closest hit shader
+	VkMemoryBarrier frame_barrier = vkb::initializers::memory_barrier();
+	frame_barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+	frame_barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1, &frame_barrier, 0, nullptr, 0, nullptr);
+
+	// Each pass reads the particles, lists and dispatch arguments written by the previous one
+	VkMemoryBarrier pass_barrier = vkb::initializers::memory_barrier();
+	pass_barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+	pass_barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
 
-		VkStridedDeviceAddressRegionKHR callable_shader_sbt_entry{};
+	// Offsets of the dispatch arguments in the counter buffer
+	const VkDeviceSize emit_dispatch_offset     = 8 * sizeof(uint32_t);
+	const VkDeviceSize simulate_dispatch_offset = 12 * sizeof(uint32_t);
 
-		std::vector<VkBufferMemoryBarrier> barriers;
-		for (auto &&model_buffer : raytracing_scene->model_buffers)
+	vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, flame_particles.pipeline_layout, 0, 1, &flame_particles.descriptor_set, 0, nullptr);
+	for (size_t pass = 0; pass < flame_particles.pipelines.size(); ++pass)
+	{
+		if (pass > 0)
 		{
-			if (!model_buffer.is_static)
-			{
-				VkBufferMemoryBarrier barrier = vkb::initializers::buffer_memory_barrier();
-				barrier.srcAccessMask         = VK_ACCESS_MEMORY_WRITE_BIT | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
-				barrier.dstAccessMask         = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
-#ifdef USE_FRAMEWORK_ACCELERATION_STRUCTURE
-				barrier.buffer = model_buffer.bottom_level_acceleration_structure->get_buffer()->get_handle();
-				barrier.size   = model_buffer.bottom_level_acceleration_structure->get_buffer()->get_size();
-#else
-				barrier.buffer = model_buffer.bottom_level_acceleration_structure.buffer->get_handle();
-				barrier.size = model_buffer.bottom_level_acceleration_structure.buffer->get_size();
-#endif
-				barriers.push_back(barrier);
-			}
+			vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1, &pass_barrier, 0, nullptr, 0, nullptr);
 		}
 
-		auto getBufferBarrier = [](const vkb::core::BufferC &buffer) {
-			VkBufferMemoryBarrier barrier = vkb::initializers::buffer_memory_barrier();
-			barrier.srcAccessMask         = VK_ACCESS_MEMORY_WRITE_BIT;
-			barrier.dstAccessMask         = VK_ACCESS_SHADER_READ_BIT;
-			barrier.buffer                = buffer.get_handle();
-			barrier.size                  = buffer.get_size();
-			return barrier;
-		};
-		barriers.emplace_back(getBufferBarrier(*dynamic_vertex_buffer));
-		barriers.emplace_back(getBufferBarrier(*dynamic_index_buffer));
-		barriers.emplace_back(getBufferBarrier(*instances_buffer));
-		barriers.emplace_back(getBufferBarrier(*ubo));
-
-		vkCmdPipelineBarrier(raytracing_command_buffer, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_HOST_BIT, 0,
-		                     0, VK_NULL_HANDLE,                                              // memory barrier
-		                     static_cast<uint32_t>(barriers.size()), barriers.data(),        // buffer memory barrier
-		                     0, VK_NULL_HANDLE);                                             // image memory barrier
-
-		/*
-		    Dispatch the ray tracing commands
-		*/
-		vkCmdBindPipeline(raytracing_command_buffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, pipeline);
-		vkCmdBindDescriptorSets(raytracing_command_buffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, pipeline_layout, 0, 1, &descriptor_set, 0, nullptr);
-
-		vkCmdTraceRaysKHR(
-		    raytracing_command_buffer,
-		    &raygen_shader_sbt_entry,
-		    &miss_shader_sbt_entry,
-		    &hit_shader_sbt_entry,
-		    &callable_shader_sbt_entry,
-		    width,
-		    height,
-		    1);
-
-		VK_CHECK(vkEndCommandBuffer(raytracing_command_buffer));
+		vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, flame_particles.pipelines[pass]);
+		switch (pass)
+		{
+			case 1:
+				vkCmdDispatchIndirect(command_buffer, flame_particles.counter_buffer->get_handle(), emit_dispatch_offset);
+				break;
+			case 3:
+				vkCmdDispatchIndirect(command_buffer, flame_particles.counter_buffer->get_handle(), simulate_dispatch_offset);
+				break;
+			default:
+				// The passes writing the dispatch arguments run on a single thread
+				vkCmdDispatch(command_buffer, 1, 1, 1);
+				break;
+		}
 	}
+
+	// The billboards are read by the refit of the flame acceleration structure, and by the closest hit shader
+	VkMemoryBarrier vertex_barrier = vkb::initializers::memory_barrier();
+	vertex_barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+	vertex_barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, 0, 1, &vertex_barrier, 0, nullptr, 0, nullptr);
 }
 
-void RaytracingExtended::update_uniform_buffers()
+/*
+    Record the copy of the billboards written by the host simulation into the flame geometry of the static vertex buffer
+*/
+void RaytracingExtended::record_flame_particle_copy(VkCommandBuffer command_buffer)
 {
-	uniform_data.proj_inverse = glm::inverse(camera.matrices.perspective);
-	uniform_data.view_inverse = glm::inverse(camera.matrices.view);
-	ubo->convert_and_update(uniform_data);
+	// The refit and closest hit shader of the previous frame read the billboards which are overwritten
+	VkMemoryBarrier frame_barrier = vkb::initializers::memory_barrier();
+	frame_barrier.dstAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &frame_barrier, 0, nullptr, 0, nullptr);
+
+	VkBufferCopy copy_region = {0, flame_particles.uniform_data.vertex_offset * sizeof(NewVertex), flame_particles.vertex_staging_buffer->get_size()};
+	vkCmdCopyBuffer(command_buffer, flame_particles.vertex_staging_buffer->get_handle(), vertex_buffer->get_handle(), 1, &copy_region);
+
+	// The billboards are read by the refit of the flame acceleration structure, and by the closest hit shader
+	VkMemoryBarrier vertex_barrier = vkb::initializers::memory_barrier();
+	vertex_barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+	vertex_barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR | VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, 0, 1, &vertex_barrier, 0, nullptr, 0, nullptr);
+}
+
+/*
+    Update the parameters of the flame particle passes, the host only provides the time step and the camera position.
+    Without the passes, the particles are simulated on the host and their billboards are written to the staging buffer,
+    with the same layout as the simulate pass
+*/
+void RaytracingExtended::update_flame_particles(float delta_time)
+{
+	flame_particles.uniform_data.camera_position = glm::vec4(camera.position, delta_time);
+
+	if (flame_particles.use_compute)
+	{
+		flame_particles.uniform_buffer->convert_and_update(flame_particles.uniform_data);
+		return;
+	}
+
+	flame_generator.update_particles(delta_time);
+
+	const std::array<glm::vec2, 4> corners = {{{0, 0},
+	                                           {1, 0},
+	                                           {1, 1},
+	                                           {0, 1}}};
+	const float                    size    = flame_particles.uniform_data.particle_size;
+
+	std::vector<NewVertex> vertices;
+	vertices.reserve(corners.size() * flame_particle_count);
+	for (auto &&particle : flame_generator.particles)
+	{
+		// Billboard facing the camera around the vertical axis
+		glm::vec3 normal = glm::normalize(particle.position + camera.position);
+		normal           = std::abs(normal.y) > 0.99f ? glm::vec3(0, 0, 1) : glm::normalize(glm::vec3(normal.x, 0, normal.z));
+		glm::vec3 u      = glm::normalize(glm::cross(normal, glm::vec3(0, 1, 0)));
+		glm::vec3 v      = glm::normalize(glm::cross(normal, u));
+
+		for (auto &corner : corners)
+		{
+			NewVertex vertex;
+			vertex.pos       = particle.position + size * ((corner.x - 0.5f) * u + (corner.y - 0.5f) * v);
+			vertex.normal    = normal;
+			vertex.tex_coord = {corner.x, 1.f - corner.y};
+			vertices.push_back(vertex);
+		}
+	}
+	flame_particles.vertex_staging_buffer->update(vertices.data(), vertices.size() * sizeof(NewVertex));
 }
 
 bool RaytracingExtended::prepare(const vkb::ApplicationOptions &options)
@@ -1399,10 +1682,18 @@ bool RaytracingExtended::prepare(const vkb::ApplicationOptions &options)
 	camera.set_rotation(glm::vec3(0.0f, 0.0f, 0.0f));
 	camera.set_translation(glm::vec3(0.0f, 1.5f, 0.f));
 
+	// Without the SPIR-V of the flame particle passes, the flame is simulated on the host
+	flame_particles.use_compute = vkb::fs::is_file(vkb::fs::path::get(vkb::fs::path::Shaders, "ray_tracing_extended/" + get_shader_folder() + "/flame_particles.comp.spv"));
+	if (!flame_particles.use_compute)
+	{
+		LOGW("Flame particle shader is not compiled, the flame particles are simulated on the host");
+	}
+
 	create_storage_image();
 	create_scene();
 	create_uniform_buffer();
 	create_ray_tracing_pipeline();
+	create_flame_particle_pipelines();
 	create_shader_binding_tables();
 	create_descriptor_sets();
 	build_command_buffers();
@@ -1411,25 +1702,28 @@ bool RaytracingExtended::prepare(const vkb::ApplicationOptions &options)
 	return true;
 }
 
-void RaytracingExtended::draw()
+/*
+    Record the whole frame in its draw command buffer: the flame particle passes, the refit of the flame and the update of
+    the top level acceleration structure, the ray tracing, and the copy to the swap chain image
+*/
+void RaytracingExtended::draw(bool print_time)
 {
-	get_device().get_fence_pool().wait();
-	get_device().get_fence_pool().reset();
-	ASSERT_LOG(raytracing_command_buffers.size() == draw_cmd_buffers.size(), "The number of raytracing command buffers must match the render queue size")
 	ApiVulkanSample::prepare_frame();
 	size_t i = current_buffer;
 
-	VkSubmitInfo submit       = vkb::initializers::submit_info();
-	submit.commandBufferCount = 1;
-	submit.pCommandBuffers    = &raytracing_command_buffers[i];
-
-	VK_CHECK(vkQueueSubmit(queue, 1, &submit, get_device().get_fence_pool().request_fence()));
-	get_device().get_fence_pool().wait();
+	// The command buffer is only recorded again once its previous submission completed
+	VK_CHECK(vkWaitForFences(get_device().get_handle(), 1, &wait_fences[i], VK_TRUE, UINT64_MAX));
+	VK_CHECK(vkResetFences(get_device().get_handle(), 1, &wait_fences[i]));
 
 	recreate_current_command_buffer();
 	VkCommandBufferBeginInfo begin = vkb::initializers::command_buffer_begin_info();
 	VK_CHECK(vkBeginCommandBuffer(draw_cmd_buffers[i], &begin));
 
+	record_flame_particles(draw_cmd_buffers[i]);
+	create_bottom_level_acceleration_structure(true, print_time, draw_cmd_buffers[i]);
+	create_top_level_acceleration_structure(print_time, draw_cmd_buffers[i]);
+	trace_rays(draw_cmd_buffers[i]);
+
 	VkImageSubresourceRange subresource_range = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
 	/*
 	    Copy ray tracing output to swap chain image
@@ -1445,12 +1739,12 @@ void RaytracingExtended::draw()
 	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 	                             subresource_range);
 
-	// Prepare ray tracing output image as transfer source
+	// Prepare ray tracing output image as transfer source, once written by the ray generation shader
 	vkb::image_layout_transition(draw_cmd_buffers[i],
 	                             storage_image.image,
-	                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+	                             VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
 	                             VK_PIPELINE_STAGE_TRANSFER_BIT,
-	                             {},
+	                             VK_ACCESS_SHADER_WRITE_BIT,
 	                             VK_ACCESS_TRANSFER_READ_BIT,
 	                             VK_IMAGE_LAYOUT_GENERAL,
 	                             VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
@@ -1485,8 +1779,7 @@ void RaytracingExtended::draw()
 
 	submit_info.commandBufferCount = 1;
 	submit_info.pCommandBuffers    = &draw_cmd_buffers[current_buffer];
-	VK_CHECK(vkQueueSubmit(queue, 1, &submit_info, get_device().get_fence_pool().request_fence()));
-	get_device().get_fence_pool().wait();
+	VK_CHECK(vkQueueSubmit(queue, 1, &submit_info, wait_fences[i]));
 	ApiVulkanSample::submit_frame();
 }
 
@@ -1499,11 +1792,9 @@ void RaytracingExtended::render(float delta_time)
 	frame_count     = (frame_count + 1) % 60;
 	bool print_time = !frame_count;
 	auto time       = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
-	flame_generator.update_particles(delta_time);
+	update_flame_particles(delta_time);
 	create_dynamic_object_buffers(static_cast<float>(time.count()) / 1000.f / 1000.f);
-	create_bottom_level_acceleration_structure(true, print_time);
-	create_top_level_acceleration_structure(print_time);
-	draw();
+	draw(print_time);
 	if (camera.updated)
 	{
 		update_uniform_buffers();
@@ -25,6 +25,7 @@
 
 #include "api_vulkan_sample.h"
 #include <core/acceleration_structure.h>
+#include <core/acceleration_structure_builder.h>
 
 class RaytracingExtended : public ApiVulkanSample
 {
@@ -58,6 +59,7 @@ class RaytracingExtended : public ApiVulkanSample
 		VkAccelerationStructureKHR          handle         = nullptr;
 		uint64_t                            device_address = 0;
 		std::unique_ptr<vkb::core::BufferC> buffer;
+		std::unique_ptr<vkb::core::BufferC> scratch_buffer;        // kept for the updates recorded in the frames
 	};
 #endif
 
@@ -71,6 +73,7 @@ class RaytracingExtended : public ApiVulkanSample
 		float     duration = 0.f;
 	};
 
+	// Host simulation of the flame particles, used when the SPIR-V of the flame particle passes is not available
 	struct FlameParticleGenerator
 	{
 		FlameParticleGenerator() = default;
@@ -143,8 +146,47 @@ class RaytracingExtended : public ApiVulkanSample
 		size_t                             n_particles = 0;
 	};
 
+	// Parameters of the flame particle passes, see shaders/ray_tracing_extended/glsl/flame_particles.comp
+	struct FlameParticleUniforms
+	{
+		glm::vec4 origin;           // xyz: center of the emitter disk, w: radius of the disk
+		glm::vec4 direction;        // xyz: emission direction, w: maximum lifetime in seconds
+		glm::vec4 u;                // basis of the emitter disk
+		glm::vec4 v;
+		glm::vec4 camera_position;        // xyz: camera position, w: time step in seconds
+		uint32_t  particle_count;
+		uint32_t  vertex_offset;        // first vertex of the billboards in the static vertex buffer
+		float     particle_size;
+		uint32_t  padding;
+	};
+
+	/**
+	 * The flame particles are emitted and simulated by compute passes, which write one billboard per particle slot into
+	 * the flame geometry of the static vertex buffer. The flame acceleration structure is then refit from it, so that
+	 * neither the particles nor their geometry go through the host.
+	 * Without the SPIR-V of these passes, the particles are simulated by flame_generator instead, and their billboards are
+	 * copied from a staging buffer into the same flame geometry.
+	 */
+	struct FlameParticles
+	{
+		FlameParticleUniforms               uniform_data{};
+		std::unique_ptr<vkb::core::BufferC> uniform_buffer;
+		std::unique_ptr<vkb::core::BufferC> particle_buffer;
+		std::unique_ptr<vkb::core::BufferC> dead_list_buffer;
+		std::unique_ptr<vkb::core::BufferC> alive_lists_buffer;
+		std::unique_ptr<vkb::core::BufferC> counter_buffer;        // list counters, followed by the indirect dispatch arguments
+		VkDescriptorSetLayout               descriptor_set_layout = VK_NULL_HANDLE;
+		VkDescriptorSet                     descriptor_set        = VK_NULL_HANDLE;
+		VkPipelineLayout                    pipeline_layout       = VK_NULL_HANDLE;
+		std::array<VkPipeline, 4>           pipelines{};        // begin emit, emit, begin simulate, simulate
+		std::unique_ptr<vkb::core::BufferC> vertex_staging_buffer;        // billboards of the host simulation
+		bool                                use_compute = true;
+	} flame_particles;
+
 	FlameParticleGenerator flame_generator;
 
+	uint32_t flame_particle_count = 2048;
+
 	struct ModelBuffer
 	{
 		size_t                                   vertex_offset           = std::numeric_limits<size_t>::max();        // in bytes
@@ -163,7 +205,8 @@ class RaytracingExtended : public ApiVulkanSample
 #endif
 		VkTransformMatrixKHR default_transform;
 		uint32_t             object_type = 0;
-		bool                 is_static   = true;
+		bool                 is_static   = true;         // stored in the static vertex and index buffers
+		bool                 is_animated = false;        // changed every frame, its acceleration structure is refit
 		uint64_t             object_id   = 0;
 	};
 
@@ -207,7 +250,8 @@ class RaytracingExtended : public ApiVulkanSample
 	Texture                          flame_texture;
 
 #ifdef USE_FRAMEWORK_ACCELERATION_STRUCTURE
-	std::unique_ptr<vkb::core::AccelerationStructure> top_level_acceleration_structure = nullptr;
+	std::unique_ptr<vkb::core::AccelerationStructure>        top_level_acceleration_structure = nullptr;
+	std::unique_ptr<vkb::core::AccelerationStructureBuilder> acceleration_structure_builder   = nullptr;
 #else
 	AccelerationStructureExtended top_level_acceleration_structure;
 #endif
@@ -248,11 +292,10 @@ class RaytracingExtended : public ApiVulkanSample
 	};
 	std::unique_ptr<vkb::core::BufferC> data_to_model_buffer;
 
-	std::vector<VkCommandBuffer> raytracing_command_buffers;
-	VkPipeline                   pipeline;
-	VkPipelineLayout             pipeline_layout;
-	VkDescriptorSet              descriptor_set;
-	VkDescriptorSetLayout        descriptor_set_layout;
+	VkPipeline            pipeline;
+	VkPipelineLayout      pipeline_layout;
+	VkDescriptorSet       descriptor_set;
+	VkDescriptorSetLayout descriptor_set_layout;
 	using Triangle                   = std::array<uint32_t, 3>;
 	uint32_t               grid_size = 100;
 	std::vector<NewVertex> refraction_model;
@@ -266,10 +309,11 @@ class RaytracingExtended : public ApiVulkanSample
 	void                 create_storage_image();
 	void                 create_static_object_buffers();
 	void                 create_flame_model();
+	void                 create_flame_particle_buffers();
 	void                 create_dynamic_object_buffers(float time);
-	void                 create_bottom_level_acceleration_structure(bool is_update, bool print_time = true);
+	void                 create_bottom_level_acceleration_structure(bool is_update, bool print_time = true, VkCommandBuffer command_buffer = VK_NULL_HANDLE);
 	VkTransformMatrixKHR calculate_rotation(glm::vec3 pt, float scale = 1.f, bool freeze_y = false);
-	void                 create_top_level_acceleration_structure(bool print_time = true);
+	void                 create_top_level_acceleration_structure(bool print_time = true, VkCommandBuffer command_buffer = VK_NULL_HANDLE);
 #ifndef USE_FRAMEWORK_ACCELERATION_STRUCTURE
 	void delete_acceleration_structure(AccelerationStructureExtended &acceleration_structure);
 #endif
@@ -278,10 +322,15 @@ class RaytracingExtended : public ApiVulkanSample
 	void create_shader_binding_tables();
 	void create_descriptor_sets();
 	void create_ray_tracing_pipeline();
+	void create_flame_particle_pipelines();
+	void record_flame_particles(VkCommandBuffer command_buffer);
+	void record_flame_particle_copy(VkCommandBuffer command_buffer);
+	void update_flame_particles(float delta_time);
 	void create_uniform_buffer();
 	void build_command_buffers() override;
 	void update_uniform_buffers();
-	void draw();
+	void trace_rays(VkCommandBuffer command_buffer);
+	void draw(bool print_time);
 	bool prepare(const vkb::ApplicationOptions &options) override;
 	void render(float delta_time) override;
 };
@@ -419,11 +419,21 @@ void RaytracingInvocationReorder::create_bottom_level_acceleration_structure(boo
 			    model_buffer.vertex_offset + (model_buffer.is_static ? static_vertex_handle : dynamic_vertex_handle),
 			    model_buffer.index_offset + (model_buffer.is_static ? static_index_handle : dynamic_index_handle));
 		}
-		model_buffer.bottom_level_acceleration_structure->set_scrach_buffer_alignment(acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment);
-		model_buffer.bottom_level_acceleration_structure->build(queue,
-		                                                        model_buffer.is_static ? VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR : VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR,
-		                                                        is_update ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR);
+		// All the bottom level acceleration structures are built together once they are all added
+		// Static geometry is compacted, dynamic geometry is refit, and periodically rebuilt to keep its trace performance
+		if (model_buffer.is_static)
+		{
+			acceleration_structure_builder->add_build(*model_buffer.bottom_level_acceleration_structure,
+			                                          VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR);
+		}
+		else
+		{
+			acceleration_structure_builder->add_update(*model_buffer.bottom_level_acceleration_structure,
+			                                           VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR);
+		}
 	}
+
+	acceleration_structure_builder->build(queue);
 }
 
 VkTransformMatrixKHR RaytracingInvocationReorder::calculate_rotation(glm::vec3 pt, float scale, bool freeze_z)
@@ -549,8 +559,8 @@ void RaytracingInvocationReorder::create_top_level_acceleration_structure(bool p
 	{
 		top_level_acceleration_structure->update_instance_geometry(instance_uid, instances_buffer, static_cast<uint32_t>(instances.size()));
 	}
-	top_level_acceleration_structure->set_scrach_buffer_alignment(acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment);
-	top_level_acceleration_structure->build(queue);
+	acceleration_structure_builder->add_build(*top_level_acceleration_structure);
+	acceleration_structure_builder->build(queue);
 }
 
 inline uint32_t aligned_size(uint32_t value, uint32_t alignment)
@@ -609,7 +619,15 @@ void RaytracingInvocationReorder::create_scene()
 	create_flame_model();
 	create_static_object_buffers();
 	create_dynamic_object_buffers(0.f);
+	acceleration_structure_builder = std::make_unique<vkb::core::AccelerationStructureBuilder>(get_device());
 	create_bottom_level_acceleration_structure(false);
+
+	auto &statistics = acceleration_structure_builder->get_statistics();
+	LOGI("BLAS compaction: {} acceleration structures, {} KiB saved of {} KiB",
+	     statistics.compaction_count,
+	     statistics.get_saved_size() / 1024,
+	     statistics.original_size / 1024);
+
 	top_level_acceleration_structure = std::make_unique<vkb::core::AccelerationStructure>(get_device(), VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR);
 	create_top_level_acceleration_structure();
 }
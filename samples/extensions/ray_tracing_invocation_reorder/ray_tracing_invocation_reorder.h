@@ -26,6 +26,7 @@
 
 #include "api_vulkan_sample.h"
 #include <core/acceleration_structure.h>
+#include <core/acceleration_structure_builder.h>
 
 class RaytracingInvocationReorder : public ApiVulkanSample
 {
@@ -203,7 +204,8 @@ class RaytracingInvocationReorder : public ApiVulkanSample
 	Texture                          flame_texture;
 
 #ifdef USE_FRAMEWORK_ACCELERATION_STRUCTURE
-	std::unique_ptr<vkb::core::AccelerationStructure> top_level_acceleration_structure = nullptr;
+	std::unique_ptr<vkb::core::AccelerationStructure>        top_level_acceleration_structure = nullptr;
+	std::unique_ptr<vkb::core::AccelerationStructureBuilder> acceleration_structure_builder   = nullptr;
 #else
 	AccelerationStructureExtended top_level_acceleration_structure;
 #endif
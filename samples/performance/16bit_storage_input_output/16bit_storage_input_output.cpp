@@ -40,7 +40,16 @@ KHR16BitStorageInputOutputSample::KHR16BitStorageInputOutputSample()
 
 void KHR16BitStorageInputOutputSample::setup_scene()
 {
-	load_scene("scenes/teapot.gltf");
+	// The vertex inputs are reduced as well: the teapot is stored in one interleaved buffer with snorm16 normals, half
+	// float texture coordinates and unorm16 positions relative to its bounding box, which the vertex shaders scale back
+	vkb::GLTFLoader::VertexLayout vertex_layout;
+	vertex_layout.interleaved        = true;
+	vertex_layout.quantize_normals   = true;
+	vertex_layout.quantize_texcoords = true;
+	vertex_layout.quantize_positions = true;
+	// Reorder the teapot's triangles and vertices for the post-transform cache, the loader logs the resulting ACMR
+	vertex_layout.optimize_vertex_order = true;
+	load_scene("scenes/teapot.gltf", vertex_layout);
 
 	// Setup the scene so we have many teapots.
 	vkb::sg::Mesh *teapot_mesh = nullptr;
@@ -156,7 +165,7 @@ void KHR16BitStorageInputOutputSample::update_pipeline()
 
 	vkb::ShaderSource vert_shader(base_path + vertex_path);
 	vkb::ShaderSource frag_shader(base_path + fragment_path);
-	auto              scene_subpass = std::make_unique<vkb::rendering::subpasses::ForwardSubpassC>(get_render_context(), std::move(vert_shader), std::move(frag_shader), get_scene(), *camera);
+	auto              scene_subpass = std::make_unique<QuantizedForwardSubpass>(get_render_context(), std::move(vert_shader), std::move(frag_shader), get_scene(), *camera);
 
 	auto render_pipeline = std::make_unique<vkb::rendering::RenderPipelineC>();
 	render_pipeline->add_subpass(std::move(scene_subpass));
@@ -164,6 +173,21 @@ void KHR16BitStorageInputOutputSample::update_pipeline()
 	set_render_pipeline(std::move(render_pipeline));
 }
 
+void KHR16BitStorageInputOutputSample::QuantizedForwardSubpass::prepare_push_constants(vkb::core::CommandBufferC &command_buffer, vkb::sg::SubMesh &sub_mesh)
+{
+	auto pbr_material = dynamic_cast<const vkb::sg::PBRMaterial *>(sub_mesh.get_material());
+	assert(pbr_material);
+
+	QuantizedPBRMaterialUniform uniform{};
+	uniform.base_color_factor = pbr_material->base_color_factor;
+	uniform.metallic_factor   = pbr_material->metallic_factor;
+	uniform.roughness_factor  = pbr_material->roughness_factor;
+	uniform.position_scale    = glm::vec4(sub_mesh.position_scale, 0.0f);
+	uniform.position_bias     = glm::vec4(sub_mesh.position_bias, 0.0f);
+
+	command_buffer.push_constants(uniform);
+}
+
 bool KHR16BitStorageInputOutputSample::prepare(const vkb::ApplicationOptions &options)
 {
 	if (!VulkanSample::prepare(options))
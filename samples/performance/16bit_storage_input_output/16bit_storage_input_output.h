@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -16,6 +16,7 @@
  */
 #pragma once
 
+#include "rendering/subpasses/forward_subpass.h"
 #include "scene_graph/components/camera.h"
 #include "vulkan_sample.h"
 
@@ -36,6 +37,36 @@ class KHR16BitStorageInputOutputSample : public vkb::VulkanSampleC
 	virtual void request_gpu_features(vkb::core::PhysicalDeviceC &gpu) override;
 
   private:
+	/**
+	 * @brief Push constants of the vertex shaders, the material factors followed by the dequantization of the positions
+	 */
+	struct QuantizedPBRMaterialUniform
+	{
+		glm::vec4 base_color_factor;
+		float     metallic_factor;
+		float     roughness_factor;
+		glm::vec2 padding;
+		glm::vec4 position_scale;
+		glm::vec4 position_bias;
+	};
+
+	/**
+	 * @brief Forward subpass pushing the position scale and bias of each submesh, whose positions are quantized relative to its bounding box
+	 */
+	class QuantizedForwardSubpass : public vkb::rendering::subpasses::ForwardSubpassC
+	{
+	  public:
+		QuantizedForwardSubpass(vkb::rendering::RenderContextC &render_context,
+		                        vkb::ShaderSource             &&vertex_shader,
+		                        vkb::ShaderSource             &&fragment_shader,
+		                        vkb::scene_graph::SceneC       &scene,
+		                        vkb::sg::Camera                &camera) :
+		    vkb::rendering::subpasses::ForwardSubpassC(render_context, std::move(vertex_shader), std::move(fragment_shader), scene, camera)
+		{}
+
+		virtual void prepare_push_constants(vkb::core::CommandBufferC &command_buffer, vkb::sg::SubMesh &sub_mesh) override;
+	};
+
 	vkb::sg::Camera *camera{nullptr};
 
 	virtual void draw_gui() override;
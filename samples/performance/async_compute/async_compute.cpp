@@ -53,8 +53,9 @@ void AsyncComputeSample::draw_gui()
 		    ImGui::Checkbox("Enable async queues", &async_enabled);
 		    ImGui::Checkbox("Double buffer HDR", &double_buffer_hdr_frames);
 		    ImGui::Checkbox("Rotate shadows", &rotate_shadows);
+		    ImGui::Checkbox("Batch submissions", &batch_submissions);
 	    },
-	    /* lines = */ 3);
+	    /* lines = */ 4);
 }
 
 static VkExtent3D downsample_extent(const VkExtent3D &extent, uint32_t level)
@@ -300,6 +301,8 @@ bool AsyncComputeSample::prepare(const vkb::ApplicationOptions &options)
 	                              vkb::StatIndex::gpu_cycles,
 	                              vkb::StatIndex::gpu_vertex_cycles,
 	                              vkb::StatIndex::gpu_fragment_cycles,
+	                              vkb::StatIndex::submit_calls,
+	                              vkb::StatIndex::submit_cpu_time,
 	                          },
 	                          config);
 
@@ -543,16 +546,7 @@ VkSemaphore AsyncComputeSample::render_swapchain(VkSemaphore post_semaphore)
 	    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
 	};
 
-	auto info                 = vkb::initializers::submit_info();
-	info.pSignalSemaphores    = signal_semaphores;
-	info.signalSemaphoreCount = 3;
-	info.pWaitSemaphores      = wait_semaphores;
-	info.waitSemaphoreCount   = 2;
-	info.pWaitDstStageMask    = wait_stages;
-	info.commandBufferCount   = 1;
-	info.pCommandBuffers      = &command_buffer->get_handle();
-
-	queue.submit({info}, get_render_context().get_active_frame().get_fence_pool().request_fence());
+	submit(queue, *command_buffer, wait_semaphores, wait_stages, signal_semaphores);
 	get_render_context().release_owned_semaphore(wait_semaphores[1]);
 	return signal_semaphores[0];
 }
@@ -703,24 +697,47 @@ VkSemaphore AsyncComputeSample::render_compute_post(VkSemaphore wait_graphics_se
 	VkSemaphore          wait_semaphores[] = {wait_graphics_semaphore, wait_present_semaphore};
 	VkSemaphore          signal_semaphore  = get_render_context().request_semaphore();
 
-	auto info                 = vkb::initializers::submit_info();
-	info.pSignalSemaphores    = &signal_semaphore;
-	info.signalSemaphoreCount = 1;
-	info.pWaitSemaphores      = wait_semaphores;
-	info.waitSemaphoreCount   = wait_present_semaphore != VK_NULL_HANDLE ? 2 : 1;
-	info.pWaitDstStageMask    = wait_stages;
-	info.commandBufferCount   = 1;
-	info.pCommandBuffers      = &command_buffer->get_handle();
+	uint32_t wait_count = wait_present_semaphore != VK_NULL_HANDLE ? 2 : 1;
+	submit(queue, *command_buffer, {wait_semaphores, wait_count}, {wait_stages, wait_count}, {&signal_semaphore, 1});
 
 	if (wait_present_semaphore != VK_NULL_HANDLE)
 	{
 		get_render_context().release_owned_semaphore(wait_present_semaphore);
 	}
 
-	queue.submit({info}, VK_NULL_HANDLE);
 	return signal_semaphore;
 }
 
+void AsyncComputeSample::submit(const vkb::Queue                     &queue,
+                                vkb::core::CommandBufferC            &command_buffer,
+                                std::span<const VkSemaphore>          wait_semaphores,
+                                std::span<const VkPipelineStageFlags> wait_stages,
+                                std::span<const VkSemaphore>          signal_semaphores)
+{
+	// Submissions with several semaphores go through the submit builder of the render context, so that they are batched
+	// with the other submissions of the frame, and tracked with the fence of the frame on their queue
+	std::vector<vkb::rendering::SemaphoreSubmit> wait_submits;
+	for (size_t i = 0; i < wait_semaphores.size(); ++i)
+	{
+		wait_submits.push_back({.semaphore = wait_semaphores[i], .stage_mask = static_cast<vk::PipelineStageFlags2>(wait_stages[i])});
+	}
+
+	std::vector<vkb::rendering::SemaphoreSubmit> signal_submits;
+	for (auto semaphore : signal_semaphores)
+	{
+		signal_submits.push_back({.semaphore = semaphore});
+	}
+
+	vk::CommandBuffer command_buffer_handle = command_buffer.get_handle();
+	get_render_context().get_submit_builder().add(
+	    reinterpret_cast<vkb::core::HPPQueue const &>(queue), {&command_buffer_handle, 1}, wait_submits, signal_submits);
+
+	if (!batch_submissions)
+	{
+		get_render_context().flush_submissions();
+	}
+}
+
 void AsyncComputeSample::update(float delta_time)
 {
 	// don't call the parent's update, because it's done differently here... but call the grandparent's update for fps logging
@@ -731,6 +748,12 @@ void AsyncComputeSample::update(float delta_time)
 		setup_queues();
 	}
 
+	// With batching, the passes of a frame are submitted together at the end of the frame, with one call per queue
+	if (batch_submissions != (get_render_context().get_submit_mode() == vkb::rendering::SubmitMode::Batched))
+	{
+		get_render_context().set_submit_mode(batch_submissions ? vkb::rendering::SubmitMode::Batched : vkb::rendering::SubmitMode::Immediate);
+	}
+
 	// We can potentially get more overlap if we double buffer the HDR render target.
 	// In this scenario, the next frame can run ahead a little further before it needs to block.
 	if (double_buffer_hdr_frames)
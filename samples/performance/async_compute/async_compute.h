@@ -54,6 +54,11 @@ class AsyncComputeSample : public vkb::VulkanSampleC
 	VkSemaphore render_compute_post(VkSemaphore wait_graphics_semaphore, VkSemaphore wait_present_semaphore);
 	VkSemaphore render_swapchain(VkSemaphore post_semaphore);
 	void        setup_queues();
+	void        submit(const vkb::Queue                     &queue,
+	                   vkb::core::CommandBufferC            &command_buffer,
+	                   std::span<const VkSemaphore>          wait_semaphores,
+	                   std::span<const VkPipelineStageFlags> wait_stages,
+	                   std::span<const VkSemaphore>          signal_semaphores);
 
 	void                                               prepare_render_targets();
 	std::unique_ptr<vkb::rendering::RenderTargetC>     forward_render_targets[2];
@@ -79,6 +84,7 @@ class AsyncComputeSample : public vkb::VulkanSampleC
 	bool        rotate_shadows{true};
 	bool        last_async_enabled{false};
 	bool        double_buffer_hdr_frames{false};
+	bool        batch_submissions{false};
 	unsigned    forward_render_target_index{};
 
 	struct DepthMapSubpass : vkb::rendering::subpasses::ForwardSubpassC
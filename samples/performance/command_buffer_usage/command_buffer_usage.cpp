@@ -134,8 +134,12 @@ void CommandBufferUsage::update(float delta_time)
 	primary_command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 	get_stats().begin_sampling(*primary_command_buffer);
 
+	record_timer.start();
 	draw(*primary_command_buffer, render_context.get_active_frame().get_render_target());
 
+	// Smooth the time over a few frames so that the reset modes can be compared
+	record_time_ms = 0.9f * record_time_ms + 0.1f * static_cast<float>(record_timer.stop<vkb::Timer::Milliseconds>());
+
 	get_stats().end_sampling(*primary_command_buffer);
 	primary_command_buffer->end();
 
@@ -145,7 +149,7 @@ void CommandBufferUsage::update(float delta_time)
 void CommandBufferUsage::draw_gui()
 {
 	const bool landscape = camera->get_aspect_ratio() > 1.0f;
-	uint32_t   lines     = landscape ? 3 : 5;
+	uint32_t   lines     = landscape ? 4 : 6;
 
 	const auto &subpass = static_cast<ForwardSubpassSecondary *>(get_render_pipeline().get_active_subpass().get());
 
@@ -178,6 +182,8 @@ void CommandBufferUsage::draw_gui()
 		    }
 		    ImGui::RadioButton(
 		        "Reset pool", &gui_command_buffer_reset_mode, static_cast<int>(vkb::CommandBufferResetMode::ResetPool));
+
+		    ImGui::Text("CPU record time: %.2f ms", record_time_ms);
 	    },
 	    /* lines = */ lines);
 }
@@ -283,7 +289,7 @@ void CommandBufferUsage::ForwardSubpassSecondary::record_draw(vkb::core::Command
 	}
 }
 
-std::shared_ptr<vkb::core::CommandBufferC>
+vkb::core::CommandBufferHandleC
     CommandBufferUsage::ForwardSubpassSecondary::record_draw_secondary(vkb::core::CommandBufferC                                                   &primary_command_buffer,
                                                                        const std::vector<std::pair<vkb::scene_graph::NodeC *, vkb::sg::SubMesh *>> &nodes,
                                                                        uint32_t                                                                     mesh_start,
@@ -348,8 +354,8 @@ void CommandBufferUsage::ForwardSubpassSecondary::draw(vkb::core::CommandBufferC
 
 	// Draw opaque objects. Depending on the subpass state, use one or multiple
 	// command buffers, and one or multiple threads
-	const bool                                              use_secondary_command_buffers = state.secondary_cmd_buf_count > 0;
-	std::vector<std::shared_ptr<vkb::core::CommandBufferC>> secondary_command_buffers;
+	const bool                                   use_secondary_command_buffers = state.secondary_cmd_buf_count > 0;
+	std::vector<vkb::core::CommandBufferHandleC> secondary_command_buffers;
 	avg_draws_per_buffer = (state.secondary_cmd_buf_count > 0) ? static_cast<float>(opaque_submeshes) / state.secondary_cmd_buf_count : 0;
 
 	if (state.thread_count != thread_pool.size())
@@ -359,7 +365,7 @@ void CommandBufferUsage::ForwardSubpassSecondary::draw(vkb::core::CommandBufferC
 
 	if (use_secondary_command_buffers)
 	{
-		std::vector<std::future<std::shared_ptr<vkb::core::CommandBufferC>>> secondary_cmd_buf_futures;
+		std::vector<std::future<vkb::core::CommandBufferHandleC>> secondary_cmd_buf_futures;
 
 		// Save the number of draws left over, these will be distributed among the first buffers
 		uint32_t draws_per_buffer = vkb::to_u32(std::floor(avg_draws_per_buffer));
@@ -24,6 +24,7 @@
 #include "scene_graph/components/material.h"
 #include "scene_graph/components/mesh.h"
 #include "scene_graph/components/perspective_camera.h"
+#include "timer.h"
 #include "vulkan_sample.h"
 
 class ThreadPool
@@ -185,14 +186,14 @@ class CommandBufferUsage : public vkb::VulkanSampleC
 		 * @param mesh_end Index to the mesh where recording will stop (not included)
 		 * @param subpass_index Index of the subpass being recorded
 		 * @param thread_index Identifies the resources allocated for this thread
-		 * @return a pointer to the recorded secondary command buffer
+		 * @return a handle to the recorded secondary command buffer
 		 */
-		std::shared_ptr<vkb::core::CommandBufferC> record_draw_secondary(vkb::core::CommandBufferC                                                   &primary_command_buffer,
-		                                                                 const std::vector<std::pair<vkb::scene_graph::NodeC *, vkb::sg::SubMesh *>> &nodes,
-		                                                                 uint32_t                                                                     mesh_start,
-		                                                                 uint32_t                                                                     mesh_end,
-		                                                                 uint32_t                                                                     subpass_index,
-		                                                                 size_t                                                                       thread_index = 0);
+		vkb::core::CommandBufferHandleC record_draw_secondary(vkb::core::CommandBufferC                                                   &primary_command_buffer,
+		                                                      const std::vector<std::pair<vkb::scene_graph::NodeC *, vkb::sg::SubMesh *>> &nodes,
+		                                                      uint32_t                                                                     mesh_start,
+		                                                      uint32_t                                                                     mesh_end,
+		                                                      uint32_t                                                                     subpass_index,
+		                                                      size_t                                                                       thread_index = 0);
 
 		VkViewport viewport{};
 
@@ -214,6 +215,11 @@ class CommandBufferUsage : public vkb::VulkanSampleC
 
 	vkb::sg::PerspectiveCamera *camera{nullptr};
 
+	// CPU time spent recording the scene, which includes requesting the secondary command buffers from the frame's pools
+	vkb::Timer record_timer;
+
+	float record_time_ms{0.0f};
+
 	void render(vkb::core::CommandBufferC &command_buffer) override;
 
 	void draw_renderpass(vkb::core::CommandBufferC &primary_command_buffer, vkb::rendering::RenderTargetC &render_target) override;
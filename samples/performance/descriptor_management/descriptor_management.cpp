@@ -34,6 +34,19 @@ DescriptorManagement::DescriptorManagement()
 
 	config.insert<vkb::IntSetting>(1, descriptor_caching.value, 1);
 	config.insert<vkb::IntSetting>(1, buffer_allocation.value, 1);
+
+	// Alternative descriptor backends, the device falls back to pooled descriptor sets without them
+	add_device_extension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, true);
+	add_device_extension(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME, true);
+	add_device_extension(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME, true);
+}
+
+void DescriptorManagement::request_gpu_features(vkb::core::PhysicalDeviceC &gpu)
+{
+	if (REQUEST_OPTIONAL_FEATURE(gpu, VkPhysicalDeviceBufferDeviceAddressFeatures, bufferDeviceAddress))
+	{
+		REQUEST_OPTIONAL_FEATURE(gpu, VkPhysicalDeviceDescriptorBufferFeaturesEXT, descriptorBuffer);
+	}
 }
 
 bool DescriptorManagement::prepare(const vkb::ApplicationOptions &options)
@@ -92,11 +105,24 @@ void DescriptorManagement::update(float delta_time)
 
 	render_context.get_active_frame().set_descriptor_management_strategy(descriptor_management_strategy);
 
+	auto backend = static_cast<vkb::DescriptorBackend>(descriptor_backend.value);
+	if (backend != get_device().get_descriptor_backend())
+	{
+		get_device().set_descriptor_backend(backend);
+
+		// Show the backend actually used, in case the device does not support the selected one
+		descriptor_backend.value = static_cast<int>(get_device().get_descriptor_backend());
+	}
+
 	command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 	get_stats().begin_sampling(*command_buffer);
 
+	record_timer.start();
 	draw(*command_buffer, render_context.get_active_frame().get_render_target());
 
+	// Smooth the time over a few frames so that the backends can be compared
+	record_time_ms = 0.9f * record_time_ms + 0.1f * static_cast<float>(record_timer.stop<vkb::Timer::Milliseconds>());
+
 	get_stats().end_sampling(*command_buffer);
 	command_buffer->end();
 
@@ -105,7 +131,8 @@ void DescriptorManagement::update(float delta_time)
 
 void DescriptorManagement::draw_gui()
 {
-	auto lines = radio_buttons.size();
+	// One more line for the record time
+	auto lines = radio_buttons.size() + 1;
 	if (camera->get_aspect_ratio() < 1.0f)
 	{
 		// In portrait, show buttons below heading
@@ -143,6 +170,8 @@ void DescriptorManagement::draw_gui()
 
 			    ImGui::PopID();
 		    }
+
+		    ImGui::Text("CPU record time: %.2f ms", record_time_ms);
 	    },
 	    /* lines = */ vkb::to_u32(lines));
 }
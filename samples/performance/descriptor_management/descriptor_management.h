@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -19,6 +19,7 @@
 
 #include "rendering/render_pipeline.h"
 #include "scene_graph/components/perspective_camera.h"
+#include "timer.h"
 #include "vulkan_sample.h"
 
 class DescriptorManagement : public vkb::VulkanSampleC
@@ -30,6 +31,8 @@ class DescriptorManagement : public vkb::VulkanSampleC
 
 	virtual ~DescriptorManagement() = default;
 
+	virtual void request_gpu_features(vkb::core::PhysicalDeviceC &gpu) override;
+
 	virtual void update(float delta_time) override;
 
   private:
@@ -54,10 +57,20 @@ class DescriptorManagement : public vkb::VulkanSampleC
 	    {"Disabled", "Enabled"},
 	    0};
 
-	std::vector<RadioButtonGroup *> radio_buttons = {&descriptor_caching, &buffer_allocation};
+	RadioButtonGroup descriptor_backend{
+	    "Descriptor backend",
+	    {"Pooled", "Push descriptors", "Descriptor buffer"},
+	    0};
+
+	std::vector<RadioButtonGroup *> radio_buttons = {&descriptor_caching, &buffer_allocation, &descriptor_backend};
 
 	vkb::sg::PerspectiveCamera *camera{nullptr};
 
+	// CPU time spent recording the scene, which includes flushing the descriptors of every draw
+	vkb::Timer record_timer;
+
+	float record_time_ms{0.0f};
+
 	virtual void draw_gui() override;
 };
 
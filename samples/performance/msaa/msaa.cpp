@@ -22,6 +22,7 @@
 #include "gltf_loader.h"
 #include "gui.h"
 
+#include "rendering/attachment_allocator.h"
 #include "rendering/postprocessing_renderpass.h"
 #include "rendering/subpasses/forward_subpass.h"
 #include "stats/stats.h"
@@ -172,19 +173,56 @@ std::unique_ptr<vkb::rendering::RenderTargetC> MSAASample::create_render_target(
 		depth_resolve_usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
 	}
 
-	vkb::core::Image depth_image{device,
-	                             extent,
-	                             depth_format,
-	                             depth_usage,
-	                             VMA_MEMORY_USAGE_GPU_ONLY,
-	                             sample_count};
+	// Attachments of the render target, in the order of their images
+	i_swapchain     = 0;
+	i_depth         = 1;
+	i_color_ms      = 2;
+	i_color_resolve = 3;
+	i_depth_resolve = 4;
 
-	vkb::core::Image depth_resolve_image{device,
-	                                     extent,
-	                                     depth_format,
-	                                     depth_resolve_usage,
-	                                     VMA_MEMORY_USAGE_GPU_ONLY,
-	                                     VK_SAMPLE_COUNT_1_BIT};
+	// The scene is drawn by pass 0, the postprocessing pass sampling the resolved color and depth is pass 1
+	std::vector<vkb::rendering::AttachmentLifetime> lifetimes(5);
+	if (scene_pipeline)
+	{
+		scene_pipeline->add_attachment_lifetimes(lifetimes, i_depth, 0);
+		if (run_postprocessing)
+		{
+			get_postprocessing_pipeline(msaa_enabled).add_attachment_lifetimes(lifetimes, 1);
+
+			if (msaa_enabled && ColorResolve::SeparatePass == color_resolve_method)
+			{
+				// The multisampled color is resolved outside of the pipelines, right after the scene pass
+				lifetimes[i_color_resolve].add_pass(0);
+			}
+		}
+	}
+	else
+	{
+		// The pipelines are not created yet, the render target is recreated once they are
+		for (auto &lifetime : lifetimes)
+		{
+			lifetime.add_pass(0);
+		}
+	}
+
+	// The attachments used by the scene pass cannot alias each other, but the ones which the current options leave unused
+	// share memory. The allocator also places the transient ones in lazily allocated memory and reports the memory of the
+	// render target.
+	vkb::rendering::AttachmentAllocator allocator{reinterpret_cast<vkb::core::DeviceCpp &>(device)};
+
+	auto add_attachment = [&](VkFormat format, VkImageUsageFlags usage, VkSampleCountFlagBits samples, const char *name, uint32_t index) {
+		vkb::core::HPPImageBuilder builder{extent.width, extent.height};
+		builder.with_format(static_cast<vk::Format>(format))
+		    .with_usage(static_cast<vk::ImageUsageFlags>(usage))
+		    .with_sample_count(static_cast<vk::SampleCountFlagBits>(samples))
+		    .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
+		    .with_debug_name(name);
+
+		return allocator.add_attachment(builder, lifetimes[index]);
+	};
+
+	uint32_t depth_attachment         = add_attachment(depth_format, depth_usage, sample_count, "Depth", i_depth);
+	uint32_t depth_resolve_attachment = add_attachment(depth_format, depth_resolve_usage, VK_SAMPLE_COUNT_1_BIT, "Resolved depth", i_depth_resolve);
 
 	VkImageUsageFlags color_ms_usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 	if (ColorResolve::OnWriteback == color_resolve_method)
@@ -200,12 +238,7 @@ std::unique_ptr<vkb::rendering::RenderTargetC> MSAASample::create_render_target(
 		color_ms_usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
 	}
 
-	vkb::core::Image color_ms_image{device,
-	                                extent,
-	                                swapchain_image.get_format(),
-	                                color_ms_usage,
-	                                VMA_MEMORY_USAGE_GPU_ONLY,
-	                                sample_count};
+	uint32_t color_ms_attachment = add_attachment(swapchain_image.get_format(), color_ms_usage, sample_count, "Multisampled color", i_color_ms);
 
 	VkImageUsageFlags color_resolve_usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 	if (run_postprocessing)
@@ -222,12 +255,11 @@ std::unique_ptr<vkb::rendering::RenderTargetC> MSAASample::create_render_target(
 		color_resolve_usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
 	}
 
-	vkb::core::Image color_resolve_image{device,
-	                                     extent,
-	                                     swapchain_image.get_format(),
-	                                     color_resolve_usage,
-	                                     VMA_MEMORY_USAGE_GPU_ONLY,
-	                                     VK_SAMPLE_COUNT_1_BIT};
+	uint32_t color_resolve_attachment = add_attachment(swapchain_image.get_format(), color_resolve_usage, VK_SAMPLE_COUNT_1_BIT, "Resolved color", i_color_resolve);
+
+	// The framework images of both bindings share their layout
+	std::vector<vkb::core::HPPImage> allocated_images  = allocator.allocate();
+	auto                            &attachment_images = reinterpret_cast<std::vector<vkb::core::Image> &>(allocated_images);
 
 	scene_load_store.clear();
 	std::vector<vkb::core::Image> images;
@@ -235,33 +267,28 @@ std::unique_ptr<vkb::rendering::RenderTargetC> MSAASample::create_render_target(
 	// Attachment 0 - Swapchain
 	// Used by the scene renderpass if postprocessing is disabled
 	// Used by the postprocessing renderpass if postprocessing is enabled
-	i_swapchain = 0;
 	images.push_back(std::move(swapchain_image));
 	scene_load_store.push_back({VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_STORE});
 
 	// Attachment 1 - Depth
 	// Always used by the scene renderpass, may or may not be multisampled
-	i_depth = 1;
-	images.push_back(std::move(depth_image));
+	images.push_back(std::move(attachment_images[depth_attachment]));
 	scene_load_store.push_back({VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_DONT_CARE});
 
 	// Attachment 2 - Multisampled color
 	// Used by the scene renderpass if MSAA is enabled
-	i_color_ms = 2;
-	images.push_back(std::move(color_ms_image));
+	images.push_back(std::move(attachment_images[color_ms_attachment]));
 	scene_load_store.push_back({VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_DONT_CARE});
 
 	// Attachment 3 - Resolved color
 	// Used as an output by the scene renderpass if MSAA and postprocessing are enabled
 	// Used as an input by the postprocessing renderpass
-	i_color_resolve = 3;
-	images.push_back(std::move(color_resolve_image));
+	images.push_back(std::move(attachment_images[color_resolve_attachment]));
 	scene_load_store.push_back({VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_DONT_CARE});
 
 	// Attachment 4 - Resolved depth
 	// Used for writeback depth resolve if MSAA is enabled and the required extension is supported
-	i_depth_resolve = 4;
-	images.push_back(std::move(depth_resolve_image));
+	images.push_back(std::move(attachment_images[depth_resolve_attachment]));
 	scene_load_store.push_back({VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_DONT_CARE});
 
 	color_atts = {i_swapchain, i_color_ms, i_color_resolve};
@@ -378,10 +405,33 @@ void MSAASample::update_for_scene_and_postprocessing(bool msaa_enabled)
 	// Swapchain is not used in the scene renderpass
 	scene_load_store[i_swapchain].store_op = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 
+	// Bind the attachments read by the postprocessing renderpass now, as the lifetimes of the attachments
+	// of the render targets are derived from the pipelines when they are recreated
+	auto        depth_attachment   = (msaa_enabled && depth_writeback_resolve_supported && resolve_depth_on_writeback) ? i_depth_resolve : i_depth;
+	bool        multisampled_depth = msaa_enabled && !(depth_writeback_resolve_supported && resolve_depth_on_writeback);
+	std::string depth_sampler_name = multisampled_depth ? "ms_depth_sampler" : "depth_sampler";
+
+	auto &postprocessing_subpass = get_postprocessing_pipeline(msaa_enabled).get_pass(0).get_subpass(0);
+	// Unbind sampled images to prevent invalid image transitions on unused images
+	postprocessing_subpass.unbind_sampled_image("depth_sampler");
+	postprocessing_subpass.unbind_sampled_image("ms_depth_sampler");
+
+	postprocessing_subpass.get_fs_variant().clear();
+
+	postprocessing_subpass
+	    .bind_sampled_image(depth_sampler_name, {depth_attachment, nullptr, nullptr, depth_writeback_resolve_supported && resolve_depth_on_writeback})
+	    .bind_sampled_image("color_sampler", i_color_resolve);
+
 	// Update the scene renderpass
 	scene_pipeline->set_load_store(scene_load_store);
 }
 
+vkb::PostProcessingPipeline &MSAASample::get_postprocessing_pipeline(bool msaa_enabled)
+{
+	bool multisampled_depth = msaa_enabled && !(depth_writeback_resolve_supported && resolve_depth_on_writeback);
+	return multisampled_depth ? *ms_depth_postprocessing_pipeline : *postprocessing_pipeline;
+}
+
 void MSAASample::use_multisampled_color(std::unique_ptr<vkb::rendering::SubpassC> &subpass,
                                         std::vector<vkb::LoadStoreInfo>           &load_store,
                                         uint32_t                                   resolve_attachment)
@@ -585,32 +635,17 @@ void MSAASample::postprocessing(vkb::core::CommandBufferC     &command_buffer,
                                 VkImageLayout                 &swapchain_layout,
                                 bool                           msaa_enabled)
 {
-	auto        depth_attachment   = (msaa_enabled && depth_writeback_resolve_supported && resolve_depth_on_writeback) ? i_depth_resolve : i_depth;
-	bool        multisampled_depth = msaa_enabled && !(depth_writeback_resolve_supported && resolve_depth_on_writeback);
-	std::string depth_sampler_name = multisampled_depth ? "ms_depth_sampler" : "depth_sampler";
-
 	glm::vec4 near_far = {camera->get_far_plane(), camera->get_near_plane(), -1.0f, -1.0f};
 
-	// Select the currently active pipeline
-	auto &pipeline = multisampled_depth ? ms_depth_postprocessing_pipeline : postprocessing_pipeline;
+	// Select the currently active pipeline, its sampled images are bound by update_for_scene_and_postprocessing
+	auto &pipeline = get_postprocessing_pipeline(msaa_enabled);
 
-	auto &postprocessing_pass = pipeline->get_pass(0);
+	auto &postprocessing_pass = pipeline.get_pass(0);
 	postprocessing_pass.set_uniform_data(near_far);
 
-	auto &postprocessing_subpass = postprocessing_pass.get_subpass(0);
-	// Unbind sampled images to prevent invalid image transitions on unused images
-	postprocessing_subpass.unbind_sampled_image("depth_sampler");
-	postprocessing_subpass.unbind_sampled_image("ms_depth_sampler");
-
-	postprocessing_subpass.get_fs_variant().clear();
-
-	postprocessing_subpass
-	    .bind_sampled_image(depth_sampler_name, {depth_attachment, nullptr, nullptr, depth_writeback_resolve_supported && resolve_depth_on_writeback})
-	    .bind_sampled_image("color_sampler", i_color_resolve);
-
 	// Second render pass
 	// NOTE: Color and depth attachments are automatically transitioned to be bound as textures
-	pipeline->draw(command_buffer, render_target);
+	pipeline.draw(command_buffer, render_target);
 
 	if (has_gui())
 	{
@@ -123,6 +123,12 @@ class MSAASample : public vkb::VulkanSampleC
 	 */
 	void update_for_scene_and_postprocessing(bool msaa_enabled);
 
+	/**
+	 * @brief Returns the postprocessing pipeline reading single-sampled
+	 *        or multisampled depth, depending on the resolve options
+	 */
+	vkb::PostProcessingPipeline &get_postprocessing_pipeline(bool msaa_enabled);
+
 	/**
 	 * @brief If true the postprocessing renderpass is enabled
 	 */
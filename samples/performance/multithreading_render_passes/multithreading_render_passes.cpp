@@ -185,13 +185,13 @@ void MultithreadingRenderPasses::draw_gui()
 	    lines);
 }
 
-std::vector<std::shared_ptr<vkb::core::CommandBufferC>>
-    MultithreadingRenderPasses::record_command_buffers(std::shared_ptr<vkb::core::CommandBufferC> main_command_buffer)
+std::vector<vkb::core::CommandBufferHandleC>
+    MultithreadingRenderPasses::record_command_buffers(vkb::core::CommandBufferHandleC main_command_buffer)
 {
 	auto        reset_mode = vkb::CommandBufferResetMode::ResetPool;
 	const auto &queue      = get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
 
-	std::vector<std::shared_ptr<vkb::core::CommandBufferC>> command_buffers;
+	std::vector<vkb::core::CommandBufferHandleC> command_buffers;
 
 	// Resources are requested from pools for thread #1 in shadow pass if multithreading is used
 	auto use_multithreading = multithreading_mode != static_cast<int>(MultithreadingMode::None);
@@ -217,8 +217,8 @@ std::vector<std::shared_ptr<vkb::core::CommandBufferC>>
 	return command_buffers;
 }
 
-void MultithreadingRenderPasses::record_separate_primary_command_buffers(std::vector<std::shared_ptr<vkb::core::CommandBufferC>> &command_buffers,
-                                                                         std::shared_ptr<vkb::core::CommandBufferC>               main_command_buffer)
+void MultithreadingRenderPasses::record_separate_primary_command_buffers(std::vector<vkb::core::CommandBufferHandleC> &command_buffers,
+                                                                         vkb::core::CommandBufferHandleC               main_command_buffer)
 {
 	auto        reset_mode = vkb::CommandBufferResetMode::ResetPool;
 	const auto &queue      = get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
@@ -247,8 +247,8 @@ void MultithreadingRenderPasses::record_separate_primary_command_buffers(std::ve
 	shadow_buffer_future.get();
 }
 
-void MultithreadingRenderPasses::record_separate_secondary_command_buffers(std::vector<std::shared_ptr<vkb::core::CommandBufferC>> &command_buffers,
-                                                                           std::shared_ptr<vkb::core::CommandBufferC>               main_command_buffer)
+void MultithreadingRenderPasses::record_separate_secondary_command_buffers(std::vector<vkb::core::CommandBufferHandleC> &command_buffers,
+                                                                           vkb::core::CommandBufferHandleC               main_command_buffer)
 {
 	auto        reset_mode = vkb::CommandBufferResetMode::ResetPool;
 	const auto &queue      = get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
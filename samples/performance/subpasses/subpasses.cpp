@@ -19,14 +19,36 @@
 
 #include "common/vk_common.h"
 
+#include "filesystem/legacy.h"
 #include "gui.h"
+#include "rendering/attachment_allocator.h"
 #include "rendering/pipeline_state.h"
 #include "rendering/render_context.h"
 #include "rendering/render_pipeline.h"
+#include "rendering/subpasses/forward_subpass.h"
 #include "rendering/subpasses/geometry_subpass.h"
 #include "rendering/subpasses/lighting_subpass.h"
 #include "scene_graph/node.h"
 
+namespace
+{
+/**
+ * @return True if the SPIR-V of all the given shaders is available
+ */
+bool spirv_available(std::initializer_list<const char *> shaders)
+{
+	for (auto shader : shaders)
+	{
+		if (!vkb::fs::is_file(vkb::fs::path::get(vkb::fs::path::Shaders, shader)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+}        // namespace
+
 Subpasses::Subpasses()
 {
 	auto &config = get_configuration();
@@ -50,6 +72,31 @@ Subpasses::Subpasses()
 	config.insert<vkb::IntSetting>(3, configs[Config::RenderTechnique].value, 0);
 	config.insert<vkb::IntSetting>(3, configs[Config::TransientAttachments].value, 0);
 	config.insert<vkb::IntSetting>(3, configs[Config::GBufferSize].value, 1);
+
+	// No light culling in the configurations above
+	for (uint32_t index = 0; index < 4; ++index)
+	{
+		config.insert<vkb::IntSetting>(index, configs[Config::LightCulling].value, 0);
+		config.insert<vkb::IntSetting>(index, configs[Config::LightCount].value, 0);
+	}
+
+	// Clustered light culling on the CPU and on the GPU, with 48, 1k and 10k point lights, deferred with subpasses (4 to 9)
+	// and forward (10 to 15)
+	for (int render_technique : {0, 2})
+	{
+		for (int light_count = 0; light_count < 3; ++light_count)
+		{
+			for (int light_culling = 1; light_culling < 3; ++light_culling)
+			{
+				uint32_t index = (render_technique == 0 ? 4 : 10) + light_count * 2 + light_culling - 1;
+				config.insert<vkb::IntSetting>(index, configs[Config::RenderTechnique].value, render_technique);
+				config.insert<vkb::IntSetting>(index, configs[Config::TransientAttachments].value, 0);
+				config.insert<vkb::IntSetting>(index, configs[Config::GBufferSize].value, 0);
+				config.insert<vkb::IntSetting>(index, configs[Config::LightCulling].value, light_culling);
+				config.insert<vkb::IntSetting>(index, configs[Config::LightCount].value, light_count);
+			}
+		}
+	}
 }
 
 std::unique_ptr<vkb::rendering::RenderTargetC> Subpasses::create_render_target(vkb::core::Image &&swapchain_image)
@@ -63,23 +110,59 @@ std::unique_ptr<vkb::rendering::RenderTargetC> Subpasses::create_render_target(v
 	// Albedo                  RGBA8_UNORM   (32-bit)
 	// Normal                  RGB10A2_UNORM (32-bit)
 
-	vkb::core::Image depth_image{device,
-	                             extent,
-	                             vkb::get_suitable_depth_format(swapchain_image.get_device().get_gpu().get_handle()),
-	                             VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | rt_usage_flags,
-	                             VMA_MEMORY_USAGE_GPU_ONLY};
+	// Attachment 1, the depth, is the first one with a depth format, which the render passes use as depth attachment
+	constexpr uint32_t depth_index  = 1;
+	constexpr uint32_t albedo_index = 2;
+	constexpr uint32_t normal_index = 3;
+
+	// The lifetimes of the attachments are derived from the pipelines of the current render technique. The geometry
+	// pass, or subpass, writes the G-buffer and the lighting one reads it, so its attachments are live at the same time
+	// and cannot alias each other, while the forward pass leaves the G-buffer unused, which then shares memory.
+	std::vector<vkb::rendering::AttachmentLifetime> lifetimes(4);
+	if (render_pipeline)
+	{
+		switch (configs[Config::RenderTechnique].value)
+		{
+			case 0:
+				render_pipeline->add_attachment_lifetimes(lifetimes, depth_index, 0);
+				break;
+			case 1:
+				geometry_render_pipeline->add_attachment_lifetimes(lifetimes, depth_index, 0);
+				lighting_render_pipeline->add_attachment_lifetimes(lifetimes, depth_index, 1);
+				break;
+			default:
+				forward_render_pipeline->add_attachment_lifetimes(lifetimes, depth_index, 0);
+				break;
+		}
+	}
+	else
+	{
+		// The pipelines are not created yet, the render targets are recreated once they are
+		for (auto &lifetime : lifetimes)
+		{
+			lifetime.add_pass(0);
+		}
+	}
+
+	// The allocator also places the transient attachments in lazily allocated memory and reports the memory of the render target
+	vkb::rendering::AttachmentAllocator allocator{reinterpret_cast<vkb::core::DeviceCpp &>(device)};
 
-	vkb::core::Image albedo_image{device,
-	                              extent,
-	                              albedo_format,
-	                              VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | rt_usage_flags,
-	                              VMA_MEMORY_USAGE_GPU_ONLY};
+	auto add_attachment = [&](VkFormat format, VkImageUsageFlags usage, const char *name, uint32_t index) {
+		vkb::core::HPPImageBuilder builder{extent.width, extent.height};
+		builder.with_format(static_cast<vk::Format>(format))
+		    .with_usage(static_cast<vk::ImageUsageFlags>(usage | rt_usage_flags))
+		    .with_vma_usage(VMA_MEMORY_USAGE_GPU_ONLY)
+		    .with_debug_name(name);
+		return allocator.add_attachment(builder, lifetimes[index]);
+	};
 
-	vkb::core::Image normal_image{device,
-	                              extent,
-	                              normal_format,
-	                              VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | rt_usage_flags,
-	                              VMA_MEMORY_USAGE_GPU_ONLY};
+	uint32_t depth_attachment  = add_attachment(vkb::get_suitable_depth_format(device.get_gpu().get_handle()), VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, "G-buffer depth", depth_index);
+	uint32_t albedo_attachment = add_attachment(albedo_format, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, "G-buffer albedo", albedo_index);
+	uint32_t normal_attachment = add_attachment(normal_format, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, "G-buffer normal", normal_index);
+
+	// The framework images of both bindings share their layout
+	std::vector<vkb::core::HPPImage> allocated_images  = allocator.allocate();
+	auto                            &attachment_images = reinterpret_cast<std::vector<vkb::core::Image> &>(allocated_images);
 
 	std::vector<vkb::core::Image> images;
 
@@ -87,13 +170,13 @@ std::unique_ptr<vkb::rendering::RenderTargetC> Subpasses::create_render_target(v
 	images.push_back(std::move(swapchain_image));
 
 	// Attachment 1
-	images.push_back(std::move(depth_image));
+	images.push_back(std::move(attachment_images[depth_attachment]));
 
 	// Attachment 2
-	images.push_back(std::move(albedo_image));
+	images.push_back(std::move(attachment_images[albedo_attachment]));
 
 	// Attachment 3
-	images.push_back(std::move(normal_image));
+	images.push_back(std::move(attachment_images[normal_attachment]));
 
 	return std::make_unique<vkb::rendering::RenderTargetC>(std::move(images));
 }
@@ -150,11 +233,21 @@ bool Subpasses::prepare(const vkb::ApplicationOptions &options)
 	auto &camera_node = vkb::add_free_camera(get_scene(), "main_camera", get_render_context().get_surface_extent());
 	camera            = dynamic_cast<vkb::sg::PerspectiveCamera *>(&camera_node.get_component<vkb::sg::Camera>());
 
+	check_light_culling_shaders();
+
+	light_clusters = std::make_unique<vkb::rendering::LightClusters>();
+	update_clustered_lights();
+
 	render_pipeline = create_one_renderpass_two_subpasses();
 
 	geometry_render_pipeline = create_geometry_renderpass();
 	lighting_render_pipeline = create_lighting_renderpass();
 
+	forward_render_pipeline = create_forward_renderpass();
+
+	// Derive the lifetimes of the attachments from the pipelines
+	get_render_context().recreate();
+
 	// Enable stats
 	get_stats().request_stats({vkb::StatIndex::frame_times,
 	                           vkb::StatIndex::gpu_fragment_jobs,
@@ -187,20 +280,16 @@ void Subpasses::request_layer_settings(std::vector<VkLayerSettingEXT>
 void Subpasses::update(float delta_time)
 {
 	// Check whether the user changed the render technique
-	if (configs[Config::RenderTechnique].value != last_render_technique)
+	bool render_technique_changed = configs[Config::RenderTechnique].value != last_render_technique;
+	if (render_technique_changed)
 	{
 		LOGI("Changing render technique");
 		last_render_technique = configs[Config::RenderTechnique].value;
-
-		// Reset frames, their synchronization objects and their command buffers
-		for (auto &frame : get_render_context().get_render_frames())
-		{
-			frame->reset();
-		}
 	}
 
-	// Check whether the user switched the attachment or the G-buffer option
-	if (configs[Config::TransientAttachments].value != last_transient_attachment ||
+	// Check whether the user switched the render technique, which changes the attachments used, or the attachment or the G-buffer option
+	if (render_technique_changed ||
+	    configs[Config::TransientAttachments].value != last_transient_attachment ||
 	    configs[Config::GBufferSize].value != last_g_buffer_size)
 	{
 		// If attachment option has changed
@@ -249,9 +338,91 @@ void Subpasses::update(float delta_time)
 		get_render_context().recreate();
 	}
 
+	// Check whether the user switched the light culling or the light count option
+	check_light_culling_shaders();
+	if (configs[Config::LightCulling].value != last_light_culling ||
+	    configs[Config::LightCount].value != last_light_count)
+	{
+		// The lighting and forward subpasses use a different fragment shader with clustered lighting
+		if ((configs[Config::LightCulling].value == 0) != (last_light_culling == 0))
+		{
+			LOGI("Recreating lighting subpasses");
+
+			render_pipeline          = create_one_renderpass_two_subpasses();
+			lighting_render_pipeline = create_lighting_renderpass();
+			forward_render_pipeline  = create_forward_renderpass();
+		}
+
+		last_light_culling = configs[Config::LightCulling].value;
+		last_light_count   = configs[Config::LightCount].value;
+
+		light_clusters->set_mode(last_light_culling == 2 ? vkb::rendering::LightCullingMode::GPU : vkb::rendering::LightCullingMode::CPU);
+		update_clustered_lights();
+	}
+
 	VulkanSample::update(delta_time);
 }
 
+std::string Subpasses::get_lighting_fragment_shader() const
+{
+	return configs[Config::LightCulling].value == 0 ? "deferred/lighting.frag.spv" : "deferred/lighting_clustered.frag.spv";
+}
+
+void Subpasses::check_light_culling_shaders()
+{
+	auto &light_culling = configs[Config::LightCulling].value;
+
+	if (light_culling != 0 && !spirv_available({"deferred/lighting_clustered.frag.spv", "base_clustered.frag.spv"}))
+	{
+		LOGW("SPIR-V of the clustered lighting shaders not found, light culling stays disabled");
+		light_culling = 0;
+	}
+
+	if (light_culling == 2 && !spirv_available({"clustered/light_culling.comp.spv"}))
+	{
+		LOGW("SPIR-V of the light culling shader not found, lights are binned on the CPU");
+		light_culling = 1;
+	}
+}
+
+void Subpasses::update_clustered_lights()
+{
+	const size_t light_counts[] = {48, 1024, 10240};
+
+	auto   scene_lights = get_scene().get_components<vkb::sg::Light>();
+	size_t light_count  = std::max(light_counts[configs[Config::LightCount].value], scene_lights.size());
+
+	// Extra point lights are scattered across the Sponza scene, with a range so that each of them only reaches nearby clusters
+	while (scene_lights.size() + extra_lights.size() < light_count)
+	{
+		auto node  = std::make_unique<vkb::scene_graph::NodeC>(-1, "clustered light node");
+		auto light = std::make_unique<vkb::sg::Light>("clustered light");
+
+		auto random = [](float min, float max) { return min + (max - min) * static_cast<float>(rand()) / RAND_MAX; };
+
+		node->get_transform().set_translation(glm::vec3{random(-1600.0f, 1600.0f), random(10.0f, 700.0f), random(-650.0f, 650.0f)});
+		node->set_component(*light);
+
+		vkb::sg::LightProperties props;
+		props.color     = glm::vec3{random(0.0f, 1.0f), random(0.0f, 1.0f), random(0.0f, 1.0f)};
+		props.intensity = 0.1f;
+		props.range     = 300.0f;
+
+		light->set_node(*node);
+		light->set_light_type(vkb::sg::LightType::Point);
+		light->set_properties(props);
+
+		extra_light_nodes.push_back(std::move(node));
+		extra_lights.push_back(std::move(light));
+	}
+
+	clustered_lights.assign(scene_lights.begin(), scene_lights.end());
+	for (size_t i = 0; clustered_lights.size() < light_count; ++i)
+	{
+		clustered_lights.push_back(extra_lights[i].get());
+	}
+}
+
 void Subpasses::draw_gui()
 {
 	auto lines = configs.size();
@@ -261,8 +432,15 @@ void Subpasses::draw_gui()
 		lines = lines * 2;
 	}
 
+	bool light_culling = last_light_culling != 0;
+	if (light_culling)
+	{
+		// Line for the light culling statistics
+		lines++;
+	}
+
 	get_gui().show_options_window(
-	    /* body = */ [this, lines]() {
+	    /* body = */ [this, lines, light_culling]() {
 		    // Create a line for every config
 		    for (size_t i = 0; i < configs.size(); ++i)
 		    {
@@ -293,6 +471,20 @@ void Subpasses::draw_gui()
 
 			    ImGui::PopID();
 		    }
+
+		    if (light_culling)
+		    {
+			    const auto &statistics = light_clusters->get_statistics();
+			    if (light_clusters->get_mode() == vkb::rendering::LightCullingMode::CPU)
+			    {
+				    ImGui::Text("%u lights, up to %u per cluster, binned in %.2f ms",
+				                statistics.light_count, statistics.max_lights_per_cluster, statistics.binning_time_ms);
+			    }
+			    else
+			    {
+				    ImGui::Text("%u lights, binned on the GPU", statistics.light_count);
+			    }
+		    }
 	    },
 	    /* lines = */ vkb::to_u32(lines));
 }
@@ -310,9 +502,14 @@ std::unique_ptr<vkb::rendering::RenderPipelineC> Subpasses::create_one_renderpas
 
 	// Lighting subpass
 	auto lighting_vs      = vkb::ShaderSource{"deferred/lighting.vert.spv"};
-	auto lighting_fs      = vkb::ShaderSource{"deferred/lighting.frag.spv"};
+	auto lighting_fs      = vkb::ShaderSource{get_lighting_fragment_shader()};
 	auto lighting_subpass = std::make_unique<vkb::LightingSubpass>(get_render_context(), std::move(lighting_vs), std::move(lighting_fs), *camera, get_scene());
 
+	if (configs[Config::LightCulling].value != 0)
+	{
+		lighting_subpass->set_light_clusters(light_clusters.get());
+	}
+
 	// Inputs are depth, albedo, and normal from the geometry subpass
 	lighting_subpass->set_input_attachments({1, 2, 3});
 
@@ -358,9 +555,14 @@ std::unique_ptr<vkb::rendering::RenderPipelineC> Subpasses::create_lighting_rend
 {
 	// Lighting subpass
 	auto lighting_vs      = vkb::ShaderSource{"deferred/lighting.vert.spv"};
-	auto lighting_fs      = vkb::ShaderSource{"deferred/lighting.frag.spv"};
+	auto lighting_fs      = vkb::ShaderSource{get_lighting_fragment_shader()};
 	auto lighting_subpass = std::make_unique<vkb::LightingSubpass>(get_render_context(), std::move(lighting_vs), std::move(lighting_fs), *camera, get_scene());
 
+	if (configs[Config::LightCulling].value != 0)
+	{
+		lighting_subpass->set_light_clusters(light_clusters.get());
+	}
+
 	// Inputs are depth, albedo, and normal from the geometry subpass
 	lighting_subpass->set_input_attachments({1, 2, 3});
 	// Create lighting pipeline
@@ -376,6 +578,31 @@ std::unique_ptr<vkb::rendering::RenderPipelineC> Subpasses::create_lighting_rend
 	return lighting_render_pipeline;
 }
 
+std::unique_ptr<vkb::rendering::RenderPipelineC> Subpasses::create_forward_renderpass()
+{
+	// Forward subpass, which writes the swapchain image and depth, the G-buffer attachments are left unused
+	auto forward_vs      = vkb::ShaderSource{"base.vert.spv"};
+	auto forward_fs      = vkb::ShaderSource{configs[Config::LightCulling].value == 0 ? "base.frag.spv" : "base_clustered.frag.spv"};
+	auto forward_subpass = std::make_unique<vkb::rendering::subpasses::ForwardSubpassC>(
+	    get_render_context(), std::move(forward_vs), std::move(forward_fs), get_scene(), *camera);
+
+	if (configs[Config::LightCulling].value != 0)
+	{
+		forward_subpass->set_light_clusters(light_clusters.get());
+	}
+
+	std::vector<std::unique_ptr<vkb::rendering::SubpassC>> forward_subpasses{};
+	forward_subpasses.push_back(std::move(forward_subpass));
+
+	auto forward_render_pipeline = std::make_unique<vkb::rendering::RenderPipelineC>(std::move(forward_subpasses));
+
+	forward_render_pipeline->set_load_store(vkb::gbuffer::get_clear_all_store_swapchain());
+
+	forward_render_pipeline->set_clear_value(vkb::gbuffer::get_clear_value());
+
+	return forward_render_pipeline;
+}
+
 void draw_pipeline(vkb::core::CommandBufferC       &command_buffer,
                    vkb::rendering::RenderTargetC   &render_target,
                    vkb::rendering::RenderPipelineC &render_pipeline,
@@ -451,16 +678,28 @@ void Subpasses::draw_renderpasses(vkb::core::CommandBufferC &command_buffer, vkb
 
 void Subpasses::draw_renderpass(vkb::core::CommandBufferC &command_buffer, vkb::rendering::RenderTargetC &render_target)
 {
+	// The last applied option matches the lighting subpasses, the GUI may have changed the option since
+	if (last_light_culling != 0)
+	{
+		// Light lists are built before the render passes begin, as the GPU culling is a compute dispatch
+		light_clusters->update(command_buffer, get_render_context().get_active_frame(), clustered_lights, *camera, render_target.get_extent());
+	}
+
 	if (configs[Config::RenderTechnique].value == 0)
 	{
 		// Efficient way
 		draw_subpasses(command_buffer, render_target);
 	}
-	else
+	else if (configs[Config::RenderTechnique].value == 1)
 	{
 		// Inefficient way
 		draw_renderpasses(command_buffer, render_target);
 	}
+	else
+	{
+		// Forward rendering, for comparison with clustered lighting
+		draw_pipeline(command_buffer, render_target, *forward_render_pipeline, &get_gui());
+	}
 }
 
 std::unique_ptr<vkb::VulkanSampleC> create_subpasses()
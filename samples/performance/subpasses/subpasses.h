@@ -17,8 +17,11 @@
 
 #pragma once
 
+#include "rendering/light_clusters.h"
 #include "rendering/render_pipeline.h"
+#include "scene_graph/components/light.h"
 #include "scene_graph/components/perspective_camera.h"
+#include "scene_graph/node.h"
 #include "vulkan_sample.h"
 
 /**
@@ -27,6 +30,9 @@
  *        of multiple render passes. In order to highlight the difference, it
  *        implements deferred rendering with and without sub-passes, giving the
  *        user the possibility to change some key settings.
+ *        The lighting subpass can also use clustered light culling, on the CPU or
+ *        on the GPU, to render many more lights than its fixed light arrays allow,
+ *        and be compared with a forward render pass using the same light clusters.
  */
 class Subpasses : public vkb::VulkanSampleC
 {
@@ -70,6 +76,11 @@ class Subpasses : public vkb::VulkanSampleC
 	 */
 	std::unique_ptr<vkb::rendering::RenderPipelineC> create_lighting_renderpass();
 
+	/**
+	 * @return A forward render pass, shading the scene in a single subpass
+	 */
+	std::unique_ptr<vkb::rendering::RenderPipelineC> create_forward_renderpass();
+
 	/**
 	 * @brief Draws using the good pipeline: one render pass with two subpasses
 	 */
@@ -82,6 +93,22 @@ class Subpasses : public vkb::VulkanSampleC
 
 	std::unique_ptr<vkb::rendering::RenderTargetC> create_render_target(vkb::core::Image &&swapchain_image);
 
+	/**
+	 * @return The fragment shader of the lighting subpass, which depends on the light culling option
+	 */
+	std::string get_lighting_fragment_shader() const;
+
+	/**
+	 * @brief Falls back to the fixed light arrays, or from GPU to CPU binning, if the SPIR-V of the clustered shaders
+	 *        was not generated
+	 */
+	void check_light_culling_shaders();
+
+	/**
+	 * @brief Selects the lights binned into clusters, creating the extra point lights on first use
+	 */
+	void update_clustered_lights();
+
 	/// Good pipeline with two subpasses within one render pass
 	std::unique_ptr<vkb::rendering::RenderPipelineC> render_pipeline{};
 
@@ -91,8 +118,21 @@ class Subpasses : public vkb::VulkanSampleC
 	/// 2. Bad pipeline with a lighting subpass in the second render pass
 	std::unique_ptr<vkb::rendering::RenderPipelineC> lighting_render_pipeline{};
 
+	/// Forward pipeline with a single subpass
+	std::unique_ptr<vkb::rendering::RenderPipelineC> forward_render_pipeline{};
+
 	vkb::sg::PerspectiveCamera *camera{};
 
+	/// Clusters used by the lighting and forward subpasses, if light culling is enabled
+	std::unique_ptr<vkb::rendering::LightClusters> light_clusters{};
+
+	/// Point lights added to the scene lights when binning more than 48 lights, not part of the scene
+	std::vector<std::unique_ptr<vkb::scene_graph::NodeC>> extra_light_nodes{};
+	std::vector<std::unique_ptr<vkb::sg::Light>>          extra_lights{};
+
+	/// Scene lights followed by the extra lights selected by the light count option
+	std::vector<vkb::sg::Light *> clustered_lights{};
+
 	/**
 	 * @brief Struct that contains configurations for this sample
 	 *        with description, options, and current selected value
@@ -106,7 +146,9 @@ class Subpasses : public vkb::VulkanSampleC
 		{
 			RenderTechnique,
 			TransientAttachments,
-			GBufferSize
+			GBufferSize,
+			LightCulling,
+			LightCount
 		} type;
 
 		/// Used as label by the GUI
@@ -122,6 +164,8 @@ class Subpasses : public vkb::VulkanSampleC
 	uint16_t last_render_technique{0};
 	uint16_t last_transient_attachment{0};
 	uint16_t last_g_buffer_size{0};
+	uint16_t last_light_culling{0};
+	uint16_t last_light_count{0};
 
 	VkFormat          albedo_format{VK_FORMAT_R8G8B8A8_UNORM};
 	VkFormat          normal_format{VK_FORMAT_A2B10G10R10_UNORM_PACK32};
@@ -130,7 +174,7 @@ class Subpasses : public vkb::VulkanSampleC
 	std::vector<Config> configs = {
 	    {/* config      = */ Config::RenderTechnique,
 	     /* description = */ "Render technique",
-	     /* options     = */ {"Subpasses", "Renderpasses"},
+	     /* options     = */ {"Subpasses", "Renderpasses", "Forward"},
 	     /* value       = */ 0},
 	    {/* config      = */ Config::TransientAttachments,
 	     /* description = */ "Transient attachments",
@@ -139,6 +183,14 @@ class Subpasses : public vkb::VulkanSampleC
 	    {/* config      = */ Config::GBufferSize,
 	     /* description = */ "G-Buffer size",
 	     /* options     = */ {"128-bit", "More"},
+	     /* value       = */ 0},
+	    {/* config      = */ Config::LightCulling,
+	     /* description = */ "Light culling",
+	     /* options     = */ {"None", "CPU clusters", "GPU clusters"},
+	     /* value       = */ 0},
+	    {/* config      = */ Config::LightCount,
+	     /* description = */ "Clustered point lights",
+	     /* options     = */ {"48", "1k", "10k"},
 	     /* value       = */ 0}};
 };
 
@@ -109,8 +109,16 @@ void TextureCompressionBasisu::get_available_target_formats()
 	available_target_formats_names.push_back("KTX_TTF_RGBA32");
 }
 
-// Loads and transcodes the input KTX texture file to the desired native GPU target format
+// Queues the input KTX texture file for transcoding to the desired native GPU target format
+// Transcoding happens on the transcoder's worker threads, so the current texture keeps rendering until the new one has been uploaded in render()
 void TextureCompressionBasisu::transcode_texture(const std::string &input_file, ktx_transcode_fmt_e target_format)
+{
+	std::string file_name = vkb::fs::path::get(vkb::fs::path::Assets, "textures/basisu/" + input_file);
+	pending_transcode     = transcoder->request(file_name, target_format);
+}
+
+// Uploads a transcoded KTX texture to a new Vulkan image, replacing the current one
+void TextureCompressionBasisu::upload_texture(vkb::ktx::TranscodeResult &transcode_result)
 {
 	// Clean up resources for an already created image
 	if (texture.image != VK_NULL_HANDLE)
@@ -118,29 +126,12 @@ void TextureCompressionBasisu::transcode_texture(const std::string &input_file,
 		destroy_texture(texture);
 	}
 
-	std::string file_name = vkb::fs::path::get(vkb::fs::path::Assets, "textures/basisu/" + input_file);
+	last_transcode_time       = static_cast<float>(transcode_result.transcode_time_ms);
+	last_transcode_throughput = static_cast<float>(transcode_result.throughput_mb_per_s());
+	last_transcode_cached     = transcode_result.from_cache;
 
-	// We are working with KTX2.0 files, so we need to use the ktxTexture2 class
-	ktxTexture2 *ktx_texture;
-	// Load the KTX2.0 file into memory. This is agnostic to the KTX version, so we cast the ktxTexture2 down to ktxTexture
-	KTX_error_code result = ktxTexture_CreateFromNamedFile(file_name.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, reinterpret_cast<ktxTexture **>(&ktx_texture));
-	if (result != KTX_SUCCESS)
-	{
-		throw std::runtime_error("Could not load the requested image file.");
-	}
-
-	// Check if the texture needs transcoding. This is the case, if the format stored in the KTX file is a non-native compression format
-	// This is the case for all textures used in this sample, as they are compressed using Basis Universal, which has to be transcoded to a native GPU format
-	if (ktxTexture2_NeedsTranscoding(ktx_texture))
-	{
-		auto tStart         = std::chrono::high_resolution_clock::now();
-		result              = ktxTexture2_TranscodeBasis(ktx_texture, target_format, 0);
-		last_transcode_time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
-		if (result != KTX_SUCCESS)
-		{
-			throw std::runtime_error("Could not transcode the input texture to the selected target format.");
-		}
-	}
+	// The transcoder already did the work of loading the KTX2.0 file and transcoding it from the Basis Universal supercompressed format
+	ktxTexture2 *ktx_texture = transcode_result.texture.get();
 
 	texture.width      = ktx_texture->baseWidth;
 	texture.height     = ktx_texture->baseHeight;
@@ -610,7 +601,10 @@ bool TextureCompressionBasisu::prepare(const vkb::ApplicationOptions &options)
 	                      "kodim05_ETC1S.ktx2",
 	                      "kodim03_UASTC.ktx2",
 	                      "kodim03_ETC1S.ktx2"};
+	transcoder = std::make_unique<vkb::ktx::Transcoder>();
 	transcode_texture(texture_file_names[selected_input_texture], available_target_formats[selected_transcode_target_format]);
+	// The initial texture is required to set up the descriptors, so wait for it
+	upload_texture(*pending_transcode.get());
 	generate_quad();
 	prepare_uniform_buffers();
 	setup_descriptor_set_layout();
@@ -628,6 +622,25 @@ void TextureCompressionBasisu::render(float delta_time)
 	{
 		return;
 	}
+	if (pending_transcode.valid() && pending_transcode.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+	{
+		std::unique_ptr<vkb::ktx::TranscodeResult> transcode_result;
+		try
+		{
+			transcode_result = pending_transcode.get();
+		}
+		catch (const std::exception &e)
+		{
+			// Keep displaying the current texture
+			LOGE("Could not transcode texture: {}", e.what());
+		}
+		if (transcode_result)
+		{
+			vkQueueWaitIdle(queue);
+			upload_texture(*transcode_result);
+			update_image_descriptor();
+		}
+	}
 	draw();
 }
 
@@ -648,13 +661,22 @@ void TextureCompressionBasisu::on_update_ui_overlay(vkb::Drawer &drawer)
 		ImGui::PushItemWidth(180);
 		drawer.combo_box("##tt", &selected_transcode_target_format, available_target_formats_names);
 		ImGui::PopItemWidth();
-		if (drawer.button("Transcode"))
+		if (pending_transcode.valid())
+		{
+			drawer.text("Transcoding...");
+		}
+		else if (drawer.button("Transcode"))
 		{
-			vkQueueWaitIdle(queue);
 			transcode_texture(texture_file_names[selected_input_texture], available_target_formats[selected_transcode_target_format]);
-			update_image_descriptor();
 		}
-		drawer.text("Transcoded in %.2f ms", last_transcode_time);
+		if (last_transcode_cached)
+		{
+			drawer.text("Loaded from cache in %.2f ms", last_transcode_time);
+		}
+		else
+		{
+			drawer.text("Transcoded in %.2f ms (%.1f MB/s)", last_transcode_time, last_transcode_throughput);
+		}
 	}
 }
 
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "api_vulkan_sample.h"
+#include "common/ktx_transcoder.h"
 
 class TextureCompressionBasisu : public ApiVulkanSample
 {
@@ -72,7 +73,13 @@ class TextureCompressionBasisu : public ApiVulkanSample
 	int32_t                          selected_input_texture = 0;
 	std::vector<std::string>         texture_file_names;
 
-	float last_transcode_time;
+	// Transcoding runs on worker threads, the current texture keeps rendering until the new one is ready
+	std::unique_ptr<vkb::ktx::Transcoder>                     transcoder;
+	std::future<std::unique_ptr<vkb::ktx::TranscodeResult>> pending_transcode;
+
+	float last_transcode_time       = 0.0f;
+	float last_transcode_throughput = 0.0f;
+	bool  last_transcode_cached     = false;
 
 	TextureCompressionBasisu();
 	~TextureCompressionBasisu();
@@ -80,6 +87,7 @@ class TextureCompressionBasisu : public ApiVulkanSample
 	bool         format_supported(VkFormat format);
 	void         get_available_target_formats();
 	void         transcode_texture(const std::string &input_file, ktx_transcode_fmt_e target_format);
+	void         upload_texture(vkb::ktx::TranscodeResult &transcode_result);
 	void         destroy_texture(Texture texture);
 	void         update_image_descriptor();
 	void         build_command_buffers() override;
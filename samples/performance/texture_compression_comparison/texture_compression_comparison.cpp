@@ -21,6 +21,7 @@
 #include "scene_graph/components/image.h"
 #include "scene_graph/components/material.h"
 #include "scene_graph/components/mesh.h"
+#include "timer.h"
 
 namespace
 {
@@ -71,6 +72,8 @@ bool TextureCompressionComparison::prepare(const vkb::ApplicationOptions &option
 		return false;
 	}
 
+	transcoder = std::make_unique<vkb::ktx::Transcoder>();
+
 	load_assets();
 
 	auto &camera_node = vkb::add_free_camera(get_scene(), "main_camera", get_render_context().get_surface_extent());
@@ -128,6 +131,12 @@ void TextureCompressionComparison::draw_gui()
 			ImGui::Text("Format name: %s", format.format_name);
 			ImGui::Text("Bytes: %f MB", static_cast<float>(current_benchmark.total_bytes) / 1024.f / 1024.f);
 			ImGui::Text("Compression Time: %f (ms)", current_benchmark.compress_time_ms);
+			ImGui::Text("Wall Time: %f (ms) on %u threads", current_benchmark.wall_time_ms, transcoder->get_thread_count());
+			ImGui::Text("Transcode Throughput: %.1f MB/s", transcoder->get_throughput(format.ktx_format).mb_per_s());
+			if (current_benchmark.cached_count > 0)
+			{
+				ImGui::Text("Loaded from cache: %u textures", current_benchmark.cached_count);
+			}
 		}
 		else
 		{
@@ -221,26 +230,49 @@ void TextureCompressionComparison::create_subpass()
 
 TextureCompressionComparison::TextureBenchmark TextureCompressionComparison::update_textures(const TextureCompressionComparison::CompressedTexture_t &new_format)
 {
-	TextureBenchmark                benchmark;
-	std::unordered_set<std::string> visited;
+	// Queue all textures at once, so they are transcoded in parallel on the transcoder's worker threads
+	std::vector<std::string> internal_names;
+	std::vector<std::string> filenames;
 	for (auto &&texture_filename : textures)
 	{
-		vkb::sg::Texture *texture = texture_filename.first;
-		assert(!!texture);
 		auto &internal_name = texture_filename.second;
-		if (!visited.count(internal_name))
+		if (std::find(internal_names.begin(), internal_names.end(), internal_name) == internal_names.end())
 		{
-			auto filename                             = get_sponza_texture_filename(internal_name);
-			auto new_image                            = compress(filename, new_format, "");
-			texture_raw_data[internal_name].image     = std::move(new_image.first);
-			texture_raw_data[internal_name].benchmark = new_image.second;
-			benchmark += new_image.second;
+			internal_names.push_back(internal_name);
+			filenames.push_back(get_sponza_texture_filename(internal_name));
 		}
+	}
+
+	vkb::Timer timer;
+	timer.start();
+
+	auto transcodes = transcoder->request(filenames, new_format.ktx_format);
+
+	TextureBenchmark benchmark;
+	for (size_t i = 0; i < transcodes.size(); ++i)
+	{
+		auto &internal_name                       = internal_names[i];
+		auto  new_image                           = compress(*transcodes[i].get(), "");
+		texture_raw_data[internal_name].image     = std::move(new_image.first);
+		texture_raw_data[internal_name].benchmark = new_image.second;
+		benchmark += new_image.second;
+	}
+
+	benchmark.wall_time_ms = static_cast<float>(timer.stop<vkb::Timer::Milliseconds>());
+
+	LOGI("Transcoded {} textures to {} in {:.2f} ms ({:.1f} MB/s)",
+	     transcodes.size(),
+	     new_format.format_name,
+	     benchmark.wall_time_ms,
+	     transcoder->get_throughput(new_format.ktx_format).mb_per_s());
 
-		vkb::sg::Image *image = texture_raw_data[internal_name].image.get();
+	for (auto &&texture_filename : textures)
+	{
+		vkb::sg::Texture *texture = texture_filename.first;
+		assert(!!texture);
+		vkb::sg::Image *image = texture_raw_data[texture_filename.second].image.get();
 		assert(image);
 		texture->set_image(*image);
-		visited.insert(internal_name);
 	}
 
 	// update the forward subpass to use the new textures
@@ -319,21 +351,14 @@ std::unique_ptr<vkb::sg::Image> TextureCompressionComparison::create_image(ktxTe
 	return image_out;
 }
 
-std::pair<std::unique_ptr<vkb::sg::Image>, TextureCompressionComparison::TextureBenchmark> TextureCompressionComparison::compress(const std::string &filename, TextureCompressionComparison::CompressedTexture_t texture_format, const std::string &name)
+std::pair<std::unique_ptr<vkb::sg::Image>, TextureCompressionComparison::TextureBenchmark> TextureCompressionComparison::compress(vkb::ktx::TranscodeResult &transcode_result, const std::string &name)
 {
-	ktxTexture2 *ktx_texture{nullptr};
-	KTX_CHECK(ktxTexture2_CreateFromNamedFile(filename.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &ktx_texture));
-
 	TextureBenchmark benchmark;
-	{
-		const auto start = std::chrono::high_resolution_clock::now();
-		KTX_CHECK(ktxTexture2_TranscodeBasis(ktx_texture, texture_format.ktx_format, 0));
-		const auto end             = std::chrono::high_resolution_clock::now();
-		benchmark.compress_time_ms = static_cast<float>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) / 1000.f;
-	}
-	benchmark.total_bytes = ktx_texture->dataSize;
-	auto image            = create_image(ktx_texture, name);
-	ktxTexture_Destroy((ktxTexture *) ktx_texture);
+	benchmark.compress_time_ms = static_cast<float>(transcode_result.transcode_time_ms);
+	benchmark.total_bytes      = transcode_result.transcoded_bytes;
+	benchmark.cached_count     = transcode_result.from_cache ? 1 : 0;
+
+	auto image = create_image(transcode_result.texture.get(), name);
 
 	return {std::move(image), benchmark};
 }
@@ -20,6 +20,7 @@
 #include "ktx.h"
 
 #include "api_vulkan_sample.h"
+#include "common/ktx_transcoder.h"
 #include "scene_graph/components/camera.h"
 
 class TextureCompressionComparison : public vkb::VulkanSampleC
@@ -50,11 +51,14 @@ class TextureCompressionComparison : public vkb::VulkanSampleC
 			total_bytes += other.total_bytes;
 			compress_time_ms += other.compress_time_ms;
 			frame_time_ms += other.frame_time_ms;
+			cached_count += other.cached_count;
 			return *this;
 		}
 		VkDeviceSize total_bytes      = 0;
 		float        compress_time_ms = 0.f;
+		float        wall_time_ms     = 0.f;
 		float        frame_time_ms    = 0.f;
+		uint32_t     cached_count     = 0;
 	};
 
 	struct SampleTexture
@@ -71,7 +75,8 @@ class TextureCompressionComparison : public vkb::VulkanSampleC
 	void                                                         create_subpass();
 	TextureBenchmark                                             update_textures(const CompressedTexture_t &new_format);
 	std::unique_ptr<vkb::sg::Image>                              create_image(ktxTexture2 *ktx_texture, const std::string &name);
-	std::pair<std::unique_ptr<vkb::sg::Image>, TextureBenchmark> compress(const std::string &filename, CompressedTexture_t texture_format, const std::string &name);
+	std::pair<std::unique_ptr<vkb::sg::Image>, TextureBenchmark> compress(vkb::ktx::TranscodeResult &transcode_result, const std::string &name);
+	std::unique_ptr<vkb::ktx::Transcoder>                        transcoder;
 	std::vector<std::string>                                     gui_texture_names;
 	std::unordered_map<std::string, SampleTexture>               texture_raw_data;
 	std::vector<std::pair<vkb::sg::Texture *, std::string>>      textures;
@@ -1,5 +1,5 @@
 #version 450
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -39,6 +39,10 @@ layout(push_constant, std430) uniform PBRMaterialUniform
     vec4  base_color_factor;
     float metallic_factor;
     float roughness_factor;
+
+    // Positions are quantized relative to the bounding box of the submesh
+    vec4 position_scale;
+    vec4 position_bias;
 }
 pbr_material_uniform;
 
@@ -58,7 +62,7 @@ layout(constant_id = 2) const uint SPOT_LIGHT_COUNT        = 0U;
 
 void main(void)
 {
-    vec4 pos = global_uniform.model * vec4(position, 1.0);
+    vec4 pos = global_uniform.model * vec4(position * pbr_material_uniform.position_scale.xyz + pbr_material_uniform.position_bias.xyz, 1.0);
     vec3 normal = mat3(global_uniform.model) * normal;
     gl_Position = global_uniform.view_proj * pos;
 
@@ -0,0 +1,123 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Resources of the Barnes-Hut passes
+// The particles are sorted along a Morton curve, then organized into a binary radix tree over their Morton codes.
+// The internal nodes come first, followed by one leaf per sorted particle.
+
+struct Particle
+{
+	vec4 pos;
+	vec4 vel;
+};
+
+struct Node
+{
+	vec4 center_of_mass;        // xyz: center of mass, w: mass
+	vec4 bounds_min;            // xyz: bounds of the particles of the node, w: largest extent of the bounds
+	vec4 bounds_max;
+	int  left;
+	int  right;
+	int  parent;
+	uint visits;        // Number of summarized children, the second one summarizes the node
+};
+
+#ifndef NODES_QUALIFIER
+#	define NODES_QUALIFIER
+#endif
+
+layout(std140, binding = 0) buffer Pos
+{
+	Particle particles[];
+};
+
+layout(binding = 1) uniform UBO
+{
+	float deltaT;
+	int   particleCount;
+	float openingAngle;
+	uint  capture;
+}
+ubo;
+
+// Keys and values read and written by a sort pass, the last pass writes them back into the input buffers
+layout(std430, binding = 2) buffer KeysIn
+{
+	uint keys_in[];
+};
+
+layout(std430, binding = 3) buffer ValuesIn
+{
+	uint values_in[];
+};
+
+layout(std430, binding = 4) buffer KeysOut
+{
+	uint keys_out[];
+};
+
+layout(std430, binding = 5) buffer ValuesOut
+{
+	uint values_out[];
+};
+
+// Number of keys of each digit in each tile, digit major, then their offsets in the sorted keys once scanned
+layout(std430, binding = 6) buffer Histogram
+{
+	uint histogram[];
+};
+
+layout(std430, binding = 7) NODES_QUALIFIER buffer Nodes
+{
+	Node nodes[];
+};
+
+// Bounds of the particles, as ordered encodings of floats
+layout(std430, binding = 8) buffer Bounds
+{
+	uint bounds[6];
+};
+
+// Position and acceleration of each particle, written when validating on the CPU
+layout(std430, binding = 9) writeonly buffer Capture
+{
+	vec4 captured[];
+};
+
+layout(push_constant) uniform PushConstants
+{
+	uint shift;              // First bit of the digit of a sort pass
+	uint group_count;        // Number of tiles of the sort
+}
+push_constants;
+
+#define TREE_GROUP_SIZE 128
+#define SORT_ITEMS_PER_THREAD 8
+#define SORT_TILE_SIZE (TREE_GROUP_SIZE * SORT_ITEMS_PER_THREAD)
+#define SORT_DIGIT_COUNT 16
+
+// Maps floats to unsigned integers with the same order, so that their bounds can be reduced with atomics
+uint float_to_ordered(float value)
+{
+	uint bits = floatBitsToUint(value);
+	return (bits & 0x80000000u) != 0u ? ~bits : bits | 0x80000000u;
+}
+
+float ordered_to_float(uint value)
+{
+	return uintBitsToFloat((value & 0x80000000u) != 0u ? value & 0x7fffffffu : ~value);
+}
@@ -0,0 +1,95 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Light lists of vkb::rendering::LightClusters, bound to set 0 from binding 5
+
+#include "lighting.h"
+
+layout(set = 0, binding = 5) uniform ClusterInfo
+{
+	mat4  view;
+	uvec4 grid;         // xyz: number of clusters, w: number of directional lights
+	vec4  scale;        // xy: clusters per pixel, z: depth slice scale, w: depth slice bias
+}
+cluster_info;
+
+// Directional lights first, then the point and spot lights referenced by the clusters
+layout(set = 0, binding = 6) readonly buffer ClusterLights
+{
+	Light cluster_lights[];
+};
+
+// Offset and number of the light indices of each cluster
+layout(set = 0, binding = 7) readonly buffer ClusterRanges
+{
+	uvec2 cluster_ranges[];
+};
+
+layout(set = 0, binding = 8) readonly buffer ClusterLightIndices
+{
+	uint cluster_light_indices[];
+};
+
+// Smoothly fades a light out at its range, lights without a range are not affected
+float range_window(float dist, float range)
+{
+	if (range <= 0.0)
+	{
+		return 1.0;
+	}
+	float ratio  = dist / range;
+	float ratio2 = ratio * ratio;
+	float window = clamp(1.0 - ratio2 * ratio2, 0.0, 1.0);
+	return window * window;
+}
+
+uint get_cluster_index(vec2 frag_coord, vec3 pos)
+{
+	float view_depth = -(cluster_info.view * vec4(pos, 1.0)).z;
+	uvec2 tile       = min(uvec2(frag_coord * cluster_info.scale.xy), cluster_info.grid.xy - 1U);
+	float slice      = clamp(floor(log(max(view_depth, 1e-4)) * cluster_info.scale.z + cluster_info.scale.w), 0.0, float(cluster_info.grid.z - 1U));
+	return (uint(slice) * cluster_info.grid.y + tile.y) * cluster_info.grid.x + tile.x;
+}
+
+vec3 apply_clustered_lights(vec2 frag_coord, vec3 pos, vec3 normal)
+{
+	vec3 L = vec3(0.0);
+
+	for (uint i = 0U; i < cluster_info.grid.w; ++i)
+	{
+		L += apply_directional_light(cluster_lights[i], normal);
+	}
+
+	uvec2 range = cluster_ranges[get_cluster_index(frag_coord, pos)];
+	for (uint i = range.x; i < range.x + range.y; ++i)
+	{
+		Light light  = cluster_lights[cluster_light_indices[i]];
+		float window = range_window(distance(light.position.xyz, pos), light.direction.w);
+
+		// position.w is 1.0 for point lights and 2.0 for spot lights
+		if (light.position.w < 1.5)
+		{
+			L += window * apply_point_light(light, pos, normal);
+		}
+		else
+		{
+			L += window * apply_spot_light(light, pos, normal);
+		}
+	}
+
+	return L;
+}
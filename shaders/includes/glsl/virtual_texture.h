@@ -0,0 +1,60 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Page table and feedback of vkb::rendering::VirtualTexture, bound to set 0 at bindings 9 and 10, after the
+// bindings of clustered_lighting.h
+// Writing the feedback from fragment shaders needs the fragmentStoresAndAtomics feature
+
+layout(set = 0, binding = 9) readonly buffer VirtualTextureTable
+{
+	uvec4 virtual_texture_info;              // xy: pages of the finest level, z: first level of the mip tail, w: number of levels
+	uint  virtual_texture_min_lods[];        // Most detailed resident level of each page of the finest level
+};
+
+// Non zero for each page sampled by the frame, for the levels above the mip tail
+layout(set = 0, binding = 10) writeonly buffer VirtualTextureFeedback
+{
+	uint virtual_texture_feedback[];
+};
+
+vec4 sample_virtual_texture(sampler2D virtual_texture, vec2 uv)
+{
+	uvec2 pages      = virtual_texture_info.xy;
+	uint  tail_level = virtual_texture_info.z;
+	vec2  page_uv    = fract(uv);
+
+	float lod   = textureQueryLod(virtual_texture, uv).y;
+	uint  level = uint(clamp(floor(lod), 0.0, float(virtual_texture_info.w - 1)));
+
+	// A single fragment of each quad requests its page, which is enough as neighboring fragments mostly share pages
+	if (level < tail_level && all(equal(uvec2(gl_FragCoord.xy) & 1u, uvec2(0u))))
+	{
+		uint offset = 0;
+		for (uint l = 0; l < level; ++l)
+		{
+			offset += (pages.x >> l) * (pages.y >> l);
+		}
+		uvec2 page = min(uvec2(page_uv * vec2(pages >> level)), (pages >> level) - 1u);
+		virtual_texture_feedback[offset + page.y * (pages.x >> level) + page.x] = 1u;
+	}
+
+	// Pages which are not resident are sampled from the most detailed resident level covering them
+	uvec2 finest_page = min(uvec2(page_uv * vec2(max(pages, uvec2(1u)))), max(pages, uvec2(1u)) - 1u);
+	float min_lod     = float(virtual_texture_min_lods[finest_page.y * max(pages.x, 1u) + finest_page.x]);
+
+	return textureLod(virtual_texture, uv, max(lod, min_lod));
+}
@@ -0,0 +1,213 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Flame particle emitter and simulation, see the GLSL version for a description of the passes
+
+#define PASS_BEGIN_EMIT 0
+#define PASS_EMIT 1
+#define PASS_BEGIN_SIMULATE 2
+#define PASS_SIMULATE 3
+
+[[vk::constant_id(0)]] const uint pass_index = PASS_BEGIN_EMIT;
+
+struct Particle
+{
+	float4 position;        // xyz: position, w: age in seconds
+	float4 velocity;        // xyz: velocity, w: lifetime in seconds
+};
+
+struct FlameParticleUniforms
+{
+	float4 origin;                 // xyz: center of the emitter disk, w: radius of the disk
+	float4 direction;              // xyz: emission direction, w: maximum lifetime in seconds
+	float4 u;                      // Basis of the emitter disk
+	float4 v;
+	float4 camera_position;        // xyz: camera position, w: time step in seconds
+	uint   particle_count;
+	uint   vertex_offset;          // First vertex of the billboards in the vertex buffer
+	float  particle_size;
+};
+[[vk::binding(0, 0)]]
+ConstantBuffer<FlameParticleUniforms> params : register(b0);
+
+[[vk::binding(1, 0)]]
+RWStructuredBuffer<Particle> particles : register(u1);
+
+[[vk::binding(2, 0)]]
+RWStructuredBuffer<uint> dead_list : register(u2);
+
+// Two lists of particle_count entries, the particles emitted or alive after a frame are in the current one
+[[vk::binding(3, 0)]]
+RWStructuredBuffer<uint> alive_lists : register(u3);
+
+struct Counters
+{
+	uint  dead_count;
+	uint  alive_counts[2];
+	uint  current;
+	uint  emit_count;
+	uint  seed;
+	uint  padding[2];
+	uint4 emit_dispatch;
+	uint4 simulate_dispatch;
+};
+[[vk::binding(4, 0)]]
+RWStructuredBuffer<Counters> counters : register(u4);
+
+[[vk::binding(5, 0)]]
+RWStructuredBuffer<float4> vertices : register(u5);
+
+uint pcg_hash(uint value)
+{
+	uint state = value * 747796405u + 2891336453u;
+	uint word  = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+	return (word >> 22u) ^ word;
+}
+
+float random(inout uint state)
+{
+	state = pcg_hash(state);
+	return float(state) / 4294967295.0;
+}
+
+Particle emit_particle(uint index)
+{
+	uint state = pcg_hash(counters[0].seed ^ pcg_hash(index));
+
+	float theta  = 2.0 * 3.14159265 * random(state);
+	float radius = params.origin.w * random(state);
+
+	// Keep a part of the direction, as a null emission direction cannot be normalized
+	float3 direction = normalize(0.2 * random(state) * params.u.xyz + 0.2 * random(state) * params.v.xyz + 0.8 * lerp(0.05, 1.0, random(state)) * params.direction.xyz);
+
+	Particle particle;
+	particle.position = float4(params.origin.xyz + radius * (sin(theta) * params.u.xyz + cos(theta) * params.v.xyz), 0.0);
+	particle.velocity = float4(0.2 * random(state) * direction, random(state) * params.direction.w);
+	return particle;
+}
+
+void write_vertex(uint slot, uint corner, float3 position, float3 normal)
+{
+	const float2 corners[4] = {float2(0.0, 0.0), float2(1.0, 0.0), float2(1.0, 1.0), float2(0.0, 1.0)};
+
+	// Same layout as the vertices of the scene: position, normal and texture coordinate
+	uint index          = 2 * (params.vertex_offset + 4 * slot + corner);
+	vertices[index]     = float4(position, normal.x);
+	vertices[index + 1] = float4(normal.yz, corners[corner].x, 1.0 - corners[corner].y);
+}
+
+// Billboard facing the camera around the vertical axis
+void write_billboard(uint slot, float3 position)
+{
+	float3 normal = normalize(position + params.camera_position.xyz);
+	normal        = abs(normal.y) > 0.99 ? float3(0.0, 0.0, 1.0) : normalize(float3(normal.x, 0.0, normal.z));
+	float3 u      = normalize(cross(normal, float3(0.0, 1.0, 0.0)));
+	float3 v      = normalize(cross(normal, u));
+
+	write_vertex(slot, 0, position + params.particle_size * (-0.5 * u - 0.5 * v), normal);
+	write_vertex(slot, 1, position + params.particle_size * (0.5 * u - 0.5 * v), normal);
+	write_vertex(slot, 2, position + params.particle_size * (0.5 * u + 0.5 * v), normal);
+	write_vertex(slot, 3, position + params.particle_size * (-0.5 * u + 0.5 * v), normal);
+}
+
+// Collapses the billboard of a dead particle, so that rays cannot hit it while keeping it in the acceleration structure
+void clear_billboard(uint slot)
+{
+	for (uint corner = 0; corner < 4; corner++)
+	{
+		write_vertex(slot, corner, params.origin.xyz, float3(0.0, 0.0, 1.0));
+	}
+}
+
+[numthreads(64, 1, 1)]
+void main(uint3 GlobalInvocationID : SV_DispatchThreadID)
+{
+	uint index = GlobalInvocationID.x;
+
+	if (pass_index == PASS_BEGIN_EMIT)
+	{
+		if (index == 0)
+		{
+			// The particles simulated by the last frame become the current ones
+			counters[0].current    = 1 - counters[0].current;
+			counters[0].emit_count = counters[0].dead_count;
+			counters[0].seed       = pcg_hash(counters[0].seed);
+
+			counters[0].emit_dispatch = uint4((counters[0].emit_count + 63) / 64, 1, 1, 0);
+		}
+	}
+	else if (pass_index == PASS_EMIT)
+	{
+		if (index < counters[0].emit_count)
+		{
+			uint current = counters[0].current;
+
+			uint dead_index;
+			InterlockedAdd(counters[0].dead_count, uint(-1), dead_index);
+			uint slot       = dead_list[dead_index - 1];
+			particles[slot] = emit_particle(index);
+
+			uint alive_index;
+			InterlockedAdd(counters[0].alive_counts[current], 1, alive_index);
+			alive_lists[current * params.particle_count + alive_index] = slot;
+		}
+	}
+	else if (pass_index == PASS_BEGIN_SIMULATE)
+	{
+		if (index == 0)
+		{
+			uint current = counters[0].current;
+
+			counters[0].alive_counts[1 - current] = 0;
+
+			counters[0].simulate_dispatch = uint4((counters[0].alive_counts[current] + 63) / 64, 1, 1, 0);
+		}
+	}
+	else if (pass_index == PASS_SIMULATE)
+	{
+		uint current = counters[0].current;
+
+		if (index < counters[0].alive_counts[current])
+		{
+			uint     slot     = alive_lists[current * params.particle_count + index];
+			Particle particle = particles[slot];
+
+			float time_step = params.camera_position.w;
+			particle.position.w += time_step;
+
+			if (particle.position.w >= particle.velocity.w)
+			{
+				uint dead_index;
+				InterlockedAdd(counters[0].dead_count, 1, dead_index);
+				dead_list[dead_index] = slot;
+				clear_billboard(slot);
+				return;
+			}
+
+			particle.position.xyz += time_step * particle.velocity.xyz;
+
+			particles[slot] = particle;
+			write_billboard(slot, particle.position.xyz);
+
+			uint next = 1 - current;
+
+			uint alive_index;
+			InterlockedAdd(counters[0].alive_counts[next], 1, alive_index);
+			alive_lists[next * params.particle_count + alive_index] = slot;
+		}
+	}
+}